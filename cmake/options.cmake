@@ -162,3 +162,8 @@ endif()
 if(ENABLE_AKG AND CMAKE_SYSTEM_NAME MATCHES "Linux")
     add_compile_definitions(ENABLE_AKG)
 endif()
+
+# The CPU graph kernels are built by the native loop fusion, or by AKG if it is enabled.
+if(ENABLE_CPU AND CMAKE_SYSTEM_NAME MATCHES "Linux")
+    add_compile_definitions(ENABLE_CPU_GRAPH_KERNEL)
+endif()
@@ -88,6 +88,17 @@ class MS_API Context {
   /// \return Bool value that indicates whether in parallel.
   bool GetEnableParallel() const;
 
+  /// \brief Set the status whether to run the independent branches of a CPU subgraph side by side on the thread pool.
+  /// Only valid for Lite.
+  ///
+  /// \param[in] is_parallel: true, independent branches overlap; false, kernels run one after another.
+  void SetEnableInterOpParallel(bool is_parallel);
+
+  /// \brief Get the status whether to run the independent branches of a CPU subgraph side by side. Only valid for Lite.
+  ///
+  /// \return Bool value that indicates whether branches overlap.
+  bool GetEnableInterOpParallel() const;
+
   /// \brief Set Delegate to access third-party AI framework. Only valid for Lite.
   ///
   /// \param[in] Pointer to the custom delegate.
@@ -186,6 +197,17 @@ class MS_API CPUDeviceInfo : public DeviceInfoContext {
   ///
   /// \return Whether enable float16 inference.
   bool GetEnableFP16() const;
+
+  /// \brief Set enables to keep the constant weights of float32 MatMul and FullConnection in bfloat16, which halves
+  /// their memory. The activations are rounded to bfloat16 and accumulation stays float32. Only valid for Lite.
+  ///
+  /// \param[in] is_bf16 Enable bfloat16 weights or not.
+  void SetEnableBF16(bool is_bf16);
+
+  /// \brief Get enables to keep the constant MatMul weights in bfloat16. Only valid for Lite.
+  ///
+  /// \return Whether enable bfloat16 weights.
+  bool GetEnableBF16() const;
 };
 
 /// \brief Derived from DeviceInfoContext, The configuration of the model running on the NPU. This option is only valid
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_INCLUDE_API_MODEL_PARALLEL_RUNNER_H
+#define MINDSPORE_INCLUDE_API_MODEL_PARALLEL_RUNNER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "include/api/status.h"
+#include "include/api/types.h"
+#include "include/api/context.h"
+#include "include/api/dual_abi_helper.h"
+
+namespace mindspore {
+class ModelPool;
+
+/// \brief The RunnerConfig class is used to define the options of a ModelParallelRunner.
+struct RunnerConfig {
+  /// \brief Number of worker sessions. 0 means as many as the cores allow, given the thread number of the context.
+  int32_t workers_num = 0;
+  /// \brief Context of each worker. The thread number is the number of threads of one worker. If a core list is set,
+  /// it is split evenly between the workers, otherwise worker i is bound to cores [i * thread_num, (i + 1) *
+  /// thread_num).
+  std::shared_ptr<Context> context = nullptr;
+  /// \brief Largest batch a worker builds out of queued requests. 1 disables dynamic batching.
+  int32_t max_batch_size = 1;
+  /// \brief How long, in microseconds, a worker holding a partial batch waits for more requests before it runs.
+  int32_t batch_timeout_us = 0;
+};
+
+/// \brief Latency statistics of the requests served by a ModelParallelRunner, measured from the call to Predict to
+/// its return, so the time spent in the queue is included.
+struct RunnerStat {
+  uint64_t request_num = 0;
+  uint64_t batch_num = 0;
+  float avg_ms = 0;
+  float p50_ms = 0;
+  float p90_ms = 0;
+  float p99_ms = 0;
+  float max_ms = 0;
+};
+
+/// \brief The ModelParallelRunner class serves one model to many concurrent callers. It runs a pool of worker
+/// sessions which share one read-only copy of the constant tensors of the model, and workers may coalesce small
+/// requests into one batch. Only valid for Lite.
+class MS_API ModelParallelRunner {
+ public:
+  ModelParallelRunner();
+  ~ModelParallelRunner();
+  ModelParallelRunner(const ModelParallelRunner &) = delete;
+  void operator=(const ModelParallelRunner &) = delete;
+
+  /// \brief Build the worker sessions from a model file.
+  ///
+  /// \param[in] model_path Define the model path, the model must be of type ModelType::kMindIR.
+  /// \param[in] runner_config Define the config used to build the pool, nullptr means the default config.
+  ///
+  /// \return Status.
+  inline Status Init(const std::string &model_path, const std::shared_ptr<RunnerConfig> &runner_config = nullptr);
+
+  /// \brief Run inference. Thread safe, any number of callers may be waiting in Predict at the same time.
+  ///
+  /// \param[in] inputs A vector where model inputs are arranged in sequence. With dynamic batching, requests are
+  /// concatenated along the first dimension, so all the inputs must carry the batch in dimension 0.
+  /// \param[out] outputs Which is a pointer to a vector. The model outputs are filled in the container in sequence.
+  ///
+  /// \return Status.
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
+
+  /// \brief Obtains all input tensors of the model. The tensors only describe the inputs, they hold no data.
+  ///
+  /// \return The vector that includes all input tensors.
+  std::vector<MSTensor> GetInputs();
+
+  /// \brief Obtains all output tensors of the model. The tensors only describe the outputs, they hold no data.
+  ///
+  /// \return The vector that includes all output tensors.
+  std::vector<MSTensor> GetOutputs();
+
+  /// \brief Latency statistics of the requests served since Init or the last reset.
+  ///
+  /// \param[in] reset Start a new measurement window after reading.
+  ///
+  /// \return The statistics.
+  RunnerStat GetStat(bool reset = false);
+
+ private:
+  Status Init(const std::vector<char> &model_path, const std::shared_ptr<RunnerConfig> &runner_config);
+
+  std::shared_ptr<ModelPool> model_pool_ = nullptr;
+};
+
+Status ModelParallelRunner::Init(const std::string &model_path, const std::shared_ptr<RunnerConfig> &runner_config) {
+  return Init(StringToChar(model_path), runner_config);
+}
+}  // namespace mindspore
+#endif  // MINDSPORE_INCLUDE_API_MODEL_PARALLEL_RUNNER_H
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_kernel_mod.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "backend/kernel_compiler/akg/cpu/akg_cpu_kernel_build.h"
+#include "backend/optimizer/graph_kernel/graph_kernel_helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/context/graph_kernel_flags.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace kernel {
+bool LoopFusionKernelMod::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                                 const std::vector<AddressPtr> &outputs, void *) {
+  auto get_addr = [](const std::vector<AddressPtr> &addresses) {
+    std::vector<void *> result;
+    (void)std::transform(addresses.begin(), addresses.end(), std::back_inserter(result),
+                         [](const AddressPtr &address) { return address->addr; });
+    return result;
+  };
+  program_->Run(get_addr(inputs), get_addr(workspace), get_addr(outputs));
+  return true;
+}
+
+std::vector<AnfNodePtr> LoopFusionKernelBuild(const std::vector<AnfNodePtr> &anf_nodes) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<AnfNodePtr> unsupported_nodes;
+  for (const auto &anf_node : anf_nodes) {
+    MS_EXCEPTION_IF_NULL(anf_node);
+    if (!AnfAlgo::IsGraphKernel(anf_node)) {
+      unsupported_nodes.push_back(anf_node);
+      continue;
+    }
+    auto func_graph = AnfAlgo::GetCNodeFuncGraphPtr(anf_node);
+    MS_EXCEPTION_IF_NULL(func_graph);
+    auto program = LoopFusionProgram::Compile(graphkernel::AnfGraph2LiteGraph(func_graph));
+    if (program == nullptr) {
+      unsupported_nodes.push_back(anf_node);
+      continue;
+    }
+    MS_LOG(DEBUG) << "Build " << anf_node->fullname_with_scope() << " by the loop fusion with "
+                  << program->stage_num() << " stages.";
+    AnfAlgo::SetKernelMod(std::make_shared<LoopFusionKernelMod>(program), anf_node.get());
+  }
+  auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Build " << (anf_nodes.size() - unsupported_nodes.size()) << " kernels by the loop fusion in "
+               << cost << " ms, " << unsupported_nodes.size() << " kernels are not supported.";
+  return unsupported_nodes;
+}
+
+bool IsLoopFusionSupported(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr) {
+    return false;
+  }
+  if (AnfAlgo::IsGraphKernel(cnode)) {
+    auto func_graph = AnfAlgo::GetCNodeFuncGraphPtr(cnode);
+    MS_EXCEPTION_IF_NULL(func_graph);
+    return LoopFusionProgram::Compile(graphkernel::AnfGraph2LiteGraph(func_graph)) != nullptr;
+  }
+  if (AnfAlgo::IsDynamicShape(cnode)) {
+    return false;
+  }
+  std::vector<TypeId> types;
+  std::vector<std::string> formats;
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(cnode); ++i) {
+    types.push_back(AnfAlgo::GetInputDeviceDataType(cnode, i));
+    formats.push_back(AnfAlgo::GetInputFormat(cnode, i));
+  }
+  for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(cnode); ++i) {
+    types.push_back(AnfAlgo::GetOutputDeviceDataType(cnode, i));
+    formats.push_back(AnfAlgo::GetOutputFormat(cnode, i));
+  }
+  return LoopFusionProgram::IsSupportedOp(AnfAlgo::GetCNodeName(cnode), types, formats);
+}
+
+bool CpuGraphKernelCanFuse(const AnfNodePtr &node) {
+#ifdef ENABLE_AKG
+  return true;
+#else
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  return context->get_param<std::string>(MS_CTX_DEVICE_TARGET) != kCPUDevice || IsLoopFusionSupported(node);
+#endif
+}
+
+bool IsEnableCpuGraphKernel() {
+  const auto &flags = graphkernel::GraphKernelFlags::GetInstance();
+#ifdef ENABLE_AKG
+  return flags.IsEnableGraphKernel();
+#else
+  return flags.IsEnableGraphKernel() && flags.enable_native_cpu_codegen;
+#endif
+}
+
+void CpuGraphKernelBuild(const std::vector<AnfNodePtr> &anf_nodes) {
+  auto akg_nodes = anf_nodes;
+  if (graphkernel::GraphKernelFlags::GetInstance().enable_native_cpu_codegen) {
+    akg_nodes = LoopFusionKernelBuild(akg_nodes);
+  }
+#ifdef ENABLE_AKG
+  AkgCpuKernelBuilder akg_cpu_kernel_builder;
+  (void)akg_cpu_kernel_builder.AkgKernelParallelBuild(akg_nodes);
+#else
+  // CpuGraphKernelCanFuse keeps the unsupported nodes out of the graph kernels, so this only fails if a later pass
+  // rewrote a graph kernel into one the loop fusion does not support.
+  if (!akg_nodes.empty()) {
+    MS_LOG(EXCEPTION) << "The loop fusion does not support the graph kernel "
+                      << akg_nodes[0]->fullname_with_scope() << " and " << (akg_nodes.size() - 1)
+                      << " others, and MindSpore is built without AKG.";
+  }
+#endif
+}
+}  // namespace kernel
+}  // namespace mindspore
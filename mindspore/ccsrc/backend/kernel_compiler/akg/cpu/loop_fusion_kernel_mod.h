@@ -0,0 +1,60 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_KERNEL_MOD_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_KERNEL_MOD_H_
+#include <memory>
+#include <vector>
+#include "backend/kernel_compiler/kernel.h"
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_program.h"
+
+namespace mindspore {
+namespace kernel {
+class LoopFusionKernelMod : public KernelMod {
+ public:
+  explicit LoopFusionKernelMod(const LoopFusionProgramPtr &program) : program_(program) {}
+  ~LoopFusionKernelMod() = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return program_->input_size_list(); }
+  const std::vector<size_t> &GetOutputSizeList() const override { return program_->output_size_list(); }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return program_->workspace_size_list(); }
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, void *stream_ptr) override;
+
+ private:
+  LoopFusionProgramPtr program_;
+};
+
+// Build the kernels of the graph kernel nodes by the loop fusion, and return the nodes which are not supported.
+std::vector<AnfNodePtr> LoopFusionKernelBuild(const std::vector<AnfNodePtr> &anf_nodes);
+
+// Whether the loop fusion can build the node: a graph kernel which it compiles, or a basic op of static shape whose
+// op, types and formats it supports.
+bool IsLoopFusionSupported(const AnfNodePtr &node);
+
+// Whether the graph kernel passes may fuse the node. Without AKG the CPU graph kernels are built by the loop fusion
+// only, so on CPU only the nodes it supports are fused, and the others keep their CPU kernels.
+bool CpuGraphKernelCanFuse(const AnfNodePtr &node);
+
+// Whether the graph kernel fusion runs on CPU. Without AKG the graph kernels can only be built by the loop fusion, so
+// enable_native_cpu_codegen is required as well.
+bool IsEnableCpuGraphKernel();
+
+// Build the graph kernel nodes on CPU: by the loop fusion if enable_native_cpu_codegen is set, and the rest by AKG.
+void CpuGraphKernelBuild(const std::vector<AnfNodePtr> &anf_nodes);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_KERNEL_MOD_H_
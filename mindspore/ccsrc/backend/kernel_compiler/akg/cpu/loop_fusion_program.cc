@@ -0,0 +1,1087 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_program.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include "abstract/utils.h"
+#include "base/float16.h"
+#include "common/thread_pool.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+using graphkernel::inner::DShape;
+using graphkernel::inner::LiteGraphPtr;
+using graphkernel::inner::Node;
+using graphkernel::inner::NodePtr;
+using graphkernel::inner::NType;
+using graphkernel::inner::PrimOp;
+
+namespace {
+// The number of elements computed by an instruction at a time, the registers of a stage should fit in the cache.
+constexpr size_t kTileSize = 256;
+// A stage with less elements runs in one thread.
+constexpr size_t kParallelMinElements = 32768;
+constexpr size_t kSelectInputNum = 3;
+constexpr size_t kInplaceAssignValueIdx = 1;
+constexpr size_t kInplaceAssignOutputIdx = 2;
+
+size_t ShapeSize(const DShape &shape) {
+  size_t size = 1;
+  for (auto dim : shape) {
+    size *= static_cast<size_t>(dim);
+  }
+  return size;
+}
+
+std::vector<int64_t> ContiguousStrides(const DShape &shape) {
+  std::vector<int64_t> strides(shape.size(), 1);
+  for (size_t i = shape.size(); i > 1; --i) {
+    strides[i - 2] = strides[i - 1] * shape[i - 1];
+  }
+  return strides;
+}
+
+bool IsContiguous(const DShape &shape, const std::vector<int64_t> &strides) {
+  auto contiguous = ContiguousStrides(shape);
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] != 1 && strides[i] != contiguous[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsSupportedType(TypeId type) {
+  return type == kNumberTypeFloat32 || type == kNumberTypeFloat16 || type == kNumberTypeBool;
+}
+
+bool IsSupportedFormat(const std::string &format) {
+  return format == kOpFormat_DEFAULT || format == kOpFormat_ND || format == kOpFormat_NCHW ||
+         format == kOpFormat_NHWC;
+}
+
+std::vector<int64_t> GetIntList(const ValuePtr &value) {
+  std::vector<int64_t> result;
+  if (value == nullptr) {
+    return result;
+  }
+  auto to_int = [](const ValuePtr &v) -> int64_t {
+    return v->isa<Int64Imm>() ? GetValue<int64_t>(v) : static_cast<int64_t>(GetValue<int>(v));
+  };
+  if (value->isa<ValueSequeue>()) {
+    for (const auto &v : value->cast<ValueSequeuePtr>()->value()) {
+      result.push_back(to_int(v));
+    }
+  } else {
+    result.push_back(to_int(value));
+  }
+  return result;
+}
+
+template <typename T>
+void ToFloat(const void *data, size_t size, std::vector<float> *result) {
+  auto src = static_cast<const T *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    (*result)[i] = static_cast<float>(src[i]);
+  }
+}
+
+bool TensorToFloat(const tensor::TensorPtr &tensor, std::vector<float> *result) {
+  auto size = LongToSize(tensor->DataSize());
+  result->resize(size);
+  switch (tensor->data_type()) {
+    case kNumberTypeFloat32:
+      ToFloat<float>(tensor->data_c(), size, result);
+      return true;
+    case kNumberTypeFloat16:
+      ToFloat<float16>(tensor->data_c(), size, result);
+      return true;
+    case kNumberTypeFloat64:
+      ToFloat<double>(tensor->data_c(), size, result);
+      return true;
+    case kNumberTypeInt32:
+      ToFloat<int32_t>(tensor->data_c(), size, result);
+      return true;
+    case kNumberTypeInt64:
+      ToFloat<int64_t>(tensor->data_c(), size, result);
+      return true;
+    case kNumberTypeBool:
+      ToFloat<bool>(tensor->data_c(), size, result);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Get the strides of a tensor broadcast to the shape, the leading dims of size 1 of the tensor can be dropped.
+bool BroadcastStrides(const DShape &tensor_shape, const std::vector<int64_t> &tensor_strides, const DShape &shape,
+                      std::vector<int64_t> *strides) {
+  size_t skip = 0;
+  while (tensor_shape.size() - skip > shape.size()) {
+    if (tensor_shape[skip] != 1) {
+      return false;
+    }
+    ++skip;
+  }
+  strides->assign(shape.size(), 0);
+  auto offset = shape.size() - (tensor_shape.size() - skip);
+  for (size_t i = skip; i < tensor_shape.size(); ++i) {
+    auto dim = offset + i - skip;
+    if (tensor_shape[i] == shape[dim]) {
+      (*strides)[dim] = shape[dim] == 1 ? 0 : tensor_strides[i];
+    } else if (tensor_shape[i] != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+inline float LoadValue(T value) {
+  return static_cast<float>(value);
+}
+
+template <typename T>
+inline T StoreValue(float value) {
+  return static_cast<T>(value);
+}
+
+template <>
+inline bool StoreValue<bool>(float value) {
+  return value != 0;
+}
+
+template <>
+inline float16 StoreValue<float16>(float value) {
+  return float16(value);
+}
+
+template <typename T>
+void LoadElements(const T *src, int64_t step, size_t len, float *dst) {
+  if (step == 1) {
+    for (size_t i = 0; i < len; ++i) {
+      dst[i] = LoadValue(src[i]);
+    }
+  } else if (step == 0) {
+    std::fill(dst, dst + len, LoadValue(src[0]));
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      dst[i] = LoadValue(src[static_cast<int64_t>(i) * step]);
+    }
+  }
+}
+
+template <typename T>
+void StoreElements(const float *src, int64_t step, size_t len, T *dst) {
+  if (step == 1) {
+    for (size_t i = 0; i < len; ++i) {
+      dst[i] = StoreValue<T>(src[i]);
+    }
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      dst[static_cast<int64_t>(i) * step] = StoreValue<T>(src[i]);
+    }
+  }
+}
+
+struct SumOp {
+  static float Identity() { return 0; }
+  float operator()(float a, float b) const { return a + b; }
+};
+
+struct MaxOp {
+  static float Identity() { return -std::numeric_limits<float>::infinity(); }
+  float operator()(float a, float b) const { return std::max(a, b); }
+};
+
+struct MinOp {
+  static float Identity() { return std::numeric_limits<float>::infinity(); }
+  float operator()(float a, float b) const { return std::min(a, b); }
+};
+
+template <typename F>
+void ReduceElements(const float *src, int64_t step, size_t len, float *dst, F f) {
+  if (step == 0) {
+    float acc = F::Identity();
+    for (size_t i = 0; i < len; ++i) {
+      acc = f(acc, src[i]);
+    }
+    dst[0] = f(dst[0], acc);
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      auto &value = dst[static_cast<int64_t>(i) * step];
+      value = f(value, src[i]);
+    }
+  }
+}
+
+template <typename F>
+inline void Unary(const float *x, size_t len, float *y, F f) {
+  for (size_t i = 0; i < len; ++i) {
+    y[i] = f(x[i]);
+  }
+}
+
+template <typename F>
+inline void Binary(const float *x, const float *y, size_t len, float *z, F f) {
+  for (size_t i = 0; i < len; ++i) {
+    z[i] = f(x[i], y[i]);
+  }
+}
+}  // namespace
+
+class LoopFusionCompiler {
+ public:
+  explicit LoopFusionCompiler(LoopFusionProgram *program) : program_(program) {}
+  ~LoopFusionCompiler() = default;
+
+  bool Compile(const LiteGraphPtr &graph);
+  static bool IsSupportedOpName(const std::string &name);
+
+ private:
+  using OpCode = LoopFusionProgram::OpCode;
+  using BufferKind = LoopFusionProgram::BufferKind;
+  using Stage = LoopFusionProgram::Stage;
+  using Instr = LoopFusionProgram::Instr;
+
+  // A tensor in a buffer, the strides are the ones of its shape.
+  struct View {
+    size_t buffer;
+    TypeId type;
+    DShape shape;
+    std::vector<int64_t> strides;
+    // The level of the stage which writes the buffer, -1 for the inputs and the constants.
+    int level;
+  };
+
+  // An expression computed on the elements of the shape and written to the target.
+  struct Sink {
+    NodePtr expr;
+    OpCode code;
+    View target;
+    DShape shape;
+    int level;
+  };
+
+  struct StageContext {
+    Stage *stage;
+    DShape shape;
+    mindspore::HashMap<Node *, size_t> regs;
+    std::set<size_t> const_regs;
+    size_t reg_num{0};
+  };
+
+  static const mindspore::HashMap<std::string, OpCode> &ElemwiseOps();
+  static size_t SrcNum(OpCode code);
+  static bool HasDst(OpCode code) {
+    return code != OpCode::kStore && code != OpCode::kReduceSum && code != OpCode::kReduceMax &&
+           code != OpCode::kReduceMin;
+  }
+
+  bool AddOp(const NodePtr &op);
+  bool AddReduce(const NodePtr &op);
+  bool GetView(const NodePtr &node, View *view);
+  View Materialize(const NodePtr &node);
+  size_t AddBuffer(BufferKind kind, size_t index);
+  int Level(const NodePtr &node);
+  void AddSink(const NodePtr &expr, OpCode code, const View &target, const DShape &shape);
+  bool GenStage(const std::vector<const Sink *> &sinks, Stage *stage);
+  bool Gen(const NodePtr &node, StageContext *context, size_t *reg);
+  bool AddAccess(const View &view, StageContext *context, size_t *access);
+  static void AllocateRegisters(StageContext *context);
+  static void CoalesceDims(Stage *stage);
+
+  LoopFusionProgram *program_;
+  NodePtr output_;
+  // The inputs, the constants and the results of the reduces and the view ops.
+  mindspore::HashMap<Node *, View> views_;
+  // The computed values written to the workspaces for the view ops.
+  mindspore::HashMap<Node *, View> materialized_;
+  mindspore::HashMap<Node *, int> levels_;
+  // The outputs written by the reduces.
+  std::set<size_t> written_outputs_;
+  std::vector<Sink> sinks_;
+};
+
+const mindspore::HashMap<std::string, LoopFusionProgram::OpCode> &LoopFusionCompiler::ElemwiseOps() {
+  static const mindspore::HashMap<std::string, OpCode> ops = {
+    {"Abs", OpCode::kAbs},
+    {"Neg", OpCode::kNeg},
+    {"Exp", OpCode::kExp},
+    {"Log", OpCode::kLog},
+    {"Sqrt", OpCode::kSqrt},
+    {"Rsqrt", OpCode::kRsqrt},
+    {"Reciprocal", OpCode::kReciprocal},
+    {"Tanh", OpCode::kTanh},
+    {"Erf", OpCode::kErf},
+    {"Sin", OpCode::kSin},
+    {"Cos", OpCode::kCos},
+    {"Round", OpCode::kRound},
+    {"Floor", OpCode::kFloor},
+    {"Sign", OpCode::kSign},
+    {"LogicalNot", OpCode::kLogicalNot},
+    {"IsNan", OpCode::kIsNan},
+    {"IsInf", OpCode::kIsInf},
+    {"IsFinite", OpCode::kIsFinite},
+    {"Add", OpCode::kAdd},
+    {"Sub", OpCode::kSub},
+    {"Mul", OpCode::kMul},
+    {"RealDiv", OpCode::kDiv},
+    {"Div", OpCode::kDiv},
+    {"Maximum", OpCode::kMaximum},
+    {"Minimum", OpCode::kMinimum},
+    {"Pow", OpCode::kPow},
+    {"Equal", OpCode::kEqual},
+    {"NotEqual", OpCode::kNotEqual},
+    {"Less", OpCode::kLess},
+    {"LessEqual", OpCode::kLessEqual},
+    {"Greater", OpCode::kGreater},
+    {"GreaterEqual", OpCode::kGreaterEqual},
+    {"LogicalAnd", OpCode::kLogicalAnd},
+    {"LogicalOr", OpCode::kLogicalOr},
+    {"Select", OpCode::kSelect},
+  };
+  return ops;
+}
+
+size_t LoopFusionCompiler::SrcNum(OpCode code) {
+  if (code == OpCode::kConst || code == OpCode::kLoad) {
+    return 0;
+  }
+  if (code == OpCode::kSelect) {
+    return kSelectInputNum;
+  }
+  return code >= OpCode::kAdd ? 2 : 1;
+}
+
+size_t LoopFusionCompiler::AddBuffer(BufferKind kind, size_t index) {
+  program_->buffers_.push_back({kind, index});
+  return program_->buffers_.size() - 1;
+}
+
+int LoopFusionCompiler::Level(const NodePtr &node) {
+  auto view_iter = views_.find(node.get());
+  if (view_iter != views_.end()) {
+    return view_iter->second.level;
+  }
+  if (node->NodeType() != NType::Primitive) {
+    return -1;
+  }
+  auto iter = levels_.find(node.get());
+  if (iter != levels_.end()) {
+    return iter->second;
+  }
+  int level = -1;
+  for (const auto &input : node->inputs()) {
+    level = std::max(level, Level(input));
+  }
+  levels_[node.get()] = level;
+  return level;
+}
+
+void LoopFusionCompiler::AddSink(const NodePtr &expr, OpCode code, const View &target, const DShape &shape) {
+  sinks_.push_back({expr, code, target, shape, Level(expr) + 1});
+}
+
+LoopFusionCompiler::View LoopFusionCompiler::Materialize(const NodePtr &node) {
+  auto buffer = AddBuffer(BufferKind::kWorkspace, program_->workspace_size_list_.size());
+  program_->workspace_size_list_.push_back(ShapeSize(node->shape) * sizeof(float));
+  View view{buffer, kNumberTypeFloat32, node->shape, ContiguousStrides(node->shape), 0};
+  AddSink(node, OpCode::kStore, view, node->shape);
+  view.level = sinks_.back().level;
+  return view;
+}
+
+bool LoopFusionCompiler::GetView(const NodePtr &node, View *view) {
+  auto iter = views_.find(node.get());
+  if (iter != views_.end()) {
+    *view = iter->second;
+    return true;
+  }
+  if (node->NodeType() == NType::Value) {
+    std::vector<float> data;
+    if (!TensorToFloat(node->As<graphkernel::inner::ConstTensorNode>()->data(), &data)) {
+      MS_LOG(INFO) << "The constant " << node->name() << " of type " << TypeIdToString(node->type)
+                   << " is not supported.";
+      return false;
+    }
+    auto buffer = AddBuffer(BufferKind::kConst, program_->const_data_.size());
+    program_->const_data_.push_back(std::move(data));
+    *view = View{buffer, kNumberTypeFloat32, node->shape, ContiguousStrides(node->shape), -1};
+    views_[node.get()] = *view;
+    return true;
+  }
+  // The computed values are still computed in the loops of their other users, only the view ops read the buffer.
+  auto materialized = materialized_.find(node.get());
+  if (materialized == materialized_.end()) {
+    materialized = materialized_.emplace(node.get(), Materialize(node)).first;
+  }
+  *view = materialized->second;
+  return true;
+}
+
+bool LoopFusionCompiler::AddReduce(const NodePtr &op) {
+  const auto &input_shape = op->input(0)->shape;
+  auto axis = GetIntList(op->attrs().count("axis") > 0 ? op->attrs().at("axis") : nullptr);
+  auto rank = SizeToLong(input_shape.size());
+  DShape keep_dims_shape = input_shape;
+  if (axis.empty()) {
+    std::fill(keep_dims_shape.begin(), keep_dims_shape.end(), 1);
+  }
+  for (auto x : axis) {
+    if (x < -rank || x >= rank) {
+      MS_LOG(INFO) << "The axis " << x << " of " << op->name() << " is out of range.";
+      return false;
+    }
+    keep_dims_shape[LongToSize(x < 0 ? x + rank : x)] = 1;
+  }
+  if (ShapeSize(keep_dims_shape) != ShapeSize(op->shape)) {
+    MS_LOG(INFO) << "The shape of " << op->name() << " does not match its axis.";
+    return false;
+  }
+  auto code = op->As<PrimOp>()->op() == "ReduceSum"
+                ? OpCode::kReduceSum
+                : (op->As<PrimOp>()->op() == "ReduceMax" ? OpCode::kReduceMax : OpCode::kReduceMin);
+  // The reduce is accumulated in float32, in the output if possible.
+  View target{0, kNumberTypeFloat32, keep_dims_shape, ContiguousStrides(keep_dims_shape), 0};
+  const auto &outputs = output_->inputs();
+  auto iter = std::find(outputs.begin(), outputs.end(), op);
+  if (iter != outputs.end() && op->type == kNumberTypeFloat32) {
+    auto index = static_cast<size_t>(iter - outputs.begin());
+    target.buffer = AddBuffer(BufferKind::kOutput, index);
+    (void)written_outputs_.insert(index);
+  } else {
+    target.buffer = AddBuffer(BufferKind::kWorkspace, program_->workspace_size_list_.size());
+    program_->workspace_size_list_.push_back(ShapeSize(keep_dims_shape) * sizeof(float));
+  }
+  AddSink(op->input(0), code, target, input_shape);
+  views_[op.get()] = View{target.buffer, kNumberTypeFloat32, op->shape, ContiguousStrides(op->shape),
+                          sinks_.back().level};
+  return true;
+}
+
+bool LoopFusionCompiler::IsSupportedOpName(const std::string &name) {
+  static const std::set<std::string> other_ops = {"ReduceSum", "ReduceMax", "ReduceMin", "Reshape",
+                                                  "Transpose", "InplaceAssign", "Cast", "BroadcastTo"};
+  return other_ops.count(name) > 0 || ElemwiseOps().count(name) > 0;
+}
+
+bool LoopFusionCompiler::AddOp(const NodePtr &op) {
+  if (!IsSupportedType(op->type) || !IsSupportedFormat(op->format)) {
+    MS_LOG(INFO) << "The type " << TypeIdToString(op->type) << " or the format " << op->format << " of "
+                 << op->name() << " is not supported.";
+    return false;
+  }
+  const auto &name = op->As<PrimOp>()->op();
+  if (name == "ReduceSum" || name == "ReduceMax" || name == "ReduceMin") {
+    return AddReduce(op);
+  }
+  if (name == "Reshape" || name == "Transpose") {
+    View input;
+    if (!GetView(op->input(0), &input)) {
+      return false;
+    }
+    if (name == "Reshape") {
+      if (!IsContiguous(input.shape, input.strides)) {
+        input = Materialize(op->input(0));
+      }
+      views_[op.get()] = View{input.buffer, input.type, op->shape, ContiguousStrides(op->shape), input.level};
+      return true;
+    }
+    auto perm = GetIntList(op->attrs().count("perm") > 0 ? op->attrs().at("perm") : nullptr);
+    if (perm.size() != input.shape.size()) {
+      MS_LOG(INFO) << "The perm of " << op->name() << " does not match its input.";
+      return false;
+    }
+    View view = input;
+    for (size_t i = 0; i < perm.size(); ++i) {
+      auto axis = perm[i] < 0 ? perm[i] + SizeToLong(perm.size()) : perm[i];
+      if (axis < 0 || axis >= SizeToLong(perm.size())) {
+        return false;
+      }
+      view.shape[i] = input.shape[LongToSize(axis)];
+      view.strides[i] = input.strides[LongToSize(axis)];
+    }
+    views_[op.get()] = view;
+    return true;
+  }
+  if (name == "InplaceAssign") {
+    auto dst = op->input(0);
+    auto iter = views_.find(dst.get());
+    if (dst->NodeType() != NType::Parameter || iter == views_.end()) {
+      MS_LOG(INFO) << "The InplaceAssign " << op->name() << " does not assign an input.";
+      return false;
+    }
+    AddSink(op->input(kInplaceAssignValueIdx), OpCode::kStore, iter->second, dst->shape);
+    return true;
+  }
+  if (name == "Cast" || name == "BroadcastTo" || ElemwiseOps().count(name) > 0) {
+    return true;
+  }
+  MS_LOG(INFO) << "The op " << name << " is not supported.";
+  return false;
+}
+
+bool LoopFusionCompiler::AddAccess(const View &view, StageContext *context, size_t *access) {
+  std::vector<int64_t> strides;
+  if (!BroadcastStrides(view.shape, view.strides, context->shape, &strides)) {
+    MS_LOG(INFO) << "The shape " << view.shape << " can not be broadcast to " << context->shape;
+    return false;
+  }
+  auto &accesses = context->stage->accesses;
+  accesses.push_back({view.buffer, view.type, strides});
+  *access = accesses.size() - 1;
+  return true;
+}
+
+bool LoopFusionCompiler::Gen(const NodePtr &node, StageContext *context, size_t *reg) {
+  auto iter = context->regs.find(node.get());
+  if (iter != context->regs.end()) {
+    *reg = iter->second;
+    return true;
+  }
+  Instr instr{OpCode::kLoad};
+  if (views_.count(node.get()) > 0) {
+    if (!AddAccess(views_[node.get()], context, &instr.access)) {
+      return false;
+    }
+  } else if (node->NodeType() == NType::Value) {
+    auto tensor = node->As<graphkernel::inner::ConstTensorNode>()->data();
+    if (tensor->DataSize() == 1) {
+      std::vector<float> data;
+      if (!TensorToFloat(tensor, &data)) {
+        return false;
+      }
+      instr.code = OpCode::kConst;
+      instr.imm = data[0];
+    } else {
+      View view;
+      if (!GetView(node, &view) || !AddAccess(view, context, &instr.access)) {
+        return false;
+      }
+    }
+  } else {
+    const auto &name = node->As<PrimOp>()->op();
+    const auto &inputs = node->inputs();
+    if (name == "BroadcastTo" || name == "InplaceAssign" || (name == "Cast" && node->type == kNumberTypeFloat32)) {
+      auto input = name == "InplaceAssign" ? inputs[kInplaceAssignOutputIdx] : inputs[0];
+      if (!Gen(input, context, reg)) {
+        return false;
+      }
+      context->regs[node.get()] = *reg;
+      return true;
+    }
+    if (name == "Cast") {
+      instr.code = node->type == kNumberTypeFloat16 ? OpCode::kCastFloat16 : OpCode::kCastBool;
+    } else {
+      instr.code = ElemwiseOps().at(name);
+    }
+    if (inputs.size() != SrcNum(instr.code)) {
+      MS_LOG(INFO) << "The input number of " << node->name() << " is " << inputs.size();
+      return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (!Gen(inputs[i], context, &instr.src[i])) {
+        return false;
+      }
+    }
+  }
+  instr.dst = context->reg_num++;
+  if (instr.code == OpCode::kConst) {
+    context->stage->consts.push_back(instr);
+    (void)context->const_regs.insert(instr.dst);
+  } else {
+    context->stage->instrs.push_back(instr);
+  }
+  context->regs[node.get()] = instr.dst;
+  *reg = instr.dst;
+  return true;
+}
+
+void LoopFusionCompiler::AllocateRegisters(StageContext *context) {
+  auto &instrs = context->stage->instrs;
+  std::map<size_t, size_t> last_use;
+  for (size_t i = 0; i < instrs.size(); ++i) {
+    for (size_t j = 0; j < SrcNum(instrs[i].code); ++j) {
+      last_use[instrs[i].src[j]] = i;
+    }
+  }
+  // The constants keep their registers, the others reuse the registers of the values which are not used any more.
+  std::map<size_t, size_t> regs;
+  size_t reg_num = 0;
+  for (auto &instr : context->stage->consts) {
+    regs[instr.dst] = reg_num;
+    instr.dst = reg_num++;
+  }
+  std::vector<size_t> free_regs;
+  for (size_t i = 0; i < instrs.size(); ++i) {
+    auto &instr = instrs[i];
+    std::set<size_t> released;
+    for (size_t j = 0; j < SrcNum(instr.code); ++j) {
+      auto src = instr.src[j];
+      instr.src[j] = regs[src];
+      if (last_use[src] == i && context->const_regs.count(src) == 0) {
+        (void)released.insert(instr.src[j]);
+      }
+    }
+    free_regs.insert(free_regs.end(), released.begin(), released.end());
+    if (!HasDst(instr.code)) {
+      continue;
+    }
+    size_t reg;
+    if (free_regs.empty()) {
+      reg = reg_num++;
+    } else {
+      reg = free_regs.back();
+      free_regs.pop_back();
+    }
+    regs[instr.dst] = reg;
+    instr.dst = reg;
+  }
+  context->stage->reg_num = reg_num;
+}
+
+void LoopFusionCompiler::CoalesceDims(Stage *stage) {
+  // Drop the dims of size 1 and merge the adjacent dims which are contiguous in all the accesses.
+  std::vector<int64_t> shape;
+  std::vector<std::vector<int64_t>> strides(stage->accesses.size());
+  for (size_t dim = 0; dim < stage->shape.size(); ++dim) {
+    auto size = stage->shape[dim];
+    if (size == 1) {
+      continue;
+    }
+    bool mergeable = !shape.empty();
+    for (size_t i = 0; i < strides.size() && mergeable; ++i) {
+      mergeable = strides[i].back() == stage->accesses[i].strides[dim] * size;
+    }
+    if (mergeable) {
+      shape.back() *= size;
+      for (size_t i = 0; i < strides.size(); ++i) {
+        strides[i].back() = stage->accesses[i].strides[dim];
+      }
+      continue;
+    }
+    shape.push_back(size);
+    for (size_t i = 0; i < strides.size(); ++i) {
+      strides[i].push_back(stage->accesses[i].strides[dim]);
+    }
+  }
+  if (shape.empty()) {
+    shape.push_back(1);
+    for (auto &s : strides) {
+      s.push_back(0);
+    }
+  }
+  stage->shape = shape;
+  for (size_t i = 0; i < strides.size(); ++i) {
+    stage->accesses[i].strides = strides[i];
+  }
+}
+
+bool LoopFusionCompiler::GenStage(const std::vector<const Sink *> &sinks, Stage *stage) {
+  StageContext context{stage, sinks.front()->shape};
+  for (auto sink : sinks) {
+    Instr instr{sink->code};
+    if (!Gen(sink->expr, &context, &instr.src[0]) || !AddAccess(sink->target, &context, &instr.access)) {
+      return false;
+    }
+    if (sink->code != OpCode::kStore) {
+      stage->accesses[instr.access].size = ShapeSize(sink->target.shape);
+    }
+    stage->instrs.push_back(instr);
+  }
+  AllocateRegisters(&context);
+  stage->shape = context.shape;
+  CoalesceDims(stage);
+  return true;
+}
+
+bool LoopFusionCompiler::Compile(const LiteGraphPtr &graph) {
+  output_ = graph->output();
+  const auto &inputs = graph->inputs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto &input = inputs[i];
+    if (!IsSupportedType(input->type)) {
+      MS_LOG(INFO) << "The type " << TypeIdToString(input->type) << " of input " << i << " is not supported.";
+      return false;
+    }
+    auto buffer = AddBuffer(BufferKind::kInput, i);
+    views_[input.get()] = View{buffer, input->type, input->shape, ContiguousStrides(input->shape), -1};
+    program_->input_size_list_.push_back(ShapeSize(input->shape) * abstract::TypeIdSize(input->type));
+  }
+  for (const auto &op : graph->ops()) {
+    if (std::any_of(op->shape.begin(), op->shape.end(), [](int64_t dim) { return dim < 0; })) {
+      MS_LOG(INFO) << "The dynamic shape of " << op->name() << " is not supported.";
+      return false;
+    }
+    if (!AddOp(op)) {
+      return false;
+    }
+  }
+  const auto &outputs = output_->inputs();
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto &output = outputs[i];
+    if (!IsSupportedType(output->type)) {
+      MS_LOG(INFO) << "The type " << TypeIdToString(output->type) << " of output " << i << " is not supported.";
+      return false;
+    }
+    program_->output_size_list_.push_back(ShapeSize(output->shape) * abstract::TypeIdSize(output->type));
+    if (written_outputs_.count(i) > 0) {
+      continue;
+    }
+    auto buffer = AddBuffer(BufferKind::kOutput, i);
+    AddSink(output, OpCode::kStore, View{buffer, output->type, output->shape, ContiguousStrides(output->shape), 0},
+            output->shape);
+  }
+  // The sinks of the same level and the same shape are computed in one loop, in the order of the levels.
+  std::map<std::pair<int, DShape>, std::vector<const Sink *>> groups;
+  for (const auto &sink : sinks_) {
+    groups[std::make_pair(sink.level, sink.shape)].push_back(&sink);
+  }
+  for (const auto &group : groups) {
+    if (ShapeSize(group.first.second) == 0) {
+      continue;
+    }
+    Stage stage;
+    if (!GenStage(group.second, &stage)) {
+      return false;
+    }
+    program_->stages_.push_back(std::move(stage));
+  }
+  return true;
+}
+
+std::shared_ptr<LoopFusionProgram> LoopFusionProgram::Compile(const LiteGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto program = std::make_shared<LoopFusionProgram>();
+  LoopFusionCompiler compiler(program.get());
+  if (!compiler.Compile(graph)) {
+    MS_LOG(INFO) << "The graph kernel " << graph->name() << " is not supported by the loop fusion.";
+    return nullptr;
+  }
+  return program;
+}
+
+bool LoopFusionProgram::IsSupportedOp(const std::string &name, const std::vector<TypeId> &types,
+                                      const std::vector<std::string> &formats) {
+  return LoopFusionCompiler::IsSupportedOpName(name) && std::all_of(types.begin(), types.end(), IsSupportedType) &&
+         std::all_of(formats.begin(), formats.end(), IsSupportedFormat);
+}
+
+void LoopFusionProgram::RunTiles(const Stage &stage, size_t tile_begin, size_t tile_end,
+                                 const std::vector<uint8_t *> &bases) const {
+  std::vector<float> regs(stage.reg_num * kTileSize);
+  auto reg = [&regs](size_t index) { return regs.data() + index * kTileSize; };
+  for (const auto &instr : stage.consts) {
+    std::fill(reg(instr.dst), reg(instr.dst) + kTileSize, instr.imm);
+  }
+  auto rank = stage.shape.size();
+  auto inner = static_cast<size_t>(stage.shape.back());
+  auto tiles_per_row = (inner + kTileSize - 1) / kTileSize;
+  std::vector<int64_t> offsets(stage.accesses.size(), 0);
+  size_t current_row = SIZE_MAX;
+  for (size_t tile = tile_begin; tile < tile_end; ++tile) {
+    auto row = tile / tiles_per_row;
+    if (row != current_row) {
+      current_row = row;
+      std::fill(offsets.begin(), offsets.end(), 0);
+      auto index = row;
+      for (size_t dim = rank - 1; dim > 0; --dim) {
+        auto size = static_cast<size_t>(stage.shape[dim - 1]);
+        auto coord = static_cast<int64_t>(index % size);
+        index /= size;
+        for (size_t i = 0; i < offsets.size(); ++i) {
+          offsets[i] += coord * stage.accesses[i].strides[dim - 1];
+        }
+      }
+    }
+    auto start = (tile % tiles_per_row) * kTileSize;
+    auto len = std::min(kTileSize, inner - start);
+    for (const auto &instr : stage.instrs) {
+      auto dst = reg(instr.dst);
+      auto x = reg(instr.src[0]);
+      auto y = reg(instr.src[1]);
+      switch (instr.code) {
+        case OpCode::kLoad:
+        case OpCode::kStore:
+        case OpCode::kReduceSum:
+        case OpCode::kReduceMax:
+        case OpCode::kReduceMin: {
+          const auto &access = stage.accesses[instr.access];
+          auto step = access.strides[rank - 1];
+          auto offset = offsets[instr.access] + static_cast<int64_t>(start) * step;
+          auto base = bases[access.buffer];
+          if (instr.code == OpCode::kReduceSum) {
+            ReduceElements(x, step, len, reinterpret_cast<float *>(base) + offset, SumOp());
+          } else if (instr.code == OpCode::kReduceMax) {
+            ReduceElements(x, step, len, reinterpret_cast<float *>(base) + offset, MaxOp());
+          } else if (instr.code == OpCode::kReduceMin) {
+            ReduceElements(x, step, len, reinterpret_cast<float *>(base) + offset, MinOp());
+          } else if (instr.code == OpCode::kLoad) {
+            if (access.type == kNumberTypeFloat32) {
+              LoadElements(reinterpret_cast<const float *>(base) + offset, step, len, dst);
+            } else if (access.type == kNumberTypeFloat16) {
+              LoadElements(reinterpret_cast<const float16 *>(base) + offset, step, len, dst);
+            } else {
+              LoadElements(reinterpret_cast<const bool *>(base) + offset, step, len, dst);
+            }
+          } else {
+            if (access.type == kNumberTypeFloat32) {
+              StoreElements(x, step, len, reinterpret_cast<float *>(base) + offset);
+            } else if (access.type == kNumberTypeFloat16) {
+              StoreElements(x, step, len, reinterpret_cast<float16 *>(base) + offset);
+            } else {
+              StoreElements(x, step, len, reinterpret_cast<bool *>(base) + offset);
+            }
+          }
+          break;
+        }
+        case OpCode::kAbs:
+          Unary(x, len, dst, [](float a) { return std::fabs(a); });
+          break;
+        case OpCode::kNeg:
+          Unary(x, len, dst, [](float a) { return -a; });
+          break;
+        case OpCode::kExp:
+          Unary(x, len, dst, [](float a) { return std::exp(a); });
+          break;
+        case OpCode::kLog:
+          Unary(x, len, dst, [](float a) { return std::log(a); });
+          break;
+        case OpCode::kSqrt:
+          Unary(x, len, dst, [](float a) { return std::sqrt(a); });
+          break;
+        case OpCode::kRsqrt:
+          Unary(x, len, dst, [](float a) { return 1.0f / std::sqrt(a); });
+          break;
+        case OpCode::kReciprocal:
+          Unary(x, len, dst, [](float a) { return 1.0f / a; });
+          break;
+        case OpCode::kTanh:
+          Unary(x, len, dst, [](float a) { return std::tanh(a); });
+          break;
+        case OpCode::kErf:
+          Unary(x, len, dst, [](float a) { return std::erf(a); });
+          break;
+        case OpCode::kSin:
+          Unary(x, len, dst, [](float a) { return std::sin(a); });
+          break;
+        case OpCode::kCos:
+          Unary(x, len, dst, [](float a) { return std::cos(a); });
+          break;
+        case OpCode::kRound:
+          Unary(x, len, dst, [](float a) { return std::nearbyint(a); });
+          break;
+        case OpCode::kFloor:
+          Unary(x, len, dst, [](float a) { return std::floor(a); });
+          break;
+        case OpCode::kSign:
+          Unary(x, len, dst, [](float a) { return static_cast<float>((a > 0) - (a < 0)); });
+          break;
+        case OpCode::kLogicalNot:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(a == 0); });
+          break;
+        case OpCode::kIsNan:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(std::isnan(a)); });
+          break;
+        case OpCode::kIsInf:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(std::isinf(a)); });
+          break;
+        case OpCode::kIsFinite:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(std::isfinite(a)); });
+          break;
+        case OpCode::kCastFloat16:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(float16(a)); });
+          break;
+        case OpCode::kCastBool:
+          Unary(x, len, dst, [](float a) { return static_cast<float>(a != 0); });
+          break;
+        case OpCode::kAdd:
+          Binary(x, y, len, dst, [](float a, float b) { return a + b; });
+          break;
+        case OpCode::kSub:
+          Binary(x, y, len, dst, [](float a, float b) { return a - b; });
+          break;
+        case OpCode::kMul:
+          Binary(x, y, len, dst, [](float a, float b) { return a * b; });
+          break;
+        case OpCode::kDiv:
+          Binary(x, y, len, dst, [](float a, float b) { return a / b; });
+          break;
+        case OpCode::kMaximum:
+          Binary(x, y, len, dst, [](float a, float b) { return std::max(a, b); });
+          break;
+        case OpCode::kMinimum:
+          Binary(x, y, len, dst, [](float a, float b) { return std::min(a, b); });
+          break;
+        case OpCode::kPow:
+          Binary(x, y, len, dst, [](float a, float b) { return std::pow(a, b); });
+          break;
+        case OpCode::kEqual:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a == b); });
+          break;
+        case OpCode::kNotEqual:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a != b); });
+          break;
+        case OpCode::kLess:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a < b); });
+          break;
+        case OpCode::kLessEqual:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a <= b); });
+          break;
+        case OpCode::kGreater:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a > b); });
+          break;
+        case OpCode::kGreaterEqual:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a >= b); });
+          break;
+        case OpCode::kLogicalAnd:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a != 0 && b != 0); });
+          break;
+        case OpCode::kLogicalOr:
+          Binary(x, y, len, dst, [](float a, float b) { return static_cast<float>(a != 0 || b != 0); });
+          break;
+        case OpCode::kSelect: {
+          auto z = reg(instr.src[2]);
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = x[i] != 0 ? y[i] : z[i];
+          }
+          break;
+        }
+        default:
+          MS_LOG(EXCEPTION) << "Unknown op code " << static_cast<int>(instr.code);
+      }
+    }
+  }
+}
+
+void LoopFusionProgram::RunStage(const Stage &stage, const std::vector<uint8_t *> &bases) const {
+  size_t elements = ShapeSize(stage.shape);
+  auto inner = static_cast<size_t>(stage.shape.back());
+  auto rows = elements / inner;
+  auto tiles_per_row = (inner + kTileSize - 1) / kTileSize;
+  auto tile_num = rows * tiles_per_row;
+  std::vector<const Instr *> reduces;
+  for (const auto &instr : stage.instrs) {
+    if (instr.code == OpCode::kReduceSum || instr.code == OpCode::kReduceMax || instr.code == OpCode::kReduceMin) {
+      reduces.push_back(&instr);
+    }
+  }
+  auto identity = [](const Instr *reduce) {
+    return reduce->code == OpCode::kReduceSum ? SumOp::Identity()
+                                              : (reduce->code == OpCode::kReduceMax ? MaxOp::Identity()
+                                                                                    : MinOp::Identity());
+  };
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  auto task_num = std::min({thread_pool.GetSyncRunThreadNum(), elements / kParallelMinElements + 1, tile_num});
+  // The tasks of a reduce write different elements if the first dim is not reduced, else each task reduces into its
+  // own buffers which are merged at last.
+  bool split_first_dim = !reduces.empty() && stage.shape.size() > 1 &&
+                         std::all_of(reduces.begin(), reduces.end(), [&stage](const Instr *reduce) {
+                           return stage.accesses[reduce->access].strides[0] != 0;
+                         });
+  size_t tile_align = 1;
+  if (split_first_dim) {
+    tile_align = tile_num / static_cast<size_t>(stage.shape[0]);
+    task_num = std::min(task_num, static_cast<size_t>(stage.shape[0]));
+  }
+  bool private_reduce = !reduces.empty() && !split_first_dim && task_num > 1;
+  if (!private_reduce) {
+    for (auto reduce : reduces) {
+      const auto &info = stage.accesses[reduce->access];
+      auto target = reinterpret_cast<float *>(bases[info.buffer]);
+      std::fill(target, target + info.size, identity(reduce));
+    }
+  }
+  if (task_num <= 1) {
+    RunTiles(stage, 0, tile_num, bases);
+    return;
+  }
+  auto units = tile_num / tile_align;
+  std::vector<std::vector<uint8_t *>> task_bases(task_num, bases);
+  std::vector<std::vector<std::vector<float>>> private_buffers(task_num);
+  std::vector<common::Task> tasks;
+  for (size_t t = 0; t < task_num; ++t) {
+    auto begin = units * t / task_num * tile_align;
+    auto end = units * (t + 1) / task_num * tile_align;
+    if (private_reduce) {
+      for (auto reduce : reduces) {
+        const auto &info = stage.accesses[reduce->access];
+        private_buffers[t].emplace_back(info.size, identity(reduce));
+        task_bases[t][info.buffer] = reinterpret_cast<uint8_t *>(private_buffers[t].back().data());
+      }
+    }
+    tasks.emplace_back([this, &stage, &task_bases, t, begin, end]() {
+      RunTiles(stage, begin, end, task_bases[t]);
+      return common::SUCCESS;
+    });
+  }
+  (void)thread_pool.SyncRun(tasks);
+  if (!private_reduce) {
+    return;
+  }
+  for (size_t i = 0; i < reduces.size(); ++i) {
+    const auto &info = stage.accesses[reduces[i]->access];
+    auto target = reinterpret_cast<float *>(bases[info.buffer]);
+    auto code = reduces[i]->code;
+    for (size_t k = 0; k < info.size; ++k) {
+      float value = private_buffers[0][i][k];
+      for (size_t t = 1; t < task_num; ++t) {
+        auto other = private_buffers[t][i][k];
+        value = code == OpCode::kReduceSum ? value + other
+                                           : (code == OpCode::kReduceMax ? std::max(value, other)
+                                                                         : std::min(value, other));
+      }
+      target[k] = value;
+    }
+  }
+}
+
+void LoopFusionProgram::Run(const std::vector<void *> &inputs, const std::vector<void *> &workspaces,
+                            const std::vector<void *> &outputs) const {
+  std::vector<uint8_t *> bases;
+  for (const auto &buffer : buffers_) {
+    void *base = nullptr;
+    switch (buffer.kind) {
+      case BufferKind::kInput:
+        base = inputs.at(buffer.index);
+        break;
+      case BufferKind::kOutput:
+        base = outputs.at(buffer.index);
+        break;
+      case BufferKind::kWorkspace:
+        base = workspaces.at(buffer.index);
+        break;
+      default:
+        base = const_cast<float *>(const_data_.at(buffer.index).data());
+        break;
+    }
+    bases.push_back(static_cast<uint8_t *>(base));
+  }
+  for (const auto &stage : stages_) {
+    RunStage(stage, bases);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
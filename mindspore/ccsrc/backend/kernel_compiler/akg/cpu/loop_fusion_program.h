@@ -0,0 +1,148 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_PROGRAM_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_PROGRAM_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/optimizer/graph_kernel/model/lite_graph.h"
+
+namespace mindspore {
+namespace kernel {
+class LoopFusionCompiler;
+
+// The fused loops of a graph kernel made of elementwise, broadcast, reshape, transpose and reduce ops, run by an
+// interpreter of instructions on tiles of elements. A stage computes the values of the same shape tile by tile so
+// that the intermediate values stay in the cache, and the results of the reduces are kept in the workspaces for the
+// later stages. The values are computed in float32 and converted when they are loaded and stored.
+class LoopFusionProgram {
+ public:
+  LoopFusionProgram() = default;
+  ~LoopFusionProgram() = default;
+
+  // Return nullptr if the graph has an op, a data type or a shape which is not supported.
+  static std::shared_ptr<LoopFusionProgram> Compile(const graphkernel::inner::LiteGraphPtr &graph);
+  // Whether a basic op of the name, whose inputs and outputs have the types and the formats, can be compiled.
+  static bool IsSupportedOp(const std::string &name, const std::vector<TypeId> &types,
+                            const std::vector<std::string> &formats);
+
+  const std::vector<size_t> &input_size_list() const { return input_size_list_; }
+  const std::vector<size_t> &output_size_list() const { return output_size_list_; }
+  const std::vector<size_t> &workspace_size_list() const { return workspace_size_list_; }
+  size_t stage_num() const { return stages_.size(); }
+
+  void Run(const std::vector<void *> &inputs, const std::vector<void *> &workspaces,
+           const std::vector<void *> &outputs) const;
+
+ private:
+  friend class LoopFusionCompiler;
+
+  enum class OpCode {
+    kConst,
+    kLoad,
+    kStore,
+    kReduceSum,
+    kReduceMax,
+    kReduceMin,
+    // unary
+    kAbs,
+    kNeg,
+    kExp,
+    kLog,
+    kSqrt,
+    kRsqrt,
+    kReciprocal,
+    kTanh,
+    kErf,
+    kSin,
+    kCos,
+    kRound,
+    kFloor,
+    kSign,
+    kLogicalNot,
+    kIsNan,
+    kIsInf,
+    kIsFinite,
+    kCastFloat16,
+    kCastBool,
+    // binary
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kMaximum,
+    kMinimum,
+    kPow,
+    kEqual,
+    kNotEqual,
+    kLess,
+    kLessEqual,
+    kGreater,
+    kGreaterEqual,
+    kLogicalAnd,
+    kLogicalOr,
+    // ternary
+    kSelect,
+  };
+
+  enum class BufferKind { kInput, kOutput, kWorkspace, kConst };
+
+  struct Buffer {
+    BufferKind kind;
+    size_t index;
+  };
+
+  // The elements of a buffer read or written by a stage, the strides are the ones of the stage dims.
+  struct Access {
+    size_t buffer;
+    TypeId type;
+    std::vector<int64_t> strides;
+    // The number of elements of the buffer, only set for the reduces.
+    size_t size{0};
+  };
+
+  struct Instr {
+    OpCode code;
+    size_t dst{0};
+    size_t src[3]{0, 0, 0};
+    size_t access{0};
+    float imm{0};
+  };
+
+  struct Stage {
+    std::vector<int64_t> shape;
+    std::vector<Access> accesses;
+    // The constants are filled once for each task.
+    std::vector<Instr> consts;
+    std::vector<Instr> instrs;
+    size_t reg_num{0};
+  };
+
+  void RunStage(const Stage &stage, const std::vector<uint8_t *> &bases) const;
+  void RunTiles(const Stage &stage, size_t tile_begin, size_t tile_end, const std::vector<uint8_t *> &bases) const;
+
+  std::vector<Buffer> buffers_;
+  std::vector<std::vector<float>> const_data_;
+  std::vector<Stage> stages_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+using LoopFusionProgramPtr = std::shared_ptr<LoopFusionProgram>;
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_AKG_CPU_LOOP_FUSION_PROGRAM_H_
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/bf16/cast_bf16.h"
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+#ifdef ENABLE_ARM64
+#include <arm_neon.h>
+#endif
+#include "nnacl/nnacl_utils.h"
+
+#if defined(ENABLE_AVX) && defined(NNACL_AVX512_BF16_TARGET)
+#define CAST_BF16_AVX512
+__attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl,avx512bf16"))) static int Float32ToBf16Avx512(
+  const float *src, bf16_t *dst, int count) {
+  int i = 0;
+  for (; i + C16NUM <= count; i += C16NUM) {
+    __m256bh value = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256((__m256i *)(dst + i), (__m256i)value);
+  }
+  return i;
+}
+#endif
+
+void Float32ToBf16(const float *src, bf16_t *dst, int count) {
+  int i = 0;
+#ifdef CAST_BF16_AVX512
+  if (GetX86Isa() >= X86_ISA_AVX512_BF16) {
+    i = Float32ToBf16Avx512(src, dst, count);
+  }
+#endif
+#ifdef ENABLE_AVX
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i round = _mm256_set1_epi32(0x7fff);
+  const __m256i quiet = _mm256_set1_epi32(0x400000);
+  for (; i + C16NUM <= count; i += C16NUM) {
+    __m256i half[C2NUM];
+    for (int h = 0; h < C2NUM; h++) {
+      __m256 value = _mm256_loadu_ps(src + i + h * C8NUM);
+      __m256i bits = _mm256_castps_si256(value);
+      __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+      __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(lsb, round));
+      __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+      rounded = _mm256_blendv_epi8(rounded, _mm256_or_si256(bits, quiet), nan);
+      half[h] = _mm256_srli_epi32(rounded, 16);
+    }
+    // packus interleaves the 128-bit lanes of its inputs, the permute puts them back in order
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(half[0], half[1]), 0xD8);
+    _mm256_storeu_si256((__m256i *)(dst + i), packed);
+  }
+#elif defined(ENABLE_ARM64)
+  for (; i + C4NUM <= count; i += C4NUM) {
+    float32x4_t value = vld1q_f32(src + i);
+    uint32x4_t bits = vreinterpretq_u32_f32(value);
+    uint32x4_t lsb = vandq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(1));
+    uint32x4_t rounded = vaddq_u32(bits, vaddq_u32(lsb, vdupq_n_u32(0x7fff)));
+    uint32x4_t nan = vmvnq_u32(vceqq_f32(value, value));
+    rounded = vbslq_u32(nan, vorrq_u32(bits, vdupq_n_u32(0x400000)), rounded);
+    vst1_u16(dst + i, vshrn_n_u32(rounded, 16));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = Fp32ToBf16(src[i]);
+  }
+}
+
+void Bf16ToFloat32(const bf16_t *src, float *dst, int count) {
+  int i = 0;
+#ifdef ENABLE_AVX
+  for (; i + C8NUM <= count; i += C8NUM) {
+    __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+  }
+#elif defined(ENABLE_ARM64)
+  for (; i + C4NUM <= count; i += C4NUM) {
+    vst1q_f32(dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = Bf16ToFp32(src[i]);
+  }
+}
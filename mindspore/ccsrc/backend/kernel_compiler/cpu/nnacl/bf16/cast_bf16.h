@@ -0,0 +1,57 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_BF16_CAST_BF16_H_
+#define MINDSPORE_NNACL_BF16_CAST_BF16_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* bfloat16 is the upper half of a float32, kept as its raw bits. The bf16 kernels only store bf16 and do their math,
+ * and all accumulation, in float32. */
+typedef uint16_t bf16_t;
+
+static inline float Bf16ToFp32(bf16_t value) {
+  uint32_t bits = (uint32_t)value << 16;
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+/* rounds to nearest even like the avx512 bf16 instructions and keeps nan a quiet nan. Unlike them it keeps denormals,
+ * which the instructions flush to zero. */
+static inline bf16_t Fp32ToBf16(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    return (bf16_t)((bits >> 16) | 0x40u);
+  }
+  bits += 0x7fffu + ((bits >> 16) & 1u);
+  return (bf16_t)(bits >> 16);
+}
+
+void Float32ToBf16(const float *src, bf16_t *dst, int count);
+void Bf16ToFloat32(const bf16_t *src, float *dst, int count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_BF16_CAST_BF16_H_
@@ -0,0 +1,439 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/bf16/matmul_bf16.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+#include "nnacl/nnacl_utils.h"
+
+#ifdef _MSC_VER
+#define BF16_INLINE static __forceinline
+#else
+#define BF16_INLINE static inline __attribute__((always_inline))
+#endif
+
+#define BF16_PAIR C2NUM
+#define BF16_TILE_ROWS C6NUM
+/* deep indices of a row tile the emulated kernels widen to float32 at a time, on the stack */
+#define BF16_DEEP_CHUNK 256
+
+static inline float Bf16Act(float value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = MSMAX(value, 0.0f);
+  }
+  if (act_type == ActType_Relu6) {
+    value = MSMIN(value, 6.0f);
+  }
+  return value;
+}
+
+size_t MatMulBf16PackedWeightSize(int deep, int col) {
+  return (size_t)UP_DIV(col, MATMUL_BF16_BLOCK) * UP_DIV(deep, BF16_PAIR) * MATMUL_BF16_BLOCK * BF16_PAIR;
+}
+
+void PackMatMulBf16Weight(const float *src, bf16_t *dst, int deep, int col, bool transpose) {
+  int pairs = UP_DIV(deep, BF16_PAIR);
+  for (int cb = 0; cb < UP_DIV(col, MATMUL_BF16_BLOCK); cb++) {
+    bf16_t *block = dst + (size_t)cb * pairs * MATMUL_BF16_BLOCK * BF16_PAIR;
+    for (int p = 0; p < pairs; p++) {
+      for (int j = 0; j < MATMUL_BF16_BLOCK; j++) {
+        int oc = cb * MATMUL_BF16_BLOCK + j;
+        for (int s = 0; s < BF16_PAIR; s++) {
+          int k = p * BF16_PAIR + s;
+          float value = 0.0f;
+          if (oc < col && k < deep) {
+            value = transpose ? src[oc * deep + k] : src[k * col + oc];
+          }
+          block[(p * MATMUL_BF16_BLOCK + j) * BF16_PAIR + s] = Fp32ToBf16(value);
+        }
+      }
+    }
+  }
+}
+
+#ifndef ENABLE_AVX
+static void MatMulBf16C(const bf16_t *a, const bf16_t *b, const float *bias, float *c, int act_type, int row, int deep,
+                        int col, int out_stride, int start_block, int end_block) {
+  size_t block_stride = (size_t)UP_DIV(deep, BF16_PAIR) * MATMUL_BF16_BLOCK * BF16_PAIR;
+  for (int cb = start_block; cb < end_block; cb++) {
+    const bf16_t *weight = b + cb * block_stride;
+    int col_start = cb * MATMUL_BF16_BLOCK;
+    int cols = MSMIN(MATMUL_BF16_BLOCK, col - col_start);
+    for (int r = 0; r < row; r++) {
+      float acc[MATMUL_BF16_BLOCK];
+      for (int j = 0; j < MATMUL_BF16_BLOCK; j++) {
+        acc[j] = bias == NULL || j >= cols ? 0.0f : bias[col_start + j];
+      }
+      for (int k = 0; k < deep; k++) {
+        float value = Bf16ToFp32(a[r * deep + k]);
+        const bf16_t *w = weight + (k / BF16_PAIR) * MATMUL_BF16_BLOCK * BF16_PAIR + k % BF16_PAIR;
+        for (int j = 0; j < MATMUL_BF16_BLOCK; j++) {
+          acc[j] += value * Bf16ToFp32(w[j * BF16_PAIR]);
+        }
+      }
+      for (int j = 0; j < cols; j++) {
+        c[r * out_stride + col_start + j] = Bf16Act(acc[j], act_type);
+      }
+    }
+  }
+}
+#endif
+
+#ifdef ENABLE_AVX
+#define BF16_ROWS6(X) X(0) X(1) X(2) X(3) X(4) X(5)
+
+/* a_buf[r][0, len) = a[r][0, len) in float32 for the rows of a tile, an odd len is padded with a zero to a full pair */
+static inline void Bf16RowsToFp32(const bf16_t *a, int deep, int rows, int len, float *a_buf) {
+  for (int r = 0; r < rows; r++) {
+    Bf16ToFloat32(a + r * deep, a_buf + r * BF16_DEEP_CHUNK, len);
+    if (len % BF16_PAIR != 0) {
+      a_buf[r * BF16_DEEP_CHUNK + len] = 0.0f;
+    }
+  }
+}
+
+static inline __m256 Bf16AvxAct(__m256 value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  return value;
+}
+
+static inline void Bf16AvxStore(float *dst, __m256 value0, __m256 value1, int act_type, int cols) {
+  value0 = Bf16AvxAct(value0, act_type);
+  value1 = Bf16AvxAct(value1, act_type);
+  if (cols == C16NUM) {
+    _mm256_storeu_ps(dst, value0);
+    _mm256_storeu_ps(dst + C8NUM, value1);
+    return;
+  }
+  float tmp[C16NUM];
+  _mm256_storeu_ps(tmp, value0);
+  _mm256_storeu_ps(tmp + C8NUM, value1);
+  memcpy(dst, tmp, cols * sizeof(float));
+}
+
+#define BF16_AVX_INIT(i)   \
+  __m256 acc##i##_0 = init0; \
+  __m256 acc##i##_1 = init1;
+#define BF16_AVX_FMA(i)                                                          \
+  if (rows > (i)) {                                                              \
+    __m256 even##i = _mm256_broadcast_ss(a_buf + (i)*BF16_DEEP_CHUNK + k);     \
+    __m256 odd##i = _mm256_broadcast_ss(a_buf + (i)*BF16_DEEP_CHUNK + k + 1);  \
+    acc##i##_0 = _mm256_fmadd_ps(even##i, w0_even, acc##i##_0);                  \
+    acc##i##_1 = _mm256_fmadd_ps(even##i, w1_even, acc##i##_1);                  \
+    acc##i##_0 = _mm256_fmadd_ps(odd##i, w0_odd, acc##i##_0);                    \
+    acc##i##_1 = _mm256_fmadd_ps(odd##i, w1_odd, acc##i##_1);                    \
+  }
+#define BF16_AVX_STORE(i)                                                          \
+  if (rows > (i)) {                                                                \
+    Bf16AvxStore(c + (i)*out_stride, acc##i##_0, acc##i##_1, act_type, cols);      \
+  }
+
+/* A bf16 is the high half of its float32, so a 32-bit lane holding a pair widens to the even weight by a shift and to
+ * the odd one by a mask. The rows of a are widened once per chunk and broadcast from the stack. */
+BF16_INLINE void MatMulBf16AvxTile(const bf16_t *a, const bf16_t *b, __m256 init0, __m256 init1, float *c,
+                                   int act_type, int rows, int deep, int cols, int out_stride) {
+  float a_buf[BF16_TILE_ROWS * BF16_DEEP_CHUNK];
+  const __m256i high = _mm256_set1_epi32((int)0xffff0000u);
+  BF16_ROWS6(BF16_AVX_INIT)
+  for (int k_start = 0; k_start < deep; k_start += BF16_DEEP_CHUNK) {
+    int len = MSMIN(BF16_DEEP_CHUNK, deep - k_start);
+    Bf16RowsToFp32(a + k_start, deep, rows, len, a_buf);
+    const bf16_t *w = b + (size_t)k_start * MATMUL_BF16_BLOCK;
+    for (int k = 0; k < len; k += BF16_PAIR, w += MATMUL_BF16_BLOCK * BF16_PAIR) {
+      __m256i w0 = _mm256_loadu_si256((const __m256i *)w);
+      __m256i w1 = _mm256_loadu_si256((const __m256i *)(w + C16NUM));
+      __m256 w0_even = _mm256_castsi256_ps(_mm256_slli_epi32(w0, 16));
+      __m256 w0_odd = _mm256_castsi256_ps(_mm256_and_si256(w0, high));
+      __m256 w1_even = _mm256_castsi256_ps(_mm256_slli_epi32(w1, 16));
+      __m256 w1_odd = _mm256_castsi256_ps(_mm256_and_si256(w1, high));
+      BF16_ROWS6(BF16_AVX_FMA)
+    }
+  }
+  BF16_ROWS6(BF16_AVX_STORE)
+}
+
+static void MatMulBf16Avx(const bf16_t *a, const bf16_t *b, const float *bias, float *c, int act_type, int row,
+                          int deep, int col, int out_stride, int start_block, int end_block) {
+  size_t block_stride = (size_t)UP_DIV(deep, BF16_PAIR) * MATMUL_BF16_BLOCK * BF16_PAIR;
+  for (int cb = start_block; cb < end_block; cb++) {
+    const bf16_t *weight = b + cb * block_stride;
+    int col_start = cb * MATMUL_BF16_BLOCK;
+    int cols = MSMIN(MATMUL_BF16_BLOCK, col - col_start);
+    float tmp[C16NUM] = {0};
+    if (bias != NULL) {
+      memcpy(tmp, bias + col_start, cols * sizeof(float));
+    }
+    __m256 init0 = _mm256_loadu_ps(tmp);
+    __m256 init1 = _mm256_loadu_ps(tmp + C8NUM);
+    int r = 0;
+    for (; r + BF16_TILE_ROWS <= row; r += BF16_TILE_ROWS) {
+      MatMulBf16AvxTile(a + r * deep, weight, init0, init1, c + r * out_stride + col_start, act_type, C6NUM, deep,
+                        cols, out_stride);
+    }
+    // the rows left get a tile of their own size, so every row check of the tile is a constant
+    const bf16_t *src = a + r * deep;
+    float *dst = c + r * out_stride + col_start;
+    switch (row - r) {
+      case C5NUM:
+        MatMulBf16AvxTile(src, weight, init0, init1, dst, act_type, C5NUM, deep, cols, out_stride);
+        break;
+      case C4NUM:
+        MatMulBf16AvxTile(src, weight, init0, init1, dst, act_type, C4NUM, deep, cols, out_stride);
+        break;
+      case C3NUM:
+        MatMulBf16AvxTile(src, weight, init0, init1, dst, act_type, C3NUM, deep, cols, out_stride);
+        break;
+      case C2NUM:
+        MatMulBf16AvxTile(src, weight, init0, init1, dst, act_type, C2NUM, deep, cols, out_stride);
+        break;
+      case C1NUM:
+        MatMulBf16AvxTile(src, weight, init0, init1, dst, act_type, C1NUM, deep, cols, out_stride);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+#ifdef NNACL_AVX512_TARGET
+#define BF16_AVX512_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl")))
+#define BF16_AVX512_INLINE static inline __attribute__((always_inline)) BF16_AVX512_TARGET
+
+BF16_AVX512_INLINE __m512 Bf16Avx512Act(__m512 value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm512_max_ps(value, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+  }
+  return value;
+}
+
+/* the avx512 tiles cover 2 blocks, 32 output channels, of 6 rows */
+#define BF16_AVX512_INIT(i)  \
+  __m512 acc##i##_0 = init0; \
+  __m512 acc##i##_1 = init1;
+#define BF16_AVX512_STORE(i)                                                                   \
+  if (rows > (i)) {                                                                            \
+    _mm512_mask_storeu_ps(c + (i)*out_stride, mask0, Bf16Avx512Act(acc##i##_0, act_type));     \
+    if (blocks > 1) {                                                                          \
+      _mm512_mask_storeu_ps(c + (i)*out_stride + C16NUM, mask1, Bf16Avx512Act(acc##i##_1, act_type)); \
+    }                                                                                          \
+  }
+#define BF16_AVX512_FMA(i)                                                    \
+  if (rows > (i)) {                                                           \
+    __m512 even##i = _mm512_set1_ps(a_buf[(i)*BF16_DEEP_CHUNK + k]);          \
+    __m512 odd##i = _mm512_set1_ps(a_buf[(i)*BF16_DEEP_CHUNK + k + 1]);       \
+    acc##i##_0 = _mm512_fmadd_ps(even##i, w0_even, acc##i##_0);               \
+    acc##i##_0 = _mm512_fmadd_ps(odd##i, w0_odd, acc##i##_0);                 \
+    if (blocks > 1) {                                                         \
+      acc##i##_1 = _mm512_fmadd_ps(even##i, w1_even, acc##i##_1);             \
+      acc##i##_1 = _mm512_fmadd_ps(odd##i, w1_odd, acc##i##_1);               \
+    }                                                                         \
+  }
+
+BF16_AVX512_INLINE void MatMulBf16Avx512Tile(const bf16_t *a, const bf16_t *b, size_t block_stride, __m512 init0,
+                                             __m512 init1, __mmask16 mask0, __mmask16 mask1, float *c, int act_type,
+                                             int rows, int blocks, int deep, int out_stride) {
+  float a_buf[BF16_TILE_ROWS * BF16_DEEP_CHUNK];
+  const __m512i high = _mm512_set1_epi32((int)0xffff0000u);
+  BF16_ROWS6(BF16_AVX512_INIT)
+  for (int k_start = 0; k_start < deep; k_start += BF16_DEEP_CHUNK) {
+    int len = MSMIN(BF16_DEEP_CHUNK, deep - k_start);
+    Bf16RowsToFp32(a + k_start, deep, rows, len, a_buf);
+    const bf16_t *w = b + (size_t)k_start * MATMUL_BF16_BLOCK;
+    for (int k = 0; k < len; k += BF16_PAIR, w += MATMUL_BF16_BLOCK * BF16_PAIR) {
+      __m512i w0 = _mm512_loadu_si512(w);
+      __m512 w0_even = _mm512_castsi512_ps(_mm512_slli_epi32(w0, 16));
+      __m512 w0_odd = _mm512_castsi512_ps(_mm512_and_si512(w0, high));
+      __m512 w1_even = w0_even;
+      __m512 w1_odd = w0_odd;
+      if (blocks > 1) {
+        __m512i w1 = _mm512_loadu_si512(w + block_stride);
+        w1_even = _mm512_castsi512_ps(_mm512_slli_epi32(w1, 16));
+        w1_odd = _mm512_castsi512_ps(_mm512_and_si512(w1, high));
+      }
+      BF16_ROWS6(BF16_AVX512_FMA)
+    }
+  }
+  BF16_ROWS6(BF16_AVX512_STORE)
+}
+
+/* calls the tile of the rows and blocks left with both as constants */
+#define BF16_AVX512_DISPATCH(TILE, ...)                         \
+  do {                                                          \
+    if (blocks > 1) {                                           \
+      switch (rows) {                                           \
+        case C6NUM:                                             \
+          TILE(__VA_ARGS__, C6NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+        case C5NUM:                                             \
+          TILE(__VA_ARGS__, C5NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+        case C4NUM:                                             \
+          TILE(__VA_ARGS__, C4NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+        case C3NUM:                                             \
+          TILE(__VA_ARGS__, C3NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+        case C2NUM:                                             \
+          TILE(__VA_ARGS__, C2NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+        default:                                                \
+          TILE(__VA_ARGS__, C1NUM, C2NUM, deep, out_stride);    \
+          break;                                                \
+      }                                                         \
+    } else {                                                    \
+      switch (rows) {                                           \
+        case C6NUM:                                             \
+          TILE(__VA_ARGS__, C6NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+        case C5NUM:                                             \
+          TILE(__VA_ARGS__, C5NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+        case C4NUM:                                             \
+          TILE(__VA_ARGS__, C4NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+        case C3NUM:                                             \
+          TILE(__VA_ARGS__, C3NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+        case C2NUM:                                             \
+          TILE(__VA_ARGS__, C2NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+        default:                                                \
+          TILE(__VA_ARGS__, C1NUM, C1NUM, deep, out_stride);    \
+          break;                                                \
+      }                                                         \
+    }                                                           \
+  } while (0)
+
+/* runs TILE over all rows of the blocks [start_block, end_block), 2 blocks at a time */
+#define BF16_AVX512_LOOP(TILE)                                                                                 \
+  size_t block_stride = (size_t)UP_DIV(deep, BF16_PAIR) * MATMUL_BF16_BLOCK * BF16_PAIR;                     \
+  for (int cb = start_block; cb < end_block; cb += C2NUM) {                                                   \
+    const bf16_t *weight = b + cb * block_stride;                                                             \
+    int blocks = MSMIN(C2NUM, end_block - cb);                                                                \
+    int col_start = cb * MATMUL_BF16_BLOCK;                                                                   \
+    int cols0 = MSMIN(C16NUM, col - col_start);                                                               \
+    int cols1 = blocks > 1 ? MSMIN(C16NUM, col - col_start - C16NUM) : 0;                                     \
+    __mmask16 mask0 = (__mmask16)((1u << cols0) - 1);                                                         \
+    __mmask16 mask1 = (__mmask16)((1u << cols1) - 1);                                                         \
+    __m512 init0 = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask0, bias + col_start);      \
+    __m512 init1 = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask1, bias + col_start + C16NUM); \
+    for (int r = 0; r < row; r += BF16_TILE_ROWS) {                                                           \
+      int rows = MSMIN(BF16_TILE_ROWS, row - r);                                                              \
+      BF16_AVX512_DISPATCH(TILE, a + r * deep, weight, block_stride, init0, init1, mask0, mask1,              \
+                           c + r * out_stride + col_start, act_type);                                         \
+    }                                                                                                         \
+  }
+
+BF16_AVX512_TARGET static void MatMulBf16Avx512(const bf16_t *a, const bf16_t *b, const float *bias, float *c,
+                                                int act_type, int row, int deep, int col, int out_stride,
+                                                int start_block, int end_block) {
+  BF16_AVX512_LOOP(MatMulBf16Avx512Tile)
+}
+
+#ifdef NNACL_AVX512_BF16_TARGET
+#define BF16_NATIVE_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl,avx512bf16")))
+#define BF16_NATIVE_INLINE static inline __attribute__((always_inline)) BF16_NATIVE_TARGET
+
+#define BF16_DP(i, pair)                                                          \
+  {                                                                               \
+    __m512bh value##i = (__m512bh)_mm512_set1_epi32(pair);                        \
+    acc##i##_0 = _mm512_dpbf16_ps(acc##i##_0, value##i, w0);                      \
+    if (blocks > 1) {                                                             \
+      acc##i##_1 = _mm512_dpbf16_ps(acc##i##_1, value##i, w1);                    \
+    }                                                                             \
+  }
+#define BF16_NATIVE_DP(i)                                                         \
+  if (rows > (i)) {                                                               \
+    int32_t pair##i;                                                              \
+    memcpy(&pair##i, a + (i)*deep + k, sizeof(int32_t));                          \
+    BF16_DP(i, pair##i)                                                           \
+  }
+#define BF16_NATIVE_DP_TAIL(i)                                                    \
+  if (rows > (i)) {                                                               \
+    BF16_DP(i, (int32_t)a[(i)*deep + k])                                          \
+  }
+
+/* vdpbf16ps multiplies the bf16 pairs of a row, broadcast to every lane, with the weight pairs of 16 channels and adds
+ * both products to the float32 lanes, which doubles the multiply-adds per instruction of the float32 kernels. */
+BF16_NATIVE_INLINE void MatMulBf16NativeTile(const bf16_t *a, const bf16_t *b, size_t block_stride, __m512 init0,
+                                             __m512 init1, __mmask16 mask0, __mmask16 mask1, float *c, int act_type,
+                                             int rows, int blocks, int deep, int out_stride) {
+  BF16_ROWS6(BF16_AVX512_INIT)
+  const bf16_t *w = b;
+  int k = 0;
+  for (; k + 1 < deep; k += BF16_PAIR, w += MATMUL_BF16_BLOCK * BF16_PAIR) {
+    __m512bh w0 = (__m512bh)_mm512_loadu_si512(w);
+    __m512bh w1 = w0;
+    if (blocks > 1) {
+      w1 = (__m512bh)_mm512_loadu_si512(w + block_stride);
+    }
+    BF16_ROWS6(BF16_NATIVE_DP)
+  }
+  if (k < deep) {
+    // the odd last deep index pairs with the zero padding of the weight
+    __m512bh w0 = (__m512bh)_mm512_loadu_si512(w);
+    __m512bh w1 = w0;
+    if (blocks > 1) {
+      w1 = (__m512bh)_mm512_loadu_si512(w + block_stride);
+    }
+    BF16_ROWS6(BF16_NATIVE_DP_TAIL)
+  }
+  BF16_ROWS6(BF16_AVX512_STORE)
+}
+
+BF16_NATIVE_TARGET static void MatMulBf16Native(const bf16_t *a, const bf16_t *b, const float *bias, float *c,
+                                                int act_type, int row, int deep, int col, int out_stride,
+                                                int start_block, int end_block) {
+  BF16_AVX512_LOOP(MatMulBf16NativeTile)
+}
+#endif
+#endif
+#endif
+
+void MatMulBf16(const bf16_t *a, const bf16_t *b, const float *bias, float *c, int act_type, int row, int deep, int col,
+                int out_stride, int start_block, int end_block) {
+#ifdef ENABLE_AVX
+#ifdef NNACL_AVX512_TARGET
+#ifdef NNACL_AVX512_BF16_TARGET
+  if (GetX86Isa() >= X86_ISA_AVX512_BF16) {
+    MatMulBf16Native(a, b, bias, c, act_type, row, deep, col, out_stride, start_block, end_block);
+    return;
+  }
+#endif
+  if (GetX86Isa() >= X86_ISA_AVX512) {
+    MatMulBf16Avx512(a, b, bias, c, act_type, row, deep, col, out_stride, start_block, end_block);
+    return;
+  }
+#endif
+  MatMulBf16Avx(a, b, bias, c, act_type, row, deep, col, out_stride, start_block, end_block);
+#else
+  MatMulBf16C(a, b, bias, c, act_type, row, deep, col, out_stride, start_block, end_block);
+#endif
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+#define MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "nnacl/op_base.h"
+#include "nnacl/bf16/cast_bf16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* output channels of one block of the packed weight */
+#define MATMUL_BF16_BLOCK C16NUM
+
+/* bf16 elements of the packed weight. It is cut into blocks of 16 output channels, each [UP_DIV(deep, 2)][16][2]: the
+ * two deep indices of a pair are adjacent, which is the operand layout of the avx512 bf16 dot product, and a pair of a
+ * block fills one 512-bit register. Channels past col and an odd last deep index are zero. */
+size_t MatMulBf16PackedWeightSize(int deep, int col);
+void PackMatMulBf16Weight(const float *src, bf16_t *dst, int deep, int col, bool transpose);
+
+/* c[row x out_stride] = a[row x deep] * b + bias for the blocks [start_block, end_block) of the packed weight b, only
+ * the col first channels are stored. a is row-major bf16, accumulation and c are float32. Hosts without avx512 bf16
+ * widen the bf16 operands to float32 inside the kernel, which costs shifts but no extra memory traffic. */
+void MatMulBf16(const bf16_t *a, const bf16_t *b, const float *bias, float *c, int act_type, int row, int deep, int col,
+                int out_stride, int start_block, int end_block);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
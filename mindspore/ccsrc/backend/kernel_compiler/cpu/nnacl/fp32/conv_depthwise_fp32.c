@@ -1083,11 +1083,24 @@ void DepthwiseSWAvxFp32(float *output_data, const float *input_data, const float
   int in_h_start = out_top * conv_param->stride_h_ - conv_param->pad_u_;
   int in_w_start = out_left * conv_param->stride_w_ - conv_param->pad_l_;
   int in_start = in_h_start * sw_param->in_h_step_ + in_w_start * oc_algin;
-  const int ow_block_num[4] = {8, 4, 4, 3};
-  const DepthwiseSWKernel kernel[4][2] = {{DepthwiseSW1x8Kernel, DepthwiseSW8x8Kernel},
-                                          {DepthwiseSW1x16Kernel, DepthwiseSW4x16Kernel},
-                                          {DepthwiseSW1x24Kernel, DepthwiseSW4x24Kernel},
-                                          {DepthwiseSW1x32Kernel, DepthwiseSW3x32Kernel}};
+  const int avx2_ow_block_num[4] = {8, 4, 4, 3};
+  const DepthwiseSWKernel avx2_kernel[4][2] = {{DepthwiseSW1x8Kernel, DepthwiseSW8x8Kernel},
+                                               {DepthwiseSW1x16Kernel, DepthwiseSW4x16Kernel},
+                                               {DepthwiseSW1x24Kernel, DepthwiseSW4x24Kernel},
+                                               {DepthwiseSW1x32Kernel, DepthwiseSW3x32Kernel}};
+  const int *ow_block_num = avx2_ow_block_num;
+  const DepthwiseSWKernel(*kernel)[2] = avx2_kernel;
+#ifdef NNACL_AVX512_TARGET
+  const int avx512_ow_block_num[4] = {12, 12, 6, 6};
+  const DepthwiseSWKernel avx512_kernel[4][2] = {{DepthwiseSW1x8Kernel, DepthwiseSWAvx512Kernel},
+                                                 {DepthwiseSW1x16Kernel, DepthwiseSWAvx512Kernel},
+                                                 {DepthwiseSW1x24Kernel, DepthwiseSWAvx512Kernel},
+                                                 {DepthwiseSW1x32Kernel, DepthwiseSWAvx512Kernel}};
+  if (GetX86Isa() >= X86_ISA_AVX512) {
+    ow_block_num = avx512_ow_block_num;
+    kernel = avx512_kernel;
+  }
+#endif
   for (int b = 0; b < conv_param->output_batch_; b++) {
     for (int oh = oh_start; oh < oh_end; ++oh) {
       float *dst_oh = output_data + oh * out_h_step;
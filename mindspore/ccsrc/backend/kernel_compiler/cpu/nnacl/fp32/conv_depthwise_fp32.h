@@ -19,6 +19,7 @@
 
 #include "nnacl/conv_parameter.h"
 #include "nnacl/base/conv_common_base.h"
+#include "nnacl/nnacl_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -100,6 +101,14 @@ void DepthwiseSW1x8Kernel(float *dst, const float *src, const float *weight, con
                           size_t kernel_w, size_t act_flag, size_t ow_block, size_t oc_block, size_t oc_algin,
                           size_t in_kw_step, size_t in_kh_step, size_t in_sw_step, size_t kw_remainder);
 
+#ifdef NNACL_AVX512_TARGET
+/* takes the place of the multi pixel kernels above when GetX86Isa() reports avx512, with ow_block 12 for up to two C8
+ * groups or 6 for three and four; the one pixel border calls stay on the avx2 kernels */
+void DepthwiseSWAvx512Kernel(float *dst, const float *src, const float *weight, const float *bias, size_t kernel_h,
+                             size_t kernel_w, size_t act_flag, size_t ow_block, size_t oc_block, size_t oc_algin,
+                             size_t in_kw_step, size_t in_kh_step, size_t in_sw_step, size_t kw_remainder);
+#endif
+
 void DepthwiseSWAvxFp32(float *output_data, const float *input_data, const float *weight_data, const float *bias_data,
                         const ConvParameter *conv_param, const SlidingWindowParam *sliding, int task_id);
 
@@ -1227,6 +1227,17 @@ void MatVecMulAvxFp32(const float *a, const float *b, float *c, const float *bia
 
 void MatMulAvxFp32(const float *a, const float *b, float *c, const float *bias, const int act_type, const int depth,
                    const int cur_col, const int col_align, const int row) {
+#ifdef NNACL_AVX512_TARGET
+  if (GetX86Isa() >= X86_ISA_AVX512) {
+    MatMulAvx512Fp32(a, b, c, bias, act_type, depth, cur_col, col_align, row);
+    return;
+  }
+#endif
+  MatMulAvx2Fp32(a, b, c, bias, act_type, depth, cur_col, col_align, row);
+}
+
+void MatMulAvx2Fp32(const float *a, const float *b, float *c, const float *bias, const int act_type, const int depth,
+                    const int cur_col, const int col_align, const int row) {
   // one time process 32 out_channel
   int col_block = C32NUM;
   int act_flag = 0;
@@ -2139,3 +2150,51 @@ void MatVecMulRowxColKernel(float *dst, const float *src, const float *weight, c
 }
 #endif
 #endif
+
+void DequantWeightInt8Tile(const int8_t *src, float *dst, const float *scale, const float *offset, int deep, int col,
+                           int start_oc, int cur_oc, bool b_transpose) {
+  if (b_transpose) {
+    for (int oc = 0; oc < cur_oc; ++oc) {
+      const int8_t *src_row = src + (start_oc + oc) * deep;
+      float *dst_row = dst + oc * deep;
+      float oc_scale = scale[start_oc + oc];
+      float oc_offset = offset[start_oc + oc];
+      int d = 0;
+#ifdef ENABLE_NEON
+      float32x4_t scale_v = vdupq_n_f32(oc_scale);
+      float32x4_t offset_v = vdupq_n_f32(oc_offset);
+      for (; d <= deep - C8NUM; d += C8NUM) {
+        int16x8_t src_16 = vmovl_s8(vld1_s8(src_row + d));
+        float32x4_t src_lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(src_16)));
+        float32x4_t src_hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(src_16)));
+        vst1q_f32(dst_row + d, vmlaq_f32(offset_v, src_lo, scale_v));
+        vst1q_f32(dst_row + d + C4NUM, vmlaq_f32(offset_v, src_hi, scale_v));
+      }
+#endif
+      for (; d < deep; ++d) {
+        dst_row[d] = src_row[d] * oc_scale + oc_offset;
+      }
+    }
+    return;
+  }
+  const float *tile_scale = scale + start_oc;
+  const float *tile_offset = offset + start_oc;
+  for (int d = 0; d < deep; ++d) {
+    const int8_t *src_row = src + d * col + start_oc;
+    float *dst_row = dst + d * cur_oc;
+    int oc = 0;
+#ifdef ENABLE_NEON
+    for (; oc <= cur_oc - C8NUM; oc += C8NUM) {
+      int16x8_t src_16 = vmovl_s8(vld1_s8(src_row + oc));
+      float32x4_t src_lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(src_16)));
+      float32x4_t src_hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(src_16)));
+      vst1q_f32(dst_row + oc, vmlaq_f32(vld1q_f32(tile_offset + oc), src_lo, vld1q_f32(tile_scale + oc)));
+      vst1q_f32(dst_row + oc + C4NUM,
+                vmlaq_f32(vld1q_f32(tile_offset + oc + C4NUM), src_hi, vld1q_f32(tile_scale + oc + C4NUM)));
+    }
+#endif
+    for (; oc < cur_oc; ++oc) {
+      dst_row[oc] = src_row[oc] * tile_scale[oc] + tile_offset[oc];
+    }
+  }
+}
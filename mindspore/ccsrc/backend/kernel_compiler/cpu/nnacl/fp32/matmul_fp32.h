@@ -22,6 +22,7 @@
 #include "nnacl/errorcode.h"
 #include "nnacl/matmul_parameter.h"
 #include "nnacl/op_base.h"
+#include "nnacl/nnacl_utils.h"
 
 #define ADD_BIAS(value, bias, c) \
   if (bias != NULL) value = value + bias[c];
@@ -91,6 +92,14 @@ void MatVecMulAvxFp32(const float *a, const float *b, float *c, const float *bia
                       int col_align);
 void MatMulAvxFp32(const float *a, const float *b, float *c, const float *bias, int act_type, int depth, int cur_col,
                    int col_align, int row);
+/* the avx2 kernel of MatMulAvxFp32, whatever GetX86Isa() reports */
+void MatMulAvx2Fp32(const float *a, const float *b, float *c, const float *bias, int act_type, int depth, int cur_col,
+                    int col_align, int row);
+#ifdef NNACL_AVX512_TARGET
+/* same operands as MatMulAvxFp32, only to be called when GetX86Isa() reports avx512 */
+void MatMulAvx512Fp32(const float *a, const float *b, float *c, const float *bias, int act_type, int depth, int cur_col,
+                      int col_align, int row);
+#endif
 void MatVecMul1x32Kernel(float *dst, const float *src, const float *weight, const float *bias, size_t act_flag,
                          size_t row_block, size_t col_block, size_t col_algin, size_t deep);
 void MatVecMul1x24Kernel(float *dst, const float *src, const float *weight, const float *bias, size_t act_flag,
@@ -123,6 +132,11 @@ void MatmulFloatSse64Opt(const float *a, const float *b, float *c, const float *
 void MatMul12x8(const float *a, const float *b, float *dst, const float *bias, ActType act_type, int deep, int row,
                 int col, int stride, int out_type);
 
+// Dequantize output channels [start_oc, start_oc + cur_oc) of an int8 weight-quantized B matrix into a dense tile,
+// dst = src * scale[oc] + offset[oc]. The tile is [cur_oc, deep] when b_transpose is set, else [deep, cur_oc].
+void DequantWeightInt8Tile(const int8_t *src, float *dst, const float *scale, const float *offset, int deep, int col,
+                           int start_oc, int cur_oc, bool b_transpose);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,741 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+#ifdef ENABLE_ARM64
+#include <arm_neon.h>
+#endif
+#include "nnacl/nnacl_utils.h"
+
+#ifdef _MSC_VER
+#define SPARSE_INLINE static __forceinline
+#else
+#define SPARSE_INLINE static inline __attribute__((always_inline))
+#endif
+
+#define SEMI_GROUP 4
+#define SEMI_SLOTS 2
+
+/* time per kept weight of each sparse kernel over the time per weight of the dense kernel, measured with avx2 and
+ * avx512 on shapes from 1x1024x1024 to 64x768x768 and rounded up. Gemv-like shapes are bound by the weight bytes, so
+ * skipping weights pays off better there than on tiles where the dense kernel reuses every weight for 12 rows. */
+#define SPARSE_BLOCK_COST 1.8f
+#define SPARSE_BLOCK_COST_GEMV 1.3f
+#define SPARSE_SEMI_COST 1.7f
+#define SPARSE_SEMI_COST_GEMV 1.4f
+/* a sparse layout has to be this much cheaper than dense to be used */
+#define SPARSE_MIN_GAIN 0.85f
+#define SPARSE_GEMV_ROWS 4
+
+static inline float SparseWeightAt(const float *weight, int k, int j, int deep, int col, bool b_transpose) {
+  return b_transpose ? weight[j * deep + k] : weight[k * col + j];
+}
+
+static inline float SparseAct(float value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = MSMAX(value, 0.0f);
+  }
+  if (act_type == ActType_Relu6) {
+    value = MSMIN(value, 6.0f);
+  }
+  return value;
+}
+
+int SparseWeightBlock(void) {
+#if defined(ENABLE_AVX) && defined(NNACL_AVX512_TARGET)
+  if (GetX86Isa() >= X86_ISA_AVX512) {
+    return C16NUM;
+  }
+#endif
+#ifdef ENABLE_ARM32
+  return C4NUM;
+#else
+  return C8NUM;
+#endif
+}
+
+int SparseBlockNnz(const float *weight, int deep, int col, int block, bool b_transpose) {
+  int nnz = 0;
+  for (int col_start = 0; col_start < col; col_start += block) {
+    int cols = MSMIN(block, col - col_start);
+    for (int k = 0; k < deep; k++) {
+      for (int j = 0; j < cols; j++) {
+        if (SparseWeightAt(weight, k, col_start + j, deep, col, b_transpose) != 0.0f) {
+          nnz++;
+          break;
+        }
+      }
+    }
+  }
+  return nnz;
+}
+
+bool IsSemi2x4Weight(const float *weight, int deep, int col, bool b_transpose) {
+  for (int j = 0; j < col; j++) {
+    for (int group = 0; group < deep; group += SEMI_GROUP) {
+      int count = 0;
+      for (int k = group; k < MSMIN(group + SEMI_GROUP, deep); k++) {
+        count += SparseWeightAt(weight, k, j, deep, col, b_transpose) != 0.0f ? 1 : 0;
+      }
+      if (count > SEMI_SLOTS) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+SparseWeightType ChooseSparseWeight(int row, int deep, int col, int block, int block_nnz, bool semi_2x4) {
+  bool gemv = row <= SPARSE_GEMV_ROWS;
+  float dense_cost = (float)deep * UP_ROUND(col, block);
+  float block_cost = (float)block_nnz * block * (gemv ? SPARSE_BLOCK_COST_GEMV : SPARSE_BLOCK_COST);
+  float semi_cost = semi_2x4 ? (float)UP_DIV(deep, SEMI_GROUP) * SEMI_SLOTS * UP_ROUND(col, block) *
+                                 (gemv ? SPARSE_SEMI_COST_GEMV : SPARSE_SEMI_COST)
+                             : dense_cost;
+  float best_cost = MSMIN(block_cost, semi_cost);
+  if (best_cost > dense_cost * SPARSE_MIN_GAIN) {
+    return SparseWeight_Dense;
+  }
+  return block_cost <= semi_cost ? SparseWeight_Block : SparseWeight_Semi2x4;
+}
+
+size_t SparseWeightIndexSize(SparseWeightType type, int deep, int col, int block, int nnz) {
+  if (type == SparseWeight_Block) {
+    return (size_t)(UP_DIV(col, block) + 1 + nnz) * sizeof(int);
+  }
+  if (type == SparseWeight_Semi2x4) {
+    return (size_t)UP_DIV(col, block) * UP_DIV(deep, SEMI_GROUP) * SEMI_SLOTS * block * sizeof(uint8_t);
+  }
+  return 0;
+}
+
+size_t SparseWeightDataSize(SparseWeightType type, int deep, int col, int block, int nnz) {
+  if (type == SparseWeight_Block) {
+    return (size_t)nnz * block * sizeof(float);
+  }
+  if (type == SparseWeight_Semi2x4) {
+    return (size_t)UP_DIV(col, block) * UP_DIV(deep, SEMI_GROUP) * SEMI_SLOTS * block * sizeof(float);
+  }
+  return 0;
+}
+
+static void PackSparseBlock(const float *weight, bool b_transpose, SparseWeight *dst) {
+  int deep = dst->deep_;
+  int col = dst->col_;
+  int block = dst->block_;
+  int nnz = 0;
+  for (int cb = 0; cb < dst->col_blocks_; cb++) {
+    int col_start = cb * block;
+    int cols = MSMIN(block, col - col_start);
+    dst->block_offset_[cb] = nnz;
+    for (int k = 0; k < deep; k++) {
+      bool kept = false;
+      for (int j = 0; j < cols && !kept; j++) {
+        kept = SparseWeightAt(weight, k, col_start + j, deep, col, b_transpose) != 0.0f;
+      }
+      if (!kept) {
+        continue;
+      }
+      float *data = dst->data_ + (size_t)nnz * block;
+      for (int j = 0; j < block; j++) {
+        data[j] = j < cols ? SparseWeightAt(weight, k, col_start + j, deep, col, b_transpose) : 0.0f;
+      }
+      dst->deep_index_[nnz++] = k;
+    }
+  }
+  dst->block_offset_[dst->col_blocks_] = nnz;
+  dst->nnz_ = nnz;
+}
+
+static void PackSemi2x4(const float *weight, bool b_transpose, SparseWeight *dst) {
+  int deep = dst->deep_;
+  int col = dst->col_;
+  int block = dst->block_;
+  int groups = UP_DIV(deep, SEMI_GROUP);
+  size_t index = 0;
+  for (int cb = 0; cb < dst->col_blocks_; cb++) {
+    for (int group = 0; group < groups; group++) {
+      uint8_t *position = dst->position_ + index;
+      float *data = dst->data_ + index;
+      for (int j = 0; j < block; j++) {
+        int oc = cb * block + j;
+        int slot = 0;
+        /* empty slots point at the first weight of the group, which is always inside deep */
+        for (int s = 0; s < SEMI_SLOTS; s++) {
+          position[s * block + j] = 0;
+          data[s * block + j] = 0.0f;
+        }
+        for (int k = 0; oc < col && k < SEMI_GROUP && group * SEMI_GROUP + k < deep; k++) {
+          float value = SparseWeightAt(weight, group * SEMI_GROUP + k, oc, deep, col, b_transpose);
+          if (value != 0.0f && slot < SEMI_SLOTS) {
+            position[slot * block + j] = (uint8_t)k;
+            data[slot * block + j] = value;
+            slot++;
+          }
+        }
+      }
+      index += SEMI_SLOTS * block;
+    }
+  }
+  dst->nnz_ = groups;
+}
+
+void PackSparseWeight(const float *weight, bool b_transpose, SparseWeight *dst) {
+  dst->col_blocks_ = UP_DIV(dst->col_, dst->block_);
+  if (dst->type_ == SparseWeight_Block) {
+    PackSparseBlock(weight, b_transpose, dst);
+  } else if (dst->type_ == SparseWeight_Semi2x4) {
+    PackSemi2x4(weight, b_transpose, dst);
+  }
+}
+
+static void SparseStoreC(float *dst, const float *acc, int act_type, int cols) {
+  for (int j = 0; j < cols; j++) {
+    dst[j] = SparseAct(acc[j], act_type);
+  }
+}
+
+static void SparseBlockC(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type, int row,
+                         int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  int block = weight->block_;
+  float acc[C12NUM * C16NUM];
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * block;
+    int cols = MSMIN(block, weight->col_ - col_start);
+    const int *deep_index = weight->deep_index_ + weight->block_offset_[cb];
+    const float *data = weight->data_ + (size_t)weight->block_offset_[cb] * block;
+    int nnz = weight->block_offset_[cb + 1] - weight->block_offset_[cb];
+    for (int r = 0; r < row; r += C12NUM) {
+      const float *src = a + r * deep;
+      int rows = MSMIN(C12NUM, row - r);
+      for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < block; j++) {
+          acc[i * block + j] = bias == NULL || j >= cols ? 0.0f : bias[col_start + j];
+        }
+      }
+      for (int n = 0; n < nnz; n++) {
+        const float *value = src + deep_index[n] * C12NUM;
+        const float *cur_data = data + n * block;
+        for (int i = 0; i < rows; i++) {
+          for (int j = 0; j < block; j++) {
+            acc[i * block + j] += value[i] * cur_data[j];
+          }
+        }
+      }
+      for (int i = 0; i < rows; i++) {
+        SparseStoreC(c + (r + i) * out_stride + col_start, acc + i * block, act_type, cols);
+      }
+    }
+  }
+}
+
+static void Semi2x4C(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type, int row,
+                     int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  int block = weight->block_;
+  int groups = UP_DIV(deep, SEMI_GROUP);
+  float acc[C16NUM];
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * block;
+    int cols = MSMIN(block, weight->col_ - col_start);
+    size_t offset = (size_t)cb * groups * SEMI_SLOTS * block;
+    for (int r = 0; r < row; r++) {
+      const float *src = a + r * deep;
+      const uint8_t *position = weight->position_ + offset;
+      const float *data = weight->data_ + offset;
+      for (int j = 0; j < block; j++) {
+        acc[j] = bias == NULL || j >= cols ? 0.0f : bias[col_start + j];
+      }
+      for (int group = 0; group < groups; group++) {
+        const float *src_group = src + group * SEMI_GROUP;
+        for (int j = 0; j < SEMI_SLOTS * block; j++) {
+          acc[j % block] += src_group[position[j]] * data[j];
+        }
+        position += SEMI_SLOTS * block;
+        data += SEMI_SLOTS * block;
+      }
+      SparseStoreC(c + r * out_stride + col_start, acc, act_type, cols);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX
+#define SPARSE_ROWS6(X) X(0) X(1) X(2) X(3) X(4) X(5)
+#define SPARSE_ROWS12(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11)
+
+static inline __m256 SparseAvxAct(__m256 value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  return value;
+}
+
+static inline void SparseAvxStore(float *dst, __m256 value, int act_type, int cols) {
+  value = SparseAvxAct(value, act_type);
+  if (cols == C8NUM) {
+    _mm256_storeu_ps(dst, value);
+    return;
+  }
+  float tmp[C8NUM];
+  _mm256_storeu_ps(tmp, value);
+  memcpy(dst, tmp, cols * sizeof(float));
+}
+
+#define SPARSE_AVX_INIT(i) \
+  __m256 acc##i = init;    \
+  __m256 odd##i = _mm256_setzero_ps();
+#define SPARSE_AVX_STORE(i)                                         \
+  if (store_rows > (i)) {                                           \
+    SparseAvxStore(dst + (i)*out_stride, acc##i, act_type, cols);   \
+  }
+#define SPARSE_AVX_BLOCK_FMA(i)                                                \
+  if (rows > (i)) {                                                            \
+    acc##i = _mm256_fmadd_ps(_mm256_set1_ps(value[(i)]), data0, acc##i);      \
+  }
+#define SPARSE_AVX_BLOCK_FMA2(i)                                               \
+  if (rows > (i)) {                                                            \
+    acc##i = _mm256_fmadd_ps(_mm256_set1_ps(value[(i)]), data0, acc##i);      \
+    odd##i = _mm256_fmadd_ps(_mm256_set1_ps(value_odd[(i)]), data1, odd##i);  \
+  }
+#define SPARSE_AVX_MERGE(i) acc##i = _mm256_add_ps(acc##i, odd##i);
+
+/* rows x 8 output tile of one column block, rows is 1, 4 or 12 and a constant at every call so the row macros fold
+ * away. The activation tile is packed so the 12 inputs of a deep index are adjacent. Up to 4 rows give too few
+ * accumulators to hide the fma latency, so even and odd kept blocks go to separate ones. */
+SPARSE_INLINE void SparseBlockAvxTile(float *dst, const float *src, const int *deep_index, const float *data, int nnz,
+                                      __m256 init, int act_type, int rows, int store_rows, int cols, int out_stride) {
+  SPARSE_ROWS12(SPARSE_AVX_INIT)
+  int n = 0;
+  if (rows <= C4NUM) {
+    for (; n + 1 < nnz; n += C2NUM) {
+      const float *value = src + deep_index[n] * C12NUM;
+      const float *value_odd = src + deep_index[n + 1] * C12NUM;
+      __m256 data0 = _mm256_loadu_ps(data + n * C8NUM);
+      __m256 data1 = _mm256_loadu_ps(data + (n + 1) * C8NUM);
+      SPARSE_ROWS12(SPARSE_AVX_BLOCK_FMA2)
+    }
+    SPARSE_ROWS12(SPARSE_AVX_MERGE)
+  }
+  for (; n < nnz; n++) {
+    const float *value = src + deep_index[n] * C12NUM;
+    __m256 data0 = _mm256_loadu_ps(data + n * C8NUM);
+    SPARSE_ROWS12(SPARSE_AVX_BLOCK_FMA)
+  }
+  SPARSE_ROWS12(SPARSE_AVX_STORE)
+}
+
+static void SparseBlockAvx(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type,
+                           int row, int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * C8NUM;
+    int cols = MSMIN(C8NUM, weight->col_ - col_start);
+    const int *deep_index = weight->deep_index_ + weight->block_offset_[cb];
+    const float *data = weight->data_ + (size_t)weight->block_offset_[cb] * C8NUM;
+    int nnz = weight->block_offset_[cb + 1] - weight->block_offset_[cb];
+    __m256 init = _mm256_setzero_ps();
+    if (bias != NULL) {
+      float tmp[C8NUM] = {0};
+      memcpy(tmp, bias + col_start, cols * sizeof(float));
+      init = _mm256_loadu_ps(tmp);
+    }
+    for (int r = 0; r < row; r += C12NUM) {
+      int rows = MSMIN(C12NUM, row - r);
+      float *dst = c + r * out_stride + col_start;
+      if (rows == C1NUM) {
+        SparseBlockAvxTile(dst, a + r * deep, deep_index, data, nnz, init, act_type, C1NUM, rows, cols, out_stride);
+      } else if (rows <= C4NUM) {
+        SparseBlockAvxTile(dst, a + r * deep, deep_index, data, nnz, init, act_type, C4NUM, rows, cols, out_stride);
+      } else {
+        SparseBlockAvxTile(dst, a + r * deep, deep_index, data, nnz, init, act_type, C12NUM, rows, cols, out_stride);
+      }
+    }
+  }
+}
+
+#define SPARSE_AVX_SEMI_FMA(i)                                                              \
+  if (rows > (i)) {                                                                         \
+    __m256 group##i = _mm256_broadcast_ps((const __m128 *)(src + (i)*deep + k));            \
+    acc##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position0), data0, acc##i);     \
+    if (rows <= C3NUM) {                                                                    \
+      odd##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position1), data1, odd##i);     \
+    } else {                                                                                \
+      acc##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position1), data1, acc##i);     \
+    }     \
+  }
+#define SPARSE_AVX_SEMI_TAIL(i)                                                             \
+  if (rows > (i)) {                                                                         \
+    float tail[SEMI_GROUP] = {0};                                                           \
+    memcpy(tail, src + (i)*deep + k, (deep - k) * sizeof(float));                           \
+    __m256 group##i = _mm256_broadcast_ps((const __m128 *)tail);                            \
+    acc##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position0), data0, acc##i);     \
+    if (rows <= C3NUM) {                                                                    \
+      odd##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position1), data1, odd##i);     \
+    } else {                                                                                \
+      acc##i = _mm256_fmadd_ps(_mm256_permutevar_ps(group##i, position1), data1, acc##i);     \
+    }     \
+  }
+
+/* Every lane picks its weight's input out of the group of 4 with a permute of the group broadcast to both halves, so
+ * the kernel does 2 permutes and 2 fma where the dense one does 4 fma on the same group. */
+SPARSE_INLINE void Semi2x4AvxTile(float *dst, const float *src, const uint8_t *position, const float *data, __m256 init,
+                                  int act_type, int rows, int cols, int deep, int out_stride) {
+  SPARSE_ROWS6(SPARSE_AVX_INIT)
+  int k = 0;
+  for (; k + SEMI_GROUP <= deep; k += SEMI_GROUP) {
+    __m256i position0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)position));
+    __m256i position1 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(position + C8NUM)));
+    __m256 data0 = _mm256_loadu_ps(data);
+    __m256 data1 = _mm256_loadu_ps(data + C8NUM);
+    SPARSE_ROWS6(SPARSE_AVX_SEMI_FMA)
+    position += SEMI_SLOTS * C8NUM;
+    data += SEMI_SLOTS * C8NUM;
+  }
+  if (k < deep) {
+    __m256i position0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)position));
+    __m256i position1 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(position + C8NUM)));
+    __m256 data0 = _mm256_loadu_ps(data);
+    __m256 data1 = _mm256_loadu_ps(data + C8NUM);
+    SPARSE_ROWS6(SPARSE_AVX_SEMI_TAIL)
+  }
+  if (rows <= C3NUM) {
+    SPARSE_ROWS6(SPARSE_AVX_MERGE)
+  }
+  int store_rows = rows;
+  SPARSE_ROWS6(SPARSE_AVX_STORE)
+}
+
+static void Semi2x4Avx(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type, int row,
+                       int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  int groups = UP_DIV(deep, SEMI_GROUP);
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * C8NUM;
+    int cols = MSMIN(C8NUM, weight->col_ - col_start);
+    size_t offset = (size_t)cb * groups * SEMI_SLOTS * C8NUM;
+    const uint8_t *position = weight->position_ + offset;
+    const float *data = weight->data_ + offset;
+    __m256 init = _mm256_setzero_ps();
+    if (bias != NULL) {
+      float tmp[C8NUM] = {0};
+      memcpy(tmp, bias + col_start, cols * sizeof(float));
+      init = _mm256_loadu_ps(tmp);
+    }
+    int r = 0;
+    for (; r + C6NUM <= row; r += C6NUM) {
+      Semi2x4AvxTile(c + r * out_stride + col_start, a + r * deep, position, data, init, act_type, C6NUM, cols, deep,
+                     out_stride);
+    }
+    for (; r + C3NUM <= row; r += C3NUM) {
+      Semi2x4AvxTile(c + r * out_stride + col_start, a + r * deep, position, data, init, act_type, C3NUM, cols, deep,
+                     out_stride);
+    }
+    for (; r < row; r++) {
+      Semi2x4AvxTile(c + r * out_stride + col_start, a + r * deep, position, data, init, act_type, C1NUM, cols, deep,
+                     out_stride);
+    }
+  }
+}
+
+#ifdef NNACL_AVX512_TARGET
+#define SPARSE_AVX512_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl")))
+#define SPARSE_AVX512_INLINE static inline __attribute__((always_inline)) SPARSE_AVX512_TARGET
+
+SPARSE_AVX512_INLINE __m512 SparseAvx512Act(__m512 value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm512_max_ps(value, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+  }
+  return value;
+}
+
+#define SPARSE_AVX512_INIT(i) \
+  __m512 acc##i = init;       \
+  __m512 odd##i = _mm512_setzero_ps();
+#define SPARSE_AVX512_STORE(i)                                                                  \
+  if (store_rows > (i)) {                                                                       \
+    _mm512_mask_storeu_ps(dst + (i)*out_stride, mask, SparseAvx512Act(acc##i, act_type));       \
+  }
+#define SPARSE_AVX512_BLOCK_FMA(i)                                             \
+  if (rows > (i)) {                                                            \
+    acc##i = _mm512_fmadd_ps(_mm512_set1_ps(value[(i)]), data0, acc##i);      \
+  }
+#define SPARSE_AVX512_BLOCK_FMA2(i)                                            \
+  if (rows > (i)) {                                                            \
+    acc##i = _mm512_fmadd_ps(_mm512_set1_ps(value[(i)]), data0, acc##i);      \
+    odd##i = _mm512_fmadd_ps(_mm512_set1_ps(value_odd[(i)]), data1, odd##i);  \
+  }
+#define SPARSE_AVX512_MERGE(i) acc##i = _mm512_add_ps(acc##i, odd##i);
+
+SPARSE_AVX512_INLINE void SparseBlockAvx512Tile(float *dst, const float *src, const int *deep_index, const float *data,
+                                                int nnz, __m512 init, __mmask16 mask, int act_type, int rows,
+                                                int store_rows, int out_stride) {
+  SPARSE_ROWS12(SPARSE_AVX512_INIT)
+  int n = 0;
+  if (rows <= C4NUM) {
+    for (; n + 1 < nnz; n += C2NUM) {
+      const float *value = src + deep_index[n] * C12NUM;
+      const float *value_odd = src + deep_index[n + 1] * C12NUM;
+      __m512 data0 = _mm512_loadu_ps(data + n * C16NUM);
+      __m512 data1 = _mm512_loadu_ps(data + (n + 1) * C16NUM);
+      SPARSE_ROWS12(SPARSE_AVX512_BLOCK_FMA2)
+    }
+    SPARSE_ROWS12(SPARSE_AVX512_MERGE)
+  }
+  for (; n < nnz; n++) {
+    const float *value = src + deep_index[n] * C12NUM;
+    __m512 data0 = _mm512_loadu_ps(data + n * C16NUM);
+    SPARSE_ROWS12(SPARSE_AVX512_BLOCK_FMA)
+  }
+  SPARSE_ROWS12(SPARSE_AVX512_STORE)
+}
+
+SPARSE_AVX512_TARGET static void SparseBlockAvx512(const float *a, const SparseWeight *weight, const float *bias,
+                                                   float *c, int act_type, int row, int out_stride, int start_block,
+                                                   int end_block) {
+  int deep = weight->deep_;
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * C16NUM;
+    int cols = MSMIN(C16NUM, weight->col_ - col_start);
+    __mmask16 mask = (__mmask16)((1u << cols) - 1);
+    const int *deep_index = weight->deep_index_ + weight->block_offset_[cb];
+    const float *data = weight->data_ + (size_t)weight->block_offset_[cb] * C16NUM;
+    int nnz = weight->block_offset_[cb + 1] - weight->block_offset_[cb];
+    __m512 init = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask, bias + col_start);
+    for (int r = 0; r < row; r += C12NUM) {
+      int rows = MSMIN(C12NUM, row - r);
+      float *dst = c + r * out_stride + col_start;
+      if (rows == C1NUM) {
+        SparseBlockAvx512Tile(dst, a + r * deep, deep_index, data, nnz, init, mask, act_type, C1NUM, rows, out_stride);
+      } else if (rows <= C4NUM) {
+        SparseBlockAvx512Tile(dst, a + r * deep, deep_index, data, nnz, init, mask, act_type, C4NUM, rows, out_stride);
+      } else {
+        SparseBlockAvx512Tile(dst, a + r * deep, deep_index, data, nnz, init, mask, act_type, C12NUM, rows,
+                              out_stride);
+      }
+    }
+  }
+}
+
+#define SPARSE_AVX512_SEMI_FMA(i)                                                           \
+  if (rows > (i)) {                                                                         \
+    __m512 group##i = _mm512_broadcast_f32x4(_mm_loadu_ps(src + (i)*deep + k));             \
+    acc##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position0), data0, acc##i);     \
+    if (rows <= C3NUM) {                                                                    \
+      odd##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position1), data1, odd##i);     \
+    } else {                                                                                \
+      acc##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position1), data1, acc##i);     \
+    }     \
+  }
+#define SPARSE_AVX512_SEMI_TAIL(i)                                                          \
+  if (rows > (i)) {                                                                         \
+    __mmask8 tail_mask = (__mmask8)((1u << (deep - k)) - 1);                                \
+    __m512 group##i = _mm512_broadcast_f32x4(_mm_maskz_loadu_ps(tail_mask, src + (i)*deep + k)); \
+    acc##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position0), data0, acc##i);     \
+    if (rows <= C3NUM) {                                                                    \
+      odd##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position1), data1, odd##i);     \
+    } else {                                                                                \
+      acc##i = _mm512_fmadd_ps(_mm512_permutevar_ps(group##i, position1), data1, acc##i);     \
+    }     \
+  }
+
+SPARSE_AVX512_INLINE void Semi2x4Avx512Tile(float *dst, const float *src, const uint8_t *position, const float *data,
+                                            __m512 init, __mmask16 mask, int act_type, int rows, int deep,
+                                            int out_stride) {
+  SPARSE_ROWS6(SPARSE_AVX512_INIT)
+  int k = 0;
+  for (; k + SEMI_GROUP <= deep; k += SEMI_GROUP) {
+    __m512i position0 = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)position));
+    __m512i position1 = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(position + C16NUM)));
+    __m512 data0 = _mm512_loadu_ps(data);
+    __m512 data1 = _mm512_loadu_ps(data + C16NUM);
+    SPARSE_ROWS6(SPARSE_AVX512_SEMI_FMA)
+    position += SEMI_SLOTS * C16NUM;
+    data += SEMI_SLOTS * C16NUM;
+  }
+  if (k < deep) {
+    __m512i position0 = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)position));
+    __m512i position1 = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(position + C16NUM)));
+    __m512 data0 = _mm512_loadu_ps(data);
+    __m512 data1 = _mm512_loadu_ps(data + C16NUM);
+    SPARSE_ROWS6(SPARSE_AVX512_SEMI_TAIL)
+  }
+  if (rows <= C3NUM) {
+    SPARSE_ROWS6(SPARSE_AVX512_MERGE)
+  }
+  int store_rows = rows;
+  SPARSE_ROWS6(SPARSE_AVX512_STORE)
+}
+
+SPARSE_AVX512_TARGET static void Semi2x4Avx512(const float *a, const SparseWeight *weight, const float *bias, float *c,
+                                               int act_type, int row, int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  int groups = UP_DIV(deep, SEMI_GROUP);
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * C16NUM;
+    int cols = MSMIN(C16NUM, weight->col_ - col_start);
+    __mmask16 mask = (__mmask16)((1u << cols) - 1);
+    size_t offset = (size_t)cb * groups * SEMI_SLOTS * C16NUM;
+    const uint8_t *position = weight->position_ + offset;
+    const float *data = weight->data_ + offset;
+    __m512 init = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask, bias + col_start);
+    int r = 0;
+    for (; r + C6NUM <= row; r += C6NUM) {
+      Semi2x4Avx512Tile(c + r * out_stride + col_start, a + r * deep, position, data, init, mask, act_type, C6NUM, deep,
+                        out_stride);
+    }
+    for (; r + C3NUM <= row; r += C3NUM) {
+      Semi2x4Avx512Tile(c + r * out_stride + col_start, a + r * deep, position, data, init, mask, act_type, C3NUM, deep,
+                        out_stride);
+    }
+    for (; r < row; r++) {
+      Semi2x4Avx512Tile(c + r * out_stride + col_start, a + r * deep, position, data, init, mask, act_type, C1NUM, deep,
+                        out_stride);
+    }
+  }
+}
+#endif
+#endif
+
+#ifdef ENABLE_ARM64
+static inline float32x4_t SparseNeonAct(float32x4_t value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = vmaxq_f32(value, vdupq_n_f32(0.0f));
+  }
+  if (act_type == ActType_Relu6) {
+    value = vminq_f32(value, vdupq_n_f32(6.0f));
+  }
+  return value;
+}
+
+static inline void SparseNeonStore(float *dst, float32x4_t value0, float32x4_t value1, int act_type, int cols) {
+  value0 = SparseNeonAct(value0, act_type);
+  value1 = SparseNeonAct(value1, act_type);
+  if (cols == C8NUM) {
+    vst1q_f32(dst, value0);
+    vst1q_f32(dst + C4NUM, value1);
+    return;
+  }
+  float tmp[C8NUM];
+  vst1q_f32(tmp, value0);
+  vst1q_f32(tmp + C4NUM, value1);
+  memcpy(dst, tmp, cols * sizeof(float));
+}
+
+#define SPARSE_NEON_ROWS12(X)                                                   \
+  X(0, 0, 0) X(1, 0, 1) X(2, 0, 2) X(3, 0, 3) X(4, 1, 0) X(5, 1, 1) X(6, 1, 2) X(7, 1, 3) \
+    X(8, 2, 0) X(9, 2, 1) X(10, 2, 2) X(11, 2, 3)
+#define SPARSE_NEON_INIT(i, v, l)   \
+  float32x4_t acc##i##_0 = init0; \
+  float32x4_t acc##i##_1 = init1;
+#define SPARSE_NEON_FMA(i, v, l)                                   \
+  acc##i##_0 = vfmaq_laneq_f32(acc##i##_0, data0, value##v, l); \
+  acc##i##_1 = vfmaq_laneq_f32(acc##i##_1, data1, value##v, l);
+#define SPARSE_NEON_STORE(i, v, l)                                                 \
+  if (rows > (i)) {                                                                \
+    SparseNeonStore(dst + (i)*out_stride, acc##i##_0, acc##i##_1, act_type, cols); \
+  }
+
+SPARSE_INLINE void SparseBlockNeonTile(float *dst, const float *src, const int *deep_index, const float *data, int nnz,
+                                       float32x4_t init0, float32x4_t init1, int act_type, int rows, int cols,
+                                       int out_stride) {
+  SPARSE_NEON_ROWS12(SPARSE_NEON_INIT)
+  for (int n = 0; n < nnz; n++) {
+    const float *value = src + deep_index[n] * C12NUM;
+    float32x4_t value0 = vld1q_f32(value);
+    float32x4_t value1 = vld1q_f32(value + C4NUM);
+    float32x4_t value2 = vld1q_f32(value + C8NUM);
+    float32x4_t data0 = vld1q_f32(data + n * C8NUM);
+    float32x4_t data1 = vld1q_f32(data + n * C8NUM + C4NUM);
+    SPARSE_NEON_ROWS12(SPARSE_NEON_FMA)
+  }
+  SPARSE_NEON_ROWS12(SPARSE_NEON_STORE)
+}
+
+static void SparseBlockNeon64(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type,
+                              int row, int out_stride, int start_block, int end_block) {
+  int deep = weight->deep_;
+  for (int cb = start_block; cb < end_block; cb++) {
+    int col_start = cb * C8NUM;
+    int cols = MSMIN(C8NUM, weight->col_ - col_start);
+    const int *deep_index = weight->deep_index_ + weight->block_offset_[cb];
+    const float *data = weight->data_ + (size_t)weight->block_offset_[cb] * C8NUM;
+    int nnz = weight->block_offset_[cb + 1] - weight->block_offset_[cb];
+    float tmp[C8NUM] = {0};
+    if (bias != NULL) {
+      memcpy(tmp, bias + col_start, cols * sizeof(float));
+    }
+    float32x4_t init0 = vld1q_f32(tmp);
+    float32x4_t init1 = vld1q_f32(tmp + C4NUM);
+    for (int r = 0; r < row; r += C12NUM) {
+      SparseBlockNeonTile(c + r * out_stride + col_start, a + r * deep, deep_index, data, nnz, init0, init1, act_type,
+                          MSMIN(C12NUM, row - r), cols, out_stride);
+    }
+  }
+}
+#endif
+
+void MatMulSparseFp32(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type, int row,
+                      int out_stride, int start_block, int end_block) {
+  if (weight->type_ == SparseWeight_Block) {
+#ifdef ENABLE_AVX
+#ifdef NNACL_AVX512_TARGET
+    if (weight->block_ == C16NUM) {
+      SparseBlockAvx512(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+      return;
+    }
+#endif
+    if (weight->block_ == C8NUM) {
+      SparseBlockAvx(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+      return;
+    }
+#elif defined(ENABLE_ARM64)
+    if (weight->block_ == C8NUM) {
+      SparseBlockNeon64(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+      return;
+    }
+#endif
+    SparseBlockC(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+  } else if (weight->type_ == SparseWeight_Semi2x4) {
+#ifdef ENABLE_AVX
+#ifdef NNACL_AVX512_TARGET
+    if (weight->block_ == C16NUM) {
+      Semi2x4Avx512(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+      return;
+    }
+#endif
+    if (weight->block_ == C8NUM) {
+      Semi2x4Avx(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+      return;
+    }
+#endif
+    Semi2x4C(a, weight, bias, c, act_type, row, out_stride, start_block, end_block);
+  }
+}
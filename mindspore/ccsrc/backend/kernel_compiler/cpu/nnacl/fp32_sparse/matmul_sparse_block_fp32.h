@@ -0,0 +1,83 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_SPARSE_BLOCK_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_SPARSE_BLOCK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum SparseWeightType {
+  SparseWeight_Dense = 0,
+  /* blocks of block_ consecutive output channels at one deep index, only blocks holding a non-zero weight are kept */
+  SparseWeight_Block = 1,
+  /* at most 2 non-zero weights in every group of 4 consecutive deep indices of an output channel */
+  SparseWeight_Semi2x4 = 2
+} SparseWeightType;
+
+/* Sparse weight of a matmul with a constant deep x col weight. The output channels are cut into col_blocks_ blocks of
+ * block_ channels, one simd register of the kernel, and the kernels compute them block by block.
+ * Block: block_offset_[cb] .. block_offset_[cb + 1] index the kept blocks of column block cb, deep_index_ holds their
+ * deep index and data_ their block_ weights.
+ * Semi2x4: every column block has UP_DIV(deep_, 4) groups of 2 slots of block_ weights, position_ holds the index of
+ * each weight inside its group of 4. */
+typedef struct SparseWeight {
+  SparseWeightType type_;
+  int deep_;
+  int col_;
+  int block_;
+  int col_blocks_;
+  int nnz_;
+  int *block_offset_;
+  int *deep_index_;
+  uint8_t *position_;
+  float *data_;
+} SparseWeight;
+
+/* output channels per block of the kernels this host runs */
+int SparseWeightBlock(void);
+
+/* number of blocks of block output channels at one deep index holding a non-zero weight */
+int SparseBlockNnz(const float *weight, int deep, int col, int block, bool b_transpose);
+bool IsSemi2x4Weight(const float *weight, int deep, int col, bool b_transpose);
+
+/* Sparse layout expected to beat the dense kernel for this shape, or SparseWeight_Dense. The costs are the measured
+ * throughput of each kernel relative to the dense one. */
+SparseWeightType ChooseSparseWeight(int row, int deep, int col, int block, int block_nnz, bool semi_2x4);
+
+/* bytes of index and of data a weight of this type takes, nnz is the result of SparseBlockNnz for the block type */
+size_t SparseWeightIndexSize(SparseWeightType type, int deep, int col, int block, int nnz);
+size_t SparseWeightDataSize(SparseWeightType type, int deep, int col, int block, int nnz);
+
+/* fills the sparse weight, type_, deep_, col_, block_ and the buffers are set by the caller */
+void PackSparseWeight(const float *weight, bool b_transpose, SparseWeight *dst);
+
+/* c[row x out_stride] = a[row x deep] * weight + bias for the column blocks [start_block, end_block), only the col_
+ * first channels are stored. a is packed by RowMajor2Col12Major for the block type, so the 12 inputs of a row tile at
+ * one deep index are adjacent, and is row-major for the semi 2x4 type, which reads groups of 4 inputs of a row. */
+void MatMulSparseFp32(const float *a, const SparseWeight *weight, const float *bias, float *c, int act_type, int row,
+                      int out_stride, int start_block, int end_block);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_SPARSE_BLOCK_H_
@@ -73,6 +73,14 @@ void MatMulInt8_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row
                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                        int32_t maxi, size_t per_channel, const int32_t *filter_zp);
 
+#ifdef ENABLE_AVX
+/* same layouts as MatMulInt8_4x16_r, runs on avx512 vnni when the cpu has it and on avx2 otherwise */
+void MatMulInt8Avx_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+#endif
+
 #ifdef ENABLE_ARM64
 void MatmulInt8Neon64(const int8_t *a, const int8_t *b, int8_t *dst, int row4, int col4, int deep16, const int *a_sums,
                       const int *bias, int act_min, int act_max, int out_zp, int32_t *multiplier, int32_t *left_shift,
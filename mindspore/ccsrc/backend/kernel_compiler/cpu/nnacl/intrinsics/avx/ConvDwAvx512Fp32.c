@@ -0,0 +1,122 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include "nnacl/fp32/conv_depthwise_fp32.h"
+#include "nnacl/nnacl_utils.h"
+
+#ifdef NNACL_AVX512_TARGET
+#define AVX512_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl")))
+#define AVX512_INLINE static inline __attribute__((always_inline)) AVX512_TARGET
+
+#define AVX512_DW_PIXELS(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11)
+
+#define AVX512_DW_INIT_PIXEL(i)                                                                 \
+  __m512 acc##i##_0 = _mm512_setzero_ps();                                                      \
+  __m512 acc##i##_1 = _mm512_setzero_ps();                                                      \
+  if (pixels > (i) && bias != NULL) {                                                           \
+    acc##i##_0 = _mm512_maskz_loadu_ps(mask0, bias);                                            \
+    if (vecs > 1) {                                                                             \
+      acc##i##_1 = _mm512_maskz_loadu_ps(mask1, bias + C16NUM);                                 \
+    }                                                                                           \
+  }
+
+#define AVX512_DW_FMA_PIXEL(i)                                                                               \
+  if (pixels > (i)) {                                                                                        \
+    const float *src##i = src_kw + (i)*in_sw_step;                                                          \
+    acc##i##_0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask0, src##i), weight0, acc##i##_0);               \
+    if (vecs > 1) {                                                                                          \
+      acc##i##_1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask1, src##i + C16NUM), weight1, acc##i##_1);     \
+    }                                                                                                        \
+  }
+
+#define AVX512_DW_STORE_PIXEL(i)                                                                      \
+  if (pixels > (i)) {                                                                                 \
+    _mm512_mask_storeu_ps(dst + (i)*oc_algin, mask0, Avx512DwAct(acc##i##_0, act_flag));              \
+    if (vecs > 1) {                                                                                   \
+      _mm512_mask_storeu_ps(dst + (i)*oc_algin + C16NUM, mask1, Avx512DwAct(acc##i##_1, act_flag));   \
+    }                                                                                                 \
+  }
+
+/* act_flag as for the avx2 kernels: 0x2 is relu, 0x1 is the upper bound of relu6 */
+AVX512_INLINE __m512 Avx512DwAct(__m512 value, size_t act_flag) {
+  if (0x2 & act_flag) {
+    value = _mm512_max_ps(value, _mm512_setzero_ps());
+  }
+  if (0x1 & act_flag) {
+    value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+  }
+  return value;
+}
+
+/* pixels output pixels of oc_block * C8NUM channels, held in vecs zmm registers each. pixels and vecs are constants at
+ * every call, so the pixel macros fold into straight code on vecs * pixels accumulators. */
+AVX512_INLINE void DepthwiseSWAvx512Tile(float *dst, const float *src, const float *weight, const float *bias,
+                                         size_t kernel_h, size_t kernel_w, size_t act_flag, int pixels, int vecs,
+                                         __mmask16 mask0, __mmask16 mask1, size_t oc_block, size_t oc_algin,
+                                         size_t in_kw_step, size_t in_kh_step, size_t in_sw_step,
+                                         size_t kw_remainder) {
+  AVX512_DW_PIXELS(AVX512_DW_INIT_PIXEL)
+  for (size_t kh = 0; kh < kernel_h; kh++) {
+    const float *src_kw = src + kh * in_kh_step;
+    for (size_t kw = 0; kw < kernel_w; kw++) {
+      __m512 weight0 = _mm512_maskz_loadu_ps(mask0, weight);
+      __m512 weight1 = _mm512_setzero_ps();
+      if (vecs > 1) {
+        weight1 = _mm512_maskz_loadu_ps(mask1, weight + C16NUM);
+      }
+      AVX512_DW_PIXELS(AVX512_DW_FMA_PIXEL)
+      weight += oc_block * C8NUM;
+      src_kw += in_kw_step;
+    }
+    weight += kw_remainder;
+  }
+  AVX512_DW_PIXELS(AVX512_DW_STORE_PIXEL)
+}
+
+/* Drop-in for the DepthwiseSW*Kernel of DepthwiseSWAvxFp32, on the same NHWC8 input, C8 packed weight and operands.
+ * The oc_block C8 groups are contiguous, so up to 32 channels sit in two zmm registers: a tile is 12 pixels of up to
+ * 16 channels or 6 pixels of up to 32 channels, and ow_block is 1 or the tile width. */
+AVX512_TARGET void DepthwiseSWAvx512Kernel(float *dst, const float *src, const float *weight, const float *bias,
+                                           size_t kernel_h, size_t kernel_w, size_t act_flag, size_t ow_block,
+                                           size_t oc_block, size_t oc_algin, size_t in_kw_step, size_t in_kh_step,
+                                           size_t in_sw_step, size_t kw_remainder) {
+  __mmask16 mask0 = oc_block >= C2NUM ? 0xFFFF : 0x00FF;
+  __mmask16 mask1 = oc_block >= C4NUM ? 0xFFFF : (oc_block == C3NUM ? 0x00FF : 0);
+  if (oc_block > C2NUM) {
+    if (ow_block == C6NUM) {
+      DepthwiseSWAvx512Tile(dst, src, weight, bias, kernel_h, kernel_w, act_flag, C6NUM, C2NUM, mask0, mask1,
+                            oc_block, oc_algin, in_kw_step, in_kh_step, in_sw_step, kw_remainder);
+    } else {
+      DepthwiseSWAvx512Tile(dst, src, weight, bias, kernel_h, kernel_w, act_flag, C1NUM, C2NUM, mask0, mask1,
+                            oc_block, oc_algin, in_kw_step, in_kh_step, in_sw_step, kw_remainder);
+    }
+  } else {
+    if (ow_block == C12NUM) {
+      DepthwiseSWAvx512Tile(dst, src, weight, bias, kernel_h, kernel_w, act_flag, C12NUM, C1NUM, mask0, mask1,
+                            oc_block, oc_algin, in_kw_step, in_kh_step, in_sw_step, kw_remainder);
+    } else {
+      DepthwiseSWAvx512Tile(dst, src, weight, bias, kernel_h, kernel_w, act_flag, C1NUM, C1NUM, mask0, mask1,
+                            oc_block, oc_algin, in_kw_step, in_kh_step, in_sw_step, kw_remainder);
+    }
+  }
+}
+#endif
+#endif
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/nnacl_utils.h"
+
+#ifdef NNACL_AVX512_TARGET
+#define AVX512_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl")))
+#define AVX512_INLINE static inline __attribute__((always_inline)) AVX512_TARGET
+
+#define AVX512_ROWS(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11)
+
+#define AVX512_INIT_ROW(i)                                                                           \
+  __m512 acc##i##_0 = _mm512_setzero_ps();                                                           \
+  __m512 acc##i##_1 = _mm512_setzero_ps();                                                           \
+  if (rows > (i)) {                                                                                  \
+    acc##i##_0 = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask0, bias);            \
+    if (vecs > 1) {                                                                                  \
+      acc##i##_1 = bias == NULL ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask1, bias + C16NUM); \
+    }                                                                                                \
+  }
+
+#define AVX512_FMA_ROW(i)                                        \
+  if (rows > (i)) {                                              \
+    __m512 src##i = _mm512_set1_ps(src[(i)*deep + d]);           \
+    acc##i##_0 = _mm512_fmadd_ps(src##i, weight0, acc##i##_0);   \
+    if (vecs > 1) {                                              \
+      acc##i##_1 = _mm512_fmadd_ps(src##i, weight1, acc##i##_1); \
+    }                                                            \
+  }
+
+#define AVX512_STORE_ROW(i)                                                                        \
+  if (rows > (i)) {                                                                                \
+    _mm512_mask_storeu_ps(dst + (i)*col_align, mask0, Avx512Act(acc##i##_0, act_type));            \
+    if (vecs > 1) {                                                                                \
+      _mm512_mask_storeu_ps(dst + (i)*col_align + C16NUM, mask1, Avx512Act(acc##i##_1, act_type)); \
+    }                                                                                              \
+  }
+
+AVX512_INLINE __m512 Avx512Act(__m512 value, int act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm512_max_ps(value, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm512_min_ps(value, _mm512_set1_ps(6.0f));
+  }
+  return value;
+}
+
+/* rows x block output tile, block is up to 32 columns held in vecs zmm registers. rows and vecs are constants at every
+ * call, so the row macros fold into straight code on 2 * rows accumulators. */
+AVX512_INLINE void MatMulAvx512Tile(float *dst, const float *src, const float *weight, const float *bias, int act_type,
+                                    int rows, int vecs, __mmask16 mask0, __mmask16 mask1, int block, int col_align,
+                                    int deep) {
+  AVX512_ROWS(AVX512_INIT_ROW)
+  for (int d = 0; d < deep; d++) {
+    __m512 weight0 = _mm512_maskz_loadu_ps(mask0, weight);
+    __m512 weight1 = _mm512_setzero_ps();
+    if (vecs > 1) {
+      weight1 = _mm512_maskz_loadu_ps(mask1, weight + C16NUM);
+    }
+    weight += block;
+    AVX512_ROWS(AVX512_FMA_ROW)
+  }
+  AVX512_ROWS(AVX512_STORE_ROW)
+}
+
+AVX512_INLINE void MatMulAvx512Block(float *dst, const float *src, const float *weight, const float *bias,
+                                     int act_type, int vecs, __mmask16 mask0, __mmask16 mask1, int block,
+                                     int col_align, int deep, int row) {
+  int r = 0;
+  for (; r + C12NUM <= row; r += C12NUM) {
+    MatMulAvx512Tile(dst + r * col_align, src + r * deep, weight, bias, act_type, C12NUM, vecs, mask0, mask1, block,
+                     col_align, deep);
+  }
+  for (; r + C4NUM <= row; r += C4NUM) {
+    MatMulAvx512Tile(dst + r * col_align, src + r * deep, weight, bias, act_type, C4NUM, vecs, mask0, mask1, block,
+                     col_align, deep);
+  }
+  for (; r < row; r++) {
+    MatMulAvx512Tile(dst + r * col_align, src + r * deep, weight, bias, act_type, C1NUM, vecs, mask0, mask1, block,
+                     col_align, deep);
+  }
+}
+
+/* Same operands as MatMulAvxFp32: a is row-major, b is packed by RowMajor2Row32Major / RowMajor2Col32Major into
+ * blocks of 32 (the last one 24, 16 or 8) columns, c is row-major with col_align columns. Each block is two zmm wide,
+ * so packed weights serve the avx2 and the avx512 kernels alike and the choice between them is made per call. */
+AVX512_TARGET void MatMulAvx512Fp32(const float *a, const float *b, float *c, const float *bias, int act_type,
+                                    int depth, int cur_col, int col_align, int row) {
+  for (int col_index = 0; col_index < cur_col; col_index += C32NUM) {
+    int block = MSMIN(C32NUM, cur_col - col_index);
+    const float *weight = b + col_index * depth;
+    const float *cur_bias = bias == NULL ? NULL : bias + col_index;
+    __mmask16 mask0 = block >= C16NUM ? 0xFFFF : (__mmask16)((1 << block) - 1);
+    __mmask16 mask1 = block > C16NUM ? (__mmask16)((1 << (block - C16NUM)) - 1) : 0;
+    if (block > C16NUM) {
+      MatMulAvx512Block(c + col_index, a, weight, cur_bias, act_type, C2NUM, mask0, mask1, block, col_align, depth,
+                        row);
+    } else {
+      MatMulAvx512Block(c + col_index, a, weight, cur_bias, act_type, C1NUM, mask0, mask1, block, col_align, depth,
+                        row);
+    }
+  }
+}
+#endif
+#endif
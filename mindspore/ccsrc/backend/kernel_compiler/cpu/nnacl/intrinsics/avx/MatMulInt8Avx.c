@@ -0,0 +1,172 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/fixed_point.h"
+#include "nnacl/nnacl_utils.h"
+
+static void Int8RequantRow(const int32_t *acc, int8_t *dst, size_t r, size_t c, size_t cols, const int32_t *input_sum,
+                           const int32_t *bias, const int32_t *left_shift, const int32_t *right_shift,
+                           const int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi,
+                           size_t per_channel, const int32_t *filter_zp) {
+  for (size_t i = 0; i < cols; i++) {
+    size_t ci = c + i;
+    int32_t value = acc[i];
+    value -= per_channel ? input_sum[r] * filter_zp[ci] : input_sum[r];
+    value += bias[ci];
+    int32_t cur_left_shift = per_channel ? left_shift[ci] : left_shift[0];
+    int32_t cur_right_shift = per_channel ? right_shift[ci] : right_shift[0];
+    int32_t cur_multiplier = per_channel ? multiplier[ci] : multiplier[0];
+    value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + output_zp;
+    value = MSMIN(maxi, value);
+    value = MSMAX(mini, value);
+    dst[i] = (int8_t)value;
+  }
+}
+
+static inline int32_t LoadInt8x4(const int8_t *src) {
+  int32_t value;
+  memcpy(&value, src, sizeof(int32_t));
+  return value;
+}
+
+// Sums of adjacent int32 pairs of two madd results, ordered as the 8 output channels they belong to.
+static inline __m256i ReducePairs(__m256i lo, __m256i hi) {
+  return _mm256_permute4x64_epi64(_mm256_hadd_epi32(lo, hi), 0xD8);
+}
+
+/* row4x4-major * row4x16-major => (int8)row-major
+ * vpmaddubsw saturates its int16 pair sums, so the operands are sign extended to int16 and multiplied with
+ * vpmaddwd, which keeps every product and sum exact. One load of a covers the 4 rows of a deep step, each row is then
+ * broadcast to the 4 output channels of a madd by a lane permute. */
+static void MatMulInt8Avx2_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col,
+                                  size_t deep_4, size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                  const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                  int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                  const int32_t *filter_zp) {
+  int32_t acc[C4NUM * C8NUM];
+  for (size_t c = 0; c < col; c += C8NUM) {
+    size_t cols = MSMIN(C8NUM, col - c);
+    const int8_t *b_block = b + (c / C16NUM) * deep_4 * C16NUM + (c % C16NUM) * C4NUM;
+    for (size_t r = 0; r < row; r += C4NUM) {
+      const int8_t *a_block = a + r * deep_4;
+      __m256i acc00 = _mm256_setzero_si256();
+      __m256i acc01 = _mm256_setzero_si256();
+      __m256i acc10 = _mm256_setzero_si256();
+      __m256i acc11 = _mm256_setzero_si256();
+      __m256i acc20 = _mm256_setzero_si256();
+      __m256i acc21 = _mm256_setzero_si256();
+      __m256i acc30 = _mm256_setzero_si256();
+      __m256i acc31 = _mm256_setzero_si256();
+      for (size_t d = 0; d < deep_4; d += C4NUM) {
+        const int8_t *b_ptr = b_block + d * C16NUM;
+        const int8_t *a_ptr = a_block + d * C4NUM;
+        __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b_ptr));
+        __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C16NUM)));
+        __m256i a_rows = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)a_ptr));
+        __m256i a0 = _mm256_permute4x64_epi64(a_rows, 0x00);
+        acc00 = _mm256_add_epi32(acc00, _mm256_madd_epi16(a0, b0));
+        acc01 = _mm256_add_epi32(acc01, _mm256_madd_epi16(a0, b1));
+        __m256i a1 = _mm256_permute4x64_epi64(a_rows, 0x55);
+        acc10 = _mm256_add_epi32(acc10, _mm256_madd_epi16(a1, b0));
+        acc11 = _mm256_add_epi32(acc11, _mm256_madd_epi16(a1, b1));
+        __m256i a2 = _mm256_permute4x64_epi64(a_rows, 0xAA);
+        acc20 = _mm256_add_epi32(acc20, _mm256_madd_epi16(a2, b0));
+        acc21 = _mm256_add_epi32(acc21, _mm256_madd_epi16(a2, b1));
+        __m256i a3 = _mm256_permute4x64_epi64(a_rows, 0xFF);
+        acc30 = _mm256_add_epi32(acc30, _mm256_madd_epi16(a3, b0));
+        acc31 = _mm256_add_epi32(acc31, _mm256_madd_epi16(a3, b1));
+      }
+      _mm256_storeu_si256((__m256i *)acc, ReducePairs(acc00, acc01));
+      _mm256_storeu_si256((__m256i *)(acc + C8NUM), ReducePairs(acc10, acc11));
+      _mm256_storeu_si256((__m256i *)(acc + C16NUM), ReducePairs(acc20, acc21));
+      _mm256_storeu_si256((__m256i *)(acc + C24NUM), ReducePairs(acc30, acc31));
+      size_t rows = MSMIN(C4NUM, row - r);
+      for (size_t i = 0; i < rows; i++) {
+        Int8RequantRow(acc + i * C8NUM, dst + (r + i) * stride + c, r + i, c, cols, input_sum, bias, left_shift,
+                       right_shift, multiplier, output_zp, mini, maxi, per_channel, filter_zp);
+      }
+    }
+  }
+}
+
+#ifdef NNACL_AVX512_TARGET
+/* row4x4-major * row4x16-major => (int8)row-major
+ * vpdpbusd takes unsigned activations, so a is biased by 128 and 128 * sum(b) of each output channel, computed once
+ * per 16 channels, is taken off the accumulators again. */
+__attribute__((target("avx2,avx512f,avx512bw,avx512vnni"))) static void MatMulInt8Vnni_4x16_r(
+  const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4, size_t stride,
+  const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift, const int32_t *right_shift,
+  const int32_t *multiplier, int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+  const int32_t *filter_zp) {
+  const int32_t sign_flip = (int32_t)0x80808080;
+  const __m512i sign_flip_vec = _mm512_set1_epi32(sign_flip);
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t c = 0; c < col; c += C16NUM) {
+    size_t cols = MSMIN(C16NUM, col - c);
+    const int8_t *b_block = b + c * deep_4;
+    __m512i b_bias = _mm512_setzero_si512();
+    for (size_t d = 0; d < deep_4; d += C4NUM) {
+      b_bias = _mm512_dpbusd_epi32(b_bias, sign_flip_vec, _mm512_loadu_si512(b_block + d * C16NUM));
+    }
+    for (size_t r = 0; r < row; r += C4NUM) {
+      const int8_t *a_block = a + r * deep_4;
+      __m512i acc0 = _mm512_setzero_si512();
+      __m512i acc1 = _mm512_setzero_si512();
+      __m512i acc2 = _mm512_setzero_si512();
+      __m512i acc3 = _mm512_setzero_si512();
+      for (size_t d = 0; d < deep_4; d += C4NUM) {
+        const int8_t *a_ptr = a_block + d * C4NUM;
+        __m512i b0 = _mm512_loadu_si512(b_block + d * C16NUM);
+        acc0 = _mm512_dpbusd_epi32(acc0, _mm512_set1_epi32(LoadInt8x4(a_ptr) ^ sign_flip), b0);
+        acc1 = _mm512_dpbusd_epi32(acc1, _mm512_set1_epi32(LoadInt8x4(a_ptr + C4NUM) ^ sign_flip), b0);
+        acc2 = _mm512_dpbusd_epi32(acc2, _mm512_set1_epi32(LoadInt8x4(a_ptr + C8NUM) ^ sign_flip), b0);
+        acc3 = _mm512_dpbusd_epi32(acc3, _mm512_set1_epi32(LoadInt8x4(a_ptr + C12NUM) ^ sign_flip), b0);
+      }
+      _mm512_storeu_si512(acc, _mm512_sub_epi32(acc0, b_bias));
+      _mm512_storeu_si512(acc + C16NUM, _mm512_sub_epi32(acc1, b_bias));
+      _mm512_storeu_si512(acc + C32NUM, _mm512_sub_epi32(acc2, b_bias));
+      _mm512_storeu_si512(acc + C48NUM, _mm512_sub_epi32(acc3, b_bias));
+      size_t rows = MSMIN(C4NUM, row - r);
+      for (size_t i = 0; i < rows; i++) {
+        Int8RequantRow(acc + i * C16NUM, dst + (r + i) * stride + c, r + i, c, cols, input_sum, bias, left_shift,
+                       right_shift, multiplier, output_zp, mini, maxi, per_channel, filter_zp);
+      }
+    }
+  }
+}
+#endif
+
+void MatMulInt8Avx_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+#ifdef NNACL_AVX512_TARGET
+  if (GetX86Isa() >= X86_ISA_AVX512_VNNI) {
+    MatMulInt8Vnni_4x16_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                          output_zp, mini, maxi, per_channel, filter_zp);
+    return;
+  }
+#endif
+  MatMulInt8Avx2_4x16_r(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                        output_zp, mini, maxi, per_channel, filter_zp);
+}
+#endif
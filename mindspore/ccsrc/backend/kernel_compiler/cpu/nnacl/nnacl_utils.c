@@ -18,6 +18,16 @@
 #ifdef __ANDROID__
 #include <sys/auxv.h>
 #endif
+#ifdef NNACL_X86
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
 
 #if defined(__ANDROID__)
 uint32_t getHwCap(int hwcap_type) {
@@ -25,3 +35,102 @@ uint32_t getHwCap(int hwcap_type) {
   return ret;
 }
 #endif
+
+#ifdef NNACL_X86
+#define CPUID_EAX 0
+#define CPUID_EBX 1
+#define CPUID_ECX 2
+#define CPUID_EDX 3
+/* xcr0 bits of the sse, avx and avx512 register state that the os saves on context switch */
+#define XCR0_YMM_STATE 0x6
+#define XCR0_ZMM_STATE 0xE6
+
+static const char *kX86IsaNames[] = {"none", "sse", "avx2", "avx512", "avx512_vnni", "avx512_bf16"};
+
+static void X86Cpuid(uint32_t leaf, uint32_t sub_leaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+  __cpuidex((int *)regs, (int)leaf, (int)sub_leaf);
+#else
+  __cpuid_count(leaf, sub_leaf, regs[CPUID_EAX], regs[CPUID_EBX], regs[CPUID_ECX], regs[CPUID_EDX]);
+#endif
+}
+
+static uint64_t X86Xcr0(void) {
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  uint32_t eax;
+  uint32_t edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+static bool HasBits(uint32_t reg, uint32_t bits) { return (reg & bits) == bits; }
+
+static X86Isa ProbeX86Isa(void) {
+  uint32_t regs[4] = {0};
+  X86Cpuid(0, 0, regs);
+  uint32_t max_leaf = regs[CPUID_EAX];
+  if (max_leaf < 1) {
+    return X86_ISA_NONE;
+  }
+  X86Cpuid(1, 0, regs);
+  uint32_t leaf1_ecx = regs[CPUID_ECX];
+  if (!HasBits(leaf1_ecx, 1u << 19)) {
+    return X86_ISA_NONE;
+  }
+  /* osxsave, avx, fma */
+  if (max_leaf < 7 || !HasBits(leaf1_ecx, (1u << 27) | (1u << 28) | (1u << 12))) {
+    return X86_ISA_SSE;
+  }
+  uint64_t xcr0 = X86Xcr0();
+  X86Cpuid(7, 0, regs);
+  if (!HasBits((uint32_t)xcr0, XCR0_YMM_STATE) || !HasBits(regs[CPUID_EBX], 1u << 5)) {
+    return X86_ISA_SSE;
+  }
+  /* avx512 f, dq, bw, vl */
+  if (!HasBits((uint32_t)xcr0, XCR0_ZMM_STATE) ||
+      !HasBits(regs[CPUID_EBX], (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31))) {
+    return X86_ISA_AVX2;
+  }
+  if (!HasBits(regs[CPUID_ECX], 1u << 11)) {
+    return X86_ISA_AVX512;
+  }
+  /* leaf 7 sub-leaf 1 is only there when sub-leaf 0 reports it */
+  if (regs[CPUID_EAX] < 1) {
+    return X86_ISA_AVX512_VNNI;
+  }
+  X86Cpuid(7, 1, regs);
+  return HasBits(regs[CPUID_EAX], 1u << 5) ? X86_ISA_AVX512_BF16 : X86_ISA_AVX512_VNNI;
+}
+
+static X86Isa CapX86Isa(X86Isa isa) {
+  const char *max_isa = getenv("MSLITE_MAX_CPU_ISA");
+  if (max_isa == NULL) {
+    return isa;
+  }
+  for (int i = X86_BUILD_ISA; i <= X86_ISA_AVX512_BF16; i++) {
+    if (strcmp(max_isa, kX86IsaNames[i]) == 0) {
+      return isa < (X86Isa)i ? isa : (X86Isa)i;
+    }
+  }
+  return isa;
+}
+
+X86Isa GetX86Isa(void) {
+  /* racing first callers all store the same value */
+  static volatile int isa = -1;
+  if (isa < 0) {
+    isa = (int)CapX86Isa(ProbeX86Isa());
+  }
+  return (X86Isa)isa;
+}
+
+const char *X86IsaName(X86Isa isa) {
+  if (isa < X86_ISA_NONE || isa > X86_ISA_AVX512_BF16) {
+    return kX86IsaNames[X86_ISA_NONE];
+  }
+  return kX86IsaNames[isa];
+}
+#endif
@@ -26,6 +26,45 @@ extern "C" {
 uint32_t getHwCap(int hwcap_type);
 #endif
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NNACL_X86
+/* ordered, every level includes the ones below it */
+typedef enum X86Isa {
+  X86_ISA_NONE = 0,
+  X86_ISA_SSE = 1,         /* sse4.1 */
+  X86_ISA_AVX2 = 2,        /* avx, avx2, fma */
+  X86_ISA_AVX512 = 3,      /* avx512 f, bw, dq, vl */
+  X86_ISA_AVX512_VNNI = 4, /* avx512 vnni */
+  X86_ISA_AVX512_BF16 = 5  /* avx512 bf16 */
+} X86Isa;
+
+/* isa this build is compiled for, kernels without a run time pick need the host to support it */
+#if defined(ENABLE_AVX512)
+#define X86_BUILD_ISA X86_ISA_AVX512
+#elif defined(ENABLE_AVX)
+#define X86_BUILD_ISA X86_ISA_AVX2
+#elif defined(ENABLE_SSE)
+#define X86_BUILD_ISA X86_ISA_SSE
+#else
+#define X86_BUILD_ISA X86_ISA_NONE
+#endif
+
+/* Best isa of the host, probed with cpuid once per process. Kernels above X86_BUILD_ISA are picked with it at run
+ * time. Setting the environment variable MSLITE_MAX_CPU_ISA to sse, avx2, avx512, avx512_vnni or avx512_bf16 caps the
+ * result, but never below X86_BUILD_ISA, to compare kernels or to rule out a faulty one. */
+X86Isa GetX86Isa(void);
+const char *X86IsaName(X86Isa isa);
+
+/* compilers that build kernels above X86_BUILD_ISA with a function target attribute */
+#if !defined(_MSC_VER) && (defined(__clang__) || __GNUC__ >= 9)
+#define NNACL_AVX512_TARGET
+#endif
+/* the avx512 bf16 intrinsics came with gcc 10 and clang 9 */
+#if !defined(_MSC_VER) && ((defined(__clang__) && __clang_major__ >= 9) || (!defined(__clang__) && __GNUC__ >= 10))
+#define NNACL_AVX512_BF16_TARGET
+#endif
+#endif
+
 #ifdef DEBUG
 #include <assert.h>
 #define NNACL_ASSERT(f) assert(f)
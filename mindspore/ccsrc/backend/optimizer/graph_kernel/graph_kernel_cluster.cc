@@ -32,6 +32,9 @@
 #include "backend/optimizer/graph_kernel/core/graph_kernel_callback.h"
 #include "backend/optimizer/graph_kernel/core/graph_kernel_utils.h"
 #include "backend/optimizer/graph_kernel/core/graph_builder.h"
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_kernel_mod.h"
+#endif
 
 namespace mindspore::graphkernel {
 using opt::GetitemTuple;
@@ -127,6 +130,11 @@ bool GraphKernelCluster::IsClusterableOp(const AnfNodePtr &node) {
       return false;
     }
   }
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+  if (!kernel::CpuGraphKernelCanFuse(node)) {
+    return false;
+  }
+#endif
   return true;
 }
 
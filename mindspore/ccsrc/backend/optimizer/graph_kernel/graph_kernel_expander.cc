@@ -39,6 +39,9 @@
 #include "runtime/device/kernel_info.h"
 #include "backend/optimizer/graph_kernel/expanders/expander_factory.h"
 #include "backend/optimizer/graph_kernel/core/graph_builder.h"
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_kernel_mod.h"
+#endif
 
 namespace mindspore::graphkernel {
 namespace {
@@ -228,6 +231,12 @@ bool GraphKernelExpander::DoExpand(const FuncGraphPtr &func_graph) {
       MS_LOG(DEBUG) << "Skipped node: " << node->fullname_with_scope();
       continue;
     }
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+    if (!kernel::CpuGraphKernelCanFuse(new_node)) {
+      MS_LOG(DEBUG) << "Skipped node: " << node->fullname_with_scope() << ", its expansion can not be built.";
+      continue;
+    }
+#endif
     (void)mng->Replace(node, new_node);
     changed = true;
   }
@@ -18,15 +18,20 @@
 #include <vector>
 #include <set>
 #include <memory>
+#include <numeric>
+#include <functional>
 
 #include "utils/hash_map.h"
 #include "ir/graph_utils.h"
 #include "base/core_ops.h"
+#include "abstract/utils.h"
 #include "runtime/device/kernel_info.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
 #include "backend/optimizer/common/helper.h"
 #include "frontend/parallel/context.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket_planner.h"
 
 namespace mindspore {
 namespace opt {
@@ -135,8 +140,90 @@ bool CheckSegments(size_t segments, size_t communication_op_node_size, const std
   }
   return true;
 }
+
+bool IsBucketPlannerEnabled(const std::string &op_name) {
+  auto algorithm = parallel::CostModelContext::GetInstance()->costmodel_allreduce_fusion_algorithm();
+  return op_name == kAllReduceOpName && algorithm == parallel::ALLREDUCE_FUSION_ALGORITHM_BUCKET_PLANNER;
+}
+
+size_t GetOutputBytes(const AnfNodePtr &node) {
+  size_t bytes = 0;
+  size_t output_num = AnfAlgo::GetOutputTensorNum(node);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto shape = AnfAlgo::GetOutputInferShape(node, i);
+    size_t type_size = abstract::TypeIdSize(AnfAlgo::GetOutputInferDataType(node, i));
+    bytes += std::accumulate(shape.begin(), shape.end(), type_size, std::multiplies<size_t>());
+  }
+  return bytes;
+}
+
+// Estimate when the computation of each node ends. The kernels are taken as run one by one in the topological order,
+// and the time of a kernel is the size of its outputs by the computation time parameter of the cost model.
+mindspore::HashMap<AnfNodePtr, float> EstimateFinishTime(const std::vector<AnfNodePtr> &node_list,
+                                                          float *compute_end_time) {
+  MS_EXCEPTION_IF_NULL(compute_end_time);
+  auto computation_time_parameter =
+    parallel::CostModelContext::GetInstance()->costmodel_allreduce_fusion_computation_time_parameter();
+  mindspore::HashMap<AnfNodePtr, float> finish_time;
+  float time = 0;
+  for (auto &node : node_list) {
+    if (node == nullptr || !node->isa<CNode>()) {
+      continue;
+    }
+    if (AnfUtils::IsRealCNodeKernel(node) && !AnfAlgo::IsCommunicationOp(node)) {
+      time += static_cast<float>(GetOutputBytes(node) * computation_time_parameter);
+    }
+    finish_time[node] = time;
+  }
+  *compute_end_time = time;
+  return finish_time;
+}
+
+void SetGradientTimings(const mindspore::HashMap<AnfNodePtr, float> &finish_time,
+                        CommunicationOpInfo *communication_op_info) {
+  MS_EXCEPTION_IF_NULL(communication_op_info);
+  communication_op_info->input_grad_size.clear();
+  communication_op_info->input_grad_time.clear();
+  for (auto &cnode : communication_op_info->communication_op_nodes) {
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto grad = AnfAlgo::VisitKernel(AnfAlgo::GetInputNode(cnode, 0), 0).first;
+    auto iter = finish_time.find(grad);
+    communication_op_info->input_grad_size.push_back(static_cast<float>(GetOutputBytes(cnode)));
+    communication_op_info->input_grad_time.push_back(iter == finish_time.end() ? 0 : iter->second);
+  }
+}
 }  // namespace
 
+void CommunicationOpFusion::GetPlannedSegments(const CommunicationOpInfo &communication_op_info,
+                                               std::vector<size_t> *segment_index, const std::string &group) const {
+  MS_EXCEPTION_IF_NULL(segment_index);
+  size_t communication_op_node_size = communication_op_info.communication_op_nodes.size();
+  // As in the allreduce fusion algorithm 2 of the cost model, an AllReduce of n bytes takes
+  // allreduce_inherent_time + n * allreduce_bandwidth.
+  auto cost_model_context = parallel::CostModelContext::GetInstance();
+  auto time_per_byte = cost_model_context->costmodel_allreduce_fusion_allreduce_bandwidth();
+  if (time_per_byte <= 0) {
+    MS_LOG(EXCEPTION) << "'costmodel_allreduce_fusion_allreduce_bandwidth' should be positive, but got "
+                      << time_per_byte;
+  }
+  parallel::AllReduceLinkModel link;
+  link.latency = cost_model_context->costmodel_allreduce_fusion_allreduce_inherent_time();
+  link.bandwidth = 1 / time_per_byte;
+  std::vector<parallel::GradientTiming> gradients(communication_op_node_size);
+  for (size_t i = 0; i < communication_op_node_size; ++i) {
+    gradients[i].size = static_cast<size_t>(communication_op_info.input_grad_size[i]);
+    gradients[i].ready_time = communication_op_info.input_grad_time[i];
+  }
+  parallel::AllReduceBucketPlanner planner(link);
+  auto plan = planner.Plan(gradients, communication_op_info.compute_end_time);
+  auto one_bucket_plan =
+    planner.Evaluate(gradients, {communication_op_node_size - 1}, communication_op_info.compute_end_time);
+  MS_LOG(INFO) << "Plan " << plan.segment_index.size() << " buckets for the " << communication_op_node_size << " "
+               << op_name_ << " of " << group << ", estimated exposed communication time " << plan.exposed_comm_time
+               << ", which is " << one_bucket_plan.exposed_comm_time << " with one bucket";
+  *segment_index = plan.segment_index;
+}
+
 bool CommunicationOpFusion::GetSplitSegments(const CommunicationOpInfo &communication_op_info, size_t *segment_num,
                                              std::vector<size_t> *segment_index, const std::string &group) const {
   MS_EXCEPTION_IF_NULL(segment_num);
@@ -181,6 +268,9 @@ bool CommunicationOpFusion::GetSplitSegments(const CommunicationOpInfo &communic
       segment_index->push_back(communication_op_node_size - 1);
       segments++;
     }
+  } else if (IsBucketPlannerEnabled(op_name_)) {
+    GetPlannedSegments(communication_op_info, segment_index, group);
+    segments = segment_index->size();
   } else {
     segments = groups_;
     for (size_t i = 0; i < segments - 1; ++i) {
@@ -451,8 +541,6 @@ bool CommunicationOpFusion::DoFusion(const FuncGraphPtr &func_graph, const Commu
 
 bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
-  const float input_grad_size_num = 0.0;
-  const float input_grad_time_num = 0.0;
   // divide candidate fusion groups with same (group,op,fusion,dtype) attrs, fusion==0 means not fusion
   mindspore::HashMap<std::string, CommunicationOpInfo> candidate_groups;
   std::vector<AnfNodePtr> node_list = TopoSort(func_graph->get_return());
@@ -467,10 +555,13 @@ bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
         candidate_groups[key] = communication_op_info;
       }
       candidate_groups[key].communication_op_nodes.push_back(node->cast<CNodePtr>());
-      candidate_groups[key].input_grad_size.push_back(input_grad_size_num);
-      candidate_groups[key].input_grad_time.push_back(input_grad_time_num);
     }
   }
+  mindspore::HashMap<AnfNodePtr, float> finish_time;
+  float compute_end_time = 0;
+  if (IsBucketPlannerEnabled(op_name_)) {
+    finish_time = EstimateFinishTime(node_list, &compute_end_time);
+  }
   // split candidate group to segments according to _group class member
   bool changed = false;
   for (auto &it : candidate_groups) {
@@ -486,6 +577,10 @@ bool CommunicationOpFusion::Run(const FuncGraphPtr &func_graph) {
                                 AnfAlgo::GetNodeAttr<int64_t>(b, kAttrIndex);
                        });
     }
+    if (IsBucketPlannerEnabled(op_name_)) {
+      SetGradientTimings(finish_time, &it.second);
+      it.second.compute_end_time = compute_end_time;
+    }
     size_t segment_num = 0;
     std::vector<size_t> segment_index;
     if (GetSplitSegments(it.second, &segment_num, &segment_index, it.first)) {
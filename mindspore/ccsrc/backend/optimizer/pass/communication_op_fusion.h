@@ -30,6 +30,8 @@ struct CommunicationOpInfo {
   std::vector<CNodePtr> communication_op_nodes;
   std::vector<float> input_grad_size;
   std::vector<float> input_grad_time;
+  // The estimated end time of the computation of the graph, in the same unit as input_grad_time.
+  float compute_end_time = 0;
 };
 
 class CommunicationOpFusion : public Pass {
@@ -47,6 +49,8 @@ class CommunicationOpFusion : public Pass {
                                         size_t end_index) const;
   bool GetSplitSegments(const CommunicationOpInfo &communication_op_info, size_t *segment_num,
                         std::vector<size_t> *segment_index, const std::string &group) const;
+  void GetPlannedSegments(const CommunicationOpInfo &communication_op_info, std::vector<size_t> *segment_index,
+                          const std::string &group) const;
   std::string op_name_;
   size_t groups_ = 1;
 };
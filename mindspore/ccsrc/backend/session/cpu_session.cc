@@ -24,7 +24,7 @@
 #include "utils/context/graph_kernel_flags.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "runtime/device/kernel_runtime.h"
-#include "backend/kernel_compiler/akg/cpu/akg_cpu_kernel_build.h"
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_kernel_mod.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "backend/optimizer/common/optimizer.h"
@@ -106,8 +106,8 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
 }
 
 void CPUSession::GraphKernelOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
-#ifdef ENABLE_AKG
-  if (!graphkernel::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+  if (!kernel::IsEnableCpuGraphKernel()) {
     return;
   }
   graphkernel::GraphKernelOptimize(kernel_graph);
@@ -394,9 +394,8 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
     AnfAlgo::SetKernelMod(cpu_kernel, kernel_node.get());
     MS_LOG(INFO) << "Cpu build success operator[" << kernel_name << "].";
   }
-#ifdef ENABLE_AKG
-  kernel::AkgCpuKernelBuilder akg_cpu_kernel_builder;
-  (void)akg_cpu_kernel_builder.AkgKernelParallelBuild(akg_nodes);
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+  kernel::CpuGraphKernelBuild(akg_nodes);
 #endif
 }
 }  // namespace session
@@ -21,6 +21,7 @@
 #include "utils/log_adapter.h"
 
 constexpr auto kModelOptionCpuEnableFP16 = "mindspore.option.cpu.enable_fp16";
+constexpr auto kModelOptionCpuEnableBF16 = "mindspore.option.cpu.enable_bf16";
 constexpr auto kModelOptionGPUEnableFP16 = "mindspore.option.gpu.enable_fp16";
 constexpr auto kModelOptionKirinNpuFrequency = "mindspore.option.kirin_npu.frequency";
 constexpr auto kModelOptionDeviceID = "mindspore.option.device_id";
@@ -46,6 +47,7 @@ struct Context::Data {
   std::vector<std::shared_ptr<DeviceInfoContext>> device_info_list;
   int32_t thread_num;
   bool enable_parallel_ = false;
+  bool enable_inter_op_parallel_ = false;
   std::vector<int32_t> affinity_core_list_;
   int affinity_mode_ = 2;
 };
@@ -93,6 +95,16 @@ bool Context::GetEnableParallel() const {
   return data_->enable_parallel_;
 }
 
+void Context::SetEnableInterOpParallel(bool is_parallel) {
+  MS_EXCEPTION_IF_NULL(data_);
+  data_->enable_inter_op_parallel_ = is_parallel;
+}
+
+bool Context::GetEnableInterOpParallel() const {
+  MS_EXCEPTION_IF_NULL(data_);
+  return data_->enable_inter_op_parallel_;
+}
+
 void Context::SetThreadAffinity(int mode) {
   MS_EXCEPTION_IF_NULL(data_);
   data_->affinity_mode_ = mode;
@@ -127,6 +139,15 @@ bool CPUDeviceInfo::GetEnableFP16() const {
   return GetValue<bool>(data_, kModelOptionCpuEnableFP16);
 }
 
+void CPUDeviceInfo::SetEnableBF16(bool is_bf16) {
+  MS_EXCEPTION_IF_NULL(data_);
+  data_->params[kModelOptionCpuEnableBF16] = is_bf16;
+}
+bool CPUDeviceInfo::GetEnableBF16() const {
+  MS_EXCEPTION_IF_NULL(data_);
+  return GetValue<bool>(data_, kModelOptionCpuEnableBF16);
+}
+
 void GPUDeviceInfo::SetEnableFP16(bool is_fp16) {
   MS_EXCEPTION_IF_NULL(data_);
   data_->params[kModelOptionGPUEnableFP16] = is_fp16;
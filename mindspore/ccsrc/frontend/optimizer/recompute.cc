@@ -26,6 +26,9 @@
 #include "ir/func_graph.h"
 #include "mindspore/core/base/core_ops.h"
 #include "utils/utils.h"
+#include "utils/ms_context.h"
+#include "utils/convert_utils_base.h"
+#include "frontend/optimizer/recompute_planner.h"
 
 namespace mindspore {
 namespace opt {
@@ -447,6 +450,13 @@ void InsertRecomputedNodes(const FuncGraphPtr &graph) {
   std::list<CNodePtr> orders = graph->GetOrderedCnodes();
   std::vector<CNodePtr> origin_nodes_topological(orders.begin(), orders.end());
   SetRecomputedAttr(graph, origin_nodes_topological);
+  // Recompute more forward nodes if the activations exceed the memory budget.
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto memory_budget = context->get_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET);
+  if (memory_budget > 0) {
+    (void)PlanRecomputedNodes(graph, origin_nodes_topological, static_cast<int64_t>(memory_budget * kGBToByte));
+  }
   // Get candidate origin recomputed nodes which have no grad inputs and output to at least one grad node directly.
   std::vector<CNodePtr> candidate_recomputed_nodes = FindCandidateRecomputedNodes(mng, origin_nodes_topological);
   mindspore::HashSet<CNodePtr> visited_nodes;
@@ -0,0 +1,386 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/optimizer/recompute_planner.h"
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/hash_set.h"
+#include "abstract/abstract_value.h"
+#include "mindspore/core/base/core_ops.h"
+#include "ops/op_utils.h"
+#include "utils/convert_utils_base.h"
+#include "utils/flags.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr auto kGradientsFlag = "Gradients";
+constexpr size_t kConvWeightIndex = 2;
+constexpr double kFlopsPerMac = 2.0;
+
+struct PlanNode {
+  CNodePtr cnode;
+  // Alias nodes forward the tensors of their inputs, they own no memory.
+  bool is_alias = false;
+  bool can_recompute = false;
+  bool recomputed = false;
+  // Recomputed nodes that are duplicated in the backward pass, their inputs are kept until then.
+  bool recomputed_for_bprop = false;
+  bool used_by_bprop = false;
+  // The output is kept until the backward pass.
+  bool held = false;
+  int64_t bytes = 0;
+  double flops = 0;
+  // The forward nodes owning the tensors read by this node. For an alias node, the ones owning its output.
+  std::vector<size_t> producers;
+  std::vector<size_t> users;
+};
+
+bool IsBpropNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return false;
+  }
+  return node->fullname_with_scope().find(kGradientsFlag) == 0;
+}
+
+bool IsAliasNode(const CNodePtr &node) {
+  return IsPrimitiveCNode(node, prim::kPrimTupleGetItem) || IsPrimitiveCNode(node, prim::kPrimDepend) ||
+         IsPrimitiveCNode(node, prim::kPrimMakeTuple);
+}
+
+bool IsSetRecomputeCNodeAttr(const CNodePtr &node, bool value) {
+  auto recompute_val = node->GetAttr(kAttrRecompute);
+  return recompute_val != nullptr && recompute_val->isa<BoolImm>() && GetValue<bool>(recompute_val) == value;
+}
+
+bool CanRecompute(const CNodePtr &node) {
+  // The random operators generate other values when recomputed, the other ones are filtered as InsertRecomputedNodes.
+  static const std::vector<PrimitivePtr> not_recomputed_op_list{
+    prim::kPrimDropoutGenMask, prim::kPrimDropout, prim::kPrimLoad,   prim::kPrimTupleGetItem,
+    prim::kPrimSend,           prim::kPrimReceive, prim::kPrimUpdateState};
+  if (std::any_of(not_recomputed_op_list.begin(), not_recomputed_op_list.end(),
+                  [&node](const PrimitivePtr &prim) { return IsPrimitiveCNode(node, prim); })) {
+    return false;
+  }
+  auto prim = GetCNodePrimitive(node);
+  return prim != nullptr && !prim->HasAttr(ops::kSeed2) && !GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_IO) &&
+         !IsSetRecomputeCNodeAttr(node, false);
+}
+
+// The elements, or the bytes, of the tensors of an output. Dynamic shapes are unknown and count as zero.
+int64_t GetOutputSize(const AbstractBasePtr &abstract, bool in_bytes) {
+  if (abstract == nullptr) {
+    return 0;
+  }
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    int64_t size = 0;
+    for (const auto &element : abstract->cast<abstract::AbstractTuplePtr>()->elements()) {
+      size += GetOutputSize(element, in_bytes);
+    }
+    return size;
+  }
+  auto tensor = abstract->cast<abstract::AbstractTensorPtr>();
+  if (tensor == nullptr || tensor->shape() == nullptr || tensor->element() == nullptr) {
+    return 0;
+  }
+  int64_t size = in_bytes ? SizeToLong(GetTypeByte(tensor->element()->BuildType())) : 1;
+  for (auto dim : tensor->shape()->shape()) {
+    if (dim < 0) {
+      return 0;
+    }
+    size *= dim;
+  }
+  return size;
+}
+
+ShapeVector GetInputShape(const CNodePtr &node, size_t index) {
+  if (index >= node->size()) {
+    return {};
+  }
+  auto input = node->input(index);
+  MS_EXCEPTION_IF_NULL(input);
+  auto tensor = dyn_cast<abstract::AbstractTensor>(input->abstract());
+  if (tensor == nullptr || tensor->shape() == nullptr) {
+    return {};
+  }
+  return tensor->shape()->shape();
+}
+
+// A multiply-add counts as two FLOPs, the operators other than the matrix multiplications and the convolutions as one
+// FLOP per output element.
+double EstimateFlops(const CNodePtr &node) {
+  auto output_count = LongToDouble(GetOutputSize(node->abstract(), false));
+  if (IsPrimitiveCNode(node, prim::kPrimMatMul) || IsPrimitiveCNode(node, prim::kPrimBatchMatMul)) {
+    auto shape = GetInputShape(node, 1);
+    if (shape.size() < kDim2) {
+      return output_count;
+    }
+    auto transpose_a = GetCNodePrimitive(node)->GetAttr(ops::kTransposeA);
+    bool is_transpose_a = transpose_a != nullptr && transpose_a->isa<BoolImm>() && GetValue<bool>(transpose_a);
+    auto deep = is_transpose_a ? shape[shape.size() - kDim2] : shape.back();
+    return kFlopsPerMac * output_count * LongToDouble(std::max<int64_t>(deep, 1));
+  }
+  if (IsPrimitiveCNode(node, prim::kPrimConv2D)) {
+    // The weight is [out_channel, in_channel / group, kernel_h, kernel_w].
+    auto weight_shape = GetInputShape(node, kConvWeightIndex);
+    int64_t macs = 1;
+    for (size_t i = 1; i < weight_shape.size(); ++i) {
+      macs *= std::max<int64_t>(weight_shape[i], 1);
+    }
+    return kFlopsPerMac * output_count * LongToDouble(macs);
+  }
+  return output_count;
+}
+
+void AppendUnique(const std::vector<size_t> &from, std::vector<size_t> *to) {
+  for (auto index : from) {
+    if (std::find(to->begin(), to->end(), index) == to->end()) {
+      to->push_back(index);
+    }
+  }
+}
+
+class RecomputePlanner {
+ public:
+  RecomputePlanner(const FuncGraphManagerPtr &mng, const std::vector<CNodePtr> &origin_nodes_topological)
+      : mng_(mng) {
+    BuildNodes(origin_nodes_topological);
+  }
+  ~RecomputePlanner() = default;
+
+  RecomputePlan Plan(int64_t memory_budget);
+
+ private:
+  void BuildNodes(const std::vector<CNodePtr> &origin_nodes_topological);
+  // The nodes owning the tensors of the output of a node.
+  std::vector<size_t> Owners(size_t index) const {
+    return nodes_[index].is_alias ? nodes_[index].producers : std::vector<size_t>{index};
+  }
+  void InitHeldNodes();
+  // The activation memory saved by recomputing the node, minus its inputs that would be kept instead.
+  int64_t SavedBytes(size_t index) const;
+  double Score(size_t index) const;
+  void Push(size_t index);
+  void SetHeld(size_t index);
+  void SetRecomputedForBprop(size_t index);
+  void SetRecomputed(size_t index);
+
+  FuncGraphManagerPtr mng_;
+  std::vector<PlanNode> nodes_;
+  int64_t held_bytes_ = 0;
+  std::priority_queue<std::pair<double, size_t>> candidates_;
+};
+
+void RecomputePlanner::BuildNodes(const std::vector<CNodePtr> &origin_nodes_topological) {
+  mindspore::HashMap<AnfNodePtr, size_t> node_index;
+  // The forward nodes depending on the gradients run in the backward pass.
+  mindspore::HashSet<AnfNodePtr> grad_nodes;
+  for (const auto &node : origin_nodes_topological) {
+    MS_EXCEPTION_IF_NULL(node);
+    const auto &inputs = node->inputs();
+    bool is_bprop = IsBpropNode(node);
+    for (size_t i = 1; i < inputs.size() && !is_bprop; ++i) {
+      if (IsPrimitiveCNode(node, prim::kPrimDepend) && i == kDependAttachNodeIndex) {
+        continue;
+      }
+      is_bprop = IsBpropNode(inputs[i]) || grad_nodes.find(inputs[i]) != grad_nodes.end();
+    }
+    if (is_bprop) {
+      (void)grad_nodes.insert(node);
+      for (const auto &input : inputs) {
+        auto iter = node_index.find(input);
+        if (iter == node_index.end()) {
+          continue;
+        }
+        for (auto owner : Owners(iter->second)) {
+          nodes_[owner].used_by_bprop = true;
+        }
+      }
+      continue;
+    }
+    PlanNode plan_node;
+    plan_node.cnode = node;
+    plan_node.is_alias = IsAliasNode(node);
+    // Only the first input of Depend and TupleGetItem is forwarded.
+    size_t alias_end = IsPrimitiveCNode(node, prim::kPrimMakeTuple) ? inputs.size() : kRealInputIndexInDepend + 1;
+    for (size_t i = 1; i < inputs.size(); ++i) {
+      auto iter = node_index.find(inputs[i]);
+      if (iter == node_index.end() || (plan_node.is_alias && i >= alias_end)) {
+        continue;
+      }
+      AppendUnique(Owners(iter->second), &plan_node.producers);
+    }
+    if (!plan_node.is_alias) {
+      // A loaded parameter is not an activation.
+      plan_node.bytes = IsPrimitiveCNode(node, prim::kPrimLoad) ? 0 : GetOutputSize(node->abstract(), true);
+      plan_node.flops = EstimateFlops(node);
+      plan_node.recomputed = IsSetRecomputeCNodeAttr(node, true);
+      plan_node.can_recompute = !plan_node.recomputed && plan_node.bytes > 0 && CanRecompute(node);
+      for (auto producer : plan_node.producers) {
+        nodes_[producer].users.push_back(nodes_.size());
+      }
+    }
+    node_index[node] = nodes_.size();
+    nodes_.push_back(std::move(plan_node));
+  }
+}
+
+void RecomputePlanner::SetHeld(size_t index) {
+  auto &node = nodes_[index];
+  if (node.is_alias || node.recomputed || node.held || node.bytes == 0) {
+    return;
+  }
+  node.held = true;
+  held_bytes_ += node.bytes;
+  // The node becomes a candidate, and its users keep less memory alive when recomputed.
+  Push(index);
+  for (auto user : node.users) {
+    if (nodes_[user].held) {
+      Push(user);
+    }
+  }
+}
+
+void RecomputePlanner::SetRecomputedForBprop(size_t index) {
+  std::vector<size_t> to_visit{index};
+  while (!to_visit.empty()) {
+    auto current = to_visit.back();
+    to_visit.pop_back();
+    nodes_[current].recomputed_for_bprop = true;
+    for (auto producer : nodes_[current].producers) {
+      if (!nodes_[producer].recomputed) {
+        SetHeld(producer);
+      } else if (!nodes_[producer].recomputed_for_bprop) {
+        to_visit.push_back(producer);
+      }
+    }
+  }
+}
+
+void RecomputePlanner::InitHeldNodes() {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].used_by_bprop) {
+      SetHeld(i);
+    }
+  }
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].recomputed && nodes_[i].used_by_bprop) {
+      SetRecomputedForBprop(i);
+    }
+  }
+}
+
+int64_t RecomputePlanner::SavedBytes(size_t index) const {
+  const auto &node = nodes_[index];
+  int64_t saved_bytes = node.bytes;
+  for (auto producer : node.producers) {
+    const auto &producer_node = nodes_[producer];
+    if (!producer_node.recomputed && !producer_node.held) {
+      saved_bytes -= producer_node.bytes;
+    }
+  }
+  return saved_bytes;
+}
+
+double RecomputePlanner::Score(size_t index) const {
+  return LongToDouble(SavedBytes(index)) / std::max(nodes_[index].flops, 1.0);
+}
+
+void RecomputePlanner::Push(size_t index) {
+  if (nodes_[index].can_recompute && nodes_[index].held && SavedBytes(index) > 0) {
+    candidates_.emplace(Score(index), index);
+  }
+}
+
+void RecomputePlanner::SetRecomputed(size_t index) {
+  auto &node = nodes_[index];
+  node.recomputed = true;
+  node.held = false;
+  held_bytes_ -= node.bytes;
+  node.cnode->AddAttr(kAttrRecompute, MakeValue(true));
+  // Set attr for the tuple_getitem outputs as SetRecomputedAttr.
+  const auto &node_users = mng_->node_users();
+  auto output_set_iter = node_users.find(node.cnode);
+  if (output_set_iter != node_users.end()) {
+    for (const auto &node_index_set : output_set_iter->second) {
+      if (IsPrimitiveCNode(node_index_set.first, prim::kPrimTupleGetItem)) {
+        node_index_set.first->cast<CNodePtr>()->AddAttr(kAttrRecompute, MakeValue(true));
+      }
+    }
+  }
+  SetRecomputedForBprop(index);
+}
+
+RecomputePlan RecomputePlanner::Plan(int64_t memory_budget) {
+  RecomputePlan plan;
+  InitHeldNodes();
+  plan.activation_bytes = held_bytes_;
+  for (const auto &node : nodes_) {
+    plan.forward_flops += node.flops;
+  }
+  // Greedily recompute the node saving the most memory per FLOP. The scores change as the nodes are recomputed, the
+  // stale candidates are pushed again with their current score.
+  while (held_bytes_ > memory_budget && !candidates_.empty()) {
+    auto candidate = candidates_.top();
+    candidates_.pop();
+    auto index = candidate.second;
+    const auto &node = nodes_[index];
+    if (node.recomputed || !node.held || SavedBytes(index) <= 0) {
+      continue;
+    }
+    auto score = Score(index);
+    if (score < candidate.first) {
+      candidates_.emplace(score, index);
+      continue;
+    }
+    plan.extra_flops += node.flops;
+    ++plan.recomputed_node_count;
+    SetRecomputed(index);
+  }
+  plan.planned_activation_bytes = held_bytes_;
+  return plan;
+}
+}  // namespace
+
+RecomputePlan PlanRecomputedNodes(const FuncGraphPtr &graph, const std::vector<CNodePtr> &origin_nodes_topological,
+                                  int64_t memory_budget) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto mng = graph->manager();
+  MS_EXCEPTION_IF_NULL(mng);
+  RecomputePlanner planner(mng, origin_nodes_topological);
+  auto plan = planner.Plan(memory_budget);
+  double extra_flops_ratio = plan.forward_flops > 0 ? plan.extra_flops / plan.forward_flops : 0;
+  MS_LOG(INFO) << "Automatic recomputation of graph " << graph->ToString() << " with the memory budget "
+               << memory_budget << " bytes: recompute " << plan.recomputed_node_count
+               << " forward nodes, the predicted activation memory is " << plan.planned_activation_bytes
+               << " bytes instead of " << plan.activation_bytes << " bytes, saving "
+               << (plan.activation_bytes - plan.planned_activation_bytes) << " bytes for " << plan.extra_flops
+               << " extra FLOPs (" << (extra_flops_ratio * 100) << "% of the forward pass).";
+  if (plan.planned_activation_bytes > memory_budget) {
+    MS_LOG(WARNING) << "The predicted activation memory " << plan.planned_activation_bytes
+                    << " bytes of graph " << graph->ToString() << " exceeds the recompute memory budget "
+                    << memory_budget << " bytes even if all the recomputable forward nodes are recomputed.";
+  }
+  return plan;
+}
+}  // namespace opt
+}  // namespace mindspore
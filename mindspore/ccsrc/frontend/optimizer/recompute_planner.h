@@ -0,0 +1,44 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_RECOMPUTE_PLANNER_H_
+#define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_RECOMPUTE_PLANNER_H_
+
+#include <vector>
+#include "ir/anf.h"
+#include "ir/func_graph.h"
+
+namespace mindspore {
+namespace opt {
+// The prediction of the automatic recomputation, the sizes are in bytes.
+struct RecomputePlan {
+  // The forward activations kept for the backward pass, before and after the planned recomputation.
+  int64_t activation_bytes = 0;
+  int64_t planned_activation_bytes = 0;
+  double forward_flops = 0;
+  // The FLOPs of the forward nodes set to be recomputed by the planner.
+  double extra_flops = 0;
+  size_t recomputed_node_count = 0;
+};
+
+// Set the 'recompute' cnode attr of the forward nodes whose recomputation saves the most activation memory per
+// recomputed FLOP, until the forward activations used by the backward pass fit in memory_budget bytes. The nodes set
+// by the user are kept, the duplication itself is left to InsertRecomputedNodes.
+RecomputePlan PlanRecomputedNodes(const FuncGraphPtr &graph, const std::vector<CNodePtr> &origin_nodes_topological,
+                                  int64_t memory_budget);
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_RECOMPUTE_PLANNER_H_
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket_planner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// The relative difference of the times which are taken as equal, then the plan with fewer buckets is chosen.
+constexpr double kTimeTolerance = 1e-9;
+
+bool IsEarlier(double time, double other) {
+  if (std::isinf(other)) {
+    return time < other;
+  }
+  return time < other - kTimeTolerance * std::max(std::abs(time), std::abs(other));
+}
+
+BucketPlan MakePlan(std::vector<size_t> segment_index, double comm_end_time, double compute_end_time) {
+  BucketPlan plan;
+  plan.segment_index = std::move(segment_index);
+  plan.comm_end_time = comm_end_time;
+  plan.exposed_comm_time = std::max(0.0, comm_end_time - compute_end_time);
+  return plan;
+}
+}  // namespace
+
+BucketPlan AllReduceBucketPlanner::Plan(const std::vector<GradientTiming> &gradients, double compute_end_time) const {
+  size_t gradient_num = gradients.size();
+  if (gradient_num == 0) {
+    return MakePlan({}, 0, compute_end_time);
+  }
+  // finish[i] is the earliest time when the first i gradients are reduced, and prev[i] is the first gradient of the
+  // last bucket of them. The later buckets only depend on that time, so the earliest one of each prefix is optimal.
+  std::vector<double> finish(gradient_num + 1, std::numeric_limits<double>::infinity());
+  std::vector<size_t> bucket_num(gradient_num + 1, 0);
+  std::vector<size_t> prev(gradient_num + 1, 0);
+  finish[0] = 0;
+  for (size_t end = 1; end <= gradient_num; ++end) {
+    size_t bucket_size = 0;
+    double bucket_ready_time = 0;
+    for (size_t begin = end; begin > 0; --begin) {
+      const auto &gradient = gradients[begin - 1];
+      bucket_size += gradient.size;
+      bucket_ready_time = std::max(bucket_ready_time, gradient.ready_time);
+      double time = std::max(finish[begin - 1], bucket_ready_time) + link_.Time(bucket_size);
+      bool fewer_buckets = !IsEarlier(finish[end], time) && bucket_num[begin - 1] + 1 < bucket_num[end];
+      if (IsEarlier(time, finish[end]) || fewer_buckets) {
+        finish[end] = time;
+        bucket_num[end] = bucket_num[begin - 1] + 1;
+        prev[end] = begin - 1;
+      }
+    }
+  }
+  std::vector<size_t> segment_index;
+  for (size_t end = gradient_num; end > 0; end = prev[end]) {
+    segment_index.push_back(end - 1);
+  }
+  std::reverse(segment_index.begin(), segment_index.end());
+  return MakePlan(std::move(segment_index), finish[gradient_num], compute_end_time);
+}
+
+BucketPlan AllReduceBucketPlanner::Evaluate(const std::vector<GradientTiming> &gradients,
+                                            const std::vector<size_t> &segment_index, double compute_end_time) const {
+  if (gradients.empty()) {
+    return MakePlan({}, 0, compute_end_time);
+  }
+  if (segment_index.empty() || segment_index.back() != gradients.size() - 1) {
+    MS_LOG(EXCEPTION) << "The last segment index should be " << (gradients.size() - 1) << ", but got "
+                      << (segment_index.empty() ? std::string("nothing") : std::to_string(segment_index.back()));
+  }
+  double comm_end_time = 0;
+  size_t begin = 0;
+  for (auto end : segment_index) {
+    if (end < begin) {
+      MS_LOG(EXCEPTION) << "The segment index " << end << " is not greater than the last one " << begin - 1;
+    }
+    size_t bucket_size = 0;
+    double bucket_ready_time = 0;
+    for (size_t i = begin; i <= end; ++i) {
+      bucket_size += gradients[i].size;
+      bucket_ready_time = std::max(bucket_ready_time, gradients[i].ready_time);
+    }
+    comm_end_time = std::max(comm_end_time, bucket_ready_time) + link_.Time(bucket_size);
+    begin = end + 1;
+  }
+  return MakePlan(segment_index, comm_end_time, compute_end_time);
+}
+
+}  // namespace parallel
+}  // namespace mindspore
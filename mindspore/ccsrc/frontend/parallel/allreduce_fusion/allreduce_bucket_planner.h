@@ -0,0 +1,73 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_PLANNER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_PLANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+// The value of costmodel_allreduce_fusion_algorithm which plans the AllReduce buckets in the backend.
+constexpr int64_t ALLREDUCE_FUSION_ALGORITHM_BUCKET_PLANNER = 3;
+
+// The sizes are in bytes. The times are in any unit, which must be the same for the gradients and the link.
+struct GradientTiming {
+  size_t size{0};
+  // The time when the gradient is computed, from the beginning of the step.
+  double ready_time{0};
+};
+
+// An AllReduce of n bytes takes latency + n / bandwidth.
+struct AllReduceLinkModel {
+  double latency{0};
+  double bandwidth{1};
+
+  double Time(size_t size) const { return latency + static_cast<double>(size) / bandwidth; }
+};
+
+struct BucketPlan {
+  // The index of the last gradient of each bucket, the same as the segment index of the AllReduce fusion pass.
+  std::vector<size_t> segment_index;
+  // The time when the last AllReduce is done.
+  double comm_end_time{0};
+  // The time of the AllReduces after the end of the computation, which is not overlapped.
+  double exposed_comm_time{0};
+};
+
+// Choose the boundaries of the buckets of the gradients, which are reduced in their order one bucket after another
+// on a single link. A bucket starts when all its gradients are ready and the previous bucket is done, so small
+// buckets overlap the computation better while large ones pay the latency less often. The buckets which finish the
+// last AllReduce the earliest are found by dynamic programming on the prefixes of the gradients.
+class AllReduceBucketPlanner {
+ public:
+  explicit AllReduceBucketPlanner(const AllReduceLinkModel &link) : link_(link) {}
+  ~AllReduceBucketPlanner() = default;
+
+  BucketPlan Plan(const std::vector<GradientTiming> &gradients, double compute_end_time) const;
+  // Simulate the given buckets.
+  BucketPlan Evaluate(const std::vector<GradientTiming> &gradients, const std::vector<size_t> &segment_index,
+                      double compute_end_time) const;
+
+ private:
+  AllReduceLinkModel link_;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_PLANNER_H_
@@ -22,6 +22,7 @@
 #include <utility>
 #include "frontend/parallel/auto_parallel/costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "frontend/parallel/auto_parallel/redistribution_cost_cache.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
 #include "frontend/parallel/ops_info/reshape_info.h"
 
@@ -62,32 +63,36 @@ Status Edge::InitEdgeCost() {
       }
     }
   } else {
-    for (auto &target_output : pre_op_output_) {
+    auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
+    auto type = prev_op_->outputs_type()[prev_op_output_index_];
+    // The redistribution costs of the strategy pairs are independent, they are calculated in parallel.
+    std::vector<CostPtr> costs(pre_op_output_.size() * next_op_input_.size());
+    RunSearchTasks(costs.size(), [this, &costs, type_length, &type](size_t index) {
+      const auto &target_output = pre_op_output_[index / next_op_input_.size()];
+      const auto &target_input = next_op_input_[index % next_op_input_.size()];
       auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
-      auto target_output_str = target_output.first;
-      auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
-      auto type = prev_op_->outputs_type()[prev_op_output_index_];
-      for (auto &target_input : next_op_input_) {
-        auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
-        auto target_input_str = target_input.first;
-        CostPtr cost;
-        if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
-          MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
-        }
-        MS_EXCEPTION_IF_NULL(cost);
-        MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
-                      << ", communication_cost: " << cost->communication_cost_
-                      << ", communication_without_parameter_: " << cost->communication_without_parameter_
-                      << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
-        // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
-        cost->communication_forward_ = cost->communication_redis_forward_;
-        CostPtrKey ck = {target_output_str, target_input_str};
-        CostPtrList cl;
-        cl.push_back(cost);
-        (void)cost_map_.emplace(std::make_pair(ck, cl));
-        has_available_cost = true;
+      auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
+      CostPtr cost;
+      if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
+        MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
       }
+      MS_EXCEPTION_IF_NULL(cost);
+      MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
+                    << ", communication_cost: " << cost->communication_cost_
+                    << ", communication_without_parameter_: " << cost->communication_without_parameter_
+                    << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
+      // refine communication cost calculation for practice
+      RefineForPracticalCost(cost, true);
+      cost->communication_forward_ = cost->communication_redis_forward_;
+      costs[index] = cost;
+    });
+    for (size_t index = 0; index < costs.size(); ++index) {
+      CostPtrKey ck = {pre_op_output_[index / next_op_input_.size()].first,
+                       next_op_input_[index % next_op_input_.size()].first};
+      CostPtrList cl;
+      cl.push_back(costs[index]);
+      (void)cost_map_.emplace(std::make_pair(ck, cl));
+      has_available_cost = true;
     }
   }
   if (!has_available_cost) {
@@ -117,22 +122,34 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   MS_EXCEPTION_IF_NULL(prev_op_);
   MS_EXCEPTION_IF_NULL(cost);
   RankList dev_list = prev_op_->stage_device_list();
-  TensorRedistribution tensor_redistribution(false);
-
-  // Init TensorRedistribution
-  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
-
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
+  auto &cost_cache = RedistributionCostCache::GetInstance();
+  auto cache_key = cost_cache.Key(prev_op_output_layout, next_op_input_layout, dev_list.size());
+  RedistributionCost redis_cost;
+  if (!cost_cache.Find(cache_key, &redis_cost)) {
+    // The operators are not constructed, so no group is created on the threads of the search.
+    TensorRedistribution tensor_redistribution(false);
+
+    // Init TensorRedistribution
+    if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
+      MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
+    }
 
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
-  double computation_cost = tensor_redistribution.computation_cost();
-  double mem_cost = tensor_redistribution.memory_cost();
+    if (tensor_redistribution.ComputeCost() == FAILED) {
+      MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+    }
+    redis_cost.comm_cost = tensor_redistribution.comm_cost();
+    redis_cost.forward_comm_cost = tensor_redistribution.forward_comm_cost();
+    redis_cost.backward_comm_cost = tensor_redistribution.backward_comm_cost();
+    redis_cost.computation_cost = tensor_redistribution.computation_cost();
+    redis_cost.memory_cost = tensor_redistribution.memory_cost();
+    cost_cache.Insert(cache_key, redis_cost);
+  }
+
+  double comm_cost = redis_cost.comm_cost;
+  double forward_comm_cost = redis_cost.forward_comm_cost;
+  double backward_comm_cost = redis_cost.backward_comm_cost;
+  double computation_cost = redis_cost.computation_cost;
+  double mem_cost = redis_cost.memory_cost;
   const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
 
   // Now AllGather, ReduceScatter, AlltoAll don't support bool type
@@ -205,25 +222,36 @@ CostPtrList Edge::CreateEdgeEliminationCostList(const StrategyPtr &output_st_ptr
   return result;
 }
 
-void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
+void Edge::SetCostMapByStrategyPairs(
+  const std::function<CostPtrList(const StrategyPtr &, const StrategyPtr &)> &create_cost_list) {
+  // The strategy pairs are independent, their cost lists are created in parallel and then put into cost_map_ in the
+  // original order.
+  std::vector<CostPtrList> clists(pre_op_output_.size() * next_op_input_.size());
+  RunSearchTasks(clists.size(), [this, &clists, &create_cost_list](size_t index) {
+    const auto &output_st_ptr = pre_op_output_[index / next_op_input_.size()].first;
+    const auto &input_st_ptr = next_op_input_[index % next_op_input_.size()].first;
+    clists[index] = create_cost_list(output_st_ptr, input_st_ptr);
+  });
   bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-      CostPtrList clist = CreateEdgeEliminationCostList(output_st_ptr, edges, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
+  for (size_t index = 0; index < clists.size(); ++index) {
+    CostPtrKey key = {pre_op_output_[index / next_op_input_.size()].first,
+                      next_op_input_[index % next_op_input_.size()].first};
+    if ((!valid) && (!clists[index].empty())) {
+      valid = true;
     }
+    cost_map_[key] = std::move(clists[index]);
   }
   if (!valid) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
   }
 }
 
+void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
+  SetCostMapByStrategyPairs([this, &edges](const StrategyPtr &output_st_ptr, const StrategyPtr &input_st_ptr) {
+    return CreateEdgeEliminationCostList(output_st_ptr, edges, input_st_ptr);
+  });
+}
+
 void Edge::CreateOpEliminationSubCostList(StrategyPtr op_strategy, const CostPtrList &left_cost_list,
                                           const CostPtrList &middle_cost_list, const CostPtrList &right_cost_list,
                                           CostPtrList *ret_cost_list) {
@@ -278,23 +306,9 @@ CostPtrList Edge::CreateOpEliminationCostList(const EdgePtr &e1, const StrategyP
 }
 
 void Edge::OpEliminationSetNewCost(const EdgePtr &e1, const OperatorInfoPtr &op, const EdgePtr &e2) {
-  bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-
-      CostPtrList clist = CreateOpEliminationCostList(e1, output_st_ptr, op, e2, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
-    }
-  }
-  if (!valid) {
-    MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
-  }
+  SetCostMapByStrategyPairs([this, &e1, &op, &e2](const StrategyPtr &output_st_ptr, const StrategyPtr &input_st_ptr) {
+    return CreateOpEliminationCostList(e1, output_st_ptr, op, e2, input_st_ptr);
+  });
 }
 
 Status Edge::CalculateMemoryCost() {
@@ -17,6 +17,7 @@
 #ifndef PARALLEL_AUTO_PARALLEL_EDGE_COSTMODEL_H_
 #define PARALLEL_AUTO_PARALLEL_EDGE_COSTMODEL_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -154,6 +155,11 @@ class Edge {
   bool CheckStrategyCostPossibility() const;
 
  private:
+  // Sets cost_map_ to the cost list 'create_cost_list' creates for every pair of the strategies of prev_op_ and
+  // next_op_.
+  void SetCostMapByStrategyPairs(
+    const std::function<CostPtrList(const StrategyPtr &, const StrategyPtr &)> &create_cost_list);
+
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
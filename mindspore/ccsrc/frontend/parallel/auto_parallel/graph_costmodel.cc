@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <numeric>
 #include <string>
@@ -22,14 +23,90 @@
 #include <queue>
 
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "frontend/parallel/group_manager.h"
 #include "frontend/parallel/ops_info/reshape_info.h"
 #include "frontend/parallel/step_auto_parallel.h"
+#include "common/thread_pool.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace parallel {
 CostGraphPtr entire_costgraph = nullptr;
 size_t TOTAL_OPS = 0;
 
+namespace {
+// The tasks are split into several chunks per thread, so that the threads finishing early take over the remaining ones.
+constexpr size_t kSearchChunksPerThread = 4;
+// Set in the threads running the search tasks, the tasks they run do not start parallel tasks again.
+thread_local bool in_search_task = false;
+}  // namespace
+
+void RunSearchTasks(size_t task_num, const std::function<void(size_t)> &task) {
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  auto thread_num = LongToSize(CostModelContext::GetInstance()->dp_algo_search_threads());
+  if (thread_num == 0 || thread_num > thread_pool.GetSyncRunThreadNum()) {
+    thread_num = thread_pool.GetSyncRunThreadNum();
+  }
+  if (thread_num <= 1 || task_num <= 1 || in_search_task) {
+    for (size_t i = 0; i < task_num; ++i) {
+      task(i);
+    }
+    return;
+  }
+  // The pool runs each of its tasks on a thread of its own, so only 'thread_num' pool tasks are started, and they take
+  // the chunks in turn.
+  thread_num = std::min(task_num, thread_num);
+  auto chunk_num = std::min(task_num, thread_num * kSearchChunksPerThread);
+  auto chunk_size = (task_num + chunk_num - 1) / chunk_num;
+  std::atomic<size_t> next_begin{0};
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < thread_num; ++i) {
+    tasks.emplace_back([&task, &next_begin, task_num, chunk_size]() {
+      ForbidGroupCreation forbid_group_creation;
+      in_search_task = true;
+      try {
+        for (size_t begin = next_begin.fetch_add(chunk_size); begin < task_num;
+             begin = next_begin.fetch_add(chunk_size)) {
+          auto end = std::min(begin + chunk_size, task_num);
+          for (size_t index = begin; index < end; ++index) {
+            task(index);
+          }
+        }
+      } catch (...) {
+        in_search_task = false;
+        throw;
+      }
+      in_search_task = false;
+      return common::SUCCESS;
+    });
+  }
+  (void)thread_pool.SyncRun(tasks);
+  MsException::Instance().CheckException();
+}
+
+bool CostGraph::ResetStrategyCostLists(
+  const OperatorInfoPtr &op,
+  const std::function<CostPtrList(const std::shared_ptr<StrategyWithCost> &)> &create_cost_list) {
+  MS_EXCEPTION_IF_NULL(op);
+  auto stra_costs = op->GetStrategyCost();
+  // A cost list is only replaced after all the new ones are created, as the creation reads the old one.
+  std::vector<CostPtrList> new_clists(stra_costs.size());
+  RunSearchTasks(stra_costs.size(), [&stra_costs, &new_clists, &create_cost_list](size_t index) {
+    MS_EXCEPTION_IF_NULL(stra_costs[index]);
+    new_clists[index] = create_cost_list(stra_costs[index]);
+    Simplify(&new_clists[index]);
+  });
+  bool valid = false;
+  for (size_t index = 0; index < stra_costs.size(); ++index) {
+    if ((!valid) && (!new_clists[index].empty())) {
+      valid = true;
+    }
+    // Set the new costlist w.r.t the strategy
+    stra_costs[index]->cost_list = std::move(new_clists[index]);
+  }
+  return valid;
+}
+
 void CostGraph::Init() {
   inputs_tensor_name_list_.clear();
   tuple_getitem_list_.clear();
@@ -1217,12 +1294,9 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
   MS_EXCEPTION_IF_NULL(target_op);
   MS_EXCEPTION_IF_NULL(edge_ptr);
   MS_LOG(INFO) << "Now merging " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
-    MS_EXCEPTION_IF_NULL(tar_stra_cost);
+  auto create_tar_clist = [this, &op, &edge_ptr](const std::shared_ptr<StrategyWithCost> &tar_stra_cost) {
     auto tar_stra = tar_stra_cost->strategy_ptr;
-    auto tar_clist_origin = tar_stra_cost->cost_list;
+    const auto &tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
     for (auto &op_stra_cost : op->GetStrategyCost()) {
@@ -1233,13 +1307,9 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
 
       CreateMergeEliminationSubCostList(op_stra, op_clist, edge_clist, tar_stra, tar_clist_origin, &tar_clist_new);
     }
-    Simplify(&tar_clist_new);
-    // Set the new costlist w.r.t the strategy
-    tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
+    return tar_clist_new;
+  };
+  bool valid = ResetStrategyCostLists(target_op, create_tar_clist);
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Merging " << op->name() << " into " << target_op->name() << " failed.";
@@ -1298,12 +1368,9 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
   auto target_op = op->GetAlivePrevEdges()[0]->prev_operator();
   auto edge_ptr = op->GetAlivePrevEdges()[0];
   MS_LOG(INFO) << "Now contracting " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
-    MS_EXCEPTION_IF_NULL(tar_stra_cost);
+  auto create_tar_clist = [this, &op, &edge_ptr](const std::shared_ptr<StrategyWithCost> &tar_stra_cost) {
     auto tar_stra = tar_stra_cost->strategy_ptr;
-    auto tar_clist_origin = tar_stra_cost->cost_list;
+    const auto &tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
     for (auto &op_stra_cost : op->GetStrategyCost()) {
@@ -1314,13 +1381,9 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
 
       CreateContractEliminationSubCostList(op_stra, op_clist, edge_clist, tar_stra, tar_clist_origin, &tar_clist_new);
     }
-    Simplify(&tar_clist_new);
-    // Set the new costlist w.r.t the strategy
-    tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
+    return tar_clist_new;
+  };
+  bool valid = ResetStrategyCostLists(target_op, create_tar_clist);
   if (!valid) {
     MS_LOG(EXCEPTION) << "Contracting " << op->name() << " into " << target_op->name() << " failed.";
   }
@@ -1419,12 +1482,10 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
     left_edge = right_edge;
     right_edge = tmp;
   }
-  bool valid = false;
-
-  for (auto &left_node_stra_cost : left_node->GetStrategyCost()) {
-    MS_EXCEPTION_IF_NULL(left_node_stra_cost);
+  auto create_left_node_clist = [this, &elimi_op, &left_edge, &right_edge,
+                                 &right_node](const std::shared_ptr<StrategyWithCost> &left_node_stra_cost) {
     auto left_node_stra = left_node_stra_cost->strategy_ptr;
-    auto left_node_clist_origin = left_node_stra_cost->cost_list;
+    const auto &left_node_clist_origin = left_node_stra_cost->cost_list;
     CostPtrList left_node_clist_new;
 
     for (auto &elimi_op_stra_cost : elimi_op->GetStrategyCost()) {
@@ -1444,13 +1505,9 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
                                           &left_node_clist_new);
       }
     }
-    Simplify(&left_node_clist_new);
-    // Set the new costlist w.r.t the strategy
-    left_node_stra_cost->cost_list = left_node_clist_new;
-    if ((!valid) && (!left_node_clist_new.empty())) {
-      valid = true;
-    }
-  }
+    return left_node_clist_new;
+  };
+  bool valid = ResetStrategyCostLists(left_node, create_left_node_clist);
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Eliminating triangle: " << elimi_op->name()
@@ -1581,14 +1638,13 @@ std::vector<std::shared_ptr<Edge>> CostGraph::EliminationStar(const OperatorInfo
   MS_EXCEPTION_IF_NULL(succ_edges[0]);
   auto first_succ_node = succ_edges[0]->next_operator();
   auto first_succ_edge = succ_edges[0];
-  bool valid = false;
 
   // 'merged_op' is merged into first_node
   MS_EXCEPTION_IF_NULL(first_succ_node);
-  for (auto &first_succ_node_stra_cost : first_succ_node->GetStrategyCost()) {
-    MS_EXCEPTION_IF_NULL(first_succ_node_stra_cost);
+  auto create_first_succ_node_clist = [this, &merged_op, &first_succ_edge, &succ_edges](
+                                        const std::shared_ptr<StrategyWithCost> &first_succ_node_stra_cost) {
     auto first_succ_node_stra = first_succ_node_stra_cost->strategy_ptr;
-    auto first_succ_node_clist = first_succ_node_stra_cost->cost_list;
+    const auto &first_succ_node_clist = first_succ_node_stra_cost->cost_list;
     CostPtrList first_succ_node_clist_new;
 
     for (auto &merged_op_stra_cost : merged_op->GetStrategyCost()) {
@@ -1600,13 +1656,9 @@ std::vector<std::shared_ptr<Edge>> CostGraph::EliminationStar(const OperatorInfo
       CreateStarEliminationCostList(succ_edges, first_succ_node_stra, first_succ_node_clist, first_succ_edge_clist,
                                     merged_op_stra, merged_op_clist, &first_succ_node_clist_new);
     }
-    Simplify(&first_succ_node_clist_new);
-    // Set the new costlist w.r.t the strategy
-    first_succ_node_stra_cost->cost_list = first_succ_node_clist_new;
-    if ((!valid) && (!first_succ_node_clist_new.empty())) {
-      valid = true;
-    }
-  }
+    return first_succ_node_clist_new;
+  };
+  bool valid = ResetStrategyCostLists(first_succ_node, create_first_succ_node_clist);
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Eliminating star centered at: " << merged_op->name()
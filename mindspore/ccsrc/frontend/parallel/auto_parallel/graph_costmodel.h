@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_GRAPH_COSTMODEL_H_
 #define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_GRAPH_COSTMODEL_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -35,6 +36,11 @@ using CostGraphPtr = std::shared_ptr<CostGraph>;
 extern CostGraphPtr entire_costgraph;
 extern size_t TOTAL_OPS;
 
+// Runs task(0), ..., task(task_num - 1) on the common thread pool, using at most 'dp_algo_search_threads' threads.
+// The tasks must not depend on each other and must not create communication groups, see ForbidGroupCreation. An
+// exception thrown by a task is rethrown after all the tasks finish.
+void RunSearchTasks(size_t task_num, const std::function<void(size_t)> &task);
+
 class CostGraph {
   // 'CostGraph' consists of Operators and edges between them. An edge is created between two Operators if they have
   // output-input dependency relationship.
@@ -199,6 +205,11 @@ class CostGraph {
   const std::map<std::string, std::string> get_tuple_getitem_list() const { return tuple_getitem_list_; }
 
  private:
+  // Replaces the cost list of each strategy of 'op' by the one 'create_cost_list' creates for it, the strategies are
+  // handled in parallel. Returns whether any of the new cost lists is not empty.
+  bool ResetStrategyCostLists(
+    const OperatorInfoPtr &op,
+    const std::function<CostPtrList(const std::shared_ptr<StrategyWithCost> &)> &create_cost_list);
   void TopologyOrder(std::vector<OperatorInfoPtr> *);
   void DFSForTopoOrder(const OperatorInfoPtr &, std::map<OperatorInfoPtr, bool> *, std::vector<OperatorInfoPtr> *);
   Status DetermineCriticalOps(const std::vector<OperatorInfoPtr> &);
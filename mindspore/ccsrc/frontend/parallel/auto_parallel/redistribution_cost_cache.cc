@@ -0,0 +1,165 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/auto_parallel/redistribution_cost_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unistd.h>
+#include "debug/common.h"
+#include "frontend/parallel/context.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// The first line of the cache file; bump it when the key or the cost computation changes.
+constexpr char kCostCacheHeader[] = "# redistribution cost cache v2";
+constexpr char kCostCacheSeparator = '\t';
+}  // namespace
+
+RedistributionCostCache &RedistributionCostCache::GetInstance() {
+  static RedistributionCostCache instance;
+  return instance;
+}
+
+std::string RedistributionCostCache::Key(const TensorLayout &from, const TensorLayout &to, size_t dev_num) const {
+  std::string key = from.ToString() + " -> " + to.ToString() + " | " + std::to_string(dev_num) + " | " +
+                    std::to_string(ParallelContext::GetInstance()->enable_all2all()) + " | " +
+                    std::to_string(CostModelContext::GetInstance()->dp_algo_redistribution_search());
+  // The layouts are printed on several lines, a key is one line of the cache file.
+  std::replace(key.begin(), key.end(), '\n', ';');
+  std::replace(key.begin(), key.end(), kCostCacheSeparator, ' ');
+  return key;
+}
+
+bool RedistributionCostCache::Find(const std::string &key, RedistributionCost *cost) {
+  MS_EXCEPTION_IF_NULL(cost);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = costs_.find(key);
+  if (iter == costs_.end()) {
+    ++miss_count_;
+    return false;
+  }
+  ++hit_count_;
+  *cost = iter->second;
+  return true;
+}
+
+void RedistributionCostCache::Insert(const std::string &key, const RedistributionCost &cost) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  (void)costs_.emplace(key, cost);
+}
+
+Status RedistributionCostCache::Load(const std::string &path) {
+  // Held across the whole load, so two threads loading the same file read it once and loaded_path_ is never torn.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path == loaded_path_) {
+    // The costs loaded before are still in the cache.
+    return SUCCESS;
+  }
+  loaded_path_ = path;
+  std::ifstream fin(path);
+  if (!fin) {
+    MS_LOG(INFO) << "The redistribution cost cache: " << path << " does not exist, starting with an empty cache.";
+    return SUCCESS;
+  }
+  std::string line;
+  if (!std::getline(fin, line) || line != kCostCacheHeader) {
+    MS_LOG(WARNING) << "The redistribution cost cache: " << path << " is written by another version, ignore it.";
+    return FAILED;
+  }
+  size_t loaded = 0;
+  while (std::getline(fin, line)) {
+    auto pos = line.rfind(kCostCacheSeparator);
+    if (pos == std::string::npos) {
+      MS_LOG(WARNING) << "The redistribution cost cache: " << path << " is broken at entry " << loaded
+                      << ", ignore the rest of it.";
+      return FAILED;
+    }
+    std::istringstream values(line.substr(pos + 1));
+    RedistributionCost cost;
+    if (!(values >> cost.comm_cost >> cost.forward_comm_cost >> cost.backward_comm_cost >> cost.computation_cost >>
+          cost.memory_cost)) {
+      MS_LOG(WARNING) << "The redistribution cost cache: " << path << " is broken at entry " << loaded
+                      << ", ignore the rest of it.";
+      return FAILED;
+    }
+    (void)costs_.emplace(line.substr(0, pos), cost);
+    ++loaded;
+  }
+  MS_LOG(INFO) << "Loaded " << loaded << " redistribution costs from: " << path << ".";
+  return SUCCESS;
+}
+
+Status RedistributionCostCache::Save(const std::string &path) {
+  auto realpath = Common::CreatePrefixPath(path);
+  if (!realpath.has_value()) {
+    MS_LOG(WARNING) << "Get real path failed, path=" << path;
+    return FAILED;
+  }
+  // Write to a temporary file and rename it, so that a concurrent compilation never reads a partial cache.
+  auto tmp_path = realpath.value() + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream fout(tmp_path, std::ios::out | std::ios::trunc);
+    if (!fout) {
+      MS_LOG(WARNING) << "Open the redistribution cost cache: " << tmp_path << " failed.";
+      return FAILED;
+    }
+    fout.precision(std::numeric_limits<double>::max_digits10);
+    fout << kCostCacheHeader << '\n';
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &item : costs_) {
+      const auto &cost = item.second;
+      fout << item.first << kCostCacheSeparator << cost.comm_cost << ' ' << cost.forward_comm_cost << ' '
+           << cost.backward_comm_cost << ' ' << cost.computation_cost << ' ' << cost.memory_cost << '\n';
+    }
+    if (!fout) {
+      MS_LOG(WARNING) << "Write the redistribution cost cache: " << tmp_path << " failed.";
+      (void)std::remove(tmp_path.c_str());
+      return FAILED;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), realpath.value().c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename the redistribution cost cache: " << tmp_path << " to " << realpath.value() << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Saved " << size() << " redistribution costs to: " << realpath.value() << ".";
+  return SUCCESS;
+}
+
+void RedistributionCostCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  costs_.clear();
+  loaded_path_.clear();
+}
+
+size_t RedistributionCostCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return costs_.size();
+}
+
+void RedistributionCostCache::ResetCount() {
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+}  // namespace parallel
+}  // namespace mindspore
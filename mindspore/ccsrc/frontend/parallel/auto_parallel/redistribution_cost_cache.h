@@ -0,0 +1,71 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_REDISTRIBUTION_COST_CACHE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_REDISTRIBUTION_COST_CACHE_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "frontend/parallel/status.h"
+#include "frontend/parallel/tensor_layout/tensor_layout.h"
+
+namespace mindspore {
+namespace parallel {
+// The costs of a tensor redistribution as computed by TensorRedistribution::ComputeCost, before they are scaled by
+// the type length of the tensor.
+struct RedistributionCost {
+  double comm_cost = 0.0;
+  double forward_comm_cost = 0.0;
+  double backward_comm_cost = 0.0;
+  double computation_cost = 0.0;
+  double memory_cost = 0.0;
+};
+
+// Memo of the redistribution costs of the edges in the cost graph. The costs only depend on the two layouts, the
+// number of devices of the stage, whether AllToAll is enabled and whether the redistribution is searched, so they are
+// shared by all the edges of a graph and by all the graphs compiled in the process. Loading and saving the memo extends the reuse across processes. It is
+// accessed concurrently by the threads initializing the edge costs.
+class RedistributionCostCache {
+ public:
+  static RedistributionCostCache &GetInstance();
+  std::string Key(const TensorLayout &from, const TensorLayout &to, size_t dev_num) const;
+  bool Find(const std::string &key, RedistributionCost *cost);
+  void Insert(const std::string &key, const RedistributionCost &cost);
+  // A missing file is an empty cache, a file written by another version is ignored. Loading the same file again does
+  // nothing.
+  Status Load(const std::string &path);
+  Status Save(const std::string &path);
+  void Clear();
+  size_t size();
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+  void ResetCount();
+
+ private:
+  RedistributionCostCache() = default;
+  ~RedistributionCostCache() = default;
+  std::mutex mutex_;
+  std::unordered_map<std::string, RedistributionCost> costs_;
+  // The file loaded last, which is not loaded again.
+  std::string loaded_path_;
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_REDISTRIBUTION_COST_CACHE_H_
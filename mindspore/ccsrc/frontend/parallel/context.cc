@@ -33,6 +33,8 @@ std::vector<std::string> PARALLEL_MODE_LIST = {STAND_ALONE, DATA_PARALLEL, HYBRI
                                                AUTO_PARALLEL};
 std::vector<std::string> STRATEGY_SEARCH_MODE_LIST = {DYNAMIC_PROGRAMMING, RECURSIVE_PROGRAMMING, SHARDING_PROPAGATION};
 
+std::vector<std::string> PIPELINE_MICRO_BATCH_ORDER_LIST = {DEPTH_FIRST, BREADTH_FIRST};
+
 std::vector<std::string> COMMUNI_PARALLEL_MODE_LIST = {ALL_GROUP_PARALLEL, SAME_SERVER_GROUP_PARALLEL,
                                                        NO_GROUP_PARALLEL};
 
@@ -68,6 +70,8 @@ void ParallelContext::Reset() {
   all_reduce_fusion_split_sizes_.clear();
   strategy_search_mode_ = DYNAMIC_PROGRAMMING;
   pipeline_stage_split_num_ = 1;
+  pipeline_interleave_num_ = 1;
+  pipeline_micro_batch_order_ = DEPTH_FIRST;
   grad_accumulation_step_ = 1;
   communi_parallel_mode_ = ALL_GROUP_PARALLEL;
   optimizer_weight_shard_size_ = -1;
@@ -105,6 +109,21 @@ void ParallelContext::set_loss_repeated_mean(bool loss_repeated_mean) { loss_rep
 
 void ParallelContext::set_pipeline_stage_split_num(const int64_t stage_num) { pipeline_stage_split_num_ = stage_num; }
 
+void ParallelContext::set_pipeline_interleave_num(const int64_t interleave_num) {
+  pipeline_interleave_num_ = interleave_num;
+}
+
+bool ParallelContext::set_pipeline_micro_batch_order(const std::string &micro_batch_order) {
+  auto iter = std::find(PIPELINE_MICRO_BATCH_ORDER_LIST.begin(), PIPELINE_MICRO_BATCH_ORDER_LIST.end(),
+                        micro_batch_order);
+  if (iter == PIPELINE_MICRO_BATCH_ORDER_LIST.end()) {
+    MS_LOG(INFO) << "Invalid pipeline micro batch order: " << micro_batch_order;
+    return false;
+  }
+  pipeline_micro_batch_order_ = micro_batch_order;
+  return true;
+}
+
 bool ParallelContext::set_parallel_mode(const std::string &parallel_mode) {
   auto iter = std::find(PARALLEL_MODE_LIST.begin(), PARALLEL_MODE_LIST.end(), parallel_mode);
   if (iter == PARALLEL_MODE_LIST.end()) {
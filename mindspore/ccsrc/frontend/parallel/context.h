@@ -25,6 +25,7 @@
 
 #include "abstract/abstract_value.h"
 #include "frontend/parallel/ops_info/ops_utils.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
 #include "frontend/parallel/status.h"
 #include "ir/anf.h"
 #include "ir/func_graph.h"
@@ -80,6 +81,10 @@ class ParallelContext {
 
   void set_pipeline_stage_split_num(const int64_t stages);
   int64_t pipeline_stage_split_num() const { return pipeline_stage_split_num_; }
+  void set_pipeline_interleave_num(const int64_t interleave_num);
+  int64_t pipeline_interleave_num() const { return pipeline_interleave_num_; }
+  bool set_pipeline_micro_batch_order(const std::string &micro_batch_order);
+  std::string pipeline_micro_batch_order() const { return pipeline_micro_batch_order_; }
 
   void set_global_rank(int64_t global_rank);
   int64_t global_rank() const { return global_rank_; }
@@ -162,6 +167,8 @@ class ParallelContext {
   std::string parallel_mode_;
   std::string strategy_search_mode_;
   int64_t pipeline_stage_split_num_;
+  int64_t pipeline_interleave_num_;
+  std::string pipeline_micro_batch_order_;
   bool parameter_broadcast_;
   bool device_num_is_set_;
   bool global_rank_is_set_;
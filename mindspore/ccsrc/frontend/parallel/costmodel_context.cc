@@ -68,6 +68,10 @@ void CostModelContext::ResetAlgoParameters() {
   triangle_star_strategy_overwrite_ = DEFAULT_TRIANGLE_STAR_STRATEGY_OVERWRITE;
   dp_algo_enable_approxi_ = DEFAULT_DP_ALGO_ENABLE_APPROX;
   dp_algo_approxi_epsilon_ = DEFAULT_DP_ALGO_APPROX_EPSILON;
+  dp_algo_search_threads_ = DEFAULT_DP_ALGO_SEARCH_THREADS;
+  dp_algo_cost_cache_path_ = DEFAULT_DP_ALGO_COST_CACHE_PATH;
+  dp_algo_strategy_db_path_ = DEFAULT_DP_ALGO_STRATEGY_DB_PATH;
+  dp_algo_redistribution_search_ = DEFAULT_DP_ALGO_REDISTRIBUTION_SEARCH;
 }
 
 void CostModelContext::PrintCostModel() {
@@ -84,6 +88,10 @@ void CostModelContext::PrintCostModel() {
   MS_LOG(INFO) << "dp_algo_enable_approxi: " << dp_algo_enable_approxi_ << ".";
   MS_LOG(INFO) << "dp_algo_approxi_epsilon: " << dp_algo_approxi_epsilon_ << ".";
   MS_LOG(INFO) << "dp_algo_single_loop: " << dp_algo_single_loop_ << ".";
+  MS_LOG(INFO) << "dp_algo_search_threads: " << dp_algo_search_threads_ << ".";
+  MS_LOG(INFO) << "dp_algo_cost_cache_path: " << dp_algo_cost_cache_path_ << ".";
+  MS_LOG(INFO) << "dp_algo_strategy_db_path: " << dp_algo_strategy_db_path_ << ".";
+  MS_LOG(INFO) << "dp_algo_redistribution_search: " << dp_algo_redistribution_search_ << ".";
   MS_LOG(INFO) << "run_phase: " << run_phase_ << ".";
   MS_LOG(INFO) << "tensor_slice_alignment_enable: " << tensor_slice_alignment_enable_ << ".";
   MS_LOG(INFO) << "tensor_slice_align_size: " << tensor_slice_alignment_size_ << ".";
@@ -113,6 +121,26 @@ void CostModelContext::set_dp_algo_enable_approxi(bool approxi) {
   dp_algo_enable_approxi_ = approxi;
 }
 
+void CostModelContext::set_dp_algo_search_threads(int64_t threads) {
+  if (threads < 0) {
+    MS_LOG(EXCEPTION) << "'search_threads' must be non-negative.";
+  }
+  dp_algo_search_threads_ = threads;
+}
+
+void CostModelContext::set_dp_algo_cost_cache_path(const std::string &path) { dp_algo_cost_cache_path_ = path; }
+
+void CostModelContext::set_dp_algo_strategy_db_path(const std::string &path) { dp_algo_strategy_db_path_ = path; }
+
+void CostModelContext::set_dp_algo_redistribution_search(bool search) {
+  if (search) {
+    MS_LOG(INFO) << "dp_algo_redistribution_search: true.";
+  } else {
+    MS_LOG(INFO) << "dp_algo_redistribution_search: false.";
+  }
+  dp_algo_redistribution_search_ = search;
+}
+
 void CostModelContext::set_device_memory_capacity(double dm_capacity) {
   if (dm_capacity <= 0) {
     MS_LOG(EXCEPTION) << "'device_memory_capacity' must be positive.";
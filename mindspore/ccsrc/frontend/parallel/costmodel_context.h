@@ -47,6 +47,10 @@ namespace parallel {
 #define DEFAULT_DP_ALGO_ENABLE_APPROX false
 #define DEFAULT_DP_ALGO_APPROX_EPSILON 0.1
 #define DEFAULT_DP_ALGO_SINGLE_LOOP true
+#define DEFAULT_DP_ALGO_SEARCH_THREADS 0
+#define DEFAULT_DP_ALGO_COST_CACHE_PATH ""
+#define DEFAULT_DP_ALGO_STRATEGY_DB_PATH ""
+#define DEFAULT_DP_ALGO_REDISTRIBUTION_SEARCH false
 
 class CostModelContext {
  public:
@@ -153,6 +157,18 @@ class CostModelContext {
   void set_dp_algo_single_loop(bool);
   bool dp_algo_single_loop() const { return dp_algo_single_loop_; }
 
+  void set_dp_algo_search_threads(int64_t);
+  int64_t dp_algo_search_threads() const { return dp_algo_search_threads_; }
+
+  void set_dp_algo_cost_cache_path(const std::string &);
+  const std::string &dp_algo_cost_cache_path() const { return dp_algo_cost_cache_path_; }
+
+  void set_dp_algo_strategy_db_path(const std::string &);
+  const std::string &dp_algo_strategy_db_path() const { return dp_algo_strategy_db_path_; }
+
+  void set_dp_algo_redistribution_search(bool);
+  bool dp_algo_redistribution_search() const { return dp_algo_redistribution_search_; }
+
  private:
   CostModelContext();
   static std::shared_ptr<CostModelContext> cm_context_inst_;
@@ -197,6 +213,20 @@ class CostModelContext {
   // Whether to generate a single suite of OperatorInfo for a loop.
   bool dp_algo_single_loop_;
 
+  // The maximum number of threads enumerating strategies and costs in the DP algorithm, 0 for the size of the common
+  // thread pool, which also caps it.
+  int64_t dp_algo_search_threads_;
+
+  // The file the redistribution costs are loaded from before the search and saved to after it, empty for none.
+  std::string dp_algo_cost_cache_path_;
+
+  // The file of the strategy database consulted before the search and updated after it, empty for none.
+  std::string dp_algo_strategy_db_path_;
+
+  // Whether to search the redistribution operators of the least communication cost, and fuse the AllGathers of the
+  // sibling redistributions, instead of the operators found by construction.
+  bool dp_algo_redistribution_search_;
+
   int64_t run_phase_;  // 0: 'training', 1: 'inference'
 
   int64_t costmodel_allreduce_fusion_algorithm_;
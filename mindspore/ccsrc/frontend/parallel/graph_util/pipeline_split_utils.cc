@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <list>
+#include <map>
 #include <set>
 #include <queue>
 #include <algorithm>
@@ -590,6 +591,7 @@ void LastStageEndNode(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphM
         (void)new_prim->SetAttrs(end_prim->attrs());
         manager->SetEdge(end_node, 0, value_node);
         end_cnode->AddPrimalAttr(PIPELINE_END, end_cnode->GetPrimalAttr(MICRO));
+        end_cnode->AddPrimalAttr(CHUNK, MakeValue(ParallelContext::GetInstance()->pipeline_interleave_num() - 1));
       }
     }
   }
@@ -734,7 +736,136 @@ void CheckBorderNode(const PipelinePair &forward_start_pair, const PipelinePair
   }
 }
 
+int64_t GetChunk(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  auto chunk_value = cnode->GetPrimalAttr(CHUNK);
+  if (chunk_value == nullptr) {
+    return 0;
+  }
+  return GetValue<int64_t>(chunk_value);
+}
+
+PipelineChunkPair DeduplicateByChunk(const std::vector<AnfNodePtr> &node_vector, const FuncGraphPtr &root) {
+  auto manager = root->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::map<std::pair<int64_t, int64_t>, std::vector<AnfNodePtr>> node_groups;
+  for (auto &node : node_vector) {
+    node_groups[std::make_pair(GetMicroBatch(node), GetChunk(node))].push_back(node);
+  }
+  PipelineChunkPair out;
+  for (auto &node_group : node_groups) {
+    auto &nodes = node_group.second;
+    std::sort(nodes.begin(), nodes.end(), CompFunc);
+    for (size_t i = 1; i < nodes.size(); ++i) {
+      InsertDepend(nodes[i - 1], nodes[i], manager, root);
+    }
+    out[node_group.first] = std::make_pair(nodes.front(), nodes.back());
+  }
+  return out;
+}
+
+static std::pair<AnfNodePtr, AnfNodePtr> GetTaskBorder(const PipelineChunkPair &border, const PipelineTask &task,
+                                                       const std::string &border_name) {
+  auto iter = border.find(std::make_pair(task.micro, task.chunk));
+  if (iter == border.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the " << border_name << " node of micro batch " << task.micro << " on chunk "
+                      << task.chunk;
+  }
+  return iter->second;
+}
+
+static void ReportPipelineSchedule(const PipelineScheduler &scheduler) {
+  // The backward takes about twice the time of the forward.
+  constexpr double kBackwardTime = 2;
+  auto stats = scheduler.Simulate(1, kBackwardTime);
+  MS_LOG(INFO) << "Pipeline schedule of " << scheduler.stage_num() << " stages, " << scheduler.chunk_num()
+               << " chunks per stage and " << scheduler.micro_num() << " micro batches: bubble ratio "
+               << stats.bubble_ratio << ", activations of "
+               << static_cast<double>(stats.peak_in_flight) / static_cast<double>(scheduler.chunk_num())
+               << " micro batches at most.";
+}
+
+void ReorderInterleaved(const FuncGraphPtr &root) {
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  MS_EXCEPTION_IF_NULL(root);
+  auto manager = root->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<AnfNodePtr> forward_start;
+  std::vector<AnfNodePtr> forward_end;
+  std::vector<AnfNodePtr> forward_params;
+  std::vector<AnfNodePtr> backward_start;
+  std::vector<AnfNodePtr> backward_end;
+  std::vector<AnfNodePtr> backward_params;
+  std::vector<AnfNodePtr> allreduce_params;
+  GetBorderNode(&forward_start, &forward_end, &backward_start, &backward_end, &forward_params, &backward_params,
+                &allreduce_params, root);
+  auto micro_max = GetMicroBatch(forward_end.back());
+  auto forward_start_pair = DeduplicateByChunk(forward_start, root);
+  auto forward_end_pair = DeduplicateByChunk(forward_end, root);
+  auto backward_start_pair = DeduplicateByChunk(backward_start, root);
+  auto backward_end_pair = DeduplicateByChunk(backward_end, root);
+  auto forward_params_pair = Deduplicate(forward_params, root, micro_max);
+  auto backward_params_pair = Deduplicate(backward_params, root, micro_max);
+
+  auto parallel_context = ParallelContext::GetInstance();
+  PipelineScheduler scheduler(g_device_manager->stage_num(), parallel_context->pipeline_interleave_num(),
+                              micro_max + 1, parallel_context->pipeline_micro_batch_order());
+  ReportPipelineSchedule(scheduler);
+  auto tasks = scheduler.Schedule(g_device_manager->stage_id());
+  auto task_start = [&](const PipelineTask &task) {
+    return task.is_forward ? GetTaskBorder(forward_start_pair, task, "forward start")
+                           : GetTaskBorder(backward_start_pair, task, "backward start");
+  };
+  auto task_end = [&](const PipelineTask &task) {
+    return task.is_forward ? GetTaskBorder(forward_end_pair, task, "forward end")
+                           : GetTaskBorder(backward_end_pair, task, "backward end");
+  };
+  // A Send blocks until the peer posts its Receive, so a task starts after the compute of the last one rather than
+  // after its Send. The Sends go in order for each direction, as PipelineScheduler::Simulate models them.
+  auto compute_end = [](const AnfNodePtr &end_node) {
+    if (!IsPrimitiveCNode(end_node, prim::kPrimSend)) {
+      return end_node;
+    }
+    auto temp_node = GetActualOp(end_node->cast<CNodePtr>()->input(1));
+    MS_EXCEPTION_IF_NULL(temp_node);
+    return temp_node;
+  };
+  std::map<bool, AnfNodePtr> last_send;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    auto end_pair = task_end(tasks[i]);
+    if (i > 0) {
+      InsertDepend(compute_end(task_end(tasks[i - 1]).second), task_start(tasks[i]).first, manager, root);
+    }
+    if (!IsPrimitiveCNode(end_pair.first, prim::kPrimSend)) {
+      continue;
+    }
+    auto iter = last_send.find(tasks[i].is_forward);
+    if (iter != last_send.end()) {
+      InsertDepend(iter->second, end_pair.first, manager, root);
+    }
+    last_send[tasks[i].is_forward] = end_pair.second;
+  }
+  if (!forward_params.empty()) {
+    InsertDepend(forward_params_pair.second[0], task_start(tasks.front()).first, manager, root);
+  }
+  if (!backward_params.empty()) {
+    for (auto &node : allreduce_params) {
+      InsertDepend(node, backward_params_pair.first[0], manager, root);
+    }
+    InsertDepend(task_end(tasks.back()).second, backward_params[0], manager, root);
+    for (auto &send : last_send) {
+      InsertDepend(send.second, backward_params[0], manager, root);
+    }
+  }
+}
+
 void Reorder(const FuncGraphPtr &root) {
+  if (root->has_flag(TRAINING) && ParallelContext::GetInstance()->pipeline_interleave_num() > 1) {
+    ReorderInterleaved(root);
+    return;
+  }
   std::vector<AnfNodePtr> forward_start;
   std::vector<AnfNodePtr> forward_end;
   std::vector<AnfNodePtr> forward_params;
@@ -758,6 +889,9 @@ void Reorder(const FuncGraphPtr &root) {
   auto forward_params_pair = Deduplicate(forward_params, root, micro_max);
   auto backward_params_pair = Deduplicate(backward_params, root, micro_max);
   CheckBorderNode(forward_start_pair, forward_end_pair, backward_start_pair, backward_end_pair, LongToSize(micro_max));
+  if (root->has_flag(TRAINING)) {
+    ReportPipelineSchedule(PipelineScheduler(g_device_manager->stage_num(), 1, micro_max + 1));
+  }
   PipelinePair forward_end_before_pair;
   if (!IsLastStage()) {
     for (auto &node : forward_end_pair.first) {
@@ -20,12 +20,16 @@
 #include <utility>
 #include <vector>
 #include <string>
+#include <map>
 #include "ir/anf.h"
 #include "ir/manager.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
 
 namespace mindspore {
 namespace parallel {
 using PipelinePair = std::pair<std::vector<AnfNodePtr>, std::vector<AnfNodePtr>>;
+// The first and the last border nodes of each micro batch and chunk.
+using PipelineChunkPair = std::map<std::pair<int64_t, int64_t>, std::pair<AnfNodePtr, AnfNodePtr>>;
 AnfNodePtr FindAccuGrad(const CNodePtr &cnode);
 bool IsLastStage();
 void InsertVirtualAssignAdd(const std::pair<AnfNodePtr, int> &node_user, const FuncGraphManagerPtr &manager,
@@ -53,6 +57,9 @@ void GetBorderNode(std::vector<AnfNodePtr> *forward_start, std::vector<AnfNodePt
                    std::vector<AnfNodePtr> *backward_start, std::vector<AnfNodePtr> *backward_end,
                    std::vector<AnfNodePtr> *forward_params, std::vector<AnfNodePtr> *backward_params,
                    std::vector<AnfNodePtr> *allreduce_params, const FuncGraphPtr &root);
+int64_t GetChunk(const AnfNodePtr &node);
+PipelineChunkPair DeduplicateByChunk(const std::vector<AnfNodePtr> &node_vector, const FuncGraphPtr &root);
+void ReorderInterleaved(const FuncGraphPtr &root);
 void Reorder(const FuncGraphPtr &root);
 void ReorderForPredict(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager);
 void HandleMicroBatch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphManagerPtr &manager);
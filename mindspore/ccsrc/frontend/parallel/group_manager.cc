@@ -29,6 +29,8 @@
 
 namespace mindspore {
 namespace parallel {
+thread_local bool ForbidGroupCreation::forbidden_ = false;
+
 Group::Group() {
   name_.clear();
   devices_.clear();
@@ -162,6 +164,10 @@ Status CreateGroups(const std::vector<std::pair<std::string, std::vector<uint32_
 #endif
 Status GroupManager::CreateGroup(const std::string &group_name, const std::vector<Device> &devices,
                                  mindspore::parallel::Group *const group) {
+  if (ForbidGroupCreation::forbidden()) {
+    MS_LOG(EXCEPTION) << "Create group " << group_name
+                      << " in the parallel strategy search, whose costs must be computed from the rank lists only.";
+  }
   // it is simple to use size to determine whether it is a world group
   uint32_t world_size = 0;
   (void)CommManager::GetInstance().GetRankSize(world_group_, &world_size);
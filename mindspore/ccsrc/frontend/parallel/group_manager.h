@@ -50,6 +50,20 @@ class Group {
   std::vector<Device> devices_;
 };
 
+// Groups are created collectively, so every rank has to create them in the same order. The parallel strategy search
+// computes its costs from rank lists only, and its threads hold this guard: creating a group while it is held raises
+// an exception instead of racing on the groups and creating them in a different order on each rank.
+class ForbidGroupCreation {
+ public:
+  ForbidGroupCreation() : prev_forbidden_(forbidden_) { forbidden_ = true; }
+  ~ForbidGroupCreation() { forbidden_ = prev_forbidden_; }
+  static bool forbidden() { return forbidden_; }
+
+ private:
+  bool prev_forbidden_;
+  static thread_local bool forbidden_;
+};
+
 class GroupManager {
  public:
   GroupManager();
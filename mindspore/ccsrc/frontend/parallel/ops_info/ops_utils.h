@@ -171,6 +171,8 @@ constexpr char SKIP_REDISTRIBUTION[] = "skip_redistribution";
 constexpr char REPLACE[] = "replace";
 constexpr char CONNSYMBOL[] = "/";
 constexpr char INSTANCE_NAME[] = "instance_name";
+constexpr char INPUT_NAMES[] = "input_names";
+constexpr char OUTPUT_NAMES[] = "output_names";
 constexpr char SPLIT_SENS[] = "split_sens";
 constexpr char SEND_RNAK_IDS[] = "send_rank_ids";
 constexpr char RECV_RNAK_IDS[] = "recv_rank_ids";
@@ -416,6 +418,7 @@ constexpr char SRC_RANK[] = "src_rank";
 constexpr char PIPELINE_PARAM[] = "pipeline_param";
 constexpr char PIPELINE_END[] = "pipeline_end";
 constexpr char PIPELINE_BEGIN[] = "pipeline_begin";
+constexpr char CHUNK[] = "chunk";
 constexpr char MAIN_GRAPH[] = "main_graph";
 constexpr char SR_TAG[] = "sr_tag";
 constexpr char NEED_GRAD[] = "need_grad";
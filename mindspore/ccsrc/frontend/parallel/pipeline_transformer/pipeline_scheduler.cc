@@ -0,0 +1,196 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// The data sent from a virtual stage to another, keyed by the direction, the micro batch and the virtual stage which
+// receives.
+using CommKey = std::tuple<bool, int64_t, int64_t>;
+
+// A task of a stage in the simulation. It receives its input, computes, and sends its output, and the Receive or the
+// Send is left out when the other virtual stage is on the same stage.
+struct SimulatedTask {
+  bool has_receive{false};
+  CommKey receive;
+  double time{0};
+  bool has_send{false};
+  CommKey send;
+};
+}  // namespace
+
+PipelineScheduler::PipelineScheduler(int64_t stage_num, int64_t chunk_num, int64_t micro_num,
+                                     const std::string &micro_batch_order)
+    : stage_num_(stage_num), chunk_num_(chunk_num), micro_num_(micro_num) {
+  if (stage_num <= 0 || chunk_num <= 0) {
+    MS_LOG(EXCEPTION) << "The stage num " << stage_num << " and the chunk num " << chunk_num << " should be positive.";
+  }
+  if (micro_num < stage_num) {
+    MS_LOG(EXCEPTION) << "MicroBatch size: " << micro_num << " can't less than stage num: " << stage_num;
+  }
+  if (micro_batch_order == DEPTH_FIRST) {
+    group_size_ = stage_num;
+  } else if (micro_batch_order == BREADTH_FIRST) {
+    group_size_ = micro_num;
+  } else {
+    MS_LOG(EXCEPTION) << "The micro batch order should be " << DEPTH_FIRST << " or " << BREADTH_FIRST << ", but got "
+                      << micro_batch_order;
+  }
+  if (chunk_num > 1 && micro_num % group_size_ != 0) {
+    MS_LOG(EXCEPTION) << "MicroBatch size: " << micro_num << " should be a multiple of stage num: " << stage_num
+                      << " when each stage has " << chunk_num << " chunks.";
+  }
+}
+
+PipelineTask PipelineScheduler::GetTask(int64_t index, bool is_forward) const {
+  PipelineTask task;
+  auto chunk = (index / group_size_) % chunk_num_;
+  task.chunk = is_forward ? chunk : chunk_num_ - 1 - chunk;
+  task.micro = (index / (group_size_ * chunk_num_)) * group_size_ + index % group_size_;
+  task.is_forward = is_forward;
+  return task;
+}
+
+std::vector<PipelineTask> PipelineScheduler::Schedule(int64_t stage) const {
+  if (stage < 0 || stage >= stage_num_) {
+    MS_LOG(EXCEPTION) << "The stage " << stage << " is out of the range of the stage num " << stage_num_;
+  }
+  auto task_num = micro_num_ * chunk_num_;
+  // The later stages start the backwards earlier. With chunks, the first backward of the stage waits for the
+  // forwards of the group on all its chunks, and two more forwards for each later stage on the way back.
+  int64_t warmup_num = stage_num_ - stage - 1;
+  if (chunk_num_ > 1) {
+    warmup_num = warmup_num * 2 + (chunk_num_ - 1) * group_size_;
+  }
+  warmup_num = std::min(warmup_num, task_num);
+  std::vector<PipelineTask> tasks;
+  for (int64_t i = 0; i < warmup_num; ++i) {
+    tasks.push_back(GetTask(i, true));
+  }
+  for (int64_t i = 0; i < task_num - warmup_num; ++i) {
+    tasks.push_back(GetTask(warmup_num + i, true));
+    tasks.push_back(GetTask(i, false));
+  }
+  for (int64_t i = task_num - warmup_num; i < task_num; ++i) {
+    tasks.push_back(GetTask(i, false));
+  }
+  return tasks;
+}
+
+PipelineScheduleStats PipelineScheduler::Simulate(double forward_time, double backward_time, double comm_time) const {
+  auto virtual_stage_num = stage_num_ * chunk_num_;
+  auto chunk_forward_time = forward_time / static_cast<double>(chunk_num_);
+  auto chunk_backward_time = backward_time / static_cast<double>(chunk_num_);
+  PipelineScheduleStats stats;
+  std::vector<std::vector<SimulatedTask>> stage_tasks(LongToSize(stage_num_));
+  for (int64_t stage = 0; stage < stage_num_; ++stage) {
+    int64_t in_flight = 0;
+    for (auto &task : Schedule(stage)) {
+      auto virtual_stage = task.chunk * stage_num_ + stage;
+      auto from = task.is_forward ? virtual_stage - 1 : virtual_stage + 1;
+      auto to = task.is_forward ? virtual_stage + 1 : virtual_stage - 1;
+      SimulatedTask simulated;
+      simulated.has_receive = from >= 0 && from < virtual_stage_num && from % stage_num_ != stage;
+      simulated.receive = std::make_tuple(task.is_forward, task.micro, virtual_stage);
+      simulated.time = task.is_forward ? chunk_forward_time : chunk_backward_time;
+      simulated.has_send = to >= 0 && to < virtual_stage_num && to % stage_num_ != stage;
+      simulated.send = std::make_tuple(task.is_forward, task.micro, to);
+      stage_tasks[LongToSize(stage)].push_back(simulated);
+      in_flight += task.is_forward ? 1 : -1;
+      stats.peak_in_flight = std::max(stats.peak_in_flight, in_flight);
+    }
+  }
+
+  // The Sends of each stage go in order for each direction, the backward ones at 2 * stage and the forward ones at
+  // 2 * stage + 1, with the time their data are ready.
+  std::vector<std::vector<std::pair<CommKey, double>>> sends(stage_tasks.size() * 2);
+  std::vector<size_t> next_send(sends.size(), 0);
+  std::vector<double> send_clock(sends.size(), 0);
+  std::vector<size_t> next_task(stage_tasks.size(), 0);
+  std::vector<double> clock(stage_tasks.size(), 0);
+  // The time when each Send or Receive is posted.
+  std::map<CommKey, double> send_time;
+  std::map<CommKey, double> receive_time;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (size_t stage = 0; stage < stage_tasks.size(); ++stage) {
+      const auto &tasks = stage_tasks[stage];
+      for (; next_task[stage] < tasks.size(); ++next_task[stage]) {
+        const auto &task = tasks[next_task[stage]];
+        if (task.has_receive) {
+          progress = receive_time.emplace(task.receive, clock[stage]).second || progress;
+          auto iter = send_time.find(task.receive);
+          if (iter == send_time.end()) {
+            break;
+          }
+          clock[stage] = std::max(clock[stage], std::max(receive_time[task.receive], iter->second) + comm_time);
+        }
+        clock[stage] += task.time;
+        if (task.has_send) {
+          sends[stage * 2 + (std::get<0>(task.send) ? 1 : 0)].emplace_back(task.send, clock[stage]);
+        }
+        progress = true;
+      }
+      for (auto queue = stage * 2; queue < stage * 2 + 2; ++queue) {
+        for (; next_send[queue] < sends[queue].size(); ++next_send[queue]) {
+          const auto &send = sends[queue][next_send[queue]];
+          progress = send_time.emplace(send.first, std::max(send.second, send_clock[queue])).second || progress;
+          auto iter = receive_time.find(send.first);
+          if (iter == receive_time.end()) {
+            break;
+          }
+          send_clock[queue] = std::max(send_time[send.first], iter->second) + comm_time;
+          progress = true;
+        }
+      }
+    }
+  }
+  for (size_t stage = 0; stage < stage_tasks.size(); ++stage) {
+    const CommKey *waiting = nullptr;
+    if (next_task[stage] < stage_tasks[stage].size()) {
+      waiting = &stage_tasks[stage][next_task[stage]].receive;
+    }
+    for (auto queue = stage * 2; queue < stage * 2 + 2 && waiting == nullptr; ++queue) {
+      if (next_send[queue] < sends[queue].size()) {
+        waiting = &sends[queue][next_send[queue]].first;
+      }
+    }
+    if (waiting != nullptr) {
+      MS_LOG(EXCEPTION) << "The pipeline schedule of " << stage_num_ << " stages, " << chunk_num_ << " chunks and "
+                        << micro_num_ << " micro batches deadlocks: stage " << stage << " waits for the "
+                        << (std::get<0>(*waiting) ? "forward" : "backward") << " of micro batch "
+                        << std::get<1>(*waiting) << " to virtual stage " << std::get<2>(*waiting);
+    }
+  }
+  stats.makespan = std::max(*std::max_element(clock.begin(), clock.end()),
+                            *std::max_element(send_clock.begin(), send_clock.end()));
+  if (stats.makespan > 0) {
+    auto busy_time = static_cast<double>(micro_num_) * (forward_time + backward_time);
+    stats.bubble_ratio = std::max(0.0, 1 - busy_time / stats.makespan);
+  }
+  return stats;
+}
+}  // namespace parallel
+}  // namespace mindspore
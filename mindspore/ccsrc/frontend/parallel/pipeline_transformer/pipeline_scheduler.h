@@ -0,0 +1,82 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+// The values of pipeline_micro_batch_order.
+constexpr char DEPTH_FIRST[] = "depth_first";
+constexpr char BREADTH_FIRST[] = "breadth_first";
+
+// The forward or backward of a micro batch on a chunk of a stage. The chunk c of the stage s is the virtual stage
+// c * stage_num + s, so the model is cut into stage_num * chunk_num virtual stages which go round the stages.
+struct PipelineTask {
+  int64_t micro{0};
+  int64_t chunk{0};
+  bool is_forward{true};
+};
+
+struct PipelineScheduleStats {
+  // The time of a step, in the unit of the given forward and backward times.
+  double makespan{0};
+  // The ratio of the time the stages are idle in a step.
+  double bubble_ratio{0};
+  // The most forwards on a stage whose backwards are not done. A forward keeps the activations of one chunk, so the
+  // activation memory is bounded by peak_in_flight / chunk_num micro batches.
+  int64_t peak_in_flight{0};
+};
+
+// The interleaved 1F1B schedule. Each stage runs some forwards to warm up, then one forward and one backward in turn,
+// and the remaining backwards at last. The micro batches go through the chunks in groups: a group of stage_num micro
+// batches for depth_first, which keeps few activations, or all the micro batches for breadth_first, which sends them
+// in larger runs. A single chunk is the plain 1F1B schedule.
+class PipelineScheduler {
+ public:
+  PipelineScheduler(int64_t stage_num, int64_t chunk_num, int64_t micro_num,
+                    const std::string &micro_batch_order = DEPTH_FIRST);
+  ~PipelineScheduler() = default;
+
+  // The tasks of the stage in the order they are run.
+  std::vector<PipelineTask> Schedule(int64_t stage) const;
+  // Run the schedules of all the stages, where a forward or a backward of a whole stage takes the given time. The
+  // Receive of a task is posted when the last task is computed, and the task computes when the data arrive. A Send
+  // blocks until its Receive is posted, and the Sends of a stage go in order for each direction beside the computes.
+  // Raise an exception if the schedules deadlock.
+  PipelineScheduleStats Simulate(double forward_time, double backward_time, double comm_time = 0) const;
+
+  int64_t stage_num() const { return stage_num_; }
+  int64_t chunk_num() const { return chunk_num_; }
+  int64_t micro_num() const { return micro_num_; }
+
+ private:
+  PipelineTask GetTask(int64_t index, bool is_forward) const;
+
+  int64_t stage_num_;
+  int64_t chunk_num_;
+  int64_t micro_num_;
+  // The number of micro batches which go through a chunk before the next chunk.
+  int64_t group_size_;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PIPELINE_TRANSFORMER_PIPELINE_SCHEDULER_H_
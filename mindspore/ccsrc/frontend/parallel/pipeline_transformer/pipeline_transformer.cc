@@ -217,7 +217,7 @@ void PipelineTransformer::Coloring() {
           auto user_node = user_pair.first->cast<CNodePtr>();
           user_node->set_user_data<NodeStageInfo>(std::make_shared<NodeStageInfo>(graph->stage()));
           auto user_node_graph = user_node->func_graph();
-          if (graph->stage() == stage_ && user_node_graph->stage() == -1) {
+          if (IsOwnedStage(graph->stage()) && user_node_graph->stage() == -1) {
             user_node_graph->set_stage(graph->stage());
             need_coloring = true;
           }
@@ -226,7 +226,7 @@ void PipelineTransformer::Coloring() {
     }
   }
   MS_EXCEPTION_IF_NULL(g_device_manager);
-  auto stage_num = g_device_manager->stage_num();
+  auto stage_num = g_device_manager->stage_num() * ParallelContext::GetInstance()->pipeline_interleave_num();
   if (SizeToLong(stage_set.size()) != stage_num) {
     MS_LOG(EXCEPTION) << "Stage num is " << stage_num << " is not equal to stage used: " << stage_set.size();
   }
@@ -432,7 +432,9 @@ std::vector<AnfNodePtr> PipelineTransformer::HandleSharedParameter() {
       if (IsValueNode<FuncGraph>(cnode->input(0))) {
         graph = GetValueNode<FuncGraphPtr>(cnode->input(0));
       }
-      if (graph == root_ || graph->stage() == -1 || !parameter_stage.count(stage_)) {
+      if (graph == root_ || graph->stage() == -1 ||
+          std::none_of(parameter_stage.begin(), parameter_stage.end(),
+                       [this](int64_t stage) { return IsOwnedStage(stage); })) {
         continue;
       }
       auto micro = cnode->GetPrimalAttr(MICRO);
@@ -440,23 +442,25 @@ std::vector<AnfNodePtr> PipelineTransformer::HandleSharedParameter() {
         MS_LOG(INFO) << "parameter: " << parameter->ToString() << " doesn't have micro batch";
         micro = MakeValue(int64_t(0));
       }
-      if (stage_ == *parameter_stage.begin()) {
+      auto parameter_owner = *parameter_stage.begin();
+      if (IsOwnedStage(parameter_owner)) {
         auto stage_info = node->user_data<NodeStageInfo>();
-        if (graph->stage() == stage_ || stage_info == nullptr) {
+        if (IsOwnedStage(graph->stage()) || stage_info == nullptr) {
           continue;
         }
         auto user_stage = stage_info->stage();
         if (Reuse(parameter, user_stage, make_tuple_input, DEST_RANK)) {
           continue;
         }
-        auto send_out = InsertSend(parameter, user_stage, stage_, micro);
+        auto send_out = InsertSend(parameter, user_stage, parameter_owner, micro);
         make_tuple_input.push_back(send_out.depend);
       } else {
-        auto receive = Reuse(parameter, *parameter_stage.begin(), recvs, SRC_RANK);
+        auto receive = Reuse(parameter, parameter_owner, recvs, SRC_RANK);
         if (receive) {
           manager_->SetEdge(node, user.second, receive);
         } else {
-          auto recv = InsertReceive(main_graph_, parameter, node, user.second, stage_, *parameter_stage.begin(), micro,
+          auto user_stage = IsOwnedStage(graph->stage()) ? graph->stage() : stage_;
+          auto recv = InsertReceive(main_graph_, parameter, node, user.second, user_stage, parameter_owner, micro,
                                     parameter);
           recvs.push_back(recv);
         }
@@ -489,7 +493,7 @@ void PipelineTransformer::ParameterColoring() {
     }
     MS_EXCEPTION_IF_NULL(param_info);
     auto requires_grad = param_info->requires_grad();
-    if (*parameter_stage.begin() == stage_ && !virtual_param_ && requires_grad) {
+    if (!parameter_stage.empty() && IsOwnedStage(*parameter_stage.begin()) && !virtual_param_ && requires_grad) {
       virtual_param_ = parameter;
     }
     parameter_color_map[parameter] = parameter_stage;
@@ -564,7 +568,8 @@ AnfNodePtr PipelineTransformer::FindPipelineCareNode(const AnfNodePtr &node) {
 
 SendAttr PipelineTransformer::InsertSend(const AnfNodePtr &parameter, int64_t user_node_stage, int64_t node_stage,
                                          const ValuePtr &value) {
-  auto dest_rank = global_rank_ + (user_node_stage - node_stage) * per_stage_rank_num_;
+  auto dest_stage = DeviceStage(user_node_stage);
+  auto dest_rank = global_rank_ + (dest_stage - DeviceStage(node_stage)) * per_stage_rank_num_;
   int64_t send_tag;
   if (send_tag_map.find(dest_rank) != send_tag_map.end()) {
     send_tag = send_tag_map[dest_rank] + 1;
@@ -574,7 +579,7 @@ SendAttr PipelineTransformer::InsertSend(const AnfNodePtr &parameter, int64_t us
     send_tag_map[dest_rank] = 0;
   }
   Attr attr_tag = std::make_pair(SR_TAG, MakeValue(send_tag));
-  Attr attr_rank = std::make_pair(DEST_RANK, MakeValue(user_node_stage));
+  Attr attr_rank = std::make_pair(DEST_RANK, MakeValue(dest_stage));
   Attr attr_group = std::make_pair(GROUP, MakeValue(group_[0]));
   Attr attr_group_back = std::make_pair(GROUP_BACK, MakeValue(group_[1]));
   OperatorAttrs attrs = {attr_tag, attr_rank, attr_group, attr_group_back};
@@ -613,6 +618,7 @@ SendAttr PipelineTransformer::InsertSend(const AnfNodePtr &parameter, int64_t us
     send->AddPrimalAttr(PARAM_INDEX, MakeValue(index));
   }
   send->AddPrimalAttr(MICRO, value);
+  send->AddPrimalAttr(CHUNK, MakeValue(Chunk(node_stage)));
   OperatorAttrs depend_attrs;
   auto depend_op = CreatOpInstance(depend_attrs, DEPEND, DEPEND);
   std::vector<AnfNodePtr> depend_input = {NewValueNode(depend_op), parameter, send};
@@ -631,7 +637,8 @@ AnfNodePtr PipelineTransformer::InsertReceive(const FuncGraphPtr &graph, const A
                                               const AnfNodePtr &use_node, int index, int64_t user_node_stage,
                                               int64_t node_stage, const ValuePtr &value,
                                               const AnfNodePtr &graph_param) {
-  auto src_rank = global_rank_ - (user_node_stage - node_stage) * per_stage_rank_num_;
+  auto src_stage = DeviceStage(node_stage);
+  auto src_rank = global_rank_ - (DeviceStage(user_node_stage) - src_stage) * per_stage_rank_num_;
   int64_t recv_tag;
   if (recv_tag_map.find(src_rank) != recv_tag_map.end()) {
     recv_tag = recv_tag_map[src_rank] + 1;
@@ -641,7 +648,7 @@ AnfNodePtr PipelineTransformer::InsertReceive(const FuncGraphPtr &graph, const A
     recv_tag_map[src_rank] = 0;
   }
   Attr attr_tag = std::make_pair(SR_TAG, MakeValue(recv_tag));
-  Attr attr_rank = std::make_pair(SRC_RANK, MakeValue(node_stage));
+  Attr attr_rank = std::make_pair(SRC_RANK, MakeValue(src_stage));
   std::pair<OperatorInfoPtr, int> op_info_pair;
   bool is_param = true;
   TensorInfo tensor_info;
@@ -677,6 +684,7 @@ AnfNodePtr PipelineTransformer::InsertReceive(const FuncGraphPtr &graph, const A
     recv->AddPrimalAttr(PIPELINE_BEGIN, value);
   }
   recv->AddPrimalAttr(MICRO, value);
+  recv->AddPrimalAttr(CHUNK, MakeValue(Chunk(user_node_stage)));
   auto node_abstract = node->abstract();
   if (node->isa<CNode>()) {
     auto cnode = node->cast<CNodePtr>();
@@ -717,7 +725,7 @@ AnfNodePtr PipelineTransformer::Reuse(const AnfNodePtr &node, int64_t stage, con
     if (cnode->input(1) == node) {
       auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
       auto dest_rank_send = GetValue<int64_t>(prim->GetAttr(tag));
-      if (dest_rank_send == stage) {
+      if (dest_rank_send == DeviceStage(stage)) {
         return input;
       }
     }
@@ -803,7 +811,7 @@ AnfNodePtr PipelineTransformer::HandleParameterGraph(const AnfNodePtr &node, con
   }
 
   // insert receive
-  if (stage_ == user_stage) {
+  if (IsOwnedStage(user_stage)) {
     auto recv = Reuse(argument, stage, ops, SRC_RANK);
     if (recv) {
       manager_->SetEdge(use_node, SizeToInt(pos), recv);
@@ -815,7 +823,7 @@ AnfNodePtr PipelineTransformer::HandleParameterGraph(const AnfNodePtr &node, con
   if (Reuse(argument, user_stage, ops, DEST_RANK)) {
     return nullptr;
   }
-  auto send_out = InsertSend(argument, user_stage, stage_, micro);
+  auto send_out = InsertSend(argument, user_stage, stage, micro);
   send_out.depend->set_user_data<Type>(DTYPE, send_out.type);
   send_out.depend->set_user_data<ValueList>(SHAPE, send_out.shape);
   return send_out.depend;
@@ -834,7 +842,11 @@ void PipelineTransformer::CutBorderForNode(const FuncGraphPtr &graph, const AnfN
       continue;
     }
     auto user_node_stage = user_stage_info->stage();
-    if (node_stage != stage_ && user_node_stage != stage_) {
+    if (!IsOwnedStage(node_stage) && !IsOwnedStage(user_node_stage)) {
+      continue;
+    }
+    // The chunks of a device use the outputs of each other directly.
+    if (node_stage != user_node_stage && DeviceStage(node_stage) == DeviceStage(user_node_stage)) {
       continue;
     }
     auto micro = user_node->cast<CNodePtr>()->GetPrimalAttr(MICRO);
@@ -843,7 +855,7 @@ void PipelineTransformer::CutBorderForNode(const FuncGraphPtr &graph, const AnfN
       micro = MakeValue(int64_t(0));
     }
     if (node_stage < user_node_stage) {
-      if (node_stage == stage_) {
+      if (IsOwnedStage(node_stage)) {
         if (IsParameterGraph(node)) {
           auto send_depend =
             HandleParameterGraph(node, user_node, node_stage, user_node_stage, micro, user_pair.second, *send_ops);
@@ -919,6 +931,13 @@ void PipelineTransformer::CutGraph() {
   auto send_recv_ops = CutBorder(main_graph_);
   auto send_ops = send_recv_ops.first;
   if (IsLastStage()) {
+    // The chunks of the last stage other than the last one send their outputs to the first stage.
+    (void)make_tuple_inputs.insert(make_tuple_inputs.end(), send_ops.begin(), send_ops.end());
+    if (make_tuple_inputs.size() > 1) {
+      auto make_tuple = main_graph_->NewCNode(make_tuple_inputs);
+      std::vector<AnfNodePtr> out = {NewValueNode(prim::kPrimDepend), main_graph_->output(), make_tuple};
+      manager_->SetEdge(main_graph_->get_return(), 1, main_graph_->NewCNode(out));
+    }
     return;
   }
   if (send_ops.empty() && !root_->has_flag(TRAINING)) {
@@ -937,6 +956,16 @@ void PipelineTransformer::CutGraph() {
   (void)manager_->Replace(main_graph_->output(), out_node);
 }
 
+int64_t PipelineTransformer::DeviceStage(int64_t stage) const {
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  return stage % g_device_manager->stage_num();
+}
+
+int64_t PipelineTransformer::Chunk(int64_t stage) const {
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  return stage / g_device_manager->stage_num();
+}
+
 void PipelineTransformer::ElimGraphStage() {
   for (auto &fg : manager_->func_graphs()) {
     fg->set_stage(-1);
@@ -87,6 +87,11 @@ class PipelineTransformer {
   CNodePtr GraphOutNode(const AnfNodePtr &node, int tuple_index);
   bool IsPipelineCareNode(const CNodePtr &cnode);
   std::pair<CNodePtr, FuncGraphPtr> FindSensNode();
+  // With pipeline_interleave_num, the stage of the cells is a virtual stage, whose chunk is stage / stage_num and
+  // which runs on the devices of stage % stage_num.
+  int64_t DeviceStage(int64_t stage) const;
+  int64_t Chunk(int64_t stage) const;
+  bool IsOwnedStage(int64_t stage) const { return DeviceStage(stage) == stage_; }
   FuncGraphManagerPtr manager_;
   int64_t stage_;
   FuncGraphPtr root_;
@@ -34,6 +34,7 @@
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
 #include "frontend/parallel/auto_parallel/edge_costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "frontend/parallel/auto_parallel/redistribution_cost_cache.h"
 #include "frontend/parallel/auto_parallel/rec_core/rec_generate_strategy.h"
 #include "frontend/parallel/auto_parallel/rec_core/rec_parse_graph.h"
 #include "frontend/parallel/auto_parallel/rec_core/rec_partition.h"
@@ -45,6 +46,7 @@
 #include "frontend/parallel/step_parallel.h"
 #include "frontend/parallel/parameter_manager.h"
 #include "frontend/parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
+#include "frontend/parallel/strategy_checkpoint/strategy_database.h"
 #include "ir/anf.h"
 #include "ir/param_info.h"
 #include "ir/tensor.h"
@@ -232,6 +234,99 @@ bool IsOperatorsInTwoSeparateLoops(const CNodePtr &a_cnode, const CNodePtr &b_cn
 
 // 'configured_stra_ops_' includes all operators that are configured sharding strategies.
 std::map<OperatorInfoPtr, StrategyPtr> configured_stra_ops_;
+
+// How the strategy of an operator is found, recorded when the strategy database is on.
+enum class StrategySource { kConfigured, kDatabaseExact, kDatabasePartial, kSearched };
+struct OperatorSignature {
+  OperatorInfoPtr operator_info;
+  StrategySignature signature;
+  StrategySource source;
+};
+// The operators whose selected strategies are put into the strategy database after the search.
+std::vector<OperatorSignature> ops_signatures_;
+
+static bool StrategyDatabaseOn() {
+  return !CostModelContext::GetInstance()->dp_algo_strategy_db_path().empty() &&
+         ParallelContext::GetInstance()->strategy_search_mode() != RECURSIVE_PROGRAMMING;
+}
+
+static bool IsSignatureValue(const ValuePtr &value) {
+  return value != nullptr && (value->isa<Scalar>() || value->isa<StringImm>() || value->isa<ValueSequeue>());
+}
+
+// The attributes of the primitive in the order of their names. The names of the inputs and outputs, the instance
+// name and the configured strategies do not change the strategies searched, and the attributes which are not scalars
+// or tuples are not printable.
+static std::string GetPrimitiveAttrsSignature(const PrimitivePtr &prim) {
+  static const std::set<std::string> skipped_attrs = {INPUT_NAMES,  OUTPUT_NAMES, INSTANCE_NAME, IN_STRATEGY,
+                                                      OUT_STRATEGY, GEN_STRATEGY, STAGE_ATTR};
+  std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+  std::string signature;
+  for (auto &attr : attrs) {
+    if (skipped_attrs.count(attr.first) > 0 || !IsSignatureValue(attr.second)) {
+      continue;
+    }
+    signature += (signature.empty() ? "" : ",") + attr.first + "=" + attr.second->ToString();
+  }
+  return signature;
+}
+
+static StrategySignature GetStrategySignature(const PrimitivePtr &prim, const CNodePtr &cnode,
+                                              const Shapes &input_shapes, const std::vector<bool> &is_parameter) {
+  std::vector<std::string> input_prims;
+  for (size_t i = 1; i < cnode->size(); ++i) {
+    const auto &input = cnode->input(i);
+    auto input_prim = GetCNodePrimitive(input);
+    if (input_prim != nullptr) {
+      input_prims.push_back(input_prim->name());
+    } else if (input->isa<Parameter>()) {
+      input_prims.push_back("Parameter");
+    } else if (input->isa<ValueNode>()) {
+      // The constant inputs, such as the axis of a reduction, are part of the operator. A tensor stays a Value.
+      auto value = GetValueNode(input);
+      if (IsSignatureValue(value)) {
+        input_prims.push_back("Value=" + value->ToString());
+      } else {
+        input_prims.push_back("Value");
+      }
+    } else {
+      input_prims.push_back("-");
+    }
+  }
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  return StrategyDatabase::Signature(prim->name(), GetPrimitiveAttrsSignature(prim), input_prims, input_shapes,
+                                     is_parameter, g_device_manager->GetDeviceListByStageId(0).size());
+}
+
+// Reuse the strategy of the signature in the strategy database. The strategy of a partial match may be invalid for the
+// shapes of the operator, and then the strategies of the operator are searched.
+static bool SetStrategyFromDatabase(const OperatorInfoPtr &operator_info, const StrategySignature &signature,
+                                    bool *exact) {
+  auto strategy = StrategyDatabase::GetInstance().Find(signature, exact);
+  if (strategy == nullptr) {
+    return false;
+  }
+  if (operator_info->SetCostUnderStrategy(strategy) != SUCCESS) {
+    MS_LOG(INFO) << "The strategy of " << operator_info->name() << " in the strategy database is invalid, search it.";
+    operator_info->ClearStrategyCost();
+    return false;
+  }
+  if (CostModelContext::GetInstance()->fully_use_device()) {
+    int64_t used_devices = operator_info->used_devices();
+    auto total_device_num = g_device_manager->GetDeviceListByStageId(0).size();
+    if (used_devices == -1 || (used_devices != 1 && LongToSize(used_devices) != total_device_num)) {
+      MS_LOG(INFO) << "The strategy of " << operator_info->name()
+                   << " in the strategy database does not fully use the devices, search it.";
+      operator_info->ClearStrategyCost();
+      return false;
+    }
+  }
+  (void)configured_stra_ops_.emplace(operator_info, strategy);
+  MS_LOG(INFO) << "Reuse the strategy of " << operator_info->name() << " in the strategy database by the "
+               << (*exact ? "exact" : "partial") << " signature.";
+  return true;
+}
+
 void InitCostGraph() {
   if (entire_costgraph == nullptr) {
     entire_costgraph = std::make_shared<CostGraph>();
@@ -288,8 +383,47 @@ void SetStrategyToOperator(const OperatorInfoPtr &operator_info, const Primitive
   (void)configured_stra_ops_.emplace(operator_info, strategyPtr);
 }
 
+// Steps after the candidate strategies of an operator are generated, they follow the order of the operators.
+static void PostprocessGeneratedStrategies(const OperatorInfoPtr &operator_info) {
+  if ((ParallelContext::GetInstance()->strategy_search_mode() == SHARDING_PROPAGATION) &&
+      (operator_info->name().find(VIRTUAL_DATA_SET_INFO) != std::string::npos)) {
+    const auto &swc_vec = operator_info->GetStrategyCost();
+    if (swc_vec.empty()) {
+      MS_LOG(EXCEPTION) << "No available strategy for: " << operator_info->name();
+    }
+    MS_EXCEPTION_IF_NULL(swc_vec[0]->strategy_ptr);
+    (void)configured_stra_ops_.emplace(operator_info, swc_vec[0]->strategy_ptr);
+  }
+  // If 'approximation' is enabled, the 'strategy_cost' of each operator is approximated
+  auto approximation = CostModelContext::GetInstance()->dp_algo_enable_approxi();
+  if (approximation) {
+    operator_info->ApproximateStrategies();
+    MS_LOG(INFO) << "Approximated StrategyCost for: " << operator_info->name();
+  }
+}
+
+// Enumerating the strategies of an operator and their costs only touches the OperatorInfo itself, so the operators
+// collected while creating the nodes are enumerated in parallel.
+static Status GenerateStrategiesForOperators(const std::vector<OperatorInfoPtr> &ops_to_search) {
+  std::vector<Status> rets(ops_to_search.size(), SUCCESS);
+  RunSearchTasks(ops_to_search.size(), [&ops_to_search, &rets](size_t index) {
+    rets[index] = ops_to_search[index]->GenerateStrategies(0);
+  });
+  for (size_t index = 0; index < ops_to_search.size(); ++index) {
+    const auto &operator_info = ops_to_search[index];
+    if (rets[index] != SUCCESS) {
+      MS_LOG(ERROR) << "Strategy search for Operator " << operator_info->name() << " failed.";
+      return FAILED;
+    }
+    PostprocessGeneratedStrategies(operator_info);
+  }
+  return SUCCESS;
+}
+
+// If the strategies of the created operator are to be searched, it is added to 'ops_to_search' and they are generated
+// by GenerateStrategiesForOperators later.
 OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode, bool is_last_nodes,
-                                      StrategyMap *stra_map) {
+                                      StrategyMap *stra_map, std::vector<OperatorInfoPtr> *ops_to_search) {
   MS_EXCEPTION_IF_NULL(prim);
   MS_EXCEPTION_IF_NULL(cnode);
   auto attrs = prim->attrs();
@@ -343,47 +477,49 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
   }
   bool load_strategy_from_ckpt =
     StrategyCheckpoint::GetInstance().LoadCheckPointOn() && stra_map->find(strategy_key_name) != stra_map->end();
+  bool database_on = StrategyDatabaseOn();
+  StrategySignature signature;
+  if (database_on) {
+    signature = GetStrategySignature(prim, cnode, shape_list[0], parameter_info);
+  }
+  auto record_signature = [&operator_info, &signature, database_on](StrategySource source) {
+    if (database_on) {
+      ops_signatures_.push_back({operator_info, signature, source});
+    }
+  };
   // If no strategy has been configured for this operator, then candidate strategies are generated for
   // auto-strategy searching; if this primitive is CAST, we ignore the user-specified strategy.
   // if strategy is set to load from checkpoint, it is prefer to load strategy from checkpoint .
   if ((StrategyFound(attrs) && prim->name() != CAST) || load_strategy_from_ckpt) {
     SetStrategyToOperator(operator_info, prim, attrs, is_last_nodes, stra_map, strategy_key_name);
+    record_signature(StrategySource::kConfigured);
     return operator_info;
   }
 
   // Compute split_flag_list_, indicating which input has batch dimension. This is ONLY used for preparation for
   // BatchParallelInfo operator
   operator_info->ComputeBatchSplitFlagList();
-  bool retGenStra;
   if (AttrFound(attrs, STRATEGY_GEN_MODE) && GetValue<std::string>(attrs[STRATEGY_GEN_MODE]) == DATA_PARALLEL) {
+    // Generating the batch parallel strategy writes the attrs of the primitive, which may be shared by operators.
     MS_LOG(INFO) << "generating batch parallel strategy...";
     StrategyPtr strategyPtr = parallel::GenerateBatchParallelStrategy(operator_info, prim);
-    retGenStra = operator_info->SetCostUnderStrategy(strategyPtr);
-  } else {
-    MS_LOG(INFO) << "auto-searching strategy...";
-    retGenStra = operator_info->GenerateStrategies(0);
-  }
-
-  if (retGenStra != SUCCESS) {
-    MS_LOG(ERROR) << "Strategy search for Operator " << operator_info->name() << " failed.";
-    return nullptr;
-  }
-
-  if ((ParallelContext::GetInstance()->strategy_search_mode() == SHARDING_PROPAGATION) &&
-      (operator_info->name().find(VIRTUAL_DATA_SET_INFO) != std::string::npos)) {
-    const auto &swc_vec = operator_info->GetStrategyCost();
-    if (swc_vec.empty()) {
-      MS_LOG(EXCEPTION) << "No available strategy for: " << operator_info->name();
+    if (operator_info->SetCostUnderStrategy(strategyPtr) != SUCCESS) {
+      MS_LOG(ERROR) << "Strategy search for Operator " << operator_info->name() << " failed.";
+      return nullptr;
     }
-    MS_EXCEPTION_IF_NULL(swc_vec[0]->strategy_ptr);
-    (void)configured_stra_ops_.emplace(operator_info, swc_vec[0]->strategy_ptr);
+    PostprocessGeneratedStrategies(operator_info);
+    record_signature(StrategySource::kConfigured);
+    return operator_info;
   }
-  // If 'approximation' is enabled, the 'strategy_cost' of each operator is approximated
-  auto approximation = CostModelContext::GetInstance()->dp_algo_enable_approxi();
-  if (approximation) {
-    operator_info->ApproximateStrategies();
-    MS_LOG(INFO) << "Approximated StrategyCost for: " << operator_info->name();
+
+  bool exact = false;
+  if (database_on && SetStrategyFromDatabase(operator_info, signature, &exact)) {
+    record_signature(exact ? StrategySource::kDatabaseExact : StrategySource::kDatabasePartial);
+    return operator_info;
   }
+  MS_LOG(INFO) << "auto-searching strategy...";
+  ops_to_search->push_back(operator_info);
+  record_signature(StrategySource::kSearched);
   return operator_info;
 }
 
@@ -406,6 +542,8 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
   std::vector<OperatorInfoPtr> operators_in_forloop;
   // Key: i-th loop; Value: index of 'operators_in_forloop'
   std::map<size_t, size_t> loop_to_ops;
+  // The operators whose strategies are to be searched
+  std::vector<OperatorInfoPtr> ops_to_search;
   // extract strategy from checkpoint for multi-train
   StrategyMap stra_map;
   if (StrategyCheckpoint::GetInstance().LoadCheckPointOn()) {
@@ -457,7 +595,7 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
         continue;
       }
       bool is_last_nodes = IsPrimitiveCNode(cnode, prim::kPrimVirtualOutput);
-      auto operator_info = CreateTheOperatorInfo(prim, cnode, is_last_nodes, &stra_map);
+      auto operator_info = CreateTheOperatorInfo(prim, cnode, is_last_nodes, &stra_map, &ops_to_search);
       if (operator_info == nullptr) {
         return FAILED;
       }
@@ -487,6 +625,9 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
                         << " is set OperatorInfo: " << search_cnode->second->name() << ", Primitive: " << prim->name();
     }
   }
+  if (GenerateStrategiesForOperators(ops_to_search) != SUCCESS) {
+    return FAILED;
+  }
 
   MS_LOG(INFO) << "Constructing nodes for cost graph ends.";
   return SUCCESS;
@@ -521,6 +662,8 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
   std::vector<OperatorInfoPtr> operators_in_forloop;
   // Key: i-th loop; Value: index of 'operators_in_forloop'
   std::map<size_t, size_t> loop_to_ops;
+  // The operators whose strategies are to be searched
+  std::vector<OperatorInfoPtr> ops_to_search;
   // extract strategy from checkpoint for multi-train
   StrategyMap stra_map;
   if (StrategyCheckpoint::GetInstance().LoadCheckPointOn() &&
@@ -572,7 +715,7 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
       }
       // In this case, the corresponding OperatorInfo is not created, create the new one.
       bool is_last_nodes = IsPrimitiveCNode(cnode, prim::kPrimVirtualOutput);
-      auto operator_info = CreateTheOperatorInfo(prim, cnode, is_last_nodes, &stra_map);
+      auto operator_info = CreateTheOperatorInfo(prim, cnode, is_last_nodes, &stra_map, &ops_to_search);
       MS_EXCEPTION_IF_NULL(operator_info);
 
       // Needed by rec_parser
@@ -598,6 +741,9 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
       SetOperatorToCNode(search_cnode->second, prim, cnode);
     }
   }
+  if (GenerateStrategiesForOperators(ops_to_search) != SUCCESS) {
+    return FAILED;
+  }
 
   MS_LOG(INFO) << "Constructing nodes for cost graph ends.";
   return SUCCESS;
@@ -927,6 +1073,50 @@ void ReshapeCostCompute(const std::vector<AnfNodePtr> &all_nodes) {
   }
 }
 
+// Returns the microseconds since 'start_time' and resets it to now.
+static uint64_t GetPhaseTime(struct timeval *start_time) {
+  struct timeval end_time {
+    0
+  };
+  (void)gettimeofday(&end_time, nullptr);
+  uint64_t time = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time->tv_sec);
+  time += static_cast<uint64_t>(end_time.tv_usec - start_time->tv_usec);
+  *start_time = end_time;
+  return time;
+}
+
+// Put the selected strategies into the strategy database, and report the time saved by the reused ones. The time per
+// searched operator is only recorded by the searches reusing no strategy, whose time is all spent on searched ones.
+static void UpdateStrategyDatabase(uint64_t search_time) {
+  auto &database = StrategyDatabase::GetInstance();
+  size_t exact_num = 0;
+  size_t partial_num = 0;
+  size_t searched_num = 0;
+  for (auto &item : ops_signatures_) {
+    exact_num += (item.source == StrategySource::kDatabaseExact) ? 1 : 0;
+    partial_num += (item.source == StrategySource::kDatabasePartial) ? 1 : 0;
+    searched_num += (item.source == StrategySource::kSearched) ? 1 : 0;
+    auto strategy = item.operator_info->selected_strategy();
+    if (strategy != nullptr) {
+      database.Insert(item.signature, strategy);
+    }
+  }
+  size_t reused_num = exact_num + partial_num;
+  MS_LOG(INFO) << "The strategy database gave the strategies of " << reused_num << " of " << ops_signatures_.size()
+               << " operators, " << exact_num << " by the exact signatures and " << partial_num
+               << " by the partial ones. " << searched_num << " operators are searched in " << search_time << " us.";
+  auto time_per_op = database.TimePerSearchedOperator();
+  if (reused_num > 0 && time_per_op > 0) {
+    MS_LOG(INFO) << "The reused strategies saved about " << time_per_op * static_cast<double>(reused_num)
+                 << " us of the search, by " << time_per_op << " us per searched operator in the database.";
+  }
+  if (reused_num == 0 && searched_num > 0) {
+    database.RecordSearchTime(searched_num, search_time);
+  }
+  (void)database.Save(CostModelContext::GetInstance()->dp_algo_strategy_db_path());
+  ops_signatures_.clear();
+}
+
 Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root) {
   // There are 4 meta-steps to determine the parallelization strategy for the ANF graph.
   // Step 1: Traverse the ANF graph, and create NODEs for costgraph:
@@ -951,6 +1141,28 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //      components in the costgraph, and the DP algorithm runs on each of them.
   //
   // OUTPUT: the determined strategy for each operator.
+  //
+  // The strategies and costs of the operators, the edges and the eliminated subgraphs are enumerated on
+  // 'dp_algo_search_threads' threads, and the redistribution costs are memoized, see RedistributionCostCache.
+  // If 'dp_algo_strategy_db_path' is set, the operators of the same or similar signatures as the operators searched
+  // before take their strategies from the database instead of enumerating them in Step 1, see StrategyDatabase.
+
+  struct timeval phase_start {
+    0
+  };
+  (void)gettimeofday(&phase_start, nullptr);
+  auto &cost_cache = RedistributionCostCache::GetInstance();
+  const auto &cost_cache_path = CostModelContext::GetInstance()->dp_algo_cost_cache_path();
+  if (!cost_cache_path.empty()) {
+    (void)cost_cache.Load(cost_cache_path);
+  }
+  cost_cache.ResetCount();
+  ops_signatures_.clear();
+  if (StrategyDatabaseOn()) {
+    (void)StrategyDatabase::GetInstance().Load(CostModelContext::GetInstance()->dp_algo_strategy_db_path());
+    StrategyDatabase::GetInstance().ResetCount();
+  }
+  auto load_time = GetPhaseTime(&phase_start);
 
   InitCostGraph();
   // Step 1
@@ -969,15 +1181,19 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
       MS_LOG(EXCEPTION) << "Constructing nodes for cost graph failed.";
     }
   }
+  auto node_time = GetPhaseTime(&phase_start);
   // Step 1.1
   ReshapeCostCompute(all_nodes);
+  auto reshape_time = GetPhaseTime(&phase_start);
   // Step 2
   ConstructCostGraphEdges(all_nodes);
+  auto edge_time = GetPhaseTime(&phase_start);
   MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
                << " operators, and " << entire_costgraph->GetNumEdges() << " edges.";
 
   // Step 3: Augment the costgraph.
   AugmentCostGraph(all_nodes);
+  auto augment_time = GetPhaseTime(&phase_start);
   auto num_ops = entire_costgraph->GetOperators().size();
   SetOpsNumToExecutor(num_ops);
   auto num_edges = entire_costgraph->GetNumEdges();
@@ -988,6 +1204,7 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   if (entire_costgraph->CalculateMemoryCost() != SUCCESS) {
     MS_LOG(EXCEPTION) << "Calculating memory cost failed.";
   }
+  auto memory_time = GetPhaseTime(&phase_start);
 
   // Step 4: run the strategy searching algorithm
   if ((ParallelContext::GetInstance()->strategy_search_mode() == SHARDING_PROPAGATION)) {
@@ -998,12 +1215,27 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
     return FAILED;
   }
   MS_LOG(INFO) << "Searching strategy succeeded.";
+  auto search_time = GetPhaseTime(&phase_start);
+
+  if (!cost_cache_path.empty()) {
+    (void)cost_cache.Save(cost_cache_path);
+  }
+  MS_LOG(INFO) << "Time of the strategy search phases, loading the cost cache: " << load_time
+               << " us, creating the nodes: " << node_time << " us, reshape: " << reshape_time
+               << " us, creating the edges: " << edge_time << " us, augmenting: " << augment_time
+               << " us, memory cost: " << memory_time << " us, searching: " << search_time
+               << " us, saving the cost cache: " << GetPhaseTime(&phase_start) << " us.";
+  MS_LOG(INFO) << "The redistribution cost cache has " << cost_cache.size() << " costs, " << cost_cache.hit_count()
+               << " hits and " << cost_cache.miss_count() << " misses in this search.";
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
   } else {
     MS_LOG(EXCEPTION) << "Init selected strategy failed.";
   }
+  if (StrategyDatabaseOn()) {
+    UpdateStrategyDatabase(node_time + reshape_time + edge_time + augment_time + memory_time + search_time);
+  }
 
   // print the selected strategy
   for (auto &op : entire_costgraph->GetOperators()) {
@@ -32,6 +32,7 @@
 #include "frontend/optimizer/optimizer.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "frontend/parallel/context.h"
+#include "frontend/parallel/costmodel_context.h"
 #include "frontend/parallel/device_manager.h"
 #include "frontend/parallel/dynamic_creator.h"
 #include "frontend/parallel/graph_util/generate_graph.h"
@@ -60,6 +61,8 @@ namespace parallel {
 static const std::set<std::string> COMMUNICATION_OPS = {ALL_REDUCE, ALL_GATHER, ALL_TO_ALL, REDUCE_SCATTER};
 static const std::set<std::string> INVALID_LOSS_OPS = {GET_NEXT, VIRTUALLOSS, LOAD, UPDATESTATE};
 static const std::set<std::string> NO_INPUT_TENSOR_OPS = {UNIFORM_REAL};
+// The fusion ids of the AllGathers of sibling redistributions, which are far from the comm_fusion of the parameters.
+static const int64_t REDISTRIBUTION_FUSION_START = 10000;
 // g_RefMap, for CNode B input i is a RefKey[Parameter C],
 // it will be one item in map with key: C, and value: (B, i)
 std::map<AnfNodePtr, std::pair<AnfNodePtr, int64_t>> g_RefMap;
@@ -482,6 +485,11 @@ void Redistribution(const std::pair<AnfNodePtr, int64_t> &node_pair, const Opera
   }
   MS_LOG(DEBUG) << "Redistribution size " << redistribution_oplist_ptr->first.size();
   if (!redistribution_oplist_ptr->first.empty()) {
+    if (CostModelContext::GetInstance()->dp_algo_redistribution_search()) {
+      MS_LOG(INFO) << "Redistribution from " << middle_node->fullname_with_scope() << " to "
+                   << next_node->fullname_with_scope() << ": comm cost " << tensor_redistribution.default_comm_cost()
+                   << " by construction, " << tensor_redistribution.searched_comm_cost() << " after search";
+    }
     // insert node before next node
     InsertRedistribution(redistribution_oplist_ptr, next_node, func_graph, node_pair.second, pre_node);
   }
@@ -597,6 +605,80 @@ void StepRedistribution(const CNodePtr &node, const OperatorInfoPtr &distribute_
   }
 }
 
+// Collect the AllGathers of the redistribution operators inserted before the input in the order they run, and return
+// the node the redistribution starts from.
+static AnfNodePtr GetRedistributionAllGathers(const AnfNodePtr &input, std::vector<CNodePtr> *const all_gathers) {
+  MS_EXCEPTION_IF_NULL(all_gathers);
+  auto is_redistribution_op = [](const AnfNodePtr &node) {
+    auto prim = GetCNodePrimitive(node);
+    return prim != nullptr && prim->instance_name().find(REDISTRIBUTION_OP) == 0;
+  };
+  AnfNodePtr node = input;
+  while (is_redistribution_op(node)) {
+    auto cnode = node->cast<CNodePtr>();
+    if (IsPrimitiveCNode(cnode, prim::kPrimAllGather)) {
+      all_gathers->push_back(cnode);
+    }
+    node = cnode->input(1);
+    // The Concat takes the outputs of the Split before it by a MakeTuple of TupleGetItems.
+    if (IsPrimitiveCNode(cnode, prim::kPrimConcat) && IsPrimitiveCNode(node, prim::kPrimMakeTuple)) {
+      auto tuple_get_item = node->cast<CNodePtr>()->input(1);
+      if (IsPrimitiveCNode(tuple_get_item, prim::kPrimTupleGetItem)) {
+        node = tuple_get_item->cast<CNodePtr>()->input(1);
+      }
+    }
+  }
+  std::reverse(all_gathers->begin(), all_gathers->end());
+  return node;
+}
+
+// The redistributions of the inputs of an operator from different nodes are independent, so their i-th AllGathers are
+// given the same fusion id and merged into one AllGather by the backend, which does the same for their ReduceScatters
+// in the backward.
+static void FuseSiblingRedistributions(const std::vector<AnfNodePtr> &all_nodes) {
+  int64_t fusion = REDISTRIBUTION_FUSION_START;
+  size_t fused_num = 0;
+  size_t fusion_num = 0;
+  for (auto &node : all_nodes) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || !IsParallelCareNode(cnode) || !cnode->has_user_data<OperatorInfo>()) {
+      continue;
+    }
+    std::set<AnfNodePtr> sources;
+    std::vector<std::vector<CNodePtr>> siblings;
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      std::vector<CNodePtr> all_gathers;
+      auto source = GetRedistributionAllGathers(cnode->input(i), &all_gathers);
+      // The same tensor may be redistributed twice for the operator, whose AllGathers can not share the input.
+      if (all_gathers.empty() || !sources.insert(source).second) {
+        continue;
+      }
+      siblings.push_back(all_gathers);
+    }
+    for (size_t step = 0;; ++step) {
+      std::vector<CNodePtr> all_gathers;
+      for (auto &sibling : siblings) {
+        if (step < sibling.size()) {
+          all_gathers.push_back(sibling[step]);
+        }
+      }
+      if (all_gathers.size() <= 1) {
+        break;
+      }
+      for (auto &all_gather : all_gathers) {
+        GetCNodePrimitive(all_gather)->set_attr(FUSION, MakeValue<int64_t>(fusion));
+      }
+      ++fusion;
+      ++fusion_num;
+      fused_num += all_gathers.size();
+    }
+  }
+  if (fusion_num > 0) {
+    MS_LOG(INFO) << "Fuse " << fused_num << " AllGathers of sibling redistributions into " << fusion_num
+                 << " AllGathers";
+  }
+}
+
 void SplitTensor(const AnfNodePtr &node, const CNodePtr &next_node, int64_t index) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(next_node);
@@ -2657,6 +2739,9 @@ void ParallelCommunication(const FuncGraphPtr &root, const std::vector<AnfNodePt
       StepSplitTensor(node, manager);
     }
   }
+  if (CostModelContext::GetInstance()->dp_algo_redistribution_search()) {
+    FuseSiblingRedistributions(all_nodes);
+  }
 
   for (auto &node : all_nodes) {
     MS_EXCEPTION_IF_NULL(node);
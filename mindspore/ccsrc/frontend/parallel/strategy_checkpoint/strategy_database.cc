@@ -0,0 +1,324 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/strategy_checkpoint/strategy_database.h"
+
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/file.h>
+#endif
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "debug/common.h"
+#include "frontend/parallel/context.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// The first line of the database file; bump it when the signature or the entry format changes.
+constexpr char kStrategyDatabaseHeader[] = "# parallel strategy database v2";
+// The second line, followed by the number of searched operators and the time in us the search took for them.
+constexpr char kSearchTimePrefix[] = "# search time ";
+constexpr char kStrategyDatabaseSeparator = '\t';
+constexpr char kBatchDim[] = "*";
+// The suffix of the file locked by the jobs saving the database.
+constexpr char kLockFileSuffix[] = ".lock";
+
+// An exclusive lock of a file beside the database, so that the jobs saving it at the same time merge their strategies
+// one after another instead of overwriting each other.
+class DatabaseFileLock {
+ public:
+  explicit DatabaseFileLock(const std::string &path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT, 0666);
+    if (fd_ >= 0 && flock(fd_, LOCK_EX) != 0) {
+      (void)close(fd_);
+      fd_ = -1;
+    }
+#else
+    MS_LOG(DEBUG) << "The strategy database: " << path << " is not locked on windows.";
+    fd_ = 0;
+#endif
+  }
+  ~DatabaseFileLock() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (fd_ >= 0) {
+      (void)flock(fd_, LOCK_UN);
+      (void)close(fd_);
+    }
+#endif
+  }
+  bool locked() const { return fd_ >= 0; }
+
+ private:
+  int fd_ = -1;
+};
+
+std::string ShapeToSignature(const Shape &shape, bool batch_free) {
+  std::ostringstream buffer;
+  buffer << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (i > 0) {
+      buffer << ",";
+    }
+    if (i == 0 && batch_free) {
+      buffer << kBatchDim;
+    } else {
+      buffer << shape[i];
+    }
+  }
+  buffer << "]";
+  return buffer.str();
+}
+
+// An entry is the stage, the number of inputs, then the number of dimensions and the dimensions of each input.
+std::string StrategyToEntry(const StrategyPtr &strategy) {
+  std::ostringstream buffer;
+  auto inputs = strategy->GetInputDim();
+  buffer << strategy->GetInputStage() << ' ' << inputs.size();
+  for (auto &dims : inputs) {
+    buffer << ' ' << dims.size();
+    for (auto dim : dims) {
+      buffer << ' ' << dim;
+    }
+  }
+  return buffer.str();
+}
+
+StrategyPtr EntryToStrategy(const std::string &entry) {
+  std::istringstream values(entry);
+  int64_t stage = 0;
+  size_t input_num = 0;
+  if (!(values >> stage >> input_num)) {
+    return nullptr;
+  }
+  Strategys inputs(input_num);
+  for (auto &dims : inputs) {
+    size_t dim_num = 0;
+    if (!(values >> dim_num)) {
+      return nullptr;
+    }
+    dims.resize(dim_num);
+    for (auto &dim : dims) {
+      if (!(values >> dim) || dim < MIN_SLICE_NUM) {
+        return nullptr;
+      }
+    }
+  }
+  return NewStrategy(stage, inputs);
+}
+}  // namespace
+
+StrategyDatabase &StrategyDatabase::GetInstance() {
+  static StrategyDatabase instance;
+  return instance;
+}
+
+StrategySignature StrategyDatabase::Signature(const std::string &prim_name, const std::string &prim_attrs,
+                                              const std::vector<std::string> &input_prims, const Shapes &input_shapes,
+                                              const std::vector<bool> &is_parameter, size_t dev_num) {
+  std::string prims = prim_name + "[" + prim_attrs + "](";
+  for (size_t i = 0; i < input_prims.size(); ++i) {
+    prims += (i > 0 ? "," : "") + input_prims[i];
+  }
+  prims += ")";
+  // The signature is one line of the database file.
+  std::replace(prims.begin(), prims.end(), '\n', ';');
+  std::replace(prims.begin(), prims.end(), kStrategyDatabaseSeparator, ' ');
+  std::string exact_shapes;
+  std::string partial_shapes;
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    bool batch_free = i >= is_parameter.size() || !is_parameter[i];
+    exact_shapes += ShapeToSignature(input_shapes[i], false);
+    partial_shapes += ShapeToSignature(input_shapes[i], batch_free);
+  }
+  auto cost_model_context = CostModelContext::GetInstance();
+  std::string devices = " | " + std::to_string(dev_num) + " | " +
+                        std::to_string(ParallelContext::GetInstance()->enable_all2all()) + " | " +
+                        std::to_string(cost_model_context->dp_algo_redistribution_search()) + " | " +
+                        std::to_string(cost_model_context->elementwise_stra_follow());
+  return {prims + " | " + exact_shapes + devices, prims + " | " + partial_shapes + devices};
+}
+
+StrategyPtr StrategyDatabase::Find(const StrategySignature &signature, bool *exact) {
+  MS_EXCEPTION_IF_NULL(exact);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = strategies_.find(signature.exact);
+  if (iter != strategies_.end()) {
+    ++exact_hit_count_;
+    *exact = true;
+    return iter->second;
+  }
+  iter = strategies_.find(signature.partial);
+  if (iter != strategies_.end()) {
+    ++partial_hit_count_;
+    *exact = false;
+    return iter->second;
+  }
+  ++miss_count_;
+  return nullptr;
+}
+
+void StrategyDatabase::Insert(const StrategySignature &signature, const StrategyPtr &strategy) {
+  MS_EXCEPTION_IF_NULL(strategy);
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The latest strategy of a signature replaces the earlier one.
+  strategies_[signature.exact] = strategy;
+  strategies_[signature.partial] = strategy;
+}
+
+void StrategyDatabase::RecordSearchTime(size_t searched_ops, uint64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  searched_ops_ += searched_ops;
+  search_time_ += time;
+  unsaved_searched_ops_ += searched_ops;
+  unsaved_search_time_ += time;
+}
+
+double StrategyDatabase::TimePerSearchedOperator() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (searched_ops_ == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(search_time_) / static_cast<double>(searched_ops_);
+}
+
+Status StrategyDatabase::Load(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path == loaded_path_) {
+    // The strategies loaded before are still in the database.
+    return SUCCESS;
+  }
+  loaded_path_ = path;
+  return LoadUnlocked(path);
+}
+
+Status StrategyDatabase::LoadUnlocked(const std::string &path) {
+  std::ifstream fin(path);
+  if (!fin) {
+    MS_LOG(INFO) << "The strategy database: " << path << " does not exist, starting with an empty database.";
+    return SUCCESS;
+  }
+  std::string line;
+  if (!std::getline(fin, line) || line != kStrategyDatabaseHeader) {
+    MS_LOG(WARNING) << "The strategy database: " << path << " is written by another version, ignore it.";
+    return FAILED;
+  }
+  size_t searched_ops = 0;
+  uint64_t search_time = 0;
+  std::string prefix = kSearchTimePrefix;
+  bool has_search_time = std::getline(fin, line) && line.compare(0, prefix.size(), prefix) == 0;
+  std::istringstream search_time_values(has_search_time ? line.substr(prefix.size()) : "");
+  if (!has_search_time || !(search_time_values >> searched_ops >> search_time)) {
+    MS_LOG(WARNING) << "The strategy database: " << path << " is broken at the search time, ignore it.";
+    return FAILED;
+  }
+  searched_ops_ += searched_ops;
+  search_time_ += search_time;
+  size_t loaded = 0;
+  while (std::getline(fin, line)) {
+    auto pos = line.rfind(kStrategyDatabaseSeparator);
+    auto strategy = (pos == std::string::npos) ? nullptr : EntryToStrategy(line.substr(pos + 1));
+    if (strategy == nullptr) {
+      MS_LOG(WARNING) << "The strategy database: " << path << " is broken at entry " << loaded
+                      << ", ignore the rest of it.";
+      return FAILED;
+    }
+    // The strategies found in this process are newer than the ones in the file.
+    (void)strategies_.emplace(line.substr(0, pos), strategy);
+    ++loaded;
+  }
+  MS_LOG(INFO) << "Loaded " << loaded << " strategies from: " << path << ".";
+  return SUCCESS;
+}
+
+Status StrategyDatabase::Save(const std::string &path) {
+  auto realpath = Common::CreatePrefixPath(path);
+  if (!realpath.has_value()) {
+    MS_LOG(WARNING) << "Get real path failed, path=" << path;
+    return FAILED;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The lock is held until the file is renamed, so no job saves between the merge and the rename.
+  DatabaseFileLock file_lock(realpath.value() + kLockFileSuffix);
+  if (!file_lock.locked()) {
+    MS_LOG(WARNING) << "Lock the strategy database: " << realpath.value() << kLockFileSuffix << " failed.";
+    return FAILED;
+  }
+  // Merge the strategies and the search time saved by other jobs since the file was loaded, then add the search time
+  // recorded in this process.
+  searched_ops_ = 0;
+  search_time_ = 0;
+  (void)LoadUnlocked(realpath.value());
+  searched_ops_ += unsaved_searched_ops_;
+  search_time_ += unsaved_search_time_;
+  // Write to a temporary file and rename it, so that a concurrent job never reads a partial database.
+  auto tmp_path = realpath.value() + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream fout(tmp_path, std::ios::out | std::ios::trunc);
+    if (!fout) {
+      MS_LOG(WARNING) << "Open the strategy database: " << tmp_path << " failed.";
+      return FAILED;
+    }
+    fout << kStrategyDatabaseHeader << '\n';
+    fout << kSearchTimePrefix << searched_ops_ << ' ' << search_time_ << '\n';
+    for (auto &item : strategies_) {
+      fout << item.first << kStrategyDatabaseSeparator << StrategyToEntry(item.second) << '\n';
+    }
+    if (!fout) {
+      MS_LOG(WARNING) << "Write the strategy database: " << tmp_path << " failed.";
+      (void)std::remove(tmp_path.c_str());
+      return FAILED;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), realpath.value().c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename the strategy database: " << tmp_path << " to " << realpath.value() << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return FAILED;
+  }
+  unsaved_searched_ops_ = 0;
+  unsaved_search_time_ = 0;
+  MS_LOG(INFO) << "Saved " << strategies_.size() << " strategies to: " << realpath.value() << ".";
+  return SUCCESS;
+}
+
+void StrategyDatabase::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  strategies_.clear();
+  searched_ops_ = 0;
+  search_time_ = 0;
+  unsaved_searched_ops_ = 0;
+  unsaved_search_time_ = 0;
+  loaded_path_.clear();
+}
+
+size_t StrategyDatabase::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return strategies_.size();
+}
+
+void StrategyDatabase::ResetCount() {
+  exact_hit_count_ = 0;
+  partial_hit_count_ = 0;
+  miss_count_ = 0;
+}
+}  // namespace parallel
+}  // namespace mindspore
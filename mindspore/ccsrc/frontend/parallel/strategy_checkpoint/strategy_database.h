@@ -0,0 +1,90 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_STRATEGY_CHEKCPOINT_STRATEGY_DATABASE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_STRATEGY_CHEKCPOINT_STRATEGY_DATABASE_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "frontend/parallel/status.h"
+#include "frontend/parallel/strategy.h"
+#include "frontend/parallel/tensor_layout/tensor_info.h"
+
+namespace mindspore {
+namespace parallel {
+// The signatures of an operator in the strategy database. The exact one is made of the primitive and its attributes,
+// the primitives or the constants producing its inputs, the input shapes, the number of devices of the stage, and the
+// AllToAll, redistribution search and elementwise strategy follow options the search depends on. The partial one
+// replaces the first dimension of the inputs which are not parameters by '*', so that it is shared by the networks
+// differing in the batch size. Both are local to the operator, so they are also shared by the networks differing in
+// the depth.
+struct StrategySignature {
+  std::string exact;
+  std::string partial;
+};
+
+// The strategies searched for the operators, kept by their signatures. It is consulted before the strategies of an
+// operator are enumerated: an exact match is reused as is, a partial match is reused if it is valid for the shapes.
+// Loading and saving the database shares the strategies across jobs, and it also records the time the search takes
+// per searched operator to estimate the time saved by the reused strategies.
+class StrategyDatabase {
+ public:
+  static StrategyDatabase &GetInstance();
+  static StrategySignature Signature(const std::string &prim_name, const std::string &prim_attrs,
+                                     const std::vector<std::string> &input_prims, const Shapes &input_shapes,
+                                     const std::vector<bool> &is_parameter, size_t dev_num);
+  // Returns nullptr if neither the exact nor the partial signature is found.
+  StrategyPtr Find(const StrategySignature &signature, bool *exact);
+  void Insert(const StrategySignature &signature, const StrategyPtr &strategy);
+  void RecordSearchTime(size_t searched_ops, uint64_t time);
+  // The average time in us the search takes per searched operator, 0 if unknown.
+  double TimePerSearchedOperator();
+  // A missing file is an empty database, a file written by another version is ignored. Loading the same file again
+  // does nothing.
+  Status Load(const std::string &path);
+  // The strategies and the search time the file gained from other jobs since it was loaded are kept. The jobs saving
+  // the same file lock the file path + ".lock" in turn.
+  Status Save(const std::string &path);
+  void Clear();
+  size_t size();
+  size_t exact_hit_count() const { return exact_hit_count_; }
+  size_t partial_hit_count() const { return partial_hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+  void ResetCount();
+
+ private:
+  StrategyDatabase() = default;
+  ~StrategyDatabase() = default;
+  Status LoadUnlocked(const std::string &path);
+  std::mutex mutex_;
+  std::unordered_map<std::string, StrategyPtr> strategies_;
+  // The search time in the file and recorded in this process, and the part of it not saved to the file yet.
+  size_t searched_ops_ = 0;
+  uint64_t search_time_ = 0;
+  size_t unsaved_searched_ops_ = 0;
+  uint64_t unsaved_search_time_ = 0;
+  // The file loaded last, which is not loaded again.
+  std::string loaded_path_;
+  std::atomic<size_t> exact_hit_count_{0};
+  std::atomic<size_t> partial_hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_STRATEGY_CHEKCPOINT_STRATEGY_DATABASE_H_
@@ -57,7 +57,21 @@ Status RedistributionOperatorInfer::Init(const TensorLayout &tensor_layout, cons
   return Status::SUCCESS;
 }
 
+RedistributionOption RedistributionOperatorInfer::DefaultOption() {
+  RedistributionOption option;
+  option.use_all2all = ParallelContext::GetInstance()->enable_all2all();
+  return option;
+}
+
 Status RedistributionOperatorInfer::InferRedistributionOperator() {
+  return InferRedistributionOperator(DefaultOption());
+}
+
+Status RedistributionOperatorInfer::InferRedistributionOperator(const RedistributionOption &option) {
+  option_ = option;
+  if (option_.concat_first && InferConcatFirst() == Status::FAILED) {
+    return Status::FAILED;
+  }
   while (!map_.empty()) {
     size_t len_global = operator_list_.size();
 
@@ -83,7 +97,7 @@ Status RedistributionOperatorInfer::InferRedistributionOperator() {
     }
     // break loop structure with concat_by_axis
     if (len_global == operator_list_.size() && !map_.empty()) {
-      size_t index = map_.begin()->first;
+      size_t index = ChooseConcatIndex();
       int64_t in_dim = map_[index];
       map_[index] = NONE;
       Args args = {SizeToLong(index), in_dim, dev_mat_.GetDimByReverseIdx(LongToSize(in_dim))};
@@ -134,7 +148,7 @@ Status RedistributionOperatorInfer::InferPermuteByAxis() {
                     [out_dim](const RedistributionOperatorMap::value_type &a) { return a.second == out_dim; })) {
       int64_t cat_dim = in_tensor_map_.GetIndexByValue(out_dim);
       int64_t dev_num = dev_mat_.GetDimByReverseIdx(LongToSize(out_dim));
-      if (ParallelContext::GetInstance()->enable_all2all()) {
+      if (option_.use_all2all) {
         int64_t dev_dim = in_tensor_map_.GetDimByIdx(LongToUlong(cat_dim));
         Args args_alltoall = {dev_mat_.GetDimByReverseIdx(LongToUlong(dev_dim)), UlongToLong(index), cat_dim, dev_dim,
                               dev_num};
@@ -187,6 +201,50 @@ Status RedistributionOperatorInfer::InferConcatByAxis() {
   return Status::SUCCESS;
 }
 
+Status RedistributionOperatorInfer::InferConcatFirst() {
+  for (auto iter = map_.begin(); iter != map_.end();) {
+    uint64_t index = iter->first;
+    int64_t in_dim = iter->second;
+    int64_t out_dim = out_tensor_map_.GetDimByIdx(index);
+    if (in_dim == out_dim) {
+      iter = map_.erase(iter);
+      continue;
+    }
+    if (in_dim != NONE) {
+      Args args = {SizeToLong(index), in_dim, dev_mat_.GetDimByReverseIdx(LongToSize(in_dim))};
+      if (InsertOperator(CONCAT_BY_AXIS, args) == Status::FAILED) {
+        MS_LOG(ERROR) << "Insert ConcatByAxis Error!";
+        return Status::FAILED;
+      }
+      iter->second = NONE;
+    }
+    (void)++iter;
+  }
+  return Status::SUCCESS;
+}
+
+size_t RedistributionOperatorInfer::ChooseConcatIndex() const {
+  size_t chosen = map_.begin()->first;
+  if (option_.concat_choice == ConcatChoice::kFirst) {
+    return chosen;
+  }
+  int64_t chosen_dev_num = -1;
+  for (auto &item : map_) {
+    if (item.second == NONE) {
+      continue;
+    }
+    int64_t dev_num = dev_mat_.GetDimByReverseIdx(LongToSize(item.second));
+    bool better = (option_.concat_choice == ConcatChoice::kFewestSlices) ? (dev_num < chosen_dev_num)
+                                                                          : (dev_num > chosen_dev_num);
+    // The smaller index is chosen between the same numbers of slices, which does not depend on the order of the map.
+    if (chosen_dev_num == -1 || better || (dev_num == chosen_dev_num && item.first < chosen)) {
+      chosen = item.first;
+      chosen_dev_num = dev_num;
+    }
+  }
+  return chosen;
+}
+
 // Transfer communicative operators into primitives and insert them into vector
 Status RedistributionOperatorInfer::InsertOperator(const OperatorName &name, const Args &args) {
   OperatorR op = std::make_pair(name, args);
@@ -36,6 +36,25 @@ using OperatorR = std::pair<OperatorName, Args>;
 using OperatorC = std::pair<OperatorR, Shape>;
 using OperatorList = std::vector<OperatorC>;
 
+// The tensor dimension to concat when no dimension can be split or permuted.
+enum class ConcatChoice {
+  // The first one found in the map.
+  kFirst,
+  // The one split into the fewest slices, so the later operators work on smaller slices.
+  kFewestSlices,
+  // The one split into the most slices.
+  kMostSlices,
+};
+
+// The choices which lead to different but equivalent operator lists of a redistribution.
+struct RedistributionOption {
+  // Permute a tensor dimension by AlltoAll, or by AllGather and Split.
+  bool use_all2all = false;
+  // Concat all the tensor dimensions split on other device dimensions at first, then only splits are needed.
+  bool concat_first = false;
+  ConcatChoice concat_choice = ConcatChoice::kFirst;
+};
+
 class RedistributionOperatorInfer {
  public:
   const int64_t NONE = -1;
@@ -47,9 +66,14 @@ class RedistributionOperatorInfer {
   OperatorList operator_list() const { return operator_list_; }
   OperatorVector operator_vector() const { return operator_vector_; }
   OutPutInfoVector output_info_vector() const { return output_info_vector_; }
+  // Infer the operators by the default option, which permutes by AlltoAll if enable_all2all is set.
   Status InferRedistributionOperator();
+  Status InferRedistributionOperator(const RedistributionOption &option);
+  static RedistributionOption DefaultOption();
 
  private:
+  Status InferConcatFirst();
+  size_t ChooseConcatIndex() const;
   Status InferSplitByAxis();
   Status InferPermuteByAxis();
   Status InferConcatByAxis();
@@ -68,6 +92,7 @@ class RedistributionOperatorInfer {
   TensorLayout cur_tensor_layout_;
   ConstructOperator constructor_;
   RankList dev_list_;
+  RedistributionOption option_;
   bool construct_op_flag_;
   bool is_cost_model_;
 };
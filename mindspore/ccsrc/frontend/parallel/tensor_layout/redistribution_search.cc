@@ -0,0 +1,166 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/tensor_layout/redistribution_search.h"
+#include <functional>
+#include <numeric>
+#include "frontend/parallel/context.h"
+#include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+// A candidate replaces the chosen one only if its cost is lower by this ratio, so the default one is kept for a tie.
+constexpr double kCostTolerance = 1e-9;
+
+bool SameOption(const RedistributionOption &a, const RedistributionOption &b) {
+  return a.use_all2all == b.use_all2all && a.concat_first == b.concat_first && a.concat_choice == b.concat_choice;
+}
+
+bool ValidDim(int64_t dim, const Shape &slice_shape) { return dim >= 0 && LongToSize(dim) < slice_shape.size(); }
+}  // namespace
+
+double RedistributionCommCost(const OperatorList &operator_list, const Shape &slice_shape) {
+  std::vector<double> shape(slice_shape.begin(), slice_shape.end());
+  double comm_cost = 0.0;
+  for (auto &op_cost : operator_list) {
+    const std::string &name = op_cost.first.first;
+    const Args &args = op_cost.first.second;
+    double input_size = std::accumulate(shape.begin(), shape.end(), 1.0, std::multiplies<double>());
+    if (name == PERMUTE_BY_AXIS && args.size() >= TRANSFER_PERMUTE_ARGS_SIZE) {
+      int64_t split_dim = args[TRANSFER_PERMUTE_SPLIT_DIM_INDEX];
+      int64_t concat_dim = args[TRANSFER_PERMUTE_CONCAT_DIM_INDEX];
+      auto split_count = static_cast<double>(args[TRANSFER_PERMUTE_SPLIT_COUNT_INDEX]);
+      comm_cost += COST_FACTOR * input_size * ALLTOALL_SCALE_FACTOR;
+      if (ValidDim(split_dim, slice_shape) && ValidDim(concat_dim, slice_shape)) {
+        shape[LongToSize(concat_dim)] *= split_count;
+        shape[LongToSize(split_dim)] /= split_count;
+      }
+    } else if (name == CONCAT_BY_AXIS && args.size() >= TRANSFER_CONCAT_ARGS_SIZE) {
+      int64_t tensor_dim = args[TRANSFER_CONCAT_TENSOR_DIM_INDEX];
+      auto dev_num = static_cast<double>(args[TRANSFER_CONCAT_SPLIT_COUNT_INDEX]);
+      comm_cost += input_size * (dev_num + 1.0) * ALLGATHER_REDUCESCATTER_SCALE_FACTOR;
+      if (ValidDim(tensor_dim, slice_shape)) {
+        shape[LongToSize(tensor_dim)] *= dev_num;
+      }
+    } else if (name == SPLIT_BY_AXIS && args.size() >= TRANSFER_SPLIT_ARGS_SIZE) {
+      int64_t split_dim = args[TRANSFER_PERMUTE_SPLIT_DIM_INDEX];
+      if (ValidDim(split_dim, slice_shape)) {
+        shape[LongToSize(split_dim)] /= static_cast<double>(args[TRANSFER_PERMUTE_SPLIT_COUNT_INDEX]);
+      }
+    }
+  }
+  return comm_cost;
+}
+
+RedistributionSearch &RedistributionSearch::GetInstance() {
+  static RedistributionSearch instance;
+  return instance;
+}
+
+std::vector<RedistributionOption> RedistributionSearch::Candidates() {
+  auto default_option = RedistributionOperatorInfer::DefaultOption();
+  std::vector<RedistributionOption> candidates = {default_option};
+  auto add_candidate = [&candidates, &default_option](const RedistributionOption &option) {
+    if (!SameOption(option, default_option)) {
+      candidates.push_back(option);
+    }
+  };
+  // AlltoAll is only tried if it is enabled, otherwise the permutes are always done by AllGather and Split.
+  std::vector<bool> use_all2all_list = {false};
+  if (default_option.use_all2all) {
+    use_all2all_list.push_back(true);
+  }
+  for (bool use_all2all : use_all2all_list) {
+    for (auto concat_choice : {ConcatChoice::kFirst, ConcatChoice::kFewestSlices, ConcatChoice::kMostSlices}) {
+      RedistributionOption option;
+      option.use_all2all = use_all2all;
+      option.concat_choice = concat_choice;
+      add_candidate(option);
+    }
+  }
+  // Nothing is permuted or left to concat after all the dimensions are concatenated.
+  RedistributionOption concat_first;
+  concat_first.concat_first = true;
+  add_candidate(concat_first);
+  return candidates;
+}
+
+Status RedistributionSearch::Search(const TensorLayout &from, const Map &to_tensor_map, const RankList &dev_list,
+                                    RedistributionPlan *const plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  std::string key = from.StandardToString() + "\nto tensor map = " + to_tensor_map.ToString() +
+                    "\nenable all2all = " + std::to_string(ParallelContext::GetInstance()->enable_all2all());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = plans_.find(key);
+    if (iter != plans_.end()) {
+      ++hit_num_;
+      *plan = iter->second;
+      return Status::SUCCESS;
+    }
+    ++miss_num_;
+  }
+
+  *plan = RedistributionPlan();
+  bool found = false;
+  bool default_found = false;
+  auto candidates = Candidates();
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    RedistributionOperatorInfer operator_infer(false);
+    if (operator_infer.Init(from, to_tensor_map, dev_list, true) != Status::SUCCESS ||
+        operator_infer.InferRedistributionOperator(candidates[i]) != Status::SUCCESS) {
+      MS_LOG(DEBUG) << "The redistribution candidate " << i << " failed.";
+      continue;
+    }
+    double comm_cost = RedistributionCommCost(operator_infer.operator_list(), from.slice_shape().array());
+    if (i == 0) {
+      default_found = true;
+      plan->default_comm_cost = comm_cost;
+    }
+    if (!found || comm_cost < plan->comm_cost * (1 - kCostTolerance)) {
+      found = true;
+      plan->option = candidates[i];
+      plan->comm_cost = comm_cost;
+    }
+  }
+  if (!found) {
+    MS_LOG(ERROR) << "No redistribution is found from the layout" << from.StandardToString() << "\nto the tensor map "
+                  << to_tensor_map.ToString();
+    return Status::FAILED;
+  }
+  // The chosen one is taken as the default if the default one failed.
+  if (!default_found) {
+    plan->default_comm_cost = plan->comm_cost;
+  }
+  MS_LOG(DEBUG) << "Search " << candidates.size() << " redistributions from the layout" << from.StandardToString()
+                << "\nto the tensor map " << to_tensor_map.ToString() << ", comm cost " << plan->default_comm_cost
+                << " by default and " << plan->comm_cost << " by the chosen one";
+  // The candidates are evaluated without the lock, so another thread may have cached the same plan meanwhile.
+  std::lock_guard<std::mutex> lock(mutex_);
+  plans_[key] = *plan;
+  return Status::SUCCESS;
+}
+
+void RedistributionSearch::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  plans_.clear();
+  hit_num_ = 0;
+  miss_num_ = 0;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_SEARCH_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_SEARCH_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/hash_map.h"
+#include "frontend/parallel/status.h"
+#include "frontend/parallel/tensor_layout/redistribution_operator_infer.h"
+#include "frontend/parallel/tensor_layout/tensor_layout.h"
+
+namespace mindspore {
+namespace parallel {
+struct RedistributionPlan {
+  RedistributionOption option;
+  // The communication cost of the operators by the default option, and by the chosen option.
+  double default_comm_cost = 0.0;
+  double comm_cost = 0.0;
+};
+
+// The communication cost of the operators of a redistribution, which starts from the slice shape. It follows the
+// formulas of TensorRedistribution::ComputeCost, with the slice shape updated by each operator.
+double RedistributionCommCost(const OperatorList &operator_list, const Shape &slice_shape);
+
+// Search the equivalent operator lists of a redistribution for the one of the least communication cost. The plans are
+// cached by the from layout, the to tensor map and the tensor shape, and whether AlltoAll is enabled. The
+// redistributions search it only if dp_algo_redistribution_search is set.
+class RedistributionSearch {
+ public:
+  static RedistributionSearch &GetInstance();
+  RedistributionSearch(const RedistributionSearch &) = delete;
+  RedistributionSearch &operator=(const RedistributionSearch &) = delete;
+
+  Status Search(const TensorLayout &from, const Map &to_tensor_map, const RankList &dev_list,
+                RedistributionPlan *const plan);
+  void Clear();
+  size_t hit_num() const { return hit_num_; }
+  size_t miss_num() const { return miss_num_; }
+
+ private:
+  RedistributionSearch() = default;
+  ~RedistributionSearch() = default;
+  static std::vector<RedistributionOption> Candidates();
+
+  std::mutex mutex_;
+  mindspore::HashMap<std::string, RedistributionPlan> plans_;
+  size_t hit_num_ = 0;
+  size_t miss_num_ = 0;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_TENSOR_LAYOUT_REDISTRIBUTION_SEARCH_H_
@@ -19,6 +19,8 @@
 #include <numeric>
 #include "utils/ms_utils.h"
 #include "frontend/parallel/status.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/tensor_layout/redistribution_search.h"
 #include "frontend/parallel/tensor_layout/shape_util.h"
 
 namespace mindspore {
@@ -34,6 +36,8 @@ Status TensorRedistribution::Init(const TensorLayout &from, const TensorLayout &
   }
 
   dev_list_ = dev_list;
+  default_comm_cost_ = 0.0;
+  searched_comm_cost_ = 0.0;
   from_ = from_origin_.SqueezeShape();
   to_ = to_origin_.SqueezeShape();
   return Status::SUCCESS;
@@ -177,12 +181,22 @@ Status TensorRedistribution::InferRedistribution(const TensorLayout &from_layout
                                                  OutPutInfoVector *const output_info_vector, bool is_cost_model) {
   MS_EXCEPTION_IF_NULL(operator_vector);
   MS_EXCEPTION_IF_NULL(output_info_vector);
+  RedistributionPlan plan;
+  plan.option = RedistributionOperatorInfer::DefaultOption();
+  if (CostModelContext::GetInstance()->dp_algo_redistribution_search() &&
+      RedistributionSearch::GetInstance().Search(from_layout, to_layout.tensor_map(), dev_list_, &plan) !=
+        Status::SUCCESS) {
+    MS_LOG(ERROR) << "Search redistribution failed";
+    return Status::FAILED;
+  }
+  default_comm_cost_ += plan.default_comm_cost;
+  searched_comm_cost_ += plan.comm_cost;
   RedistributionOperatorInfer operator_infer(construct_op_flag_);
   if (operator_infer.Init(from_layout, to_layout.tensor_map(), dev_list_, is_cost_model) == Status::FAILED) {
     MS_LOG(ERROR) << "Init operatorInfer failed";
     return Status::FAILED;
   }
-  if (operator_infer.InferRedistributionOperator() != Status::SUCCESS) {
+  if (operator_infer.InferRedistributionOperator(plan.option) != Status::SUCCESS) {
     MS_LOG(ERROR) << "Infer redistribution failed";
     return Status::FAILED;
   } else {
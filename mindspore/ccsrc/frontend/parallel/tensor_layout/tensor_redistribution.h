@@ -57,6 +57,9 @@ class TensorRedistribution {
   double forward_comm_cost() const { return forward_comm_cost_; }
   double backward_comm_cost() const { return backward_comm_cost_; }
   double memory_cost() const { return memory_cost_; }
+  // The communication cost of the operators chosen by construction and by the search, see RedistributionSearch.
+  double default_comm_cost() const { return default_comm_cost_; }
+  double searched_comm_cost() const { return searched_comm_cost_; }
 
  private:
   Status InferReshape(const TensorLayout &from_layout, const TensorLayout &to_layout,
@@ -86,6 +89,8 @@ class TensorRedistribution {
   // memory_cost models the PEAK memory cost in a training iteration contributed by this tensor redistribution, which is
   // calculated by the outputs.
   double memory_cost_;
+  double default_comm_cost_ = 0.0;
+  double searched_comm_cost_ = 0.0;
   bool construct_op_flag_;
   bool keep_reshape_;
   bool expand_able_ = true;
@@ -59,6 +59,8 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_shared_mem", &ConfigManager::enable_shared_mem)
                     .def("set_auto_offload", &ConfigManager::set_auto_offload)
                     .def("get_auto_offload", &ConfigManager::get_auto_offload)
+                    .def("set_jpeg_dct_scale", &ConfigManager::set_jpeg_dct_scale)
+                    .def("get_jpeg_dct_scale", &ConfigManager::get_jpeg_dct_scale)
                     .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
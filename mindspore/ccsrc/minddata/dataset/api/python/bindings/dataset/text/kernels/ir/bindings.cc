@@ -45,10 +45,10 @@ PYBIND_REGISTER(
       .def(py::init([](const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                        int32_t max_bytes_per_token, const std::string &unknown_token, bool lower_case,
                        bool keep_whitespace, const NormalizeForm normalize_form, bool preserve_unused_token,
-                       bool with_offsets) {
+                       bool with_offsets, bool with_ids) {
         auto bert_tokenizer = std::make_shared<text::BertTokenizerOperation>(
           vocab, suffix_indicator, max_bytes_per_token, unknown_token, lower_case, keep_whitespace, normalize_form,
-          preserve_unused_token, with_offsets);
+          preserve_unused_token, with_offsets, with_ids);
         THROW_IF_ERROR(bert_tokenizer->ValidateParams());
         return bert_tokenizer;
       }));
@@ -235,9 +235,10 @@ PYBIND_REGISTER(WordpieceTokenizerOperation, 1, ([](const py::module *m) {
                                    std::shared_ptr<text::WordpieceTokenizerOperation>>(*m,
                                                                                        "WordpieceTokenizerOperation")
                     .def(py::init([](const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
-                                     int32_t max_bytes_per_token, const std::string &unknown_token, bool with_offsets) {
+                                     int32_t max_bytes_per_token, const std::string &unknown_token, bool with_offsets,
+                                     bool with_ids) {
                       auto wordpiece_tokenizer = std::make_shared<text::WordpieceTokenizerOperation>(
-                        vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets);
+                        vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets, with_ids);
                       THROW_IF_ERROR(wordpiece_tokenizer->ValidateParams());
                       return wordpiece_tokenizer;
                     }));
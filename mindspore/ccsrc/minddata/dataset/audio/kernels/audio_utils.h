@@ -23,6 +23,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
@@ -206,93 +207,153 @@ Status DCShift(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
   return Status::OK();
 }
 
-/// \brief Perform an IIR filter by evaluating difference equation.
+/// \brief Number of waveforms filtered together, one per SIMD lane.
+constexpr size_t kLFilterLanes = 8;
+/// \brief Number of time steps transposed into the lane-interleaved buffer at once.
+constexpr size_t kLFilterTimeBlock = 256;
+
+/// \brief Run one IIR section over a block of lane-interleaved samples in place.
+///     The inner loops run over independent waveforms, so they have no loop-carried dependency and vectorize.
+/// \param block: Samples laid out as <time, kLFilterLanes>, replaced by the filtered samples.
+/// \param block_len: Number of time steps in the block.
+/// \param a_coeffs: Normalized denominator coefficients of size (order + 1).
+/// \param b_coeffs: Normalized numerator coefficients of size (order + 1).
+/// \param x_hist: Previous inputs laid out as <order, kLFilterLanes>, x[n-1] first.
+/// \param y_hist: Previous unclamped outputs laid out as <order, kLFilterLanes>, y[n-1] first.
+/// \param clamp: If True, clamp the output signal to be in the range [-1, 1].
+template <typename T>
+void LFilterSectionBlock(T *block, size_t block_len, const std::vector<T> &a_coeffs, const std::vector<T> &b_coeffs,
+                         T *x_hist, T *y_hist, bool clamp) {
+  const size_t order = a_coeffs.size() - 1;
+  T y[kLFilterLanes];
+  for (size_t t = 0; t < block_len; t++) {
+    T *x = block + t * kLFilterLanes;
+    for (size_t l = 0; l < kLFilterLanes; l++) {
+      y[l] = b_coeffs[0] * x[l];
+    }
+    for (size_t k = 1; k <= order; k++) {
+      const T *x_prev = x_hist + (k - 1) * kLFilterLanes;
+      for (size_t l = 0; l < kLFilterLanes; l++) {
+        y[l] += b_coeffs[k] * x_prev[l];
+      }
+    }
+    for (size_t k = 1; k <= order; k++) {
+      const T *y_prev = y_hist + (k - 1) * kLFilterLanes;
+      for (size_t l = 0; l < kLFilterLanes; l++) {
+        y[l] -= a_coeffs[k] * y_prev[l];
+      }
+    }
+    if (order > 0) {
+      for (size_t k = order - 1; k > 0; k--) {
+        std::copy(x_hist + (k - 1) * kLFilterLanes, x_hist + k * kLFilterLanes, x_hist + k * kLFilterLanes);
+        std::copy(y_hist + (k - 1) * kLFilterLanes, y_hist + k * kLFilterLanes, y_hist + k * kLFilterLanes);
+      }
+      std::copy(x, x + kLFilterLanes, x_hist);
+      std::copy(y, y + kLFilterLanes, y_hist);
+    }
+    for (size_t l = 0; l < kLFilterLanes; l++) {
+      if (clamp) {
+        x[l] = y[l] > static_cast<T>(1) ? static_cast<T>(1) : (y[l] < static_cast<T>(-1) ? static_cast<T>(-1) : y[l]);
+      } else {
+        x[l] = y[l];
+      }
+    }
+  }
+}
+
+/// \brief Perform a cascade of IIR filters by evaluating their difference equations in a single pass.
+///     Waveforms are processed kLFilterLanes at a time and every section is applied to a cache-resident block of
+///     samples before moving on, the result is the same as applying the sections one after another.
 /// \param input/output: Tensor of shape <..., time>
-/// \param a_coeffs: denominator coefficients of difference equation of dimension of (n_order + 1).
-/// \param b_coeffs: numerator coefficients of difference equation of dimension of (n_order + 1).
-/// \param clamp: If True, clamp the output signal to be in the range [-1, 1] (Default: True).
+/// \param a_coeffs: denominator coefficients of each section, each of dimension (n_order + 1).
+/// \param b_coeffs: numerator coefficients of each section, each of dimension (n_order + 1).
+/// \param clamp: If True, clamp the output signal of every section to be in the range [-1, 1].
 /// \return Status code
 template <typename T>
-Status LFilter(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<T> a_coeffs,
-               std::vector<T> b_coeffs, bool clamp) {
-  //  pack batch
+Status LFilterCascade(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                      std::vector<std::vector<T>> a_coeffs, std::vector<std::vector<T>> b_coeffs, bool clamp) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  CHECK_FAIL_RETURN_UNEXPECTED(!a_coeffs.empty() && a_coeffs.size() == b_coeffs.size(),
+                               "LFilter: the number of a_coeffs and b_coeffs sections should be equal and positive.");
   TensorShape input_shape = input->shape();
-  TensorShape toShape({input->Size() / input_shape[-1], input_shape[-1]});
-  input->Reshape(toShape);
-  auto shape_0 = input->shape()[0];
-  auto shape_1 = input->shape()[1];
-  std::vector<T> signal;
-  std::shared_ptr<Tensor> out;
-  std::vector<T> out_vect(shape_0 * shape_1);
-  size_t x_idx = 0;
-  size_t channel_idx = 1;
-  size_t m_num_order = b_coeffs.size() - 1;
-  size_t m_den_order = a_coeffs.size() - 1;
-  // init A_coeffs and B_coeffs by div(a0)
-  for (size_t i = 1; i < a_coeffs.size(); i++) {
-    a_coeffs[i] /= a_coeffs[0];
-  }
-  for (size_t i = 0; i < b_coeffs.size(); i++) {
-    b_coeffs[i] /= a_coeffs[0];
+  CHECK_FAIL_RETURN_UNEXPECTED(input_shape.Size() > 0, "LFilter: input tensor is not in shape of <..., time>.");
+  // pad every section to a common order and normalize by a0
+  const size_t num_sections = a_coeffs.size();
+  for (size_t s = 0; s < num_sections; s++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(!a_coeffs[s].empty() && !b_coeffs[s].empty(),
+                                 "LFilter: a_coeffs and b_coeffs should not be empty.");
+    CHECK_FAIL_RETURN_UNEXPECTED(a_coeffs[s][0] != static_cast<T>(0), "LFilter: a_coeffs[0] should not be zero.");
+    size_t len = std::max(a_coeffs[s].size(), b_coeffs[s].size());
+    a_coeffs[s].resize(len, static_cast<T>(0));
+    b_coeffs[s].resize(len, static_cast<T>(0));
+    T a0 = a_coeffs[s][0];
+    for (size_t i = 0; i < len; i++) {
+      a_coeffs[s][i] /= a0;
+      b_coeffs[s][i] /= a0;
+    }
   }
-  // Sliding window
-  T *m_px = new T[m_num_order + 1];
-  T *m_py = new T[m_den_order + 1];
 
-  // Tensor -> vector
-  for (auto itr = input->begin<T>(); itr != input->end<T>();) {
-    while (x_idx < shape_1 * channel_idx) {
-      signal.push_back(*itr);
-      itr++;
-      x_idx++;
-    }
-    // Sliding window
-    for (size_t j = 0; j < m_den_order; j++) {
-      m_px[j] = static_cast<T>(0);
+  size_t time = static_cast<size_t>(input_shape[-1]);
+  size_t num_waveforms = time == 0 ? 0 : static_cast<size_t>(input->Size()) / time;
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input_shape, input->type(), &out));
+  const T *in_data = reinterpret_cast<const T *>(input->GetBuffer());
+  T *out_data = reinterpret_cast<T *>(const_cast<unsigned char *>(out->GetBuffer()));
+  CHECK_FAIL_RETURN_UNEXPECTED(num_waveforms == 0 || (in_data != nullptr && out_data != nullptr),
+                               "LFilter: input or output tensor has no data.");
+
+  std::vector<T> block(kLFilterTimeBlock * kLFilterLanes, static_cast<T>(0));
+  std::vector<std::vector<T>> x_hist(num_sections);
+  std::vector<std::vector<T>> y_hist(num_sections);
+  for (size_t w = 0; w < num_waveforms; w += kLFilterLanes) {
+    size_t lanes = std::min(kLFilterLanes, num_waveforms - w);
+    for (size_t s = 0; s < num_sections; s++) {
+      x_hist[s].assign((a_coeffs[s].size() - 1) * kLFilterLanes, static_cast<T>(0));
+      y_hist[s].assign((a_coeffs[s].size() - 1) * kLFilterLanes, static_cast<T>(0));
     }
-    for (size_t j = 0; j <= m_den_order; j++) {
-      m_py[j] = static_cast<T>(0);
+    if (lanes < kLFilterLanes) {
+      // the unused lanes still hold the samples of the previous waveforms, zero them so that they filter zeros
+      std::fill(block.begin(), block.end(), static_cast<T>(0));
     }
-    // Each channel is processed with the sliding window
-    for (size_t i = x_idx - shape_1; i < x_idx; i++) {
-      m_px[m_num_order] = signal[i];
-      for (size_t j = 0; j < m_num_order + 1; j++) {
-        m_py[m_num_order] += b_coeffs[j] * m_px[m_num_order - j];
-      }
-      for (size_t j = 1; j < m_den_order + 1; j++) {
-        m_py[m_num_order] -= a_coeffs[j] * m_py[m_num_order - j];
-      }
-      if (clamp) {
-        if (m_py[m_num_order] > static_cast<T>(1))
-          out_vect[i] = static_cast<T>(1);
-        else if (m_py[m_num_order] < static_cast<T>(-1))
-          out_vect[i] = static_cast<T>(-1);
-        else
-          out_vect[i] = m_py[m_num_order];
-      } else {
-        out_vect[i] = m_py[m_num_order];
+    for (size_t t0 = 0; t0 < time; t0 += kLFilterTimeBlock) {
+      size_t block_len = std::min(kLFilterTimeBlock, time - t0);
+      // transpose <lanes, time> into <time, lanes>, the unused lanes stay zero with zero history
+      for (size_t l = 0; l < lanes; l++) {
+        const T *src = in_data + (w + l) * time + t0;
+        for (size_t t = 0; t < block_len; t++) {
+          block[t * kLFilterLanes + l] = src[t];
+        }
       }
-      if (i + 1 == x_idx) continue;
-      for (size_t j = 0; j < m_num_order; j++) {
-        m_px[j] = m_px[j + 1];
+      for (size_t s = 0; s < num_sections; s++) {
+        LFilterSectionBlock(block.data(), block_len, a_coeffs[s], b_coeffs[s], x_hist[s].data(), y_hist[s].data(),
+                            clamp);
       }
-      for (size_t j = 0; j < m_num_order; j++) {
-        m_py[j] = m_py[j + 1];
+      for (size_t l = 0; l < lanes; l++) {
+        T *dst = out_data + (w + l) * time + t0;
+        for (size_t t = 0; t < block_len; t++) {
+          dst[t] = block[t * kLFilterLanes + l];
+        }
       }
-      m_py[m_num_order] = static_cast<T>(0);
-    }
-    if (x_idx % shape_1 == 0) {
-      ++channel_idx;
     }
   }
-  // unpack batch
-  Tensor::CreateFromVector(out_vect, input_shape, &out);
   *output = out;
-  delete[] m_px;
-  delete[] m_py;
   return Status::OK();
 }
 
+/// \brief Perform an IIR filter by evaluating difference equation.
+/// \param input/output: Tensor of shape <..., time>
+/// \param a_coeffs: denominator coefficients of difference equation of dimension of (n_order + 1).
+/// \param b_coeffs: numerator coefficients of difference equation of dimension of (n_order + 1).
+/// \param clamp: If True, clamp the output signal to be in the range [-1, 1] (Default: True).
+/// \return Status code
+template <typename T>
+Status LFilter(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<T> a_coeffs,
+               std::vector<T> b_coeffs, bool clamp) {
+  return LFilterCascade(input, output, std::vector<std::vector<T>>{std::move(a_coeffs)},
+                        std::vector<std::vector<T>>{std::move(b_coeffs)}, clamp);
+}
+
 /// \brief Stretch STFT in time at a given rate, without changing the pitch.
 /// \param input: Tensor of shape <..., freq, time>.
 /// \param rate: Stretch factor.
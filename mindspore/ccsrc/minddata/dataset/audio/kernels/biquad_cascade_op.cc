@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/audio/kernels/biquad_cascade_op.h"
+
+#include "minddata/dataset/audio/kernels/audio_utils.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+template <typename T>
+std::vector<std::vector<T>> CastCoeffs(const std::vector<std::vector<float>> &coeffs) {
+  std::vector<std::vector<T>> result;
+  result.reserve(coeffs.size());
+  for (const auto &section : coeffs) {
+    std::vector<T> cast_section;
+    cast_section.reserve(section.size());
+    for (auto coeff : section) {
+      cast_section.push_back(static_cast<T>(coeff));
+    }
+    result.push_back(std::move(cast_section));
+  }
+  return result;
+}
+}  // namespace
+
+Status BiquadCascadeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  TensorShape input_shape = input->shape();
+  // check input tensor dimension, it should be greater than 0.
+  CHECK_FAIL_RETURN_UNEXPECTED(input_shape.Size() > 0, "Biquad: input tensor is not in shape of <..., time>.");
+  // check input type, it should be DE_FLOAT32 or DE_FLOAT16 or DE_FLOAT64
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    input->type() == DataType(DataType::DE_FLOAT32) || input->type() == DataType(DataType::DE_FLOAT16) ||
+      input->type() == DataType(DataType::DE_FLOAT64),
+    "Biquad: input tensor type should be float or double, but got: " + input->type().ToString());
+  if (input->type() == DataType(DataType::DE_FLOAT32)) {
+    return LFilterCascade(input, output, a_coeffs_, b_coeffs_, true);
+  } else if (input->type() == DataType(DataType::DE_FLOAT64)) {
+    return LFilterCascade(input, output, CastCoeffs<double>(a_coeffs_), CastCoeffs<double>(b_coeffs_), true);
+  } else {
+    return LFilterCascade(input, output, CastCoeffs<float16>(a_coeffs_), CastCoeffs<float16>(b_coeffs_), true);
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
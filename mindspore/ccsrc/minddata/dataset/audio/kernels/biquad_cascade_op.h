@@ -0,0 +1,51 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_BIQUAD_CASCADE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_BIQUAD_CASCADE_OP_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Consecutive biquad filters fused into one pass over the waveform, created by TensorOpFusionPass.
+///     Every section clamps its output to [-1, 1] like a single BiquadOp does.
+class BiquadCascadeOp : public TensorOp {
+ public:
+  BiquadCascadeOp(std::vector<std::vector<float>> a_coeffs, std::vector<std::vector<float>> b_coeffs)
+      : a_coeffs_(std::move(a_coeffs)), b_coeffs_(std::move(b_coeffs)) {}
+
+  ~BiquadCascadeOp() override = default;
+
+  void Print(std::ostream &out) const override { out << Name() << ": sections: " << a_coeffs_.size() << std::endl; }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  std::string Name() const override { return kBiquadCascadeOp; }
+
+ private:
+  std::vector<std::vector<float>> a_coeffs_;
+  std::vector<std::vector<float>> b_coeffs_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_BIQUAD_CASCADE_OP_H_
@@ -42,6 +42,12 @@ class BiquadOp : public TensorOp {
 
   std::string Name() const override { return kBiquadOp; }
 
+  /// \brief Denominator coefficients a0, a1, a2.
+  std::vector<float> ACoeffs() const { return {a0_, a1_, a2_}; }
+
+  /// \brief Numerator coefficients b0, b1, b2.
+  std::vector<float> BCoeffs() const { return {b0_, b1_, b2_}; }
+
  private:
   float b0_;
   float b1_;
@@ -52,6 +52,7 @@ ConfigManager::ConfigManager()
       auto_worker_config_(0),
       enable_shared_mem_(true),
       auto_offload_(false),
+      jpeg_dct_scale_(false),
       enable_autotune_(false),
       autotune_interval_(kCfgAutoTuneInterval) {
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
@@ -230,6 +230,14 @@ class ConfigManager {
   // @return - Flag to indicate whether automatic offloading is enabled for the dataset
   bool get_auto_offload() { return auto_offload_; }
 
+  // setter function
+  // @param enable - To let decode ops followed by a known resize downscale JPEG images in the DCT domain
+  void set_jpeg_dct_scale(bool enable) { jpeg_dct_scale_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether JPEG DCT domain downscaling is enabled
+  bool get_jpeg_dct_scale() { return jpeg_dct_scale_; }
+
   // setter function
   // @param enable - To enable autotune
   void set_enable_autotune(bool enable) { enable_autotune_ = enable; }
@@ -269,6 +277,7 @@ class ConfigManager {
   uint8_t auto_worker_config_;
   bool enable_shared_mem_;
   bool auto_offload_;
+  bool jpeg_dct_scale_;
   bool enable_autotune_;
   int64_t autotune_interval_;
   // Private helper function that takes a nlohmann json format and populates the settings
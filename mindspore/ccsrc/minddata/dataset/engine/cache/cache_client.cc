@@ -214,6 +214,8 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
       if (local_bypass_) {
         async_buffer_stream_ = std::make_shared<AsyncBufferStream>();
         RETURN_IF_NOT_OK(async_buffer_stream_->Init(this));
+        // Same host. Small row requests can skip gRPC.
+        RETURN_IF_NOT_OK(comm_->AttachRingChannel(server_connection_id_, client_id_));
       }
     }
     // We are not resetting the Duplicate key return code. We are passing it back to the CacheOp. This will tell the
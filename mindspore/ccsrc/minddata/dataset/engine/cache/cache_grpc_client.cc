@@ -20,7 +20,11 @@ namespace dataset {
 CacheClientGreeter::~CacheClientGreeter() { (void)ServiceStop(); }
 
 CacheClientGreeter::CacheClientGreeter(const std::string &hostname, int32_t port, int32_t num_connections)
-    : num_connections_(num_connections), request_cnt_(0), hostname_(std::move(hostname)), port_(port) {
+    : num_connections_(num_connections),
+      request_cnt_(0),
+      ring_senders_(0),
+      hostname_(std::move(hostname)),
+      port_(port) {
   grpc::ChannelArguments args;
   // We need to bump up the message size to unlimited. The default receiving
   // message limit is 4MB which is not big enough.
@@ -55,6 +59,27 @@ Status CacheClientGreeter::AttachToSharedMemory(bool *local_bypass) {
   return Status::OK();
 }
 
+Status CacheClientGreeter::AttachRingChannel(connection_id_type connection_id, int32_t client_id) {
+#ifdef CACHE_LOCAL_CLIENT
+  auto rq = std::make_shared<CreateRingChannelRequest>(connection_id, client_id);
+  RETURN_IF_NOT_OK(HandleRequest(rq));
+  Status rc = rq->Wait();
+  if (rc.IsError()) {
+    // Most likely an older server. Not fatal, we just continue with gRPC.
+    MS_LOG(WARNING) << "Unable to set up ring channel with the cache server. " << rc.ToString();
+    return Status::OK();
+  }
+  auto *base = static_cast<char *>(mem_.SharedMemoryBaseAddr());
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    ring_ = std::make_shared<CacheRingChannel>(base + rq->GetAddr());
+  }
+  RETURN_IF_NOT_OK(vg_.CreateAsyncTask("Ring reply", std::bind(&CacheClientGreeter::RingReplyEntry, this)));
+  MS_LOG(INFO) << "Ring channel is set up at offset " << rq->GetAddr();
+#endif
+  return Status::OK();
+}
+
 Status CacheClientGreeter::DoServiceStart() {
   RETURN_IF_NOT_OK(vg_.ServiceStart());
   RETURN_IF_NOT_OK(DispatchWorkers(num_connections_));
@@ -67,6 +92,15 @@ Status CacheClientGreeter::DoServiceStop() {
   // Shutdown the TaskGroup.
   vg_.interrupt_all();
   RETURN_IF_NOT_OK(vg_.join_all(Task::WaitFlag::kNonBlocking));
+  // Let the server know it can release the ring channel and fail whoever is still waiting on it.
+  std::shared_ptr<CacheRingChannel> ring;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    ring = ring_;
+  }
+  if (ring != nullptr) {
+    ReleaseRingChannel(ring, Status(StatusCode::kMDInterrupted, __LINE__, __FILE__));
+  }
   // Drain the queue. We know how many requests we send out
   while (!req_.empty()) {
     bool success;
@@ -84,9 +118,21 @@ Status CacheClientGreeter::HandleRequest(std::shared_ptr<BaseRequest> rq) {
   RETURN_IF_NOT_OK(rq->Prepare());
   auto seq_no = request_cnt_.fetch_add(1);
   auto tag = std::make_unique<CacheClientRequestTag>(std::move(rq), seq_no);
-  // One minute timeout
+  // One minute timeout. A request sent through the ring is failed by RingReplyEntry past the same deadline.
   auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(kRequestTimeoutDeadlineInSec);
   tag->ctx_.set_deadline(deadline);
+  std::shared_ptr<CacheRingChannel> ring;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    ring = ring_;
+  }
+  if (ring != nullptr && UseRing(*ring, *tag->base_rq_)) {
+    RETURN_IF_NOT_OK(HandleRingRequest(ring, &tag));
+    if (tag == nullptr) {
+      return Status::OK();
+    }
+    // The channel went down in the meantime, send it through grpc instead.
+  }
   tag->rpc_ = stub_->PrepareAsyncCacheServerRequest(&tag->ctx_, tag->base_rq_->rq_, &cq_);
   tag->rpc_->StartCall();
   auto ccReqTag = tag.get();
@@ -103,6 +149,156 @@ Status CacheClientGreeter::HandleRequest(std::shared_ptr<BaseRequest> rq) {
   return Status::OK();
 }
 
+bool CacheClientGreeter::UseRing(const CacheRingChannel &ring, const BaseRequest &rq) const {
+  if (rq.type_ != BaseRequest::RequestType::kBatchFetchRows && rq.type_ != BaseRequest::RequestType::kCacheRow &&
+      rq.type_ != BaseRequest::RequestType::kBatchCacheRows) {
+    return false;
+  }
+  return rq.rq_.ByteSizeLong() <= ring.RequestRing()->MaxPayload();
+}
+
+Status CacheClientGreeter::HandleRingRequest(const std::shared_ptr<CacheRingChannel> &ring,
+                                             std::unique_ptr<CacheClientRequestTag> *tag) {
+  auto seq_no = (*tag)->seq_no_;
+  auto *ccReqTag = tag->get();
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    // The channel is released once it is no longer ring_. Leave the request to the caller.
+    if (ring_ != ring) {
+      return Status::OK();
+    }
+    auto r = ring_req_.emplace(seq_no, std::move(*tag));
+    if (!r.second) {
+      return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__);
+    }
+  }
+  // Many threads can be sending at the same time. Each one copies its request into the ring but only the last
+  // one to leave rings the doorbell, so a burst of requests reaches the server in one go.
+  ++ring_senders_;
+  Status rc;
+  {
+    std::unique_lock<std::mutex> lck(ring_mux_);
+    bool alive;
+    {
+      std::unique_lock<std::mutex> lck2(mux_);
+      alive = ring_ == ring;
+    }
+    // If the channel was released while we were waiting for our turn, the request has already been failed by
+    // ReleaseRingChannel and the memory may belong to someone else by now.
+    if (alive) {
+      auto *request_ring = ring->RequestRing();
+      rc = ring->Send(request_ring, seq_no, ccReqTag->base_rq_->rq_, false);
+      if (--ring_senders_ == 0 || rc.IsError()) {
+        request_ring->Flush();
+      }
+    } else {
+      --ring_senders_;
+    }
+  }
+  if (rc.IsError()) {
+    std::unique_lock<std::mutex> lck(mux_);
+    (void)ring_req_.erase(seq_no);
+  }
+  return rc;
+}
+
+void CacheClientGreeter::ReleaseRingChannel(const std::shared_ptr<CacheRingChannel> &channel, const Status &rc) {
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    if (ring_ == channel) {
+      ring_ = nullptr;
+    }
+    for (auto &it : ring_req_) {
+      Status2CacheReply(rc, &it.second->base_rq_->reply_);
+      it.second->Notify();
+    }
+    ring_req_.clear();
+  }
+  // A sender stuck on a full ring gives up once the channel is closed. Wait for it to leave before we tell the
+  // server it can take the memory back.
+  channel->Close();
+  {
+    std::unique_lock<std::mutex> lck(ring_mux_);
+  }
+  channel->Release();
+}
+
+void CacheClientGreeter::FailExpiredRingRequests() {
+  auto now = std::chrono::system_clock::now();
+  std::unique_lock<std::mutex> lck(mux_);
+  for (auto it = ring_req_.begin(); it != ring_req_.end();) {
+    if (it->second->ctx_.deadline() < now) {
+      Status2CacheReply(Status(StatusCode::kMDTimeOut, __LINE__, __FILE__,
+                               "Cache server did not reply to request " + std::to_string(it->first) + " in time"),
+                        &it->second->base_rq_->reply_);
+      it->second->Notify();
+      it = ring_req_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Status CacheClientGreeter::RingReplyEntry() {
+  TaskManager::FindMe()->Post();
+  std::shared_ptr<CacheRingChannel> channel;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    channel = ring_;
+  }
+  RETURN_UNEXPECTED_IF_NULL(channel);
+  auto *ring = channel->ReplyRing();
+  auto f = [this](int64_t seq_no, const void *data, size_t sz) -> Status {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto it = ring_req_.find(seq_no);
+    if (it == ring_req_.end()) {
+      // The request has timed out and was failed already.
+      MS_LOG(INFO) << "Drop the late reply of sequence " << seq_no;
+      return Status::OK();
+    }
+    auto &reply = it->second->base_rq_->reply_;
+    if (!reply.ParseFromArray(data, static_cast<int>(sz))) {
+      Status2CacheReply(Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, "Corrupted reply in ring"),
+                        &reply);
+    }
+    it->second->Notify();
+    (void)ring_req_.erase(it);
+    return Status::OK();
+  };
+  RingBackoff backoff;
+  auto last_check = std::chrono::steady_clock::now();
+  Status rc;
+  do {
+    // The server closes the channel on error, on shutdown or when it thinks we are gone.
+    if (channel->IsClosed()) {
+      rc = Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, "Ring channel is closed by the cache server");
+      break;
+    }
+    int32_t num = 0;
+    // Tell the server we are still alive, it frees the channel of a client that stops beating.
+    channel->Beat();
+    rc = ring->Poll(f, &num);
+    if (rc.IsError()) {
+      break;
+    }
+    if (num > 0) {
+      backoff.Reset();
+    } else {
+      RETURN_IF_INTERRUPTED();
+      auto now = std::chrono::steady_clock::now();
+      if (now - last_check >= std::chrono::seconds(kWaitForNewEventDeadlineInSec)) {
+        FailExpiredRingRequests();
+        last_check = now;
+      }
+      backoff.Pause();
+    }
+  } while (true);
+  // Fail whoever is waiting on the channel. From now on every request goes through grpc.
+  MS_LOG(WARNING) << "Ring channel is down, falling back to grpc. " << rc.ToString();
+  ReleaseRingChannel(channel, rc);
+  return Status::OK();
+}
+
 Status CacheClientGreeter::WorkerEntry() {
   TaskManager::FindMe()->Post();
   do {
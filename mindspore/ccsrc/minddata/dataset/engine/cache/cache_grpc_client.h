@@ -24,6 +24,7 @@
 #include <utility>
 #include "minddata/dataset/engine/cache/cache_common.h"
 #include "minddata/dataset/engine/cache/cache_ipc.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
@@ -84,6 +85,16 @@ class CacheClientGreeter : public Service {
   /// \return Status object.
   Status AttachToSharedMemory(bool *local_bypass);
 
+  /// \brief Set up a ring channel in the shared memory with the server. Small row requests will go through
+  /// the ring instead of gRPC afterward.
+  /// \note Called after AttachToSharedMemory. If the server can't provide a channel, we stay with gRPC.
+  /// \return Status object.
+  Status AttachRingChannel(connection_id_type connection_id, int32_t client_id);
+
+  /// \brief A thread receiving replies from the ring channel
+  /// \return Status object
+  Status RingReplyEntry();
+
   /// \brief This returns where we attach to the shared memory.
   /// \return Base address of the shared memory.
   const void *SharedMemoryBaseAddr() const { return mem_.SharedMemoryBaseAddr(); }
@@ -100,9 +111,31 @@ class CacheClientGreeter : public Service {
   std::atomic<int64_t> request_cnt_;
   mutable std::mutex mux_;
   std::map<int64_t, std::unique_ptr<CacheClientRequestTag>> req_;
+  std::map<int64_t, std::unique_ptr<CacheClientRequestTag>> ring_req_;
   SharedMemory mem_;
+  // Guarded by mux_. Senders hold their own copy for the whole request, so the channel can be dropped any time.
+  std::shared_ptr<CacheRingChannel> ring_;
+  std::mutex ring_mux_;
+  std::atomic<int32_t> ring_senders_;
   std::string hostname_;
   int32_t port_;
+
+  /// \brief Only small row requests go through the ring. Everything else and anything that does not fit
+  /// in a slot is sent using gRPC.
+  bool UseRing(const CacheRingChannel &ring, const BaseRequest &rq) const;
+
+  /// \brief Send a request through the ring channel
+  /// \param[in] ring The channel the caller picked.
+  /// \param[in,out] tag The request. It is taken over unless the channel is gone, in which case the caller
+  /// sends it through gRPC.
+  Status HandleRingRequest(const std::shared_ptr<CacheRingChannel> &ring, std::unique_ptr<CacheClientRequestTag> *tag);
+
+  /// \brief Stop using the ring channel for good. Every pending request fails with the given status, later
+  /// requests go through gRPC, and the server is told it can free the channel.
+  void ReleaseRingChannel(const std::shared_ptr<CacheRingChannel> &channel, const Status &rc);
+
+  /// \brief Fail the requests sent through the ring which are past their deadline.
+  void FailExpiredRingRequests();
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include <vector>
 #include "minddata/dataset/engine/cache/cache_common.h"
 #include "minddata/dataset/engine/cache/cache_ipc.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/arena.h"
 #include "minddata/dataset/util/status.h"
@@ -41,7 +42,11 @@ class CacheServerRequest : public BaseRequest {
   friend class CacheServerGreeterImpl;
   enum class STATE : int8_t { CREATE = 1, PROCESS = 2, FINISH = 3 };
   CacheServerRequest()
-      : BaseRequest::BaseRequest(BaseRequest::RequestType::kRequestUnknown), st_(STATE::CREATE), responder_(&ctx_) {}
+      : BaseRequest::BaseRequest(BaseRequest::RequestType::kRequestUnknown),
+        st_(STATE::CREATE),
+        responder_(&ctx_),
+        ring_(nullptr),
+        ring_tag_(-1) {}
 
   ~CacheServerRequest() override = default;
 
@@ -61,6 +66,9 @@ class CacheServerRequest : public BaseRequest {
   STATE st_;
   grpc::ServerContext ctx_;
   grpc::ServerAsyncResponseWriter<CacheReply> responder_;
+  // Set if the request comes from a ring channel instead of gRPC. The reply goes back the same way.
+  CacheRingChannel *ring_;
+  int64_t ring_tag_;
 };
 
 /// \brief Implementation of CacheServerGreeter
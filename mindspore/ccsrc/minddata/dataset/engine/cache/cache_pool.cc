@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <chrono>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
@@ -22,7 +23,15 @@
 namespace mindspore {
 namespace dataset {
 CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      num_mem_hit_(0),
+      num_disk_hit_(0),
+      num_miss_(0),
+      disk_read_us_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -47,6 +56,8 @@ Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
   if (sm_ != nullptr) {
+    MS_LOG(INFO) << "CachePool " << subfolder_ << " prefetched " << sm_->GetNumPrefetch() << " spilled buffers, "
+                 << sm_->GetNumPrefetchHit() << " of them were read after the prefetch.";
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
       rc2 = rc;
@@ -165,9 +176,14 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      ++num_mem_hit_;
     } else if (sm_ != nullptr) {
       size_t expectedLength = 0;
+      auto start_tick = std::chrono::steady_clock::now();
       RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
+      auto end_tick = std::chrono::steady_clock::now();
+      disk_read_us_ += std::chrono::duration_cast<std::chrono::microseconds>(end_tick - start_tick).count();
+      ++num_disk_hit_;
       if (expectedLength != it->sz) {
         MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
                       << " Internal key: " << key << "\n";
@@ -178,6 +194,7 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
       *bytesRead = it->sz;
     }
   } else {
+    ++num_miss_;
     RETURN_STATUS_UNEXPECTED("Key not found");
   }
   return Status::OK();
@@ -190,7 +207,7 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -224,6 +241,12 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     }
   }
   tree_->Unlock();
+  cs.num_mem_hit = num_mem_hit_;
+  cs.num_disk_hit = num_disk_hit_;
+  cs.num_miss = num_miss_;
+  if (cs.num_disk_hit > 0) {
+    cs.avg_disk_read_us = disk_read_us_ / cs.num_disk_hit;
+  }
   return cs;
 }
 
@@ -240,8 +263,21 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
+    if (it->ptr != nullptr) {
+      // The client copies straight from this address and will not come back to us.
+      ++num_mem_hit_;
+    } else if (sm_ != nullptr) {
+      // The client will come back with a fetch request for this row. Get the device started now so
+      // the reads of the whole batch overlap instead of being served one by one. The prefetch is only
+      // a hint, the fetch still reads the row if it fails.
+      Status rc = sm_->Prefetch(it->storage_key);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Prefetch of key " << key << " failed: " << rc.ToString();
+      }
+    }
   } else {
     // Key not in the cache.
+    ++num_miss_;
     auto offset = CreateDataLocatorMsg(*fbb, key, 0, 0, 0);
     *out = offset;
   }
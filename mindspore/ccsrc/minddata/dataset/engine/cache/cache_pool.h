@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -87,7 +88,8 @@ class CachePool : public Service {
   using bl_alloc_type = typename value_allocator::template rebind<DataLocator>::other;
 
   /// \brief Simple statistics returned from CachePool like how many elements are cached in memory and
-  /// how many elements are spilled to disk.
+  /// how many elements are spilled to disk. The hit/miss counters are per tier and accumulate over the
+  /// life time of the pool.
   struct CacheStat {
     key_type min_key;
     key_type max_key;
@@ -95,6 +97,10 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_mem_hit;
+    int64_t num_disk_hit;
+    int64_t num_miss;
+    int64_t avg_disk_read_us;
     std::vector<key_type> gap;
   };
 
@@ -129,7 +135,8 @@ class CachePool : public Service {
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
-  /// \brief Serialize a DataLocator
+  /// \brief Serialize a DataLocator. If the buffer has been spilled to disk, an asynchronous readahead is
+  /// started so the Read that follows does not have to wait for the device.
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
 
@@ -153,6 +160,11 @@ class CachePool : public Service {
   std::atomic<uint64_t> temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
+  // Per tier statistics. Updated from const lookups, hence mutable.
+  mutable std::atomic<int64_t> num_mem_hit_;
+  mutable std::atomic<int64_t> num_disk_hit_;
+  mutable std::atomic<int64_t> num_miss_;
+  mutable std::atomic<int64_t> disk_read_us_;
   const int kMemoryCapAdjustInterval = 104857600;
 };
 }  // namespace dataset
@@ -303,6 +303,10 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.num_miss = msg->num_miss();
+  stat_.avg_disk_read_us = msg->avg_disk_read_us();
   return Status::OK();
 }
 
@@ -331,6 +335,10 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_mem_hit = current_session_info->stats()->num_mem_hit();
+    stats.num_disk_hit = current_session_info->stats()->num_disk_hit();
+    stats.num_miss = current_session_info->stats()->num_miss();
+    stats.avg_disk_read_us = current_session_info->stats()->avg_disk_read_us();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
@@ -45,6 +45,10 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
+  int64_t num_miss;
+  int64_t avg_disk_read_us;
 };
 
 struct CacheServerCfgInfo {
@@ -87,6 +91,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kCreateRingChannel = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -148,7 +153,8 @@ class BaseRequest {
            type_ == RequestType::kCacheSchema || type_ == RequestType::kFetchSchema ||
            type_ == RequestType::kBuildPhaseDone || type_ == RequestType::kToggleWriteMode ||
            type_ == RequestType::kConnectReset || type_ == RequestType::kStopService ||
-           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys;
+           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys ||
+           type_ == RequestType::kCreateRingChannel;
   }
 
   /// \brief Return if the request is of session request type
@@ -451,6 +457,27 @@ class AllocateSharedBlockRequest : public BaseRequest {
   }
 };
 
+/// \brief Ask the server to set up a shared memory ring channel for this client. Small row requests are then
+/// sent through the ring instead of gRPC.
+/// \see CacheRingChannel
+class CreateRingChannelRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  explicit CreateRingChannelRequest(connection_id_type connection_id, int32_t client_id)
+      : BaseRequest(RequestType::kCreateRingChannel) {
+    rq_.set_connection_id(connection_id);
+    rq_.set_client_id(client_id);
+  }
+  ~CreateRingChannelRequest() override = default;
+
+  /// \brief On return from the server, we get the (relative) address of the channel
+  /// \return
+  int64_t GetAddr() {
+    auto addr = strtoll(reply_.result().data(), nullptr, kDecimal);
+    return addr;
+  }
+};
+
 class ToggleWriteModeRequest : public BaseRequest {
  public:
   friend class CacheServer;
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "minddata/dataset/engine/cache/cache_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr size_t kCacheLineSize = 64;
+constexpr int32_t kSpinCount = 128;
+constexpr int32_t kYieldCount = 64;
+constexpr int32_t kMinSleepInUs = 20;
+constexpr int32_t kMaxSleepInUs = 1000;
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+inline uint64_t RoundUpCacheLine(uint64_t sz) { return (sz + kCacheLineSize - 1) & ~(kCacheLineSize - 1); }
+
+struct SlotHeader {
+  int64_t tag;
+  uint64_t len;
+};
+}  // namespace
+
+void RingBackoff::Pause() {
+  if (cnt_ < kSpinCount) {
+    CpuRelax();
+  } else if (cnt_ < kSpinCount + kYieldCount) {
+    std::this_thread::yield();
+  } else {
+    // Double the sleep every round up to the cap.
+    auto shift = std::min(cnt_ - kSpinCount - kYieldCount, 6);
+    auto us = std::min(kMinSleepInUs << shift, kMaxSleepInUs);
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  }
+  ++cnt_;
+}
+
+/// The two cursors are on their own cache line so the producer and the consumer do not
+/// invalidate each other on every update.
+struct SharedRing::RingHeader {
+  alignas(kCacheLineSize) std::atomic<uint64_t> head;
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail;
+  alignas(kCacheLineSize) uint32_t num_slots;
+  uint32_t slot_sz;
+};
+
+int64_t SharedRing::MemoryNeeded(uint32_t num_slots, uint32_t slot_sz) {
+  auto one_slot = RoundUpCacheLine(sizeof(SlotHeader) + slot_sz);
+  return static_cast<int64_t>(RoundUpCacheLine(sizeof(RingHeader)) + one_slot * num_slots);
+}
+
+void SharedRing::Format(void *base, uint32_t num_slots, uint32_t slot_sz) {
+  auto *hdr = new (base) RingHeader();
+  hdr->head.store(0, std::memory_order_relaxed);
+  hdr->tail.store(0, std::memory_order_relaxed);
+  hdr->num_slots = num_slots;
+  hdr->slot_sz = slot_sz;
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+SharedRing::SharedRing(void *base)
+    : hdr_(reinterpret_cast<RingHeader *>(base)),
+      slots_(reinterpret_cast<char *>(base) + RoundUpCacheLine(sizeof(RingHeader))) {
+  local_head_ = hdr_->head.load(std::memory_order_acquire);
+  local_tail_ = hdr_->tail.load(std::memory_order_acquire);
+}
+
+char *SharedRing::Slot(uint64_t pos) const {
+  auto one_slot = RoundUpCacheLine(sizeof(SlotHeader) + hdr_->slot_sz);
+  return slots_ + (pos % hdr_->num_slots) * one_slot;
+}
+
+size_t SharedRing::MaxPayload() const { return hdr_->slot_sz; }
+
+bool SharedRing::Full() const { return local_head_ - hdr_->tail.load(std::memory_order_acquire) >= hdr_->num_slots; }
+
+Status SharedRing::Push(int64_t tag, const google::protobuf::MessageLite &msg) {
+  auto sz = msg.ByteSizeLong();
+  if (sz > MaxPayload()) {
+    RETURN_STATUS_UNEXPECTED("Message of " + std::to_string(sz) + " bytes does not fit in a ring slot of " +
+                             std::to_string(MaxPayload()) + " bytes");
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!Full(), "Ring is full");
+  auto *p = Slot(local_head_);
+  auto *slot_hdr = reinterpret_cast<SlotHeader *>(p);
+  CHECK_FAIL_RETURN_UNEXPECTED(msg.SerializeToArray(p + sizeof(SlotHeader), static_cast<int>(sz)),
+                               "Fail to serialize message into ring slot");
+  slot_hdr->tag = tag;
+  slot_hdr->len = sz;
+  ++local_head_;
+  return Status::OK();
+}
+
+void SharedRing::Flush() {
+  // The release store is the doorbell. It makes all the slots written so far visible to the consumer.
+  hdr_->head.store(local_head_, std::memory_order_release);
+}
+
+Status SharedRing::Poll(const std::function<Status(int64_t, const void *, size_t)> &f, int32_t *num) {
+  RETURN_UNEXPECTED_IF_NULL(num);
+  *num = 0;
+  auto head = hdr_->head.load(std::memory_order_acquire);
+  Status rc;
+  while (local_tail_ < head) {
+    auto *p = Slot(local_tail_);
+    auto *slot_hdr = reinterpret_cast<const SlotHeader *>(p);
+    rc = f(slot_hdr->tag, p + sizeof(SlotHeader), slot_hdr->len);
+    ++local_tail_;
+    ++(*num);
+    if (rc.IsError()) {
+      break;
+    }
+  }
+  // Give all the slots back to the producer at once.
+  if (*num > 0) {
+    hdr_->tail.store(local_tail_, std::memory_order_release);
+  }
+  return rc;
+}
+
+struct CacheRingChannel::ChannelHeader {
+  alignas(kCacheLineSize) std::atomic<int32_t> closed;
+  alignas(kCacheLineSize) std::atomic<int64_t> heartbeat;
+  alignas(kCacheLineSize) std::atomic<int32_t> released;
+};
+
+int64_t CacheRingChannel::MemoryNeeded() {
+  return static_cast<int64_t>(RoundUpCacheLine(sizeof(ChannelHeader))) +
+         SharedRing::MemoryNeeded(kRingNumSlots, kRingSlotSize) * 2;
+}
+
+void CacheRingChannel::Format(void *base) {
+  auto *hdr = new (base) ChannelHeader();
+  hdr->closed.store(0, std::memory_order_relaxed);
+  hdr->heartbeat.store(0, std::memory_order_relaxed);
+  hdr->released.store(0, std::memory_order_relaxed);
+  auto *p = reinterpret_cast<char *>(base) + RoundUpCacheLine(sizeof(ChannelHeader));
+  SharedRing::Format(p, kRingNumSlots, kRingSlotSize);
+  SharedRing::Format(p + SharedRing::MemoryNeeded(kRingNumSlots, kRingSlotSize), kRingNumSlots, kRingSlotSize);
+}
+
+CacheRingChannel::CacheRingChannel(void *base)
+    : hdr_(reinterpret_cast<ChannelHeader *>(base)),
+      request_(reinterpret_cast<char *>(base) + RoundUpCacheLine(sizeof(ChannelHeader))),
+      reply_(reinterpret_cast<char *>(base) + RoundUpCacheLine(sizeof(ChannelHeader)) +
+             SharedRing::MemoryNeeded(kRingNumSlots, kRingSlotSize)) {}
+
+void CacheRingChannel::Close() { hdr_->closed.store(1, std::memory_order_release); }
+
+bool CacheRingChannel::IsClosed() const { return hdr_->closed.load(std::memory_order_acquire) != 0; }
+
+void CacheRingChannel::Release() {
+  Close();
+  hdr_->released.store(1, std::memory_order_release);
+}
+
+bool CacheRingChannel::IsReleased() const { return hdr_->released.load(std::memory_order_acquire) != 0; }
+
+void CacheRingChannel::Beat() { (void)hdr_->heartbeat.fetch_add(1, std::memory_order_relaxed); }
+
+int64_t CacheRingChannel::Heartbeat() const { return hdr_->heartbeat.load(std::memory_order_relaxed); }
+
+Status CacheRingChannel::Send(SharedRing *ring, int64_t tag, const google::protobuf::MessageLite &msg, bool flush) {
+  RETURN_UNEXPECTED_IF_NULL(ring);
+  if (ring->Full()) {
+    // Whatever we are holding back must go out first, or the other side may never free up a slot.
+    ring->Flush();
+    RingBackoff backoff;
+    while (ring->Full()) {
+      CHECK_FAIL_RETURN_UNEXPECTED(!IsClosed(), "Ring channel is closed");
+      backoff.Pause();
+    }
+  }
+  RETURN_IF_NOT_OK(ring->Push(tag, msg));
+  if (flush) {
+    ring->Flush();
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <google/protobuf/message_lite.h>
+#include "minddata/dataset/engine/cache/cache_common.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Number of slots in each direction of a ring channel.
+constexpr static uint32_t kRingNumSlots = 64;
+/// \brief Size of each slot. A request or a reply below kLocalByPassThreshold is sent inline, anything
+/// bigger goes through the shared memory arena, so this leaves room for the largest inline payload plus
+/// the rest of the protobuf.
+constexpr static uint32_t kRingSlotSize = kLocalByPassThreshold + 4096;
+/// \brief The server releases a channel whose client has not polled it for this long, since a crashed client
+/// never closes it.
+constexpr static int32_t kRingLivenessTimeoutInSec = 60;
+
+/// \brief Wait strategy used by both ends of a ring. Spin first since the other side usually answers within
+/// a few microseconds, then yield, and finally sleep with an increasing interval so an idle channel costs
+/// almost nothing.
+class RingBackoff {
+ public:
+  RingBackoff() : cnt_(0) {}
+  ~RingBackoff() = default;
+
+  /// \brief Wait a little bit longer than the last time.
+  void Pause();
+
+  /// \brief Called when there is progress. The next Pause starts spinning again.
+  void Reset() { cnt_ = 0; }
+
+ private:
+  int32_t cnt_;
+};
+
+/// \brief A lock free single producer single consumer ring of fixed size slots. The ring itself lives in
+/// memory shared by two processes. Each side keeps a private cursor and only publishes it with one atomic
+/// store, so the producer can fill many slots and ring the doorbell once (see Flush), and the consumer
+/// can drain all the slots that are ready and release them at once (see Poll).
+class SharedRing {
+ public:
+  /// \brief Number of bytes needed to hold a ring of the given geometry.
+  static int64_t MemoryNeeded(uint32_t num_slots, uint32_t slot_sz);
+
+  /// \brief Initialize an empty ring at the given address. Done once by the side that allocates the memory.
+  static void Format(void *base, uint32_t num_slots, uint32_t slot_sz);
+
+  /// \brief Attach to a ring previously formatted at the given address.
+  explicit SharedRing(void *base);
+
+  ~SharedRing() = default;
+
+  /// \brief Largest serialized message that fits in a slot.
+  size_t MaxPayload() const;
+
+  /// \brief Producer side. True if there is no free slot left.
+  bool Full() const;
+
+  /// \brief Producer side. Copy a message into the next free slot. The slot is not visible to the consumer
+  /// until Flush is called.
+  /// \param[in] tag A value handed back to the consumer along with the message.
+  /// \param[in] msg The message to serialize.
+  /// \return Status object. Error if the ring is full or the message does not fit in a slot.
+  Status Push(int64_t tag, const google::protobuf::MessageLite &msg);
+
+  /// \brief Producer side. Publish all the slots pushed so far.
+  void Flush();
+
+  /// \brief Consumer side. Call the given function on every published slot and release them.
+  /// \param[in] f Function to call on each slot. Processing stops at the first error.
+  /// \param[out] num Number of slots consumed.
+  /// \return Status object
+  Status Poll(const std::function<Status(int64_t, const void *, size_t)> &f, int32_t *num);
+
+ private:
+  struct RingHeader;
+  RingHeader *hdr_;
+  char *slots_;
+  uint64_t local_head_;  // producer's cursor, ahead of the published head by the number of pending slots
+  uint64_t local_tail_;  // consumer's cursor
+
+  char *Slot(uint64_t pos) const;
+};
+
+/// \brief Request and reply rings between one cache client and the server, placed back to back in a block of
+/// the shared memory arena. The client is the producer of the request ring and the consumer of the reply ring.
+class CacheRingChannel {
+ public:
+  /// \brief Number of bytes needed for a channel.
+  static int64_t MemoryNeeded();
+
+  /// \brief Initialize a channel at the given address.
+  static void Format(void *base);
+
+  /// \brief Attach to a channel previously formatted at the given address.
+  explicit CacheRingChannel(void *base);
+
+  ~CacheRingChannel() = default;
+
+  SharedRing *RequestRing() { return &request_; }
+  SharedRing *ReplyRing() { return &reply_; }
+
+  /// \brief Either side can close the channel. The other side stops using it once it notices.
+  void Close();
+  bool IsClosed() const;
+
+  /// \brief The client releases the channel once it has stopped using it for good. Only then the server gives
+  /// the memory back to the arena, so a late write from the client never lands in a block handed out again.
+  void Release();
+  bool IsReleased() const;
+
+  /// \brief The client bumps the heartbeat while it is polling the reply ring, so the server can tell a crashed
+  /// client, which will never close the channel, from an idle one.
+  void Beat();
+  int64_t Heartbeat() const;
+
+  /// \brief Push a message and flush, waiting for a free slot if the ring is full.
+  /// \param[in] ring The ring to push to, must be one of the two rings of this channel.
+  /// \param[in] tag Tag of the message.
+  /// \param[in] msg The message.
+  /// \param[in] flush If false, the caller will flush later so a few messages share one doorbell.
+  /// \return Status object. Error if the channel is closed while waiting.
+  Status Send(SharedRing *ring, int64_t tag, const google::protobuf::MessageLite &msg, bool flush = true);
+
+ private:
+  struct ChannelHeader;
+  ChannelHeader *hdr_;
+  SharedRing request_;
+  SharedRing reply_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_RING_H_
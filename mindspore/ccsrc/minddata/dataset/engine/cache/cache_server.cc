@@ -578,6 +578,10 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+    bld.add_num_miss(svc_stat.stat_.num_miss);
+    bld.add_avg_disk_read_us(svc_stat.stat_.avg_disk_read_us);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -711,7 +715,9 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.stat_.num_mem_hit, svc_stat.stat_.num_disk_hit,
+                                                  svc_stat.stat_.num_miss, svc_stat.stat_.avg_disk_read_us);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -905,6 +911,10 @@ Status CacheServer::ProcessAdminRequest(CacheServerRequest *cache_req) {
       cache_req->rc_ = FreeSharedMemory(&rq);
       break;
     }
+    case BaseRequest::RequestType::kCreateRingChannel: {
+      cache_req->rc_ = CreateRingChannel(&rq, &reply);
+      break;
+    }
     case BaseRequest::RequestType::kStopService: {
       // This command shutdowns everything.
       // But we first reply back to the client that we receive the request.
@@ -957,7 +967,19 @@ Status CacheServer::ProcessRequest(CacheServerRequest *cache_req) {
   cache_req->st_ = CacheServerRequest::STATE::FINISH;
   // We will re-tag the request back to the grpc queue. Once it comes back from the client,
   // the CacheServerRequest, i.e. the pointer cache_req, will be free
-  if (!internal_request && !global_shutdown_) {
+  if (cache_req->ring_ != nullptr) {
+    // We are running in the thread of the ring channel which is the only producer of the reply ring.
+    // The doorbell is rung by the caller once the whole batch of requests is done.
+    auto *reply_ring = cache_req->ring_->ReplyRing();
+    if (cache_req->reply_.ByteSizeLong() > reply_ring->MaxPayload()) {
+      cache_req->reply_.Clear();
+      Status2CacheReply(Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, "Reply too big for ring channel"),
+                        &cache_req->reply_);
+    }
+    Status rc = cache_req->ring_->Send(reply_ring, cache_req->ring_tag_, cache_req->reply_, false);
+    RETURN_IF_NOT_OK(ReturnRequestTag(cache_req));
+    RETURN_IF_NOT_OK(rc);
+  } else if (!internal_request && !global_shutdown_) {
     cache_req->responder_.Finish(cache_req->reply_, grpc::Status::OK, cache_req);
   } else {
     // We can free up the request now.
@@ -1143,6 +1165,99 @@ Status CacheServer::FreeSharedMemory(CacheRequest *rq) {
   return Status::OK();
 }
 
+Status CacheServer::CreateRingChannel(CacheRequest *rq, CacheReply *reply) {
+  auto client_id = rq->client_id();
+  CHECK_FAIL_RETURN_UNEXPECTED(client_id != -1, "Client ID not set");
+#ifdef CACHE_LOCAL_CLIENT
+  void *p = nullptr;
+  RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, CacheRingChannel::MemoryNeeded(), &p));
+  CacheRingChannel::Format(p);
+  Status rc = vg_.CreateAsyncTask("Ring channel", std::bind(&CacheServer::RingChannelRequest, this, p, client_id));
+  if (rc.IsError()) {
+    DeallocateSharedMemory(client_id, p);
+    return rc;
+  }
+  auto *base = SharedMemoryBaseAddr();
+  auto difference = reinterpret_cast<int64_t>(p) - reinterpret_cast<int64_t>(base);
+  reply->set_result(std::to_string(difference));
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Ring channel is not supported on this platform");
+#endif
+}
+
+Status CacheServer::RingChannelRequest(void *addr, int32_t client_id) {
+  TaskManager::FindMe()->Post();
+  CacheRingChannel channel(addr);
+  auto *request_ring = channel.RequestRing();
+  auto *reply_ring = channel.ReplyRing();
+  auto f = [this, &channel](int64_t tag, const void *data, size_t sz) -> Status {
+    CacheServerRequest *cache_req = nullptr;
+    RETURN_IF_NOT_OK(GetFreeRequestTag(&cache_req));
+    // Only the client facing row requests are accepted here. Anything else, or a request we can't parse,
+    // is left as unknown type and ProcessRequest will reply with an error.
+    if (cache_req->rq_.ParseFromArray(data, static_cast<int>(sz))) {
+      auto type = static_cast<BaseRequest::RequestType>(cache_req->rq_.type());
+      if (type == BaseRequest::RequestType::kCacheRow || type == BaseRequest::RequestType::kBatchCacheRows ||
+          type == BaseRequest::RequestType::kBatchFetchRows) {
+        cache_req->type_ = type;
+      }
+    }
+    cache_req->ring_ = &channel;
+    cache_req->ring_tag_ = tag;
+    return ProcessRequest(cache_req);
+  };
+  RingBackoff backoff;
+  Status rc;
+  // A client that crashed never closes the channel. Its reply thread stops beating though, and then the channel
+  // and its slots are given back.
+  auto last_heartbeat = channel.Heartbeat();
+  auto last_beat_time = std::chrono::steady_clock::now();
+  auto client_gone = [&channel, &last_heartbeat, &last_beat_time]() {
+    auto heartbeat = channel.Heartbeat();
+    auto now = std::chrono::steady_clock::now();
+    if (heartbeat != last_heartbeat) {
+      last_heartbeat = heartbeat;
+      last_beat_time = now;
+      return false;
+    }
+    return now - last_beat_time > std::chrono::seconds(kRingLivenessTimeoutInSec);
+  };
+  bool gone = false;
+  while (!global_shutdown_ && !channel.IsClosed() && !this_thread::is_interrupted()) {
+    int32_t num = 0;
+    rc = request_ring->Poll(f, &num);
+    if (num > 0) {
+      reply_ring->Flush();
+      backoff.Reset();
+    }
+    if (rc.IsError()) {
+      break;
+    }
+    if (num > 0) {
+      continue;
+    }
+    backoff.Pause();
+    // Only an idle channel is checked, a client sending requests is alive.
+    if (client_gone()) {
+      MS_LOG(WARNING) << "Client " << client_id << " has not polled its ring channel for " << kRingLivenessTimeoutInSec
+                      << " seconds. Assume it is gone and release the channel.";
+      gone = true;
+      break;
+    }
+  }
+  channel.Close();
+  // The client may still be writing into the request ring until it notices the channel is closed. Keep the memory
+  // until it says it is done with it, or until it is gone, so the block is not handed out while still in use.
+  while (!gone && !channel.IsReleased() && !global_shutdown_ && !this_thread::is_interrupted()) {
+    backoff.Pause();
+    gone = client_gone();
+  }
+  DeallocateSharedMemory(client_id, addr);
+  MS_LOG(INFO) << "Ring channel of client " << client_id << " is closed.";
+  return rc;
+}
+
 Status CacheServer::GetCacheState(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   SharedLock lck(&rwLock_);
@@ -361,6 +361,22 @@ class CacheServer : public Service {
   /// \return Status object
   Status FreeSharedMemory(CacheRequest *rq);
 
+  /// \brief Handle kCreateRingChannel request. A channel is carved out of the shared memory and a thread
+  /// is dedicated to serve it.
+  /// \param rq CacheRequest
+  /// \param reply CacheReply
+  /// \return Status object
+  Status CreateRingChannel(CacheRequest *rq, CacheReply *reply);
+
+  /// \brief Entry point of the thread serving a ring channel. It is the only consumer of the request ring
+  /// and the only producer of the reply ring. It returns when the client closes the channel, or when the client
+  /// stops beating for kRingLivenessTimeoutInSec, which means it is gone. The memory of the channel is given back
+  /// only after the client has released it, or is gone.
+  /// \param addr Address of the channel in the shared memory
+  /// \param client_id The client the memory is allocated for
+  /// \return Status object
+  Status RingChannelRequest(void *addr, int32_t client_id);
+
   /// \brief Handle CacheRow request
   /// \note There are two different implementation depends if shared memory is used for transportation.
   /// \return Status object
@@ -15,7 +15,9 @@
  */
 #include "minddata/dataset/engine/cache/storage_container.h"
 
+#include <fcntl.h>
 #include <unistd.h>
+#include <cstring>
 #include <vector>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -145,6 +147,19 @@ Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *
   return Status::OK();
 }
 
+Status StorageContainer::Prefetch(off64_t offset, size_t sz) const noexcept {
+  MS_ASSERT(is_open_);
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  // Only a hint to the kernel to start the readahead asynchronously. A later pread will find the pages
+  // in the page cache. Failure is harmless, the read simply goes to the device.
+  auto err = posix_fadvise64(fd_, offset, static_cast<off64_t>(sz), POSIX_FADV_WILLNEED);
+  if (err != 0) {
+    MS_LOG(DEBUG) << "Prefetch on container " << cont_ << " failed: " << strerror(err);
+  }
+#endif
+  return Status::OK();
+}
+
 Status StorageContainer::Truncate() const noexcept {
   if (is_open_) {
     RETURN_IF_NOT_OK(cont_.TruncateFile(fd_));
@@ -54,6 +54,9 @@ class StorageContainer {
 
   Status Read(WritableSlice *dest, off64_t offset) const noexcept;
 
+  /// \brief Ask the OS to bring a range of the container into the page cache without waiting for it.
+  Status Prefetch(off64_t offset, size_t sz) const noexcept;
+
   Status Truncate() const noexcept;
 
   bool IsOpen() const { return is_open_; }
@@ -148,6 +148,27 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
     }
     auto cont = containers_.at(container_inx);
     RETURN_IF_NOT_OK(cont->Read(dest, offset));
+    std::lock_guard<std::mutex> lck(prefetch_mux_);
+    if (prefetched_keys_.erase(key) > 0) {
+      ++num_prefetch_hit_;
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  return Status::OK();
+}
+
+Status StorageManager::Prefetch(StorageManager::key_type key) const {
+  auto r = index_.Search(key);
+  if (r.second) {
+    auto &it = r.first;
+    value_type v = *it;
+    auto cont = containers_.at(v.first);
+    RETURN_IF_NOT_OK(cont->Prefetch(v.second.first, v.second.second));
+    std::lock_guard<std::mutex> lck(prefetch_mux_);
+    if (prefetched_keys_.insert(key).second) {
+      ++num_prefetch_;
+    }
   } else {
     RETURN_STATUS_UNEXPECTED("Key not found");
   }
@@ -171,10 +192,11 @@ Status StorageManager::DoServiceStop() noexcept {
   return rc1;
 }
 
-StorageManager::StorageManager(const Path &root) : root_(root), file_id_(0), index_(), pool_size_(1) {}
+StorageManager::StorageManager(const Path &root)
+    : root_(root), file_id_(0), index_(), pool_size_(1), num_prefetch_(0), num_prefetch_hit_(0) {}
 
 StorageManager::StorageManager(const Path &root, int pool_size)
-    : root_(root), file_id_(0), index_(), pool_size_(pool_size) {}
+    : root_(root), file_id_(0), index_(), pool_size_(pool_size), num_prefetch_(0), num_prefetch_hit_(0) {}
 
 StorageManager::~StorageManager() { (void)StorageManager::DoServiceStop(); }
 
@@ -17,8 +17,11 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_STORAGE_MANAGER_H_
 
 #include <unistd.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/storage_container.h"
@@ -63,6 +66,18 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Start an asynchronous readahead of a previously written buffer. A subsequent Read of the
+  /// same key is then served from the page cache instead of waiting for the device.
+  /// \param key A key returned from Write
+  /// \return Status object
+  Status Prefetch(key_type key) const;
+
+  /// \brief Number of buffers prefetched so far
+  int64_t GetNumPrefetch() const { return num_prefetch_; }
+
+  /// \brief Number of reads of a buffer which had been prefetched and not read since
+  int64_t GetNumPrefetchHit() const { return num_prefetch_hit_; }
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -77,6 +92,11 @@ class StorageManager : public Service {
   storage_index index_;
   std::vector<int> writable_containers_pool_;
   int pool_size_;
+  // Keys prefetched but not read yet. Updated from const lookups, hence mutable.
+  mutable std::mutex prefetch_mux_;
+  mutable std::unordered_set<key_type> prefetched_keys_;
+  mutable std::atomic<int64_t> num_prefetch_;
+  mutable std::atomic<int64_t> num_prefetch_hit_;
 
   std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
@@ -165,6 +165,8 @@ Status CacheOp::WaitForCachingAllRows() {
   MS_LOG(INFO) << "Number of rows cached in memory : " << stat.num_mem_cached;
   MS_LOG(INFO) << "Number of rows spilled to disk : " << stat.num_disk_cached;
   MS_LOG(INFO) << "Average cache size : " << stat.avg_cache_sz;
+  MS_LOG(INFO) << "Rows served from memory / disk / missed : " << stat.num_mem_hit << " / " << stat.num_disk_hit
+               << " / " << stat.num_miss << ", average disk read (us) : " << stat.avg_disk_read_us;
   // Now all rows are cached and we have done a sync point check up. Next phase is
   // is pick up fetch input from sampler and pass up to the caller.
   RETURN_IF_NOT_OK(sampler_->HandshakeRandomAccessOp(this));
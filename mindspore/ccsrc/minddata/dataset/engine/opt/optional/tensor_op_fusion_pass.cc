@@ -16,9 +16,14 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "minddata/dataset/audio/ir/kernels/biquad_ir.h"
+#include "minddata/dataset/audio/kernels/biquad_cascade_op.h"
+#include "minddata/dataset/audio/kernels/biquad_op.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
@@ -29,12 +34,54 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+bool IsBiquad(const std::shared_ptr<TensorOperation> &op) {
+  return op != nullptr && op->Name() == audio::kBiquadOperation;
+}
+}  // namespace
+
+Status TensorOpFusionPass::FuseBiquadCascade(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *modified) {
+  RETURN_UNEXPECTED_IF_NULL(ops);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  auto itr = ops->begin();
+  while (itr != ops->end()) {
+    itr = std::find_if(itr, ops->end(), IsBiquad);
+    auto last = std::find_if_not(itr, ops->end(), IsBiquad);
+    if (last - itr < 2) {
+      itr = last;
+      continue;
+    }
+    // a run of biquad filters becomes one cascade, every section keeps its own clamp
+    std::vector<std::vector<float>> a_coeffs;
+    std::vector<std::vector<float>> b_coeffs;
+    for (auto cur = itr; cur != last; ++cur) {
+      std::shared_ptr<TensorOp> built = (*cur)->Build();
+      auto *biquad_op = dynamic_cast<BiquadOp *>(built.get());
+      RETURN_UNEXPECTED_IF_NULL(biquad_op);
+      a_coeffs.push_back(biquad_op->ACoeffs());
+      b_coeffs.push_back(biquad_op->BCoeffs());
+    }
+    MS_LOG(INFO) << "Fusing " << a_coeffs.size() << " consecutive Biquad into one cascade.";
+    *itr = std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<BiquadCascadeOp>(std::move(a_coeffs), std::move(b_coeffs)));
+    itr = ops->erase(itr + 1, last);
+    *modified = true;
+  }
+  return Status::OK();
+}
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   RETURN_UNEXPECTED_IF_NULL(node);
   RETURN_UNEXPECTED_IF_NULL(modified);
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
 
+  bool biquad_fused = false;
+  RETURN_IF_NOT_OK(FuseBiquadCascade(&ops, &biquad_fused));
+  if (biquad_fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
   auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
@@ -31,6 +32,14 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+ private:
+  /// \brief Replaces every run of consecutive Biquad ops by a single BiquadCascadeOp. Only the Biquad with explicit
+  ///     coefficients is fused, the derived biquad ops, LFilter and the other IIR ops are kept as they are.
+  /// \param[in, out] ops The tensor operations of the MapOp
+  /// \param[out] modified Indicates whether any run was fused
+  /// \return Status The status code returned
+  Status FuseBiquadCascade(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -263,8 +263,11 @@ static void JpegSkipInputData(j_decompress_ptr cinfo, int64_t jump) {
 }
 
 void JpegSetSource(j_decompress_ptr cinfo, const void *data, int64_t datasize) {
-  cinfo->src = static_cast<struct jpeg_source_mgr *>(
-    (*cinfo->mem->alloc_small)(reinterpret_cast<j_common_ptr>(cinfo), JPOOL_PERMANENT, sizeof(struct jpeg_source_mgr)));
+  // the source manager lives in the permanent pool, a reused decompress object keeps the one it already has
+  if (cinfo->src == nullptr) {
+    cinfo->src = static_cast<struct jpeg_source_mgr *>((*cinfo->mem->alloc_small)(
+      reinterpret_cast<j_common_ptr>(cinfo), JPOOL_PERMANENT, sizeof(struct jpeg_source_mgr)));
+  }
   cinfo->src->init_source = JpegInitSource;
   cinfo->src->fill_input_buffer = JpegFillInputBuffer;
 #if defined(_WIN32) || defined(_WIN64) || defined(ENABLE_ARM32) || defined(__APPLE__)
@@ -278,15 +281,73 @@ void JpegSetSource(j_decompress_ptr cinfo, const void *data, int64_t datasize) {
   cinfo->src->next_input_byte = static_cast<const JOCTET *>(data);
 }
 
-static Status JpegReadScanlines(jpeg_decompress_struct *const cinfo, int max_scanlines_to_read, JSAMPLE *buffer,
-                                int buffer_size, int crop_w, int crop_w_aligned, int offset, int stride) {
+namespace {
+// A decompress object and its scanline buffer are kept per thread and reused for every image the thread decodes,
+// so libjpeg's permanent pool, the source manager and the row buffer are set up only once.
+class JpegDecompressContext {
+ public:
+  JpegDecompressContext() : valid_(false) {
+    cinfo_.err = jpeg_std_error(&jerr_.pub);
+    jerr_.pub.error_exit = JpegErrorExitCustom;
+    try {
+      jpeg_create_decompress(&cinfo_);
+      valid_ = true;
+    } catch (std::runtime_error &e) {
+      MS_LOG(ERROR) << "Decode: create jpeg decompress failed: " << e.what();
+    }
+  }
+
+  ~JpegDecompressContext() {
+    if (valid_) {
+      jpeg_destroy_decompress(&cinfo_);
+    }
+  }
+
+  bool valid() const { return valid_; }
+
+  jpeg_decompress_struct *cinfo() { return &cinfo_; }
+
+  std::vector<JSAMPLE> *scanline() { return &scanline_; }
+
+ private:
+  struct jpeg_decompress_struct cinfo_ {};
+  struct JpegErrorManagerCustom jerr_ {};
+  std::vector<JSAMPLE> scanline_;
+  bool valid_;
+};
+
+// Brings the reused decompress object back to its idle state when the decode of one image ends, whatever the outcome.
+class JpegDecompressGuard {
+ public:
+  explicit JpegDecompressGuard(j_decompress_ptr cinfo) : cinfo_(cinfo) {}
+
+  ~JpegDecompressGuard() { jpeg_abort_decompress(cinfo_); }
+
+ private:
+  j_decompress_ptr cinfo_;
+};
+
+JpegDecompressContext *GetJpegDecompressContext() {
+  thread_local JpegDecompressContext context;
+  return &context;
+}
+
+// libjpeg-turbo implements 1/2, 1/4 and 1/8 scaling directly in the inverse DCT
+constexpr unsigned int kMaxJpegScaleDenom = 8;
+}  // namespace
+
+static Status JpegReadScanlines(jpeg_decompress_struct *const cinfo, std::vector<JSAMPLE> *scanline,
+                                int max_scanlines_to_read, JSAMPLE *buffer, int buffer_size, int crop_w,
+                                int crop_w_aligned, int offset, int stride) {
   // scanlines will be read to this buffer first, must have the number
   // of components equal to the number of components in the image
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int64_t>::max() / cinfo->output_components) > crop_w_aligned,
                                "JpegReadScanlines: multiplication out of bounds.");
   int64_t scanline_size = crop_w_aligned * cinfo->output_components;
-  std::vector<JSAMPLE> scanline(scanline_size);
-  JSAMPLE *scanline_ptr = &scanline[0];
+  if (scanline->size() < static_cast<size_t>(scanline_size)) {
+    scanline->resize(scanline_size);
+  }
+  JSAMPLE *scanline_ptr = scanline->data();
   while (cinfo->output_scanline < static_cast<unsigned int>(max_scanlines_to_read)) {
     int num_lines_read = 0;
     try {
@@ -318,11 +379,9 @@ static Status JpegReadScanlines(jpeg_decompress_struct *const cinfo, int max_sca
     } else if (num_lines_read > 0) {
       int copy_status = memcpy_s(buffer, buffer_size, scanline_ptr + offset, stride);
       if (copy_status != 0) {
-        jpeg_destroy_decompress(cinfo);
         RETURN_STATUS_UNEXPECTED("[Internal ERROR] Decode: memcpy failed.");
       }
     } else {
-      jpeg_destroy_decompress(cinfo);
       std::string err_msg = "[Internal ERROR] Decode: image decode failed.";
       RETURN_STATUS_UNEXPECTED(err_msg);
     }
@@ -346,7 +405,6 @@ static Status JpegSetColorSpace(jpeg_decompress_struct *cinfo) {
       cinfo->out_color_space = JCS_CMYK;
       return Status::OK();
     default:
-      jpeg_destroy_decompress(cinfo);
       std::string err_msg = "[Internal ERROR] Decode: image decode failed.";
       RETURN_STATUS_UNEXPECTED(err_msg);
   }
@@ -358,47 +416,56 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
-Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
-  struct jpeg_decompress_struct cinfo;
-  auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
-    jpeg_destroy_decompress(&cinfo);
-    RETURN_STATUS_UNEXPECTED(err);
-  };
-  struct JpegErrorManagerCustom jerr;
-  cinfo.err = jpeg_std_error(&jerr.pub);
-  jerr.pub.error_exit = JpegErrorExitCustom;
+// crop_x, crop_y, crop_w and crop_h are given on the full size image, the output is the crop downscaled by scale_denom
+static Status JpegCropAndDecodeWithScale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                                         int crop_x, int crop_y, int crop_w, int crop_h, unsigned int scale_denom) {
+  JpegDecompressContext *context = GetJpegDecompressContext();
+  CHECK_FAIL_RETURN_UNEXPECTED(context->valid(), "[Internal ERROR] Decode: create jpeg decompress failed.");
+  jpeg_decompress_struct *cinfo = context->cinfo();
+  JpegDecompressGuard guard(cinfo);
   try {
-    jpeg_create_decompress(&cinfo);
-    JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
-    (void)jpeg_read_header(&cinfo, TRUE);
-    RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
-    jpeg_calc_output_dimensions(&cinfo);
+    JpegSetSource(cinfo, input->GetBuffer(), input->SizeInBytes());
+    (void)jpeg_read_header(cinfo, TRUE);
+    RETURN_IF_NOT_OK(JpegSetColorSpace(cinfo));
+    cinfo->scale_num = 1;
+    cinfo->scale_denom = scale_denom;
+    jpeg_calc_output_dimensions(cinfo);
   } catch (std::runtime_error &e) {
-    return DestroyDecompressAndReturnError(e.what());
+    RETURN_STATUS_UNEXPECTED(e.what());
   }
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int32_t>::max() - crop_w) > crop_x,
                                "JpegCropAndDecode: addition(crop x and crop width) out of bounds.");
   CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<int32_t>::max() - crop_h) > crop_y,
                                "JpegCropAndDecode: addition(crop y and crop height) out of bounds.");
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
-    crop_w = cinfo.output_width;
-    crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
-    return DestroyDecompressAndReturnError("Crop: invalid crop size.");
-  }
-  const int mcu_size = cinfo.min_DCT_scaled_size;
+    crop_w = cinfo->output_width;
+    crop_h = cinfo->output_height;
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo->image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo->image_height) {
+    RETURN_STATUS_UNEXPECTED("Crop: invalid crop size.");
+  } else if (scale_denom > 1) {
+    // map the crop box onto the downscaled image, keeping every source pixel of the box
+    int crop_right = std::min(static_cast<int>((crop_x + crop_w + scale_denom - 1) / scale_denom),
+                              static_cast<int>(cinfo->output_width));
+    int crop_bottom = std::min(static_cast<int>((crop_y + crop_h + scale_denom - 1) / scale_denom),
+                               static_cast<int>(cinfo->output_height));
+    crop_x = crop_x / static_cast<int>(scale_denom);
+    crop_y = crop_y / static_cast<int>(scale_denom);
+    crop_w = std::max(crop_right - crop_x, 1);
+    crop_h = std::max(crop_bottom - crop_y, 1);
+  }
+  const int mcu_size = cinfo->min_DCT_scaled_size;
   CHECK_FAIL_RETURN_UNEXPECTED(mcu_size != 0, "JpegCropAndDecode: divisor mcu_size is zero.");
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
   unsigned int crop_w_aligned = crop_w + crop_x - crop_x_aligned;
+  JDIMENSION skipped_scanlines = 0;
   try {
-    (void)jpeg_start_decompress(&cinfo);
-    jpeg_crop_scanline(&cinfo, &crop_x_aligned, &crop_w_aligned);
+    (void)jpeg_start_decompress(cinfo);
+    jpeg_crop_scanline(cinfo, &crop_x_aligned, &crop_w_aligned);
+    skipped_scanlines = jpeg_skip_scanlines(cinfo, crop_y);
   } catch (std::runtime_error &e) {
-    return DestroyDecompressAndReturnError(e.what());
+    RETURN_STATUS_UNEXPECTED(e.what());
   }
-  JDIMENSION skipped_scanlines = jpeg_skip_scanlines(&cinfo, crop_y);
   // three number of output components, always convert to RGB and output
   constexpr int kOutNumComponents = 3;
   TensorShape ts = TensorShape({crop_h, crop_w, kOutNumComponents});
@@ -416,16 +483,33 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   // offset is calculated for scanlines read from the image, therefore
   // has the same number of components as the image
   int minius_value = crop_x - crop_x_aligned;
-  CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<float_t>::max() / minius_value) > cinfo.output_components,
+  CHECK_FAIL_RETURN_UNEXPECTED((std::numeric_limits<float_t>::max() / minius_value) > cinfo->output_components,
                                "JpegCropAndDecode: multiplication out of bounds.");
-  const int offset = minius_value * cinfo.output_components;
-  RETURN_IF_NOT_OK(
-    JpegReadScanlines(&cinfo, max_scanlines_to_read, buffer, buffer_size, crop_w, crop_w_aligned, offset, stride));
+  const int offset = minius_value * cinfo->output_components;
+  RETURN_IF_NOT_OK(JpegReadScanlines(cinfo, context->scanline(), max_scanlines_to_read, buffer, buffer_size, crop_w,
+                                     crop_w_aligned, offset, stride));
   *output = output_tensor;
-  jpeg_destroy_decompress(&cinfo);
   return Status::OK();
 }
 
+Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
+                         int crop_w, int crop_h) {
+  return JpegCropAndDecodeWithScale(input, output, crop_x, crop_y, crop_w, crop_h, 1);
+}
+
+Status JpegCropAndDecodeScaled(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x,
+                               int crop_y, int crop_w, int crop_h, int target_h, int target_w) {
+  // pick the largest downscale which still leaves the crop at least as large as the target in both dimensions
+  unsigned int scale_denom = 1;
+  if (target_h > 0 && target_w > 0) {
+    while (scale_denom < kMaxJpegScaleDenom && crop_w / static_cast<int>(scale_denom * 2) >= target_w &&
+           crop_h / static_cast<int>(scale_denom * 2) >= target_h) {
+      scale_denom *= 2;
+    }
+  }
+  return JpegCropAndDecodeWithScale(input, output, crop_x, crop_y, crop_w, crop_h, scale_denom);
+}
+
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
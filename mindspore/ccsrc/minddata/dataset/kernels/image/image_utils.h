@@ -118,6 +118,15 @@ void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size)
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
                          int w = 0, int h = 0);
 
+/// \brief Decode a crop of a JPEG image, downscaled in the DCT domain by 1/2, 1/4 or 1/8 when the downscaled crop is
+///     still at least as large as the target size, so a following resize to the target does not lose detail.
+/// \param input: CVTensor containing the not decoded JPEG image 1D bytes
+/// \param output: Decoded crop of shape <H,W,C> and type DE_UINT8, H and W are not smaller than the target size
+/// \param x, y, w, h: Crop box on the full size image
+/// \param target_h, target_w: Size the crop will be resized to
+Status JpegCropAndDecodeScaled(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y,
+                               int w, int h, int target_h, int target_w);
+
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \param rescale: rescale parameter
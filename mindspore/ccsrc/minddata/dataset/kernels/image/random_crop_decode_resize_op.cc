@@ -17,6 +17,7 @@
 #include <random>
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 
 namespace mindspore {
@@ -37,6 +38,7 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
   int crop_width = 0;
   TensorRow decoded;
   decoded.resize(output_count);
+  const bool dct_scale = GlobalContext::config_manager()->get_jpeg_dct_scale();
   for (size_t i = 0; i < input.size(); i++) {
     if (input[i] == nullptr) {
       RETURN_STATUS_UNEXPECTED("RandomCropDecodeResize: input image is empty since got nullptr.");
@@ -53,7 +55,12 @@ Status RandomCropDecodeResizeOp::Compute(const TensorRow &input, TensorRow *outp
         RETURN_IF_NOT_OK(GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width));
       }
       std::shared_ptr<Tensor> decoded_tensor = nullptr;
-      RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
+      if (dct_scale) {
+        RETURN_IF_NOT_OK(JpegCropAndDecodeScaled(input[i], &decoded_tensor, x, y, crop_width, crop_height,
+                                                 target_height_, target_width_));
+      } else {
+        RETURN_IF_NOT_OK(JpegCropAndDecode(input[i], &decoded_tensor, x, y, crop_width, crop_height));
+      }
       RETURN_IF_NOT_OK(Resize(decoded_tensor, &(*output)[i], target_height_, target_width_, 0.0, 0.0, interpolation_));
     }
   }
@@ -152,6 +152,7 @@ constexpr char kBandBiquadOp[] = "BandBiquadOp";
 constexpr char kBandpassBiquadOp[] = "BandpassBiquadOp";
 constexpr char kBandrejectBiquadOp[] = "BandrejectBiquadOp";
 constexpr char kBassBiquadOp[] = "BassBiquadOp";
+constexpr char kBiquadCascadeOp[] = "BiquadCascadeOp";
 constexpr char kBiquadOp[] = "BiquadOp";
 constexpr char kComplexNormOp[] = "ComplexNormOp";
 constexpr char kComputeDeltasOp[] = "ComputeDeltasOp";
@@ -86,7 +86,7 @@ BertTokenizerOperation::BertTokenizerOperation(const std::shared_ptr<Vocab> &voc
                                                int32_t max_bytes_per_token, const std::string &unknown_token,
                                                bool lower_case, bool keep_whitespace,
                                                const NormalizeForm normalize_form, bool preserve_unused_token,
-                                               bool with_offsets)
+                                               bool with_offsets, bool with_ids)
     : vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
@@ -95,7 +95,8 @@ BertTokenizerOperation::BertTokenizerOperation(const std::shared_ptr<Vocab> &voc
       keep_whitespace_(keep_whitespace),
       normalize_form_(normalize_form),
       preserve_unused_token_(preserve_unused_token),
-      with_offsets_(with_offsets) {}
+      with_offsets_(with_offsets),
+      with_ids_(with_ids) {}
 
 BertTokenizerOperation::~BertTokenizerOperation() = default;
 
@@ -118,13 +119,19 @@ Status BertTokenizerOperation::ValidateParams() {
     LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
 
+  if (with_offsets_ && with_ids_) {
+    std::string err_msg = "BertTokenizer: with_offsets and with_ids can not be both True.";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+
   return Status::OK();
 }
 
 std::shared_ptr<TensorOp> BertTokenizerOperation::Build() {
   std::shared_ptr<BertTokenizerOp> tensor_op =
     std::make_shared<BertTokenizerOp>(vocab_, suffix_indicator_, max_bytes_per_token_, unknown_token_, lower_case_,
-                                      keep_whitespace_, normalize_form_, preserve_unused_token_, with_offsets_);
+                                      keep_whitespace_, normalize_form_, preserve_unused_token_, with_offsets_,
+                                      with_ids_);
   return tensor_op;
 }
 
@@ -452,12 +459,13 @@ std::shared_ptr<TensorOp> UnicodeCharTokenizerOperation::Build() {
 WordpieceTokenizerOperation::WordpieceTokenizerOperation(const std::shared_ptr<Vocab> &vocab,
                                                          const std::string &suffix_indicator,
                                                          int32_t max_bytes_per_token, const std::string &unknown_token,
-                                                         bool with_offsets)
+                                                         bool with_offsets, bool with_ids)
     : vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
+      with_offsets_(with_offsets),
+      with_ids_(with_ids) {}
 
 Status WordpieceTokenizerOperation::ValidateParams() {
   if (vocab_ == nullptr) {
@@ -470,12 +478,16 @@ Status WordpieceTokenizerOperation::ValidateParams() {
       std::to_string(max_bytes_per_token_);
     LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
+  if (with_offsets_ && with_ids_) {
+    std::string err_msg = "WordpieceTokenizer: with_offsets and with_ids can not be both True.";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
   return Status::OK();
 }
 
 std::shared_ptr<TensorOp> WordpieceTokenizerOperation::Build() {
   std::shared_ptr<WordpieceTokenizerOp> tensor_op = std::make_shared<WordpieceTokenizerOp>(
-    vocab_, suffix_indicator_, max_bytes_per_token_, unknown_token_, with_offsets_);
+    vocab_, suffix_indicator_, max_bytes_per_token_, unknown_token_, with_offsets_, with_ids_);
   return tensor_op;
 }
 
@@ -80,7 +80,7 @@ class BertTokenizerOperation : public TensorOperation {
   BertTokenizerOperation(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                          int32_t max_bytes_per_token, const std::string &unknown_token, bool lower_case,
                          bool keep_whitespace, const NormalizeForm normalize_form, bool preserve_unused_token,
-                         bool with_offsets);
+                         bool with_offsets, bool with_ids = false);
 
   ~BertTokenizerOperation();
 
@@ -100,6 +100,7 @@ class BertTokenizerOperation : public TensorOperation {
   NormalizeForm normalize_form_;
   bool preserve_unused_token_;
   bool with_offsets_;
+  bool with_ids_;
 };
 
 class CaseFoldOperation : public TensorOperation {
@@ -330,7 +331,7 @@ class WordpieceTokenizerOperation : public TensorOperation {
  public:
   explicit WordpieceTokenizerOperation(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                        int32_t max_bytes_per_token, const std::string &unknown_token,
-                                       bool with_offsets);
+                                       bool with_offsets, bool with_ids = false);
 
   ~WordpieceTokenizerOperation() = default;
 
@@ -346,6 +347,7 @@ class WordpieceTokenizerOperation : public TensorOperation {
   int32_t max_bytes_per_token_;
   std::string unknown_token_;
   bool with_offsets_;
+  bool with_ids_;
 };
 
 #ifndef _WIN32
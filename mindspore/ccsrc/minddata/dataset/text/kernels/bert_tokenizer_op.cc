@@ -18,10 +18,25 @@ namespace mindspore {
 namespace dataset {
 Status BertTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  if (with_ids_) {
+    std::shared_ptr<Tensor> ids_tensor;
+    RETURN_IF_NOT_OK(ComputeIds(input[0], &ids_tensor));
+    output->push_back(ids_tensor);
+    return Status::OK();
+  }
   TensorRow basic_tensor;
   RETURN_IF_NOT_OK(basic_tokenizer_.Compute(input, &basic_tensor));
   RETURN_IF_NOT_OK(wordpiece_tokenizer_.Compute(basic_tensor, output));
   return Status::OK();
 }
+
+Status BertTokenizerOp::ComputeIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  TensorRow basic_tensor;
+  RETURN_IF_NOT_OK(basic_tokenizer_.Compute(TensorRow(0, {input}), &basic_tensor));
+  CHECK_FAIL_RETURN_UNEXPECTED(!basic_tensor.empty(), "BertTokenizer: basic tokenizer returns no output.");
+  RETURN_IF_NOT_OK(wordpiece_tokenizer_.ComputeIds(basic_tensor[0], output));
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
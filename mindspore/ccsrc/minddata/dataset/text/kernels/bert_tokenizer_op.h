@@ -38,19 +38,29 @@ class BertTokenizerOp : public TensorOp {
                            const bool &keep_whitespace = BasicTokenizerOp::kDefKeepWhitespace,
                            const NormalizeForm &normalization_form = BasicTokenizerOp::kDefNormalizationForm,
                            const bool &preserve_unused_token = BasicTokenizerOp::kDefPreserveUnusedToken,
-                           const bool &with_offsets = TokenizerOp::kDefWithOffsets)
+                           const bool &with_offsets = TokenizerOp::kDefWithOffsets,
+                           const bool &with_ids = WordpieceTokenizerOp::kDefWithIds)
       : wordpiece_tokenizer_(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets),
-        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets) {}
+        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets),
+        with_ids_(with_ids) {}
 
   ~BertTokenizerOp() override = default;
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  /// \brief Fused basic and wordpiece tokenization, the word ids of the sub-words are written straight into an int32
+  ///     tensor without creating the sub-word strings.
+  /// \param[in] input String tensor to tokenize.
+  /// \param[out] output 1D int32 tensor of word ids.
+  /// \return Status code.
+  Status ComputeIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
   std::string Name() const override { return kBertTokenizerOp; }
 
  private:
   WordpieceTokenizerOp wordpiece_tokenizer_;
   BasicTokenizerOp basic_tokenizer_;
+  bool with_ids_;
 };
 }  // namespace dataset
 }  // namespace mindspore
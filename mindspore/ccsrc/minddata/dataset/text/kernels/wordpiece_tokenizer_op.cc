@@ -25,36 +25,87 @@ namespace dataset {
 const char WordpieceTokenizerOp::kDefSuffixIndicator[] = "##";
 const int WordpieceTokenizerOp::kDefMaxBytesPerToken = 100;
 const char WordpieceTokenizerOp::kDefUnknownToken[] = "[UNK]";
+const bool WordpieceTokenizerOp::kDefWithIds = false;
+
+namespace {
+constexpr uint8_t kUtf8OneByteMask = 0x80;
+constexpr uint8_t kUtf8TwoBytesMask = 0xE0;
+constexpr uint8_t kUtf8TwoBytesLead = 0xC0;
+constexpr uint8_t kUtf8ThreeBytesMask = 0xF0;
+constexpr uint8_t kUtf8ThreeBytesLead = 0xE0;
+constexpr uint8_t kUtf8FourBytesMask = 0xF8;
+constexpr uint8_t kUtf8FourBytesLead = 0xF0;
+constexpr uint8_t kUtf8ContinuationMask = 0xC0;
+constexpr uint8_t kUtf8ContinuationByte = 0x80;
+
+// structural utf8 check, same acceptance as decoding the token into runes but without allocating them
+bool IsValidUtf8(std::string_view str) {
+  size_t i = 0;
+  while (i < str.size()) {
+    auto lead = static_cast<uint8_t>(str[i]);
+    size_t len = 0;
+    if ((lead & kUtf8OneByteMask) == 0) {
+      len = 1;
+    } else if ((lead & kUtf8TwoBytesMask) == kUtf8TwoBytesLead) {
+      len = 2;
+    } else if ((lead & kUtf8ThreeBytesMask) == kUtf8ThreeBytesLead) {
+      len = 3;
+    } else if ((lead & kUtf8FourBytesMask) == kUtf8FourBytesLead) {
+      len = 4;
+    } else {
+      return false;
+    }
+    if (i + len > str.size()) {
+      return false;
+    }
+    for (size_t j = 1; j < len; j++) {
+      if ((static_cast<uint8_t>(str[i + j]) & kUtf8ContinuationMask) != kUtf8ContinuationByte) {
+        return false;
+      }
+    }
+    i += len;
+  }
+  return true;
+}
+}  // namespace
 
 WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                            const int &max_bytes_per_token, const std::string &unknown_token,
-                                           const bool &with_offsets)
+                                           const bool &with_offsets, const bool &with_ids)
     : TokenizerOp(with_offsets),
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
+      unknown_token_(unknown_token),
+      suffix_node_(WordpieceTrie::kInvalidNode),
+      unknown_id_(Vocab::kNoTokenExists),
+      with_ids_(with_ids) {
+  if (vocab_ != nullptr) {
+    trie_.Build(vocab_->vocab());
+    suffix_node_ = trie_.Walk(trie_.Root(), suffix_indicator_);
+    if (!unknown_token_.empty()) {
+      unknown_id_ = trie_.WordId(trie_.Walk(trie_.Root(), unknown_token_));
+    }
+  }
+}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(std::string_view input_token, const int start, bool *out_found, int *out_end,
+                                        WordIdType *out_id) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
-    }
+  int32_t node = start > 0 ? suffix_node_ : trie_.Root();
+  if (node == WordpieceTrie::kInvalidNode) {
+    return Status::OK();
+  }
+  size_t match_len = 0;
+  if (trie_.LongestMatch(node, input_token.substr(start), &match_len, out_id)) {
+    *out_found = true;
+    *out_end = start + static_cast<int>(match_len);
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
@@ -69,19 +120,21 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(std::string_view input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= static_cast<int>(input_token.size()),
                                "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword.reserve(suffix_indicator_.size() + end - start);
+    subword = suffix_indicator_;
   }
-  (void)out_tokens->emplace_back(subword);
+  (void)subword.append(input_token.substr(start, end - start));
+  (void)out_tokens->emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
@@ -95,14 +148,14 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
     }
     return Status::OK();
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+  if (!IsValidUtf8(input_token)) {
     RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
   }
   int end = 0;
+  WordIdType word_id = Vocab::kNoTokenExists;
   for (int start = 0; start < static_cast<int>(input_token.size());) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end, &word_id));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
@@ -115,12 +168,64 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   return Status::OK();
 }
 
+Status WordpieceTokenizerOp::GetTokenIds(std::string_view input_token, std::vector<WordIdType> *out_ids) const {
+  auto add_unknown = [&]() -> Status {
+    CHECK_FAIL_RETURN_UNEXPECTED(unknown_id_ != Vocab::kNoTokenExists,
+                                 "WordpieceTokenizer: invalid data, token: \"" + std::string(input_token) +
+                                   "\" can not be tokenized and unknown token \"" + unknown_token_ +
+                                   "\" doesn't exist in vocab.");
+    out_ids->push_back(unknown_id_);
+    return Status::OK();
+  };
+  if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
+    return add_unknown();
+  }
+  if (!IsValidUtf8(input_token)) {
+    RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
+  }
+  size_t first_id = out_ids->size();
+  int end = 0;
+  WordIdType word_id = Vocab::kNoTokenExists;
+  for (int start = 0; start < static_cast<int>(input_token.size());) {
+    bool found = false;
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end, &word_id));
+    if (!found) {
+      out_ids->resize(first_id);
+      return add_unknown();
+    }
+    out_ids->push_back(word_id);
+    start = end;
+  }
+  return Status::OK();
+}
+
+Status WordpieceTokenizerOp::ComputeIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const {
+  IO_CHECK(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
+  if (input->Rank() > 1 || input->type() != DataType::DE_STRING) {
+    RETURN_STATUS_UNEXPECTED(
+      "WordpieceTokenizer: The input shape should be 1D scalar the input datatype should be string.");
+  }
+  std::vector<WordIdType> out_ids;
+  out_ids.reserve(input->Size());
+  for (auto iter = input->begin<std::string_view>(); iter != input->end<std::string_view>(); iter++) {
+    RETURN_IF_NOT_OK(GetTokenIds(*iter, &out_ids));
+  }
+  return Tensor::CreateFromVector(out_ids, output);
+}
+
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED(
       "WordpieceTokenizer: The input shape should be 1D scalar the input datatype should be string.");
   }
+  if (with_ids_) {
+    std::shared_ptr<Tensor> ids_tensor;
+    RETURN_IF_NOT_OK(ComputeIds(input[0], &ids_tensor));
+    output->push_back(ids_tensor);
+    return Status::OK();
+  }
   dsize_t count = 0;
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
@@ -131,7 +236,7 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
     out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
     count++;
   }
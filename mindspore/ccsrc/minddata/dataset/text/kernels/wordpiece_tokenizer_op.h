@@ -20,16 +20,13 @@
 #include <string_view>
 #include <vector>
 
-#include "cppjieba/Unicode.hpp"
-
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/text/kernels/tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_trie.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
 namespace mindspore {
 namespace dataset {
 
@@ -38,23 +35,33 @@ class WordpieceTokenizerOp : public TokenizerOp {
   static const char kDefSuffixIndicator[];
   static const int kDefMaxBytesPerToken;
   static const char kDefUnknownToken[];
+  static const bool kDefWithIds;
   WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator = kDefSuffixIndicator,
                        const int &max_bytes_per_token = kDefMaxBytesPerToken,
-                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets);
+                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets,
+                       const bool &with_ids = kDefWithIds);
 
   ~WordpieceTokenizerOp() override = default;
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  /// \brief Tokenize a string tensor of words and write the word ids of the sub-words straight into an int32 tensor,
+  ///     without creating the sub-word strings. Equivalent to WordpieceTokenizer followed by Lookup.
+  /// \param[in] input String tensor of words, scalar or 1D.
+  /// \param[out] output 1D int32 tensor of word ids.
+  /// \return Status code.
+  Status ComputeIds(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const;
+
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
+  Status AddSubword(std::string_view input_token, const int &start, const int &end,
                     std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  Status FoundNoToken(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                       std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  Status LookupWord(std::string_view input_token, const int start, bool *out_found, int *out_end,
+                    WordIdType *out_id) const;
+  Status GetTokens(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  Status GetTokenIds(std::string_view input_token, std::vector<WordIdType> *out_ids) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -63,6 +70,12 @@ class WordpieceTokenizerOp : public TokenizerOp {
   const std::string suffix_indicator_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  WordpieceTrie trie_;
+  // node reached from the trie root by the suffix indicator, kInvalidNode if no word starts with it
+  int32_t suffix_node_;
+  WordIdType unknown_id_;
+  // output the word ids of the sub-words by ComputeIds instead of the sub-word strings
+  bool with_ids_;
 };
 }  // namespace dataset
 }  // namespace mindspore
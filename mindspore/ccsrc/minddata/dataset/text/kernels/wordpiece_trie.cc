@@ -0,0 +1,128 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/kernels/wordpiece_trie.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint8_t kUtf8ContinuationMask = 0xC0;
+constexpr uint8_t kUtf8ContinuationByte = 0x80;
+constexpr size_t kLinearSearchThreshold = 8;
+
+inline bool IsCharBoundary(std::string_view input, size_t pos) {
+  return pos >= input.size() ||
+         (static_cast<uint8_t>(input[pos]) & kUtf8ContinuationMask) != kUtf8ContinuationByte;
+}
+}  // namespace
+
+void WordpieceTrie::Build(const std::unordered_map<WordType, WordIdType> &words) {
+  // build a pointer based trie first, then lay it out breadth first so the children of a node are contiguous
+  std::vector<std::map<uint8_t, int32_t>> children(1);
+  std::vector<WordIdType> ids(1, Vocab::kNoTokenExists);
+  for (const auto &item : words) {
+    int32_t cur = kRootNode;
+    for (char c : item.first) {
+      auto label = static_cast<uint8_t>(c);
+      auto iter = children[cur].find(label);
+      if (iter == children[cur].end()) {
+        auto next = static_cast<int32_t>(children.size());
+        children[cur][label] = next;
+        children.emplace_back();
+        ids.push_back(Vocab::kNoTokenExists);
+        cur = next;
+      } else {
+        cur = iter->second;
+      }
+    }
+    ids[cur] = item.second;
+  }
+
+  nodes_.assign(children.size(), Node{0, 0, Vocab::kNoTokenExists});
+  labels_.clear();
+  targets_.clear();
+  labels_.reserve(children.size());
+  targets_.reserve(children.size());
+  std::vector<int32_t> new_index(children.size(), kInvalidNode);
+  std::queue<int32_t> queue;
+  new_index[kRootNode] = kRootNode;
+  int32_t next_index = kRootNode + 1;
+  queue.push(kRootNode);
+  while (!queue.empty()) {
+    int32_t old_node = queue.front();
+    queue.pop();
+    Node &node = nodes_[new_index[old_node]];
+    node.word_id = ids[old_node];
+    node.first_child = static_cast<uint32_t>(labels_.size());
+    node.num_children = static_cast<uint32_t>(children[old_node].size());
+    for (const auto &child : children[old_node]) {
+      new_index[child.second] = next_index++;
+      labels_.push_back(child.first);
+      targets_.push_back(new_index[child.second]);
+      queue.push(child.second);
+    }
+  }
+}
+
+int32_t WordpieceTrie::Child(int32_t node, uint8_t label) const {
+  const Node &cur = nodes_[static_cast<size_t>(node)];
+  auto first = labels_.begin() + cur.first_child;
+  auto last = first + cur.num_children;
+  auto iter = last;
+  if (cur.num_children <= kLinearSearchThreshold) {
+    iter = std::find(first, last, label);
+  } else {
+    iter = std::lower_bound(first, last, label);
+    if (iter != last && *iter != label) {
+      iter = last;
+    }
+  }
+  return iter == last ? kInvalidNode : targets_[static_cast<size_t>(iter - labels_.begin())];
+}
+
+int32_t WordpieceTrie::Walk(int32_t node, std::string_view key) const {
+  if (nodes_.empty()) {
+    return kInvalidNode;
+  }
+  for (size_t i = 0; i < key.size() && node != kInvalidNode; i++) {
+    node = Child(node, static_cast<uint8_t>(key[i]));
+  }
+  return node;
+}
+
+bool WordpieceTrie::LongestMatch(int32_t node, std::string_view input, size_t *match_len,
+                                 WordIdType *word_id) const {
+  bool found = false;
+  if (nodes_.empty()) {
+    return found;
+  }
+  for (size_t i = 0; i < input.size() && node != kInvalidNode;) {
+    node = Child(node, static_cast<uint8_t>(input[i]));
+    i++;
+    if (node != kInvalidNode && nodes_[node].word_id != Vocab::kNoTokenExists && IsCharBoundary(input, i)) {
+      found = true;
+      *match_len = i;
+      *word_id = nodes_[node].word_id;
+    }
+  }
+  return found;
+}
+}  // namespace dataset
+}  // namespace mindspore
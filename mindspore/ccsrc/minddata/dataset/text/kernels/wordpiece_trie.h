@@ -0,0 +1,88 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Read-only byte trie over the words of a Vocab, used by the wordpiece tokenizer for greedy longest-match.
+///     Nodes are stored in flat arrays and the children of a node are contiguous and sorted by label, so a lookup
+///     never allocates and never materializes a substring of the input.
+class WordpieceTrie {
+ public:
+  static constexpr int32_t kInvalidNode = -1;
+
+  WordpieceTrie() = default;
+
+  ~WordpieceTrie() = default;
+
+  /// \brief Build the trie from a word to id map, any previous content is dropped.
+  /// \param[in] words Word to word id map.
+  void Build(const std::unordered_map<WordType, WordIdType> &words);
+
+  /// \brief Root node, all words are reachable from it.
+  int32_t Root() const { return kRootNode; }
+
+  /// \brief Follow the bytes of the key starting from the given node.
+  /// \param[in] node Node to start from.
+  /// \param[in] key Bytes to follow.
+  /// \return The node reached, or kInvalidNode if the path does not exist.
+  int32_t Walk(int32_t node, std::string_view key) const;
+
+  /// \brief Find the longest word starting at the given node which is a prefix of the input and ends on an utf8
+  ///     character boundary of the input.
+  /// \param[in] node Node to start from, usually Root() or the node reached by the suffix indicator.
+  /// \param[in] input Bytes to match.
+  /// \param[out] match_len Length in bytes of the longest match.
+  /// \param[out] word_id Word id of the longest match.
+  /// \return True if a word was matched.
+  bool LongestMatch(int32_t node, std::string_view input, size_t *match_len, WordIdType *word_id) const;
+
+  /// \brief Word id stored on the node, Vocab::kNoTokenExists if no word ends on it.
+  WordIdType WordId(int32_t node) const {
+    return node == kInvalidNode ? Vocab::kNoTokenExists : nodes_[static_cast<size_t>(node)].word_id;
+  }
+
+  /// \brief Number of nodes of the trie.
+  size_t NodeCount() const { return nodes_.size(); }
+
+ private:
+  static constexpr int32_t kRootNode = 0;
+
+  struct Node {
+    uint32_t first_child;
+    uint32_t num_children;
+    WordIdType word_id;
+  };
+
+  int32_t Child(int32_t node, uint8_t label) const;
+
+  std::vector<Node> nodes_;
+  // label and target of each edge, the edges of a node are [first_child, first_child + num_children)
+  std::vector<uint8_t> labels_;
+  std::vector<int32_t> targets_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_WORDPIECE_TRIE_H_
@@ -40,6 +40,9 @@
 #include "ps/util.h"
 #endif
 #include "ps/ps_context.h"
+#ifndef _WIN32
+#include "utils/checkpoint_engine.h"
+#endif
 
 #include "pybind_api/gil_scoped_long_running.h"
 
@@ -58,6 +61,10 @@ using ParallelContext = mindspore::parallel::ParallelContext;
 using CostModelContext = mindspore::parallel::CostModelContext;
 using mindspore::MsCtxParam;
 using PSContext = mindspore::ps::PSContext;
+#ifndef _WIN32
+using CheckpointWriter = mindspore::checkpoint::CheckpointWriter;
+using CheckpointReader = mindspore::checkpoint::CheckpointReader;
+#endif
 
 // Interface with python
 PYBIND11_MODULE(_c_expression, m) {
@@ -188,6 +195,14 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_pipeline_stage_split_num", &ParallelContext::set_pipeline_stage_split_num,
          "Set pipeline stage split num.")
     .def("get_pipeline_stage_split_num", &ParallelContext::pipeline_stage_split_num, "Get pipeline stage split num.")
+    .def("set_pipeline_interleave_num", &ParallelContext::set_pipeline_interleave_num,
+         "Set the number of the chunks of each pipeline stage.")
+    .def("get_pipeline_interleave_num", &ParallelContext::pipeline_interleave_num,
+         "Get the number of the chunks of each pipeline stage.")
+    .def("set_pipeline_micro_batch_order", &ParallelContext::set_pipeline_micro_batch_order,
+         "Set the order of the micro batches on the pipeline chunks.")
+    .def("get_pipeline_micro_batch_order", &ParallelContext::pipeline_micro_batch_order,
+         "Get the order of the micro batches on the pipeline chunks.")
     .def("set_full_batch", &ParallelContext::set_full_batch, "Set whether load full batch on each device.")
     .def("get_full_batch", &ParallelContext::full_batch, "Get whether load full batch on each device.")
     .def("set_dataset_strategy", &ParallelContext::set_dataset_strategy, "Set dataset sharding strategy.")
@@ -305,6 +320,22 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the flag of generating a single suite of OperatorInfos in for-loop.")
     .def("get_dp_algo_single_loop", &CostModelContext::dp_algo_single_loop,
          "Get the flag of whether or not generating a single suite of OperatorInfos in for-loop.")
+    .def("set_dp_algo_search_threads", &CostModelContext::set_dp_algo_search_threads,
+         "Set the number of threads searching strategies in the DP algorithm.")
+    .def("get_dp_algo_search_threads", &CostModelContext::dp_algo_search_threads,
+         "Get the number of threads searching strategies in the DP algorithm.")
+    .def("set_dp_algo_cost_cache_path", &CostModelContext::set_dp_algo_cost_cache_path,
+         "Set the file caching the redistribution costs of the DP algorithm across compilations.")
+    .def("get_dp_algo_cost_cache_path", &CostModelContext::dp_algo_cost_cache_path,
+         "Get the file caching the redistribution costs of the DP algorithm across compilations.")
+    .def("set_dp_algo_strategy_db_path", &CostModelContext::set_dp_algo_strategy_db_path,
+         "Set the file of the strategy database shared by the DP algorithm across jobs.")
+    .def("get_dp_algo_strategy_db_path", &CostModelContext::dp_algo_strategy_db_path,
+         "Get the file of the strategy database shared by the DP algorithm across jobs.")
+    .def("set_dp_algo_redistribution_search", &CostModelContext::set_dp_algo_redistribution_search,
+         "Set the flag whether searching the redistribution operators of the least communication cost.")
+    .def("get_dp_algo_redistribution_search", &CostModelContext::dp_algo_redistribution_search,
+         "Get the flag whether searching the redistribution operators of the least communication cost.")
     .def("reset_cost_model", &CostModelContext::ResetCostModel, "Reset the CostModelContext.")
     .def("reset_algo_parameters", &CostModelContext::ResetAlgoParameters, "Reset the AlgoParameters.");
 
@@ -442,6 +473,22 @@ PYBIND11_MODULE(_c_expression, m) {
   (void)m.def("_is_cipher_file", &mindspore::pipeline::PyIsCipherFile, "Determine whether the file is encrypted");
 
 #ifndef _WIN32
+  (void)py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter>>(m, "CheckpointWriter_")
+    .def(py::init<const std::string &>())
+    .def("add", &CheckpointWriter::Add, "Add a snapshot of the tensor to the checkpoint.")
+    .def("save", &CheckpointWriter::Save, "Save the checkpoint, asynchronously or not.")
+    .def("wait", &CheckpointWriter::Wait, "Wait for the end of the save, return whether it succeeded.")
+    .def("is_running", &CheckpointWriter::IsRunning, "Whether the checkpoint is being saved.");
+
+  (void)py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(m, "CheckpointReader_")
+    .def(py::init<const std::string &>())
+    .def("open", &CheckpointReader::Open, "Map the checkpoint file and parse its index.")
+    .def("get_names", &CheckpointReader::GetNames, "Get the names of the tensors in the checkpoint.")
+    .def("read", &CheckpointReader::Read, "Read a tensor of the checkpoint.");
+
+  (void)m.def("_is_native_checkpoint", &mindspore::checkpoint::IsNativeCheckpoint,
+              "Determine whether the file is a native checkpoint.");
+
   (void)m.def("_export_bprop_mindir", &mindspore::ad::KPrim::ExportBpropMindir,
               "Export the backpropagation function to mindir file.");
 #endif
@@ -0,0 +1,547 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/cpu/nvme_mem_handler.h"
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The alignment of the buffers, offsets and sizes of the file accesses, as required by O_DIRECT.
+constexpr size_t kIoAlignment = 4096;
+// The address range reserved for the handles of the arena, no memory is used by it.
+constexpr size_t kArenaReservedSize = 1ull << 40;
+constexpr unsigned kRingEntries = 64;
+
+size_t AlignUp(size_t size) { return (size + kIoAlignment - 1) / kIoAlignment * kIoAlignment; }
+
+double ElapsedMicroseconds(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SyncIo(int fd, bool is_write, uint8_t *buffer, size_t offset, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    auto ret = is_write ? pwrite(fd, buffer + done, size - done, static_cast<off_t>(offset + done))
+                        : pread(fd, buffer + done, size - done, static_cast<off_t>(offset + done));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(EXCEPTION) << (is_write ? "Write" : "Read") << " the swap file failed, offset: " << offset
+                        << ", size: " << size << ", errno: " << errno;
+    }
+    done += static_cast<size_t>(ret);
+  }
+}
+}  // namespace
+
+// The submission and completion rings of io_uring, used through the system calls directly.
+class IoUring {
+ public:
+  IoUring() = default;
+  ~IoUring() {
+    if (sqes_ != nullptr) {
+      (void)munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      (void)munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      (void)munmap(sq_ptr_, sq_size_);
+    }
+    if (ring_fd_ >= 0) {
+      (void)close(ring_fd_);
+    }
+  }
+
+  bool Init(unsigned entries) {
+    io_uring_params params{};
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+      return false;
+    }
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+    sq_ptr_ = Map(sq_size_, IORING_OFF_SQ_RING);
+    cq_ptr_ = single_mmap ? sq_ptr_ : Map(cq_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+    if (sq_ptr_ == nullptr || cq_ptr_ == nullptr || sqes_ == nullptr) {
+      return false;
+    }
+    auto sq = static_cast<uint8_t *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_entries_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_entries);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto cq = static_cast<uint8_t *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  // Queue a read or a write and submit it, return false if it can not be submitted.
+  bool Submit(bool is_write, int fd, uint8_t *buffer, size_t size, size_t offset, uint64_t user_data) {
+    unsigned tail = *sq_tail_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      return false;
+    }
+    unsigned index = tail & sq_mask_;
+    auto sqe = &sqes_[index];
+    (void)memset_s(sqe, sizeof(io_uring_sqe), 0, sizeof(io_uring_sqe));
+    sqe->opcode = is_write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    while (syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) < 0) {
+      if (errno != EINTR && errno != EAGAIN) {
+        MS_LOG(EXCEPTION) << "Submit the io request failed, errno: " << errno;
+      }
+    }
+    return true;
+  }
+
+  // Get a finished request, wait for one if wait is true.
+  bool Complete(bool wait, uint64_t *user_data, int64_t *result) {
+    while (true) {
+      unsigned head = *cq_head_;
+      if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        const auto &cqe = cqes_[head & cq_mask_];
+        *user_data = cqe.user_data;
+        *result = cqe.res;
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return true;
+      }
+      if (!wait) {
+        return false;
+      }
+      if (syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+        MS_LOG(EXCEPTION) << "Wait for the io requests failed, errno: " << errno;
+      }
+    }
+  }
+
+ private:
+  void *Map(size_t size, off_t offset) const {
+    auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return addr == MAP_FAILED ? nullptr : addr;
+  }
+
+  int ring_fd_{-1};
+  void *sq_ptr_{nullptr};
+  void *cq_ptr_{nullptr};
+  size_t sq_size_{0};
+  size_t cq_size_{0};
+  io_uring_sqe *sqes_{nullptr};
+  size_t sqes_size_{0};
+  unsigned *sq_head_{nullptr};
+  unsigned *sq_tail_{nullptr};
+  unsigned *sq_array_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned sq_entries_{0};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned cq_mask_{0};
+  io_uring_cqe *cqes_{nullptr};
+};
+
+NvmeMemHandler::NvmeMemHandler(const std::string &arena_dir, size_t device_mem_size)
+    : device_mem_size_(device_mem_size) {
+  std::string file_template = arena_dir + "/mindspore_swap_XXXXXX";
+  std::vector<char> file_name(file_template.begin(), file_template.end());
+  file_name.push_back('\0');
+  // Bypass the page cache, or the swapped data would take the memory again.
+  fd_ = mkostemp(file_name.data(), O_DIRECT);
+  if (fd_ < 0) {
+    file_name.assign(file_template.begin(), file_template.end());
+    file_name.push_back('\0');
+    fd_ = mkstemp(file_name.data());
+  }
+  if (fd_ < 0) {
+    MS_LOG(EXCEPTION) << "Create the swap file in " << arena_dir << " failed, errno: " << errno;
+  }
+  arena_file_ = file_name.data();
+  // The file is removed when it is closed.
+  (void)unlink(arena_file_.c_str());
+  auto base = mmap(nullptr, kArenaReservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (base == MAP_FAILED) {
+    (void)close(fd_);
+    MS_LOG(EXCEPTION) << "Reserve the address range of the swap file failed, errno: " << errno;
+  }
+  arena_base_ = static_cast<uint8_t *>(base);
+  ring_ = std::make_unique<IoUring>();
+  if (!ring_->Init(kRingEntries)) {
+    MS_LOG(WARNING) << "io_uring is not supported, the swap file is accessed synchronously.";
+    ring_ = nullptr;
+  }
+  MS_LOG(INFO) << "Swap the memory beyond " << device_mem_size_ << " bytes to " << arena_file_;
+}
+
+NvmeMemHandler::~NvmeMemHandler() {
+  while (inflight_io_ > 0) {
+    ReapIo(true);
+  }
+  for (auto &item : buffer_size_) {
+    std::free(const_cast<void *>(item.first));
+  }
+  ring_ = nullptr;
+  (void)munmap(arena_base_, kArenaReservedSize);
+  (void)close(fd_);
+}
+
+size_t NvmeMemHandler::GetAvailableMemSize() { return device_mem_size_ - device_mem_used_; }
+
+bool NvmeMemHandler::IsArenaPtr(const void *ptr) const {
+  auto addr = static_cast<const uint8_t *>(ptr);
+  return addr >= arena_base_ && addr < arena_base_ + kArenaReservedSize;
+}
+
+size_t NvmeMemHandler::ArenaOffset(const void *ptr) const {
+  return static_cast<size_t>(static_cast<const uint8_t *>(ptr) - arena_base_);
+}
+
+uint8_t *NvmeMemHandler::AllocBuffer(size_t mem_size) {
+  auto size = AlignUp(mem_size);
+  if (device_mem_used_ + size > device_mem_size_) {
+    // The memory of the running swap outs is released when they are done, and the prefetched data is dropped from
+    // the latest one, whose swap in is the farthest, because the memory scheduler plans with the whole budget.
+    auto start = std::chrono::steady_clock::now();
+    while (device_mem_used_ + size > device_mem_size_) {
+      if (!buffers_to_free_.empty()) {
+        ReapIo(true);
+        continue;
+      }
+      if (prefetches_.empty()) {
+        break;
+      }
+      auto latest = std::max_element(
+        prefetches_.begin(), prefetches_.end(),
+        [](const std::pair<const size_t, uint64_t> &a, const std::pair<const size_t, uint64_t> &b) {
+          return a.second < b.second;
+        });
+      DropPrefetch(latest->first);
+    }
+    statistics_.stall_time += ElapsedMicroseconds(start);
+  }
+  if (device_mem_used_ + size > device_mem_size_) {
+    return nullptr;
+  }
+  auto buffer = static_cast<uint8_t *>(std::aligned_alloc(kIoAlignment, size));
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  buffer_size_[buffer] = size;
+  device_mem_used_ += size;
+  return buffer;
+}
+
+void NvmeMemHandler::ReleaseBuffer(uint8_t *buffer) {
+  auto iter = buffer_size_.find(buffer);
+  if (iter == buffer_size_.end()) {
+    MS_LOG(EXCEPTION) << "The memory " << static_cast<void *>(buffer) << " is not malloced by the handler.";
+  }
+  device_mem_used_ -= iter->second;
+  (void)buffer_size_.erase(iter);
+  std::free(buffer);
+}
+
+void *NvmeMemHandler::MallocDevice(size_t mem_size) {
+  ReapIo(false);
+  return AllocBuffer(mem_size);
+}
+
+void NvmeMemHandler::FreeDevice(void *ptr) {
+  for (auto &item : io_requests_) {
+    if (item.second.buffer == ptr && !item.second.done) {
+      buffers_to_free_[item.first] = static_cast<uint8_t *>(ptr);
+      return;
+    }
+  }
+  ReleaseBuffer(static_cast<uint8_t *>(ptr));
+}
+
+void *NvmeMemHandler::MallocHost(size_t mem_size) {
+  auto size = AlignUp(mem_size);
+  size_t offset = arena_end_;
+  auto iter = std::find_if(arena_free_.begin(), arena_free_.end(),
+                           [size](const std::pair<const size_t, size_t> &range) { return range.second >= size; });
+  if (iter != arena_free_.end()) {
+    offset = iter->first;
+    if (iter->second > size) {
+      arena_free_[offset + size] = iter->second - size;
+    }
+    (void)arena_free_.erase(iter);
+  } else {
+    if (arena_end_ + size > kArenaReservedSize) {
+      MS_LOG(EXCEPTION) << "The swap file exceeds " << kArenaReservedSize << " bytes.";
+    }
+    arena_end_ += size;
+  }
+  arena_used_[offset] = size;
+  return arena_base_ + offset;
+}
+
+void NvmeMemHandler::FreeHost(void *ptr) {
+  auto offset = ArenaOffset(ptr);
+  DropPrefetch(offset);
+  auto iter = pending_writes_.find(offset);
+  if (iter != pending_writes_.end()) {
+    arena_to_free_[iter->second] = offset;
+    return;
+  }
+  ReleaseArena(offset);
+}
+
+void NvmeMemHandler::ReleaseArena(size_t offset) {
+  auto used_iter = arena_used_.find(offset);
+  if (used_iter == arena_used_.end()) {
+    MS_LOG(EXCEPTION) << "The offset " << offset << " of the swap file is not malloced by the handler.";
+  }
+  auto size = used_iter->second;
+  (void)arena_used_.erase(used_iter);
+  // Merge the range with the free ranges around it.
+  auto next = arena_free_.find(offset + size);
+  if (next != arena_free_.end()) {
+    size += next->second;
+    (void)arena_free_.erase(next);
+  }
+  auto prev = arena_free_.lower_bound(offset);
+  if (prev != arena_free_.begin() && (--prev)->first + prev->second == offset) {
+    offset = prev->first;
+    size += prev->second;
+    (void)arena_free_.erase(prev);
+  }
+  if (offset + size == arena_end_) {
+    arena_end_ = offset;
+  } else {
+    arena_free_[offset] = size;
+  }
+}
+
+uint64_t NvmeMemHandler::SubmitIo(bool is_write, uint8_t *buffer, size_t offset, size_t size) {
+  auto id = next_io_id_++;
+  auto &request = io_requests_[id];
+  request.is_write = is_write;
+  request.buffer = buffer;
+  request.offset = offset;
+  request.size = size;
+  if (is_write) {
+    pending_writes_[offset] = id;
+  }
+  if (ring_ != nullptr) {
+    while (inflight_io_ >= kRingEntries) {
+      ReapIo(true);
+    }
+    if (ring_->Submit(is_write, fd_, buffer, size, offset, id)) {
+      ++inflight_io_;
+      return id;
+    }
+  }
+  SyncIo(fd_, is_write, buffer, offset, size);
+  OnIoDone(id, static_cast<int64_t>(size));
+  return id;
+}
+
+void NvmeMemHandler::WaitIo(uint64_t id) {
+  auto iter = io_requests_.find(id);
+  while (iter != io_requests_.end() && !iter->second.done) {
+    ReapIo(true);
+    iter = io_requests_.find(id);
+  }
+}
+
+void NvmeMemHandler::ReapIo(bool wait) {
+  if (ring_ == nullptr || inflight_io_ == 0) {
+    return;
+  }
+  uint64_t id = 0;
+  int64_t result = 0;
+  while (ring_->Complete(wait, &id, &result)) {
+    --inflight_io_;
+    OnIoDone(id, result);
+    wait = false;
+    if (inflight_io_ == 0) {
+      break;
+    }
+  }
+}
+
+void NvmeMemHandler::OnIoDone(uint64_t id, int64_t result) {
+  auto iter = io_requests_.find(id);
+  if (iter == io_requests_.end()) {
+    MS_LOG(EXCEPTION) << "Unknown io request " << id;
+  }
+  auto &request = iter->second;
+  auto done = result > 0 ? static_cast<size_t>(result) : 0;
+  if (done < request.size) {
+    // A short or failed asynchronous access, finish it synchronously.
+    SyncIo(fd_, request.is_write, request.buffer + done, request.offset + done, request.size - done);
+  }
+  request.done = true;
+  auto write_iter = pending_writes_.find(request.offset);
+  if (request.is_write && write_iter != pending_writes_.end() && write_iter->second == id) {
+    (void)pending_writes_.erase(write_iter);
+  }
+  auto arena_iter = arena_to_free_.find(id);
+  if (arena_iter != arena_to_free_.end()) {
+    ReleaseArena(arena_iter->second);
+    (void)arena_to_free_.erase(arena_iter);
+  }
+  auto buffer_iter = buffers_to_free_.find(id);
+  bool orphan = buffer_iter != buffers_to_free_.end();
+  if (orphan) {
+    ReleaseBuffer(buffer_iter->second);
+    (void)buffers_to_free_.erase(buffer_iter);
+  }
+  // The reads which are not orphans are released by their owners.
+  if (request.is_write || orphan) {
+    (void)io_requests_.erase(iter);
+  }
+}
+
+void NvmeMemHandler::DropPrefetch(size_t offset) {
+  auto iter = prefetches_.find(offset);
+  if (iter == prefetches_.end()) {
+    return;
+  }
+  auto id = iter->second;
+  (void)prefetches_.erase(iter);
+  auto &request = io_requests_[id];
+  if (!request.done) {
+    buffers_to_free_[id] = request.buffer;
+    return;
+  }
+  ReleaseBuffer(request.buffer);
+  (void)io_requests_.erase(id);
+}
+
+void NvmeMemHandler::SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *) {
+  MS_EXCEPTION_IF_NULL(host_ptr);
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  if (!IsArenaPtr(host_ptr)) {
+    auto ret = memcpy_s(device_ptr, mem_size, host_ptr, mem_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Swap in the memory failed, memcpy_s errorno: " << ret;
+    }
+    return;
+  }
+  ReapIo(false);
+  auto offset = ArenaOffset(host_ptr);
+  statistics_.swap_in_bytes += mem_size;
+  ++statistics_.swap_in_count;
+  const uint8_t *src = nullptr;
+  auto write_iter = pending_writes_.find(offset);
+  auto prefetch_iter = prefetches_.find(offset);
+  auto start = std::chrono::steady_clock::now();
+  if (write_iter != pending_writes_.end()) {
+    // The data is still in the memory of the swap out.
+    src = io_requests_[write_iter->second].buffer;
+    ++statistics_.prefetch_hit_count;
+  } else if (prefetch_iter != prefetches_.end()) {
+    WaitIo(prefetch_iter->second);
+    src = io_requests_[prefetch_iter->second].buffer;
+    ++statistics_.prefetch_hit_count;
+  } else {
+    auto id = SubmitIo(false, static_cast<uint8_t *>(device_ptr), offset, AlignUp(mem_size));
+    WaitIo(id);
+    (void)io_requests_.erase(id);
+  }
+  if (src != nullptr) {
+    auto ret = memcpy_s(device_ptr, mem_size, src, mem_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Swap in the memory failed, memcpy_s errorno: " << ret;
+    }
+    DropPrefetch(offset);
+  }
+  statistics_.stall_time += ElapsedMicroseconds(start);
+}
+
+void NvmeMemHandler::SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *) {
+  MS_EXCEPTION_IF_NULL(host_ptr);
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  if (!IsArenaPtr(host_ptr)) {
+    auto ret = memcpy_s(host_ptr, mem_size, device_ptr, mem_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Swap out the memory failed, memcpy_s errorno: " << ret;
+    }
+    return;
+  }
+  auto offset = ArenaOffset(host_ptr);
+  DropPrefetch(offset);
+  auto write_iter = pending_writes_.find(offset);
+  if (write_iter != pending_writes_.end()) {
+    WaitIo(write_iter->second);
+  }
+  statistics_.swap_out_bytes += mem_size;
+  (void)SubmitIo(true, static_cast<uint8_t *>(const_cast<void *>(device_ptr)), offset, AlignUp(mem_size));
+}
+
+void NvmeMemHandler::Prefetch(const void *host_ptr, size_t mem_size) {
+  if (host_ptr == nullptr || !IsArenaPtr(host_ptr)) {
+    return;
+  }
+  ReapIo(false);
+  auto offset = ArenaOffset(host_ptr);
+  if (prefetches_.count(offset) > 0 || pending_writes_.count(offset) > 0) {
+    return;
+  }
+  // Never wait for memory here, the prefetch is only done when the memory is free.
+  auto size = AlignUp(mem_size);
+  if (device_mem_used_ + size > device_mem_size_) {
+    return;
+  }
+  auto buffer = AllocBuffer(size);
+  if (buffer == nullptr) {
+    return;
+  }
+  prefetches_[offset] = SubmitIo(false, buffer, offset, size);
+}
+
+SwapStatistics NvmeMemHandler::TakeStatistics() {
+  auto statistics = statistics_;
+  statistics_ = SwapStatistics();
+  MS_LOG(INFO) << "Swap in " << statistics.swap_in_bytes << " bytes " << statistics.swap_in_count << " times, "
+               << statistics.prefetch_hit_count << " times prefetched, swap out " << statistics.swap_out_bytes
+               << " bytes, stall " << statistics.stall_time << " us.";
+  return statistics;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
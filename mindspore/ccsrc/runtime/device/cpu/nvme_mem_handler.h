@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_NVME_MEM_HANDLER_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_NVME_MEM_HANDLER_H_
+#include <map>
+#include <memory>
+#include <string>
+#include "runtime/device/memory_scheduler.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class IoUring;
+
+struct SwapStatistics {
+  size_t swap_in_bytes{0};
+  size_t swap_out_bytes{0};
+  size_t swap_in_count{0};
+  // The swap in whose data was read by a prefetch, or was still in memory because its swap out was not finished.
+  size_t prefetch_hit_count{0};
+  // The time spent waiting for the file, in microseconds.
+  double stall_time{0};
+};
+
+// A MemHandler for the CPU whose device memory is the DRAM, limited to a budget, and whose host memory is an arena
+// in a file, which should be on a NVMe disk. The reads and writes of the arena are asynchronous through io_uring:
+// a swap out returns at once and the device memory is released when the write is done, a swap in uses the data read
+// in advance by Prefetch when the MemScheduler planned it early enough.
+class NvmeMemHandler : public MemHandler {
+ public:
+  NvmeMemHandler(const std::string &arena_dir, size_t device_mem_size);
+  ~NvmeMemHandler();
+
+  size_t GetAvailableMemSize() override;
+  void *MallocDevice(size_t mem_size) override;
+  void FreeDevice(void *ptr) override;
+  // The returned address is a handle of the arena which can not be accessed.
+  void *MallocHost(size_t mem_size) override;
+  void FreeHost(void *ptr) override;
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override;
+  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override;
+  void Prefetch(const void *host_ptr, size_t mem_size) override;
+
+  // Get the statistics since the last call, such as the ones of a training step, and reset them.
+  SwapStatistics TakeStatistics();
+
+ private:
+  struct IoRequest {
+    bool is_write{false};
+    uint8_t *buffer{nullptr};
+    size_t offset{0};
+    size_t size{0};
+    bool done{false};
+  };
+
+  bool IsArenaPtr(const void *ptr) const;
+  size_t ArenaOffset(const void *ptr) const;
+  uint8_t *AllocBuffer(size_t mem_size);
+  void ReleaseBuffer(uint8_t *buffer);
+  uint64_t SubmitIo(bool is_write, uint8_t *buffer, size_t offset, size_t size);
+  void WaitIo(uint64_t id);
+  // Handle the finished requests, wait for one of them if wait is true and some are running.
+  void ReapIo(bool wait);
+  void OnIoDone(uint64_t id, int64_t result);
+  void ReleaseArena(size_t offset);
+  void DropPrefetch(size_t offset);
+
+  std::string arena_file_;
+  int fd_{-1};
+  size_t device_mem_size_;
+  size_t device_mem_used_{0};
+  uint8_t *arena_base_{nullptr};
+  size_t arena_end_{0};
+  std::unique_ptr<IoUring> ring_;
+  unsigned inflight_io_{0};
+
+  std::map<const void *, size_t> buffer_size_;
+  // The free ranges of the arena, from the offset to the size.
+  std::map<size_t, size_t> arena_free_;
+  std::map<size_t, size_t> arena_used_;
+
+  uint64_t next_io_id_{1};
+  std::map<uint64_t, IoRequest> io_requests_;
+  // The running write of each range of the arena, its buffer can be used instead of reading the file.
+  std::map<size_t, uint64_t> pending_writes_;
+  // The prefetched or prefetching data of each range of the arena.
+  std::map<size_t, uint64_t> prefetches_;
+  // The buffers and ranges freed while a request used them, they are released when the request is done.
+  std::map<uint64_t, uint8_t *> buffers_to_free_;
+  std::map<uint64_t, size_t> arena_to_free_;
+  SwapStatistics statistics_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_NVME_MEM_HANDLER_H_
@@ -29,6 +29,7 @@ namespace {
 constexpr float kMaxMemReuseFactor = 0.9;
 constexpr float kMinMemReuseFactor = 0.5;
 constexpr float kRetryFactor = 0.1;
+constexpr size_t kPrefetchStepNum = 4;
 
 double GetCurrentTime() {
 #ifdef _MSC_VER
@@ -202,9 +203,26 @@ bool MemScheduler::PostCompute(void *stream) {
     }
   }
   ++current_step_;
+  PrefetchSwapIn();
   return true;
 }
 
+void MemScheduler::PrefetchSwapIn() {
+  auto end_step = std::min(current_step_ + kPrefetchStepNum, total_step_);
+  for (size_t step = current_step_; step < end_step; ++step) {
+    for (auto &event : strategy_->GetPreComputeEvents(step)) {
+      MS_EXCEPTION_IF_NULL(event);
+      if (event->type != kSwapIn) {
+        continue;
+      }
+      auto iter = swap_host_ptr_.find(event->key);
+      if (iter != swap_host_ptr_.end()) {
+        mem_handler_->Prefetch(iter->second, event->mem_size);
+      }
+    }
+  }
+}
+
 void MemScheduler::OptMemUsage(float mem_used_factor) {
   mem_used_factor_ = mem_used_factor;
   MS_EXCEPTION_IF_NULL(mem_handler_);
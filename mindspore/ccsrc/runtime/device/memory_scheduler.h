@@ -34,6 +34,8 @@ class MemHandler {
   virtual void FreeHost(void *ptr) = 0;
   virtual void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) = 0;
   virtual void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) = 0;
+  // A hint that the host memory will be swapped in soon.
+  virtual void Prefetch(const void *host_ptr, size_t mem_size) {}
 };
 
 class MemScheduler {
@@ -79,6 +81,8 @@ class MemScheduler {
 
   void OptMemUsage(float mem_used_factor = 1.0f);
 
+  void PrefetchSwapIn();
+
   std::map<const void *, MemPriority> mem_priority_;
   std::map<const void *, std::vector<std::shared_ptr<MemEvent>>> mem_events_;
   std::vector<std::vector<std::shared_ptr<MemEvent>>> step_events_;
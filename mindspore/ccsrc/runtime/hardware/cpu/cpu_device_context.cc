@@ -18,7 +18,7 @@
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
-#include "backend/kernel_compiler/akg/cpu/akg_cpu_kernel_build.h"
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_kernel_mod.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
@@ -127,9 +127,9 @@ void CPUDeviceContext::OptimizeGraph(const KernelGraphPtr &graph) const {
   // Run final optimization.
   opt::CommonFinalOptimization(graph);
 
-#ifdef ENABLE_AKG
+#ifdef ENABLE_CPU_GRAPH_KERNEL
   // Run graph kernel fusion optimization
-  if (graphkernel::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+  if (kernel::IsEnableCpuGraphKernel()) {
     graphkernel::GraphKernelOptimize(graph);
     graph->SetExecOrderByDefault();
   }
@@ -230,9 +230,8 @@ void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
     cpu_dynamic_kernel->Initialize();
     AnfAlgo::SetKernelMod(cpu_kernel, node.get());
   }
-#ifdef ENABLE_AKG
-  kernel::AkgCpuKernelBuilder akg_cpu_kernel_builder;
-  (void)akg_cpu_kernel_builder.AkgKernelParallelBuild(akg_nodes);
+#ifdef ENABLE_CPU_GRAPH_KERNEL
+  kernel::CpuGraphKernelBuild(akg_nodes);
 #endif
 }
 
@@ -0,0 +1,396 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint_engine.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+#include "utils/scoped_long_running.h"
+#include "utils/system/crc32c.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr char kMagic[] = "MSCKPT01";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kHeaderSize = kMagicSize + 3 * sizeof(uint64_t);
+constexpr uint64_t kDataAlignment = 64;
+// The unit of the parallel writes and of the crc check, small enough for memcpy_s.
+constexpr uint64_t kChunkSize = 64ull << 20;
+constexpr size_t kMaxWriteThreads = 8;
+
+uint64_t AlignUp(uint64_t value) { return (value + kDataAlignment - 1) / kDataAlignment * kDataAlignment; }
+
+uint32_t Crc32c(const uint8_t *data, size_t size) {
+  return system::Crc32c::MakeCrc32c(0, reinterpret_cast<const char *>(data), size);
+}
+
+template <typename T>
+void Append(const T &value, std::string *buffer) {
+  (void)buffer->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendString(const std::string &value, std::string *buffer) {
+  Append(static_cast<uint32_t>(value.size()), buffer);
+  (void)buffer->append(value);
+}
+
+// Read the fields of the index, every read checks the bounds.
+class IndexParser {
+ public:
+  IndexParser(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+  ~IndexParser() = default;
+
+  template <typename T>
+  bool Get(T *value) {
+    if (size_ - pos_ < sizeof(T)) {
+      return false;
+    }
+    auto ret = memcpy_s(value, sizeof(T), data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return ret == EOK;
+  }
+
+  bool GetString(std::string *value) {
+    uint32_t length = 0;
+    if (!Get(&length) || size_ - pos_ < length) {
+      return false;
+    }
+    value->assign(reinterpret_cast<const char *>(data_ + pos_), length);
+    pos_ += length;
+    return true;
+  }
+
+  size_t pos() const { return pos_; }
+
+ private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+bool WriteAll(int fd, const uint8_t *data, uint64_t size, uint64_t offset) {
+  while (size > 0) {
+    auto written = pwrite(fd, data, static_cast<size_t>(std::min(size, kChunkSize)), static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= static_cast<uint64_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+  return true;
+}
+}  // namespace
+
+bool IsNativeCheckpoint(const std::string &file_name) {
+  std::ifstream fin(file_name, std::ios::binary);
+  char magic[kMagicSize] = {0};
+  return fin.read(magic, kMagicSize) && std::string(magic, kMagicSize) == kMagic;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string &file_name, size_t thread_num)
+    : file_name_(file_name), thread_num_(thread_num) {
+  if (thread_num_ == 0) {
+    thread_num_ = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), kMaxWriteThreads);
+  }
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (save_thread_.joinable()) {
+    save_thread_.join();
+  }
+}
+
+void CheckpointWriter::Add(const std::string &name, const tensor::TensorPtr &tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  if (running_ || save_thread_.joinable()) {
+    MS_LOG(EXCEPTION) << "Can not add " << name << " to the checkpoint " << file_name_ << " which is saved.";
+  }
+  tensor->data_sync();
+  CheckpointEntry entry;
+  entry.name = name;
+  entry.type_name = TypeIdToType(tensor->data_type())->ToString();
+  entry.shape = tensor->shape();
+  entry.size = tensor->Size();
+  entries_.push_back(std::move(entry));
+  tensors_.push_back(tensor);
+}
+
+bool CheckpointWriter::Save(bool async) {
+  if (running_ || save_thread_.joinable()) {
+    MS_LOG(ERROR) << "The checkpoint " << file_name_ << " has been saved.";
+    return false;
+  }
+  running_ = true;
+  if (async) {
+    save_thread_ = std::thread([this]() {
+      succeeded_ = Write();
+      running_ = false;
+    });
+    return true;
+  }
+  ScopedLongRunning long_running;
+  succeeded_ = Write();
+  running_ = false;
+  return succeeded_;
+}
+
+bool CheckpointWriter::Wait() {
+  if (save_thread_.joinable()) {
+    ScopedLongRunning long_running;
+    save_thread_.join();
+  }
+  return succeeded_;
+}
+
+bool CheckpointWriter::Write() {
+  // Lay out the data and cut it into chunks.
+  uint64_t offset = AlignUp(kHeaderSize);
+  std::vector<std::pair<size_t, uint64_t>> chunks;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    auto &entry = entries_[i];
+    entry.offset = offset;
+    offset = AlignUp(offset + entry.size);
+    entry.chunk_crcs.resize((entry.size + kChunkSize - 1) / kChunkSize);
+    for (uint64_t chunk = 0; chunk < entry.chunk_crcs.size(); ++chunk) {
+      (void)chunks.emplace_back(i, chunk);
+    }
+  }
+  auto index_offset = offset;
+  auto tmp_file_name = file_name_ + ".tmp";
+  int fd = open(tmp_file_name.c_str(), O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open the checkpoint file " << tmp_file_name << " failed, errno: " << errno;
+    return false;
+  }
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> write_ok{true};
+  auto write_chunks = [this, fd, &chunks, &next_chunk, &write_ok]() {
+    // The tensor may be updated while it is written, so the crc and the write are both done on a staged copy.
+    std::vector<uint8_t> stage;
+    for (size_t i = next_chunk++; i < chunks.size() && write_ok; i = next_chunk++) {
+      auto &entry = entries_[chunks[i].first];
+      auto begin = chunks[i].second * kChunkSize;
+      auto size = std::min(kChunkSize, entry.size - begin);
+      stage.resize(static_cast<size_t>(size));
+      const auto *data = static_cast<const uint8_t *>(tensors_[chunks[i].first]->data_c()) + begin;
+      if (size > 0 && memcpy_s(stage.data(), stage.size(), data, static_cast<size_t>(size)) != EOK) {
+        write_ok = false;
+        break;
+      }
+      entry.chunk_crcs[chunks[i].second] = Crc32c(stage.data(), stage.size());
+      if (!WriteAll(fd, stage.data(), size, entry.offset + begin)) {
+        write_ok = false;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(thread_num_, chunks.size()); ++i) {
+    (void)threads.emplace_back(write_chunks);
+  }
+  write_chunks();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // The data is written, the tensors are not held any longer.
+  tensors_.clear();
+
+  std::string index;
+  Append(static_cast<uint64_t>(entries_.size()), &index);
+  for (const auto &entry : entries_) {
+    AppendString(entry.name, &index);
+    AppendString(entry.type_name, &index);
+    Append(static_cast<uint32_t>(entry.shape.size()), &index);
+    for (auto dim : entry.shape) {
+      Append(static_cast<int64_t>(dim), &index);
+    }
+    Append(entry.offset, &index);
+    Append(entry.size, &index);
+    for (auto crc : entry.chunk_crcs) {
+      Append(crc, &index);
+    }
+  }
+  Append(Crc32c(reinterpret_cast<const uint8_t *>(index.data()), index.size()), &index);
+  std::string header(kMagic, kMagicSize);
+  Append(kChunkSize, &header);
+  Append(index_offset, &header);
+  Append(static_cast<uint64_t>(index.size()), &header);
+  write_ok = write_ok && WriteAll(fd, reinterpret_cast<const uint8_t *>(index.data()), index.size(), index_offset) &&
+             WriteAll(fd, reinterpret_cast<const uint8_t *>(header.data()), header.size(), 0);
+  // Flush the file before it is renamed, so that a crash never leaves a renamed file whose data is not on the disk.
+  write_ok = write_ok && fsync(fd) == 0;
+  if (close(fd) != 0 || !write_ok) {
+    MS_LOG(ERROR) << "Write the checkpoint file " << tmp_file_name
+                  << " failed, the disk may be full or not be writable, errno: " << errno;
+    (void)std::remove(tmp_file_name.c_str());
+    return false;
+  }
+  if (std::rename(tmp_file_name.c_str(), file_name_.c_str()) != 0) {
+    MS_LOG(ERROR) << "Rename the checkpoint file " << tmp_file_name << " to " << file_name_
+                  << " failed, errno: " << errno;
+    (void)std::remove(tmp_file_name.c_str());
+    return false;
+  }
+  (void)chmod(file_name_.c_str(), S_IRUSR);
+  MS_LOG(INFO) << "Saved " << entries_.size() << " tensors of " << index_offset << " bytes to the checkpoint "
+               << file_name_ << ".";
+  return true;
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name) : file_name_(file_name) {}
+
+CheckpointReader::~CheckpointReader() {
+  if (addr_ != nullptr) {
+    (void)munmap(addr_, file_size_);
+    addr_ = nullptr;
+  }
+}
+
+bool CheckpointReader::Open() {
+  if (addr_ != nullptr) {
+    return true;
+  }
+  int fd = open(file_name_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open the checkpoint file " << file_name_ << " failed, errno: " << errno;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < kHeaderSize) {
+    MS_LOG(ERROR) << "The checkpoint file " << file_name_ << " is not a native checkpoint.";
+    (void)close(fd);
+    return false;
+  }
+  file_size_ = static_cast<size_t>(file_stat.st_size);
+  auto addr = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map the checkpoint file " << file_name_ << " failed, errno: " << errno;
+    return false;
+  }
+  addr_ = static_cast<uint8_t *>(addr);
+  IndexParser header(addr_, kHeaderSize);
+  uint64_t magic = 0;
+  uint64_t index_offset = 0;
+  uint64_t index_size = 0;
+  if (!header.Get(&magic) || !header.Get(&chunk_size_) || !header.Get(&index_offset) || !header.Get(&index_size) ||
+      std::string(reinterpret_cast<const char *>(addr_), kMagicSize) != kMagic || chunk_size_ == 0 ||
+      !ParseIndex(index_offset, index_size)) {
+    MS_LOG(ERROR) << "The checkpoint file " << file_name_ << " is broken or not a native checkpoint.";
+    (void)munmap(addr_, file_size_);
+    addr_ = nullptr;
+    entries_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool CheckpointReader::ParseIndex(uint64_t index_offset, uint64_t index_size) {
+  if (index_offset > file_size_ || index_size > file_size_ - index_offset || index_size < sizeof(uint32_t)) {
+    return false;
+  }
+  const uint8_t *index = addr_ + index_offset;
+  auto content_size = static_cast<size_t>(index_size - sizeof(uint32_t));
+  IndexParser parser(index, static_cast<size_t>(index_size));
+  uint64_t count = 0;
+  if (!parser.Get(&count)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    CheckpointEntry entry;
+    uint32_t rank = 0;
+    if (!parser.GetString(&entry.name) || !parser.GetString(&entry.type_name) || !parser.Get(&rank)) {
+      return false;
+    }
+    entry.shape.resize(rank);
+    for (auto &dim : entry.shape) {
+      int64_t value = 0;
+      if (!parser.Get(&value)) {
+        return false;
+      }
+      dim = value;
+    }
+    if (!parser.Get(&entry.offset) || !parser.Get(&entry.size) || entry.offset > file_size_ ||
+        entry.size > file_size_ - entry.offset || StringToType(entry.type_name) == nullptr) {
+      return false;
+    }
+    entry.chunk_crcs.resize((entry.size + chunk_size_ - 1) / chunk_size_);
+    for (auto &crc : entry.chunk_crcs) {
+      if (!parser.Get(&crc)) {
+        return false;
+      }
+    }
+    entries_.push_back(std::move(entry));
+  }
+  uint32_t index_crc = 0;
+  return parser.pos() == content_size && parser.Get(&index_crc) && index_crc == Crc32c(index, content_size);
+}
+
+std::vector<std::string> CheckpointReader::GetNames() const {
+  std::vector<std::string> names;
+  (void)std::transform(entries_.begin(), entries_.end(), std::back_inserter(names),
+                       [](const CheckpointEntry &entry) { return entry.name; });
+  return names;
+}
+
+tensor::TensorPtr CheckpointReader::Read(const std::string &name) const {
+  auto iter = std::find_if(entries_.begin(), entries_.end(),
+                           [&name](const CheckpointEntry &entry) { return entry.name == name; });
+  if (addr_ == nullptr || iter == entries_.end()) {
+    MS_LOG(EXCEPTION) << "There is no tensor " << name << " in the checkpoint file " << file_name_ << ".";
+  }
+  auto tensor = std::make_shared<tensor::Tensor>(StringToTypeId(iter->type_name), iter->shape);
+  if (tensor->Size() != iter->size) {
+    MS_LOG(EXCEPTION) << "The size of the tensor " << name << " in the checkpoint file " << file_name_ << " is "
+                      << iter->size << ", but its shape and type need " << tensor->Size() << " bytes.";
+  }
+  auto dst = static_cast<uint8_t *>(tensor->data_c());
+  const uint8_t *src = addr_ + iter->offset;
+  for (size_t chunk = 0; chunk < iter->chunk_crcs.size(); ++chunk) {
+    auto begin = chunk * chunk_size_;
+    auto size = static_cast<size_t>(std::min(chunk_size_, iter->size - begin));
+    if (Crc32c(src + begin, size) != iter->chunk_crcs[chunk]) {
+      MS_LOG(EXCEPTION) << "The data of the tensor " << name << " in the checkpoint file " << file_name_
+                        << " is broken, the crc check failed.";
+    }
+    auto ret = memcpy_s(dst + begin, size, src + begin, size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy the tensor " << name << " failed, memcpy_s errorno: " << ret;
+    }
+  }
+  // The tensor owns its data now, drop the pages of the file from the memory of the process.
+  auto page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  auto page_begin = (iter->offset + page_size - 1) / page_size * page_size;
+  auto page_end = (iter->offset + iter->size) / page_size * page_size;
+  if (page_end > page_begin) {
+    (void)madvise(addr_ + page_begin, page_end - page_begin, MADV_DONTNEED);
+  }
+  return tensor;
+}
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+// The native checkpoint file:
+//   header: magic "MSCKPT01" | uint64 chunk size | uint64 index offset | uint64 index size
+//   data:   the bytes of each tensor, starting at a multiple of kDataAlignment
+//   index:  uint64 count, then for each tensor: name, type name, shape, data offset, data size and the crc32c of each
+//           chunk of its data, followed by the crc32c of the index.
+// Strings are a uint32 length and the characters, a shape is a uint32 rank and int64 dims, all in little endian.
+// The type names are the ones of the .ckpt format, such as "Float32".
+struct CheckpointEntry {
+  std::string name;
+  std::string type_name;
+  ShapeVector shape;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+  std::vector<uint32_t> chunk_crcs;
+};
+
+// Whether the file starts with the magic of the native checkpoint.
+bool IsNativeCheckpoint(const std::string &file_name);
+
+// Write tensors to a native checkpoint by several threads, in the background if the save is asynchronous. The tensors
+// are written from their own memory and not copied when they are added, so as with the .ckpt format, a tensor updated
+// during an asynchronous save may be saved partly updated. Each thread stages a chunk at a time, the crc is the one of
+// the bytes written.
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::string &file_name, size_t thread_num = 0);
+  ~CheckpointWriter();
+
+  void Add(const std::string &name, const tensor::TensorPtr &tensor);
+  // Write the added tensors to a temporary file and rename it to the file name, the checkpoint is never partial.
+  bool Save(bool async);
+  // Wait for the end of the asynchronous save, return whether the save succeeded.
+  bool Wait();
+  bool IsRunning() const { return running_; }
+
+ private:
+  bool Write();
+
+  std::string file_name_;
+  size_t thread_num_;
+  std::vector<CheckpointEntry> entries_;
+  std::vector<tensor::TensorPtr> tensors_;
+  std::thread save_thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> succeeded_{false};
+};
+using CheckpointWriterPtr = std::shared_ptr<CheckpointWriter>;
+
+// Read the tensors of a native checkpoint through mmap. Only the index is parsed when the file is opened, the data of
+// a tensor is verified and copied when it is read, and the pages are released afterwards.
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader();
+
+  bool Open();
+  std::vector<std::string> GetNames() const;
+  tensor::TensorPtr Read(const std::string &name) const;
+
+ private:
+  bool ParseIndex(uint64_t index_offset, uint64_t index_size);
+
+  std::string file_name_;
+  uint8_t *addr_ = nullptr;
+  size_t file_size_ = 0;
+  uint64_t chunk_size_ = 0;
+  std::vector<CheckpointEntry> entries_;
+};
+using CheckpointReaderPtr = std::shared_ptr<CheckpointReader>;
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
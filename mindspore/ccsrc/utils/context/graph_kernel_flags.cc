@@ -209,6 +209,7 @@ void GraphKernelFlags::RegisterFlags(std::map<std::string, std::string> *flag_ma
   reg.AddFlag("enable_parallel_fusion", &enable_parallel_fusion, opt_level == OptLevel_3);
   reg.AddFlag("enable_low_precision", &enable_low_precision);
   reg.AddFlag("enable_trans_op_optimize", &enable_trans_op_optimize);
+  reg.AddFlag("enable_native_cpu_codegen", &enable_native_cpu_codegen);
 
   // Integer flags
   reg.AddFlag("online_tuning", &online_tuning);
@@ -240,6 +241,7 @@ std::string GraphKernelFlags::DumpAllFlags() const {
   json["enable_parallel_fusion"] = enable_parallel_fusion;
   json["enable_low_precision"] = enable_low_precision;
   json["enable_trans_op_optimize"] = enable_trans_op_optimize;
+  json["enable_native_cpu_codegen"] = enable_native_cpu_codegen;
 
   json["opt_level"] = opt_level;
   json["fusion_ops_level"] = fusion_ops_level;
@@ -109,6 +109,12 @@ class GraphKernelFlags {
    */
   bool enable_trans_op_optimize{false};
 
+  /**
+   * Build the CPU kernels by the built-in loop fusion instead of AKG, the kernels it does not support are still built
+   * by AKG. Without AKG, the graph kernel fusion runs on CPU only if this flag is set.
+   */
+  bool enable_native_cpu_codegen{false};
+
   /**
    * Optimization level, value from 0 to 3.
    * 0: Disable GraphKernel
@@ -273,6 +273,15 @@ class _Context:
             raise ValueError("For 'context.set_context', the argument 'max_device_memory' should not be \"0GB\".")
         self.set_param(ms_ctx_param.max_device_memory, max_device_memory_value)
 
+    def set_recompute_memory_budget(self, recompute_memory_budget):
+        if recompute_memory_budget != "0GB" and not Validator.check_str_by_regular(recompute_memory_budget,
+                                                                                   _re_pattern):
+            raise ValueError("For 'context.set_context', the argument 'recompute_memory_budget' should be in correct"
+                             " format! It must be a string ending with 'GB', in addition to that, it must contain "
+                             "only numbers or decimal points, such as \"5GB\" or \"3.5GB\", but got {}."
+                             .format(recompute_memory_budget))
+        self.set_param(ms_ctx_param.recompute_memory_budget, float(recompute_memory_budget[:-2]))
+
     def set_print_file_path(self, file_path):
         """Add timestamp suffix to file name. Sets print file path."""
         print_file_path = os.path.realpath(file_path)
@@ -317,6 +326,7 @@ class _Context:
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
+        'recompute_memory_budget': set_recompute_memory_budget,
         'print_file_path': set_print_file_path,
         'env_config_path': set_env_config_path
     }
@@ -373,7 +383,7 @@ def _context():
                  search_mode=str, parameter_broadcast=bool, strategy_ckpt_load_file=str,
                  strategy_ckpt_save_file=str, full_batch=bool, enable_parallel_optimizer=bool,
                  all_reduce_fusion_config=list, pipeline_stages=int, grad_accumulation_step=int,
-                 parallel_optimizer_config=dict)
+                 parallel_optimizer_config=dict, pipeline_interleave_num=int, pipeline_micro_batch_order=str)
 def set_auto_parallel_context(**kwargs):
     r"""
     Set auto parallel context, which is valid only for Ascend and GPU target.
@@ -401,6 +411,8 @@ def set_auto_parallel_context(**kwargs):
     enable_parallel_optimizer    dataset_strategy
     parallel_optimizer_config    pipeline_stages
                \                 grad_accumulation_step
+               \                 pipeline_interleave_num
+               \                 pipeline_micro_batch_order
     ===========================  ===========================
 
     Args:
@@ -456,6 +468,16 @@ def set_auto_parallel_context(**kwargs):
                         distributed alone in the pipeline. The total devices will be divided into 'pipeline_stags'
                         stages. Currently, this could only be used when parallel mode semi_auto_parallel is enabled.
                         Default: 1.
+        pipeline_interleave_num (int): Set the number of the chunks of each pipeline stage. The cells are given
+                        'pipeline_stages' * 'pipeline_interleave_num' stages, and the stage s of them runs on the
+                        devices of the stage s % 'pipeline_stages'. More chunks make the pipeline bubbles smaller with
+                        the interleaved 1F1B schedule, at the cost of more communication. The micro batch number must
+                        be a multiple of 'pipeline_stages' when it is larger than 1. Default: 1.
+        pipeline_micro_batch_order (str): The order of the micro batches on the chunks of the pipeline stages,
+                        "depth_first" or "breadth_first". With "depth_first", a group of 'pipeline_stages' micro
+                        batches goes through the chunks one after another, which keeps fewer activations. With
+                        "breadth_first", all the micro batches go through a chunk before the next chunk.
+                        Default: "depth_first".
         grad_accumulation_step (int): Set the accumulation steps of gradients in auto and semi auto parallel mode.
                         This should be a positive int. Default: 1.
         parallel_optimizer_config (dict): A dict contains the keys and values for setting the parallel optimizer
@@ -492,6 +514,8 @@ def set_auto_parallel_context(**kwargs):
         >>> context.set_auto_parallel_context(enable_parallel_optimizer=False)
         >>> context.set_auto_parallel_context(all_reduce_fusion_config=[8, 160])
         >>> context.set_auto_parallel_context(pipeline_stages=2)
+        >>> context.set_auto_parallel_context(pipeline_interleave_num=2)
+        >>> context.set_auto_parallel_context(pipeline_micro_batch_order="depth_first")
         >>> parallel_config = {"gradient_accumulation_shard": True}
         >>> context.set_auto_parallel_context(parallel_optimizer_config=parallel_config, enable_parallel_optimizer=True)
     """
@@ -535,6 +559,8 @@ def reset_auto_parallel_context():
     - full_batch: False.
     - enable_parallel_optimizer: False.
     - pipeline_stages: 1.
+    - pipeline_interleave_num: 1.
+    - pipeline_micro_batch_order: 'depth_first'.
     """
     _reset_auto_parallel_context()
 
@@ -573,7 +599,8 @@ def _check_target_specific_cfgs(device, arg_key):
                  enable_graph_kernel=bool, reserve_class_name_in_scope=bool, check_bprop=bool,
                  max_device_memory=str, print_file_path=str, enable_sparse=bool, max_call_depth=int,
                  env_config_path=str, graph_kernel_flags=str, enable_compile_cache=bool,
-                 compile_cache_path=str, grad_for_scalar=bool, pynative_synchronize=bool)
+                 compile_cache_path=str, grad_for_scalar=bool, pynative_synchronize=bool,
+                 recompute_memory_budget=str)
 def set_context(**kwargs):
     """
     Set context for running environment.
@@ -642,6 +669,8 @@ def set_context(**kwargs):
     |                         |  enable_compile_cache        |  CPU/GPU/Ascend            |
     |                         +------------------------------+----------------------------+
     |                         |  compile_cache_path          |  CPU/GPU/Ascend            |
+    |                         +------------------------------+----------------------------+
+    |                         |  recompute_memory_budget     |  CPU/GPU/Ascend            |
     +-------------------------+------------------------------+----------------------------+
 
     Args:
@@ -778,6 +807,12 @@ def set_context(**kwargs):
             If the specified directory does not exist, the system will automatically create the directory.
             The cache will be saved to the directory of `compile_cache_path/rank_${rank_id}/`. The `rank_id` is
             the ID of the current device in the cluster.
+        recompute_memory_budget (str): The memory budget of the activations kept for the backward pass in graph mode
+            training, the format is "xxGB". Default: "0GB", which disables the automatic recomputation.
+            When the estimated size of the forward activations used by the backward pass exceeds the budget, the
+            forward operators with the most memory saved per recomputed FLOP are recomputed in the backward pass,
+            in addition to the ones set by `Cell.recompute` or `Primitive.recompute`. The predicted memory saving and
+            extra computation are printed in the INFO log.
     Raises:
         ValueError: If input key is not an attribute in context.
 
@@ -805,6 +840,7 @@ def set_context(**kwargs):
         >>> context.set_context(grad_for_scalar=True)
         >>> context.set_context(enable_compile_cache=True, compile_cache_path="./cache.ms")
         >>> context.set_context(pynative_synchronize=True)
+        >>> context.set_context(recompute_memory_budget="10GB")
     """
     ctx = _context()
     # set device target first
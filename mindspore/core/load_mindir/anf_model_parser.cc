@@ -15,6 +15,12 @@
  */
 
 #include "load_mindir/anf_model_parser.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include <climits>
 #include <functional>
 #include <map>
@@ -240,6 +246,87 @@ string GetTypeString(const std::string &ref_attr_name, size_t *pos) {
   }
   return "";
 }
+
+#ifdef _WIN32
+constexpr bool kCanMapExternalData = false;
+#else
+constexpr bool kCanMapExternalData = true;
+#endif
+}  // namespace
+
+class MappedFile {
+ public:
+  MappedFile(void *addr, size_t size) : addr_(addr), size_(size) {}
+  ~MappedFile() {
+#ifndef _WIN32
+    (void)munmap(addr_, size_);
+#endif
+  }
+
+  // Map the file privately, so the tensors can write their data without changing the file.
+  static MappedFilePtr Map(const std::string &file) {
+#ifdef _WIN32
+    MS_LOG(ERROR) << "Mapping the file '" << file << "' is not supported on Windows.";
+    return nullptr;
+#else
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Open file '" << file << "' failed, please check the correct of the file.";
+      return nullptr;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "The file '" << file << "' is empty or can not be read.";
+      (void)close(fd);
+      return nullptr;
+    }
+    auto size = static_cast<size_t>(file_stat.st_size);
+    auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "Map file '" << file << "' failed, errno: " << errno;
+      return nullptr;
+    }
+    return std::make_shared<MappedFile>(addr, size);
+#endif
+  }
+
+  uint8_t *addr() const { return static_cast<uint8_t *>(addr_); }
+  size_t size() const { return size_; }
+
+ private:
+  void *addr_;
+  size_t size_;
+};
+
+namespace {
+// The data of a tensor borrowed from a mapped weight file. The pages are read from the file when they are accessed
+// for the first time, and copied by the kernel when they are written for the first time.
+class MappedTensorData : public tensor::TensorData {
+ public:
+  MappedTensorData(const MappedFilePtr &file, size_t offset, size_t ndim, size_t data_size, size_t item_size)
+      : file_(file), offset_(offset), ndim_(ndim), data_size_(data_size), item_size_(item_size) {}
+  ~MappedTensorData() override = default;
+
+  ssize_t size() const override { return static_cast<ssize_t>(data_size_); }
+  ssize_t itemsize() const override { return static_cast<ssize_t>(item_size_); }
+  ssize_t nbytes() const override { return size() * itemsize(); }
+  ssize_t ndim() const override { return static_cast<ssize_t>(ndim_); }
+  void *data() override { return file_->addr() + offset_; }
+  const void *const_data() const override { return file_->addr() + offset_; }
+
+  std::string ToString(const TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    tensor::Tensor tensor(type, shape, const_cast<void *>(const_data()), type);
+    return tensor.data().ToString(type, shape, use_comma);
+  }
+
+ private:
+  MappedFilePtr file_;
+  size_t offset_;
+  size_t ndim_;
+  size_t data_size_;
+  size_t item_size_;
+};
 }  // namespace
 
 tensor::TensorPtr MSANFModelParser::BuildTensorInfoForFuncGraph(const mind_ir::TensorProto &tensor_proto) {
@@ -277,7 +364,10 @@ bool MSANFModelParser::BuildParameterForFuncGraph(const ParameterPtr &node,
   node->set_debug_info(debug_info_ptr);
   node->set_name(debug_info_name);
 
-  tensor::TensorPtr tensor_info = BuildTensorInfoForFuncGraph(parameter_proto);
+  // The weights in the external files are not copied, the tensors borrow them from the mapped files.
+  bool is_mapped = kCanMapExternalData && parameter_proto.has_external_data() && mindir_dec_key_ == nullptr;
+  tensor::TensorPtr tensor_info =
+    is_mapped ? BuildMappedTensorForFuncGraph(parameter_proto) : BuildTensorInfoForFuncGraph(parameter_proto);
   if (tensor_info == nullptr) {
     return false;
   }
@@ -314,8 +404,7 @@ bool MSANFModelParser::BuildParameterForFuncGraph(const ParameterPtr &node,
     }
     node->set_default_param(tensor_info);
   } else if (parameter_proto.has_external_data()) {
-    auto ret = GetTensorDataFromExternal(parameter_proto, tensor_info);
-    if (!ret) {
+    if (!is_mapped && !GetTensorDataFromExternal(parameter_proto, tensor_info)) {
       return false;
     }
     node->set_default_param(tensor_info);
@@ -345,8 +434,8 @@ bool MSANFModelParser::GetTensorDataFromExternal(const mind_ir::TensorProto &ten
         MS_LOG(ERROR) << "Decrypt MindIR file failed, please check the correctness of the dec_key or dec_mode.";
         return false;
       }
-      tenor_data_.emplace(tensor_proto.external_data().location(), std::move(plain_data));
       data = plain_data.get();
+      tenor_data_.emplace(tensor_proto.external_data().location(), std::move(plain_data));
     } else {
       // Read file
       std::basic_ifstream<char> fid(file, std::ios::in | std::ios::binary);
@@ -383,6 +472,44 @@ bool MSANFModelParser::GetTensorDataFromExternal(const mind_ir::TensorProto &ten
   return true;
 }
 
+tensor::TensorPtr MSANFModelParser::BuildMappedTensorForFuncGraph(const mind_ir::TensorProto &tensor_proto) {
+  auto tensor_info = BuildTensorInfoForFuncGraph(tensor_proto);
+  if (tensor_info == nullptr) {
+    return nullptr;
+  }
+  const auto &external_data = tensor_proto.external_data();
+  auto iter = mapped_files_.find(external_data.location());
+  if (iter == mapped_files_.end()) {
+    auto file = MappedFile::Map(mindir_path_ + "/" + external_data.location());
+    if (file == nullptr) {
+      return nullptr;
+    }
+    constexpr Byte is_little_endian = 1;
+    constexpr int byte_order_index = 0;
+    if ((file->addr()[byte_order_index] == is_little_endian) != little_endian()) {
+      MS_LOG(ERROR) << "The byte order of export MindIr device and load MindIr device is not same!";
+      return nullptr;
+    }
+    iter = mapped_files_.emplace(external_data.location(), file).first;
+  }
+  const auto &file = iter->second;
+  auto nbytes = static_cast<uint64_t>(tensor_info->data().nbytes());
+  if (external_data.offset() < 0 || external_data.length() < 0 ||
+      static_cast<uint64_t>(external_data.length()) != nbytes ||
+      static_cast<uint64_t>(external_data.offset()) > file->size() ||
+      nbytes > file->size() - static_cast<uint64_t>(external_data.offset())) {
+    MS_LOG(ERROR) << "The data of the parameter " << tensor_proto.name() << " is out of the file "
+                  << external_data.location() << ", offset: " << external_data.offset()
+                  << ", length: " << external_data.length() << ", the parameter needs " << nbytes << " bytes.";
+    return nullptr;
+  }
+  const auto &layout = tensor_info->data();
+  auto tensor_data = std::make_shared<MappedTensorData>(file, static_cast<size_t>(external_data.offset()),
+                                                        LongToSize(layout.ndim()), LongToSize(layout.size()),
+                                                        LongToSize(layout.itemsize()));
+  return std::make_shared<tensor::Tensor>(tensor_info->data_type(), tensor_info->shape(), tensor_data);
+}
+
 bool MSANFModelParser::BuildInputForFuncGraph(const ParameterPtr &node, const mind_ir::ValueInfoProto &value_proto) {
   MS_EXCEPTION_IF_NULL(node);
 
@@ -29,6 +29,10 @@ namespace mindspore {
 using int32 = int32_t;
 using int64 = int64_t;
 using uint64 = uint64_t;
+// A weight file of the MindIR mapped in memory, shared by the tensors which borrow their data from it.
+class MappedFile;
+using MappedFilePtr = std::shared_ptr<MappedFile>;
+
 class MSANFModelParser {
  public:
   MSANFModelParser() : producer_name_(""), model_version_(""), ir_version_("") {}
@@ -59,6 +63,7 @@ class MSANFModelParser {
   bool BuildParameterForFuncGraph(const ParameterPtr &node, const mind_ir::TensorProto &tensor_proto);
   bool SetValueForTopGraphParameter(const FuncGraphPtr &topGraph, const std::map<std::string, ValuePtr> &weights);
   bool GetTensorDataFromExternal(const mind_ir::TensorProto &tensor_proto, const tensor::TensorPtr &tensor_info);
+  tensor::TensorPtr BuildMappedTensorForFuncGraph(const mind_ir::TensorProto &tensor_proto);
   bool BuildInputForFuncGraph(const ParameterPtr &node, const mind_ir::ValueInfoProto &value_proto);
   tensor::TensorPtr BuildTensorInfoForFuncGraph(const mind_ir::TensorProto &tensor_proto);
   CNodePtr BuildCNodeForFuncGraph(const FuncGraphPtr &outputFuncGraph, const mind_ir::NodeProto &node_proto);
@@ -100,6 +105,7 @@ class MSANFModelParser {
   std::string mindir_dec_mode_;
   bool little_endian_ = common::IsLittleByteOrder();
   std::map<std::string, std::unique_ptr<Byte[]>> tenor_data_;
+  std::map<std::string, MappedFilePtr> mapped_files_;
   static std::map<std::string, tensor::TensorPtr> load_tensor_map_;
 };
 }  // namespace mindspore
@@ -109,6 +109,7 @@ enum MsCtxParam : unsigned {
   // parameter of type float
   MS_CTX_TYPE_FLOAT_BEGIN = MS_CTX_TYPE_UINT32_END,
   MS_CTX_MAX_DEVICE_MEMORY = MS_CTX_TYPE_FLOAT_BEGIN,
+  MS_CTX_RECOMPUTE_MEMORY_BUDGET,
   MS_CTX_TYPE_FLOAT_END,
 
   // parameter of type string
@@ -575,3 +575,39 @@ def get_auto_offload():
         >>> auto_offload = ds.config.get_auto_offload()
     """
     return _config.get_auto_offload()
+
+
+def set_jpeg_dct_scale(enable):
+    """
+    Set whether JPEG images may be downscaled in the DCT domain while decoding, when the decode is fused with a
+    following resize to a smaller size (for example RandomCropDecodeResize). The image is decoded at 1/2, 1/4 or 1/8
+    of its size when that is still not smaller than the target, which saves most of the decode time, and the
+    result differs slightly from a full size decode followed by the resize.
+
+    Args:
+        enable (bool): Whether to use JPEG DCT domain downscaling.
+
+    Raises:
+        TypeError: If enable is not a boolean data type.
+
+    Examples:
+        >>> # Enable JPEG DCT domain downscaling
+        >>> ds.config.set_jpeg_dct_scale(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a bool dtype")
+    _config.set_jpeg_dct_scale(enable)
+
+
+def get_jpeg_dct_scale():
+    """
+    Get the state of the JPEG DCT domain downscaling flag (True or False)
+
+    Returns:
+        bool, Whether JPEG DCT domain downscaling is enabled.
+
+    Example:
+        >>> # Get the global configuration of JPEG DCT domain downscaling.
+        >>> jpeg_dct_scale = ds.config.get_jpeg_dct_scale()
+    """
+    return _config.get_jpeg_dct_scale()
@@ -507,20 +507,25 @@ class WordpieceTokenizer(TextTensorOperation):
         >>> text_file_dataset = text_file_dataset.map(operations=tokenizer_op, input_columns=["text"],
         ...                                           output_columns=["token", "offsets_start", "offsets_limit"],
         ...                                           column_order=["token", "offsets_start", "offsets_limit"])
+        >>> # If with_ids=True, then output one column {["text", dtype=int32]}
+        >>> tokenizer_op = text.WordpieceTokenizer(vocab=vocab, unknown_token='[UNK]',
+        ...                                        max_bytes_per_token=100, with_ids=True)
+        >>> text_file_dataset = text_file_dataset.map(operations=tokenizer_op)
     """
 
     @check_wordpiece_tokenizer
     def __init__(self, vocab, suffix_indicator='##', max_bytes_per_token=100,
-                 unknown_token='[UNK]', with_offsets=False):
+                 unknown_token='[UNK]', with_offsets=False, with_ids=False):
         self.vocab = vocab
         self.suffix_indicator = suffix_indicator
         self.max_bytes_per_token = max_bytes_per_token
         self.unknown_token = unknown_token
         self.with_offsets = with_offsets
+        self.with_ids = with_ids
 
     def parse(self):
         return cde.WordpieceTokenizerOperation(self.vocab, self.suffix_indicator, self.max_bytes_per_token,
-                                               self.unknown_token, self.with_offsets)
+                                               self.unknown_token, self.with_offsets, self.with_ids)
 
 
 class PythonTokenizer:
@@ -656,6 +661,9 @@ if platform.system().lower() != 'windows':
             preserve_unused_token (bool, optional): If True, do not split special tokens like
                 '[CLS]', '[SEP]', '[UNK]', '[PAD]', '[MASK]' (default=True).
             with_offsets (bool, optional): Whether or not output offsets of tokens (default=False).
+            with_ids (bool, optional): Whether or not output the ids of the subword tokens in `vocab` instead of the
+                tokens, which is the same as a following Lookup but creates no subword strings. It can not be True
+                together with `with_offsets` (default=False).
 
         Examples:
             >>> from mindspore.dataset.text import NormalizeForm
@@ -690,7 +698,7 @@ if platform.system().lower() != 'windows':
         @check_bert_tokenizer
         def __init__(self, vocab, suffix_indicator='##', max_bytes_per_token=100, unknown_token='[UNK]',
                      lower_case=False, keep_whitespace=False, normalization_form=NormalizeForm.NONE,
-                     preserve_unused_token=True, with_offsets=False):
+                     preserve_unused_token=True, with_offsets=False, with_ids=False):
             if not isinstance(normalization_form, NormalizeForm):
                 raise TypeError("Wrong input type for normalization_form, should be enum of 'NormalizeForm'.")
 
@@ -703,11 +711,13 @@ if platform.system().lower() != 'windows':
             self.normalization_form = DE_C_INTER_NORMALIZE_FORM[normalization_form]
             self.preserve_unused_token = preserve_unused_token
             self.with_offsets = with_offsets
+            self.with_ids = with_ids
 
         def parse(self):
             return cde.BertTokenizerOperation(self.vocab, self.suffix_indicator, self.max_bytes_per_token,
                                               self.unknown_token, self.lower_case, self.keep_whitespace,
-                                              self.normalization_form, self.preserve_unused_token, self.with_offsets)
+                                              self.normalization_form, self.preserve_unused_token, self.with_offsets,
+                                              self.with_ids)
 
 
     class CaseFold(TextTensorOperation):
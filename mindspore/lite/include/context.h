@@ -26,6 +26,7 @@ namespace mindspore::lite {
 typedef struct CpuDeviceInfo {
   bool enable_float16_ = false; /**< prior enable float16 inference */
   CpuBindMode cpu_bind_mode_ = MID_CPU;
+  bool enable_bfloat16_ = false; /**< keep the constant float32 matmul weights in bfloat16 */
 } CpuDeviceInfo;
 
 /// \brief GpuDeviceInfo defined for GPU's configuration information.
@@ -70,6 +71,7 @@ struct Context {
   String vendor_name_;
   int thread_num_ = 2; /**< thread number config for thread pool */
   bool enable_parallel_ = false;
+  bool enable_inter_op_parallel_ = false; /**< run the independent branches of a cpu subgraph side by side */
   Vector<int> affinity_core_list_; /**< explicitly specify the core to be bound. priority use affinity core list */
   AllocatorPtr allocator = nullptr;
 #ifndef NOT_USE_STL
@@ -39,6 +39,10 @@ class CoderFlags : public virtual FlagParser {
     AddFlag(&CoderFlags::code_mode_, "codeMode", "generated code mode, Inference | Train", "Inference");
     AddFlag(&CoderFlags::support_parallel_, "supportParallel", "whether support parallel launch, true | false", false);
     AddFlag(&CoderFlags::debug_mode_, "debugMode", "dump the tensors data for debugging, true | false", false);
+    AddFlag(&CoderFlags::shape_specialized_, "shapeSpecialized",
+            "generate x86 code specialized to the model shapes, with weights packed ahead of time and a shared net "
+            "library, true | false",
+            false);
   }
 
   ~CoderFlags() override = default;
@@ -48,6 +52,7 @@ class CoderFlags : public virtual FlagParser {
   std::string code_path_;
   std::string code_mode_;
   bool debug_mode_{false};
+  bool shape_specialized_{false};
   std::string target_;
 };
 
@@ -147,6 +152,15 @@ int Coder::Init(const CoderFlags &flags) const {
     return true;
   });
 
+  parsers.emplace_back([&flags, config]() -> bool {
+    if (flags.shape_specialized_ && (config->target() != kX86 || config->code_mode() != Inference)) {
+      MS_LOG(ERROR) << "shape specialized code only supports x86 inference.";
+      return false;
+    }
+    config->set_shape_specialized(flags.shape_specialized_);
+    return true;
+  });
+
   parsers.emplace_back([&flags, config]() -> bool {
     const std::string slash = std::string(kSlash);
     if (!flags.code_path_.empty() && !DirExists(flags.code_path_)) {
@@ -186,6 +200,7 @@ int Coder::Init(const CoderFlags &flags) const {
   print_parameter("codePath", config->code_path());
   print_parameter("codeMode", config->code_mode());
   print_parameter("debugMode", config->debug_mode());
+  print_parameter("shapeSpecialized", config->shape_specialized());
 
   return RET_OK;
 }
@@ -45,6 +45,9 @@ class Configurator {
   void set_support_parallel(bool parallel) { support_parallel_ = parallel; }
   bool support_parallel() const { return support_parallel_; }
 
+  void set_shape_specialized(bool specialized) { shape_specialized_ = specialized; }
+  bool shape_specialized() const { return shape_specialized_; }
+
   int ParseProjDir(std::string model_path);
   std::string proj_dir() const { return proj_dir_; }
 
@@ -56,6 +59,7 @@ class Configurator {
   CodeMode code_mode_{Code_Unknown};
   bool support_parallel_{false};
   bool debug_mode_{false};
+  bool shape_specialized_{false};
   std::string proj_dir_;
 };
 }  // namespace mindspore::lite::micro
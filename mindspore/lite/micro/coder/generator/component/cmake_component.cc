@@ -53,6 +53,15 @@ void CodeCMakeNetLibrary(std::ofstream &ofs, const std::unique_ptr<CoderContext>
         << "set_property(SOURCE ${ASSEMBLY_SRC} PROPERTY LANGUAGE C)\n"
         << "list(APPEND OP_SRC ${ASSEMBLY_SRC})\n";
   }
+  // the shape specialized net is also linked as a shared library, and its kernels are only tuned for the build host
+  // when asked to, since a -march=native library does not run on older cpus
+  if (config->shape_specialized()) {
+    ofs << "option(MICRO_NATIVE_ARCH \"vectorize the shape specialized kernels for the build host\" OFF)\n"
+        << "if(MICRO_NATIVE_ARCH)\n"
+        << "    add_compile_options(-march=native)\n"
+        << "endif()\n"
+        << "set(MICRO_SHARED_NET ON)\n";
+  }
   ofs << "file(GLOB NET_SRC\n"
          "     ${CMAKE_CURRENT_SOURCE_DIR}/*.cc\n"
          "     ${CMAKE_CURRENT_SOURCE_DIR}/*.c\n"
@@ -180,5 +180,16 @@ endfunction(create_library)
 string(CONCAT library_name "lib" net ".a")
 create_library()
 
+if(MICRO_SHARED_NET)
+    add_custom_command(TARGET net
+            POST_BUILD
+            COMMAND ${CMAKE_CXX_COMPILER} -shared -o libnet.so -Wl,--whole-archive ${library_name}
+                    -Wl,--no-whole-archive -lm -pthread
+            COMMAND echo "shared library libnet.so size:"
+            COMMAND ls -lh libnet.so
+            COMMENT "generate shared library libnet.so"
+            )
+endif()
+
 )RAW";
 }  // namespace mindspore::lite::micro
@@ -15,8 +15,11 @@
  */
 
 #include "coder/opcoders/nnacl/fp32/matmul_fp32_base_coder.h"
+#include <algorithm>
+#include <sstream>
 #include <string>
 #include <vector>
+#include "coder/config.h"
 #include "coder/log.h"
 #include "coder/opcoders/parallel.h"
 #include "coder/opcoders/serializers/nnacl_serializer/nnacl_fp32_serializer.h"
@@ -28,6 +31,110 @@
 using mindspore::schema::PrimitiveType_MatMul;
 
 namespace mindspore::lite::micro::nnacl {
+namespace {
+// gcc and clang lower it to whatever vector registers the build host has, so the emitted kernels need no intrinsics
+constexpr char kSpecializedVectorType[] = "typedef float MicroFloat8 __attribute__((vector_size(32)));";
+
+std::string SpecializedActivation(int act_type, const std::string &value) {
+  if (act_type == ActType_Relu) {
+    return value + " > 0.0f ? " + value + " : 0.0f";
+  }
+  if (act_type == ActType_Relu6) {
+    return value + " > 0.0f ? (" + value + " < 6.0f ? " + value + " : 6.0f) : 0.0f";
+  }
+  return value;
+}
+
+// rows x width output tile at row r and column cb, held in rows x vecs vectors of C8NUM columns. The packed filter and
+// bias are padded to whole vectors, so only the store is cut to width.
+void CodeSpecializedTile(std::ostringstream *code, const MatMulParameter &params, int rows, int vecs, int width,
+                         bool has_bias) {
+  const std::string vec_size = "sizeof(MicroFloat8)";
+  *code << "        const float *src = batch_a + r * " << params.deep_ << ";\n"
+        << "        float *dst = batch_c + r * " << params.col_ << " + cb;\n";
+  for (int v = 0; v < vecs; ++v) {
+    if (has_bias) {
+      *code << "        MicroFloat8 init" << v << ";\n"
+            << "        __builtin_memcpy(&init" << v << ", bias + cb + " << v * C8NUM << ", " << vec_size << ");\n";
+    } else {
+      *code << "        MicroFloat8 init" << v << " = {0};\n";
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int v = 0; v < vecs; ++v) {
+      *code << "        MicroFloat8 acc" << i << "_" << v << " = init" << v << ";\n";
+    }
+  }
+  *code << "        for (int d = 0; d < " << params.deep_ << "; ++d) {\n";
+  for (int v = 0; v < vecs; ++v) {
+    *code << "          MicroFloat8 weight" << v << ";\n"
+          << "          __builtin_memcpy(&weight" << v << ", w + " << v * C8NUM * params.deep_ << " + d * " << C8NUM
+          << ", " << vec_size << ");\n";
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int v = 0; v < vecs; ++v) {
+      *code << "          acc" << i << "_" << v << " += src[" << i * params.deep_ << " + d] * weight" << v << ";\n";
+    }
+  }
+  *code << "        }\n"
+        << "        float out[" << vecs * C8NUM << "];\n";
+  for (int i = 0; i < rows; ++i) {
+    for (int v = 0; v < vecs; ++v) {
+      *code << "        __builtin_memcpy(out + " << v * C8NUM << ", &acc" << i << "_" << v << ", " << vec_size
+            << ");\n";
+    }
+    *code << "        for (int j = 0; j < " << width << "; ++j) {\n"
+          << "          dst[" << i * params.col_ << " + j] = " << SpecializedActivation(params.act_type_, "out[j]")
+          << ";\n"
+          << "        }\n";
+  }
+}
+
+// row-major a times the filter packed by InitSpecializedWeight, on tiles of C4NUM rows and C16NUM columns with every
+// shape and stride a literal, the last rows and columns getting tiles of their own.
+std::string CodeSpecializedKernel(const std::string &name, const MatMulParameter &params, bool has_bias) {
+  int col_align = UP_ROUND(params.col_, C8NUM);
+  int full_cols = params.col_ / C16NUM * C16NUM;
+  int full_rows = params.row_ / C4NUM * C4NUM;
+  auto code_rows = [&params, full_rows, has_bias](std::ostringstream *code, int width) {
+    int vecs = UP_DIV(width, C8NUM);
+    if (full_rows > 0) {
+      *code << "      for (int r = 0; r < " << full_rows << "; r += " << C4NUM << ") {\n";
+      CodeSpecializedTile(code, params, C4NUM, vecs, width, has_bias);
+      *code << "      }\n";
+    }
+    if (full_rows < params.row_) {
+      *code << "      for (int r = " << full_rows << "; r < " << params.row_ << "; ++r) {\n";
+      CodeSpecializedTile(code, params, C1NUM, vecs, width, has_bias);
+      *code << "      }\n";
+    }
+  };
+  std::ostringstream code;
+  code << "static void " << name << "(const float *a, const float *b, " << (has_bias ? "const float *bias, " : "")
+       << "float *c) {\n"
+       << "  for (int i = 0; i < " << params.batch << "; ++i) {\n"
+       << "    const float *batch_a = a + i * " << params.row_ * params.deep_ << ";\n"
+       << "    const float *batch_b = b + i * " << params.deep_ * col_align << ";\n"
+       << "    float *batch_c = c + i * " << params.row_ * params.col_ << ";\n";
+  if (full_cols > 0) {
+    code << "    for (int cb = 0; cb < " << full_cols << "; cb += " << C16NUM << ") {\n"
+         << "      const float *w = batch_b + cb * " << params.deep_ << ";\n";
+    code_rows(&code, C16NUM);
+    code << "    }\n";
+  }
+  if (full_cols < params.col_) {
+    code << "    {\n"
+         << "      const int cb = " << full_cols << ";\n"
+         << "      const float *w = batch_b + cb * " << params.deep_ << ";\n";
+    code_rows(&code, params.col_ - full_cols);
+    code << "    }\n";
+  }
+  code << "  }\n"
+       << "}\n";
+  return code.str();
+}
+}  // namespace
+
 int MatMulFP32BaseCoder::ReSize() {
   ResizeParameter();
   MS_CHECK_TRUE(params_->col_align_ != 0, "params_->col_align_ = 0");
@@ -35,6 +142,9 @@ int MatMulFP32BaseCoder::ReSize() {
   MS_CHECK_TRUE(thread_count_ != 0, "thread_count_ = 0");
   thread_stride_ = UP_DIV(UP_DIV(params_->col_align_, col_tile_), thread_count_);
   // can not call Malloc in DoCode,so move this runtime init to final resize
+  if (shape_specialized_) {
+    return RET_OK;
+  }
   if (!params_->a_const_) {
     MS_CHECK_RET_CODE(InitBufferA(), "InitBufferA failed");
   }
@@ -113,9 +223,53 @@ int MatMulFP32BaseCoder::InitMatrixB(const float *src_ptr) {
   return RET_OK;
 }
 
+// The filter is packed into weight.c at codegen, [col / 8][deep][8] per batch as RowMajor2Col8Major and
+// RowMajor2Row8Major lay it out on x86, and the bias is padded to the same whole column blocks.
+int MatMulFP32BaseCoder::InitSpecializedWeight() {
+  auto *origin_weight = reinterpret_cast<float *>(filter_tensor_->data());
+  MS_CHECK_PTR(origin_weight);
+  int col_align = UP_ROUND(params_->col_, C8NUM);
+  b_pack_ptr_size_ = static_cast<size_t>(params_->batch * col_align * params_->deep_ * sizeof(float));
+  b_pack_ptr_ = reinterpret_cast<float *>(allocator_->Malloc(kNumberTypeFloat32, b_pack_ptr_size_, kOfflinePackWeight));
+  MS_CHECK_PTR(b_pack_ptr_);
+  MS_CHECK_RET_CODE(memset_s(b_pack_ptr_, b_pack_ptr_size_, 0, b_pack_ptr_size_), "memset packed weight failed!");
+  for (int i = 0; i < params_->batch; i++) {
+    const float *src = origin_weight + i * params_->deep_ * params_->col_;
+    float *dst = b_pack_ptr_ + i * params_->deep_ * col_align;
+    if (params_->b_transpose_) {
+      RowMajor2Col8Major(src, dst, params_->col_, params_->deep_);
+    } else {
+      RowMajor2Row8Major(src, dst, params_->deep_, params_->col_);
+    }
+  }
+  if (bias_tensor_ == nullptr) {
+    return RET_OK;
+  }
+  auto *origin_bias = reinterpret_cast<float *>(bias_tensor_->data());
+  MS_CHECK_PTR(origin_bias);
+  bias_pack_ptr_size_ = static_cast<size_t>(col_align * sizeof(float));
+  bias_ptr_ =
+    reinterpret_cast<float *>(allocator_->Malloc(kNumberTypeFloat32, bias_pack_ptr_size_, kOfflinePackWeight));
+  MS_CHECK_PTR(bias_ptr_);
+  MS_CHECK_RET_CODE(memset_s(bias_ptr_, bias_pack_ptr_size_, 0, bias_pack_ptr_size_), "memset bias failed!");
+  if (bias_tensor_->ElementsNum() == 1) {
+    std::fill(bias_ptr_, bias_ptr_ + params_->col_, origin_bias[0]);
+    return RET_OK;
+  }
+  MS_CHECK_TRUE(bias_tensor_->ElementsNum() == params_->col_, "invalid bias length");
+  MS_CHECK_RET_CODE(memcpy_s(bias_ptr_, bias_pack_ptr_size_, origin_bias, bias_tensor_->Size()),
+                    "memcpy_s bias failed!");
+  return RET_OK;
+}
+
 int MatMulFP32BaseCoder::Init() {
   thread_count_ = thread_num_;
   ResizeParameter();
+  shape_specialized_ = Configurator::GetInstance()->shape_specialized() && target_ == kX86 && params_->b_const_ &&
+                       !params_->a_const_ && !params_->a_transpose_ && !de_quant_flag_;
+  if (shape_specialized_) {
+    return InitSpecializedWeight();
+  }
   MS_CHECK_RET_CODE(InitBiasData(), "InitBiasData failed");
   if (params_->a_const_) {
     MS_CHECK_RET_CODE(InitBufferA(), "InitBufferA failed");
@@ -169,7 +323,34 @@ int MatMulFP32BaseCoder::CollectFilesForTarget(CoderContext *const context) {
   return RET_OK;
 }
 
+// the emitted kernel is shared by the ops of the same shape and runs on a single thread
+int MatMulFP32BaseCoder::DoSpecializedCode(CoderContext *const context) {
+  std::string kernel_name = "MatMulFp32Specialized_" + std::to_string(params_->batch) + "_" +
+                            std::to_string(params_->row_) + "_" + std::to_string(params_->deep_) + "_" +
+                            std::to_string(params_->col_) + "_" + std::to_string(params_->act_type_) +
+                            (bias_ptr_ != nullptr ? "_bias" : "");
+  std::string kernel = CodeSpecializedKernel(kernel_name, *params_, bias_ptr_ != nullptr);
+  auto global_code = context->global_code_blocks();
+  for (const std::string &block : {std::string(kSpecializedVectorType), kernel}) {
+    if (std::find(global_code.begin(), global_code.end(), block) == global_code.end()) {
+      global_code.emplace_back(block);
+    }
+  }
+  context->set_global_code_blocks(global_code);
+  NNaclFp32Serializer code;
+  if (bias_ptr_ != nullptr) {
+    code.CodeFunction(kernel_name, input_tensor_, b_pack_ptr_, bias_ptr_, output_tensor_);
+  } else {
+    code.CodeFunction(kernel_name, input_tensor_, b_pack_ptr_, output_tensor_);
+  }
+  context->AppendCode(code.str());
+  return RET_OK;
+}
+
 int MatMulFP32BaseCoder::DoCode(CoderContext *const context) {
+  if (shape_specialized_) {
+    return DoSpecializedCode(context);
+  }
   CollectFilesForTarget(context);
   NNaclFp32Serializer code;
   NNaclFp32Serializer init_code;
@@ -43,6 +43,8 @@ class MatMulFP32BaseCoder : public OperatorCoder {
   int InitBufferB();
   int InitMatrixA(const float *src_ptr);
   int InitMatrixB(const float *src_ptr);
+  int InitSpecializedWeight();
+  int DoSpecializedCode(CoderContext *const context);
   int CollectFilesForTarget(CoderContext *const context);
 
  protected:
@@ -69,6 +71,8 @@ class MatMulFP32BaseCoder : public OperatorCoder {
   size_t a_pack_ptr_size_{0};
   size_t b_pack_ptr_size_{0};
   bool is_bias_broadcast_{false};
+  // the filter is packed at codegen and the op runs on a kernel emitted for its exact shape
+  bool shape_specialized_{false};
 };
 }  // namespace mindspore::lite::micro::nnacl
 #endif  // MINDSPORE_LITE_MICRO_CODER_OPCODERS_NNACL_FP32_MATMUL_FP32_BASE_CODER_H_
@@ -16,13 +16,18 @@
 set -e
 
 GEN=OFF
-while getopts 'g' OPT
+SPECIALIZED=OFF
+LOOP_COUNT=1000
+while getopts 'gs' OPT
 do
     case $OPT in
         g)
             GEN=ON;;
+        s)
+            GEN=ON
+            SPECIALIZED=ON;;
         ?)
-            echo "Usage: add -g or left it empty"
+            echo "Usage: add -g, -s or left it empty"
     esac
 done
 
@@ -68,7 +73,21 @@ download_mnist() {
 
 gen_mnist() {
     local CODEGEN_PATH=${BASEPATH}/build/${MINDSPORE_FILE_NAME}/tools/codegen
-    ${CODEGEN_PATH}/codegen --codePath=${BASEPATH}/build --modelPath=${BASEPATH}/build/${MNIST_FILE}
+    local CODEGEN_ARGS="--codePath=${BASEPATH}/build --modelPath=${BASEPATH}/build/${MNIST_FILE}"
+    if [[ "${SPECIALIZED}" == "ON" ]]; then
+        CODEGEN_ARGS="${CODEGEN_ARGS} --shapeSpecialized=true"
+    fi
+    ${CODEGEN_PATH}/codegen ${CODEGEN_ARGS}
+}
+
+# latency of the generated code against the lite runtime, LiteSession::RunGraph, on one thread
+compare_runtime() {
+    echo "======generated code, ${LOOP_COUNT} loops======"
+    ./benchmark ${INPUT_BIN} ${BENCHMARK_PATH}/src/net.bin ${LOOP_COUNT} | grep "total time"
+    echo "======lite runtime, ${LOOP_COUNT} loops======"
+    LD_LIBRARY_PATH=${PKG_PATH}/runtime/lib:${LD_LIBRARY_PATH} ${PKG_PATH}/tools/benchmark/benchmark \
+        --modelFile=${BASEPATH}/build/${MNIST_FILE} --inDataFile=${INPUT_BIN} --loopCount=${LOOP_COUNT} \
+        --numThreads=1 | grep -i "time"
 }
 
 mkdir -p ${BASEPATH}/build
@@ -87,9 +106,18 @@ fi
 # 1. build benchmark
 rm -rf ${BASEPATH}/build/benchmark
 mkdir -p ${BASEPATH}/build/benchmark && cd ${BASEPATH}/build/benchmark || exit 1
-cmake -DPKG_PATH=${PKG_PATH} ${BENCHMARK_PATH}
+if [[ "${SPECIALIZED}" == "ON" ]]; then
+    # the example runs where it is built, so the specialized kernels may use the host instruction set
+    cmake -DPKG_PATH=${PKG_PATH} -DMICRO_NATIVE_ARCH=ON ${BENCHMARK_PATH}
+else
+    cmake -DPKG_PATH=${PKG_PATH} ${BENCHMARK_PATH}
+fi
 make
 
 # 2. run benchmark
 echo "net file: ${BENCHMARK_PATH}/src/mnist.bin"
 ./benchmark ${INPUT_BIN} ${BENCHMARK_PATH}/src/net.bin
+
+if [[ "${SPECIALIZED}" == "ON" ]]; then
+    compare_runtime
+fi
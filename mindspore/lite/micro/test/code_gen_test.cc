@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include "gtest/gtest.h"
 #include "micro/coder/coder.h"
 
@@ -24,6 +28,47 @@ TEST(GenerateCodeTest, mnist_x86) {
   STATUS status = RunCoder(5, argv);
   ASSERT_EQ(status, RET_OK);
 }
+
+namespace {
+std::string ReadGenerated(const std::string &file) {
+  std::ifstream ifs(file);
+  std::stringstream content;
+  content << ifs.rdbuf();
+  return content.str();
+}
+}  // namespace
+
+TEST(GenerateCodeTest, mnist_x86_shape_specialized) {
+  const std::string code_path = "./shape_specialized";
+  (void)mkdir(code_path.c_str(), S_IRWXU);
+  const std::string code_path_flag = "--codePath=" + code_path;
+  const char *argv[] = {"./codegen", "--modelPath=../example/mnist/mnist.ms", code_path_flag.c_str(),
+                        "--shapeSpecialized=true"};
+  STATUS status = RunCoder(4, argv);
+  ASSERT_EQ(status, RET_OK);
+  std::string net_c = ReadGenerated(code_path + "/mnist/src/net.c");
+  std::string weight_c = ReadGenerated(code_path + "/mnist/src/weight.c");
+  std::string net_cmake = ReadGenerated(code_path + "/mnist/src/net.cmake");
+  ASSERT_FALSE(net_c.empty());
+  // the fully connected layers call kernels unrolled for their shapes on the filters packed at codegen
+  EXPECT_NE(net_c.find("typedef float MicroFloat8"), std::string::npos);
+  EXPECT_NE(net_c.find("static void MatMulFp32Specialized_"), std::string::npos);
+  for (const auto &pack_call : {"InitMatrixA", "InitMatrixB"}) {
+    EXPECT_EQ(net_c.find(pack_call), std::string::npos) << pack_call;
+    EXPECT_EQ(weight_c.find(pack_call), std::string::npos) << pack_call;
+  }
+  // the host instruction set is opt-in
+  EXPECT_NE(net_cmake.find("set(MICRO_SHARED_NET ON)"), std::string::npos);
+  EXPECT_NE(net_cmake.find("if(MICRO_NATIVE_ARCH)"), std::string::npos);
+  EXPECT_NE(net_cmake.find("option(MICRO_NATIVE_ARCH"), std::string::npos);
+}
+
+TEST(GenerateCodeTest, shape_specialized_x86_only) {
+  const char *argv[] = {"./codegen", "--modelPath=../example/mnist/mnist.ms", "--codePath=.", "--target=ARM64",
+                        "--shapeSpecialized=true"};
+  STATUS status = RunCoder(5, argv);
+  ASSERT_NE(status, RET_OK);
+}
 }  // namespace mindspore::lite::micro::test
 
 GTEST_API_ int main(int argc, char **argv) {
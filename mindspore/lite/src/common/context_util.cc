@@ -41,6 +41,7 @@ std::shared_ptr<mindspore::CPUDeviceInfo> CPUDeviceInfoFromCPUDeviceContext(cons
   auto cpu_info = std::make_shared<mindspore::CPUDeviceInfo>();
   MS_CHECK_TRUE_RET(cpu_info != nullptr, nullptr);
   cpu_info->SetEnableFP16(cpu_context.device_info_.cpu_device_info_.enable_float16_);
+  cpu_info->SetEnableBF16(cpu_context.device_info_.cpu_device_info_.enable_bfloat16_);
   PassBasicProperties(cpu_info, cpu_context);
   return cpu_info;
 }
@@ -120,6 +121,7 @@ mindspore::Context *MSContextFromContext(const lite::Context *context) {
   ms_context->SetThreadNum(context->thread_num_);
   ms_context->SetThreadAffinity(context->affinity_core_list_);
   ms_context->SetEnableParallel(context->enable_parallel_);
+  ms_context->SetEnableInterOpParallel(context->enable_inter_op_parallel_);
   ms_context->SetDelegate(context->delegate);
   auto &device_infos = ms_context->MutableDeviceInfo();
   std::map<DeviceType, std::function<std::shared_ptr<mindspore::DeviceInfoContext>(const lite::DeviceContext &)>>
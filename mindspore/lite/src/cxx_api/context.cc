@@ -24,6 +24,7 @@
 
 namespace mindspore {
 constexpr auto kModelOptionCpuEnableFP16 = "mindspore.option.cpu.enable_fp16";
+constexpr auto kModelOptionCpuEnableBF16 = "mindspore.option.cpu.enable_bf16";
 constexpr auto kModelOptionGPUEnableFP16 = "mindspore.option.gpu.enable_fp16";
 #ifdef ENABLE_OPENGL_TEXTURE
 constexpr auto kModelOptionGPUEnableEnableGLTexture = "mindspore.option.gpu.enable_gl_texture_";
@@ -102,6 +103,22 @@ bool Context::GetEnableParallel() const {
   return data_->enable_parallel_;
 }
 
+void Context::SetEnableInterOpParallel(bool is_parallel) {
+  if (data_ == nullptr) {
+    MS_LOG(ERROR) << "Invalid context.";
+    return;
+  }
+  data_->enable_inter_op_parallel_ = is_parallel;
+}
+
+bool Context::GetEnableInterOpParallel() const {
+  if (data_ == nullptr) {
+    MS_LOG(ERROR) << "Invalid context.";
+    return false;
+  }
+  return data_->enable_inter_op_parallel_;
+}
+
 void Context::SetThreadAffinity(int mode) {
   if (data_ == nullptr) {
     MS_LOG(ERROR) << "Invalid context.";
@@ -228,6 +245,22 @@ bool CPUDeviceInfo::GetEnableFP16() const {
   return GetValue<bool>(data_, kModelOptionCpuEnableFP16);
 }
 
+void CPUDeviceInfo::SetEnableBF16(bool is_bf16) {
+  if (data_ == nullptr) {
+    MS_LOG(ERROR) << "Invalid context.";
+    return;
+  }
+  data_->params[kModelOptionCpuEnableBF16] = is_bf16;
+}
+
+bool CPUDeviceInfo::GetEnableBF16() const {
+  if (data_ == nullptr) {
+    MS_LOG(ERROR) << "Invalid context.";
+    return false;
+  }
+  return GetValue<bool>(data_, kModelOptionCpuEnableBF16);
+}
+
 void GPUDeviceInfo::SetEnableFP16(bool is_fp16) {
   if (data_ == nullptr) {
     MS_LOG(ERROR) << "Invalid context.";
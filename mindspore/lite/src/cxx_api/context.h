@@ -33,6 +33,7 @@ struct Context::Data {
   std::vector<std::shared_ptr<DeviceInfoContext>> device_info_list;
   int32_t thread_num = 2;
   bool enable_parallel_ = false;
+  bool enable_inter_op_parallel_ = false;
   std::vector<int32_t> affinity_core_list_;
   int affinity_mode_ = 0;
   std::shared_ptr<Delegate> delegate = nullptr;
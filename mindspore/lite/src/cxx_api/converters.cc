@@ -48,7 +48,7 @@ Status AddCpuDevice(const Context *a_context, lite::InnerContext *l_context, Dev
   lite::CpuBindMode mode = A2L_ConvertAffinityMode(a_context->GetThreadAffinityMode());
 
   lite::DeviceInfo cpu_info = {0};
-  cpu_info.cpu_device_info_ = {cpu_context->GetEnableFP16(), mode};
+  cpu_info.cpu_device_info_ = {cpu_context->GetEnableFP16(), mode, cpu_context->GetEnableBF16()};
   l_context->device_list_.push_back({lite::DT_CPU, cpu_info, cpu_context->GetProvider(),
                                      cpu_context->GetProviderDevice(), cpu_context->GetAllocator()});
   return kSuccess;
@@ -103,6 +103,7 @@ Status A2L_ConvertContext(Context *a_context, lite::InnerContext *l_context) {
   }
   l_context->thread_num_ = a_context->GetThreadNum();
   l_context->enable_parallel_ = a_context->GetEnableParallel();
+  l_context->enable_inter_op_parallel_ = a_context->GetEnableInterOpParallel();
   l_context->affinity_core_list_ = a_context->GetThreadAffinityCoreList();
   l_context->device_list_.clear();
 
@@ -149,6 +150,7 @@ Status A2L_ConvertContext(const Context::Data *a_context, lite::Context *l_conte
   }
   l_context->thread_num_ = a_context->thread_num;
   l_context->enable_parallel_ = a_context->enable_parallel_;
+  l_context->enable_inter_op_parallel_ = a_context->enable_inter_op_parallel_;
   l_context->affinity_core_list_ = a_context->affinity_core_list_;
   l_context->device_list_.clear();
   if (device_list[0]->GetDeviceType() != kCPU) {
@@ -176,7 +178,7 @@ Status A2L_ConvertContext(const Context::Data *a_context, lite::Context *l_conte
   lite::CpuBindMode mode = A2L_ConvertAffinityMode(a_context->affinity_mode_);
 
   lite::DeviceInfo cpu_info = {0};
-  cpu_info.cpu_device_info_ = {cpu_context->GetEnableFP16(), mode};
+  cpu_info.cpu_device_info_ = {cpu_context->GetEnableFP16(), mode, cpu_context->GetEnableBF16()};
   l_context->device_list_.push_back({lite::DT_CPU, cpu_info, cpu_context->GetProvider(),
                                      cpu_context->GetProviderDevice(), cpu_context->GetAllocator()});
   if (device_list.size() == kMaxNumOfDevices) {
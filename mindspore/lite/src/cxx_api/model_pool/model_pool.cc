@@ -0,0 +1,522 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/cxx_api/model_pool/model_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include "src/cxx_api/converters.h"
+#include "src/common/log_adapter.h"
+#include "src/lite_model.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore {
+namespace {
+constexpr float kUsPerMs = 1000.0f;
+constexpr float kPercentP50 = 50.0f;
+constexpr float kPercentP90 = 90.0f;
+constexpr float kPercentP99 = 99.0f;
+constexpr float kPercentAll = 100.0f;
+// After a failed batch, batching pauses for kBatchRetryBaseMs, doubled on each failure in a row up to
+// kBatchRetryMaxMs.
+constexpr int64_t kBatchRetryBaseMs = 100;
+constexpr int64_t kBatchRetryMaxMs = 60000;
+constexpr int32_t kBatchRetryMaxShift = 10;
+
+uint64_t ElapsedUs(const std::chrono::steady_clock::time_point &start) {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Dimension 0 of the first input, which is how many samples a request carries.
+int64_t RequestBatch(const std::vector<MSTensor> &inputs) {
+  if (inputs.empty() || inputs.front().Shape().empty()) {
+    return 1;
+  }
+  return std::max<int64_t>(inputs.front().Shape().front(), 1);
+}
+}  // namespace
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::BucketIndex(uint64_t us) {
+  if (us < kSubBucketNum) {
+    return static_cast<int>(us);
+  }
+  int msb = 63 - __builtin_clzll(us);
+  auto sub = static_cast<int>((us >> (msb - kSubBucketBits)) & (kSubBucketNum - 1));
+  return ((msb - kSubBucketBits + 1) << kSubBucketBits) + sub;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+  if (index < static_cast<int>(kSubBucketNum)) {
+    return static_cast<uint64_t>(index) + 1;
+  }
+  int msb = (index >> kSubBucketBits) + kSubBucketBits - 1;
+  uint64_t sub = static_cast<uint64_t>(index) & (kSubBucketNum - 1);
+  return (kSubBucketNum + sub + 1) << (msb - kSubBucketBits);
+}
+
+void LatencyHistogram::Record(uint64_t us) {
+  buckets_[BucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(us, std::memory_order_relaxed);
+  auto cur = max_.load(std::memory_order_relaxed);
+  while (us > cur && !max_.compare_exchange_weak(cur, us, std::memory_order_relaxed)) {
+  }
+}
+
+float LatencyHistogram::AvgMs() const {
+  auto cnt = Count();
+  return cnt == 0 ? 0 : static_cast<float>(sum_.load(std::memory_order_relaxed)) / cnt / kUsPerMs;
+}
+
+float LatencyHistogram::MaxMs() const { return static_cast<float>(max_.load(std::memory_order_relaxed)) / kUsPerMs; }
+
+float LatencyHistogram::PercentileMs(float percent) const {
+  auto cnt = Count();
+  if (cnt == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(cnt * percent / kPercentAll);
+  rank = std::min(std::max<uint64_t>(rank, 1), cnt);
+  uint64_t seen = 0;
+  for (int i = 0; i < kBucketNum; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      // the upper bound of a bucket may be above the largest value ever seen
+      return static_cast<float>(std::min(BucketUpperBound(i), max_.load(std::memory_order_relaxed))) / kUsPerMs;
+    }
+  }
+  return MaxMs();
+}
+
+ModelPool::~ModelPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  // the sessions point into the buffer of the model, so the model goes last
+  for (auto iter = sessions_.rbegin(); iter != sessions_.rend(); ++iter) {
+    delete *iter;
+  }
+  sessions_.clear();
+  delete model_;
+  model_ = nullptr;
+}
+
+lite::LiteSession *ModelPool::CreateSession(Context *context, const std::vector<int> &core_list) {
+  auto *lite_context = new (std::nothrow) lite::InnerContext();
+  if (lite_context == nullptr) {
+    MS_LOG(ERROR) << "New inner context failed.";
+    return nullptr;
+  }
+  auto status = A2L_ConvertContext(context, lite_context);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "Convert context failed.";
+    delete lite_context;
+    return nullptr;
+  }
+  if (!core_list.empty()) {
+    lite_context->affinity_core_list_ = core_list;
+  }
+  auto *session = new (std::nothrow) lite::LiteSession();
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "New session failed.";
+    delete lite_context;
+    return nullptr;
+  }
+  // the session takes the context from here on
+  if (session->Init(lite_context) != lite::RET_OK) {
+    MS_LOG(ERROR) << "Init session failed.";
+    delete session;
+    return nullptr;
+  }
+  // Const tensors of the model are not copied when the model keeps its buffer, every session reads the one copy.
+  // Only the weights of packed ops are repacked per session. The model keeps owning the weights loaded from
+  // external data files, or the first session would free them once packed, under the sessions compiled after it.
+  session->set_shared_model(true);
+  if (session->CompileGraph(model_) != lite::RET_OK) {
+    MS_LOG(ERROR) << "Compile graph failed.";
+    delete session;
+    return nullptr;
+  }
+  return session;
+}
+
+Status ModelPool::CreateWorkers(const std::shared_ptr<RunnerConfig> &config) {
+  auto context = config->context;
+  if (context == nullptr) {
+    context = std::make_shared<Context>();
+    context->MutableDeviceInfo().push_back(std::make_shared<CPUDeviceInfo>());
+  }
+  int thread_num = std::max(context->GetThreadNum(), 1);
+  auto user_core_list = context->GetThreadAffinityCoreList();
+  int core_num = user_core_list.empty() ? static_cast<int>(std::thread::hardware_concurrency())
+                                        : static_cast<int>(user_core_list.size());
+  core_num = std::max(core_num, 1);
+  int workers_num = config->workers_num > 0 ? config->workers_num : std::max(core_num / thread_num, 1);
+  bool bind_core = context->GetThreadAffinityMode() != lite::NO_BIND || !user_core_list.empty();
+
+  for (int i = 0; i < workers_num; i++) {
+    // Hand out disjoint groups of cores while there are enough of them, the workers would only fight over the
+    // same cores otherwise.
+    std::vector<int> core_list;
+    if (bind_core && (i + 1) * thread_num <= core_num) {
+      for (int j = i * thread_num; j < (i + 1) * thread_num; j++) {
+        core_list.push_back(user_core_list.empty() ? j : user_core_list[j]);
+      }
+    }
+    auto *session = CreateSession(context.get(), core_list);
+    if (session == nullptr) {
+      MS_LOG(ERROR) << "Create session of worker " << i << " failed.";
+      return kLiteError;
+    }
+    sessions_.push_back(session);
+  }
+
+  for (auto *tensor : sessions_.front()->GetInputs()) {
+    if (tensor->data_type() == kObjectTypeString) {
+      MS_LOG(ERROR) << "String input " << tensor->tensor_name() << " is not supported by the model pool.";
+      return kLiteNotSupport;
+    }
+  }
+  for (auto *session : sessions_) {
+    workers_.emplace_back(&ModelPool::WorkerEntry, this, session);
+  }
+  MS_LOG(INFO) << "Model pool of " << workers_num << " workers, " << thread_num << " threads per worker.";
+  return kSuccess;
+}
+
+Status ModelPool::Init(const std::string &model_path, const std::shared_ptr<RunnerConfig> &runner_config) {
+  if (model_ != nullptr) {
+    MS_LOG(ERROR) << "Model pool is already initialized.";
+    return kLiteError;
+  }
+  auto config = runner_config == nullptr ? std::make_shared<RunnerConfig>() : runner_config;
+  max_batch_size_ = std::max(config->max_batch_size, 1);
+  batch_timeout_us_ = std::max(config->batch_timeout_us, 0);
+  batch_enable_ = max_batch_size_ > 1;
+
+  model_ = lite::ImportFromPath(model_path.c_str());
+  if (model_ == nullptr) {
+    MS_LOG(ERROR) << "Import model " << model_path << " failed.";
+    return kLiteError;
+  }
+  reinterpret_cast<lite::LiteModel *>(model_)->set_keep_model_buf(true);
+  auto status = CreateWorkers(config);
+  if (status != kSuccess) {
+    return status;
+  }
+
+  auto *session = sessions_.front();
+  for (auto *tensor : session->GetInputs()) {
+    auto dims = tensor->shape();
+    std::vector<int64_t> shape(dims.begin(), dims.end());
+    auto *desc = MSTensor::CreateTensor(tensor->tensor_name(), static_cast<enum DataType>(tensor->data_type()), shape,
+                                        nullptr, 0);
+    MS_CHECK_TRUE_MSG(desc != nullptr, kLiteNullptr, "Create input tensor failed.");
+    inputs_desc_.push_back(*desc);
+    MSTensor::DestroyTensorPtr(desc);
+  }
+  for (auto &name : session->GetOutputTensorNames()) {
+    auto *tensor = session->GetOutputByTensorName(name);
+    MS_CHECK_TRUE_MSG(tensor != nullptr, kLiteNullptr, "Get output tensor failed.");
+    auto dims = tensor->shape();
+    std::vector<int64_t> shape(dims.begin(), dims.end());
+    auto *desc = MSTensor::CreateTensor(name, static_cast<enum DataType>(tensor->data_type()), shape, nullptr, 0);
+    MS_CHECK_TRUE_MSG(desc != nullptr, kLiteNullptr, "Create output tensor failed.");
+    outputs_desc_.push_back(*desc);
+    MSTensor::DestroyTensorPtr(desc);
+  }
+  return kSuccess;
+}
+
+std::vector<MSTensor> ModelPool::GetInputs() { return inputs_desc_; }
+
+std::vector<MSTensor> ModelPool::GetOutputs() { return outputs_desc_; }
+
+RunnerStat ModelPool::GetStat(bool reset) {
+  RunnerStat stat;
+  stat.request_num = latency_.Count();
+  stat.batch_num = batch_num_.load(std::memory_order_relaxed);
+  stat.avg_ms = latency_.AvgMs();
+  stat.p50_ms = latency_.PercentileMs(kPercentP50);
+  stat.p90_ms = latency_.PercentileMs(kPercentP90);
+  stat.p99_ms = latency_.PercentileMs(kPercentP99);
+  stat.max_ms = latency_.MaxMs();
+  if (reset) {
+    latency_.Reset();
+    batch_num_.store(0, std::memory_order_relaxed);
+  }
+  return stat;
+}
+
+Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+  if (outputs == nullptr) {
+    MS_LOG(ERROR) << "outputs is nullptr.";
+    return kLiteNullptr;
+  }
+  if (sessions_.empty()) {
+    MS_LOG(ERROR) << "Model pool is not initialized.";
+    return kLiteError;
+  }
+  auto start = std::chrono::steady_clock::now();
+  PredictTask task;
+  task.inputs = &inputs;
+  task.outputs = outputs;
+  task.batch = RequestBatch(inputs);
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (stop_) {
+      return kLiteError;
+    }
+    queue_.push_back(&task);
+    task_cv_.notify_one();
+    task.cv.wait(lock, [&task] { return task.done; });
+  }
+  latency_.Record(ElapsedUs(start));
+  return task.status;
+}
+
+bool ModelPool::Batchable(const PredictTask &first, const PredictTask &other) const {
+  auto &a = *first.inputs;
+  auto &b = *other.inputs;
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].DataType() != b[i].DataType()) {
+      return false;
+    }
+    auto shape_a = a[i].Shape();
+    auto shape_b = b[i].Shape();
+    if (shape_a.empty() || shape_a.size() != shape_b.size() || shape_a.front() != first.batch ||
+        shape_b.front() != other.batch || !std::equal(shape_a.begin() + 1, shape_a.end(), shape_b.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ModelPool::CollectBatch(std::unique_lock<std::mutex> *lock, std::vector<PredictTask *> *tasks) {
+  tasks->push_back(queue_.front());
+  queue_.pop_front();
+  if (!batch_enable_ || std::chrono::steady_clock::now() < batch_resume_time_) {
+    return;
+  }
+  // Only requests at the head of the queue are taken so no request is overtaken by a later one. An idle worker may
+  // grab a request this worker is waiting for, which is fine: batching only pays off when every worker is busy.
+  auto *first = tasks->front();
+  int64_t total = first->batch;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(batch_timeout_us_);
+  while (total < max_batch_size_ && !stop_) {
+    if (queue_.empty()) {
+      if (batch_timeout_us_ == 0 || task_cv_.wait_until(*lock, deadline) == std::cv_status::timeout) {
+        break;
+      }
+      continue;
+    }
+    auto *next = queue_.front();
+    if (total + next->batch > max_batch_size_ || !Batchable(*first, *next)) {
+      break;
+    }
+    tasks->push_back(next);
+    queue_.pop_front();
+    total += next->batch;
+  }
+}
+
+void ModelPool::WorkerEntry(lite::LiteSession *session) {
+  while (true) {
+    std::vector<PredictTask *> tasks;
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      task_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      CollectBatch(&lock, &tasks);
+    }
+    batch_num_.fetch_add(1, std::memory_order_relaxed);
+    auto status = Run(session, tasks);
+    bool batch_failed = status != kSuccess && tasks.size() > 1;
+    if (batch_failed) {
+      // Most likely an output without the batch in dimension 0. The requests are run one by one, so each one gets
+      // its own status.
+      for (auto *task : tasks) {
+        task->status = Run(session, {task});
+      }
+    } else {
+      for (auto *task : tasks) {
+        task->status = status;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (batch_failed) {
+      auto delay_ms = std::min(kBatchRetryBaseMs << std::min(batch_fail_num_, kBatchRetryMaxShift), kBatchRetryMaxMs);
+      batch_resume_time_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+      batch_fail_num_++;
+      MS_LOG(WARNING) << "Run a batch of " << tasks.size() << " requests failed, dynamic batching is paused for "
+                      << delay_ms << " ms.";
+    } else if (tasks.size() > 1) {
+      batch_fail_num_ = 0;
+    }
+    for (auto *task : tasks) {
+      // notify under the lock, the task lives on the stack of the caller which returns as soon as it sees done
+      task->done = true;
+      task->cv.notify_one();
+    }
+  }
+}
+
+Status ModelPool::BindInputs(lite::LiteSession *session, const std::vector<PredictTask *> &tasks,
+                             int64_t total_batch, std::vector<void *> *old_data) {
+  auto input_tensors = session->GetInputs();
+  auto &first = *tasks.front()->inputs;
+  if (first.size() != input_tensors.size()) {
+    MS_LOG(ERROR) << "Wrong input size " << first.size() << ", the model has " << input_tensors.size() << " inputs.";
+    return kLiteInputTensorError;
+  }
+  bool need_resize = false;
+  std::vector<std::vector<int>> dims;
+  for (size_t i = 0; i < first.size(); i++) {
+    if (first[i].DataType() != static_cast<enum DataType>(input_tensors[i]->data_type())) {
+      MS_LOG(ERROR) << "Tensor " << first[i].Name() << " has a different data type from input "
+                    << input_tensors[i]->tensor_name() << ".";
+      return kLiteInputTensorError;
+    }
+    std::vector<int> shape;
+    for (auto dim : first[i].Shape()) {
+      shape.push_back(static_cast<int>(dim));
+    }
+    if (tasks.size() > 1) {
+      shape.front() = static_cast<int>(total_batch);
+    }
+    auto cur_shape = input_tensors[i]->shape();
+    need_resize = need_resize || !std::equal(shape.begin(), shape.end(), cur_shape.begin(), cur_shape.end());
+    dims.push_back(shape);
+  }
+  if (need_resize && session->Resize(input_tensors, dims) != lite::RET_OK) {
+    MS_LOG(ERROR) << "Resize inputs failed.";
+    return kLiteError;
+  }
+
+  for (size_t i = 0; i < input_tensors.size(); i++) {
+    auto *input = input_tensors[i];
+    if (tasks.size() == 1) {
+      // a single request is run on the data of the caller, as Model::Predict does
+      auto user_input = first[i];
+      if (user_input.Data() == nullptr || user_input.DataSize() != input->Size()) {
+        MS_LOG(ERROR) << "Tensor " << user_input.Name() << " has no data or a wrong data size.";
+        return kLiteInputTensorError;
+      }
+      old_data->push_back(input->data());
+      input->set_data(user_input.MutableData());
+      continue;
+    }
+    auto *dst = static_cast<uint8_t *>(input->MutableData());
+    MS_CHECK_TRUE_MSG(dst != nullptr, kLiteMemoryFailed, "Malloc input data failed.");
+    size_t offset = 0;
+    for (auto *task : tasks) {
+      auto &user_input = task->inputs->at(i);
+      auto data = user_input.Data();
+      if (data == nullptr || offset + user_input.DataSize() > input->Size()) {
+        MS_LOG(ERROR) << "Tensor " << user_input.Name() << " has no data or a wrong data size.";
+        return kLiteInputTensorError;
+      }
+      (void)memcpy(dst + offset, data.get(), user_input.DataSize());
+      offset += user_input.DataSize();
+    }
+    if (offset != input->Size()) {
+      MS_LOG(ERROR) << "The batched data of input " << input->tensor_name() << " has a wrong size.";
+      return kLiteInputTensorError;
+    }
+  }
+  return kSuccess;
+}
+
+Status ModelPool::SplitOutputs(lite::LiteSession *session, const std::vector<PredictTask *> &tasks,
+                               int64_t total_batch) {
+  auto names = session->GetOutputTensorNames();
+  for (auto *task : tasks) {
+    task->outputs->clear();
+  }
+  for (auto &name : names) {
+    auto *output = session->GetOutputByTensorName(name);
+    MS_CHECK_TRUE_MSG(output != nullptr, kLiteNullptr, "Get output tensor failed.");
+    auto dims = output->shape();
+    std::vector<int64_t> shape(dims.begin(), dims.end());
+    if (tasks.size() > 1 && (shape.empty() || shape.front() != total_batch)) {
+      MS_LOG(WARNING) << "Output " << name << " can not be split along dimension 0.";
+      return kLiteError;
+    }
+    auto *src = static_cast<const uint8_t *>(output->data());
+    MS_CHECK_TRUE_MSG(src != nullptr, kLiteNullptr, "Output has no data.");
+    size_t bytes_per_sample = output->Size() / static_cast<size_t>(tasks.size() > 1 ? total_batch : 1);
+    size_t offset = 0;
+    for (auto *task : tasks) {
+      size_t size = output->Size();
+      if (tasks.size() > 1) {
+        shape.front() = task->batch;
+        size = bytes_per_sample * static_cast<size_t>(task->batch);
+      }
+      auto *tensor = MSTensor::CreateTensor(name, static_cast<enum DataType>(output->data_type()), shape,
+                                            size == 0 ? nullptr : src + offset, size);
+      MS_CHECK_TRUE_MSG(tensor != nullptr, kLiteNullptr, "Create output tensor failed.");
+      task->outputs->push_back(*tensor);
+      MSTensor::DestroyTensorPtr(tensor);
+      offset += size;
+    }
+  }
+  return kSuccess;
+}
+
+Status ModelPool::Run(lite::LiteSession *session, const std::vector<PredictTask *> &tasks) {
+  int64_t total_batch = 0;
+  for (auto *task : tasks) {
+    total_batch += task->batch;
+  }
+  std::vector<void *> old_data;
+  auto input_tensors = session->GetInputs();
+  auto status = BindInputs(session, tasks, total_batch, &old_data);
+  if (status == kSuccess) {
+    status = session->RunGraph() == lite::RET_OK ? kSuccess : kLiteError;
+  }
+  for (size_t i = 0; i < old_data.size(); i++) {
+    input_tensors[i]->set_data(old_data[i]);
+  }
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "Run graph failed.";
+    return status;
+  }
+  return SplitOutputs(session, tasks, total_batch);
+}
+}  // namespace mindspore
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_MODEL_POOL_H_
+#define MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_MODEL_POOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/api/model_parallel_runner.h"
+#include "include/model.h"
+#include "src/lite_session.h"
+
+namespace mindspore {
+// Lock free histogram of latencies in microseconds. Buckets are log-linear: every power of two is split into
+// kSubBucketNum buckets, so a percentile is off by at most 1 / kSubBucketNum of its value.
+class LatencyHistogram {
+ public:
+  LatencyHistogram() { Reset(); }
+  ~LatencyHistogram() = default;
+
+  void Record(uint64_t us);
+  void Reset();
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  float AvgMs() const;
+  float MaxMs() const;
+  float PercentileMs(float percent) const;
+
+ private:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr uint64_t kSubBucketNum = 1 << kSubBucketBits;
+  static constexpr int kBucketNum = 64 << kSubBucketBits;
+
+  static int BucketIndex(uint64_t us);
+  static uint64_t BucketUpperBound(int index);
+
+  std::atomic<uint64_t> buckets_[kBucketNum];
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+};
+
+class ModelPool {
+ public:
+  ModelPool() = default;
+  ~ModelPool();
+
+  Status Init(const std::string &model_path, const std::shared_ptr<RunnerConfig> &runner_config);
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
+  std::vector<MSTensor> GetInputs();
+  std::vector<MSTensor> GetOutputs();
+  RunnerStat GetStat(bool reset);
+
+ private:
+  struct PredictTask {
+    const std::vector<MSTensor> *inputs = nullptr;
+    std::vector<MSTensor> *outputs = nullptr;
+    int64_t batch = 1;
+    Status status;
+    bool done = false;
+    std::condition_variable cv;
+  };
+
+  Status CreateWorkers(const std::shared_ptr<RunnerConfig> &config);
+  lite::LiteSession *CreateSession(Context *context, const std::vector<int> &core_list);
+  void WorkerEntry(lite::LiteSession *session);
+  void CollectBatch(std::unique_lock<std::mutex> *lock, std::vector<PredictTask *> *tasks);
+  bool Batchable(const PredictTask &first, const PredictTask &other) const;
+  Status Run(lite::LiteSession *session, const std::vector<PredictTask *> &tasks);
+  Status BindInputs(lite::LiteSession *session, const std::vector<PredictTask *> &tasks, int64_t total_batch,
+                    std::vector<void *> *old_data);
+  Status SplitOutputs(lite::LiteSession *session, const std::vector<PredictTask *> &tasks, int64_t total_batch);
+
+  lite::Model *model_ = nullptr;
+  std::vector<lite::LiteSession *> sessions_;
+  std::vector<std::thread> workers_;
+  std::vector<MSTensor> inputs_desc_;
+  std::vector<MSTensor> outputs_desc_;
+
+  std::mutex mtx_;
+  std::condition_variable task_cv_;
+  std::deque<PredictTask *> queue_;
+  bool stop_ = false;
+
+  int32_t max_batch_size_ = 1;
+  int32_t batch_timeout_us_ = 0;
+  bool batch_enable_ = false;
+  // Guarded by mtx_. A failed batch pauses batching until batch_resume_time_, longer for each failure in a row.
+  std::chrono::steady_clock::time_point batch_resume_time_;
+  int32_t batch_fail_num_ = 0;
+
+  LatencyHistogram latency_;
+  std::atomic<uint64_t> batch_num_{0};
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_MODEL_POOL_H_
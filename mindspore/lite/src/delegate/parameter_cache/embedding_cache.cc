@@ -55,9 +55,9 @@ EmbeddingCache::~EmbeddingCache() {
 }
 
 Status EmbeddingCache::Init() {
-  cache_ = std::make_shared<LFUCacheAlgorithm>(device_cache_size_, mix_host_index_, max_host_index_);
+  cache_ = std::make_shared<TinyLFUCacheAlgorithm>(device_cache_size_, mix_host_index_, max_host_index_);
   if (cache_ == nullptr) {
-    MS_LOG(ERROR) << "malloc LFUCacheAlgorithm failed";
+    MS_LOG(ERROR) << "malloc TinyLFUCacheAlgorithm failed";
     return kLiteMemoryFailed;
   }
   device_cache_ = std::make_shared<gpu::GPUCacheMem>();
@@ -20,7 +20,7 @@
 #include <cmath>
 #include <algorithm>
 #include <memory>
-#include "src/delegate/parameter_cache/lfu_cache.h"
+#include "src/delegate/parameter_cache/tiny_lfu_cache.h"
 #include "ps/ps_cache/ps_cache_basic.h"
 #include "include/api/status.h"
 #include "include/api/data_type.h"
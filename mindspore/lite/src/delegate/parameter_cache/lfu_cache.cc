@@ -207,17 +207,9 @@ Status LFUCacheAlgorithm::CheckCacheHit(const int *batch_ids, const size_t batch
       key_table_[(*iter)->key] = iter;
     }
 
-    auto node_list_iter = frequency_table_.begin();
-    if (node_list_iter->second.size() > 0) {
-      auto iter = node_list_iter->second.begin();
-      if ((*iter)->frequency == 1) {
-        node_list_iter->second.splice(node_list_iter->second.begin(), need_swap_nodes);
-      } else {
-        frequency_table_[1] = need_swap_nodes;
-      }
-    } else {
-      frequency_table_[1] = need_swap_nodes;
-    }
+    // splice rather than copy, key_table_ holds iterators into need_swap_nodes
+    auto &first_list = frequency_table_[1];
+    first_list.splice(first_list.begin(), need_swap_nodes);
   }
   for (auto node_iter : hit_index_nodes) {
     auto node = node_iter.second;
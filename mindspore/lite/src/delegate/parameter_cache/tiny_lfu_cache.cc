@@ -0,0 +1,405 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/delegate/parameter_cache/tiny_lfu_cache.h"
+#include <algorithm>
+#include <vector>
+#ifdef ENABLE_SSE
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+#include "src/common/log_adapter.h"
+
+namespace mindspore {
+namespace cache {
+namespace {
+constexpr int kEmptyKey = -1;
+constexpr int kMissSlot = -2;
+constexpr int kSketchDepth = 4;
+constexpr int kCounterBits = 4;
+constexpr uint64_t kCounterMax = 15;
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+constexpr size_t kSampleFactor = 10;
+constexpr size_t kWindowPercent = 1;
+constexpr size_t kProtectedPercent = 80;
+constexpr size_t kPercent = 100;
+constexpr uint64_t kSketchSeeds[kSketchDepth] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                                 0xcbf29ce484222325ULL};
+#ifdef ENABLE_SSE
+constexpr size_t kProbeLanes = 4;
+#endif
+
+uint32_t Hash(int key) {
+  auto hash = static_cast<uint32_t>(key);
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bU;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35U;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+size_t RoundUpPowerOfTwo(size_t value) {
+  size_t power = 1;
+  while (power < value) {
+    power <<= 1;
+  }
+  return power;
+}
+
+// word and nibble of the depth-th counter of a key
+void SketchCounter(uint32_t hash, int depth, size_t table_mask, size_t *word, int *shift) {
+  uint64_t item = (static_cast<uint64_t>(hash) + kSketchSeeds[depth]) * kSketchSeeds[depth];
+  item ^= item >> 32;
+  *word = static_cast<size_t>(item) & table_mask;
+  *shift = static_cast<int>((item >> 40) & 0xF) * kCounterBits;
+}
+}  // namespace
+
+FrequencySketch::FrequencySketch(size_t cache_size) {
+  table_.resize(RoundUpPowerOfTwo(std::max<size_t>(cache_size, 1)), 0);
+  table_mask_ = table_.size() - 1;
+  sample_size_ = kSampleFactor * std::max<size_t>(cache_size, 1);
+}
+
+void FrequencySketch::Increment(int key) {
+  auto hash = Hash(key);
+  bool added = false;
+  for (int depth = 0; depth < kSketchDepth; depth++) {
+    size_t word;
+    int shift;
+    SketchCounter(hash, depth, table_mask_, &word, &shift);
+    if (((table_[word] >> shift) & kCounterMax) != kCounterMax) {
+      table_[word] += 1ULL << shift;
+      added = true;
+    }
+  }
+  if (added && ++additions_ == sample_size_) {
+    Reset();
+  }
+}
+
+int FrequencySketch::Frequency(int key) const {
+  auto hash = Hash(key);
+  uint64_t frequency = kCounterMax;
+  for (int depth = 0; depth < kSketchDepth; depth++) {
+    size_t word;
+    int shift;
+    SketchCounter(hash, depth, table_mask_, &word, &shift);
+    frequency = std::min(frequency, (table_[word] >> shift) & kCounterMax);
+  }
+  return static_cast<int>(frequency);
+}
+
+void FrequencySketch::Reset() {
+  for (auto &word : table_) {
+    word = (word >> 1) & kHalfMask;
+  }
+  additions_ /= 2;
+}
+
+TinyLFUCacheAlgorithm::TinyLFUCacheAlgorithm(size_t cache_size, int min_host_index, int max_host_index)
+    : cache_size_(cache_size),
+      min_host_index_(min_host_index),
+      max_host_index_(max_host_index),
+      sketch_(cache_size) {
+  window_capacity_ = std::max<size_t>(1, cache_size_ * kWindowPercent / kPercent);
+  protected_capacity_ = (cache_size_ - std::min(cache_size_, window_capacity_)) * kProtectedPercent / kPercent;
+  index_keys_.resize(RoundUpPowerOfTwo(std::max<size_t>(2 * cache_size_, 1)), kEmptyKey);
+  index_slots_.resize(index_keys_.size(), -1);
+  index_mask_ = index_keys_.size() - 1;
+  slot_keys_.resize(cache_size_, kEmptyKey);
+  prev_.resize(cache_size_, -1);
+  next_.resize(cache_size_, -1);
+  regions_.resize(cache_size_, kFree);
+  stamps_.resize(cache_size_, 0);
+  for (size_t slot = 0; slot < cache_size_; slot++) {
+    PushFront(kFree, static_cast<int>(cache_size_ - 1 - slot));
+  }
+}
+
+int TinyLFUCacheAlgorithm::Find(int key) const {
+  size_t pos = Hash(key) & index_mask_;
+#ifdef ENABLE_SSE
+  // the keys of a probe run are contiguous, so one compare covers kProbeLanes buckets and tells whether the run ends
+  // among them
+  const __m128i target = _mm_set1_epi32(key);
+  const __m128i empty = _mm_set1_epi32(kEmptyKey);
+  for (; pos + kProbeLanes <= index_keys_.size(); pos += kProbeLanes) {
+    __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(index_keys_.data() + pos));
+    int hit = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, target)));
+    if (hit != 0) {
+      return index_slots_[pos + __builtin_ctz(hit)];
+    }
+    if (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, empty))) != 0) {
+      return -1;
+    }
+  }
+  pos &= index_mask_;
+#endif
+  for (;; pos = (pos + 1) & index_mask_) {
+    if (index_keys_[pos] == key) {
+      return index_slots_[pos];
+    }
+    if (index_keys_[pos] == kEmptyKey) {
+      return -1;
+    }
+  }
+}
+
+void TinyLFUCacheAlgorithm::IndexInsert(int key, int slot) {
+  size_t pos = Hash(key) & index_mask_;
+  while (index_keys_[pos] != kEmptyKey) {
+    pos = (pos + 1) & index_mask_;
+  }
+  index_keys_[pos] = key;
+  index_slots_[pos] = slot;
+}
+
+// backward shift deletion, the entries after the hole move up unless that would put them before their home bucket
+void TinyLFUCacheAlgorithm::IndexErase(int key) {
+  size_t pos = Hash(key) & index_mask_;
+  while (index_keys_[pos] != key) {
+    if (index_keys_[pos] == kEmptyKey) {
+      return;
+    }
+    pos = (pos + 1) & index_mask_;
+  }
+  size_t next = pos;
+  while (true) {
+    next = (next + 1) & index_mask_;
+    if (index_keys_[next] == kEmptyKey) {
+      break;
+    }
+    size_t home = Hash(index_keys_[next]) & index_mask_;
+    bool stays = pos <= next ? (pos < home && home <= next) : (pos < home || home <= next);
+    if (stays) {
+      continue;
+    }
+    index_keys_[pos] = index_keys_[next];
+    index_slots_[pos] = index_slots_[next];
+    pos = next;
+  }
+  index_keys_[pos] = kEmptyKey;
+  index_slots_[pos] = -1;
+}
+
+void TinyLFUCacheAlgorithm::PushFront(Region region, int slot) {
+  auto &list = lists_[region];
+  prev_[slot] = -1;
+  next_[slot] = list.head;
+  if (list.head != -1) {
+    prev_[list.head] = slot;
+  } else {
+    list.tail = slot;
+  }
+  list.head = slot;
+  list.size++;
+  regions_[slot] = region;
+}
+
+void TinyLFUCacheAlgorithm::Remove(int slot) {
+  auto &list = lists_[regions_[slot]];
+  if (prev_[slot] != -1) {
+    next_[prev_[slot]] = next_[slot];
+  } else {
+    list.head = next_[slot];
+  }
+  if (next_[slot] != -1) {
+    prev_[next_[slot]] = prev_[slot];
+  } else {
+    list.tail = prev_[slot];
+  }
+  list.size--;
+  prev_[slot] = -1;
+  next_[slot] = -1;
+}
+
+// least recently used slot of the region that the current batch has not used, -1 if there is none
+int TinyLFUCacheAlgorithm::LastUnpinned(Region region) const {
+  int slot = lists_[region].tail;
+  while (slot != -1 && stamps_[slot] == stamp_) {
+    slot = prev_[slot];
+  }
+  return slot;
+}
+
+void TinyLFUCacheAlgorithm::Touch(int slot) {
+  stamps_[slot] = stamp_;
+  auto region = static_cast<Region>(regions_[slot]);
+  Remove(slot);
+  if (region == kWindow) {
+    PushFront(kWindow, slot);
+    return;
+  }
+  PushFront(kProtected, slot);
+  if (lists_[kProtected].size > protected_capacity_) {
+    auto demoted = lists_[kProtected].tail;
+    Remove(demoted);
+    PushFront(kProbation, demoted);
+  }
+}
+
+int TinyLFUCacheAlgorithm::EvictSlot() {
+  int candidate = lists_[kWindow].size >= window_capacity_ ? lists_[kWindow].tail : -1;
+  // a window entry the batch uses can not lose, it goes to the main region without a contest
+  if (candidate != -1 && stamps_[candidate] == stamp_) {
+    Remove(candidate);
+    PushFront(kProbation, candidate);
+    candidate = -1;
+  }
+  int victim = LastUnpinned(kProbation);
+  if (victim == -1) {
+    victim = LastUnpinned(kProtected);
+  }
+  int evicted;
+  if (candidate == -1 && victim == -1) {
+    evicted = LastUnpinned(kWindow);
+  } else if (candidate == -1) {
+    evicted = victim;
+  } else if (victim == -1) {
+    evicted = candidate;
+  } else if (sketch_.Frequency(slot_keys_[candidate]) > sketch_.Frequency(slot_keys_[victim])) {
+    Remove(candidate);
+    PushFront(kProbation, candidate);
+    evicted = victim;
+  } else {
+    evicted = candidate;
+  }
+  if (evicted == -1) {
+    return -1;
+  }
+  Remove(evicted);
+  IndexErase(slot_keys_[evicted]);
+  slot_keys_[evicted] = kEmptyKey;
+  regions_[evicted] = kFree;
+  return evicted;
+}
+
+int TinyLFUCacheAlgorithm::Admit(int key) {
+  int slot = lists_[kFree].head;
+  if (slot != -1) {
+    Remove(slot);
+  } else {
+    slot = EvictSlot();
+    if (slot == -1) {
+      return -1;
+    }
+  }
+  slot_keys_[slot] = key;
+  stamps_[slot] = stamp_;
+  IndexInsert(key, slot);
+  PushFront(kWindow, slot);
+  // while the cache fills up, the window overflow goes to the main region without a contest
+  while (lists_[kWindow].size > window_capacity_ &&
+         lists_[kProbation].size + lists_[kProtected].size + window_capacity_ < cache_size_) {
+    auto oldest = lists_[kWindow].tail;
+    Remove(oldest);
+    PushFront(kProbation, oldest);
+  }
+  return slot;
+}
+
+int TinyLFUCacheAlgorithm::Get(int key) {
+  sketch_.Increment(key);
+  auto slot = Find(key);
+  if (slot != -1) {
+    Touch(slot);
+  }
+  return slot;
+}
+
+// places key at slot value, the initial content of the device cache going to the main region first
+void TinyLFUCacheAlgorithm::Put(int key, int value) {
+  if (value < 0 || static_cast<size_t>(value) >= cache_size_) {
+    return;
+  }
+  auto slot = Find(key);
+  if (slot == value) {
+    return;
+  }
+  if (slot != -1) {
+    Remove(slot);
+    IndexErase(key);
+    slot_keys_[slot] = kEmptyKey;
+    PushFront(kFree, slot);
+  }
+  Remove(value);
+  if (slot_keys_[value] != kEmptyKey) {
+    IndexErase(slot_keys_[value]);
+  }
+  slot_keys_[value] = key;
+  IndexInsert(key, value);
+  auto main_size = lists_[kProbation].size + lists_[kProtected].size;
+  PushFront(main_size + window_capacity_ < cache_size_ ? kProbation : kWindow, value);
+}
+
+Status TinyLFUCacheAlgorithm::CheckCacheHit(const int *batch_ids, const size_t batch_ids_len, int *cache_index,
+                                            std::vector<int> *need_swap_indies,
+                                            std::vector<int> *need_swap_indies_cache_index) {
+  if (batch_ids == nullptr) {
+    MS_LOG(ERROR) << "batch_ids is nullptr";
+    return kLiteNullptr;
+  }
+  if (cache_index == nullptr || need_swap_indies == nullptr || need_swap_indies_cache_index == nullptr) {
+    MS_LOG(ERROR) << "cache_index or need swap output is nullptr";
+    return kLiteNullptr;
+  }
+  stamp_++;
+  // all hits are taken first, so that none of them can be evicted by a miss of the same batch
+  for (size_t i = 0; i < batch_ids_len; i++) {
+    auto key = batch_ids[i];
+    if (key < min_host_index_ || key >= max_host_index_) {
+      cache_index[i] = -1;
+      continue;
+    }
+    sketch_.Increment(key);
+    auto slot = Find(key);
+    if (slot == -1) {
+      cache_index[i] = kMissSlot;
+      continue;
+    }
+    if (stamps_[slot] != stamp_) {
+      Touch(slot);
+    }
+    cache_index[i] = slot;
+    hit_count_++;
+  }
+  for (size_t i = 0; i < batch_ids_len; i++) {
+    if (cache_index[i] != kMissSlot) {
+      continue;
+    }
+    auto key = batch_ids[i];
+    auto slot = Find(key);
+    if (slot == -1) {
+      slot = Admit(key);
+      if (slot == -1) {
+        MS_LOG(ERROR) << "batch has more distinct ids than the " << cache_size_ << " cache entries";
+        return kLiteError;
+      }
+      need_swap_indies->push_back(key);
+      need_swap_indies_cache_index->push_back(slot);
+      MS_LOG(DEBUG) << "device index " << slot << ",for host index " << key;
+    }
+    cache_index[i] = slot;
+    miss_count_++;
+  }
+  return kSuccess;
+}
+}  // namespace cache
+}  // namespace mindspore
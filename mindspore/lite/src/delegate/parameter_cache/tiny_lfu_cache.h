@@ -0,0 +1,113 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_TINY_LFU_CACHE_H_
+#define MINDSPORE_LITE_TINY_LFU_CACHE_H_
+
+#include <cstdint>
+#include <vector>
+#include "include/api/status.h"
+#include "src/delegate/parameter_cache/lfu_cache.h"
+
+namespace mindspore {
+namespace cache {
+// count-min sketch of 4-bit counters, 16 to a 64-bit word. Every key has a counter in each of 4 words and its
+// frequency is the smallest of them. All counters are halved after 10 additions per cache entry, so the sketch
+// follows the recent popularity of the keys rather than their all-time counts.
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t cache_size);
+  ~FrequencySketch() = default;
+
+  void Increment(int key);
+  int Frequency(int key) const;
+
+ private:
+  void Reset();
+
+  std::vector<uint64_t> table_;
+  size_t table_mask_{0};
+  size_t sample_size_{0};
+  size_t additions_{0};
+};
+
+// W-TinyLFU over the device cache slots. New keys always enter a small LRU window, so every miss of a batch gets a
+// slot. When a slot is needed, the oldest window entry is only moved into the main region if the sketch has seen it
+// more often than the main region's next victim, and whichever of the two loses is evicted. The main region is a
+// segmented LRU, probation for entries hit once in it and protected for the rest.
+// Slots live in flat arrays linked into the region lists by index, and the keys are found through an open addressing
+// table that is probed several buckets at a time.
+class TinyLFUCacheAlgorithm : public CacheAlgorithm {
+ public:
+  TinyLFUCacheAlgorithm(size_t cache_size, int min_host_index, int max_host_index);
+  ~TinyLFUCacheAlgorithm() override = default;
+
+  int Get(int key) override;
+
+  void Put(int key, int value) override;
+  Status CheckCacheHit(const int *batch_ids, const size_t batch_ids_len, int *cache_index,
+                       std::vector<int> *need_swap_indies, std::vector<int> *need_swap_indies_cache_index) override;
+
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  enum Region : uint8_t { kFree = 0, kWindow, kProbation, kProtected, kRegionNum };
+  struct SlotList {
+    int head = -1;
+    int tail = -1;
+    size_t size = 0;
+  };
+
+  int Find(int key) const;
+  void IndexInsert(int key, int slot);
+  void IndexErase(int key);
+
+  void PushFront(Region region, int slot);
+  void Remove(int slot);
+  int LastUnpinned(Region region) const;
+
+  void Touch(int slot);
+  int Admit(int key);
+  int EvictSlot();
+
+  size_t cache_size_;
+  int min_host_index_{0};
+  int max_host_index_{1};
+  size_t window_capacity_{0};
+  size_t protected_capacity_{0};
+  FrequencySketch sketch_;
+
+  // key -> slot, linear probing over a power of two table at most half full
+  std::vector<int> index_keys_;
+  std::vector<int> index_slots_;
+  size_t index_mask_{0};
+
+  std::vector<int> slot_keys_;
+  std::vector<int> prev_;
+  std::vector<int> next_;
+  std::vector<uint8_t> regions_;
+  // the batch that last used the slot, such slots are never evicted by the misses of the same batch
+  std::vector<uint32_t> stamps_;
+  SlotList lists_[kRegionNum];
+  uint32_t stamp_{0};
+
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+};
+}  // namespace cache
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_TINY_LFU_CACHE_H_
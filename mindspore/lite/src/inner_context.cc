@@ -18,6 +18,7 @@
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/common/log_util.h"
+#include "nnacl/nnacl_utils.h"
 #ifdef ENABLE_MINDRT
 #include "thread/actor_threadpool.h"
 #endif
@@ -51,6 +52,7 @@ InnerContext::InnerContext(const Context *context) {
     this->allocator = context->allocator;
     this->thread_num_ = context->thread_num_;
     this->enable_parallel_ = context->enable_parallel_;
+    this->enable_inter_op_parallel_ = context->enable_inter_op_parallel_;
     this->affinity_core_list_ = context->affinity_core_list_;
     SetContextDevice(context);
     this->delegate = context->delegate;
@@ -191,6 +193,15 @@ int InnerContext::IsValid() const {
     MS_LOG(ERROR) << "CPU bind mode should be one of NO_BIND, HIGHER_CPU or MID_CPU.";
     return RET_NOT_SUPPORT;
   }
+#ifdef NNACL_X86
+  // Not fatal: kernels which pick their ISA at run time fall back to what the CPU supports. Only those compiled
+  // for the build ISA alone would fault.
+  if (GetX86Isa() < X86_BUILD_ISA) {
+    MS_LOG(WARNING) << "This package is built for " << X86IsaName(X86_BUILD_ISA) << ", but the CPU only supports "
+                    << X86IsaName(GetX86Isa()) << ". Kernels fall back to " << X86IsaName(GetX86Isa())
+                    << " where they can.";
+  }
+#endif
 
 #ifndef SUPPORT_GPU
   if (IsUserSetGpu()) {
@@ -217,6 +228,13 @@ bool InnerContext::IsCpuFloat16Enabled() const {
   return GetCpuInfo().enable_float16_;
 }
 
+bool InnerContext::IsCpuBfloat16Enabled() const {
+  if (!IsCpuEnabled()) {
+    return false;
+  }
+  return GetCpuInfo().enable_bfloat16_;
+}
+
 bool InnerContext::IsGpuFloat16Enabled() const {
 #ifdef GPU_OPENCL
   if (!IsGpuEnabled()) {
@@ -37,6 +37,8 @@ struct InnerContext : public Context {
 
   bool IsCpuFloat16Enabled() const;
 
+  bool IsCpuBfloat16Enabled() const;
+
   bool IsGpuFloat16Enabled() const;
 
 #ifdef ENABLE_OPENGL_TEXTURE
@@ -0,0 +1,250 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/inter_op_executor.h"
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+#include "src/common/utils.h"
+
+namespace mindspore::lite {
+namespace {
+size_t ElementsNum(const Tensor *tensor) {
+  auto num = tensor->ElementsNum();
+  return num > 0 ? static_cast<size_t>(num) : 0;
+}
+
+// Every kernel reads and writes its tensors once. A constant input larger than the output channel count is taken as
+// weights, and each output element then costs one pass over the weights of its channel, as for conv and matmul.
+size_t KernelCost(const kernel::LiteKernel *kernel) {
+  size_t io_cost = 0;
+  for (auto *tensor : kernel->in_tensors()) {
+    io_cost += ElementsNum(tensor);
+  }
+  for (auto *tensor : kernel->out_tensors()) {
+    io_cost += ElementsNum(tensor);
+  }
+  if (kernel->out_tensors().empty()) {
+    return io_cost;
+  }
+  auto *output = kernel->out_tensors().front();
+  auto out_num = ElementsNum(output);
+  auto channel = output->shape().empty() ? 0 : output->shape().back();
+  size_t mul_cost = 0;
+  for (auto *tensor : kernel->in_tensors()) {
+    if (channel > 0 && tensor->IsConst() && ElementsNum(tensor) > static_cast<size_t>(channel)) {
+      mul_cost = std::max(mul_cost, out_num * (ElementsNum(tensor) / channel));
+    }
+  }
+  return io_cost + mul_cost;
+}
+
+int InterOpLaneRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto executor = reinterpret_cast<InterOpExecutor *>(cdata);
+  return executor->RunLane();
+}
+}  // namespace
+
+int InterOpExecutor::Prepare(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &inputs,
+                             const std::vector<Tensor *> &outputs, const lite::InnerContext *ctx) {
+  CHECK_NULL_RETURN(ctx);
+  ctx_ = ctx;
+  auto ret = BuildBranches(kernels);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  CalculatePriority();
+  lanes_num_ = CalculateLanesNum();
+  pending_preds_.resize(branches_.size());
+  ready_.reserve(branches_.size());
+  MS_LOG(INFO) << "inter-op branches: " << branches_.size() << ", lanes: " << lanes_num_;
+  return RET_OK;
+}
+
+// kernels are in topological order, so a branch is always created before the branches it feeds
+int InterOpExecutor::BuildBranches(const std::vector<kernel::LiteKernel *> &kernels) {
+  branches_.clear();
+  std::unordered_set<const kernel::LiteKernel *> members(kernels.begin(), kernels.end());
+  auto in_subgraph = [&members](const kernel::LiteKernel *kernel) { return members.count(kernel) > 0; };
+  std::unordered_map<const kernel::LiteKernel *, size_t> branch_of;
+  for (auto *kernel : kernels) {
+    std::vector<kernel::LiteKernel *> preds;
+    std::copy_if(kernel->in_kernels().begin(), kernel->in_kernels().end(), std::back_inserter(preds), in_subgraph);
+    if (std::any_of(preds.begin(), preds.end(), [&branch_of](const kernel::LiteKernel *pred) {
+          return branch_of.find(pred) == branch_of.end();
+        })) {
+      MS_LOG(ERROR) << "kernels are not in topological order at " << kernel->name();
+      return RET_ERROR;
+    }
+    if (preds.size() == 1 &&
+        std::count_if(preds.front()->out_kernels().begin(), preds.front()->out_kernels().end(), in_subgraph) == 1) {
+      auto index = branch_of[preds.front()];
+      branches_[index].kernels_.push_back(kernel);
+      branches_[index].cost_ += KernelCost(kernel);
+      branch_of[kernel] = index;
+      continue;
+    }
+    Branch branch;
+    branch.kernels_.push_back(kernel);
+    branch.cost_ = KernelCost(kernel);
+    auto index = branches_.size();
+    for (auto *pred : preds) {
+      auto &succs = branches_[branch_of[pred]].succs_;
+      if (!IsContain(succs, index)) {
+        succs.push_back(index);
+        branch.preds_num_++;
+      }
+    }
+    branch_of[kernel] = index;
+    branches_.push_back(branch);
+  }
+  return RET_OK;
+}
+
+void InterOpExecutor::CalculatePriority() {
+  for (auto iter = branches_.rbegin(); iter != branches_.rend(); ++iter) {
+    size_t succ_priority = 0;
+    for (auto succ : iter->succs_) {
+      succ_priority = std::max(succ_priority, branches_[succ].priority_);
+    }
+    iter->priority_ = iter->cost_ + succ_priority;
+  }
+}
+
+// as many lanes as branches that can be ready together, taking the branches of the same depth as an estimate, and
+// never more than the kernel threads of the context
+size_t InterOpExecutor::CalculateLanesNum() const {
+  std::vector<size_t> depth(branches_.size(), 0);
+  std::vector<size_t> width(branches_.size() + 1, 0);
+  for (size_t i = 0; i < branches_.size(); i++) {
+    width[depth[i]]++;
+    for (auto succ : branches_[i].succs_) {
+      depth[succ] = std::max(depth[succ], depth[i] + 1);
+    }
+  }
+  auto max_width = *std::max_element(width.begin(), width.end());
+  return std::max<size_t>(1, std::min<size_t>(max_width, ctx_->thread_num_));
+}
+
+int InterOpExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                         const std::vector<kernel::LiteKernel *> &kernels, const KernelCallBack &before,
+                         const KernelCallBack &after) {
+  CHECK_NULL_RETURN(ctx_);
+  auto start = std::chrono::steady_clock::now();
+  ready_.clear();
+  finished_num_ = 0;
+  status_ = RET_OK;
+  for (size_t i = 0; i < branches_.size(); i++) {
+    pending_preds_[i] = branches_[i].preds_num_;
+    if (pending_preds_[i] == 0) {
+      PushReady(i);
+    }
+  }
+  auto ret = ParallelLaunch(ctx_, InterOpLaneRun, this, static_cast<int>(lanes_num_));
+  if (ret != RET_OK || status_ != RET_OK) {
+    MS_LOG(ERROR) << "inter-op run failed: " << status_;
+    return status_ != RET_OK ? status_ : RET_ERROR;
+  }
+  auto end = std::chrono::steady_clock::now();
+  UpdateStat(std::chrono::duration<float, std::micro>(end - start).count());
+  return RET_OK;
+}
+
+int InterOpExecutor::RunLane() {
+  while (true) {
+    size_t index;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_var_.wait(lock, [this] {
+        return !ready_.empty() || finished_num_ == branches_.size() || status_ != RET_OK;
+      });
+      if (ready_.empty() || status_ != RET_OK) {
+        return RET_OK;
+      }
+      index = PopReady();
+    }
+    auto ret = RunBranch(&branches_[index]);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (ret != RET_OK) {
+        status_ = ret;
+      } else {
+        finished_num_++;
+        for (auto succ : branches_[index].succs_) {
+          if (--pending_preds_[succ] == 0) {
+            PushReady(succ);
+          }
+        }
+      }
+    }
+    cond_var_.notify_all();
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+}
+
+int InterOpExecutor::RunBranch(Branch *branch) {
+  auto start = std::chrono::steady_clock::now();
+  for (auto *kernel : branch->kernels_) {
+    auto ret = kernel->Execute();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+      return ret;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  branch->run_us_ = std::chrono::duration<float, std::micro>(end - start).count();
+  return RET_OK;
+}
+
+// ready_ is a max heap on the branch priority
+void InterOpExecutor::PushReady(size_t index) {
+  ready_.push_back(index);
+  std::push_heap(ready_.begin(), ready_.end(),
+                 [this](size_t lhs, size_t rhs) { return branches_[lhs].priority_ < branches_[rhs].priority_; });
+}
+
+size_t InterOpExecutor::PopReady() {
+  std::pop_heap(ready_.begin(), ready_.end(),
+                [this](size_t lhs, size_t rhs) { return branches_[lhs].priority_ < branches_[rhs].priority_; });
+  auto index = ready_.back();
+  ready_.pop_back();
+  return index;
+}
+
+void InterOpExecutor::UpdateStat(float latency_us) {
+  std::vector<float> path_us(branches_.size(), 0);
+  stat_.latency_us_ = latency_us;
+  stat_.critical_path_us_ = 0;
+  stat_.serial_us_ = 0;
+  for (auto iter = branches_.rbegin(); iter != branches_.rend(); ++iter) {
+    auto index = static_cast<size_t>(branches_.rend() - iter) - 1;
+    float succ_us = 0;
+    for (auto succ : iter->succs_) {
+      succ_us = std::max(succ_us, path_us[succ]);
+    }
+    path_us[index] = iter->run_us_ + succ_us;
+    stat_.critical_path_us_ = std::max(stat_.critical_path_us_, path_us[index]);
+    stat_.serial_us_ += iter->run_us_;
+  }
+  MS_LOG(INFO) << "inter-op latency: " << stat_.latency_us_ << " us, critical path: " << stat_.critical_path_us_
+               << " us, serial: " << stat_.serial_us_ << " us";
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_INTER_OP_EXECUTOR_H_
+#define MINDSPORE_LITE_SRC_INTER_OP_EXECUTOR_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "src/executor.h"
+#include "src/lite_kernel.h"
+
+namespace mindspore::lite {
+// timing of the last run, in microseconds.
+// critical_path_us_ is the heaviest dependency path through the measured kernels, the latency the run could reach with
+// enough threads; serial_us_ is the sum of all kernels, the latency of running them one after another.
+struct InterOpStat {
+  float latency_us_ = 0;
+  float critical_path_us_ = 0;
+  float serial_us_ = 0;
+};
+
+// Runs the independent branches of a cpu subgraph side by side on the context thread pool.
+// The kernels are cut into branches, runs of kernels where each one only feeds the next. Every lane of a
+// ParallelLaunch keeps taking the ready branch with the heaviest remaining path until all of them are done, and the
+// kernels of a branch still launch their own intra-op tasks, which go to whatever workers the other lanes leave idle.
+class InterOpExecutor : public Executor {
+ public:
+  InterOpExecutor() = default;
+  ~InterOpExecutor() override = default;
+
+  int Prepare(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &inputs,
+              const std::vector<Tensor *> &outputs, const lite::InnerContext *ctx) override;
+
+  int Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+          const std::vector<kernel::LiteKernel *> &kernels, const KernelCallBack &before = nullptr,
+          const KernelCallBack &after = nullptr) override;
+
+  // whether the kernels have branches that can overlap on the thread pool at all
+  bool HasParallelBranches() const { return lanes_num_ > 1; }
+
+  size_t branches_num() const { return branches_.size(); }
+
+  size_t lanes_num() const { return lanes_num_; }
+
+  const InterOpStat &stat() const { return stat_; }
+
+  int RunLane();
+
+ private:
+  struct Branch {
+    std::vector<kernel::LiteKernel *> kernels_;
+    std::vector<size_t> succs_;
+    size_t preds_num_ = 0;
+    size_t cost_ = 0;
+    // cost of this branch and of its heaviest path of successors
+    size_t priority_ = 0;
+    float run_us_ = 0;
+  };
+
+  int BuildBranches(const std::vector<kernel::LiteKernel *> &kernels);
+  void CalculatePriority();
+  size_t CalculateLanesNum() const;
+  int RunBranch(Branch *branch);
+  void PushReady(size_t index);
+  size_t PopReady();
+  void UpdateStat(float latency_us);
+
+  std::vector<Branch> branches_;
+  size_t lanes_num_ = 1;
+
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  std::vector<size_t> pending_preds_;
+  std::vector<size_t> ready_;
+  size_t finished_num_ = 0;
+  int status_ = RET_OK;
+  InterOpStat stat_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_INTER_OP_EXECUTOR_H_
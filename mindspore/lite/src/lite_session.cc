@@ -182,9 +182,15 @@ int LiteSession::ConvertTensorsData(const lite::LiteModel *model, size_t tensor_
       MS_LOG(ERROR) << "Tensor data shape invalid";
       return RET_ERROR;
     }
-    auto data_pair = src_tensor->ReleaseData();
-    dst_tensor->set_data(data_pair.second);
-    dst_tensor->set_own_data(data_pair.first);
+    if (shared_model_) {
+      // Other sessions read the same data, none of them may take it over, nor free it after packing.
+      dst_tensor->set_data(const_cast<void *>(src_tensor->data()));
+      dst_tensor->set_own_data(false);
+    } else {
+      auto data_pair = src_tensor->ReleaseData();
+      dst_tensor->set_data(data_pair.second);
+      dst_tensor->set_own_data(data_pair.first);
+    }
   } else if (ret != RET_OK) {
     MS_LOG(ERROR) << "Decompress tensor data failed: " << ret;
     return ret;
@@ -1134,6 +1140,10 @@ int LiteSession::RuntimeAllocatorValid() {
     MS_LOG(DEBUG) << "Not support runtime allocator in subgraph parallel.";
     return RET_ERROR;
   }
+  if (context_->enable_inter_op_parallel_) {
+    MS_LOG(DEBUG) << "Not support runtime allocator in inter-op parallel.";
+    return RET_ERROR;
+  }
   if (is_train_session_ == true) {
     MS_LOG(DEBUG) << "Not support runtime allocator in train session.";
     return RET_ERROR;
@@ -89,6 +89,9 @@ class LiteSession : public session::LiteSession {
 
   void set_model(Model *model) { this->model_ = model; }
 
+  // The model is compiled by more than one session, so its const data stays owned by the model.
+  void set_shared_model(bool shared_model) { this->shared_model_ = shared_model; }
+
   const std::vector<kernel::LiteKernel *> &get_kernels() const { return this->kernels_; }
 
   const Delegate *get_delegate() const { return this->delegate_.get(); }
@@ -185,6 +188,7 @@ class LiteSession : public session::LiteSession {
   Model *model_ = nullptr;
   std::atomic<bool> is_running_ = {false};
   bool is_train_session_ = false;
+  bool shared_model_ = false;
   friend class TransferSession;
 #if GPU_OPENCL
   opencl::OpenCLRuntimeInnerWrapper *opencl_runtime_wrapper_{nullptr};
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include "nnacl/fp32/matmul_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/bf16/matmul_bf16.h"
 
 using mindspore::lite::RET_NULL_PTR;
 
@@ -37,6 +38,11 @@ MatmulFp32BaseCPUKernel::~MatmulFp32BaseCPUKernel() {
   FreeResizeBufA();
   FreeResizeBufB();
   FreeBiasBuf();
+  FreeWeightQuantBuf();
+  FreeBf16WeightBuf();
+#ifdef ENABLE_SPARSE_COMPUTE
+  FreeSparseWeightBuf();
+#endif
 }
 
 void MatmulFp32BaseCPUKernel::InitParameter() {
@@ -206,6 +212,310 @@ void MatmulFp32BaseCPUKernel::FreeResizeBufB() {
   }
 }
 
+void MatmulFp32BaseCPUKernel::FreeWeightQuantBuf() {
+  if (b_quant_ptr_ != nullptr) {
+    free(b_quant_ptr_);
+    b_quant_ptr_ = nullptr;
+  }
+  if (b_quant_scale_ != nullptr) {
+    free(b_quant_scale_);
+    b_quant_scale_ = nullptr;
+    b_quant_offset_ = nullptr;
+  }
+}
+
+int MatmulFp32BaseCPUKernel::InitWeightQuant(const lite::Tensor *b_tensor) {
+  auto quant_params = b_tensor->quant_params();
+  auto channels = static_cast<int>(quant_params.size());
+  if (channels != 1 && channels != params_->col_) {
+    MS_LOG(ERROR) << "weight quant channels " << channels << " mismatch output channels " << params_->col_;
+    return RET_ERROR;
+  }
+  MS_CHECK_TRUE_RET(b_tensor->data() != nullptr, RET_NULL_PTR);
+  FreeWeightQuantBuf();
+  // the weight tensor is freed after Prepare as a packed weight, so keep our own int8 copy.
+  size_t weight_size = static_cast<size_t>(b_batch_) * params_->deep_ * params_->col_;
+  MS_CHECK_TRUE_RET(b_tensor->Size() == weight_size, RET_ERROR);
+  b_quant_ptr_ = reinterpret_cast<int8_t *>(malloc(weight_size));
+  if (b_quant_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "malloc b_quant_ptr_ failed";
+    return RET_ERROR;
+  }
+  memcpy(b_quant_ptr_, b_tensor->data(), weight_size);
+  b_quant_scale_ = reinterpret_cast<float *>(malloc(C2NUM * params_->col_align_ * sizeof(float)));
+  if (b_quant_scale_ == nullptr) {
+    MS_LOG(ERROR) << "malloc b_quant_scale_ failed";
+    FreeWeightQuantBuf();
+    return RET_ERROR;
+  }
+  b_quant_offset_ = b_quant_scale_ + params_->col_align_;
+  memset(b_quant_scale_, 0, C2NUM * params_->col_align_ * sizeof(float));
+  // (q - zp) * scale * var_corr + mean_corr is folded into q * scale' + offset per output channel.
+  for (int oc = 0; oc < params_->col_; ++oc) {
+    const auto &param = quant_params.at(channels == 1 ? 0 : oc);
+    float var_corr = 1.0f;
+    float mean_corr = 0.0f;
+    if (channels != 1) {
+      var_corr = (param.var_corr < 0 || param.var_corr > 10) ? 1.0f : param.var_corr;
+      mean_corr = param.mean_corr;
+    }
+    b_quant_scale_[oc] = static_cast<float>(param.scale) * var_corr;
+    b_quant_offset_[oc] = mean_corr - param.zeroPoint * b_quant_scale_[oc];
+  }
+  weight_quant_ = true;
+  return RET_OK;
+}
+
+void MatmulFp32BaseCPUKernel::FreeBf16WeightBuf() {
+  if (bf16_b_ptr_ != nullptr) {
+    free(bf16_b_ptr_);
+    bf16_b_ptr_ = nullptr;
+  }
+  bf16_weight_ = false;
+}
+
+int MatmulFp32BaseCPUKernel::InitBf16Weight(const float *weight) {
+  CHECK_NULL_RETURN(weight);
+  MS_CHECK_TRUE_RET(params_->deep_ > 0 && params_->col_ > 0, RET_ERROR);
+  FreeBf16WeightBuf();
+  // the weight tensor is freed after Prepare as a packed weight, so the bf16 weight is a copy of ours
+  size_t pack_size = MatMulBf16PackedWeightSize(params_->deep_, params_->col_);
+  bf16_b_ptr_ = reinterpret_cast<bf16_t *>(malloc(pack_size * sizeof(bf16_t)));
+  if (bf16_b_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "malloc bf16_b_ptr_ failed";
+    return RET_ERROR;
+  }
+  PackMatMulBf16Weight(weight, bf16_b_ptr_, params_->deep_, params_->col_, params_->b_transpose_);
+  bf16_blocks_ = UP_DIV(params_->col_, MATMUL_BF16_BLOCK);
+  bf16_weight_ = true;
+  MS_LOG(INFO) << "matmul " << this->name() << " keeps its " << params_->deep_ << "x" << params_->col_
+               << " weight in bf16";
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::InitBf16MatrixA(const float *src_ptr) {
+  CHECK_NULL_RETURN(src_ptr);
+  size_t deep = static_cast<size_t>(params_->deep_);
+  size_t row = static_cast<size_t>(params_->row_);
+  MS_ASSERT(ms_context_->allocator != nullptr);
+  bf16_a_ptr_ = reinterpret_cast<bf16_t *>(
+    ms_context_->allocator->Malloc(static_cast<size_t>(params_->batch) * row * deep * sizeof(bf16_t)));
+  if (bf16_a_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "malloc bf16_a_ptr_ failed";
+    return RET_ERROR;
+  }
+  // the weight has a single batch, so the batches of A are stacked into one row x deep matrix
+  for (int i = 0; i < params_->batch; ++i) {
+    const float *src = src_ptr + static_cast<size_t>(a_offset_[i]) * deep * row;
+    bf16_t *dst = bf16_a_ptr_ + static_cast<size_t>(i) * row * deep;
+    if (!params_->a_transpose_) {
+      Float32ToBf16(src, dst, static_cast<int>(row * deep));
+      continue;
+    }
+    for (size_t r = 0; r < row; ++r) {
+      for (size_t d = 0; d < deep; ++d) {
+        dst[r * deep + d] = Fp32ToBf16(src[d * row + r]);
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::ParallelRunByBf16Block(int task_id) const {
+  int start_block = task_id * bf16_stride_;
+  int end_block = MSMIN(bf16_blocks_, start_block + bf16_stride_);
+  if (start_block >= end_block) {
+    return RET_OK;
+  }
+  MatMulBf16(bf16_a_ptr_, bf16_b_ptr_, bias_ptr_, batch_c_ptr_, params_->act_type_, params_->batch * params_->row_,
+             params_->deep_, params_->col_, params_->col_, start_block, end_block);
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::Bf16Run() {
+  auto ret = InitBf16MatrixA(reinterpret_cast<float *>(in_tensors_[0]->data()));
+  // MatMulBf16 stores the col_ valid channels only, straight into the output
+  batch_c_ptr_ = reinterpret_cast<float *>(out_tensors_.front()->data());
+  if (ret != RET_OK || batch_c_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "InitBf16MatrixA failed!";
+    ret = RET_ERROR;
+  } else {
+    ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "MatmulRun failed in split by bf16 block";
+    }
+  }
+  if (bf16_a_ptr_ != nullptr) {
+    ms_context_->allocator->Free(bf16_a_ptr_);
+    bf16_a_ptr_ = nullptr;
+  }
+  return ret;
+}
+
+#ifdef ENABLE_SPARSE_COMPUTE
+void MatmulFp32BaseCPUKernel::FreeSparseWeightBuf() {
+  if (sparse_b_.data_ != nullptr) {
+    free(sparse_b_.data_);
+  }
+  sparse_b_ = {};
+  sparse_weight_ = false;
+}
+
+int MatmulFp32BaseCPUKernel::InitSparseWeight(const float *weight) {
+  CHECK_NULL_RETURN(weight);
+  int deep = params_->deep_;
+  int col = params_->col_;
+  MS_CHECK_TRUE_RET(deep > 0 && col > 0, RET_ERROR);
+  // the rows are only known once the shapes are inferred, a full row tile is assumed before that
+  int row = C12NUM;
+  if (InferShapeDone()) {
+    row = out_tensors_.front()->ElementsNum() / col;
+  }
+  int block = SparseWeightBlock();
+  int nnz = SparseBlockNnz(weight, deep, col, block, params_->b_transpose_);
+  bool semi_2x4 = IsSemi2x4Weight(weight, deep, col, params_->b_transpose_);
+  auto type = ChooseSparseWeight(row, deep, col, block, nnz, semi_2x4);
+  if (type == SparseWeight_Dense) {
+    return RET_OK;
+  }
+  FreeSparseWeightBuf();
+  size_t data_size = SparseWeightDataSize(type, deep, col, block, nnz);
+  size_t index_size = SparseWeightIndexSize(type, deep, col, block, nnz);
+  // the weight tensor is freed after Prepare as a packed weight, so the compressed weight lives in one buffer of ours,
+  // the data first to keep it aligned.
+  auto buf = reinterpret_cast<uint8_t *>(malloc(data_size + index_size));
+  if (buf == nullptr) {
+    MS_LOG(ERROR) << "malloc sparse weight failed";
+    return RET_ERROR;
+  }
+  sparse_b_.type_ = type;
+  sparse_b_.deep_ = deep;
+  sparse_b_.col_ = col;
+  sparse_b_.block_ = block;
+  sparse_b_.data_ = reinterpret_cast<float *>(buf);
+  if (type == SparseWeight_Block) {
+    sparse_b_.block_offset_ = reinterpret_cast<int *>(buf + data_size);
+    sparse_b_.deep_index_ = sparse_b_.block_offset_ + UP_DIV(col, block) + 1;
+  } else {
+    sparse_b_.position_ = buf + data_size;
+  }
+  PackSparseWeight(weight, params_->b_transpose_, &sparse_b_);
+  sparse_weight_ = true;
+  MS_LOG(INFO) << "matmul " << this->name() << " uses the " << (type == SparseWeight_Block ? "block" : "2:4")
+               << " sparse weight, " << nnz << " of " << UP_DIV(col, block) * deep << " weight blocks are non-zero";
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::InitSparseMatrixA(const float *src_ptr) {
+  CHECK_NULL_RETURN(src_ptr);
+  int deep = params_->deep_;
+  int row = params_->batch * params_->row_;
+  size_t trans_size = params_->a_transpose_ ? static_cast<size_t>(row) * deep : 0;
+  size_t pack_size = sparse_b_.type_ == SparseWeight_Block ? static_cast<size_t>(UP_ROUND(row, C12NUM)) * deep : 0;
+  sparse_a_ptr_ = src_ptr;
+  if (trans_size + pack_size == 0) {
+    return RET_OK;
+  }
+  MS_ASSERT(ms_context_->allocator != nullptr);
+  a_pack_ptr_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc((trans_size + pack_size) * sizeof(float)));
+  if (a_pack_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "malloc sparse a_pack_ptr_ failed";
+    return RET_ERROR;
+  }
+  // the weight has a single batch, so the batches of A are stacked into one row x deep matrix
+  if (params_->a_transpose_) {
+    for (int i = 0; i < params_->batch; ++i) {
+      RowMajor2ColMajor(src_ptr + static_cast<size_t>(a_offset_[i]) * deep * params_->row_,
+                        a_pack_ptr_ + static_cast<size_t>(i) * params_->row_ * deep, deep, params_->row_);
+    }
+    sparse_a_ptr_ = a_pack_ptr_;
+  }
+  if (sparse_b_.type_ == SparseWeight_Block) {
+    RowMajor2Col12Major(sparse_a_ptr_, a_pack_ptr_ + trans_size, row, deep);
+    sparse_a_ptr_ = a_pack_ptr_ + trans_size;
+  }
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::ParallelRunBySparseBlock(int task_id) const {
+  int start_block = task_id * sparse_stride_;
+  int end_block = MSMIN(sparse_b_.col_blocks_, start_block + sparse_stride_);
+  if (start_block >= end_block) {
+    return RET_OK;
+  }
+  MatMulSparseFp32(sparse_a_ptr_, &sparse_b_, bias_ptr_, batch_c_ptr_, params_->act_type_,
+                   params_->batch * params_->row_, params_->col_, start_block, end_block);
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::SparseRun() {
+  auto ret = InitSparseMatrixA(reinterpret_cast<float *>(in_tensors_[0]->data()));
+  // the sparse kernels store the col_ valid channels only, straight into the output
+  batch_c_ptr_ = reinterpret_cast<float *>(out_tensors_.front()->data());
+  if (ret != RET_OK || batch_c_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "InitSparseMatrixA failed!";
+    ret = RET_ERROR;
+  } else {
+    ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "MatmulRun failed in split by sparse block";
+    }
+  }
+  // a_pack_ptr_ is always our buffer here, even for a single row
+  if (a_pack_ptr_ != nullptr) {
+    ms_context_->allocator->Free(a_pack_ptr_);
+    a_pack_ptr_ = nullptr;
+  }
+  return ret;
+}
+#endif
+
+void MatmulFp32BaseCPUKernel::ComputeMatmul(const float *a, const float *b, float *c, const float *bias, int cur_oc,
+                                            int align_oc) const {
+  if (vec_matmul_) {
+#ifdef ENABLE_AVX
+    MatVecMulAvxFp32(a, b, c, bias, params_->act_type_, params_->deep_, cur_oc, params_->col_align_);
+#elif defined(ENABLE_ARM64)
+    MatVecMulFp32Neon64(a, b, c, bias, params_->act_type_, params_->deep_, cur_oc, align_oc);
+#elif defined(ENABLE_ARM32)
+    MatVecMulFp32Block4(a, b, c, bias, params_->act_type_, params_->deep_, cur_oc);
+#else
+    MatVecMulFp32Block8(a, b, c, bias, params_->act_type_, params_->deep_, cur_oc);
+#endif
+  } else {
+#ifdef ENABLE_AVX
+    MatMulAvxFp32(a, b, c, bias, params_->act_type_, params_->deep_, cur_oc, params_->col_align_, params_->row_);
+#else
+    MatMulOpt(a, b, c, bias, params_->act_type_, params_->deep_, params_->row_, cur_oc, params_->col_, OutType_Nhwc);
+#endif
+  }
+}
+
+int MatmulFp32BaseCPUKernel::WeightQuantRun(const float *a, const int8_t *b, float *c, int start_oc, int end_oc,
+                                            int task_id) const {
+  int tile_oc = col_tile_ * C4NUM;
+  float *dequant_tile = b_tile_buf_ + static_cast<size_t>(task_id) * C2NUM * tile_oc * params_->deep_;
+  float *pack_tile = dequant_tile + tile_oc * params_->deep_;
+  for (int oc = start_oc; oc < end_oc; oc += tile_oc) {
+    int cur_oc = MSMIN(tile_oc, end_oc - oc);
+    DequantWeightInt8Tile(b, dequant_tile, b_quant_scale_, b_quant_offset_, params_->deep_, params_->col_, oc, cur_oc,
+                          params_->b_transpose_);
+    if (params_->b_transpose_) {
+      matrix_b_pack_fun_(dequant_tile, pack_tile, cur_oc, params_->deep_);
+    } else {
+      matrix_b_pack_fun_(dequant_tile, pack_tile, params_->deep_, cur_oc);
+    }
+    int align_oc = UP_ROUND(cur_oc, col_tile_);
+    auto bias = (bias_ptr_ == nullptr) ? nullptr : bias_ptr_ + oc;
+#ifdef ENABLE_AVX
+    ComputeMatmul(a, pack_tile, c + oc, bias, align_oc, align_oc);
+#else
+    ComputeMatmul(a, pack_tile, c + oc, bias, cur_oc, align_oc);
+#endif
+  }
+  return RET_OK;
+}
+
 int MatmulFp32BaseCPUKernel::ParallelRunByBatch(int task_id) const {
   int start_batch = task_id * batch_stride_;
   int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
@@ -218,28 +528,17 @@ int MatmulFp32BaseCPUKernel::ParallelRunByBatch(int task_id) const {
 
   for (int index = start_batch; index < end_batch; ++index) {
     const float *a = a_pack_ptr_ + a_offset_[index] * params_->row_align_ * params_->deep_;
-    const float *b = b_pack_ptr_ + b_offset_[index] * params_->deep_ * params_->col_align_;
     float *c = output_data_ + index * params_->row_ * col_step;
-
-    auto bias = (bias_ptr_ == nullptr) ? nullptr : bias_ptr_;
-    if (vec_matmul_) {
-#ifdef ENABLE_AVX
-      MatVecMulAvxFp32(a, b, c, bias, params_->act_type_, params_->deep_, col_step, params_->col_align_);
-#elif defined(ENABLE_ARM64)
-      MatVecMulFp32Neon64(a, b, c, bias, params_->act_type_, params_->deep_, col_step, params_->col_align_);
-#elif defined(ENABLE_ARM32)
-      MatVecMulFp32Block4(a, b, c, bias, params_->act_type_, params_->deep_, col_step);
-#else
-      MatVecMulFp32Block8(a, b, c, bias, params_->act_type_, params_->deep_, col_step);
-#endif
-    } else {
-#ifdef ENABLE_AVX
-      MatMulAvxFp32(a, b, c, bias, params_->act_type_, params_->deep_, col_step, params_->col_align_, params_->row_);
-#else
-      MatMulOpt(a, b, c, bias, params_->act_type_, params_->deep_, params_->row_, col_step, params_->col_,
-                OutType_Nhwc);
-#endif
+    if (weight_quant_) {
+      auto b = b_quant_ptr_ + b_offset_[index] * params_->deep_ * params_->col_;
+      auto ret = WeightQuantRun(a, b, c, 0, params_->col_, task_id);
+      if (ret != RET_OK) {
+        return ret;
+      }
+      continue;
     }
+    const float *b = b_pack_ptr_ + b_offset_[index] * params_->deep_ * params_->col_align_;
+    ComputeMatmul(a, b, c, bias_ptr_, col_step, params_->col_align_);
   }
   return RET_OK;
 }
@@ -256,29 +555,15 @@ int MatmulFp32BaseCPUKernel::ParallelRunByOC(int task_id) const {
     return RET_OK;
   }
 
+  if (weight_quant_) {
+    int end_oc = MSMIN(current_start_oc + oc_stride_ * col_tile_, params_->col_);
+    return WeightQuantRun(batch_a_ptr_, batch_b_quant_ptr_, batch_c_ptr_, current_start_oc, end_oc, task_id);
+  }
   auto b = batch_b_ptr_ + current_start_oc * params_->deep_;
   auto c = batch_c_ptr_ + current_start_oc;
   auto bias = (bias_ptr_ == nullptr) ? nullptr : bias_ptr_ + current_start_oc;
-  if (vec_matmul_) {
-#ifdef ENABLE_AVX
-    MatVecMulAvxFp32(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, cur_oc, params_->col_align_);
-#elif defined(ENABLE_ARM64)
-    int rest_align_col = MSMIN(params_->col_align_ - current_start_oc, oc_stride_ * col_tile_);
-    MatVecMulFp32Neon64(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, cur_oc, rest_align_col);
-#elif defined(ENABLE_ARM32)
-    MatVecMulFp32Block4(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, cur_oc);
-#else
-    MatVecMulFp32Block8(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, cur_oc);
-#endif
-  } else {
-#ifdef ENABLE_AVX
-    MatMulAvxFp32(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, cur_oc, params_->col_align_,
-                  params_->row_);
-#else
-    MatMulOpt(batch_a_ptr_, b, c, bias, params_->act_type_, params_->deep_, params_->row_, cur_oc, params_->col_,
-              OutType_Nhwc);
-#endif
-  }
+  int rest_align_col = MSMIN(params_->col_align_ - current_start_oc, oc_stride_ * col_tile_);
+  ComputeMatmul(batch_a_ptr_, b, c, bias, cur_oc, rest_align_col);
   return RET_OK;
 }
 
@@ -337,6 +622,23 @@ int MatmulFp32BaseCPUKernel::Prepare() {
   if (params_->b_const_) {
     auto b_tensor = in_tensors_[1];
     CHECK_NULL_RETURN(b_tensor);
+    if (b_tensor->data_type() == kNumberTypeInt8 && !b_tensor->quant_params().empty()) {
+      return InitWeightQuant(b_tensor);
+    }
+    // bf16 is opted into on the cpu device, and A packed at Prepare is in the fp32 layout
+    if (ms_context_->IsCpuBfloat16Enabled() && b_tensor->data_type() == kNumberTypeFloat32 && b_batch_ == 1 &&
+        !params_->a_const_) {
+      return InitBf16Weight(static_cast<float *>(b_tensor->data()));
+    }
+#ifdef ENABLE_SPARSE_COMPUTE
+    // A packed at Prepare is in the dense layout, so a constant A keeps the dense kernels
+    if (b_tensor->data_type() == kNumberTypeFloat32 && b_batch_ == 1 && !params_->a_const_) {
+      ret = InitSparseWeight(static_cast<float *>(b_tensor->data()));
+      if (ret != RET_OK || sparse_weight_) {
+        return ret;
+      }
+    }
+#endif
     if (InitBufferB() != RET_OK) {
       return RET_ERROR;
     }
@@ -400,6 +702,22 @@ int MatmulFp32BaseCPUKernel::InitTmpOutBuffer() {
 }
 
 void MatmulFp32BaseCPUKernel::GetThreadCuttingPolicy() {
+  if (bf16_weight_) {
+    thread_count_ = MSMIN(op_parameter_->thread_num_, bf16_blocks_);
+    bf16_stride_ = UP_DIV(bf16_blocks_, thread_count_);
+    batch_split_ = false;
+    parallel_fun_ = &MatmulFp32BaseCPUKernel::ParallelRunByBf16Block;
+    return;
+  }
+#ifdef ENABLE_SPARSE_COMPUTE
+  if (sparse_weight_) {
+    thread_count_ = MSMIN(op_parameter_->thread_num_, sparse_b_.col_blocks_);
+    sparse_stride_ = UP_DIV(sparse_b_.col_blocks_, thread_count_);
+    batch_split_ = false;
+    parallel_fun_ = &MatmulFp32BaseCPUKernel::ParallelRunBySparseBlock;
+    return;
+  }
+#endif
   if (params_->batch >= op_parameter_->thread_num_) {
     thread_count_ = op_parameter_->thread_num_;
     batch_stride_ = UP_DIV(params_->batch, thread_count_);
@@ -418,6 +736,14 @@ void MatmulFp32BaseCPUKernel::GetThreadCuttingPolicy() {
 }
 
 int MatmulFp32BaseCPUKernel::Run() {
+  if (bf16_weight_) {
+    return Bf16Run();
+  }
+#ifdef ENABLE_SPARSE_COMPUTE
+  if (sparse_weight_) {
+    return SparseRun();
+  }
+#endif
   if (!params_->a_const_) {
     auto a_ptr = reinterpret_cast<float *>(in_tensors_[0]->data());
     CHECK_NULL_RETURN(a_ptr);
@@ -451,6 +777,15 @@ int MatmulFp32BaseCPUKernel::Run() {
     MS_LOG(ERROR) << "InitTmpOutBuffer error!";
     return ret;
   }
+  if (weight_quant_) {
+    b_tile_buf_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(
+      static_cast<size_t>(thread_count_) * C2NUM * col_tile_ * C4NUM * params_->deep_ * sizeof(float)));
+    if (b_tile_buf_ == nullptr) {
+      MS_LOG(ERROR) << "malloc b_tile_buf_ failed";
+      FreeResizeBufA();
+      return RET_NULL_PTR;
+    }
+  }
 
   if (batch_split_) {
     ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
@@ -467,7 +802,11 @@ int MatmulFp32BaseCPUKernel::Run() {
 #endif
     for (int i = 0; i < params_->batch; ++i) {
       batch_a_ptr_ = a_pack_ptr_ + a_offset_[i] * params_->row_align_ * params_->deep_;
-      batch_b_ptr_ = b_pack_ptr_ + b_offset_[i] * params_->deep_ * params_->col_align_;
+      if (weight_quant_) {
+        batch_b_quant_ptr_ = b_quant_ptr_ + b_offset_[i] * params_->deep_ * params_->col_;
+      } else {
+        batch_b_ptr_ = b_pack_ptr_ + b_offset_[i] * params_->deep_ * params_->col_align_;
+      }
       batch_c_ptr_ = output_data_ + i * params_->row_ * col_step;
       ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
       if (ret != RET_OK) {
@@ -477,6 +816,10 @@ int MatmulFp32BaseCPUKernel::Run() {
     }
   }
 
+  if (b_tile_buf_ != nullptr) {
+    ms_context_->allocator->Free(b_tile_buf_);
+    b_tile_buf_ = nullptr;
+  }
 #ifdef ENABLE_AVX
   if (oc_res_ != 0) {
     auto out_data = reinterpret_cast<float *>(out_tensors_.front()->MutableData());
@@ -20,6 +20,10 @@
 #include <vector>
 #include "src/inner_kernel.h"
 #include "nnacl/matmul_parameter.h"
+#include "nnacl/bf16/cast_bf16.h"
+#ifdef ENABLE_SPARSE_COMPUTE
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+#endif
 #include "include/errorcode.h"
 #include "src/common/common.h"
 
@@ -45,6 +49,7 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
  public:
   int ParallelRunByOC(int task_id) const;
   int ParallelRunByBatch(int task_id) const;
+  int ParallelRunByBf16Block(int task_id) const;
   using ParallelRun = int (MatmulFp32BaseCPUKernel::*)(int task_id) const;
   ParallelRun parallel_fun_ = nullptr;
 
@@ -65,6 +70,21 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   int CalBroadCastBiasDataElements();
   int InitTmpOutBuffer();
   void GetThreadCuttingPolicy();
+  int InitWeightQuant(const lite::Tensor *b_tensor);
+  void FreeWeightQuantBuf();
+  void ComputeMatmul(const float *a, const float *b, float *c, const float *bias, int cur_oc, int align_oc) const;
+  int WeightQuantRun(const float *a, const int8_t *b, float *c, int start_oc, int end_oc, int task_id) const;
+  int InitBf16Weight(const float *weight);
+  void FreeBf16WeightBuf();
+  int InitBf16MatrixA(const float *src_ptr);
+  int Bf16Run();
+#ifdef ENABLE_SPARSE_COMPUTE
+  int InitSparseWeight(const float *weight);
+  void FreeSparseWeightBuf();
+  int InitSparseMatrixA(const float *src_ptr);
+  int SparseRun();
+  int ParallelRunBySparseBlock(int task_id) const;
+#endif
 
  protected:
   MatMulParameter *params_ = nullptr;
@@ -93,6 +113,28 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   MatrixPackFun matrix_a_pack_fun_ = nullptr;
   MatrixPackFun matrix_b_pack_fun_ = nullptr;
   bool batch_split_ = false;
+  // B is a constant int8 weight-quantized matrix. It stays int8 and is dequantized tile by tile inside the GEMM.
+  bool weight_quant_ = false;
+  int8_t *b_quant_ptr_ = nullptr;
+  float *b_quant_scale_ = nullptr;
+  float *b_quant_offset_ = nullptr;
+  float *b_tile_buf_ = nullptr;
+  const int8_t *batch_b_quant_ptr_ = nullptr;
+  // B is a constant fp32 matrix kept in bf16 in the layout of MatMulBf16, because the cpu device enables bfloat16.
+  // A is rounded to bf16 for each run, all batches stacked into one matrix, and the accumulation stays fp32.
+  bool bf16_weight_ = false;
+  bf16_t *bf16_b_ptr_ = nullptr;
+  bf16_t *bf16_a_ptr_ = nullptr;
+  int bf16_blocks_ = 0;
+  int bf16_stride_ = 0;
+#ifdef ENABLE_SPARSE_COMPUTE
+  // B is a constant fp32 matrix with enough zero blocks or 2:4 structure that the sparse kernels beat the dense GEMM.
+  // It is only kept compressed, and A is packed for the sparse kernels, all batches stacked into one matrix.
+  bool sparse_weight_ = false;
+  SparseWeight sparse_b_ = {};
+  const float *sparse_a_ptr_ = nullptr;
+  int sparse_stride_ = 0;
+#endif
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_MATMUL_FP32_BASE_H_
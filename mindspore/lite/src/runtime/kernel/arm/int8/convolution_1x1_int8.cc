@@ -151,6 +151,9 @@ void Convolution1x1Int8CPUKernel::CheckSupportOptimize() {
 #if !defined(SUPPORT_NNIE)
   }
 #endif
+#elif defined(ENABLE_AVX)
+  support_optimize_ = true;
+  matmul_func_ = MatMulInt8Avx_4x16_r;
 #endif
   return;
 }
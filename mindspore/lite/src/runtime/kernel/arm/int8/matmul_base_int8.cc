@@ -33,7 +33,7 @@ int MatmulBaseInt8Run(void *cdata, int task_id, float lhs_scale, float rhs_scale
   return RET_OK;
 }
 
-#ifdef ENABLE_ARM64
+#if defined(ENABLE_ARM64) || defined(ENABLE_AVX)
 int Arm64SdotPreRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
   CHECK_NULL_RETURN(cdata);
   auto op = reinterpret_cast<MatmulBaseInt8CPUKernel *>(cdata);
@@ -115,10 +115,17 @@ int MatmulBaseInt8CPUKernel::Arm64SdotImpl(int task_id) {
     filter_per_channel_ ? quant_param_->quant_multiplier_ + cur_stride : quant_param_->quant_multiplier_;
   int32_t *cur_zp = filter_per_channel_ ? quant_param_->filter_zp_ + cur_stride : quant_param_->filter_zp_;
 
+#ifdef ENABLE_ARM64
   MatmulInt8DpOpt(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride, param_->row_,
                   cur_oc, param_->deep_align_, input_sums_, weight_bias_sums_ + cur_stride, quant_param_->out_act_min_,
                   quant_param_->out_act_max_, quant_param_->output_.zp_, cur_mul, cur_left, cur_right, param_->col_,
                   filter_per_channel_, cur_zp);
+#else
+  MatMulInt8Avx_4x16_r(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride,
+                       param_->row_, cur_oc, param_->deep_align_, param_->col_, input_sums_,
+                       weight_bias_sums_ + cur_stride, cur_left, cur_right, cur_mul, quant_param_->output_.zp_,
+                       quant_param_->out_act_min_, quant_param_->out_act_max_, filter_per_channel_, cur_zp);
+#endif
 
   return RET_OK;
 }
@@ -278,6 +285,12 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
     col_tile_ = C4NUM;
     deep_tile_ = C16NUM;
   }
+#elif ENABLE_AVX
+  // the avx2 / avx512 vnni kernels consume the same 4x16 layouts as sdot
+  support_sdot_ = true;
+  row_tile_ = C4NUM;
+  col_tile_ = C16NUM;
+  deep_tile_ = C4NUM;
 #else
   row_tile_ = C4NUM;
   col_tile_ = C4NUM;
@@ -291,7 +304,7 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   if (param_->b_transpose_) {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Row2x16MajorInt8;
-#elif ENABLE_ARM64
+#elif defined(ENABLE_ARM64) || defined(ENABLE_AVX)
     if (support_sdot_) {
       b_pack_func_ = RowMajor2Row4x16MajorInt8;
     } else {
@@ -303,7 +316,7 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   } else {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Col16x2MajorInt8;
-#elif ENABLE_ARM64
+#elif defined(ENABLE_ARM64) || defined(ENABLE_AVX)
     if (support_sdot_) {
       b_pack_func_ = RowMajor2Col4x16MajorInt8;
     } else {
@@ -452,7 +465,7 @@ int MatmulBaseInt8CPUKernel::ReSize() {
   return RET_OK;
 }
 
-#ifdef ENABLE_ARM64
+#if defined(ENABLE_ARM64) || defined(ENABLE_AVX)
 int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
   int8_t *a_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(0)->data());
   int8_t *b_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(1)->data());
@@ -485,7 +498,7 @@ int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
 #endif
 
 int MatmulBaseInt8CPUKernel::Run() {
-#ifdef ENABLE_ARM64
+#if defined(ENABLE_ARM64) || defined(ENABLE_AVX)
   if (support_sdot_) {
     return RunArm64Sdot();
   }
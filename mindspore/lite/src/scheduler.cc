@@ -890,7 +890,9 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
   }
   int ret;
 #ifndef WEIGHT_DECODE_CLIP
-  ret = WeightDecoder::DequantNode(op_parameter, in_tensors, kernel_data_type);
+  // fp32 MatMul and FullConnection dequantize int8 weights while running, so the weights stay compressed in memory.
+  bool keep_matmul_weight = !is_train_session_ && cpu_desc.data_type == kNumberTypeFloat32;
+  ret = WeightDecoder::DequantNode(op_parameter, in_tensors, kernel_data_type, keep_matmul_weight);
   if (ret != RET_OK) {
     MS_LOG(DEBUG) << "Dequant input tensors failed: " << ret;
     return RET_NOT_SUPPORT;
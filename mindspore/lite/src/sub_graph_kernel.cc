@@ -27,6 +27,7 @@
 #include "src/runtime/infer_manager.h"
 #include "src/common/tensor_util.h"
 #include "src/common/utils.h"
+#include "src/inter_op_executor.h"
 
 namespace mindspore::kernel {
 using mindspore::lite::RET_ERROR;
@@ -206,11 +207,50 @@ int CpuSubGraph::Prepare() {
   for (auto &out : this->out_tensors()) {
     out->set_allocator(this->Context()->allocator);
   }
+  return PrepareInterOp();
+}
+
+// Branches only overlap when the user asked for inter-op parallel execution, which also keeps the runtime allocator,
+// whose offsets assume one kernel after another, out of the session. Control flow and training kernels stay serial.
+int CpuSubGraph::PrepareInterOp() {
+  delete this->executor_;
+  this->executor_ = nullptr;
+  auto context = this->Context();
+  if (!context->enable_inter_op_parallel_ || context->thread_num_ <= 1) {
+    return RET_OK;
+  }
+  for (auto *node : nodes_) {
+    if (node->subgraph_type() != kNotSubGraph || node->type() == schema::PrimitiveType_PartialFusion ||
+        node->type() == schema::PrimitiveType_Call || node->type() == schema::PrimitiveType_Switch ||
+        node->type() == schema::PrimitiveType_SwitchLayer) {
+      return RET_OK;
+    }
+    auto parameter = node->op_parameter();
+    if (parameter != nullptr && parameter->is_train_session_) {
+      return RET_OK;
+    }
+  }
+  auto executor = new (std::nothrow) lite::InterOpExecutor();
+  if (executor == nullptr) {
+    MS_LOG(ERROR) << "new InterOpExecutor failed";
+    return RET_ERROR;
+  }
+  auto ret = executor->Prepare(nodes_, this->in_tensors(), this->out_tensors(), context);
+  if (ret != RET_OK || !executor->HasParallelBranches()) {
+    MS_LOG(INFO) << this->name() << " runs its kernels serially";
+    delete executor;
+    return RET_OK;
+  }
+  this->executor_ = executor;
   return RET_OK;
 }
 
 int CpuSubGraph::Execute(const KernelCallBack &before, const KernelCallBack &after) {
   MS_ASSERT(this->Context()->allocator.get() != nullptr);
+  // callbacks are not required to be reentrant, so profiled runs keep the serial order
+  if (this->executor_ != nullptr && before == nullptr && after == nullptr) {
+    return this->executor_->Run(this->in_tensors(), this->out_tensors(), this->nodes_);
+  }
 
   for (auto *kernel : nodes_) {
     MS_ASSERT(kernel != nullptr);
@@ -133,6 +133,9 @@ class CpuSubGraph : public SubGraphKernel {
   int SetFp16Attr() override { return SubGraphKernel::SetFp16Attr(); }
   int Execute() override { return Execute(nullptr, nullptr); }
   int Execute(const KernelCallBack &before, const KernelCallBack &after) override;
+
+ private:
+  int PrepareInterOp();
 };
 
 class CpuFp32SubGraph : public CpuSubGraph {
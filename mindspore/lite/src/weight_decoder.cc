@@ -354,13 +354,17 @@ int WeightDecoder::UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *d
 }
 
 int WeightDecoder::DequantNode(OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors,
-                               TypeId dst_data_type) {
+                               TypeId dst_data_type, bool keep_matmul_weight) {
   if (op_parameter->quant_type_ != schema::QuantType_QUANT_WEIGHT) {
     return RET_OK;
   }
   int index = 0;
   for (auto &tensor : in_tensors) {
     MS_CHECK_TRUE_RET(tensor != nullptr, RET_ERROR);
+    if (keep_matmul_weight && dst_data_type == kNumberTypeFloat32 && IsKeptMatMulWeight(op_parameter, index, tensor)) {
+      index++;
+      continue;
+    }
     auto preferred_dim = GetPreferredDim(op_parameter, index++, tensor->shape());
     auto ret = WeightDecoder::DequantTensor(tensor, preferred_dim, dst_data_type);
     if (ret != RET_OK && ret != RET_NO_CHANGE) {
@@ -414,6 +418,34 @@ int WeightDecoder::GetMatMulPreferredDim(OpParameter *op_parameter, int input_in
   return 0;
 }
 
+bool WeightDecoder::IsKeptMatMulWeight(OpParameter *op_parameter, int index, const Tensor *tensor) {
+  if (index != kWeightIndex || !tensor->IsConst() || tensor->data_type() != kNumberTypeInt8 ||
+      !tensor->quant_clusters().empty()) {
+    return false;
+  }
+  auto quant_params = tensor->quant_params();
+  if (quant_params.empty() || !quant_params.front().inited) {
+    return false;
+  }
+  auto dims = tensor->shape();
+  if (dims.size() < DIMENSION_2D) {
+    return false;
+  }
+  // The kernel folds one scale and offset into every output channel of B.
+  size_t channel_num;
+  if (op_parameter->type_ == schema::PrimitiveType_FullConnection) {
+    if (dims.size() != DIMENSION_2D) {
+      return false;
+    }
+    channel_num = static_cast<size_t>(dims.front());
+  } else if (op_parameter->type_ == schema::PrimitiveType_MatMul) {
+    channel_num = static_cast<size_t>(dims.at(GetMatMulPreferredDim(op_parameter, index, dims)));
+  } else {
+    return false;
+  }
+  return quant_params.size() == kPerTensor || quant_params.size() == channel_num;
+}
+
 int WeightDecoder::GetPreferredDim(OpParameter *op_parameter, int index, const std::vector<int> &dims) {
   if (op_parameter->type_ == schema::PrimitiveType_MatMul) {
     return GetMatMulPreferredDim(op_parameter, index, dims);
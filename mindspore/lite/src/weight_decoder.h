@@ -20,7 +20,7 @@
 #include <map>
 #include <utility>
 #include <vector>
-#include <queue>
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <cmath>
@@ -132,7 +132,10 @@ int GetDataIndex(const std::vector<int> &dims, int preferred_dim, int bucket_ind
 
 class WeightDecoder {
  public:
-  static int DequantNode(OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors, TypeId dst_data_type);
+  // With keep_matmul_weight, the int8 weight of MatMul and FullConnection stays quantized when the fp32 kernel can
+  // dequantize it tile by tile while running.
+  static int DequantNode(OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors, TypeId dst_data_type,
+                         bool keep_matmul_weight = false);
 
   static int UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
 
@@ -155,6 +158,40 @@ class WeightDecoder {
 
   static int DecompressTensor(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
 
+  // Unpacks count values of kBit bits from a stream read LSB first out of consecutive T2 words, where value i starts
+  // at bit i * kBit and value = bits - 2^(kBit - 1). Bits past the end of the stream read as zero.
+  template <typename T1, typename T2, int kBit>
+  static void UnPackBits(const T2 *packed, size_t pack_size, size_t count, T1 *unpacked) {
+    constexpr size_t kWordBits = sizeof(T2) * kBitNum8;
+    constexpr uint32_t kMask = (1u << static_cast<unsigned int>(kBit)) - 1;
+    constexpr int32_t kOffset = 1 << static_cast<unsigned int>(kBit - 1);
+    size_t i = 0;
+    size_t word = 0;
+    // kWordBits values fill exactly kBit words. Inside such a block each value lies in two neighbouring words at an
+    // offset known at compile time, so the inner loop unrolls into branch free shifts and masks.
+    for (; i + kWordBits <= count && word + kBit < pack_size; i += kWordBits, word += kBit) {
+      const T2 *block = packed + word;
+      T1 *dst = unpacked + i;
+      for (size_t k = 0; k < kWordBits; ++k) {
+        const size_t bit = k * kBit;
+        uint32_t window = static_cast<uint32_t>(block[bit / kWordBits]) |
+                          (static_cast<uint32_t>(block[bit / kWordBits + 1]) << kWordBits);
+        dst[k] = static_cast<T1>(static_cast<int32_t>((window >> (bit % kWordBits)) & kMask) - kOffset);
+      }
+    }
+    uint64_t acc = 0;
+    size_t acc_bits = 0;
+    for (; i < count; ++i) {
+      while (acc_bits < static_cast<size_t>(kBit) && word < pack_size) {
+        acc |= static_cast<uint64_t>(packed[word++]) << acc_bits;
+        acc_bits += kWordBits;
+      }
+      unpacked[i] = static_cast<T1>(static_cast<int32_t>(acc & kMask) - kOffset);
+      acc >>= static_cast<unsigned int>(kBit);
+      acc_bits = acc_bits > static_cast<size_t>(kBit) ? acc_bits - kBit : 0;
+    }
+  }
+
  private:
   static int DequantTensor(Tensor *tensor, int preferred_dim, TypeId dst_data_type = kNumberTypeFloat32);
 
@@ -242,36 +279,9 @@ class WeightDecoder {
 
   static int GetMatMulPreferredDim(OpParameter *op_parameter, int input_index, const std::vector<int> &dims);
 
-  static int DequantWeight(lite::Tensor *input_tensor, int preferred_dim, TypeId dst_data_type = kNumberTypeFloat32);
+  static bool IsKeptMatMulWeight(OpParameter *op_parameter, int index, const Tensor *tensor);
 
-  template <typename T1, typename T2>
-  static void UnPackData(int origin_bit, const T2 &packed_data, std::queue<bool> *unpack_bit_data, void *unpack_int,
-                         size_t *count, bool is_last) {
-    T2 uint_result = 0;
-    T1 result;
-    UnPackFromUintToOrigin<T2>(packed_data, unpack_bit_data);
-    while (static_cast<int>(unpack_bit_data->size()) >= origin_bit) {
-      for (int k = 0; k < origin_bit; k++) {
-        bool bit_tmp = unpack_bit_data->front();
-        uint_result = (static_cast<size_t>(bit_tmp) << static_cast<unsigned int>(k)) + uint_result;
-        unpack_bit_data->pop();
-      }
-      result = uint_result - static_cast<T2>(pow(2, origin_bit - 1));
-      (static_cast<T1 *>(unpack_int))[*count] = result;
-      uint_result = 0;
-      (*count)++;
-    }
-    size_t remainder = unpack_bit_data->size();
-    if (is_last && remainder > 0) {
-      for (size_t i = 0; i < remainder; i++) {
-        bool bit = unpack_bit_data->front();
-        uint_result = (static_cast<unsigned int>(bit) << i) + uint_result;
-        unpack_bit_data->pop();
-      }
-      result = static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1)));
-      (static_cast<T1 *>(unpack_int))[*count] = result;
-    }
-  }
+  static int DequantWeight(lite::Tensor *input_tensor, int preferred_dim, TypeId dst_data_type = kNumberTypeFloat32);
 
   template <typename T1, typename T2>
   static int UnPackUtil(const SchemaTensorWrapper &src_tensor, const size_t &unpack_int_up_limit_size, int origin_bit,
@@ -285,30 +295,45 @@ class WeightDecoder {
     auto weight_data = src_tensor.data();
     size_t pack_size =
       src_tensor.handler()->dataType() == kNumberTypeInt8 ? src_tensor.length() : src_tensor.length() / 2;
-    std::queue<bool> unpack_bit_data;
-    size_t count = 0;
-    for (size_t i = 0; i < pack_size; ++i) {
-      T2 pack_data = (static_cast<const T2 *>(static_cast<const void *>(weight_data)))[i];
-      bool is_last = i == pack_size - 1;
-      if (count >= unpack_int_up_limit_size) {
-        MS_LOG(ERROR) << "extend unpack_int_up_limit_size, which is " << unpack_int_up_limit_size;
-        return RET_ERROR;
-      }
-      UnPackData<T1, T2>(origin_bit, pack_data, &unpack_bit_data, unpack_int_data, &count, is_last);
+    if (pack_size == 0) {
+      return RET_OK;
     }
-    return RET_OK;
-  }
-
-  template <typename T2>
-  static void UnPackFromUintToOrigin(const T2 &packed_data, std::queue<bool> *unpack_bit_data) {
-    auto n = packed_data;
-    size_t bit_count = 0;
-    while (bit_count < sizeof(T2) * 8) {
-      bool a = n % 2;
-      n = n >> 1;
-      bit_count++;
-      unpack_bit_data->push(a);
+    const size_t word_bits = sizeof(T2) * kBitNum8;
+    if ((pack_size - 1) * word_bits / origin_bit >= unpack_int_up_limit_size) {
+      MS_LOG(ERROR) << "extend unpack_int_up_limit_size, which is " << unpack_int_up_limit_size;
+      return RET_ERROR;
     }
+    // A trailing partial value is kept as the encoder wrote it, as long as it fits in the tensor.
+    size_t count = std::min(UP_DIV(pack_size * word_bits, static_cast<size_t>(origin_bit)), unpack_int_up_limit_size);
+    auto packed = static_cast<const T2 *>(static_cast<const void *>(weight_data));
+    auto unpacked = static_cast<T1 *>(unpack_int_data);
+    switch (origin_bit) {
+#define UNPACK_BITS_CASE(bit)                                   \
+  case bit:                                                     \
+    UnPackBits<T1, T2, bit>(packed, pack_size, count, unpacked); \
+    break;
+      UNPACK_BITS_CASE(1)
+      UNPACK_BITS_CASE(2)
+      UNPACK_BITS_CASE(3)
+      UNPACK_BITS_CASE(4)
+      UNPACK_BITS_CASE(5)
+      UNPACK_BITS_CASE(6)
+      UNPACK_BITS_CASE(7)
+      UNPACK_BITS_CASE(8)
+      UNPACK_BITS_CASE(9)
+      UNPACK_BITS_CASE(10)
+      UNPACK_BITS_CASE(11)
+      UNPACK_BITS_CASE(12)
+      UNPACK_BITS_CASE(13)
+      UNPACK_BITS_CASE(14)
+      UNPACK_BITS_CASE(15)
+      UNPACK_BITS_CASE(16)
+#undef UNPACK_BITS_CASE
+      default:
+        MS_LOG(ERROR) << "Unsupported bit number: " << origin_bit;
+        return RET_NOT_SUPPORT;
+    }
+    return RET_OK;
   }
 };
 }  // namespace mindspore::lite
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/matmul_bf16.h"
+
+namespace mindspore {
+class TestBf16Kernels : public mindspore::CommonTest {
+ public:
+  TestBf16Kernels() {}
+};
+
+namespace {
+std::vector<float> RandomData(size_t size, unsigned seed, float low = -1.0f, float high = 1.0f) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(low, high);
+  std::vector<float> data(size);
+  for (auto &value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+std::vector<bf16_t> ToBf16(const std::vector<float> &src) {
+  std::vector<bf16_t> dst(src.size());
+  Float32ToBf16(src.data(), dst.data(), static_cast<int>(src.size()));
+  return dst;
+}
+
+std::vector<float> ToFp32(const std::vector<bf16_t> &src) {
+  std::vector<float> dst(src.size());
+  Bf16ToFloat32(src.data(), dst.data(), static_cast<int>(src.size()));
+  return dst;
+}
+
+// the relative error of a bf16 operand is 2^-8, the products of a deep sum of them stay within a few of those
+void CheckClose(const std::vector<float> &out, const std::vector<float> &expect, float tolerance) {
+  ASSERT_EQ(out.size(), expect.size());
+  for (size_t i = 0; i < out.size(); i++) {
+    ASSERT_NEAR(out[i], expect[i], tolerance * (1.0f + std::fabs(expect[i]))) << "at " << i;
+  }
+}
+
+std::vector<float> RefMatMul(const std::vector<float> &a, const std::vector<float> &b, const std::vector<float> &bias,
+                             int row, int deep, int col) {
+  std::vector<float> c(static_cast<size_t>(row) * col);
+  for (int r = 0; r < row; r++) {
+    for (int j = 0; j < col; j++) {
+      double sum = bias.empty() ? 0.0 : bias[j];
+      for (int k = 0; k < deep; k++) {
+        sum += static_cast<double>(a[r * deep + k]) * b[k * col + j];
+      }
+      c[r * col + j] = static_cast<float>(sum);
+    }
+  }
+  return c;
+}
+}  // namespace
+
+TEST_F(TestBf16Kernels, Cast) {
+  // 1 + 2^-8 is a tie and rounds to the even 1, 1 + 3 * 2^-8 is a tie that rounds up to 1 + 2^-6
+  std::vector<float> src = {1.0f, -2.5f, 1.00390625f, 1.01171875f, 1.0f + 1.0f / 64 + 1.0f / 512, INFINITY, -0.0f};
+  std::vector<float> expect = {1.0f, -2.5f, 1.0f, 1.015625f, 1.015625f, INFINITY, -0.0f};
+  auto round_trip = ToFp32(ToBf16(src));
+  for (size_t i = 0; i < src.size(); i++) {
+    EXPECT_EQ(round_trip[i], expect[i]);
+    EXPECT_EQ(Bf16ToFp32(Fp32ToBf16(src[i])), expect[i]);
+  }
+  EXPECT_TRUE(std::isnan(Bf16ToFp32(Fp32ToBf16(NAN))));
+
+  auto data = RandomData(1000, 1, -100.0f, 100.0f);
+  auto vector_cast = ToBf16(data);
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(vector_cast[i], Fp32ToBf16(data[i]));
+  }
+}
+
+TEST_F(TestBf16Kernels, MatMulAccuracy) {
+  struct Shape {
+    int row;
+    int deep;
+    int col;
+  };
+  for (auto shape : {Shape{1, 7, 5}, Shape{5, 300, 33}, Shape{13, 513, 70}, Shape{6, 64, 32}, Shape{25, 31, 16}}) {
+    auto a = ToFp32(ToBf16(RandomData(static_cast<size_t>(shape.row) * shape.deep, 2)));
+    auto b = RandomData(static_cast<size_t>(shape.deep) * shape.col, 3);
+    auto bias = RandomData(shape.col, 4);
+    std::vector<bf16_t> b_pack(MatMulBf16PackedWeightSize(shape.deep, shape.col));
+    PackMatMulBf16Weight(b.data(), b_pack.data(), shape.deep, shape.col, false);
+    auto expect = RefMatMul(a, ToFp32(ToBf16(b)), bias, shape.row, shape.deep, shape.col);
+    std::vector<float> c(static_cast<size_t>(shape.row) * shape.col);
+    MatMulBf16(ToBf16(a).data(), b_pack.data(), bias.data(), c.data(), ActType_No, shape.row, shape.deep, shape.col,
+               shape.col, 0, UP_DIV(shape.col, MATMUL_BF16_BLOCK));
+    CheckClose(c, expect, 1e-4f);
+
+    // a transposed weight packs the same, split the blocks like two threads would and check relu
+    std::vector<float> b_t(b.size());
+    for (int k = 0; k < shape.deep; k++) {
+      for (int j = 0; j < shape.col; j++) {
+        b_t[j * shape.deep + k] = b[k * shape.col + j];
+      }
+    }
+    std::vector<bf16_t> b_t_pack(b_pack.size());
+    PackMatMulBf16Weight(b_t.data(), b_t_pack.data(), shape.deep, shape.col, true);
+    EXPECT_EQ(b_t_pack, b_pack);
+    int blocks = UP_DIV(shape.col, MATMUL_BF16_BLOCK);
+    std::vector<float> relu_c(c.size());
+    MatMulBf16(ToBf16(a).data(), b_pack.data(), bias.data(), relu_c.data(), ActType_Relu, shape.row, shape.deep,
+               shape.col, shape.col, 0, blocks / 2);
+    MatMulBf16(ToBf16(a).data(), b_pack.data(), bias.data(), relu_c.data(), ActType_Relu, shape.row, shape.deep,
+               shape.col, shape.col, blocks / 2, blocks);
+    for (auto &value : expect) {
+      value = std::max(value, 0.0f);
+    }
+    CheckClose(relu_c, expect, 1e-4f);
+  }
+}
+
+// The matmuls of a BERT-base encoder layer for 128 tokens and for a single one: q, k, v and the attention output
+// projection are 768x768, then the two feed-forward matmuls.
+TEST_F(TestBf16Kernels, BertLayerMatMul) {
+  for (int tokens : {128, 1}) {
+    for (auto shape : {std::make_pair(768, 768), std::make_pair(768, 3072), std::make_pair(3072, 768)}) {
+      int deep = shape.first;
+      int col = shape.second;
+      auto a = RandomData(static_cast<size_t>(tokens) * deep, 13);
+      auto b = RandomData(static_cast<size_t>(deep) * col, 14, -0.05f, 0.05f);
+      auto bias = RandomData(col, 15);
+      auto a16 = ToBf16(a);
+      std::vector<bf16_t> b_pack(MatMulBf16PackedWeightSize(deep, col));
+      PackMatMulBf16Weight(b.data(), b_pack.data(), deep, col, false);
+      std::vector<float> c(static_cast<size_t>(tokens) * col);
+      int blocks = UP_DIV(col, MATMUL_BF16_BLOCK);
+      MatMulBf16(a16.data(), b_pack.data(), bias.data(), c.data(), ActType_No, tokens, deep, col, col, 0, blocks);
+      CheckClose(c, RefMatMul(ToFp32(a16), ToFp32(ToBf16(b)), bias, tokens, deep, col), 1e-4f);
+    }
+  }
+}
+}  // namespace mindspore
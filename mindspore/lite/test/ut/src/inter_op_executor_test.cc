@@ -0,0 +1,169 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "common/common_test.h"
+#include "src/inner_kernel.h"
+#include "src/inter_op_executor.h"
+
+namespace mindspore {
+namespace {
+constexpr int kTowersNum = 3;
+constexpr int kTowerDepth = 4;
+constexpr int kThreadNum = 4;
+// only reached when the towers do not overlap, it turns a hang into a failure
+constexpr int kRendezvousTimeoutSec = 30;
+
+// The first kernel of every tower waits here until all the towers have started, which only happens when they run on
+// different lanes at the same time.
+struct Rendezvous {
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  int arrived_ = 0;
+  bool missed_ = false;
+
+  void Arrive() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    arrived_++;
+    cond_var_.notify_all();
+    if (!cond_var_.wait_for(lock, std::chrono::seconds(kRendezvousTimeoutSec),
+                            [this] { return arrived_ == kTowersNum; })) {
+      missed_ = true;
+    }
+  }
+};
+
+class RecordKernel : public kernel::InnerKernel {
+ public:
+  RecordKernel(int id, std::vector<int> *order, std::mutex *order_mutex, Rendezvous *rendezvous)
+      : kernel::InnerKernel(nullptr, {}, {}, nullptr),
+        id_(id),
+        order_(order),
+        order_mutex_(order_mutex),
+        rendezvous_(rendezvous) {}
+  int Execute() override {
+    if (rendezvous_ != nullptr) {
+      rendezvous_->Arrive();
+    }
+    std::lock_guard<std::mutex> lock(*order_mutex_);
+    order_->push_back(id_);
+    return fail_ ? lite::RET_ERROR : lite::RET_OK;
+  }
+  void set_fail(bool fail) { fail_ = fail; }
+
+ private:
+  int id_;
+  bool fail_ = false;
+  std::vector<int> *order_;
+  std::mutex *order_mutex_;
+  Rendezvous *rendezvous_;
+};
+
+void Link(kernel::LiteKernel *from, kernel::LiteKernel *to) {
+  from->AddOutKernel(to);
+  to->AddInKernel(from);
+}
+}  // namespace
+
+class TestInterOpExecutor : public mindspore::CommonTest {
+ public:
+  TestInterOpExecutor() = default;
+  void SetUp() override {
+    ctx_.thread_num_ = kThreadNum;
+    ASSERT_EQ(ctx_.Init(), lite::RET_OK);
+    // head -> kTowersNum towers of kTowerDepth kernels -> tail
+    kernels_.push_back(NewKernel(nullptr));
+    std::vector<kernel::LiteKernel *> tower_tails;
+    for (int i = 0; i < kTowersNum; i++) {
+      auto *prev = kernels_.front();
+      for (int j = 0; j < kTowerDepth; j++) {
+        auto *kernel = NewKernel(j == 0 ? &rendezvous_ : nullptr);
+        Link(prev, kernel);
+        kernels_.push_back(kernel);
+        prev = kernel;
+      }
+      tower_tails.push_back(prev);
+    }
+    kernels_.push_back(NewKernel(nullptr));
+    for (auto *tower_tail : tower_tails) {
+      Link(tower_tail, kernels_.back());
+    }
+  }
+  void TearDown() override {
+    for (auto *kernel : kernels_) {
+      delete kernel;
+    }
+    kernels_.clear();
+  }
+
+  kernel::LiteKernel *NewKernel(Rendezvous *rendezvous) {
+    auto inner = new RecordKernel(static_cast<int>(kernels_.size()), &order_, &order_mutex_, rendezvous);
+    return new kernel::LiteKernel(std::shared_ptr<kernel::Kernel>(inner));
+  }
+
+  lite::InnerContext ctx_;
+  std::vector<kernel::LiteKernel *> kernels_;
+  std::vector<int> order_;
+  std::mutex order_mutex_;
+  Rendezvous rendezvous_;
+};
+
+TEST_F(TestInterOpExecutor, TowersOverlap) {
+  lite::InterOpExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_OK);
+  // the head, one branch per tower and the tail, with a lane for every tower
+  ASSERT_EQ(executor.branches_num(), static_cast<size_t>(kTowersNum + 2));
+  ASSERT_EQ(executor.lanes_num(), static_cast<size_t>(kTowersNum));
+  ASSERT_TRUE(executor.HasParallelBranches());
+  ASSERT_EQ(executor.Run({}, {}, kernels_), lite::RET_OK);
+  ASSERT_FALSE(rendezvous_.missed_);
+  ASSERT_EQ(order_.size(), kernels_.size());
+  ASSERT_EQ(order_.front(), 0);
+  ASSERT_EQ(order_.back(), static_cast<int>(kernels_.size()) - 1);
+  // every tower keeps its own order
+  for (int i = 0; i < kTowersNum; i++) {
+    auto prev = std::find(order_.begin(), order_.end(), 1 + i * kTowerDepth);
+    for (int j = 1; j < kTowerDepth; j++) {
+      auto cur = std::find(order_.begin(), order_.end(), 1 + i * kTowerDepth + j);
+      ASSERT_TRUE(prev < cur);
+      prev = cur;
+    }
+  }
+  auto &stat = executor.stat();
+  ASSERT_LE(stat.critical_path_us_, stat.latency_us_);
+  ASSERT_LE(stat.critical_path_us_, stat.serial_us_);
+}
+
+TEST_F(TestInterOpExecutor, LanesCappedByThreads) {
+  ctx_.thread_num_ = kTowersNum - 1;
+  lite::InterOpExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_OK);
+  ASSERT_EQ(executor.lanes_num(), static_cast<size_t>(kTowersNum - 1));
+}
+
+TEST_F(TestInterOpExecutor, FailureStops) {
+  lite::InterOpExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_OK);
+  auto *inner = static_cast<RecordKernel *>(kernels_[1]->kernel());
+  inner->set_fail(true);
+  ASSERT_NE(executor.Run({}, {}, kernels_), lite::RET_OK);
+  ASSERT_TRUE(std::find(order_.begin(), order_.end(), static_cast<int>(kernels_.size()) - 1) == order_.end());
+}
+}  // namespace mindspore
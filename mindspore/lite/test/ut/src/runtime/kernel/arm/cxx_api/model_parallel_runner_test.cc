@@ -0,0 +1,171 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "include/api/model_parallel_runner.h"
+#include "include/api/context.h"
+
+namespace mindspore {
+namespace {
+constexpr int kWorkersNum = 2;
+constexpr int kClientsNum = 4;
+constexpr int kLoopCount = 4;
+constexpr int kMaxBatchSize = 4;
+constexpr int kBatchTimeoutUs = 1000;
+constexpr float kTolerance = 1e-5;
+
+std::shared_ptr<RunnerConfig> CreateConfig(int max_batch_size) {
+  auto context = std::make_shared<Context>();
+  context->SetThreadNum(1);
+  context->MutableDeviceInfo().push_back(std::make_shared<CPUDeviceInfo>());
+  auto config = std::make_shared<RunnerConfig>();
+  config->workers_num = kWorkersNum;
+  config->context = context;
+  config->max_batch_size = max_batch_size;
+  config->batch_timeout_us = kBatchTimeoutUs;
+  return config;
+}
+
+std::vector<MSTensor> CreateInputs(ModelParallelRunner *runner) {
+  std::vector<MSTensor> inputs;
+  for (auto &desc : runner->GetInputs()) {
+    std::vector<uint8_t> data(desc.DataSize(), 1);
+    auto *tensor = MSTensor::CreateTensor(desc.Name(), desc.DataType(), desc.Shape(), data.data(), data.size());
+    inputs.push_back(*tensor);
+    MSTensor::DestroyTensorPtr(tensor);
+  }
+  return inputs;
+}
+
+// A batched run may pack the data differently, so float outputs are compared with a tolerance.
+bool SameData(const MSTensor &a, const MSTensor &b) {
+  if (a.DataSize() != b.DataSize() || a.DataType() != b.DataType()) {
+    return false;
+  }
+  if (a.DataType() != DataType::kNumberTypeFloat32) {
+    return memcmp(a.Data().get(), b.Data().get(), a.DataSize()) == 0;
+  }
+  auto *x = static_cast<const float *>(a.Data().get());
+  auto *y = static_cast<const float *>(b.Data().get());
+  for (int64_t i = 0; i < a.ElementNum(); i++) {
+    if (std::fabs(x[i] - y[i]) > kTolerance * (1 + std::fabs(y[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+class TestModelParallelRunner : public mindspore::CommonTest {
+ public:
+  TestModelParallelRunner() = default;
+};
+
+TEST_F(TestModelParallelRunner, test_uninitialized_FAILURE) {
+  ModelParallelRunner runner;
+  std::vector<MSTensor> outputs;
+  ASSERT_TRUE(runner.Predict({}, &outputs) != kSuccess);
+  ASSERT_TRUE(runner.GetInputs().empty());
+  ASSERT_TRUE(runner.Init("./nets/not_exist.ms") != kSuccess);
+}
+
+TEST_F(TestModelParallelRunner, test_concurrent_predict_SUCCESS) {
+  ModelParallelRunner reference;
+  ASSERT_TRUE(reference.Init("./nets/conv_train_model.ms", CreateConfig(1)) == kSuccess);
+  auto inputs = CreateInputs(&reference);
+  std::vector<MSTensor> expect;
+  ASSERT_TRUE(reference.Predict(inputs, &expect) == kSuccess);
+  ASSERT_FALSE(expect.empty());
+
+  ModelParallelRunner runner;
+  ASSERT_TRUE(runner.Init("./nets/conv_train_model.ms", CreateConfig(kMaxBatchSize)) == kSuccess);
+  std::vector<int> failed(kClientsNum, 0);
+  std::vector<std::thread> clients;
+  for (int i = 0; i < kClientsNum; i++) {
+    clients.emplace_back([&runner, &inputs, &expect, &failed, i]() {
+      for (int j = 0; j < kLoopCount; j++) {
+        std::vector<MSTensor> outputs;
+        if (runner.Predict(inputs, &outputs) != kSuccess || outputs.size() != expect.size()) {
+          failed[i]++;
+          continue;
+        }
+        for (size_t k = 0; k < outputs.size(); k++) {
+          if (!SameData(outputs[k], expect[k])) {
+            failed[i]++;
+          }
+        }
+      }
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  for (auto num : failed) {
+    ASSERT_EQ(num, 0);
+  }
+  auto stat = runner.GetStat(true);
+  ASSERT_EQ(stat.request_num, static_cast<uint64_t>(kClientsNum * kLoopCount));
+  ASSERT_TRUE(stat.batch_num > 0 && stat.batch_num <= stat.request_num);
+  ASSERT_TRUE(stat.p50_ms <= stat.p99_ms && stat.p99_ms <= stat.max_ms);
+  ASSERT_EQ(runner.GetStat(false).request_num, 0u);
+}
+
+// The convolution is a packed op, every worker packs its own copy of the weights from the data of the one model.
+TEST_F(TestModelParallelRunner, test_packed_op_workers_SUCCESS) {
+  ModelParallelRunner reference;
+  ASSERT_TRUE(reference.Init("./nets/conv_train_model.ms", CreateConfig(1)) == kSuccess);
+  auto inputs = CreateInputs(&reference);
+  std::vector<MSTensor> expect;
+  ASSERT_TRUE(reference.Predict(inputs, &expect) == kSuccess);
+  ASSERT_FALSE(expect.empty());
+
+  constexpr int kPackedWorkersNum = 4;
+  auto config = CreateConfig(1);
+  config->workers_num = kPackedWorkersNum;
+  ModelParallelRunner runner;
+  ASSERT_TRUE(runner.Init("./nets/conv_train_model.ms", config) == kSuccess);
+  // Enough concurrent requests to keep all the workers busy.
+  std::vector<int> failed(kPackedWorkersNum * 2, 0);
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < failed.size(); i++) {
+    clients.emplace_back([&runner, &inputs, &expect, &failed, i]() {
+      for (int j = 0; j < kLoopCount; j++) {
+        std::vector<MSTensor> outputs;
+        if (runner.Predict(inputs, &outputs) != kSuccess || outputs.size() != expect.size()) {
+          failed[i]++;
+          continue;
+        }
+        for (size_t k = 0; k < outputs.size(); k++) {
+          if (!SameData(outputs[k], expect[k])) {
+            failed[i]++;
+          }
+        }
+      }
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  for (auto num : failed) {
+    ASSERT_EQ(num, 0);
+  }
+  ASSERT_EQ(runner.GetStat(false).request_num, failed.size() * kLoopCount);
+}
+}  // namespace mindspore
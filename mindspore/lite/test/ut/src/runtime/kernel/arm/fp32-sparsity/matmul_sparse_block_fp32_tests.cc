@@ -0,0 +1,254 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/fp32_sparse/matmul_sparse_block_fp32.h"
+
+namespace mindspore {
+namespace {
+// deep x col weight (col x deep when transposed) where whole blocks of block output channels at one deep index are
+// zero with probability sparsity
+std::vector<float> BlockSparseWeight(int deep, int col, int block, float sparsity, bool b_transpose, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> keep(0.0f, 1.0f);
+  std::vector<float> weight(static_cast<size_t>(deep) * col, 0.0f);
+  for (int k = 0; k < deep; k++) {
+    for (int cb = 0; cb < col; cb += block) {
+      if (keep(gen) < sparsity) {
+        continue;
+      }
+      for (int j = cb; j < std::min(cb + block, col); j++) {
+        weight[b_transpose ? j * deep + k : k * col + j] = value(gen);
+      }
+    }
+  }
+  return weight;
+}
+
+// 2 random weights of every group of 4 deep indices are zeroed, negative weights included
+std::vector<float> Semi2x4Weight(int deep, int col, bool b_transpose, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::vector<float> weight(static_cast<size_t>(deep) * col, 0.0f);
+  for (int j = 0; j < col; j++) {
+    for (int g = 0; g < deep; g += C4NUM) {
+      int first = static_cast<int>(gen() % C4NUM);
+      int second = (first + 1 + static_cast<int>(gen() % (C4NUM - 1))) % C4NUM;
+      for (int k : {first, second}) {
+        if (g + k < deep) {
+          weight[b_transpose ? j * deep + g + k : (g + k) * col + j] = value(gen);
+        }
+      }
+    }
+  }
+  return weight;
+}
+
+std::vector<float> RandomData(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto &v : data) {
+    v = value(gen);
+  }
+  return data;
+}
+
+std::vector<float> RefMatMul(const std::vector<float> &a, const std::vector<float> &b, const std::vector<float> &bias,
+                             int row, int deep, int col, bool b_transpose, int act_type) {
+  std::vector<float> c(static_cast<size_t>(row) * col);
+  for (int r = 0; r < row; r++) {
+    for (int j = 0; j < col; j++) {
+      double sum = bias.empty() ? 0.0 : bias[j];
+      for (int k = 0; k < deep; k++) {
+        sum += static_cast<double>(a[r * deep + k]) * (b_transpose ? b[j * deep + k] : b[k * col + j]);
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        sum = std::max(sum, 0.0);
+      }
+      if (act_type == ActType_Relu6) {
+        sum = std::min(sum, 6.0);
+      }
+      c[r * col + j] = static_cast<float>(sum);
+    }
+  }
+  return c;
+}
+
+class SparseMatMul {
+ public:
+  SparseMatMul(const std::vector<float> &weight, SparseWeightType type, int deep, int col, bool b_transpose) {
+    weight_.type_ = type;
+    weight_.deep_ = deep;
+    weight_.col_ = col;
+    weight_.block_ = SparseWeightBlock();
+    int nnz = SparseBlockNnz(weight.data(), deep, col, weight_.block_, b_transpose);
+    data_.resize(SparseWeightDataSize(type, deep, col, weight_.block_, nnz) / sizeof(float));
+    index_.resize(SparseWeightIndexSize(type, deep, col, weight_.block_, nnz));
+    weight_.data_ = data_.data();
+    if (type == SparseWeight_Block) {
+      weight_.block_offset_ = reinterpret_cast<int *>(index_.data());
+      weight_.deep_index_ = weight_.block_offset_ + UP_DIV(col, weight_.block_) + 1;
+    } else {
+      weight_.position_ = index_.data();
+    }
+    PackSparseWeight(weight.data(), b_transpose, &weight_);
+  }
+
+  // packs a the way the kernel of the type expects and runs all column blocks
+  void Run(const std::vector<float> &a, const float *bias, float *c, int act_type, int row) {
+    const float *src = a.data();
+    if (weight_.type_ == SparseWeight_Block) {
+      a_pack_.resize(static_cast<size_t>(UP_ROUND(row, C12NUM)) * weight_.deep_);
+      RowMajor2Col12Major(a.data(), a_pack_.data(), row, weight_.deep_);
+      src = a_pack_.data();
+    }
+    MatMulSparseFp32(src, &weight_, bias, c, act_type, row, weight_.col_, 0, weight_.col_blocks_);
+  }
+
+  const SparseWeight &weight() const { return weight_; }
+
+ private:
+  SparseWeight weight_ = {};
+  std::vector<float> data_;
+  std::vector<uint8_t> index_;
+  std::vector<float> a_pack_;
+};
+
+void CheckClose(const std::vector<float> &out, const std::vector<float> &expect, int deep) {
+  ASSERT_EQ(out.size(), expect.size());
+  for (size_t i = 0; i < out.size(); i++) {
+    ASSERT_NEAR(out[i], expect[i], 1e-5f * deep) << "at " << i;
+  }
+}
+}  // namespace
+
+class TestSparseBlockFp32 : public mindspore::CommonTest {
+ public:
+  TestSparseBlockFp32() = default;
+};
+
+TEST_F(TestSparseBlockFp32, BlockAccuracy) {
+  const int deep = 37;
+  const int col = 45;
+  int block = SparseWeightBlock();
+  for (bool b_transpose : {false, true}) {
+    auto weight = BlockSparseWeight(deep, col, block, 0.7f, b_transpose, 1);
+    SparseMatMul matmul(weight, SparseWeight_Block, deep, col, b_transpose);
+    auto bias = RandomData(col, 2);
+    // every row tile shape the kernels specialize: single rows, up to 4 rows, full and partial 12 row tiles
+    for (int row : {1, 3, 4, 5, 12, 13, 30}) {
+      for (int act_type : {ActType_No, ActType_Relu, ActType_Relu6}) {
+        auto a = RandomData(static_cast<size_t>(row) * deep, 3);
+        // the output rows are wider than col to catch stores past the col valid channels
+        int out_stride = col + 3;
+        std::vector<float> c(static_cast<size_t>(row) * out_stride, -100.0f);
+        auto expect = RefMatMul(a, weight, bias, row, deep, col, b_transpose, act_type);
+        std::vector<float> a_pack(static_cast<size_t>(UP_ROUND(row, C12NUM)) * deep);
+        RowMajor2Col12Major(a.data(), a_pack.data(), row, deep);
+        const float *src = a_pack.data();
+        // two calls over disjoint column blocks, the way two threads split the work
+        int half = matmul.weight().col_blocks_ / 2;
+        MatMulSparseFp32(src, &matmul.weight(), bias.data(), c.data(), act_type, row, out_stride, 0, half);
+        MatMulSparseFp32(src, &matmul.weight(), bias.data(), c.data(), act_type, row, out_stride, half,
+                         matmul.weight().col_blocks_);
+        for (int r = 0; r < row; r++) {
+          for (int j = 0; j < out_stride; j++) {
+            float value = c[r * out_stride + j];
+            if (j < col) {
+              ASSERT_NEAR(value, expect[r * col + j], 1e-5f * deep) << "row " << r << " col " << j;
+            } else {
+              ASSERT_EQ(value, -100.0f) << "row " << r << " col " << j;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestSparseBlockFp32, Semi2x4Accuracy) {
+  const int deep = 38;
+  const int col = 45;
+  for (bool b_transpose : {false, true}) {
+    auto weight = Semi2x4Weight(deep, col, b_transpose, 4);
+    ASSERT_TRUE(IsSemi2x4Weight(weight.data(), deep, col, b_transpose));
+    SparseMatMul matmul(weight, SparseWeight_Semi2x4, deep, col, b_transpose);
+    for (int row : {1, 2, 5, 6, 7, 13}) {
+      auto a = RandomData(static_cast<size_t>(row) * deep, 5);
+      std::vector<float> c(static_cast<size_t>(row) * col);
+      matmul.Run(a, nullptr, c.data(), ActType_No, row);
+      CheckClose(c, RefMatMul(a, weight, {}, row, deep, col, b_transpose, ActType_No), deep);
+    }
+  }
+  auto dense = RandomData(static_cast<size_t>(deep) * col, 6);
+  ASSERT_FALSE(IsSemi2x4Weight(dense.data(), deep, col, false));
+}
+
+TEST_F(TestSparseBlockFp32, ChooseSparseWeight) {
+  const int deep = 512;
+  const int col = 512;
+  int block = SparseWeightBlock();
+  int blocks = deep * UP_DIV(col, block);
+  // a dense weight, or one with too few zero blocks to pay for the index, stays dense
+  ASSERT_EQ(ChooseSparseWeight(64, deep, col, block, blocks, false), SparseWeight_Dense);
+  ASSERT_EQ(ChooseSparseWeight(64, deep, col, block, blocks * 7 / 10, false), SparseWeight_Dense);
+  ASSERT_EQ(ChooseSparseWeight(64, deep, col, block, blocks / 10, false), SparseWeight_Block);
+  ASSERT_EQ(ChooseSparseWeight(1, deep, col, block, blocks / 2, false), SparseWeight_Block);
+  // a 2:4 weight with no zero block
+  ASSERT_EQ(ChooseSparseWeight(1, deep, col, block, blocks, true), SparseWeight_Semi2x4);
+}
+
+// Sweeps the sparsity of a pruned transformer projection and of a recommendation model MLP layer: the block sparse
+// kernel stays exact, and the cost model keeps dense for a dense weight, picks block for a very sparse one and never
+// goes back to dense as the sparsity grows.
+TEST_F(TestSparseBlockFp32, SparsitySweep) {
+  struct Shape {
+    int row;
+    int deep;
+    int col;
+  };
+  int block = SparseWeightBlock();
+  for (auto shape : {Shape{1, 1024, 1024}, Shape{4, 512, 2048}, Shape{64, 768, 768}}) {
+    auto a = RandomData(static_cast<size_t>(shape.row) * shape.deep, 7);
+    auto bias = RandomData(shape.col, 8);
+    bool picked_sparse = false;
+    for (float sparsity : {0.0f, 0.5f, 0.7f, 0.8f, 0.9f, 0.95f}) {
+      auto weight = BlockSparseWeight(shape.deep, shape.col, block, sparsity, false, 9);
+      int nnz = SparseBlockNnz(weight.data(), shape.deep, shape.col, block, false);
+      auto type = ChooseSparseWeight(shape.row, shape.deep, shape.col, block, nnz, false);
+      if (sparsity == 0.0f) {
+        ASSERT_EQ(type, SparseWeight_Dense);
+      }
+      if (picked_sparse) {
+        ASSERT_EQ(type, SparseWeight_Block) << "sparsity " << sparsity;
+      }
+      picked_sparse = type == SparseWeight_Block;
+      SparseMatMul matmul(weight, SparseWeight_Block, shape.deep, shape.col, false);
+      std::vector<float> c(static_cast<size_t>(shape.row) * shape.col);
+      matmul.Run(a, bias.data(), c.data(), ActType_No, shape.row);
+      CheckClose(c, RefMatMul(a, weight, bias, shape.row, shape.deep, shape.col, false, ActType_No), shape.deep);
+    }
+    ASSERT_TRUE(picked_sparse);
+  }
+}
+}  // namespace mindspore
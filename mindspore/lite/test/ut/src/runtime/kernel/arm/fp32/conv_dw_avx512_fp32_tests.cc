@@ -0,0 +1,99 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "nnacl/fp32/conv_depthwise_fp32.h"
+#include "nnacl/nnacl_utils.h"
+
+namespace mindspore {
+class TestConvDwAvx512Fp32 : public mindspore::CommonTest {
+ public:
+  TestConvDwAvx512Fp32() {}
+};
+
+#if defined(ENABLE_AVX) && defined(NNACL_AVX512_TARGET)
+/// Feature: DepthwiseSWAvx512Kernel
+/// Description: run the avx512 sliding window kernel on one and on a full tile of pixels, for one to four C8 groups,
+/// strides 1 and 2, kernels whose packed weight rows are wider than the part used, with and without bias and
+/// activation.
+/// Expectation: every pixel gets what the avx2 one pixel kernel computes for it, and the channels past the groups are
+/// left alone. Skipped without avx512.
+TEST_F(TestConvDwAvx512Fp32, CompareWithAvx2) {
+  if (GetX86Isa() < X86_ISA_AVX512) {
+    MS_LOG(WARNING) << "The cpu is " << X86IsaName(GetX86Isa()) << ", skip the avx512 depthwise test.";
+    return;
+  }
+  const DepthwiseSWKernel avx2_kernel[C4NUM] = {DepthwiseSW1x8Kernel, DepthwiseSW1x16Kernel, DepthwiseSW1x24Kernel,
+                                                DepthwiseSW1x32Kernel};
+  const int avx512_ow_block[C4NUM] = {C12NUM, C12NUM, C6NUM, C6NUM};
+  // kernel_h, kernel_w and the width of a packed weight row, which is wider at a border
+  const std::vector<std::vector<int>> kernels = {{1, 1, 1}, {3, 3, 3}, {5, 5, 5}, {3, 2, 3}};
+  const std::vector<size_t> act_flags = {0, 2, 3};
+  // one group more than a call covers, so a write past the groups shows
+  const int oc_algin = C32NUM + C8NUM;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  for (auto &kernel : kernels) {
+    int kernel_h = kernel[0];
+    int kernel_w = kernel[1];
+    int weight_w = kernel[2];
+    for (int stride : {1, 2}) {
+      for (int oc_block = 1; oc_block <= C4NUM; oc_block++) {
+        for (int ow_block : {1, avx512_ow_block[oc_block - 1]}) {
+          int in_w = (ow_block - 1) * stride + kernel_w;
+          size_t in_sw_step = stride * oc_algin;
+          size_t in_kw_step = oc_algin;
+          size_t in_kh_step = in_w * oc_algin;
+          size_t kw_remainder = (weight_w - kernel_w) * oc_block * C8NUM;
+          std::vector<float> src(kernel_h * in_w * oc_algin);
+          std::vector<float> weight(kernel_h * weight_w * oc_block * C8NUM);
+          std::vector<float> bias(C32NUM);
+          for (auto *data : {&src, &weight, &bias}) {
+            for (auto &value : *data) {
+              value = dist(gen);
+            }
+          }
+          const std::vector<const float *> biases = {nullptr, bias.data()};
+          for (size_t act_flag : act_flags) {
+            for (const float *bias_data : biases) {
+              std::vector<float> expect(ow_block * oc_algin, 0.0f);
+              std::vector<float> output(ow_block * oc_algin, 0.0f);
+              for (int i = 0; i < ow_block; i++) {
+                avx2_kernel[oc_block - 1](expect.data() + i * oc_algin, src.data() + i * in_sw_step, weight.data(),
+                                          bias_data, kernel_h, kernel_w, act_flag, 1, oc_block, oc_algin, in_kw_step,
+                                          in_kh_step, in_sw_step, kw_remainder);
+              }
+              DepthwiseSWAvx512Kernel(output.data(), src.data(), weight.data(), bias_data, kernel_h, kernel_w,
+                                      act_flag, ow_block, oc_block, oc_algin, in_kw_step, in_kh_step, in_sw_step,
+                                      kw_remainder);
+              for (size_t index = 0; index < output.size(); index++) {
+                ASSERT_LE(std::fabs(output[index] - expect[index]), 1e-5f * (1.0f + std::fabs(expect[index])))
+                  << "kernel " << kernel_h << "x" << kernel_w << ", stride " << stride << ", oc_block " << oc_block
+                  << ", ow_block " << ow_block << ", act_flag " << act_flag << ", bias " << (bias_data != nullptr)
+                  << ", at " << index;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+}  // namespace mindspore
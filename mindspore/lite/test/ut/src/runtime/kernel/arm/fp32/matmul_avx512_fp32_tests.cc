@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/nnacl_utils.h"
+
+namespace mindspore {
+class TestMatMulAvx512Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatMulAvx512Fp32() {}
+};
+
+#if defined(ENABLE_AVX) && defined(NNACL_AVX512_TARGET)
+/// Feature: MatMulAvx512Fp32
+/// Description: multiply by weights packed for the avx2 kernel, with rows, columns and depths which leave a tail of
+/// every block of the avx512 and the avx2 kernels, with and without bias and activation.
+/// Expectation: the avx512 kernel computes the same result as the avx2 kernel. Skipped without avx512.
+TEST_F(TestMatMulAvx512Fp32, CompareWithAvx2) {
+  if (GetX86Isa() < X86_ISA_AVX512) {
+    MS_LOG(WARNING) << "The cpu is " << X86IsaName(GetX86Isa()) << ", skip the avx512 matmul test.";
+    return;
+  }
+  const std::vector<int> rows = {1, 3, 5, 7, 13, 25};
+  const std::vector<int> cols = {5, 17, 37, 45, 63, 70};
+  const std::vector<int> depths = {1, 7, 31, 65};
+  const std::vector<int> act_types = {ActType_No, ActType_Relu, ActType_Relu6};
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  for (int row : rows) {
+    for (int col : cols) {
+      for (int depth : depths) {
+        // The caller pads the columns of the weight, the bias and the output to C8NUM as MatmulFp32BaseCPUKernel does.
+        int col_align = UP_ROUND(col, C8NUM);
+        std::vector<float> a(row * depth);
+        std::vector<float> b(depth * col);
+        std::vector<float> bias(col_align, 0.0f);
+        for (auto &value : a) {
+          value = dist(gen);
+        }
+        for (auto &value : b) {
+          value = dist(gen);
+        }
+        for (int i = 0; i < col; i++) {
+          bias[i] = dist(gen);
+        }
+        std::vector<float> b_pack(depth * col_align, 0.0f);
+        RowMajor2Row32Major(b.data(), b_pack.data(), depth, col);
+        const std::vector<const float *> biases = {nullptr, bias.data()};
+        for (int act_type : act_types) {
+          for (const float *bias_data : biases) {
+            std::vector<float> expect(row * col_align, 0.0f);
+            std::vector<float> output(row * col_align, 0.0f);
+            MatMulAvx2Fp32(a.data(), b_pack.data(), expect.data(), bias_data, act_type, depth, col_align, col_align,
+                           row);
+            MatMulAvx512Fp32(a.data(), b_pack.data(), output.data(), bias_data, act_type, depth, col_align, col_align,
+                             row);
+            for (int r = 0; r < row; r++) {
+              for (int c = 0; c < col; c++) {
+                auto index = r * col_align + c;
+                ASSERT_LE(std::fabs(output[index] - expect[index]), 1e-4f * (1.0f + std::fabs(expect[index])))
+                  << "row " << row << ", col " << col << ", depth " << depth << ", act_type " << act_type
+                  << ", bias " << (bias_data != nullptr) << ", at (" << r << ", " << c << ")";
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+}  // namespace mindspore
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "schema/ops_generated.h"
+#include "src/inner_context.h"
+#include "src/kernel_registry.h"
+#include "src/tensor.h"
+#include "src/tensor_category.h"
+
+namespace mindspore {
+class TestMatMulBf16Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatMulBf16Fp32() {}
+};
+
+namespace {
+struct MatMulCase {
+  schema::PrimitiveType type;
+  int batch;
+  int row;
+  int deep;
+  int col;
+  bool a_transpose;
+  bool b_transpose;
+  ActType act_type;
+  bool has_bias;
+  int thread_num;
+};
+
+std::vector<float> RandomData(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto &value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+float RoundBf16(float value) { return Bf16ToFp32(Fp32ToBf16(value)); }
+
+// c = a * b + bias on the bf16 rounded a and b, with a single batch of b as the kernel keeps it
+std::vector<float> RefMatMul(const MatMulCase &mm, const std::vector<float> &a, const std::vector<float> &b,
+                             const std::vector<float> &bias) {
+  std::vector<float> c(static_cast<size_t>(mm.batch) * mm.row * mm.col);
+  for (int n = 0; n < mm.batch; n++) {
+    for (int r = 0; r < mm.row; r++) {
+      for (int j = 0; j < mm.col; j++) {
+        double sum = bias.empty() ? 0.0 : bias[j];
+        for (int k = 0; k < mm.deep; k++) {
+          size_t a_index = mm.a_transpose ? (static_cast<size_t>(n) * mm.deep + k) * mm.row + r
+                                          : (static_cast<size_t>(n) * mm.row + r) * mm.deep + k;
+          size_t b_index = mm.b_transpose ? static_cast<size_t>(j) * mm.deep + k : static_cast<size_t>(k) * mm.col + j;
+          sum += static_cast<double>(RoundBf16(a[a_index])) * RoundBf16(b[b_index]);
+        }
+        auto value = static_cast<float>(sum);
+        if (mm.act_type == ActType_Relu || mm.act_type == ActType_Relu6) {
+          value = std::max(value, 0.0f);
+        }
+        if (mm.act_type == ActType_Relu6) {
+          value = std::min(value, 6.0f);
+        }
+        c[(static_cast<size_t>(n) * mm.row + r) * mm.col + j] = value;
+      }
+    }
+  }
+  return c;
+}
+
+// runs the registered fp32 kernel of mm.type on a context with bf16 weights enabled
+std::vector<float> RunKernel(const MatMulCase &mm, std::vector<float> *a, std::vector<float> *b,
+                             std::vector<float> *bias) {
+  std::vector<int> a_shape = mm.a_transpose ? std::vector<int>{mm.batch, mm.deep, mm.row}
+                                            : std::vector<int>{mm.batch, mm.row, mm.deep};
+  std::vector<int> b_shape = mm.b_transpose ? std::vector<int>{mm.col, mm.deep} : std::vector<int>{mm.deep, mm.col};
+  std::vector<int> c_shape = {mm.batch, mm.row, mm.col};
+  if (mm.type == schema::PrimitiveType_FullConnection) {
+    a_shape = {mm.row, mm.deep};
+    c_shape = {mm.row, mm.col};
+  }
+  std::vector<float> c(static_cast<size_t>(mm.batch) * mm.row * mm.col);
+  lite::Tensor a_tensor(kNumberTypeFloat32, a_shape, mindspore::NHWC, lite::Category::VAR);
+  lite::Tensor b_tensor(kNumberTypeFloat32, b_shape, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor bias_tensor(kNumberTypeFloat32, {mm.col}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor c_tensor(kNumberTypeFloat32, c_shape, mindspore::NHWC, lite::Category::VAR);
+  a_tensor.set_data(a->data());
+  b_tensor.set_data(b->data());
+  bias_tensor.set_data(bias->data());
+  c_tensor.set_data(c.data());
+  std::vector<lite::Tensor *> inputs = {&a_tensor, &b_tensor};
+  if (mm.has_bias) {
+    inputs.push_back(&bias_tensor);
+  }
+  std::vector<lite::Tensor *> outputs = {&c_tensor};
+
+  auto param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  EXPECT_NE(param, nullptr);
+  memset(param, 0, sizeof(MatMulParameter));
+  param->op_parameter_.type_ = mm.type;
+  param->op_parameter_.thread_num_ = mm.thread_num;
+  param->a_transpose_ = mm.a_transpose;
+  param->b_transpose_ = mm.b_transpose;
+  param->act_type_ = mm.act_type;
+  param->has_bias_ = mm.has_bias;
+
+  lite::InnerContext ctx;
+  ctx.thread_num_ = mm.thread_num;
+  ctx.device_list_.front().device_info_.cpu_device_info_.enable_bfloat16_ = true;
+  EXPECT_EQ(lite::RET_OK, ctx.Init());
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, mm.type};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  EXPECT_NE(creator, nullptr);
+  auto kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), &ctx, desc);
+  EXPECT_NE(kernel, nullptr);
+  if (kernel != nullptr) {
+    EXPECT_EQ(lite::RET_OK, kernel->Prepare());
+    EXPECT_EQ(lite::RET_OK, kernel->Run());
+    delete kernel;
+  }
+  for (auto *tensor : {&a_tensor, &b_tensor, &bias_tensor, &c_tensor}) {
+    tensor->set_data(nullptr);
+  }
+  return c;
+}
+}  // namespace
+
+/// Feature: bf16 weights of the fp32 MatMul and FullConnection kernels
+/// Description: run the registered kernels with bfloat16 enabled on the cpu device, over channels that leave a tail
+/// of the 16 channel weight blocks, several batches of a, both transposes, activations and threads.
+/// Expectation: the outputs are the products of the bf16 rounded operands, accumulated in fp32.
+TEST_F(TestMatMulBf16Fp32, MatchesRoundedReference) {
+  const std::vector<MatMulCase> cases = {
+    {schema::PrimitiveType_FullConnection, 1, 5, 37, 40, false, true, ActType_No, true, 2},
+    {schema::PrimitiveType_FullConnection, 1, 1, 64, 16, false, true, ActType_Relu, true, 1},
+    {schema::PrimitiveType_MatMul, 3, 7, 33, 21, false, false, ActType_No, false, 3},
+    {schema::PrimitiveType_MatMul, 2, 6, 24, 50, true, true, ActType_Relu6, true, 4},
+  };
+  unsigned seed = 1;
+  for (const auto &mm : cases) {
+    auto a = RandomData(static_cast<size_t>(mm.batch) * mm.row * mm.deep, seed++);
+    auto b = RandomData(static_cast<size_t>(mm.deep) * mm.col, seed++);
+    auto bias = RandomData(mm.col, seed++);
+    auto expect = RefMatMul(mm, a, b, mm.has_bias ? bias : std::vector<float>());
+    auto out = RunKernel(mm, &a, &b, &bias);
+    ASSERT_EQ(out.size(), expect.size());
+    for (size_t i = 0; i < out.size(); i++) {
+      ASSERT_NEAR(out[i], expect[i], 1e-4f * (1.0f + std::fabs(expect[i])))
+        << "type " << mm.type << ", batch " << mm.batch << ", row " << mm.row << ", deep " << mm.deep << ", col "
+        << mm.col << ", at " << i;
+    }
+  }
+}
+
+/// Feature: bf16 weights of the fp32 FullConnection kernel
+/// Description: multiply a = 1 + 2^-10, which bf16 rounds to 1, by a weight of ones.
+/// Expectation: every output is exactly deep, so the kernel took the bf16 path rather than the fp32 one.
+TEST_F(TestMatMulBf16Fp32, RoundsOperands) {
+  MatMulCase mm = {schema::PrimitiveType_FullConnection, 1, 4, 32, 24, false, true, ActType_No, false, 2};
+  std::vector<float> a(static_cast<size_t>(mm.row) * mm.deep, 1.0f + 1.0f / 1024);
+  std::vector<float> b(static_cast<size_t>(mm.deep) * mm.col, 1.0f);
+  std::vector<float> bias(mm.col, 0.0f);
+  auto out = RunKernel(mm, &a, &b, &bias);
+  for (auto value : out) {
+    ASSERT_EQ(value, static_cast<float>(mm.deep));
+  }
+}
+}  // namespace mindspore
@@ -356,4 +356,71 @@ TEST_F(TestMatMulFp32, batch) {
   for (auto t : inputs_) delete t;
   for (auto t : outputs_) delete t;
 }
+
+TEST_F(TestMatMulFp32, weight_quant_transb) {
+  constexpr int kRow = 3;
+  constexpr int kDeep = 9;
+  constexpr int kCol = 37;
+  std::vector<lite::Tensor *> inputs_;
+  std::vector<lite::Tensor *> outputs_;
+  auto matmul_param = new MatMulParameter();
+  matmul_param->a_transpose_ = false;
+  matmul_param->b_transpose_ = true;
+  matmul_param->has_bias_ = false;
+  matmul_param->act_type_ = ActType_No;
+
+  auto in_t = new lite::Tensor(kNumberTypeFloat, {kRow, kDeep}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  in_t->MallocData();
+  auto a = reinterpret_cast<float *>(in_t->MutableData());
+  for (int i = 0; i < kRow * kDeep; ++i) {
+    a[i] = static_cast<float>(i % 7 - 3) * 0.25f;
+  }
+  inputs_.push_back(in_t);
+
+  // int8 weight with one scale and zero point per output channel, kept quantized by the kernel.
+  auto weight_t = new lite::Tensor(kNumberTypeInt8, {kCol, kDeep}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  weight_t->MallocData();
+  auto b = reinterpret_cast<int8_t *>(weight_t->MutableData());
+  for (int i = 0; i < kCol * kDeep; ++i) {
+    b[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+  }
+  std::vector<lite::LiteQuantParam> quant_params;
+  for (int oc = 0; oc < kCol; ++oc) {
+    lite::LiteQuantParam param;
+    param.scale = 0.01 * (oc % 5 + 1);
+    param.zeroPoint = oc % 3 - 1;
+    param.inited = true;
+    quant_params.push_back(param);
+  }
+  weight_t->set_quant_params(quant_params);
+  inputs_.push_back(weight_t);
+
+  auto out_t = new lite::Tensor(kNumberTypeFloat, {kRow, kCol}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  out_t->MallocData();
+  outputs_.push_back(out_t);
+
+  std::vector<float> correct(kRow * kCol, 0);
+  for (int r = 0; r < kRow; ++r) {
+    for (int oc = 0; oc < kCol; ++oc) {
+      for (int d = 0; d < kDeep; ++d) {
+        float weight = (b[oc * kDeep + d] - quant_params[oc].zeroPoint) * quant_params[oc].scale;
+        correct[r * kCol + oc] += a[r * kDeep + d] * weight;
+      }
+    }
+  }
+
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  matmul_param->op_parameter_.thread_num_ = ctx->thread_num_;
+  auto mm = new kernel::MatmulCPUKernel(reinterpret_cast<OpParameter *>(matmul_param), inputs_, outputs_, ctx);
+  ASSERT_EQ(lite::RET_OK, mm->Prepare());
+  ASSERT_EQ(lite::RET_OK, mm->Run());
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(outputs_[0]->MutableData()), correct.data(),
+                                 kRow * kCol, 0.0001));
+  delete mm;
+  delete ctx;
+  for (auto t : inputs_) delete t;
+  for (auto t : outputs_) delete t;
+}
 }  // namespace mindspore
@@ -260,4 +260,46 @@ TEST_F(TestMatmulInt8, mmtest2) {
   delete[] out;
 }
 
+#ifdef ENABLE_AVX
+TEST_F(TestMatmulInt8, avx_4x16_r) {
+  const int row = 13;
+  const int col = 37;
+  const int deep = 29;
+  const int row4 = UP_ROUND(row, C4NUM);
+  const int col16 = UP_ROUND(col, C16NUM);
+  const int deep4 = UP_ROUND(deep, C4NUM);
+  std::vector<int8_t> a(row * deep);
+  std::vector<int8_t> b(col * deep);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int8_t>(i * 37 % 256 - 128);
+  }
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = static_cast<int8_t>(i * 91 % 256 - 128);
+  }
+  std::vector<int32_t> bias(col16), filter_zp(col16), left_shift(col16), right_shift(col16), multiplier(col16);
+  for (int i = 0; i < col16; i++) {
+    bias[i] = i * 53 % 2000 - 1000;
+    filter_zp[i] = i % 7 - 3;
+    left_shift[i] = i % 2;
+    right_shift[i] = -(i % 5 + 6);
+    multiplier[i] = (1 << 30) + i * 7919;
+  }
+  std::vector<int8_t> pack_b(col16 * deep4, 0);
+  RowMajor2Row4x16MajorInt8(b.data(), pack_b.data(), col, deep);
+  for (int per_channel = 0; per_channel < 2; per_channel++) {
+    std::vector<int8_t> pack_a(row4 * deep4, 0);
+    std::vector<int32_t> input_sum(row4, 0);
+    PackInput4x4AndInputSumPert(a.data(), pack_a.data(), input_sum.data(), deep, row, per_channel ? 1 : filter_zp[0]);
+    std::vector<int8_t> expect(row * col);
+    std::vector<int8_t> output(row * col);
+    MatMulInt8_4x16_r(pack_a.data(), pack_b.data(), expect.data(), row, col, deep4, col, input_sum.data(), bias.data(),
+                      left_shift.data(), right_shift.data(), multiplier.data(), 5, -128, 127, per_channel,
+                      filter_zp.data());
+    MatMulInt8Avx_4x16_r(pack_a.data(), pack_b.data(), output.data(), row, col, deep4, col, input_sum.data(),
+                         bias.data(), left_shift.data(), right_shift.data(), multiplier.data(), 5, -128, 127,
+                         per_channel, filter_zp.data());
+    ASSERT_EQ(expect, output);
+  }
+}
+#endif
 }  // namespace mindspore
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "src/delegate/parameter_cache/lfu_cache.h"
+#include "src/delegate/parameter_cache/tiny_lfu_cache.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kVocabSize = 100000;
+constexpr size_t kCacheSize = 5000;
+constexpr size_t kBatchSize = 1600;
+constexpr size_t kBatchNum = 200;
+
+// ids drawn from a zipf distribution whose hottest ids move every quarter of the trace, the way the popular items
+// of a recommendation model drift over a day
+std::vector<int> MakeTrace(double skew, unsigned int seed) {
+  std::vector<double> cdf(kVocabSize);
+  double sum = 0;
+  for (size_t i = 0; i < kVocabSize; i++) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    cdf[i] = sum;
+  }
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(0, sum);
+  std::vector<int> trace(kBatchSize * kBatchNum);
+  for (size_t i = 0; i < trace.size(); i++) {
+    auto rank = static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin());
+    size_t shift = (i * 4 / trace.size()) * (kVocabSize / 7);
+    trace[i] = static_cast<int>((rank * 7919 + shift) % kVocabSize);
+  }
+  return trace;
+}
+
+// runs the trace batch by batch and checks the contract of CheckCacheHit on the way: every id gets a valid slot,
+// the same id gets the same slot within a batch and no two ids of a batch share a slot. Returns the miss rate.
+float RunTrace(cache::CacheAlgorithm *cache, const std::vector<int> &trace) {
+  // the embedding cache starts out holding the first ids of the host table
+  for (size_t i = 0; i < kCacheSize; i++) {
+    cache->Put(static_cast<int>(i), static_cast<int>(i));
+  }
+  std::vector<int> cache_index(kBatchSize);
+  std::vector<int> need_swap;
+  std::vector<int> need_swap_index;
+  size_t distinct = 0;
+  size_t misses = 0;
+  for (size_t b = 0; b < kBatchNum; b++) {
+    const int *batch = trace.data() + b * kBatchSize;
+    need_swap.clear();
+    need_swap_index.clear();
+    auto ret = cache->CheckCacheHit(batch, kBatchSize, cache_index.data(), &need_swap, &need_swap_index);
+    if (ret != kSuccess) {
+      ADD_FAILURE() << "CheckCacheHit failed at batch " << b;
+      return 1.0f;
+    }
+
+    std::unordered_map<int, int> key_slots;
+    std::set<int> used_slots;
+    for (size_t i = 0; i < kBatchSize; i++) {
+      EXPECT_GE(cache_index[i], 0);
+      EXPECT_LT(cache_index[i], static_cast<int>(kCacheSize));
+      auto iter = key_slots.find(batch[i]);
+      if (iter == key_slots.end()) {
+        key_slots[batch[i]] = cache_index[i];
+        EXPECT_TRUE(used_slots.insert(cache_index[i]).second);
+      } else {
+        EXPECT_EQ(iter->second, cache_index[i]);
+      }
+    }
+    EXPECT_EQ(need_swap.size(), need_swap_index.size());
+    for (size_t i = 0; i < need_swap.size(); i++) {
+      EXPECT_EQ(key_slots[need_swap[i]], need_swap_index[i]);
+    }
+    distinct += key_slots.size();
+    misses += need_swap.size();
+  }
+  return static_cast<float>(misses) / distinct;
+}
+}  // namespace
+
+class TestTinyLFUCache : public mindspore::CommonTest {
+ public:
+  TestTinyLFUCache() = default;
+};
+
+TEST_F(TestTinyLFUCache, HitAndMiss) {
+  cache::TinyLFUCacheAlgorithm cache(4, 0, 100);
+  std::vector<int> ids = {1, 2, 1, 200, 3};
+  std::vector<int> cache_index(ids.size());
+  std::vector<int> need_swap;
+  std::vector<int> need_swap_index;
+  ASSERT_EQ(cache.CheckCacheHit(ids.data(), ids.size(), cache_index.data(), &need_swap, &need_swap_index), kSuccess);
+  // ids outside [min_host_index, max_host_index) are not cached here
+  ASSERT_EQ(cache_index[3], -1);
+  ASSERT_EQ(cache_index[0], cache_index[2]);
+  ASSERT_EQ(need_swap, std::vector<int>({1, 2, 3}));
+  ASSERT_EQ(cache.Get(2), cache_index[1]);
+
+  need_swap.clear();
+  need_swap_index.clear();
+  std::vector<int> again = {3, 1};
+  std::vector<int> again_index(again.size());
+  ASSERT_EQ(cache.CheckCacheHit(again.data(), again.size(), again_index.data(), &need_swap, &need_swap_index),
+            kSuccess);
+  ASSERT_TRUE(need_swap.empty());
+  ASSERT_EQ(again_index[0], cache_index[4]);
+  ASSERT_EQ(again_index[1], cache_index[0]);
+}
+
+TEST_F(TestTinyLFUCache, BatchLargerThanCache) {
+  cache::TinyLFUCacheAlgorithm cache(2, 0, 100);
+  std::vector<int> ids = {1, 2, 3};
+  std::vector<int> cache_index(ids.size());
+  std::vector<int> need_swap;
+  std::vector<int> need_swap_index;
+  ASSERT_NE(cache.CheckCacheHit(ids.data(), ids.size(), cache_index.data(), &need_swap, &need_swap_index), kSuccess);
+}
+
+TEST_F(TestTinyLFUCache, ZipfTrace) {
+  for (double skew : {0.9, 1.1}) {
+    auto trace = MakeTrace(skew, 1);
+    cache::LFUCacheAlgorithm lfu(kCacheSize, 0, kVocabSize);
+    auto lfu_miss_rate = RunTrace(&lfu, trace);
+    cache::TinyLFUCacheAlgorithm tiny_lfu(kCacheSize, 0, kVocabSize);
+    auto tiny_lfu_miss_rate = RunTrace(&tiny_lfu, trace);
+    ASSERT_LE(tiny_lfu_miss_rate, lfu_miss_rate) << "skew " << skew;
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "src/weight_decoder.h"
+
+namespace mindspore {
+namespace {
+// The bit by bit decoder UnPackBits replaced, kept here as the reference: bits are queued LSB first, every origin_bit
+// of them make a value, and the bits left after the last word make one more value.
+template <typename T1, typename T2>
+std::vector<T1> QueueUnPack(int origin_bit, const std::vector<T2> &packed) {
+  std::vector<T1> unpacked;
+  std::queue<bool> bits;
+  T2 uint_result = 0;
+  for (auto word : packed) {
+    for (size_t k = 0; k < sizeof(T2) * 8; k++) {
+      bits.push((word >> k) & 1);
+    }
+    while (static_cast<int>(bits.size()) >= origin_bit) {
+      for (int k = 0; k < origin_bit; k++) {
+        uint_result = (static_cast<size_t>(bits.front()) << static_cast<unsigned int>(k)) + uint_result;
+        bits.pop();
+      }
+      unpacked.push_back(static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1))));
+      uint_result = 0;
+    }
+  }
+  size_t remainder = bits.size();
+  if (remainder > 0) {
+    for (size_t i = 0; i < remainder; i++) {
+      uint_result = (static_cast<unsigned int>(bits.front()) << i) + uint_result;
+      bits.pop();
+    }
+    unpacked.push_back(static_cast<T1>(uint_result - static_cast<T2>(pow(2, origin_bit - 1))));
+  }
+  return unpacked;
+}
+
+template <typename T1, typename T2, int kBit>
+void CheckSameAsQueueUnPack(std::mt19937 *gen) {
+  std::uniform_int_distribution<uint32_t> dist(0, std::numeric_limits<T2>::max());
+  // sizes below one block, on a block boundary, and with a tail after several blocks
+  for (size_t pack_size : {1, kBit, kBit + 1, 7 * kBit + 3, 100}) {
+    std::vector<T2> packed(pack_size);
+    for (auto &word : packed) {
+      word = static_cast<T2>(dist(*gen));
+    }
+    auto expect = QueueUnPack<T1, T2>(kBit, packed);
+    std::vector<T1> unpacked(expect.size());
+    lite::WeightDecoder::UnPackBits<T1, T2, kBit>(packed.data(), pack_size, unpacked.size(), unpacked.data());
+    ASSERT_EQ(unpacked, expect) << "bit " << kBit << ", pack size " << pack_size;
+    // A tensor shorter than the stream only takes the leading values.
+    std::vector<T1> head(expect.size() / 2);
+    lite::WeightDecoder::UnPackBits<T1, T2, kBit>(packed.data(), pack_size, head.size(), head.data());
+    ASSERT_TRUE(std::equal(head.begin(), head.end(), expect.begin())) << "bit " << kBit << ", pack size " << pack_size;
+  }
+}
+}  // namespace
+
+class TestWeightDecoder : public mindspore::CommonTest {
+ public:
+  TestWeightDecoder() {}
+};
+
+TEST_F(TestWeightDecoder, UnPackBitsSameAsQueue) {
+  std::mt19937 gen(1);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 1>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 2>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 3>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 4>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 5>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 6>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 7>(&gen);
+  CheckSameAsQueueUnPack<int8_t, uint8_t, 8>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 9>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 10>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 11>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 12>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 13>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 14>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 15>(&gen);
+  CheckSameAsQueueUnPack<int16_t, uint16_t, 16>(&gen);
+}
+}  // namespace mindspore
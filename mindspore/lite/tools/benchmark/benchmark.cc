@@ -161,6 +161,7 @@ void Benchmark::InitContext(const std::shared_ptr<Context> &context) {
     cpu_device_ctx.device_info_.cpu_device_info_.cpu_bind_mode_ = NO_BIND;
   }
   cpu_device_ctx.device_info_.cpu_device_info_.enable_float16_ = flags_->enable_fp16_;
+  cpu_device_ctx.device_info_.cpu_device_info_.enable_bfloat16_ = flags_->enable_bf16_;
 
   if (flags_->device_ == "GPU") {
     DeviceContext gpu_device_ctx{DT_GPU, {false}};
@@ -176,6 +177,7 @@ void Benchmark::InitContext(const std::shared_ptr<Context> &context) {
 
   context->thread_num_ = flags_->num_threads_;
   context->enable_parallel_ = flags_->enable_parallel_;
+  context->enable_inter_op_parallel_ = flags_->enable_inter_op_parallel_;
 }
 
 int Benchmark::CompareOutput() {
@@ -505,6 +507,8 @@ int Benchmark::RunBenchmark() {
   MS_LOG(INFO) << "PrepareTime = " << static_cast<float>(end_prepare_time - start_prepare_time) / kNumUsPerMs << " ms";
   std::cout << "PrepareTime = " << static_cast<float>(end_prepare_time - start_prepare_time) / kNumUsPerMs << " ms"
             << std::endl;
+  PrintMemoryUsage();
+  PrintCpuIsa();
 
   // Check input names
   if (CheckInputNames() != RET_OK) {
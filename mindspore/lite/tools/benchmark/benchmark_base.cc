@@ -19,11 +19,13 @@
 #include <cinttypes>
 #undef __STDC_FORMAT_MACROS
 #include <algorithm>
+#include <cstring>
 #include <utility>
 #include <regex>
 #include <functional>
 #include "include/context.h"
 #include "include/ms_tensor.h"
+#include "nnacl/nnacl_utils.h"
 #include "include/version.h"
 #include "schema/model_generated.h"
 #include "src/common/common.h"
@@ -256,7 +258,7 @@ int BenchmarkBase::CheckThreadNumValid() {
     return RET_ERROR;
   }
 
-  if (flags_->enable_parallel_) {
+  if (flags_->enable_parallel_ || flags_->enable_inter_op_parallel_) {
     if (flags_->num_threads_ < kParallelThreadNumMin) {
       MS_LOG(ERROR) << "enable parallel need more than 1 thread.";
       std::cerr << "enable parallel need more than 1 thread." << std::endl;
@@ -370,7 +372,9 @@ int BenchmarkBase::Init() {
   MS_LOG(INFO) << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_;
   MS_LOG(INFO) << "NumThreads = " << this->flags_->num_threads_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
+  MS_LOG(INFO) << "EnableBf16 = " << this->flags_->enable_bf16_;
   MS_LOG(INFO) << "EnableParallel = " << this->flags_->enable_parallel_;
+  MS_LOG(INFO) << "EnableInterOpParallel = " << this->flags_->enable_inter_op_parallel_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
   std::cout << "ModelPath = " << this->flags_->model_file_ << std::endl;
   std::cout << "ModelType = " << this->flags_->model_type_ << std::endl;
@@ -383,8 +387,22 @@ int BenchmarkBase::Init() {
   std::cout << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_ << std::endl;
   std::cout << "NumThreads = " << this->flags_->num_threads_ << std::endl;
   std::cout << "Fp16Priority = " << this->flags_->enable_fp16_ << std::endl;
+  std::cout << "EnableBf16 = " << this->flags_->enable_bf16_ << std::endl;
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
+  std::cout << "EnableInterOpParallel = " << this->flags_->enable_inter_op_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
+  if (this->flags_->parallel_workers_ > 0) {
+    std::cout << "ParallelWorkers = " << this->flags_->parallel_workers_ << std::endl;
+    std::cout << "ParallelClients = " << this->flags_->parallel_clients_ << std::endl;
+    std::cout << "MaxBatchSize = " << this->flags_->max_batch_size_ << std::endl;
+    std::cout << "BatchTimeoutUs = " << this->flags_->batch_timeout_us_ << std::endl;
+  }
+  if (this->flags_->parallel_workers_ < 0 || this->flags_->parallel_clients_ < 0 ||
+      this->flags_->max_batch_size_ < 1 || this->flags_->batch_timeout_us_ < 0) {
+    MS_LOG(ERROR) << "Invalid throughput mode arguments.";
+    std::cerr << "Invalid throughput mode arguments." << std::endl;
+    return RET_ERROR;
+  }
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
     std::cerr << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0" << std::endl;
@@ -454,6 +472,36 @@ int BenchmarkBase::Init() {
   return RET_OK;
 }
 
+void BenchmarkBase::PrintMemoryUsage() {
+#if defined(__linux__) || defined(__ANDROID__)
+  std::ifstream status_file("/proc/self/status");
+  if (!status_file.is_open()) {
+    return;
+  }
+  std::string rss;
+  std::string peak_rss;
+  std::string line;
+  while (std::getline(status_file, line)) {
+    if (line.compare(0, strlen("VmRSS:"), "VmRSS:") == 0) {
+      rss = line.substr(strlen("VmRSS:"));
+    } else if (line.compare(0, strlen("VmHWM:"), "VmHWM:") == 0) {
+      peak_rss = line.substr(strlen("VmHWM:"));
+    }
+  }
+  rss.erase(0, rss.find_first_not_of(" \t"));
+  peak_rss.erase(0, peak_rss.find_first_not_of(" \t"));
+  MS_LOG(INFO) << "RSS = " << rss << ", PeakRSS = " << peak_rss;
+  std::cout << "RSS = " << rss << ", PeakRSS = " << peak_rss << std::endl;
+#endif
+}
+
+void BenchmarkBase::PrintCpuIsa() {
+#ifdef NNACL_X86
+  MS_LOG(INFO) << "CpuIsa = " << X86IsaName(GetX86Isa()) << ", BuildIsa = " << X86IsaName(X86_BUILD_ISA);
+  std::cout << "CpuIsa = " << X86IsaName(GetX86Isa()) << ", BuildIsa = " << X86IsaName(X86_BUILD_ISA) << std::endl;
+#endif
+}
+
 int BenchmarkBase::PrintResult(const std::vector<std::string> &title,
                                const std::map<std::string, std::pair<int, float>> &result) {
   std::vector<size_t> columnLenMax(kPrintColNum);
@@ -115,12 +115,24 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loop_count_, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
+    AddFlag(&BenchmarkFlags::enable_bf16_, "enableBf16", "Keep the constant MatMul weights of the CPU in bfloat16",
+            false);
     AddFlag(&BenchmarkFlags::enable_parallel_, "enableParallel", "Enable subgraph parallel : true | false", false);
+    AddFlag(&BenchmarkFlags::enable_inter_op_parallel_, "enableInterOpParallel",
+            "Run independent branches of a CPU subgraph side by side : true | false", false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
             "Perf event profiling(only instructions statics enabled currently)", false);
     AddFlag(&BenchmarkFlags::perf_event_, "perfEvent", "CYCLE|CACHE|STALL", "CYCLE");
+    // MarkThroughput
+    AddFlag(&BenchmarkFlags::parallel_workers_, "parallelWorkers",
+            "Serve the model with a pool of this many workers and measure the throughput, 0 to disable", 0);
+    AddFlag(&BenchmarkFlags::parallel_clients_, "parallelClients",
+            "Number of concurrent callers in throughput mode, 0 means twice the workers", 0);
+    AddFlag(&BenchmarkFlags::max_batch_size_, "maxBatchSize", "Largest dynamic batch in throughput mode", 1);
+    AddFlag(&BenchmarkFlags::batch_timeout_us_, "batchTimeoutUs",
+            "Time in microseconds a worker waits to fill a dynamic batch in throughput mode", 0);
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::benchmark_data_file_, "benchmarkDataFile", "Benchmark data file path", "");
     AddFlag(&BenchmarkFlags::benchmark_data_type_, "benchmarkDataType",
@@ -150,8 +162,15 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loop_count_ = 10;
   int num_threads_ = 2;
   bool enable_fp16_ = false;
+  bool enable_bf16_ = false;
   bool enable_parallel_ = false;
+  bool enable_inter_op_parallel_ = false;
   int warm_up_loop_count_ = 3;
+  // MarkThroughput
+  int parallel_workers_ = 0;
+  int parallel_clients_ = 0;
+  int max_batch_size_ = 1;
+  int batch_timeout_us_ = 0;
   // MarkAccuracy
   std::string benchmark_data_file_;
   std::string benchmark_data_type_ = "FLOAT";
@@ -210,6 +229,11 @@ class MS_API BenchmarkBase {
 
   int PrintResult(const std::vector<std::string> &title, const std::map<std::string, std::pair<int, float>> &result);
 
+  // Prints the resident and peak resident memory of the process, only available on Linux.
+  void PrintMemoryUsage();
+
+  void PrintCpuIsa();
+
 #ifdef ENABLE_ARM64
   int PrintPerfResult(const std::vector<std::string> &title,
                       const std::map<std::string, std::pair<int, struct PerfCount>> &result);
@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <utility>
 #include <functional>
+#include <thread>
+#include <atomic>
 #include "include/context.h"
 #include "include/ms_tensor.h"
 #include "include/version.h"
@@ -180,6 +182,7 @@ void BenchmarkUnifiedApi::UpdateDistributionModelName(const std::shared_ptr<mind
 void BenchmarkUnifiedApi::InitMSContext(const std::shared_ptr<mindspore::Context> &context) {
   context->SetThreadNum(flags_->num_threads_);
   context->SetEnableParallel(flags_->enable_parallel_);
+  context->SetEnableInterOpParallel(flags_->enable_inter_op_parallel_);
   context->SetThreadAffinity(flags_->cpu_bind_mode_);
   auto &device_list = context->MutableDeviceInfo();
 
@@ -204,6 +207,7 @@ void BenchmarkUnifiedApi::InitMSContext(const std::shared_ptr<mindspore::Context
   // CPU priority is behind GPU and NPU
   std::shared_ptr<CPUDeviceInfo> device_info = std::make_shared<CPUDeviceInfo>();
   device_info->SetEnableFP16(flags_->enable_fp16_);
+  device_info->SetEnableBF16(flags_->enable_bf16_);
   device_list.push_back(device_info);
 }
 
@@ -382,6 +386,72 @@ int BenchmarkUnifiedApi::MarkPerformance() {
   return RET_OK;
 }
 
+int BenchmarkUnifiedApi::MarkThroughput(const std::shared_ptr<mindspore::Context> &context) {
+  MS_LOG(INFO) << "Running throughput mode...";
+  std::cout << "Running throughput mode..." << std::endl;
+  auto runner_config = std::make_shared<RunnerConfig>();
+  runner_config->workers_num = flags_->parallel_workers_;
+  runner_config->context = context;
+  runner_config->max_batch_size = flags_->max_batch_size_;
+  runner_config->batch_timeout_us = flags_->batch_timeout_us_;
+  ModelParallelRunner runner;
+  auto ret = runner.Init(flags_->model_file_, runner_config);
+  if (ret != kSuccess) {
+    MS_LOG(ERROR) << "ModelParallelRunner init failed.";
+    std::cerr << "ModelParallelRunner init failed." << std::endl;
+    return RET_ERROR;
+  }
+
+  std::vector<MSTensor> outputs;
+  for (int i = 0; i < flags_->warm_up_loop_count_; i++) {
+    if (runner.Predict(ms_inputs_for_api_, &outputs) != kSuccess) {
+      MS_LOG(ERROR) << "Inference error ";
+      std::cerr << "Inference error " << std::endl;
+      return RET_ERROR;
+    }
+  }
+  (void)runner.GetStat(true);
+
+  // every client sends loopCount requests back to back
+  int clients = flags_->parallel_clients_ > 0 ? flags_->parallel_clients_ : 2 * flags_->parallel_workers_;
+  std::atomic<int> failed_num{0};
+  std::vector<std::thread> client_threads;
+  auto start = GetTimeUs();
+  for (int i = 0; i < clients; i++) {
+    client_threads.emplace_back([this, &runner, &failed_num]() {
+      std::vector<MSTensor> client_outputs;
+      for (int j = 0; j < flags_->loop_count_; j++) {
+        if (runner.Predict(ms_inputs_for_api_, &client_outputs) != kSuccess) {
+          failed_num++;
+        }
+      }
+    });
+  }
+  for (auto &thread : client_threads) {
+    thread.join();
+  }
+  auto elapsed = GetTimeUs() - start;
+  if (failed_num > 0) {
+    MS_LOG(ERROR) << failed_num << " requests failed.";
+    std::cerr << failed_num << " requests failed." << std::endl;
+    return RET_ERROR;
+  }
+
+  auto stat = runner.GetStat(false);
+  float qps = elapsed == 0 ? 0 : stat.request_num * kFloatMSEC * kFloatMSEC / elapsed;
+  float avg_batch = stat.batch_num == 0 ? 0 : static_cast<float>(stat.request_num) / stat.batch_num;
+  MS_LOG(INFO) << "Model = " << flags_->model_file_.substr(flags_->model_file_.find_last_of(DELIM_SLASH) + 1).c_str()
+               << ", Workers = " << flags_->parallel_workers_ << ", Clients = " << clients << ", QPS = " << qps
+               << ", AvgBatch = " << avg_batch << ", AvgLatency = " << stat.avg_ms << ", P50 = " << stat.p50_ms
+               << ", P90 = " << stat.p90_ms << ", P99 = " << stat.p99_ms << ", Max = " << stat.max_ms;
+  printf(
+    "Model = %s, Workers = %d, Clients = %d, QPS = %f, AvgBatch = %f, AvgLatency = %f ms, P50 = %f ms, P90 = %f ms, "
+    "P99 = %f ms, MaxLatency = %f ms\n",
+    flags_->model_file_.substr(flags_->model_file_.find_last_of(DELIM_SLASH) + 1).c_str(), flags_->parallel_workers_,
+    clients, qps, avg_batch, stat.avg_ms, stat.p50_ms, stat.p90_ms, stat.p99_ms, stat.max_ms);
+  return RET_OK;
+}
+
 int BenchmarkUnifiedApi::MarkAccuracy() {
   MS_LOG(INFO) << "MarkAccuracy";
   std::cout << "MarkAccuracy" << std::endl;
@@ -527,6 +597,8 @@ int BenchmarkUnifiedApi::RunBenchmark() {
   auto end_prepare_time = GetTimeUs();
   MS_LOG(INFO) << "PrepareTime = " << ((end_prepare_time - start_prepare_time) / kFloatMSEC) << " ms";
   std::cout << "PrepareTime = " << ((end_prepare_time - start_prepare_time) / kFloatMSEC) << " ms" << std::endl;
+  PrintMemoryUsage();
+  PrintCpuIsa();
 
   // Load input
   MS_LOG(INFO) << "start generate input data";
@@ -549,6 +621,13 @@ int BenchmarkUnifiedApi::RunBenchmark() {
       std::cout << "Run MarkAccuracy error: " << status << std::endl;
       return status;
     }
+  } else if (flags_->parallel_workers_ > 0) {
+    status = MarkThroughput(context);
+    if (status != 0) {
+      MS_LOG(ERROR) << "Run MarkThroughput error: " << status;
+      std::cout << "Run MarkThroughput error: " << status << std::endl;
+      return status;
+    }
   } else {
     status = MarkPerformance();
     if (status != 0) {
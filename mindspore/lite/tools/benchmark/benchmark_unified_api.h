@@ -37,6 +37,7 @@
 #include "src/common/utils.h"
 #include "include/api/types.h"
 #include "include/api/model.h"
+#include "include/api/model_parallel_runner.h"
 
 namespace mindspore::lite {
 class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
@@ -87,6 +88,8 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
 
   int MarkAccuracy();
 
+  int MarkThroughput(const std::shared_ptr<mindspore::Context> &context);
+
   int CompareOutputByCosineDistance(float cosine_distance_threshold);
 
   int CompareDataGetTotalCosineDistanceAndSize(const std::string &name, mindspore::MSTensor *tensor,
@@ -1621,6 +1621,7 @@ class Cell(Cell_):
             - If a parameter P has been used by two operators in different stages "stageA" and "stageB",
               the parameter P should use P.add_pipeline_stage(stageA) and P.add_pipeline_stage(stageB)
               to add it's stage information before using infer_param_pipeline_stage.
+            - With pipeline_interleave_num, the stage s of the cells belongs to the stage s % pipeline_stages.
 
         Returns:
             The params belong to current stage in pipeline parallel.
@@ -1642,7 +1643,7 @@ class Cell(Cell_):
                                    " has been set pipeline_stage. "
                                    "Otherwise, the parameter should use add_pipeline_stage "
                                    "to add its stage information".format(param.name))
-            if current_stage in param._pipeline_stage_list:
+            if current_stage in [stage % stage_num for stage in param._pipeline_stage_list]:
                 params.append(param)
         return params
 
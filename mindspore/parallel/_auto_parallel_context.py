@@ -125,6 +125,46 @@ class _AutoParallelContext:
         self.check_context_handle()
         return self._context_handle.get_pipeline_stage_split_num()
 
+    def set_pipeline_interleave_num(self, interleave_num):
+        """Set the number of the chunks of each pipeline stage"""
+        if isinstance(interleave_num, bool) or not isinstance(interleave_num, int):
+            raise TypeError("The type of pipeline_interleave_num must be int, but got the type : {}."
+                            .format(type(interleave_num)))
+        if interleave_num < 1:
+            raise ValueError("The parameter pipeline_interleave_num be greater or equal 1, "
+                             "but got the value of interleave_num : {}.".format(interleave_num))
+        self.check_context_handle()
+        self._context_handle.set_pipeline_interleave_num(interleave_num)
+
+    def get_pipeline_interleave_num(self):
+        """Get the number of the chunks of each pipeline stage"""
+        self.check_context_handle()
+        return self._context_handle.get_pipeline_interleave_num()
+
+    def set_pipeline_micro_batch_order(self, micro_batch_order):
+        """
+        Set the order of the micro batches on the chunks of the pipeline stages.
+
+        Args:
+            micro_batch_order (str): The micro batch order, "depth_first" or "breadth_first".
+
+        Raises:
+            ValueError: If the micro batch order is not supported.
+        """
+        if not isinstance(micro_batch_order, str):
+            raise TypeError("The type of parameter 'pipeline_micro_batch_order' must be str, "
+                            "but got the type : {}.".format(type(micro_batch_order)))
+        self.check_context_handle()
+        ret = self._context_handle.set_pipeline_micro_batch_order(micro_batch_order)
+        if ret is False:
+            raise ValueError("The parameter 'pipeline_micro_batch_order' only support 'depth_first' and "
+                             "'breadth_first', but got the value : {}.".format(micro_batch_order))
+
+    def get_pipeline_micro_batch_order(self):
+        """Get the order of the micro batches on the chunks of the pipeline stages."""
+        self.check_context_handle()
+        return self._context_handle.get_pipeline_micro_batch_order()
+
     def set_gradients_mean(self, gradients_mean):
         """
         Set gradients_mean flag.
@@ -675,6 +715,8 @@ _set_auto_parallel_context_func_map = {
     "gradient_fp32_sync": auto_parallel_context().set_gradient_fp32_sync,
     "loss_repeated_mean": auto_parallel_context().set_loss_repeated_mean,
     "pipeline_stages": auto_parallel_context().set_pipeline_stages,
+    "pipeline_interleave_num": auto_parallel_context().set_pipeline_interleave_num,
+    "pipeline_micro_batch_order": auto_parallel_context().set_pipeline_micro_batch_order,
     "parallel_mode": auto_parallel_context().set_parallel_mode,
     "search_mode": auto_parallel_context().set_strategy_search_mode,
     "parameter_broadcast": auto_parallel_context().set_parameter_broadcast,
@@ -700,6 +742,8 @@ _get_auto_parallel_context_func_map = {
     "gradient_fp32_sync": auto_parallel_context().get_gradient_fp32_sync,
     "loss_repeated_mean": auto_parallel_context().get_loss_repeated_mean,
     "pipeline_stages": auto_parallel_context().get_pipeline_stages,
+    "pipeline_interleave_num": auto_parallel_context().get_pipeline_interleave_num,
+    "pipeline_micro_batch_order": auto_parallel_context().get_pipeline_micro_batch_order,
     "parallel_mode": auto_parallel_context().get_parallel_mode,
     "search_mode": auto_parallel_context().get_strategy_search_mode,
     "parameter_broadcast": auto_parallel_context().get_parameter_broadcast,
@@ -722,7 +766,8 @@ _get_auto_parallel_context_func_map = {
                  strategy_ckpt_save_file=str, full_batch=bool, enable_parallel_optimizer=bool,
                  grad_accumulation_step=int, all_reduce_fusion_config=list, group_ckpt_save_file=str,
                  communi_parallel_mode=str, optimizer_weight_shard_size=int,
-                 optimizer_weight_shard_aggregated_save=bool, enable_alltoall=bool)
+                 optimizer_weight_shard_aggregated_save=bool, enable_alltoall=bool, pipeline_interleave_num=int,
+                 pipeline_micro_batch_order=str)
 
 def _set_auto_parallel_context(**kwargs):
     """
@@ -774,6 +819,17 @@ def _set_auto_parallel_context(**kwargs):
                         the devices are distributed alone the pipeline. The total devices will be divided into
                         'pipeline_stags' stages. This currently could only be used when
                         parallel mode semi_auto_parallel is enabled. Default: 0
+        pipeline_interleave_num (int): Set the number of the chunks of each pipeline stage. The cells are given
+                        pipeline_stages * pipeline_interleave_num stages, and the stage s of them runs on the devices
+                        of the stage s % pipeline_stages, which shrinks the pipeline bubbles with the interleaved
+                        1F1B schedule. Default: 1
+        pipeline_micro_batch_order (str): The order of the micro batches on the chunks of the pipeline stages,
+                     "depth_first" or "breadth_first". Default: "depth_first".
+
+                     - depth_first: A group of pipeline_stages micro batches goes through the chunks one after
+                       another, which keeps fewer activations.
+
+                     - breadth_first: All the micro batches go through a chunk before the next chunk.
         communi_parallel_mode (str): There are tree kinds of communication parallel modes, "all_group_parallel",
                      "same_server_group_parallel" and "no_group_parallel". Default: "all_group_parallel".
 
@@ -838,6 +894,8 @@ def _reset_auto_parallel_context():
     - enable_parallel_optimizer: False
     - search_mode: dynamic_programming
     - pipeline_stages: 0
+    - pipeline_interleave_num: 1
+    - pipeline_micro_batch_order: "depth_first"
     - gradient_accumulation_shard: True
     """
     auto_parallel_context().reset()
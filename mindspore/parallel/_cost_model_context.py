@@ -570,6 +570,8 @@ def set_cost_model_context(**kwargs):
             0: bypass allreduce fusion;
             1: only use backward computation time to group allreduce;
             2: use backward computation time and parameter gradient allreduce time to group allreduce.
+            3: plan the AllReduce buckets in the backend by the ready time of the gradients and the time of
+            AllReduce, which are estimated by the cost model.
         costmodel_allreduce_fusion_times (int): The AllReduce fusion times of parameter gradients.
         costmodel_allreduce_fusion_tail_percent (float): A parameter used in allreduce fusion algorithm. The percentage
             of backward computing time corresponding to the last parameter gradients AllReduce in the whole backward
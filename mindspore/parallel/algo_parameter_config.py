@@ -175,6 +175,91 @@ class _AlgoParameterConfig:
         self.check_config_handle()
         return self._config_handle.get_dp_algo_approxi_epsilon()
 
+    def set_dp_algo_search_threads(self, threads):
+        """
+        Set the maximum number of threads searching strategies in the DP algorithm.
+        Default: 0.
+
+        Args:
+            threads (int): The maximum number of threads, 0 for the size of the common thread pool. A larger value is
+                capped by the size of the common thread pool.
+        """
+        self.check_config_handle()
+        self._config_handle.set_dp_algo_search_threads(threads)
+
+    def get_dp_algo_search_threads(self):
+        """
+        Get the maximum number of threads searching strategies in the DP algorithm.
+
+        Returns:
+            The maximum number of threads.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_search_threads()
+
+    def set_dp_algo_cost_cache_path(self, path):
+        """
+        Set the file caching the redistribution costs of the DP algorithm across compilations.
+        Default: "".
+
+        Args:
+            path (str): The path of the file, "" for no file.
+        """
+        self.check_config_handle()
+        self._config_handle.set_dp_algo_cost_cache_path(path)
+
+    def get_dp_algo_cost_cache_path(self):
+        """
+        Get the file caching the redistribution costs of the DP algorithm across compilations.
+
+        Returns:
+            The path of the file.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_cost_cache_path()
+
+    def set_dp_algo_strategy_db_path(self, path):
+        """
+        Set the file of the strategy database shared by the DP algorithm across jobs.
+        Default: "".
+
+        Args:
+            path (str): The path of the file, "" for no database.
+        """
+        self.check_config_handle()
+        self._config_handle.set_dp_algo_strategy_db_path(path)
+
+    def get_dp_algo_strategy_db_path(self):
+        """
+        Get the file of the strategy database shared by the DP algorithm across jobs.
+
+        Returns:
+            The path of the file.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_strategy_db_path()
+
+    def set_dp_algo_redistribution_search(self, search):
+        """
+        Set the flag of searching the redistribution operators of the least communication cost.
+        Default: False.
+
+        Args:
+            search (bool): The flag of searching the redistribution operators.
+        """
+        self.check_config_handle()
+        self._config_handle.set_dp_algo_redistribution_search(search)
+
+    def get_dp_algo_redistribution_search(self):
+        """
+        Get the flag of searching the redistribution operators of the least communication cost.
+
+        Returns:
+            The flag of searching the redistribution operators.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_redistribution_search()
+
     def reset_algo_parameters(self):
         """
         Reset algorithm parameter attributes.
@@ -205,7 +290,11 @@ set_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().set_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().set_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().set_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon,
+    "search_threads": _algo_parameter_config().set_dp_algo_search_threads,
+    "cost_cache_path": _algo_parameter_config().set_dp_algo_cost_cache_path,
+    "strategy_db_path": _algo_parameter_config().set_dp_algo_strategy_db_path,
+    "redistribution_search": _algo_parameter_config().set_dp_algo_redistribution_search}
 
 
 get_algo_parameters_config_func_map = {
@@ -214,12 +303,17 @@ get_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().get_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().get_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().get_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon,
+    "search_threads": _algo_parameter_config().get_dp_algo_search_threads,
+    "cost_cache_path": _algo_parameter_config().get_dp_algo_cost_cache_path,
+    "strategy_db_path": _algo_parameter_config().get_dp_algo_strategy_db_path,
+    "redistribution_search": _algo_parameter_config().get_dp_algo_redistribution_search}
 
 
 @args_type_check(tensor_slice_align_enable=bool, tensor_slice_align_size=int,
                  fully_use_devices=bool, elementwise_op_strategy_follow=bool,
-                 enable_algo_approxi=bool, algo_approxi_epsilon=float)
+                 enable_algo_approxi=bool, algo_approxi_epsilon=float, search_threads=int, cost_cache_path=str,
+                 strategy_db_path=str, redistribution_search=bool)
 def set_algo_parameters(**kwargs):
     """
     Set parameters in the algorithm for parallel strategy searching. See a typical use in
@@ -249,6 +343,24 @@ def set_algo_parameters(**kwargs):
         tensor_slice_align_size (int): The minimum tensor slice shape of MatMul, the value must be in [1, 1024].
             Default: 16. If 'tensor_slice_align_enable' is set true, then the slice size of last dimension of MatMul
             tensors should be multiple of this value.
+        search_threads (int): The maximum number of threads enumerating the strategies and the costs of the operators
+            and the edges, and eliminating the cost graph. Default: 0, which uses the size of the common thread pool.
+            A larger value is capped by the size of the common thread pool. The searched strategies do not depend on
+            this value.
+        cost_cache_path (str): The file caching the tensor redistribution costs of the algorithm. Default: "", which
+            disables the file. If set, the costs are loaded from the file before the search and saved to it after the
+            search, so that recompiling the same or a similar network skips recomputing them.
+        strategy_db_path (str): The file of the strategy database of the algorithm. Default: "", which disables the
+            database. If set, the strategies searched for the operators are saved to it by the signatures of the
+            operators, which are made of the operator, the operators producing its inputs, the input shapes and the
+            number of devices. Before enumerating the strategies of an operator, a strategy of the same signature is
+            reused, or one which only differs in the batch size if it is valid, so that the jobs of the same network
+            or of networks of other depths or batch sizes skip most of the search.
+        redistribution_search (bool): Whether to search the tensor redistribution operators of the least
+            communication cost. Default: False, which uses the operators found by construction. If set, the equivalent
+            operator lists of a redistribution, such as permuting by AlltoAll or by AllGather and Split, are scored by
+            the cost model and the cheapest one is inserted, and the AllGathers of the redistributions of the inputs
+            of an operator are fused into one.
 
     Raises:
         ValueError: If context keyword is not recognized.
@@ -270,7 +382,8 @@ def get_algo_parameters(attr_key):
     Args:
         attr_key (str): The key of the attribute. The keys include: "fully_use_devices",
             "elementwise_op_strategy_follow", "enable_algo_approxi", "algo_approxi_epsilon",
-            "tensor_slice_align_enable","tensor_slice_align_size".
+            "tensor_slice_align_enable", "tensor_slice_align_size", "search_threads", "cost_cache_path",
+            "strategy_db_path", "redistribution_search".
 
     Returns:
         Return attribute value according to the key.
@@ -297,5 +410,9 @@ def reset_algo_parameters():
     --algo_approxi_epsilon: 0.1.
     --tensor_slice_align_enable: False.
     --tensor_slice_align_size: 16.
+    --search_threads: 0.
+    --cost_cache_path: "".
+    --strategy_db_path: "".
+    --redistribution_search: False.
     """
     _algo_parameter_config().reset_algo_parameters()
@@ -94,6 +94,8 @@ class CheckpointConfig:
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        native_format (bool): Whether to save the checkpoint in the native format, see `save_checkpoint`.
+                              Default: False.
 
     Raises:
         ValueError: If input parameter is not the correct type.
@@ -144,7 +146,8 @@ class CheckpointConfig:
                  saved_network=None,
                  append_info=None,
                  enc_key=None,
-                 enc_mode='AES-GCM'):
+                 enc_mode='AES-GCM',
+                 native_format=False):
 
         if save_checkpoint_steps is not None:
             save_checkpoint_steps = Validator.check_non_negative_int(save_checkpoint_steps)
@@ -183,6 +186,7 @@ class CheckpointConfig:
         self._append_dict = self._handle_append_info(append_info)
         self._enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
         self._enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+        self._native_format = Validator.check_bool(native_format)
 
     @property
     def save_checkpoint_steps(self):
@@ -229,6 +233,11 @@ class CheckpointConfig:
         """Get the value of _enc_mode"""
         return self._enc_mode
 
+    @property
+    def native_format(self):
+        """Get the value of _native_format"""
+        return self._native_format
+
     @property
     def append_dict(self):
         """Get the value of append_dict."""
@@ -434,7 +443,8 @@ class ModelCheckpoint(Callback):
                 self._append_dict["step_num"] = self._append_step_num + cb_params.cur_step_num
             network = self._config.saved_network if self._config.saved_network is not None else cb_params.train_network
             save_checkpoint(network, cur_file, self._config.integrated_save, self._config.async_save,
-                            self._append_dict, self._config.enc_key, self._config.enc_mode)
+                            self._append_dict, self._config.enc_key, self._config.enc_mode,
+                            self._config.native_format)
 
             self._latest_ckpt_file_name = cur_file
 
@@ -52,6 +52,8 @@ from mindspore.parallel._tensor import _reshape_param_data
 from mindspore.parallel._tensor import _reshape_param_data_with_weight
 from mindspore.parallel._utils import _infer_rank_list, _remove_repeated_slices
 from .._c_expression import load_mindir, _encrypt, _decrypt, _is_cipher_file
+if sys.platform != "win32":
+    from .._c_expression import CheckpointWriter_, CheckpointReader_, _is_native_checkpoint
 
 tensor_to_ms_type = {"Int8": mstype.int8, "UInt8": mstype.uint8, "Int16": mstype.int16, "UInt16": mstype.uint16,
                      "Int32": mstype.int32, "UInt32": mstype.uint32, "Int64": mstype.int64, "UInt64": mstype.uint64,
@@ -207,8 +209,17 @@ def _exec_save(ckpt_file_name, data_list, enc_key=None, enc_mode="AES-GCM"):
         raise e
 
 
+def _exec_save_native(ckpt_file_name, writer):
+    """Execute the process of saving checkpoint into a native checkpoint file."""
+    with _ckpt_mutex:
+        if not writer.save(False):
+            logger.critical("Failed to save the checkpoint file %s. May don't have the permission to write files, "
+                            "or the disk space is insufficient and so on.", ckpt_file_name)
+            raise RuntimeError("Failed to save the checkpoint file {}.".format(ckpt_file_name))
+
+
 def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
-                    async_save=False, append_dict=None, enc_key=None, enc_mode="AES-GCM"):
+                    async_save=False, append_dict=None, enc_key=None, enc_mode="AES-GCM", native_format=False):
     """
     Save checkpoint to a specified file.
 
@@ -226,16 +237,23 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        native_format (bool): Whether to save the checkpoint in the native format, which is written from the
+                              tensor memory by several threads and loaded lazily through mmap. The file is
+                              still loaded by `load_checkpoint`, so a checkpoint is converted between the formats
+                              by loading it and saving it again. It can not be encrypted and is not supported on
+                              Windows. Default: False.
 
     Raises:
         TypeError: If the parameter save_obj is not `nn.Cell` or list type. And if the parameter
-                   `integrated_save` and `async_save` are not bool type.
+                   `integrated_save`, `async_save` and `native_format` are not bool type.
+        ValueError: If `native_format` is True and `enc_key` is not None.
 
     Examples:
         >>> from mindspore import save_checkpoint
         >>>
         >>> net = Net()
         >>> save_checkpoint(net, "lenet.ckpt")
+        >>> save_checkpoint(net, "lenet_native.ckpt", native_format=True)
     """
 
     if not isinstance(save_obj, nn.Cell) and not isinstance(save_obj, list):
@@ -246,6 +264,12 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
     append_dict = _check_append_dict(append_dict)
     enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
     enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+    native_format = Validator.check_bool(native_format)
+    if native_format and enc_key is not None:
+        raise ValueError("For 'save_checkpoint', the native checkpoint can not be encrypted, 'enc_key' should be None "
+                         "when 'native_format' is True.")
+    if native_format and sys.platform == "win32":
+        raise ValueError("For 'save_checkpoint', the native checkpoint is not supported on Windows.")
 
     logger.info("Execute the process of saving checkpoint files.")
 
@@ -274,6 +298,22 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
             append_info_list.append({"name": k_name, "data": Tensor(value)})
             save_obj.extend(append_info_list)
 
+    if native_format:
+        ckpt_file_name = os.path.realpath(ckpt_file_name)
+        writer = CheckpointWriter_(ckpt_file_name)
+        with _ckpt_mutex:
+            for param in save_obj:
+                if isinstance(param["data"], Parameter):
+                    param["data"].init_data()
+                writer.add(param["name"], param["data"])
+        if async_save:
+            thr = Thread(target=_exec_save_native, args=(ckpt_file_name, writer), name="asyn_save_ckpt")
+            thr.start()
+        else:
+            _exec_save_native(ckpt_file_name, writer)
+        logger.info("Saving checkpoint process is finished.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -411,6 +451,10 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
         dec_mode (str): This parameter is valid only when dec_key is not set to None. Specifies the decryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
 
+    Note:
+        The checkpoint saved with `native_format` is detected automatically, a parameter of it is read from the file
+        the first time it is accessed in the returned dict.
+
     Returns:
         Dict, key is parameter name, value is a Parameter.
 
@@ -429,6 +473,15 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     dec_key = Validator.check_isinstance('dec_key', dec_key, (type(None), bytes))
     dec_mode = Validator.check_isinstance('dec_mode', dec_mode, str)
     logger.info("Execute the process of loading checkpoint files.")
+    if sys.platform != "win32" and _is_native_checkpoint(ckpt_file_name):
+        if dec_key is not None:
+            raise ValueError("For 'load_checkpoint', the checkpoint file {} is a native checkpoint which is not "
+                             "encrypted, 'dec_key' should be None.".format(ckpt_file_name))
+        parameter_dict = _load_native_checkpoint(ckpt_file_name, filter_prefix)
+        if net is not None:
+            load_param_into_net(net, parameter_dict, strict_load)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -498,6 +551,95 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     return parameter_dict
 
 
+class _NativeParameterDict(dict):
+    """
+    The parameters of a native checkpoint. Only the names are known when the file is opened, a parameter is read from
+    the mapped file the first time it is accessed, so the parameters which are never used are never in memory.
+    """
+
+    def __init__(self, ckpt_file_name, reader, names):
+        super(_NativeParameterDict, self).__init__((name, None) for name in names)
+        self._ckpt_file_name = ckpt_file_name
+        self._reader = reader
+        self._unread = set(names)
+
+    def __getitem__(self, key):
+        if key in self._unread:
+            try:
+                value = Parameter(Tensor(self._reader.read(key)), name=key)
+            except BaseException as e:
+                logger.critical("Failed to load the checkpoint file '%s'.", self._ckpt_file_name)
+                raise ValueError(e.__str__() + "\nFailed to load the checkpoint file {}.".format(self._ckpt_file_name))
+            super(_NativeParameterDict, self).__setitem__(key, value)
+            self._unread.discard(key)
+        return super(_NativeParameterDict, self).__getitem__(key)
+
+    def __setitem__(self, key, value):
+        self._unread.discard(key)
+        super(_NativeParameterDict, self).__setitem__(key, value)
+
+    def __delitem__(self, key):
+        self._unread.discard(key)
+        super(_NativeParameterDict, self).__delitem__(key)
+
+    def __iter__(self):
+        # Overriding __iter__ makes dict(), ** and update() go through keys() and __getitem__ instead of copying the
+        # unread entries.
+        return super(_NativeParameterDict, self).__iter__()
+
+    def get(self, key, default=None):
+        return self[key] if key in self else default
+
+    def items(self):
+        return [(key, self[key]) for key in self]
+
+    def values(self):
+        return [self[key] for key in self]
+
+    def pop(self, key, *default):
+        if key not in self:
+            return super(_NativeParameterDict, self).pop(key, *default)
+        value = self[key]
+        del self[key]
+        return value
+
+    def popitem(self):
+        key = next(reversed(list(self.keys())))
+        return key, self.pop(key)
+
+    def setdefault(self, key, default=None):
+        if key not in self:
+            self[key] = default
+        return self[key]
+
+    def update(self, *args, **kwargs):
+        for key, value in dict(*args, **kwargs).items():
+            self[key] = value
+
+    def copy(self):
+        return dict(self.items())
+
+    def __reduce_ex__(self, protocol):
+        return dict, (self.items(),)
+
+
+def _load_native_checkpoint(ckpt_file_name, filter_prefix=None):
+    """Open a native checkpoint file, the parameters which are not filtered out are read when they are accessed."""
+    reader = CheckpointReader_(ckpt_file_name)
+    if not reader.open():
+        logger.critical("Failed to read the checkpoint file '%s', may not have permission to read it, please "
+                        "check the correct of the file.", ckpt_file_name)
+        raise ValueError("Failed to read the checkpoint file {}, may not have permission to read it.".format(
+            ckpt_file_name))
+    names = [name for name in reader.get_names()
+             if filter_prefix is None or not _check_param_prefix(filter_prefix, name)]
+    if not names:
+        raise ValueError(f"The loaded parameter dict is empty after filtering, please check whether "
+                         f"'filter_prefix' was set to filter out all parameters.")
+    logger.info("Loading checkpoint files process is finished.")
+    return _NativeParameterDict(ckpt_file_name, reader, names)
+
+
 def _check_checkpoint_param(ckpt_file_name, filter_prefix=None):
     """Check function load_checkpoint's parameter."""
     if not isinstance(ckpt_file_name, str):
@@ -755,6 +897,9 @@ def export(net, *inputs, file_name, file_format='AIR', **kwargs):
             - enc_mode (str): Specifies the encryption mode, to take effect when enc_key is set.
               Option: 'AES-GCM' | 'AES-CBC'. Default: 'AES-GCM'.
             - dataset (Dataset): Specifies the preprocess methods of network.
+            - external_data (bool): Whether to save the parameters of the MINDIR in external files next to the
+              graph file, which is done anyway when they exceed 1GB. The parameters in the external files are mapped
+              in memory instead of being copied when the MINDIR is loaded. Default: False.
 
     Examples:
         >>> import numpy as np
@@ -779,7 +924,9 @@ def export(net, *inputs, file_name, file_format='AIR', **kwargs):
         if 'enc_mode' in kwargs.keys():
             enc_mode = Validator.check_isinstance('enc_mode', kwargs['enc_mode'], str)
         dataset = kwargs['dataset'] if 'dataset' in kwargs.keys() else None
-        _export(net, file_name, file_format, *inputs, enc_key=enc_key, enc_mode=enc_mode, dataset=dataset)
+        external_data = kwargs['external_data'] if 'external_data' in kwargs.keys() else False
+        _export(net, file_name, file_format, *inputs, enc_key=enc_key, enc_mode=enc_mode, dataset=dataset,
+                external_data=external_data)
     else:
         _export(net, file_name, file_format, *inputs, **kwargs)
 
@@ -864,7 +1011,6 @@ def _spilt_save(net_dict, model, file_name, is_encrypt, **kwargs):
     '''
         The function to save parameter data
     '''
-    logger.warning("Parameters in the net capacity exceeds 1G, save MindIR model and parameters separately.")
     # save parameter
     file_prefix = file_name.split("/")[-1]
     if file_prefix.endswith(".mindir"):
@@ -958,7 +1104,10 @@ def _save_mindir(net, file_name, *inputs, **kwargs):
         dataset = kwargs['dataset']
         model.preprocessor = json.dumps(dataset.to_json(), indent=2)
 
-    save_together = _save_together(net_dict, model)
+    external_data = Validator.check_bool(kwargs.get('external_data', False))
+    save_together = not external_data and _save_together(net_dict, model)
+    if not external_data and not save_together:
+        logger.warning("Parameters in the net capacity exceeds 1G, save MindIR model and parameters separately.")
     is_encrypt = lambda: 'enc_key' in kwargs.keys() and 'enc_mode' in kwargs.keys()
     if save_together:
         _save_mindir_together(net_dict, model, file_name, is_encrypt, **kwargs)
@@ -13,9 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <string>
+#include <thread>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_ring.h"
+#include "minddata/dataset/engine/cache/storage_manager.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
@@ -312,3 +316,157 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestImageFolderCacheMerge) {
   rc = myClient->DestroyCache();
   ASSERT_TRUE(rc.IsOk());
 }
+
+/// Feature: CacheRingChannel
+/// Description: One thread pushes requests through the request ring, another echoes them back through the reply
+///     ring, for both small and large rows. Then the client releases the channel
+/// Expectation: The server side sees the heartbeat of the client. Every message comes back once, in order, with the
+///     same content. A released channel is seen as closed and released by the server.
+TEST_F(MindDataTestCacheOp, TestRingChannelEcho) {
+  std::vector<char> mem(CacheRingChannel::MemoryNeeded() + 64);
+  void *base = reinterpret_cast<void *>((reinterpret_cast<uintptr_t>(mem.data()) + 63) & ~uintptr_t(63));
+  CacheRingChannel::Format(base);
+  {
+    // The heartbeat bumped by the client is what the server sees.
+    CacheRingChannel client(base);
+    CacheRingChannel server(base);
+    EXPECT_EQ(server.Heartbeat(), 0);
+    client.Beat();
+    EXPECT_EQ(server.Heartbeat(), 1);
+  }
+  for (size_t row_sz : {64, 32 * 1024}) {
+    // Enough rows to wrap around the ring many times.
+    const int64_t num_rows = kRingNumSlots * 16;
+    CacheRingChannel client(base);
+    CacheRingChannel server(base);
+    std::thread echo([&server, num_rows]() {
+      int64_t cnt = 0;
+      RingBackoff backoff;
+      auto f = [&server](int64_t tag, const void *data, size_t sz) -> Status {
+        CacheRequest rq;
+        CHECK_FAIL_RETURN_UNEXPECTED(rq.ParseFromArray(data, static_cast<int>(sz)), "Parse error");
+        CacheReply reply;
+        reply.set_result(rq.buf_data(0));
+        return server.Send(server.ReplyRing(), tag, reply, false);
+      };
+      // The client closes the channel if it gives up early, so we never wait for requests which won't come.
+      while (cnt < num_rows && !server.IsClosed()) {
+        int32_t n = 0;
+        Status rc = server.RequestRing()->Poll(f, &n);
+        if (rc.IsError()) {
+          MS_LOG(ERROR) << rc.ToString();
+          server.Close();
+          break;
+        }
+        if (n > 0) {
+          server.ReplyRing()->Flush();
+          cnt += n;
+          backoff.Reset();
+        } else {
+          backoff.Pause();
+        }
+      }
+    });
+    int64_t expected = 0;
+    auto check = [&expected, row_sz](int64_t tag, const void *data, size_t sz) -> Status {
+      CacheReply reply;
+      CHECK_FAIL_RETURN_UNEXPECTED(reply.ParseFromArray(data, static_cast<int>(sz)), "Parse error");
+      CHECK_FAIL_RETURN_UNEXPECTED(tag == expected, "Out of order");
+      CHECK_FAIL_RETURN_UNEXPECTED(reply.result().size() == row_sz, "Wrong size");
+      CHECK_FAIL_RETURN_UNEXPECTED(reply.result()[0] == static_cast<char>(tag & 0x7f), "Wrong content");
+      ++expected;
+      return Status::OK();
+    };
+    // Nothing is asserted until the echo thread is joined, a failed assertion would leave it running.
+    auto poll_reply = [&client, &check]() -> Status {
+      CHECK_FAIL_RETURN_UNEXPECTED(!client.IsClosed(), "The echo thread failed");
+      int32_t n = 0;
+      RETURN_IF_NOT_OK(client.ReplyRing()->Poll(check, &n));
+      return Status::OK();
+    };
+    CacheRequest rq;
+    rq.add_buf_data(std::string(row_sz, 0));
+    Status rc;
+    for (int64_t i = 0; i < num_rows && rc.IsOk(); ++i) {
+      (*rq.mutable_buf_data(0))[0] = static_cast<char>(i & 0x7f);
+      // Single threaded client, so keep draining the replies while waiting for a free request slot.
+      RingBackoff backoff;
+      while (rc.IsOk() && client.RequestRing()->Full()) {
+        rc = poll_reply();
+        backoff.Pause();
+      }
+      if (rc.IsOk()) {
+        rc = client.Send(client.RequestRing(), i, rq);
+      }
+      if (rc.IsOk()) {
+        rc = poll_reply();
+      }
+    }
+    RingBackoff backoff;
+    while (rc.IsOk() && expected < num_rows) {
+      auto before = expected;
+      rc = poll_reply();
+      if (expected == before) {
+        backoff.Pause();
+      }
+    }
+    if (rc.IsError()) {
+      client.Close();
+    }
+    echo.join();
+    ASSERT_OK(rc);
+    EXPECT_EQ(expected, num_rows);
+  }
+  CacheRingChannel client(base);
+  CacheRingChannel server(base);
+  EXPECT_FALSE(server.IsReleased());
+  client.Release();
+  EXPECT_TRUE(server.IsClosed());
+  EXPECT_TRUE(server.IsReleased());
+}
+
+/// Feature: StorageManager
+/// Description: Spill rows to disk, prefetch half of them twice, read all of them back, then read them again
+/// Expectation: The rows come back intact. A row is counted once as prefetched, and only the first read after its
+///     prefetch is a prefetch hit. Prefetching a missing key fails without being counted.
+TEST_F(MindDataTestCacheOp, TestStorageManagerPrefetch) {
+  Path spill("/tmp/test_storage_manager_prefetch");
+  ASSERT_OK(spill.CreateDirectories());
+  {
+    StorageManager sm(spill, 2);
+    ASSERT_OK(sm.ServiceStart());
+    const int kNumRows = 8;
+    std::vector<StorageManager::key_type> keys(kNumRows);
+    std::vector<std::string> rows;
+    for (int i = 0; i < kNumRows; ++i) {
+      rows.emplace_back(4096 + i, static_cast<char>('a' + i));
+      ASSERT_OK(sm.Write(&keys[i], {ReadableSlice(rows[i].data(), rows[i].size())}));
+    }
+    for (int i = 0; i < kNumRows / 2; ++i) {
+      ASSERT_OK(sm.Prefetch(keys[i]));
+      ASSERT_OK(sm.Prefetch(keys[i]));
+    }
+    EXPECT_EQ(sm.GetNumPrefetch(), kNumRows / 2);
+    EXPECT_EQ(sm.GetNumPrefetchHit(), 0);
+    for (int round = 0; round < 2; ++round) {
+      for (int i = 0; i < kNumRows; ++i) {
+        std::string out(rows[i].size(), 0);
+        WritableSlice dest(&out[0], out.size());
+        size_t bytes_read = 0;
+        ASSERT_OK(sm.Read(keys[i], &dest, &bytes_read));
+        EXPECT_EQ(bytes_read, rows[i].size());
+        EXPECT_EQ(out, rows[i]);
+      }
+      EXPECT_EQ(sm.GetNumPrefetchHit(), kNumRows / 2);
+    }
+    auto missing_key = *std::max_element(keys.begin(), keys.end()) + 1;
+    EXPECT_TRUE(sm.Prefetch(missing_key).IsError());
+    EXPECT_EQ(sm.GetNumPrefetch(), kNumRows / 2);
+    ASSERT_OK(sm.ServiceStop());
+  }
+  auto it = Path::DirIterator::OpenDirectory(&spill);
+  while (it->HasNext()) {
+    ASSERT_OK(it->Next().Remove());
+  }
+  ASSERT_OK(spill.Remove());
+}
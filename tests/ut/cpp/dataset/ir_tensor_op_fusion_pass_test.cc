@@ -16,10 +16,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common.h"
+#include "minddata/dataset/audio/kernels/biquad_cascade_op.h"
+#include "minddata/dataset/audio/kernels/biquad_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 #include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/audio.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 #include "minddata/dataset/include/dataset/transforms.h"
 #include "minddata/dataset/include/dataset/vision.h"
@@ -97,3 +101,64 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
   // EXPECT_EQ(++func_it, tfuncs.end());
 }
 
+TEST_F(MindDataTestTensorOpFusionPass, BiquadCascadeEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-BiquadCascadeEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops, the three consecutive biquads are fused, the last one is not
+  std::shared_ptr<TensorTransform> biquad_01(new audio::Biquad(1, 0.02, 0.13, 1, 0.12, 0.3));
+  std::shared_ptr<TensorTransform> biquad_02(new audio::Biquad(0.5, 0.1, 0.1, 1, 0.2, 0.1));
+  std::shared_ptr<TensorTransform> biquad_03(new audio::Biquad(0.3, 0.3, 0.3, 1, 0.1, 0.1));
+  std::shared_ptr<TensorTransform> type_cast(new transforms::TypeCast(mindspore::DataType::kNumberTypeFloat32));
+  std::shared_ptr<TensorTransform> biquad_04(new audio::Biquad(1, 0.02, 0.13, 1, 0.12, 0.3));
+  ds = ds->Map({type_cast, biquad_01, biquad_02, biquad_03, type_cast, biquad_04}, {"label"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 4);
+  EXPECT_EQ(tfuncs[1]->Name(), kBiquadCascadeOp);
+  EXPECT_EQ(tfuncs[3]->Name(), kBiquadOp);
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, BiquadCascadeCompute) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-BiquadCascadeCompute";
+  const dsize_t kWaveforms = 13;
+  const dsize_t kTime = 16000;
+  std::vector<float> waveform(kWaveforms * kTime);
+  for (size_t i = 0; i < waveform.size(); i++) {
+    waveform[i] = static_cast<float>((i * 7919) % 2001) / 1000.0f - 1.0f;
+  }
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(waveform, TensorShape({kWaveforms, kTime}), &input));
+
+  BiquadOp biquad_01(1, 0.02, 0.13, 1, 0.12, 0.3);
+  BiquadOp biquad_02(0.5, 0.1, 0.1, 1, 0.2, 0.1);
+  std::shared_ptr<Tensor> expect_01;
+  std::shared_ptr<Tensor> expect;
+  ASSERT_OK(biquad_01.Compute(input, &expect_01));
+  ASSERT_OK(biquad_02.Compute(expect_01, &expect));
+
+  BiquadCascadeOp cascade({biquad_01.ACoeffs(), biquad_02.ACoeffs()}, {biquad_01.BCoeffs(), biquad_02.BCoeffs()});
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(cascade.Compute(input, &output));
+
+  ASSERT_EQ(output->shape(), expect->shape());
+  auto expect_itr = expect->begin<float>();
+  for (auto itr = output->begin<float>(); itr != output->end<float>(); ++itr, ++expect_itr) {
+    EXPECT_FLOAT_EQ(*itr, *expect_itr);
+  }
+}
@@ -158,3 +158,45 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestJpegDctScale) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp test 3";
+  int h = 0;
+  int w = 0;
+  ASSERT_TRUE(GetJpegImageInfo(raw_input_tensor_, &w, &h).IsOk());
+  // a crop several times larger than the target lets the decoder downscale in the DCT domain
+  const int target_height = h / 8;
+  const int target_width = w / 8;
+  const int crop_y = h / 10;
+  const int crop_x = w / 10;
+  const int crop_height = h / 2;
+  const int crop_width = w / 2;
+
+  std::shared_ptr<Tensor> full_decoded, full_resized, scaled_decoded, scaled_resized;
+  ASSERT_TRUE(JpegCropAndDecode(raw_input_tensor_, &full_decoded, crop_x, crop_y, crop_width, crop_height).IsOk());
+  ASSERT_TRUE(JpegCropAndDecodeScaled(raw_input_tensor_, &scaled_decoded, crop_x, crop_y, crop_width, crop_height,
+                                      target_height, target_width)
+                .IsOk());
+
+  EXPECT_LT(scaled_decoded->shape()[0], full_decoded->shape()[0]);
+  EXPECT_GE(scaled_decoded->shape()[0], target_height);
+  EXPECT_GE(scaled_decoded->shape()[1], target_width);
+
+  ASSERT_TRUE(Resize(full_decoded, &full_resized, target_height, target_width).IsOk());
+  ASSERT_TRUE(Resize(scaled_decoded, &scaled_resized, target_height, target_width).IsOk());
+  cv::Mat output1 = CVTensor::AsCVTensor(full_resized)->mat();
+  cv::Mat output2 = CVTensor::AsCVTensor(scaled_resized)->mat();
+  double diff_sum = 0;
+  for (int i = 0; i < target_height; i++) {
+    for (int j = 0; j < target_width; j++) {
+      int a = output1.at<cv::Vec3b>(i, j)[1];
+      int b = output2.at<cv::Vec3b>(i, j)[1];
+      diff_sum += std::abs(a - b);
+    }
+  }
+  double mean_diff = diff_sum / (target_height * target_width);
+  MS_LOG(INFO) << "mean difference: " << mean_diff;
+  // the downscaled decode covers a slightly larger box and filters differently, but must show the same image
+  EXPECT_LT(mean_diff, 16.0);
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp test 3 finished";
+}
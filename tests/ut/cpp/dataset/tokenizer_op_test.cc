@@ -26,6 +26,7 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +359,80 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector({"my", "favor", "##ite", "book", "dur", "##ing", "我", "##最", "[UNK]"}, {}, true,
+                                    &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"my", "favorite", "during", "我最", "cholera"}, &input);
+  TensorRow output;
+  s = op->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output.size(), 3);
+  EXPECT_EQ(output[0]->Size(), 8);
+  CheckEqual(output[0], {0}, "my");
+  CheckEqual(output[0], {1}, "favor");
+  CheckEqual(output[0], {2}, "##ite");
+  CheckEqual(output[0], {3}, "dur");
+  CheckEqual(output[0], {4}, "##ing");
+  CheckEqual(output[0], {5}, "我");
+  CheckEqual(output[0], {6}, "##最");
+  CheckEqual(output[0], {7}, "[UNK]");
+  uint32_t offset = 0;
+  EXPECT_TRUE(output[1]->GetItemAt<uint32_t>(&offset, {6}).IsOk());
+  EXPECT_EQ(offset, 3);
+  EXPECT_TRUE(output[2]->GetItemAt<uint32_t>(&offset, {6}).IsOk());
+  EXPECT_EQ(offset, 6);
+
+  // the id path must agree with tokenizing to strings and looking them up
+  std::shared_ptr<Tensor> ids;
+  s = op->ComputeIds(input, &ids);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(ids->Size(), output[0]->Size());
+  for (dsize_t i = 0; i < ids->Size(); i++) {
+    std::string_view token;
+    int32_t id = 0;
+    EXPECT_TRUE(output[0]->GetItemAt(&token, {i}).IsOk());
+    EXPECT_TRUE(ids->GetItemAt<int32_t>(&id, {i}).IsOk());
+    EXPECT_EQ(id, vocab->Lookup(std::string(token)));
+  }
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizerIdsLongInput) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizerIdsLongInput.";
+  std::vector<std::string> words = {"my", "favor", "##ite", "book", "is", "love", "dur", "##ing", "the", "era", "[UNK]"};
+  std::shared_ptr<Vocab> vocab;
+  EXPECT_TRUE(Vocab::BuildFromVector(words, {}, true, &vocab).IsOk());
+  WordpieceTokenizerOp op(vocab);
+  std::vector<std::string> sentence;
+  std::vector<int32_t> expect_ids;
+  const int kSentenceWords = 4096;
+  for (int i = 0; i < kSentenceWords; i++) {
+    // "favorite" and "during" split into two tokens, "cholera" becomes a single unknown token
+    if (i % 3 == 0) {
+      sentence.emplace_back("favorite");
+      expect_ids.insert(expect_ids.end(), {vocab->Lookup("favor"), vocab->Lookup("##ite")});
+    } else if (i % 3 == 1) {
+      sentence.emplace_back("during");
+      expect_ids.insert(expect_ids.end(), {vocab->Lookup("dur"), vocab->Lookup("##ing")});
+    } else {
+      sentence.emplace_back("cholera");
+      expect_ids.push_back(vocab->Lookup("[UNK]"));
+    }
+  }
+  std::shared_ptr<Tensor> input;
+  EXPECT_TRUE(Tensor::CreateFromVector(sentence, &input).IsOk());
+  std::shared_ptr<Tensor> ids;
+  EXPECT_TRUE(op.ComputeIds(input, &ids).IsOk());
+  ASSERT_EQ(ids->Size(), static_cast<dsize_t>(expect_ids.size()));
+  for (dsize_t i = 0; i < ids->Size(); i++) {
+    int32_t id = 0;
+    EXPECT_TRUE(ids->GetItemAt<int32_t>(&id, {i}).IsOk());
+    EXPECT_EQ(id, expect_ids[i]);
+  }
+}
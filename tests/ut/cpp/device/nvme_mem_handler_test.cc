@@ -0,0 +1,106 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/memory_scheduler.h"
+#include "runtime/device/cpu/nvme_mem_handler.h"
+
+namespace mindspore::device::cpu {
+constexpr size_t kTensorSize = 64 * 1024;
+
+class TestNvmeMemHandler : public UT::Common {
+ public:
+  TestNvmeMemHandler() {}
+};
+
+/// Feature: NvmeMemHandler
+/// Description: swap out a memory to the file, then swap it in with and without prefetch.
+/// Expectation: the data swapped in is the one swapped out, and the statistics count the swaps.
+TEST_F(TestNvmeMemHandler, test_swap_out_and_in) {
+  NvmeMemHandler handler(".", 4 * kTensorSize);
+  ASSERT_EQ(handler.GetAvailableMemSize(), 4 * kTensorSize);
+  auto device_ptr = static_cast<uint8_t *>(handler.MallocDevice(kTensorSize));
+  ASSERT_NE(device_ptr, nullptr);
+  memset(device_ptr, 7, kTensorSize);
+  auto host_ptr = handler.MallocHost(kTensorSize);
+  handler.SwapOut(device_ptr, host_ptr, kTensorSize, nullptr);
+  handler.FreeDevice(device_ptr);
+
+  auto first_ptr = static_cast<uint8_t *>(handler.MallocDevice(kTensorSize));
+  handler.SwapIn(host_ptr, first_ptr, kTensorSize, nullptr);
+  ASSERT_EQ(std::vector<uint8_t>(first_ptr, first_ptr + kTensorSize), std::vector<uint8_t>(kTensorSize, 7));
+  handler.Prefetch(host_ptr, kTensorSize);
+  auto second_ptr = static_cast<uint8_t *>(handler.MallocDevice(kTensorSize));
+  handler.SwapIn(host_ptr, second_ptr, kTensorSize, nullptr);
+  ASSERT_EQ(std::vector<uint8_t>(second_ptr, second_ptr + kTensorSize), std::vector<uint8_t>(kTensorSize, 7));
+  handler.FreeHost(host_ptr);
+  handler.FreeDevice(first_ptr);
+  handler.FreeDevice(second_ptr);
+  // The memory of the swap out may be released only when its write is done.
+  auto whole_ptr = handler.MallocDevice(4 * kTensorSize);
+  ASSERT_NE(whole_ptr, nullptr);
+  handler.FreeDevice(whole_ptr);
+
+  auto statistics = handler.TakeStatistics();
+  ASSERT_EQ(statistics.swap_out_bytes, kTensorSize);
+  ASSERT_EQ(statistics.swap_in_bytes, 2 * kTensorSize);
+  ASSERT_EQ(statistics.swap_in_count, 2);
+  ASSERT_GE(statistics.prefetch_hit_count, 1);
+  ASSERT_EQ(handler.TakeStatistics().swap_in_count, 0);
+}
+
+/// Feature: NvmeMemHandler
+/// Description: the MemScheduler runs tensors which need twice the memory of the handler.
+/// Expectation: the tensors are swapped to the file and keep their data.
+TEST_F(TestNvmeMemHandler, test_mem_scheduler_with_nvme) {
+  constexpr size_t kTensorNum = 8;
+  constexpr size_t kStepNum = 2 * kTensorNum;
+  auto handler = std::make_shared<NvmeMemHandler>(".", kTensorNum / 2 * kTensorSize);
+  MemScheduler scheduler;
+  scheduler.SetMemHandler(handler);
+  scheduler.SetTotalStep(kStepNum);
+  std::vector<uint8_t> tensor_keys(kTensorNum, 0);
+  // Step i writes the tensor i, step kTensorNum + i reads it.
+  for (size_t step = 0; step < kStepNum; ++step) {
+    scheduler.GetOrMalloc(tensor_keys.data() + step % kTensorNum, kTensorSize);
+    scheduler.PostCompute(nullptr);
+  }
+  scheduler.set_need_record_event(false);
+  scheduler.Optimize();
+  ASSERT_TRUE(scheduler.optimized());
+  (void)handler->TakeStatistics();
+
+  scheduler.ResetCurrentStep();
+  for (size_t step = 0; step < kStepNum; ++step) {
+    ASSERT_TRUE(scheduler.PreCompute(nullptr));
+    auto index = step % kTensorNum;
+    auto addr = static_cast<uint8_t *>(scheduler.GetOrMalloc(tensor_keys.data() + index, kTensorSize));
+    ASSERT_NE(addr, nullptr);
+    if (step < kTensorNum) {
+      memset(addr, static_cast<int>(index + 1), kTensorSize);
+    } else {
+      ASSERT_EQ(std::vector<uint8_t>(addr, addr + kTensorSize), std::vector<uint8_t>(kTensorSize, index + 1));
+    }
+    ASSERT_TRUE(scheduler.PostCompute(nullptr));
+  }
+  auto statistics = handler->TakeStatistics();
+  ASSERT_GT(statistics.swap_out_bytes, 0);
+  ASSERT_EQ(statistics.swap_in_bytes, statistics.swap_out_bytes);
+}
+}  // namespace mindspore::device::cpu
@@ -0,0 +1,169 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "base/float16.h"
+#include "backend/kernel_compiler/akg/cpu/loop_fusion_program.h"
+
+namespace mindspore {
+namespace kernel {
+using graphkernel::inner::DAttrs;
+using graphkernel::inner::LiteGraph;
+using graphkernel::inner::NodeBase;
+
+class TestLoopFusionProgram : public UT::Common {
+ public:
+  TestLoopFusionProgram() {}
+
+  static std::vector<float> Range(size_t size, float scale) {
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * scale;
+    }
+    return data;
+  }
+
+  static DAttrs ReduceAttrs(const std::vector<int64_t> &axis, bool keep_dims) {
+    return {{"axis", MakeValue(axis)}, {"keep_dims", MakeValue(keep_dims)}};
+  }
+};
+
+/// Feature: loop fusion of graph kernel on CPU
+/// Description: fuse Add with broadcast, Tanh, Mul with a constant and Add into one loop.
+/// Expectation: the result is the one of the ops run one by one.
+TEST_F(TestLoopFusionProgram, test_elemwise_broadcast) {
+  constexpr int64_t kRow = 64;
+  constexpr int64_t kCol = 1000;
+  LiteGraph::GraphBuilder gb("elemwise");
+  auto x = gb.Parameter(NodeBase{{kRow, kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto bias = gb.Parameter(NodeBase{{kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto y = gb.Parameter(NodeBase{{kRow, kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto half = gb.Value(std::make_shared<tensor::Tensor>(0.5f, kFloat32));
+  auto add = gb.Emit("Add", {x, bias});
+  auto mul = gb.Emit("Mul", {gb.Emit("Tanh", {add}), half});
+  gb.SetOutputs({gb.Emit("Add", {mul, y})});
+  auto program = LoopFusionProgram::Compile(gb.Get());
+  ASSERT_NE(program, nullptr);
+  ASSERT_EQ(program->stage_num(), 1);
+  ASSERT_TRUE(program->workspace_size_list().empty());
+  ASSERT_EQ(program->output_size_list(), std::vector<size_t>{kRow * kCol * sizeof(float)});
+
+  auto x_data = Range(kRow * kCol, 0.1f);
+  auto bias_data = Range(kCol, 0.01f);
+  auto y_data = Range(kRow * kCol, 1.0f);
+  std::vector<float> output(kRow * kCol);
+  program->Run({x_data.data(), bias_data.data(), y_data.data()}, {}, {output.data()});
+  for (size_t i = 0; i < output.size(); ++i) {
+    auto expect = std::tanh(x_data[i] + bias_data[i % kCol]) * 0.5f + y_data[i];
+    ASSERT_NEAR(output[i], expect, 1e-5);
+  }
+}
+
+/// Feature: loop fusion of graph kernel on CPU
+/// Description: fuse a softmax on the last axis, which has two reduces.
+/// Expectation: the kernel runs in three stages and both the softmax and the sum are right.
+TEST_F(TestLoopFusionProgram, test_softmax) {
+  constexpr int64_t kRow = 300;
+  constexpr int64_t kCol = 200;
+  LiteGraph::GraphBuilder gb("softmax");
+  auto x = gb.Parameter(NodeBase{{kRow, kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto max = gb.Emit("ReduceMax", {x}, ReduceAttrs({1}, true));
+  auto exp = gb.Emit("Exp", {gb.Emit("Sub", {x, max})});
+  auto sum = gb.Emit("ReduceSum", {exp}, ReduceAttrs({1}, true));
+  gb.SetOutputs({gb.Emit("RealDiv", {exp, sum}), sum});
+  auto program = LoopFusionProgram::Compile(gb.Get());
+  ASSERT_NE(program, nullptr);
+  ASSERT_EQ(program->stage_num(), 3);
+
+  auto x_data = Range(kRow * kCol, 0.3f);
+  std::vector<float> output(kRow * kCol);
+  std::vector<float> sum_output(kRow);
+  std::vector<float> workspace(program->workspace_size_list().at(0) / sizeof(float));
+  program->Run({x_data.data()}, {workspace.data()}, {output.data(), sum_output.data()});
+  for (int64_t i = 0; i < kRow; ++i) {
+    auto row = x_data.data() + i * kCol;
+    auto row_max = *std::max_element(row, row + kCol);
+    float row_sum = 0;
+    for (int64_t j = 0; j < kCol; ++j) {
+      row_sum += std::exp(row[j] - row_max);
+    }
+    ASSERT_NEAR(sum_output[i], row_sum, 1e-3);
+    for (int64_t j = 0; j < kCol; ++j) {
+      ASSERT_NEAR(output[i * kCol + j], std::exp(row[j] - row_max) / row_sum, 1e-5);
+    }
+  }
+}
+
+/// Feature: loop fusion of graph kernel on CPU
+/// Description: reduce a float16 tensor on the first axis, and transpose it.
+/// Expectation: the reduce is merged from the tasks and the transpose reads the input with strides.
+TEST_F(TestLoopFusionProgram, test_reduce_first_axis_and_transpose) {
+  constexpr int64_t kRow = 2000;
+  constexpr int64_t kCol = 40;
+  LiteGraph::GraphBuilder gb("reduce");
+  auto x = gb.Parameter(NodeBase{{kRow, kCol}, kNumberTypeFloat16, kOpFormat_DEFAULT});
+  auto cast = gb.Emit("Cast", {x}, {{"dst_type", kFloat32}});
+  auto sum = gb.Emit("ReduceSum", {cast}, ReduceAttrs({0}, false));
+  auto transpose = gb.Emit("Transpose", {x}, {{"perm", MakeValue(std::vector<int64_t>{1, 0})}});
+  gb.SetOutputs({sum, transpose});
+  auto program = LoopFusionProgram::Compile(gb.Get());
+  ASSERT_NE(program, nullptr);
+
+  auto x_float = Range(kRow * kCol, 0.5f);
+  std::vector<float16> x_data(x_float.begin(), x_float.end());
+  std::vector<float> sum_output(kCol);
+  std::vector<float16> transpose_output(kRow * kCol);
+  program->Run({x_data.data()}, {}, {sum_output.data(), transpose_output.data()});
+  for (int64_t j = 0; j < kCol; ++j) {
+    float expect = 0;
+    for (int64_t i = 0; i < kRow; ++i) {
+      expect += x_float[i * kCol + j];
+      ASSERT_EQ(static_cast<float>(transpose_output[j * kRow + i]), x_float[i * kCol + j]);
+    }
+    ASSERT_NEAR(sum_output[j], expect, 1e-3);
+  }
+}
+
+/// Feature: loop fusion of graph kernel on CPU
+/// Description: compile a graph with a MatMul.
+/// Expectation: the graph is not supported.
+TEST_F(TestLoopFusionProgram, test_unsupported_op) {
+  LiteGraph::GraphBuilder gb("matmul");
+  auto a = gb.Parameter(NodeBase{{16, 16}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto b = gb.Parameter(NodeBase{{16, 16}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto matmul = gb.Op("MatMul", NodeBase{{16, 16}, kNumberTypeFloat32, kOpFormat_DEFAULT}, {a, b});
+  gb.SetOutputs({gb.Emit("Add", {matmul, a})});
+  ASSERT_EQ(LoopFusionProgram::Compile(gb.Get()), nullptr);
+}
+
+/// Feature: loop fusion of graph kernel on CPU
+/// Description: check the basic ops which the CPU graph kernel passes may fuse when built without AKG.
+/// Expectation: the ops the loop fusion compiles are accepted, other ops, types and formats are not.
+TEST_F(TestLoopFusionProgram, test_supported_op) {
+  const std::vector<std::string> formats = {kOpFormat_DEFAULT, kOpFormat_DEFAULT};
+  ASSERT_TRUE(LoopFusionProgram::IsSupportedOp("Add", {kNumberTypeFloat32, kNumberTypeFloat32}, formats));
+  ASSERT_TRUE(LoopFusionProgram::IsSupportedOp("ReduceSum", {kNumberTypeFloat16, kNumberTypeFloat16}, formats));
+  ASSERT_TRUE(LoopFusionProgram::IsSupportedOp("Cast", {kNumberTypeBool, kNumberTypeFloat32}, formats));
+  ASSERT_FALSE(LoopFusionProgram::IsSupportedOp("MatMul", {kNumberTypeFloat32, kNumberTypeFloat32}, formats));
+  ASSERT_FALSE(LoopFusionProgram::IsSupportedOp("Cast", {kNumberTypeInt32, kNumberTypeFloat32}, formats));
+  ASSERT_FALSE(LoopFusionProgram::IsSupportedOp("Exp", {kNumberTypeFloat32, kNumberTypeFloat32},
+                                                {kOpFormat_NC1HWC0, kOpFormat_NC1HWC0}));
+}
+}  // namespace kernel
+}  // namespace mindspore
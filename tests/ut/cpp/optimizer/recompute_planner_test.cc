@@ -0,0 +1,155 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/anf.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "abstract/abstract_value.h"
+#include "frontend/operator/ops.h"
+#include "frontend/optimizer/recompute_planner.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestRecomputePlanner : public UT::Common {
+ public:
+  TestRecomputePlanner() {}
+  void SetUp() override { graph_ = std::make_shared<FuncGraph>(); }
+
+  CNodePtr NewForwardNode(const PrimitivePtr &prim, const std::vector<AnfNodePtr> &inputs, const ShapeVector &shape) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(prim)};
+    node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto node = graph_->NewCNode(node_inputs);
+    node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    return node;
+  }
+
+  // The gradient of a forward node, which keeps the forward node alive until the backward pass.
+  CNodePtr NewBpropNode(const AnfNodePtr &dout, const AnfNodePtr &forward_node) {
+    auto node = graph_->NewCNode({NewValueNode(prim::kPrimReluGrad), dout, forward_node});
+    node->set_abstract(forward_node->abstract());
+    node->set_fullname_with_scope("Gradients/Default/ReluGrad-op" + std::to_string(bprop_count_++));
+    return node;
+  }
+
+  void SetOutput(const std::vector<AnfNodePtr> &grads) {
+    std::vector<AnfNodePtr> make_tuple_inputs{NewValueNode(prim::kPrimMakeTuple)};
+    make_tuple_inputs.insert(make_tuple_inputs.end(), grads.begin(), grads.end());
+    auto make_tuple = graph_->NewCNode(make_tuple_inputs);
+    make_tuple->set_fullname_with_scope("Gradients/Default/MakeTuple-op" + std::to_string(bprop_count_++));
+    graph_->set_output(make_tuple);
+    manager_ = Manage(graph_);
+  }
+
+  RecomputePlan Plan(int64_t memory_budget) {
+    std::list<CNodePtr> orders = graph_->GetOrderedCnodes();
+    std::vector<CNodePtr> origin_nodes_topological(orders.begin(), orders.end());
+    return PlanRecomputedNodes(graph_, origin_nodes_topological, memory_budget);
+  }
+
+  bool IsRecomputed(const CNodePtr &node) {
+    auto recompute_val = node->GetAttr(kAttrRecompute);
+    return recompute_val != nullptr && GetValue<bool>(recompute_val);
+  }
+
+  FuncGraphPtr graph_;
+  FuncGraphManagerPtr manager_;
+  size_t bprop_count_ = 0;
+};
+
+/// Feature: automatic recomputation planner.
+/// Description: four relu of 4KB each are kept for the backward pass, the budget is 8KB.
+/// Expectation: two relu are recomputed, the other ones are kept as their inputs.
+TEST_F(TestRecomputePlanner, test_relu_chain_under_budget) {
+  const ShapeVector shape{1024};
+  auto x = graph_->add_parameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  std::vector<CNodePtr> relus;
+  AnfNodePtr input = x;
+  for (size_t i = 0; i < 4; ++i) {
+    auto relu = NewForwardNode(prim::kPrimRelu, {input}, shape);
+    relus.push_back(relu);
+    input = relu;
+  }
+  std::vector<AnfNodePtr> grads;
+  AnfNodePtr dout = x;
+  for (auto iter = relus.rbegin(); iter != relus.rend(); ++iter) {
+    dout = NewBpropNode(dout, *iter);
+    grads.push_back(dout);
+  }
+  SetOutput(grads);
+
+  auto plan = Plan(8192);
+  ASSERT_EQ(plan.activation_bytes, 16384);
+  ASSERT_EQ(plan.planned_activation_bytes, 8192);
+  ASSERT_EQ(plan.recomputed_node_count, 2u);
+  ASSERT_DOUBLE_EQ(plan.extra_flops, 2048);
+  ASSERT_DOUBLE_EQ(plan.forward_flops, 4096);
+  size_t recomputed_count = 0;
+  for (const auto &relu : relus) {
+    recomputed_count += IsRecomputed(relu) ? 1 : 0;
+  }
+  ASSERT_EQ(recomputed_count, 2u);
+}
+
+/// Feature: automatic recomputation planner.
+/// Description: a matmul and a relu are kept for the backward pass, the budget only fits one of them.
+/// Expectation: the relu which is cheaper to recompute is recomputed, the matmul is kept.
+TEST_F(TestRecomputePlanner, test_recompute_cheap_node_first) {
+  const ShapeVector shape{64, 64};
+  auto x = graph_->add_parameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  auto w = graph_->add_parameter();
+  w->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  auto matmul = NewForwardNode(prim::kPrimMatMul, {x, w}, shape);
+  auto relu = NewForwardNode(prim::kPrimRelu, {matmul}, shape);
+  auto relu_grad = NewBpropNode(x, relu);
+  auto matmul_grad = NewBpropNode(relu_grad, matmul);
+  SetOutput({relu_grad, matmul_grad});
+
+  auto plan = Plan(16384);
+  ASSERT_EQ(plan.activation_bytes, 32768);
+  ASSERT_EQ(plan.planned_activation_bytes, 16384);
+  ASSERT_EQ(plan.recomputed_node_count, 1u);
+  ASSERT_TRUE(IsRecomputed(relu));
+  ASSERT_FALSE(IsRecomputed(matmul));
+}
+
+/// Feature: automatic recomputation planner.
+/// Description: the activations fit in the budget, or the only activation is set not to be recomputed.
+/// Expectation: no node is recomputed.
+TEST_F(TestRecomputePlanner, test_no_recompute) {
+  const ShapeVector shape{1024};
+  auto x = graph_->add_parameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  auto relu = NewForwardNode(prim::kPrimRelu, {x}, shape);
+  SetOutput({NewBpropNode(x, relu)});
+
+  auto plan = Plan(4096);
+  ASSERT_EQ(plan.recomputed_node_count, 0u);
+  ASSERT_FALSE(IsRecomputed(relu));
+
+  relu->AddAttr(kAttrRecompute, MakeValue(false));
+  plan = Plan(0);
+  ASSERT_EQ(plan.recomputed_node_count, 0u);
+  ASSERT_EQ(plan.planned_activation_bytes, 4096);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket_planner.h"
+
+namespace mindspore {
+namespace parallel {
+class TestAllReduceBucketPlanner : public UT::Common {
+ public:
+  TestAllReduceBucketPlanner() {}
+
+  // The gradients of a backward pass, whose sizes vary and which are ready one after another.
+  static std::vector<GradientTiming> MakeGradients(size_t gradient_num) {
+    std::vector<GradientTiming> gradients(gradient_num);
+    for (size_t i = 0; i < gradient_num; ++i) {
+      gradients[i].size = 1000 * (1 + i % 3);
+      gradients[i].ready_time = 100.0 * static_cast<double>(i + 1);
+    }
+    return gradients;
+  }
+
+  static std::vector<size_t> OneBucketPerGradient(size_t gradient_num) {
+    std::vector<size_t> segment_index(gradient_num);
+    for (size_t i = 0; i < gradient_num; ++i) {
+      segment_index[i] = i;
+    }
+    return segment_index;
+  }
+};
+
+/// Feature: AllReduceBucketPlanner
+/// Description: plan the buckets of 10 gradients, and evaluate all the 512 ways to split them.
+/// Expectation: no way finishes the AllReduces earlier than the plan.
+TEST_F(TestAllReduceBucketPlanner, test_plan_is_optimal) {
+  constexpr size_t kGradientNum = 10;
+  auto gradients = MakeGradients(kGradientNum);
+  constexpr double kComputeEndTime = 1100;
+  AllReduceBucketPlanner planner({40, 20});
+  auto plan = planner.Plan(gradients, kComputeEndTime);
+  ASSERT_EQ(plan.segment_index.back(), kGradientNum - 1);
+  ASSERT_GT(plan.segment_index.size(), 1);
+  ASSERT_LT(plan.segment_index.size(), kGradientNum);
+  auto evaluated = planner.Evaluate(gradients, plan.segment_index, kComputeEndTime);
+  ASSERT_DOUBLE_EQ(evaluated.comm_end_time, plan.comm_end_time);
+  ASSERT_DOUBLE_EQ(plan.exposed_comm_time, plan.comm_end_time - kComputeEndTime);
+
+  for (size_t mask = 0; mask < (1u << (kGradientNum - 1)); ++mask) {
+    std::vector<size_t> segment_index;
+    for (size_t i = 0; i + 1 < kGradientNum; ++i) {
+      if ((mask >> i) & 1) {
+        segment_index.push_back(i);
+      }
+    }
+    segment_index.push_back(kGradientNum - 1);
+    ASSERT_GE(planner.Evaluate(gradients, segment_index, kComputeEndTime).comm_end_time, plan.comm_end_time - 1e-6);
+  }
+}
+
+/// Feature: AllReduceBucketPlanner
+/// Description: plan the buckets with a link without latency, and with a link of a large latency.
+/// Expectation: each gradient has its own bucket without latency, and all the gradients are in one bucket otherwise.
+TEST_F(TestAllReduceBucketPlanner, test_plan_by_link) {
+  constexpr size_t kGradientNum = 6;
+  auto gradients = MakeGradients(kGradientNum);
+  auto plan = AllReduceBucketPlanner({0, 100}).Plan(gradients, 700);
+  ASSERT_EQ(plan.segment_index, OneBucketPerGradient(kGradientNum));
+  ASSERT_DOUBLE_EQ(plan.exposed_comm_time, 0);
+
+  plan = AllReduceBucketPlanner({10000, 100}).Plan(gradients, 700);
+  ASSERT_EQ(plan.segment_index, std::vector<size_t>{kGradientNum - 1});
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -18,12 +18,29 @@
 #include "ir/dtype/number.h"
 #include "frontend/parallel/device_manager.h"
 #include "frontend/parallel/auto_parallel/edge_costmodel.h"
+#include "frontend/parallel/auto_parallel/redistribution_cost_cache.h"
 #include "frontend/parallel/ops_info/matmul_info.h"
 
 namespace mindspore {
 namespace parallel {
 
 using MatMulInfoPtr = std::shared_ptr<MatMulInfo>;
+
+void ExpectSameCostMap(const std::map<CostPtrKey, CostPtrList> &map1, const std::map<CostPtrKey, CostPtrList> &map2) {
+  ASSERT_EQ(map1.size(), map2.size());
+  for (auto &kv : map1) {
+    auto iter = map2.find(kv.first);
+    ASSERT_NE(iter, map2.end());
+    ASSERT_EQ(kv.second.size(), iter->second.size());
+    for (size_t i = 0; i < kv.second.size(); ++i) {
+      EXPECT_EQ(kv.second[i]->computation_cost_, iter->second[i]->computation_cost_);
+      EXPECT_EQ(kv.second[i]->communication_cost_, iter->second[i]->communication_cost_);
+      EXPECT_EQ(kv.second[i]->communication_with_partial_para_, iter->second[i]->communication_with_partial_para_);
+      EXPECT_EQ(kv.second[i]->memory_with_reuse_, iter->second[i]->memory_with_reuse_);
+    }
+  }
+}
+
 class TestEdgeCostModel : public UT::Common {
  public:
   TestEdgeCostModel() {
@@ -115,6 +132,50 @@ TEST_F(TestEdgeCostModel, test_InitEdgeCost) {
   ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
 }
 
+TEST_F(TestEdgeCostModel, test_InitEdgeCost_with_cost_cache) {
+  auto &cost_cache = RedistributionCostCache::GetInstance();
+  cost_cache.Clear();
+  cost_cache.ResetCount();
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  auto cost_map = edge_m1_m2->GetCostMap();
+  ASSERT_EQ(cost_cache.hit_count() + cost_cache.miss_count(), cost_map.size());
+  ASSERT_LE(cost_cache.size(), cost_cache.miss_count());
+
+  // The costs of the same edge are all found in the cache
+  cost_cache.ResetCount();
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(cost_cache.hit_count(), cost_map.size());
+  ASSERT_EQ(cost_cache.miss_count(), 0u);
+  ExpectSameCostMap(edge_m1_m2->GetCostMap(), cost_map);
+
+  // The costs with and without the redistribution search are kept apart
+  auto cost_model_context = CostModelContext::GetInstance();
+  auto redistribution_search = cost_model_context->dp_algo_redistribution_search();
+  TensorLayout layout;
+  auto key = cost_cache.Key(layout, layout, 8);
+  cost_model_context->set_dp_algo_redistribution_search(!redistribution_search);
+  ASSERT_NE(cost_cache.Key(layout, layout, 8), key);
+  cost_model_context->set_dp_algo_redistribution_search(redistribution_search);
+
+  // The costs survive saving and loading
+  std::string path = "./test_redistribution_cost.cache";
+  ASSERT_EQ(cost_cache.Save(path), SUCCESS);
+  auto cache_size = cost_cache.size();
+  cost_cache.Clear();
+  ASSERT_EQ(cost_cache.Load(path), SUCCESS);
+  ASSERT_EQ(cost_cache.size(), cache_size);
+  cost_cache.ResetCount();
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(cost_cache.miss_count(), 0u);
+  ExpectSameCostMap(edge_m1_m2->GetCostMap(), cost_map);
+  (void)remove(path.c_str());
+  cost_cache.Clear();
+}
+
 TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
@@ -135,6 +196,58 @@ TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   new_edge->OpEliminationSetNewCost(edge_m1_m2, matmul2, edge_m2_m4);
 }
 
+TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost_multi_threads) {
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  std::shared_ptr<Edge> edge_m2_m4 = std::make_shared<Edge>(edge_name, matmul2, matmul4, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul4->GenerateStrategies(0);
+  auto cost_model_context = CostModelContext::GetInstance();
+  cost_model_context->set_dp_algo_search_threads(1);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(edge_m2_m4->InitEdgeCost(), SUCCESS);
+  std::shared_ptr<Edge> serial_edge = std::make_shared<Edge>(edge_name, matmul1, matmul4, 0, 0, false);
+  serial_edge->set_pre_op_output(edge_m1_m2->prev_op_output());
+  serial_edge->set_next_op_input(edge_m2_m4->next_op_input());
+  serial_edge->OpEliminationSetNewCost(edge_m1_m2, matmul2, edge_m2_m4);
+
+  // The costs do not depend on the number of threads
+  cost_model_context->set_dp_algo_search_threads(4);
+  auto serial_cost_map = edge_m1_m2->GetCostMap();
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ExpectSameCostMap(edge_m1_m2->GetCostMap(), serial_cost_map);
+  std::shared_ptr<Edge> parallel_edge = std::make_shared<Edge>(edge_name, matmul1, matmul4, 0, 0, false);
+  parallel_edge->set_pre_op_output(edge_m1_m2->prev_op_output());
+  parallel_edge->set_next_op_input(edge_m2_m4->next_op_input());
+  parallel_edge->OpEliminationSetNewCost(edge_m1_m2, matmul2, edge_m2_m4);
+  ExpectSameCostMap(parallel_edge->GetCostMap(), serial_edge->GetCostMap());
+  cost_model_context->set_dp_algo_search_threads(DEFAULT_DP_ALGO_SEARCH_THREADS);
+}
+
+TEST_F(TestEdgeCostModel, test_InitEdgeCost_creates_no_group) {
+  auto &cost_cache = RedistributionCostCache::GetInstance();
+  cost_cache.Clear();
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  auto cost_model_context = CostModelContext::GetInstance();
+  cost_model_context->set_dp_algo_search_threads(4);
+  auto group_num = g_device_manager->group_info().size();
+  // The redistribution costs are all computed by the threads of the search
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(g_device_manager->group_info().size(), group_num);
+  cost_model_context->set_dp_algo_search_threads(DEFAULT_DP_ALGO_SEARCH_THREADS);
+  cost_cache.Clear();
+
+  {
+    ForbidGroupCreation forbid_group_creation;
+    EXPECT_ANY_THROW(g_device_manager->CreateGroup({0, 1}));
+  }
+  EXPECT_NO_THROW(g_device_manager->CreateGroup({0, 1}));
+}
+
 TEST_F(TestEdgeCostModel, test_EdgeEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m5 = std::make_shared<Edge>(edge_name, matmul1, matmul5, 0, 0, false);
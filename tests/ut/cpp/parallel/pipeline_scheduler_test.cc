@@ -0,0 +1,128 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/pipeline_transformer/pipeline_scheduler.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace parallel {
+class TestPipelineScheduler : public UT::Common {
+ public:
+  TestPipelineScheduler() {}
+
+  // Check that each stage runs the forward and the backward of each micro batch on each chunk once, the backward
+  // after the forward, and the forwards of a micro batch in the order of the chunks.
+  static void CheckSchedule(const PipelineScheduler &scheduler) {
+    for (int64_t stage = 0; stage < scheduler.stage_num(); ++stage) {
+      auto tasks = scheduler.Schedule(stage);
+      ASSERT_EQ(tasks.size(), LongToSize(scheduler.micro_num() * scheduler.chunk_num() * 2));
+      std::map<std::pair<int64_t, int64_t>, size_t> forward_index;
+      std::map<std::pair<int64_t, int64_t>, size_t> backward_index;
+      for (size_t i = 0; i < tasks.size(); ++i) {
+        auto key = std::make_pair(tasks[i].micro, tasks[i].chunk);
+        auto &index = tasks[i].is_forward ? forward_index : backward_index;
+        ASSERT_EQ(index.count(key), 0u);
+        index[key] = i;
+      }
+      for (auto &forward : forward_index) {
+        ASSERT_LT(forward.second, backward_index.at(forward.first));
+        if (forward.first.second > 0) {
+          ASSERT_GT(forward.second, forward_index.at({forward.first.first, forward.first.second - 1}));
+        }
+      }
+    }
+  }
+};
+
+/// Feature: PipelineScheduler
+/// Description: schedule and simulate the pipeline with several numbers of stages, chunks and micro batches, where a
+/// Send blocks until its Receive is posted.
+/// Expectation: the schedules are complete and do not deadlock.
+TEST_F(TestPipelineScheduler, test_schedule_no_deadlock) {
+  for (int64_t stage_num : {1, 2, 4, 8}) {
+    for (int64_t chunk_num : {1, 2, 3, 4}) {
+      for (int64_t group_num : {1, 2, 3}) {
+        for (auto order : {DEPTH_FIRST, BREADTH_FIRST}) {
+          PipelineScheduler scheduler(stage_num, chunk_num, stage_num * group_num, order);
+          CheckSchedule(scheduler);
+          auto stats = scheduler.Simulate(1, 2, 0.1);
+          ASSERT_GE(stats.bubble_ratio, 0);
+          ASSERT_LT(stats.bubble_ratio, 1);
+        }
+      }
+    }
+  }
+  PipelineScheduler scheduler(4, 1, 7);
+  CheckSchedule(scheduler);
+  (void)scheduler.Simulate(1, 2);
+}
+
+/// Feature: PipelineScheduler
+/// Description: simulate the plain 1F1B schedule.
+/// Expectation: the bubble is (p - 1) / (m + p - 1) and the first stage keeps the activations of p micro batches.
+TEST_F(TestPipelineScheduler, test_plain_1f1b) {
+  constexpr int64_t kStageNum = 4;
+  constexpr int64_t kMicroNum = 8;
+  auto stats = PipelineScheduler(kStageNum, 1, kMicroNum).Simulate(1, 2);
+  ASSERT_DOUBLE_EQ(stats.makespan, (kMicroNum + kStageNum - 1) * 3.0);
+  ASSERT_DOUBLE_EQ(stats.bubble_ratio, (kStageNum - 1.0) / (kMicroNum + kStageNum - 1));
+  ASSERT_EQ(stats.peak_in_flight, kStageNum);
+}
+
+/// Feature: PipelineScheduler
+/// Description: simulate the interleaved schedule with 1, 2 and 4 chunks per stage.
+/// Expectation: the bubble shrinks as the chunks increase, and the activations are bounded by the warmup.
+TEST_F(TestPipelineScheduler, test_interleaved_bubble) {
+  constexpr int64_t kStageNum = 4;
+  constexpr int64_t kMicroNum = 8;
+  double last_bubble_ratio = 1;
+  for (int64_t chunk_num : {1, 2, 4}) {
+    auto stats = PipelineScheduler(kStageNum, chunk_num, kMicroNum).Simulate(1, 2);
+    ASSERT_LT(stats.bubble_ratio, last_bubble_ratio);
+    last_bubble_ratio = stats.bubble_ratio;
+    auto bound = chunk_num == 1 ? kStageNum : (kStageNum - 1) * 2 + (chunk_num - 1) * kStageNum + 1;
+    ASSERT_LE(stats.peak_in_flight, bound);
+  }
+  auto stats = PipelineScheduler(kStageNum, 2, kMicroNum).Simulate(1, 2);
+  ASSERT_LT(stats.bubble_ratio, (kStageNum - 1.0) / (kMicroNum + kStageNum - 1));
+}
+
+/// Feature: PipelineScheduler
+/// Description: schedule the chunks with the depth first and the breadth first micro batch order.
+/// Expectation: the breadth first order keeps more activations, and invalid settings raise exceptions.
+TEST_F(TestPipelineScheduler, test_micro_batch_order) {
+  constexpr int64_t kStageNum = 4;
+  constexpr int64_t kMicroNum = 16;
+  auto depth_first = PipelineScheduler(kStageNum, 2, kMicroNum, DEPTH_FIRST).Simulate(1, 2);
+  auto breadth_first = PipelineScheduler(kStageNum, 2, kMicroNum, BREADTH_FIRST).Simulate(1, 2);
+  ASSERT_LT(depth_first.peak_in_flight, breadth_first.peak_in_flight);
+
+  auto tasks = PipelineScheduler(kStageNum, 2, kMicroNum, BREADTH_FIRST).Schedule(0);
+  for (int64_t micro = 0; micro < kMicroNum; ++micro) {
+    ASSERT_EQ(tasks[micro].micro, micro);
+    ASSERT_EQ(tasks[micro].chunk, 0);
+  }
+  EXPECT_ANY_THROW(PipelineScheduler(kStageNum, 2, kMicroNum, "random"));
+  EXPECT_ANY_THROW(PipelineScheduler(kStageNum, 2, 6));
+  EXPECT_ANY_THROW(PipelineScheduler(kStageNum, 1, 2));
+}
+}  // namespace parallel
+}  // namespace mindspore
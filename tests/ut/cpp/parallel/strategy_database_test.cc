@@ -0,0 +1,146 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <string>
+#include "common/common_test.h"
+#include "frontend/parallel/context.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/strategy_checkpoint/strategy_database.h"
+
+namespace mindspore {
+namespace parallel {
+class TestStrategyDatabase : public UT::Common {
+ public:
+  TestStrategyDatabase() {}
+
+  void SetUp() {
+    StrategyDatabase::GetInstance().Clear();
+    StrategyDatabase::GetInstance().ResetCount();
+  }
+
+  void TearDown() { StrategyDatabase::GetInstance().Clear(); }
+
+  // The signature of a MatMul taking an activation of the batch size and a weight.
+  static StrategySignature MatMulSignature(int64_t batch, size_t dev_num,
+                                           const std::string &attrs = "transpose_a=false,transpose_b=false") {
+    return StrategyDatabase::Signature("MatMul", attrs, {"ReLU", "Load"}, {{batch, 256}, {256, 512}}, {false, true},
+                                       dev_num);
+  }
+};
+
+/// Feature: StrategyDatabase
+/// Description: make the signatures of MatMuls of different batch sizes and numbers of devices.
+/// Expectation: the partial signatures only ignore the batch size of the inputs which are not parameters.
+TEST_F(TestStrategyDatabase, test_signature) {
+  auto signature = MatMulSignature(32, 8);
+  ASSERT_EQ(signature.exact,
+            "MatMul[transpose_a=false,transpose_b=false](ReLU,Load) | [32,256][256,512] | 8 | 0 | 0 | 0");
+  ASSERT_EQ(signature.partial,
+            "MatMul[transpose_a=false,transpose_b=false](ReLU,Load) | [*,256][256,512] | 8 | 0 | 0 | 0");
+  auto other_batch = MatMulSignature(64, 8);
+  ASSERT_NE(other_batch.exact, signature.exact);
+  ASSERT_EQ(other_batch.partial, signature.partial);
+  ASSERT_NE(MatMulSignature(32, 16).partial, signature.partial);
+}
+
+/// Feature: StrategyDatabase
+/// Description: make the signatures of MatMuls with other attributes and under other search options.
+/// Expectation: neither the exact nor the partial signatures are shared.
+TEST_F(TestStrategyDatabase, test_signature_attrs_and_options) {
+  auto signature = MatMulSignature(32, 8);
+  ASSERT_NE(MatMulSignature(32, 8, "transpose_a=false,transpose_b=true").partial, signature.partial);
+
+  auto cost_model_context = CostModelContext::GetInstance();
+  cost_model_context->set_dp_algo_redistribution_search(true);
+  ASSERT_NE(MatMulSignature(32, 8).partial, signature.partial);
+  cost_model_context->set_dp_algo_redistribution_search(DEFAULT_DP_ALGO_REDISTRIBUTION_SEARCH);
+  cost_model_context->set_elementwise_stra_follow(true);
+  ASSERT_NE(MatMulSignature(32, 8).partial, signature.partial);
+  cost_model_context->set_elementwise_stra_follow(DEFAULT_ELEMENTWISE_OP_STRA_FOLLOW);
+  ParallelContext::GetInstance()->set_enable_all2all(true);
+  ASSERT_NE(MatMulSignature(32, 8).partial, signature.partial);
+  ParallelContext::GetInstance()->set_enable_all2all(false);
+  ASSERT_EQ(MatMulSignature(32, 8).partial, signature.partial);
+}
+
+/// Feature: StrategyDatabase
+/// Description: find the strategy of a MatMul by the same batch size, another batch size and another number of
+/// devices.
+/// Expectation: they are found by the exact signature, by the partial signature and not found.
+TEST_F(TestStrategyDatabase, test_find) {
+  auto &database = StrategyDatabase::GetInstance();
+  auto strategy = NewStrategy(0, {{8, 1}, {1, 1}});
+  database.Insert(MatMulSignature(32, 8), strategy);
+  ASSERT_EQ(database.size(), 2u);
+
+  bool exact = false;
+  auto found = database.Find(MatMulSignature(32, 8), &exact);
+  ASSERT_NE(found, nullptr);
+  ASSERT_TRUE(found->IsEqual(strategy));
+  ASSERT_TRUE(exact);
+  found = database.Find(MatMulSignature(64, 8), &exact);
+  ASSERT_NE(found, nullptr);
+  ASSERT_TRUE(found->IsEqual(strategy));
+  ASSERT_FALSE(exact);
+  ASSERT_EQ(database.Find(MatMulSignature(32, 16), &exact), nullptr);
+  ASSERT_EQ(database.exact_hit_count(), 1u);
+  ASSERT_EQ(database.partial_hit_count(), 1u);
+  ASSERT_EQ(database.miss_count(), 1u);
+}
+
+/// Feature: StrategyDatabase
+/// Description: save the strategies and the search time of a job, load them in another job which saves its own
+/// strategy, then save a strategy of a third job which has not loaded the file.
+/// Expectation: the strategies and the time per searched operator survive, and the file keeps the strategies and the
+/// search time of all the jobs.
+TEST_F(TestStrategyDatabase, test_save_load) {
+  auto &database = StrategyDatabase::GetInstance();
+  std::string path = "./test_parallel_strategy.db";
+  (void)remove(path.c_str());
+  auto strategy = NewStrategy(0, {{8, 1}, {1, 1}});
+  database.Insert(MatMulSignature(32, 8), strategy);
+  database.RecordSearchTime(4, 1000);
+  ASSERT_DOUBLE_EQ(database.TimePerSearchedOperator(), 250.0);
+  ASSERT_EQ(database.Save(path), SUCCESS);
+
+  database.Clear();
+  ASSERT_EQ(database.Load(path), SUCCESS);
+  ASSERT_EQ(database.size(), 2u);
+  ASSERT_DOUBLE_EQ(database.TimePerSearchedOperator(), 250.0);
+  bool exact = false;
+  auto found = database.Find(MatMulSignature(32, 8), &exact);
+  ASSERT_NE(found, nullptr);
+  ASSERT_TRUE(found->IsEqual(strategy));
+
+  database.Clear();
+  auto relu_signature = StrategyDatabase::Signature("ReLU", "", {"MatMul"}, {{32, 512}}, {false}, 8);
+  auto relu_strategy = NewStrategy(0, {{4, 2}});
+  database.Insert(relu_signature, relu_strategy);
+  ASSERT_EQ(database.Save(path), SUCCESS);
+  database.Clear();
+  ASSERT_EQ(database.Load(path), SUCCESS);
+  ASSERT_EQ(database.size(), 4u);
+  ASSERT_DOUBLE_EQ(database.TimePerSearchedOperator(), 250.0);
+  found = database.Find(relu_signature, &exact);
+  ASSERT_NE(found, nullptr);
+  ASSERT_TRUE(found->IsEqual(relu_strategy));
+  ASSERT_NE(database.Find(MatMulSignature(64, 8), &exact), nullptr);
+  (void)remove(path.c_str());
+  (void)remove((path + ".lock").c_str());
+}
+}  // namespace parallel
+}  // namespace mindspore
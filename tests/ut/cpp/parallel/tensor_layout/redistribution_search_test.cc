@@ -0,0 +1,176 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/context.h"
+#include "frontend/parallel/tensor_layout/redistribution_search.h"
+#include "util_layout_gen_test.h"
+
+namespace mindspore {
+namespace parallel {
+class TestRedistributionSearch : public UT::Common {
+ public:
+  TestRedistributionSearch() {}
+
+  void SetUp() { RedistributionSearch::GetInstance().Clear(); }
+
+  void TearDown() {
+    RedistributionSearch::GetInstance().Clear();
+    ParallelContext::GetInstance()->set_enable_all2all(false);
+  }
+
+  static TensorLayout MakeLayout(const Shape &dev_mat, const Shape &tensor_map, const Shape &tensor_shape) {
+    Arrangement device_arrangement;
+    Map map;
+    Arrangement shape;
+    EXPECT_EQ(device_arrangement.Init(dev_mat), Status::SUCCESS);
+    EXPECT_EQ(map.Init(tensor_map), Status::SUCCESS);
+    EXPECT_EQ(shape.Init(tensor_shape), Status::SUCCESS);
+    TensorLayout layout;
+    EXPECT_EQ(layout.Init(device_arrangement, map, shape), Status::SUCCESS);
+    return layout;
+  }
+
+  static std::vector<RedistributionOption> AllOptions() {
+    std::vector<RedistributionOption> options;
+    for (bool use_all2all : {false, true}) {
+      for (auto concat_choice : {ConcatChoice::kFirst, ConcatChoice::kFewestSlices, ConcatChoice::kMostSlices}) {
+        for (bool concat_first : {false, true}) {
+          RedistributionOption option;
+          option.use_all2all = use_all2all;
+          option.concat_first = concat_first;
+          option.concat_choice = concat_choice;
+          options.push_back(option);
+        }
+      }
+    }
+    return options;
+  }
+
+  // Check that the operators change the in tensor map into the out tensor map.
+  static void CheckOperators(Shape in_tensor_map, const Shape &out_tensor_map, const OperatorList &operator_list) {
+    for (auto &op_cost : operator_list) {
+      const Args &args = op_cost.first.second;
+      ASSERT_GT(args.size(), 2);
+      if (op_cost.first.first == SPLIT_BY_AXIS) {
+        ASSERT_EQ(in_tensor_map[args[1]], -1);
+        in_tensor_map[args[1]] = out_tensor_map[args[1]];
+      } else if (op_cost.first.first == PERMUTE_BY_AXIS) {
+        in_tensor_map[args[1]] = in_tensor_map[args[2]];
+        in_tensor_map[args[2]] = -1;
+      } else {
+        in_tensor_map[args[0]] = -1;
+      }
+    }
+    ASSERT_EQ(in_tensor_map, out_tensor_map);
+  }
+};
+
+/// Feature: RedistributionSearch
+/// Description: search the redistributions between all the valid tensor maps on the device matrix [2, 4, 8], with
+/// AlltoAll disabled and enabled.
+/// Expectation: the operators of every option are equivalent, the plan is the cheapest option allowed, and some plans
+/// are cheaper than the default ones.
+TEST_F(TestRedistributionSearch, test_search_cheapest) {
+  Shape dev_mat = {2, 4, 8};
+  Shape tensor_shape = {64, 64, 64};
+  Shapes tensor_map_list;
+  GenerateValidTensorMap(dev_mat, tensor_shape, &tensor_map_list);
+  RankList dev_list(64);
+  std::iota(dev_list.begin(), dev_list.end(), 0);
+  for (bool enable_all2all : {false, true}) {
+    ParallelContext::GetInstance()->set_enable_all2all(enable_all2all);
+    size_t improved_num = 0;
+    for (auto &in_tensor_map : tensor_map_list) {
+      auto from = MakeLayout(dev_mat, in_tensor_map, tensor_shape);
+      for (auto &out_tensor_map : tensor_map_list) {
+        Map to_tensor_map;
+        ASSERT_EQ(to_tensor_map.Init(out_tensor_map), Status::SUCCESS);
+        double least_cost = -1;
+        for (auto &option : AllOptions()) {
+          RedistributionOperatorInfer operator_infer(false);
+          ASSERT_EQ(operator_infer.Init(from, to_tensor_map, dev_list), Status::SUCCESS);
+          ASSERT_EQ(operator_infer.InferRedistributionOperator(option), Status::SUCCESS);
+          CheckOperators(in_tensor_map, out_tensor_map, operator_infer.operator_list());
+          if (option.use_all2all && !enable_all2all) {
+            continue;
+          }
+          double cost = RedistributionCommCost(operator_infer.operator_list(), from.slice_shape().array());
+          least_cost = (least_cost < 0) ? cost : std::min(least_cost, cost);
+        }
+        RedistributionPlan plan;
+        ASSERT_EQ(RedistributionSearch::GetInstance().Search(from, to_tensor_map, dev_list, &plan), Status::SUCCESS);
+        ASSERT_EQ(plan.option.use_all2all && !enable_all2all, false);
+        ASSERT_DOUBLE_EQ(plan.comm_cost, least_cost);
+        ASSERT_LE(plan.comm_cost, plan.default_comm_cost);
+        improved_num += (plan.comm_cost < plan.default_comm_cost) ? 1 : 0;
+      }
+    }
+    ASSERT_GT(improved_num, 0);
+  }
+}
+
+/// Feature: RedistributionSearch
+/// Description: gather a tensor map [1, 0] on the device matrix [2, 4] into the swapped one, and compute its cost.
+/// Expectation: the dimension split into fewer slices is gathered first, and the cost follows the cost model.
+TEST_F(TestRedistributionSearch, test_swap_cost) {
+  auto from = MakeLayout({2, 4}, {1, 0}, {64, 64});
+  Map to_tensor_map;
+  ASSERT_EQ(to_tensor_map.Init({0, 1}), Status::SUCCESS);
+  RankList dev_list = {0, 1, 2, 3, 4, 5, 6, 7};
+  RedistributionOperatorInfer operator_infer(false);
+  ASSERT_EQ(operator_infer.Init(from, to_tensor_map, dev_list), Status::SUCCESS);
+  RedistributionOption option;
+  option.concat_choice = ConcatChoice::kFewestSlices;
+  ASSERT_EQ(operator_infer.InferRedistributionOperator(option), Status::SUCCESS);
+  auto operator_list = operator_infer.operator_list();
+  // AllGather the dimension 0 of 2 slices, permute the dimension 1 into it by AllGather and Split, then split it.
+  ASSERT_EQ(operator_list.size(), 4);
+  ASSERT_EQ(operator_list[0].first.first, CONCAT_BY_AXIS);
+  ASSERT_EQ(operator_list[0].first.second, Args({0, 1, 2}));
+  // The slice [32, 16] is gathered into [64, 16], which is gathered into [64, 64] by the permute.
+  double expect_cost = 32 * 16 * (2 + 1) * ALLGATHER_REDUCESCATTER_SCALE_FACTOR +
+                       64 * 16 * (4 + 1) * ALLGATHER_REDUCESCATTER_SCALE_FACTOR;
+  ASSERT_DOUBLE_EQ(RedistributionCommCost(operator_list, from.slice_shape().array()), expect_cost);
+}
+
+/// Feature: RedistributionSearch
+/// Description: search the same redistribution twice, and again after the AlltoAll is enabled.
+/// Expectation: the second search hits the cache, and enabling AlltoAll searches again.
+TEST_F(TestRedistributionSearch, test_cache) {
+  auto from = MakeLayout({2, 4}, {1, 0}, {64, 64});
+  Map to_tensor_map;
+  ASSERT_EQ(to_tensor_map.Init({0, 1}), Status::SUCCESS);
+  RankList dev_list = {0, 1, 2, 3, 4, 5, 6, 7};
+  auto &search = RedistributionSearch::GetInstance();
+  RedistributionPlan plan;
+  RedistributionPlan cached_plan;
+  ASSERT_EQ(search.Search(from, to_tensor_map, dev_list, &plan), Status::SUCCESS);
+  ASSERT_EQ(search.Search(from, to_tensor_map, dev_list, &cached_plan), Status::SUCCESS);
+  ASSERT_EQ(search.miss_num(), 1);
+  ASSERT_EQ(search.hit_num(), 1);
+  ASSERT_DOUBLE_EQ(cached_plan.comm_cost, plan.comm_cost);
+  ParallelContext::GetInstance()->set_enable_all2all(true);
+  ASSERT_EQ(search.Search(from, to_tensor_map, dev_list, &plan), Status::SUCCESS);
+  ASSERT_EQ(search.miss_num(), 2);
+  search.Clear();
+  ASSERT_EQ(search.hit_num(), 0);
+}
+}  // namespace parallel
+}  // namespace mindspore
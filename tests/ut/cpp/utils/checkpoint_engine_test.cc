@@ -0,0 +1,109 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/tensor.h"
+#include "utils/checkpoint_engine.h"
+
+namespace mindspore {
+namespace checkpoint {
+class TestCheckpointEngine : public UT::Common {
+ public:
+  TestCheckpointEngine() {}
+  void TearDown() override { (void)std::remove(file_name_.c_str()); }
+
+  tensor::TensorPtr NewTensor(const ShapeVector &shape, float start) {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+    auto data = static_cast<float *>(tensor->data_c());
+    for (size_t i = 0; i < tensor->DataSize(); ++i) {
+      data[i] = start + static_cast<float>(i);
+    }
+    return tensor;
+  }
+
+  std::string file_name_ = "./checkpoint_engine_test.msckpt";
+};
+
+/// Feature: native checkpoint engine.
+/// Description: save tensors asynchronously, change one after the save, and read them back.
+/// Expectation: the read tensors are the saved ones, the writer does not hold the tensors after the save.
+TEST_F(TestCheckpointEngine, test_save_and_read) {
+  auto weight = NewTensor({16, 32}, 1);
+  auto bias = NewTensor({32}, 100);
+  auto step = std::make_shared<tensor::Tensor>(static_cast<int64_t>(7), kInt64);
+  CheckpointWriter writer(file_name_, 2);
+  writer.Add("weight", weight);
+  writer.Add("bias", bias);
+  writer.Add("step", step);
+  ASSERT_TRUE(writer.Save(true));
+  ASSERT_TRUE(writer.Wait());
+  ASSERT_FALSE(writer.IsRunning());
+  ASSERT_EQ(weight.use_count(), 1);
+  static_cast<float *>(weight->data_c())[0] = -1;
+  ASSERT_TRUE(IsNativeCheckpoint(file_name_));
+
+  CheckpointReader reader(file_name_);
+  ASSERT_TRUE(reader.Open());
+  ASSERT_EQ(reader.GetNames(), std::vector<std::string>({"weight", "bias", "step"}));
+  auto read_weight = reader.Read("weight");
+  ASSERT_EQ(read_weight->data_type(), kNumberTypeFloat32);
+  ASSERT_EQ(read_weight->shape(), ShapeVector({16, 32}));
+  ASSERT_TRUE(read_weight->ValueEqual(*NewTensor({16, 32}, 1)));
+  ASSERT_TRUE(reader.Read("bias")->ValueEqual(*bias));
+  auto read_step = reader.Read("step");
+  ASSERT_EQ(read_step->data_type(), kNumberTypeInt64);
+  ASSERT_EQ(static_cast<int64_t *>(read_step->data_c())[0], 7);
+  ASSERT_ANY_THROW(reader.Read("moment"));
+}
+
+/// Feature: native checkpoint engine.
+/// Description: change one byte of the data of a saved tensor, then of a file which is not a native checkpoint.
+/// Expectation: reading the tensor fails the crc check, opening the other file fails.
+TEST_F(TestCheckpointEngine, test_broken_file) {
+  CheckpointWriter writer(file_name_);
+  writer.Add("weight", NewTensor({64}, 0));
+  ASSERT_TRUE(writer.Save(false));
+
+  std::vector<char> content;
+  {
+    std::ifstream fin(file_name_, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  }
+  (void)std::remove(file_name_.c_str());
+  content[128] ^= 1;
+  {
+    std::ofstream fout(file_name_, std::ios::binary);
+    fout.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+  CheckpointReader reader(file_name_);
+  ASSERT_TRUE(reader.Open());
+  ASSERT_ANY_THROW(reader.Read("weight"));
+
+  (void)std::remove(file_name_.c_str());
+  {
+    std::ofstream fout(file_name_, std::ios::binary);
+    fout << "not a native checkpoint file";
+  }
+  ASSERT_FALSE(IsNativeCheckpoint(file_name_));
+  CheckpointReader other_reader(file_name_);
+  ASSERT_FALSE(other_reader.Open());
+}
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -16,6 +16,7 @@
 Testing WordpieceTokenizer op in DE
 """
 import numpy as np
+import pytest
 import mindspore.dataset as ds
 from mindspore import log as logger
 import mindspore.dataset.text as text
@@ -140,6 +141,25 @@ def check_wordpiece_tokenizer_with_offsets(first, last, expect_str, expected_off
         count = count + 1
 
 
+def check_wordpiece_tokenizer_with_ids(first, last, expect_str, vocab_list, max_bytes_per_token=100):
+    dataset = ds.TextFileDataset(WORDPIECE_TOKENIZER_FILE, shuffle=False)
+    if first > 1:
+        dataset = dataset.skip(first - 1)
+    if last >= first:
+        dataset = dataset.take(last - first + 1)
+    vocab_list = vocab_list + ['[UNK]']
+    vocab = text.Vocab.from_list(vocab_list)
+    tokenizer_op = text.WordpieceTokenizer(vocab=vocab, with_ids=True, max_bytes_per_token=max_bytes_per_token)
+    dataset = dataset.map(operations=tokenizer_op)
+    count = 0
+    for i in dataset.create_dict_iterator(num_epochs=1, output_numpy=True):
+        expect_ids = [vocab_list.index(token) for token in expect_str[count]]
+        assert i['text'].dtype == np.int32
+        np.testing.assert_array_equal(i['text'], expect_ids)
+        count = count + 1
+    assert count == last - first + 1
+
+
 def test_wordpiece_tokenizer_default():
     """
     Test WordpieceTokenizer
@@ -156,6 +176,33 @@ def test_wordpiece_tokenizer_with_offsets():
         check_wordpiece_tokenizer_with_offsets(**paras)
 
 
+def test_wordpiece_tokenizer_with_ids():
+    """
+    Feature: WordpieceTokenizer
+    Description: tokenize with with_ids=True, the unknown token being in the vocab
+    Expectation: the output is the ids of the tokens of the default output
+    """
+    for paras in test_paras:
+        if 'unknown_token' in paras:
+            continue
+        check_wordpiece_tokenizer_with_ids(paras['first'], paras['last'], paras['expect_str'], paras['vocab_list'],
+                                           paras.get('max_bytes_per_token', 100))
+
+
+def test_wordpiece_tokenizer_with_ids_and_offsets():
+    """
+    Feature: WordpieceTokenizer
+    Description: set both with_offsets and with_ids to True
+    Expectation: ValueError is raised
+    """
+    vocab = text.Vocab.from_list(vocab_english)
+    with pytest.raises(ValueError) as info:
+        text.WordpieceTokenizer(vocab=vocab, with_offsets=True, with_ids=True)
+    assert "with_offsets and with_ids" in str(info.value)
+
+
 if __name__ == '__main__':
     test_wordpiece_tokenizer_default()
     test_wordpiece_tokenizer_with_offsets()
+    test_wordpiece_tokenizer_with_ids()
+    test_wordpiece_tokenizer_with_ids_and_offsets()
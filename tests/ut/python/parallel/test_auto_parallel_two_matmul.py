@@ -108,7 +108,9 @@ def test_two_matmul():
 
     set_algo_parameters(tensor_slice_align_enable=False, tensor_slice_align_size=32,
                         fully_use_devices=False, elementwise_op_strategy_follow=False,
-                        enable_algo_approxi=True, algo_approxi_epsilon=0.001)
+                        enable_algo_approxi=True, algo_approxi_epsilon=0.001, search_threads=4,
+                        cost_cache_path="./redistribution_cost.cache", strategy_db_path="./parallel_strategy.db",
+                        redistribution_search=True)
     para_slice_align_enable = get_algo_parameters("tensor_slice_align_enable")
     assert not para_slice_align_enable
     para_slice_align_size = get_algo_parameters("tensor_slice_align_size")
@@ -121,6 +123,14 @@ def test_two_matmul():
     assert enable_approxi
     algo_epsilon = get_algo_parameters("algo_approxi_epsilon")
     assert algo_epsilon == 0.001
+    search_threads = get_algo_parameters("search_threads")
+    assert search_threads == 4
+    cost_cache_path = get_algo_parameters("cost_cache_path")
+    assert cost_cache_path == "./redistribution_cost.cache"
+    strategy_db_path = get_algo_parameters("strategy_db_path")
+    assert strategy_db_path == "./parallel_strategy.db"
+    redistribution_search = get_algo_parameters("redistribution_search")
+    assert redistribution_search
 
     expecte_single_loop = True
     signle_loop = _get_algo_single_loop()
@@ -143,6 +153,14 @@ def test_two_matmul():
     assert not enable_approxi
     algo_epsilon = get_algo_parameters("algo_approxi_epsilon")
     assert algo_epsilon == 0.1
+    search_threads = get_algo_parameters("search_threads")
+    assert search_threads == 0
+    cost_cache_path = get_algo_parameters("cost_cache_path")
+    assert cost_cache_path == ""
+    strategy_db_path = get_algo_parameters("strategy_db_path")
+    assert strategy_db_path == ""
+    redistribution_search = get_algo_parameters("redistribution_search")
+    assert not redistribution_search
 
     x = Tensor(np.ones([128, 32]), dtype=ms.float32)
     y = Tensor(np.ones([32, 64]), dtype=ms.float32)
@@ -99,6 +99,17 @@ def test_max_device_memory_size():
         context.set_context(max_device_memory="3.5G")
     context.set_context.__wrapped__(max_device_memory="3GB")
 
+def test_recompute_memory_budget():
+    """test_recompute_memory_budget"""
+    with pytest.raises(TypeError):
+        context.set_context(recompute_memory_budget=1)
+    with pytest.raises(ValueError):
+        context.set_context(recompute_memory_budget="3.5G")
+    context.set_context(recompute_memory_budget="3.5GB")
+    assert context.get_context("recompute_memory_budget") == 3.5
+    context.set_context(recompute_memory_budget="0GB")
+    assert context.get_context("recompute_memory_budget") == 0
+
 def test_print_file_path():
     """test_print_file_path"""
     with pytest.raises(IOError):
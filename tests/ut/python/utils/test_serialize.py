@@ -15,6 +15,7 @@
 """ut for model serialize(save/load)"""
 import os
 import platform
+import shutil
 import stat
 import time
 import secrets
@@ -33,7 +34,7 @@ from mindspore.nn.optim.momentum import Momentum
 from mindspore.ops import operations as P
 from mindspore.train.callback import _CheckpointManager
 from mindspore.train.serialization import save_checkpoint, load_checkpoint, load_param_into_net, \
-     export, _save_graph, load
+     export, _save_graph, load, async_ckpt_thread_status
 from tests.security_utils import security_off_wrap
 from ..ut_filter import non_graph_engine
 
@@ -355,6 +356,36 @@ def test_save_and_load_checkpoint_for_network_with_encryption():
         os.remove(ckpt_path)
 
 
+@pytest.mark.skipif(platform.system().lower() == "windows", reason="the native checkpoint is not on Windows")
+def test_save_and_load_native_checkpoint():
+    """
+    Feature: Native checkpoint.
+    Description: Save a network in the native format asynchronously, load it and convert it to the .ckpt format.
+    Expectation: The parameters are read when they are accessed, the ones loaded from both formats are the same.
+    """
+    net = Net()
+    ckpt_path = "./native_ckpt.ckpt"
+    converted_path = "./converted_ckpt.ckpt"
+    save_checkpoint(net, ckpt_file_name=ckpt_path, async_save=True, append_dict={"epoch": 3}, native_format=True)
+    while async_ckpt_thread_status():
+        time.sleep(0.01)
+    param_dict = load_checkpoint(ckpt_path)
+    assert len(param_dict._unread) == len(param_dict)
+    assert param_dict["epoch"].asnumpy() == 3
+    assert "epoch" not in param_dict._unread
+    for param in net.get_parameters():
+        assert np.array_equal(param_dict[param.name].asnumpy(), param.asnumpy())
+    save_checkpoint([{"name": name, "data": param} for name, param in param_dict.items()], converted_path)
+    converted_dict = load_checkpoint(converted_path, filter_prefix="epoch")
+    for name, param in converted_dict.items():
+        assert np.array_equal(param.asnumpy(), param_dict[name].asnumpy())
+    with pytest.raises(ValueError):
+        save_checkpoint(net, ckpt_file_name=ckpt_path, enc_key=secrets.token_bytes(16), native_format=True)
+    for path in (ckpt_path, converted_path):
+        os.chmod(path, stat.S_IWRITE)
+        os.remove(path)
+
+
 class MYNET(nn.Cell):
     """ NET definition """
 
@@ -399,6 +430,29 @@ def test_mindir_export_and_load_with_encryption():
     load("./me_cipher_binary_export.mindir", dec_key=key)
 
 
+@non_graph_engine
+def test_mindir_export_and_load_with_external_data():
+    """
+    Feature: MindIR with external data.
+    Description: Export the parameters of the network to external files and load the MindIR.
+    Expectation: The graph file and the data file are exported, and the parameters of the loaded MindIR are the ones
+    of the network.
+    """
+    net = MYNET()
+    input_data = Tensor(np.random.randint(0, 255, [1, 3, 224, 224]).astype(np.float32))
+    export(net, input_data, file_name="./me_external_export", file_format="MINDIR", external_data=True)
+    assert os.path.exists("./me_external_export_variables/data_0")
+    graph = load("./me_external_export_graph.mindir")
+    loaded_params = nn.GraphCell(graph).parameters_dict()
+    net_params = net.parameters_dict()
+    assert loaded_params
+    for name, param in loaded_params.items():
+        assert name in net_params
+        assert np.array_equal(param.asnumpy(), net_params[name].asnumpy())
+    os.remove("./me_external_export_graph.mindir")
+    shutil.rmtree("./me_external_export_variables")
+
+
 
 class PrintNet(nn.Cell):
     def __init__(self):